@@ -0,0 +1,33 @@
+//! \file autotune.h
+//! Choice of the event-based particle buffer size and OpenMP schedule from the
+//! calculation rates measured in the first batches
+
+#ifndef OPENMC_AUTOTUNE_H
+#define OPENMC_AUTOTUNE_H
+
+namespace openmc {
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Set up the configurations tried when settings::event_autotune is on
+//
+//! The first batch is transported with the configuration given by the user
+//! to warm up caches. Each following batch tries one configuration: first a
+//! few numbers of particles in flight with the schedule of the user, then the
+//! best of those with static, dynamic and guided OpenMP schedules. The fastest
+//! configuration is kept for the rest of the run.
+void init_autotune();
+
+//! Apply the configuration tried in the batch that is starting
+void autotune_initialize_batch();
+
+//! Record the calculation rate of the batch that finished and, once every
+//! configuration has been tried, keep the fastest one. This must be called on
+//! all processes.
+void autotune_finalize_batch();
+
+} // namespace openmc
+
+#endif // OPENMC_AUTOTUNE_H
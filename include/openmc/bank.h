@@ -10,6 +10,16 @@
 
 namespace openmc {
 
+//==============================================================================
+//! Fission sites created by one thread in the current generation. Each bank
+//! starts on its own cache line so that threads appending to their banks do
+//! not write to the same line.
+//==============================================================================
+
+struct alignas(64) ThreadFissionBank {
+  vector<SourceSite> sites;
+};
+
 //==============================================================================
 // Global variables
 //==============================================================================
@@ -22,6 +32,8 @@ extern SharedArray<SourceSite> surf_source_bank;
 
 extern SharedArray<SourceSite> fission_bank;
 
+extern vector<ThreadFissionBank> thread_fission_banks;
+
 extern vector<int64_t> progeny_per_particle;
 
 } // namespace simulation
@@ -30,6 +42,16 @@ extern vector<int64_t> progeny_per_particle;
 // Non-member functions
 //==============================================================================
 
+//! Store a fission site in the bank of the calling thread
+//
+//! \param[in] site  Fission site created in the current generation
+void bank_fission_site(const SourceSite& site);
+
+//! Clear the fission bank and the bank of each thread for a new generation
+void clear_fission_bank();
+
+//! Gather the fission sites of every thread into the fission bank, ordered by
+//! parent and progeny IDs
 void sort_fission_bank();
 
 void free_memory_bank();
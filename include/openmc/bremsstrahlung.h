@@ -2,6 +2,8 @@
 #define OPENMC_BREMSSTRAHLUNG_H
 
 #include "openmc/particle.h"
+#include "openmc/search.h"
+#include "openmc/vector.h"
 
 #include "xtensor/xtensor.hpp"
 
@@ -17,6 +19,10 @@ public:
   xt::xtensor<double, 2> pdf;   //!< Bremsstrahlung energy PDF
   xt::xtensor<double, 2> cdf;   //!< Bremsstrahlung energy CDF
   xt::xtensor<double, 1> yield; //!< Photon yield
+
+  //! Guide tables for searching each row of the CDF, normalized by its last
+  //! value. Empty unless settings::guide_table_cells is positive.
+  vector<GuideTable> guide;
 };
 
 class Bremsstrahlung {
@@ -36,6 +42,8 @@ extern xt::xtensor<double, 1>
   ttb_e_grid; //! energy T of incident electron in [eV]
 extern xt::xtensor<double, 1>
   ttb_k_grid; //! reduced energy W/T of emitted photon
+extern GuideTable
+  ttb_e_guide; //! guide table for searching the log of ttb_e_grid
 
 } // namespace data
 
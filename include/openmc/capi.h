@@ -77,6 +77,10 @@ bool openmc_is_statepoint_batch();
 int openmc_legendre_filter_get_order(int32_t index, int* order);
 int openmc_legendre_filter_set_order(int32_t index, int order);
 int openmc_load_nuclide(const char* name, const double* temps, int n);
+int openmc_majorant_create(int n, const int32_t* materials, int32_t* index);
+int openmc_majorant_evaluate(int32_t index, double E, double* xs);
+int openmc_majorant_get_xs(int32_t index, const double** xs, int* n,
+  double* energy_min, double* energy_max);
 int openmc_material_add_nuclide(
   int32_t index, const char name[], double density);
 int openmc_material_get_densities(
@@ -107,8 +111,12 @@ int openmc_mesh_get_id(int32_t index, int32_t* id);
 int openmc_mesh_set_id(int32_t index, int32_t id);
 int openmc_mesh_get_n_elements(int32_t index, size_t* n);
 int openmc_mesh_get_volumes(int32_t index, double* volumes);
+int openmc_mesh_get_bins(
+  int32_t index, size_t n, const double* coords, int* bins);
 int openmc_mesh_material_volumes(int32_t index, int n_sample, int bin,
   int result_size, void* result, int* hits, uint64_t* seed);
+int openmc_mesh_traced_material_volumes(int32_t index, const int* n_rays,
+  int max_materials, int* n_materials, int32_t* materials, double* volumes);
 int openmc_meshsurface_filter_get_mesh(int32_t index, int32_t* index_mesh);
 int openmc_meshsurface_filter_set_mesh(int32_t index, int32_t index_mesh);
 int openmc_new_filter(const char* type, int32_t* index);
@@ -117,6 +125,12 @@ int openmc_nuclide_name(int index, const char** name);
 int openmc_plot_geometry();
 int openmc_id_map(const void* slice, int32_t* data_out);
 int openmc_property_map(const void* slice, double* data_out);
+int openmc_reaction_rates_clear();
+int openmc_reaction_rates_flux(double* flux);
+int openmc_reaction_rates_get(double* rates);
+int openmc_reaction_rates_set(int n_materials, const int32_t* materials,
+  int n_nuclides, const int* nuclides, int n_reactions, const int* reactions,
+  int n_energies, const double* energies);
 int openmc_rectilinear_mesh_get_grid(int32_t index, double** grid_x, int* nx,
   double** grid_y, int* ny, double** grid_z, int* nz);
 int openmc_rectilinear_mesh_set_grid(int32_t index, const double* grid_x,
@@ -134,10 +148,12 @@ int openmc_reset_timers();
 int openmc_run();
 int openmc_sample_external_source(size_t n, uint64_t* seed, void* sites);
 void openmc_set_seed(int64_t new_seed);
+int openmc_set_source_sites(const void* sites, int64_t n, double strength);
 int openmc_set_n_batches(
   int32_t n_batches, bool set_max_batches, bool add_statepoint_batch);
 int openmc_simulation_finalize();
 int openmc_simulation_init();
+int openmc_simulation_set_persistent(bool persistent);
 int openmc_source_bank(void** ptr, int64_t* n);
 int openmc_spatial_legendre_filter_get_order(int32_t index, int* order);
 int openmc_spatial_legendre_filter_get_params(
@@ -159,6 +175,7 @@ int openmc_tally_get_filters(int32_t index, const int32_t** indices, size_t* n);
 int openmc_tally_get_n_realizations(int32_t index, int32_t* n);
 int openmc_tally_get_nuclides(int32_t index, int** nuclides, int* n);
 int openmc_tally_get_scores(int32_t index, int** scores, int* n);
+int openmc_tally_get_thread_private(int32_t index, bool* value);
 int openmc_tally_get_type(int32_t index, int32_t* type);
 int openmc_tally_get_writable(int32_t index, bool* writable);
 int openmc_tally_reset(int32_t index);
@@ -169,6 +186,7 @@ int openmc_tally_set_filters(int32_t index, size_t n, const int32_t* indices);
 int openmc_tally_set_id(int32_t index, int32_t id);
 int openmc_tally_set_nuclides(int32_t index, int n, const char** nuclides);
 int openmc_tally_set_scores(int32_t index, int n, const char** scores);
+int openmc_tally_set_thread_private(int32_t index, bool value);
 int openmc_tally_set_type(int32_t index, const char* type);
 int openmc_tally_set_writable(int32_t index, bool writable);
 int openmc_get_weight_windows_index(int32_t id, int32_t* idx);
@@ -242,11 +260,15 @@ void openmc_cmfd_reweight(const bool feedback, const double* cmfd_src);
 //! \param[in] map coremap for problem, storing accelerated regions
 //! \param[in] use_all_threads whether to use all threads when running CMFD
 //! solver
+//! \param[in] solver index of linear solver: 0 for Gauss-Seidel, 1 for
+//! BiCGStab with a Jacobi preconditioner and 2 for BiCGStab with an ILU(0)
+//! preconditioner
 void openmc_initialize_linsolver(const int* indptr, int len_indptr,
   const int* indices, int n_elements, int dim, double spectral, const int* map,
-  bool use_all_threads);
+  bool use_all_threads, int solver);
 
-//! Runs a Gauss Seidel linear solver to solve CMFD matrix equations
+//! Runs a Gauss Seidel or BiCGStab linear solver to solve CMFD matrix
+//! equations
 //! linear solver
 //! \param[in] A_data CSR format data array of coefficient matrix
 //! \param[in] b right hand side vector
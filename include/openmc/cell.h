@@ -12,6 +12,7 @@
 #include "pugixml.hpp"
 #include <gsl/gsl-lite.hpp>
 
+#include "openmc/array.h"
 #include "openmc/bounding_box.h"
 #include "openmc/constants.h"
 #include "openmc/memory.h" // for unique_ptr
@@ -43,6 +44,7 @@ constexpr int32_t OP_UNION {std::numeric_limits<int32_t>::max() - 4};
 class Cell;
 class GeometryState;
 class ParentCell;
+struct SurfaceDistances;
 class CellInstance;
 class Universe;
 class UniversePartitioner;
@@ -53,6 +55,41 @@ extern vector<unique_ptr<Cell>> cells;
 
 } // namespace model
 
+//==============================================================================
+//! A step in the evaluation of a complex region. The sense of the particle with
+//! respect to one half-space decides which step is taken next.
+//==============================================================================
+
+struct RegionBranch {
+  int32_t token;      //!< Half-space as a signed, off-by-one surface index
+  int32_t next_true;  //!< Next step if the particle is in the half-space
+  int32_t next_false; //!< Next step if the particle is not in the half-space
+  int32_t slot; //!< Bit in which the sense of a surface appearing more than
+                //!< once is remembered, or -1
+};
+
+//==============================================================================
+//! Coefficients of the surfaces of a simple region grouped by kind, so that
+//! distances to all surfaces of one kind can be found in a vectorized loop.
+//! Distances are laid out as planes normal to x, y and z, then cylinders along
+//! x, y and z, then any other surfaces.
+//==============================================================================
+
+struct SurfaceBatch {
+  array<vector<double>, 3> plane_offset; //!< Offsets of planes by normal axis
+
+  //! Offsets along the two other axes and radii of cylinders by axis
+  array<vector<double>, 3> cylinder_offset1;
+  array<vector<double>, 3> cylinder_offset2;
+  array<vector<double>, 3> cylinder_radius;
+
+  vector<int32_t> other; //!< Indices of any other surfaces
+
+  //! Position among the batched distances of each token, or empty if the
+  //! region is not batched
+  vector<int> slot;
+};
+
 //==============================================================================
 
 class Region {
@@ -86,6 +123,13 @@ public:
   std::pair<double, int32_t> distance(
     Position r, Direction u, int32_t on_surface) const;
 
+  //! Find the oncoming boundary of this cell, reusing the distances to its
+  //! surfaces if they were calculated earlier on the same ray.
+  //! \param cache Distances to the surfaces, which are updated if they were
+  //!   calculated for another region or ray
+  std::pair<double, int32_t> distance(Position r, Direction u,
+    int32_t on_surface, SurfaceDistances& cache) const;
+
   //! Get the BoundingBox for this cell.
   BoundingBox bounding_box(int32_t cell_id) const;
 
@@ -114,11 +158,27 @@ private:
 
   //! Determine if a particle is inside the cell for a complex cell.
   //!
-  //! Uses the comobination of half-spaces and binary operators to determine
-  //! if short circuiting can be used. Short cicuiting uses the relative and
-  //! absolute depth of parenthases in the expression.
+  //! Follows the branches compiled from the expression, which evaluate only
+  //! the half-spaces needed to decide the result and each surface at most
+  //! once.
   bool contains_complex(Position r, Direction u, int32_t on_surface) const;
 
+  //! Remove half-spaces that cannot change the region, merge nested operators
+  //! of the same kind and put the cheapest operands of each operator first.
+  //! Half-spaces of planes normal to an axis are removed from an intersection
+  //! when they contain the bounding box of the other operands.
+  void simplify(int32_t cell_id);
+
+  //! Compile the expression of a complex region into branches_
+  void compile_branches(int32_t cell_id);
+
+  //! Group the surfaces of a simple region by kind into batch_
+  void build_batch();
+
+  //! Find the distances to all surfaces in batch_ as if none were coincident
+  //! \param distances Array receiving the distances in the layout of batch_
+  void batch_distances(Position r, Direction u, double* distances) const;
+
   //! BoundingBox if the paritcle is in a simple cell.
   BoundingBox bounding_box_simple() const;
 
@@ -145,6 +205,12 @@ private:
   // TODO: Should this be a vector of some other type
   vector<int32_t> expression_;
   bool simple_; //!< Does the region contain only intersections?
+
+  //! Steps that evaluate a complex region, starting with the first. A step
+  //! leads to another step or to BRANCH_INSIDE or BRANCH_OUTSIDE.
+  vector<RegionBranch> branches_;
+
+  SurfaceBatch batch_; //!< Surfaces of a simple region grouped by kind
 };
 
 //==============================================================================
@@ -376,6 +442,12 @@ public:
     return region_.distance(r, u, on_surface);
   }
 
+  std::pair<double, int32_t> distance(Position r, Direction u,
+    int32_t on_surface, SurfaceDistances& cache) const
+  {
+    return region_.distance(r, u, on_surface, cache);
+  }
+
   bool contains(Position r, Direction u, int32_t on_surface) const override
   {
     return region_.contains(r, u, on_surface);
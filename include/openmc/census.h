@@ -0,0 +1,85 @@
+//! \file census.h
+//! Time census of fixed source calculations, at which the particles in flight
+//! are stopped and their population is combed back to the number of particles
+//! per batch before they are transported to the next census time
+
+#ifndef OPENMC_CENSUS_H
+#define OPENMC_CENSUS_H
+
+#include "openmc/particle.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Sites of the particles stopped at the census by one thread, aligned to a
+//! cache line so that threads banking their own sites do not contend
+//==============================================================================
+
+struct alignas(64) ThreadCensusBank {
+  vector<SourceSite> sites;
+};
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+//! Index of the time step being transported, from zero for the step ending at
+//! the first census time to the number of census times for the last step
+extern int census_step;
+
+//! End of the time step being transported in [s], or infinity in the last
+//! step or when there is no census
+extern double census_time;
+
+//! Particles stopped at the census time by each thread of this process
+extern vector<ThreadCensusBank> thread_census_banks;
+
+//! Particles stopped at the census time on this process, in order of their
+//! parent and progeny
+extern vector<SourceSite> census_bank;
+
+//! Share of this process of the combed particles started in a time step after
+//! the first
+extern vector<SourceSite> census_source;
+
+} // namespace simulation
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Whether census times were given in the settings
+bool census_on();
+
+//! Number of time steps transported in each generation
+int n_census_steps();
+
+//! Allocate the census banks of each thread
+void init_census();
+
+//! Start the first time step of a generation
+void start_census();
+
+//! Store the state of a particle stopped at the census time. The weight of the
+//! particle is left for the caller to set to zero.
+//
+//! \param[in,out] p  Particle whose state is stored, and whose progeny count
+//!   is incremented
+void bank_census_site(Particle& p);
+
+//! Comb the particles stopped at the census of the time step that finished
+//! into the number of particles per batch, each with the same share of their
+//! total weight, and distribute them evenly across processes. This must be
+//! called on all processes.
+//
+//! \return Whether there is another time step to transport
+bool census_population_control();
+
+void free_memory_census();
+
+} // namespace openmc
+
+#endif // OPENMC_CENSUS_H
@@ -10,6 +10,10 @@ namespace openmc {
 // For non-accelerated regions on coarse mesh overlay
 constexpr int CMFD_NOACCEL {-1};
 
+//! Linear solvers for CMFD matrix equations, in the order of the solver
+//! indices passed by the Python API
+enum class CMFDLinearSolver { GAUSS_SEIDEL, BICGSTAB_JACOBI, BICGSTAB_ILU };
+
 //==============================================================================
 // Non-member functions
 //==============================================================================
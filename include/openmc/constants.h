@@ -34,6 +34,7 @@ constexpr array<int, 2> VERSION_VOXEL {2, 0};
 constexpr array<int, 2> VERSION_MGXS_LIBRARY {1, 0};
 constexpr array<int, 2> VERSION_PROPERTIES {1, 0};
 constexpr array<int, 2> VERSION_WEIGHT_WINDOWS {1, 0};
+constexpr array<int, 2> VERSION_PROFILE {1, 0};
 
 // ============================================================================
 // ADJUSTABLE PARAMETERS
@@ -246,6 +247,17 @@ enum class ElectronTreatment {
   TTB  // Thick Target Bremsstrahlung
 };
 
+// Compression filters for large HDF5 datasets
+enum class OutputCompression {
+  none,
+  deflate, // zlib
+  szip,
+  zstd // Zstandard, through the registered HDF5 filter plugin
+};
+
+// Identifier of the Zstandard filter registered with the HDF Group
+constexpr int H5Z_FILTER_ZSTD {32015};
+
 // ============================================================================
 // MULTIGROUP RELATED
 
@@ -337,13 +349,17 @@ enum class RunMode {
   EIGENVALUE,
   PLOTTING,
   PARTICLE,
-  VOLUME
+  VOLUME,
+  OVERLAP_CHECK
 };
 
 enum class SolverType { MONTE_CARLO, RANDOM_RAY };
 
+enum class ThreadAffinity { NONE, COMPACT, SPREAD };
+
 enum class RandomRayVolumeEstimator { NAIVE, SIMULATION_AVERAGED, HYBRID };
 enum class RandomRaySourceShape { FLAT, LINEAR, LINEAR_XY };
+enum class RandomRayAccumulation { LOCK, ATOMIC, PRIVATE };
 
 //==============================================================================
 // Geometry Constants
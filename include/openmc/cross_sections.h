@@ -81,6 +81,11 @@ void read_ce_cross_sections_xml();
 //! Load nuclide and thermal scattering data
 void finalize_cross_sections();
 
+//! Free the nuclear data that the settings and tallies cannot use when
+//! settings::prune_nuclear_data is on. This must be called once the tallies
+//! have been read.
+void prune_nuclear_data();
+
 void library_clear();
 
 } // namespace openmc
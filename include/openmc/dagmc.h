@@ -26,6 +26,7 @@ void check_dagmc_root_univ();
 #include "dagmcmetadata.hpp"
 
 #include "openmc/cell.h"
+#include "openmc/dagmc_embree.h"
 #include "openmc/particle.h"
 #include "openmc/position.h"
 #include "openmc/surface.h"
@@ -51,6 +52,11 @@ public:
   moab::DagMC* dagmc_ptr() const { return dagmc_ptr_.get(); }
   int32_t dag_index() const { return dag_index_; }
 
+#ifdef OPENMC_EMBREE
+  //! Ray tracer of the universe used in place of DAGMC ray fire
+  std::shared_ptr<const EmbreeRayTracer> ray_tracer_;
+#endif
+
 private:
   std::shared_ptr<moab::DagMC> dagmc_ptr_; //!< Pointer to DagMC instance
   int32_t dag_index_;                      //!< DagMC index of surface
@@ -75,9 +81,18 @@ public:
   moab::DagMC* dagmc_ptr() const { return dagmc_ptr_.get(); }
   int32_t dag_index() const { return dag_index_; }
 
+#ifdef OPENMC_EMBREE
+  //! Ray tracer of the universe used in place of DAGMC ray fire
+  std::shared_ptr<const EmbreeRayTracer> ray_tracer_;
+#endif
+
 private:
   std::shared_ptr<moab::DagMC> dagmc_ptr_; //!< Pointer to DagMC instance
   int32_t dag_index_;                      //!< DagMC index of cell
+
+  //! Bounding box used to reject points before a point in volume query. It is
+  //! unbounded for the implicit complement.
+  BoundingBox bbox_;
 };
 
 class DAGUniverse : public Universe {
@@ -152,6 +167,10 @@ public:
 
   bool find_cell(GeometryState& p) const override;
 
+  //! Partition the volumes other than the implicit complement with an octree
+  //! of their bounding boxes if that reduces the number checked by find_cell
+  void partition();
+
   void to_hdf5(hid_t universes_group) const override;
 
   // Data Members
@@ -0,0 +1,107 @@
+#ifndef OPENMC_DAGMC_EMBREE_H
+#define OPENMC_DAGMC_EMBREE_H
+
+#if defined(DAGMC) && defined(OPENMC_EMBREE)
+
+#include <embree4/rtcore.h>
+
+#include "DagMC.hpp"
+
+#include "openmc/position.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Ray tracer for DAGMC geometry built on Embree
+//!
+//! The triangles of each DAGMC surface are loaded into an Embree scene, and
+//! each volume is a scene of instances of the scenes of its surfaces, so the
+//! triangles are only stored once. Rays are traced in single precision and
+//! the distance to the triangle hit is then found in double precision from
+//! its plane. Only intersections leaving a volume are accepted, which takes
+//! the place of the ray history used by DAGMC to skip the surface a particle
+//! has just crossed.
+//==============================================================================
+
+class EmbreeRayTracer {
+public:
+  //----------------------------------------------------------------------------
+  // Constructors, destructors
+
+  explicit EmbreeRayTracer(moab::DagMC* dagmc);
+  ~EmbreeRayTracer();
+
+  EmbreeRayTracer(const EmbreeRayTracer&) = delete;
+  EmbreeRayTracer& operator=(const EmbreeRayTracer&) = delete;
+
+  //----------------------------------------------------------------------------
+  // Methods
+
+  //! Distance to the boundary of a volume
+  //
+  //! \param[in] i_vol  DAGMC index of the volume
+  //! \param[in] r  Starting point of the ray
+  //! \param[in] u  Direction of the ray
+  //! \param[out] i_surf  DAGMC index of the surface hit, or 0 if none is hit
+  //! \return Distance to the surface hit, or INFTY
+  double distance_to_boundary(
+    int i_vol, Position r, Direction u, int& i_surf) const;
+
+  //! Distance to a surface in either direction of crossing
+  //
+  //! \param[in] i_surf  DAGMC index of the surface
+  //! \param[in] r  Starting point of the ray
+  //! \param[in] u  Direction of the ray
+  //! \return Distance to the surface, or INFTY if it is not hit
+  double distance_to_surface(int i_surf, Position r, Direction u) const;
+
+private:
+  //! Plane of a triangle, n . x = d, with the normal n following the winding
+  //! of the triangle
+  struct Facet {
+    Direction n;
+    double d;
+  };
+
+  //! Surface of a volume as seen by the instance of its scene
+  struct VolumeSurface {
+    int i_surf; //!< DAGMC index of the surface
+    int sense;  //!< Sign of the outward normal relative to the facet normals,
+                //!< or zero if the surface has the volume on both sides
+  };
+
+  //! Context passed to the filter that rejects intersections entering a
+  //! volume. The Embree context must come first.
+  struct QueryContext {
+    RTCRayQueryContext base;
+    const EmbreeRayTracer* tracer;
+    const vector<VolumeSurface>* surfaces;
+  };
+
+  //! Filter rejecting intersections that enter a volume
+  static void exiting_filter(const RTCFilterFunctionNArguments* args);
+
+  //! Trace a ray through a scene
+  //
+  //! \param[in] scene  Scene to trace
+  //! \param[in] r  Starting point of the ray
+  //! \param[in] u  Direction of the ray
+  //! \param[in] args  Arguments of the query, or nullptr
+  //! \param[out] rayhit  Ray and hit
+  //! \return Whether a triangle was hit
+  bool trace(RTCScene scene, Position r, Direction u,
+    RTCIntersectArguments* args, RTCRayHit& rayhit) const;
+
+  RTCDevice device_;                      //!< Embree device
+  vector<RTCScene> surface_scenes_;       //!< Scene of each surface
+  vector<vector<Facet>> facets_;          //!< Facets of each surface
+  vector<RTCScene> volume_scenes_;        //!< Scene of each volume
+  vector<vector<VolumeSurface>> volumes_; //!< Surface of each instance
+};
+
+} // namespace openmc
+
+#endif // DAGMC && OPENMC_EMBREE
+
+#endif // OPENMC_DAGMC_EMBREE_H
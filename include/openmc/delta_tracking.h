@@ -0,0 +1,98 @@
+#ifndef OPENMC_DELTA_TRACKING_H
+#define OPENMC_DELTA_TRACKING_H
+
+#include <cstdint>
+
+#include "openmc/particle.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Majorant cross section of a set of materials
+//!
+//! The majorant is an upper bound on the macroscopic total cross section of
+//! every material in the set. It is stored for each bin of the logarithmic
+//! energy grid used for cross section lookups and bounds the cross sections at
+//! all temperatures of the data, in the unresolved resonance range when
+//! probability tables are used, and with thermal scattering data. The bounds
+//! of each distinct nuclide are found in parallel.
+//==============================================================================
+
+class Majorant {
+public:
+  //----------------------------------------------------------------------------
+  // Constructors
+
+  //! Build the majorant over a set of materials
+  //
+  //! \param[in] materials  Indices in model::materials of the materials
+  //! \throw std::runtime_error if a nuclide uses windowed multipole data
+  explicit Majorant(const vector<int32_t>& materials);
+
+  //----------------------------------------------------------------------------
+  // Methods
+
+  //! Majorant cross section
+  //
+  //! \param[in] E  Neutron energy in [eV]
+  //! \return Macroscopic majorant cross section in [1/cm]
+  double operator()(double E) const;
+
+  //----------------------------------------------------------------------------
+  // Accessors
+
+  //! Majorant in each bin of the logarithmic energy grid in [1/cm]
+  const vector<double>& xs() const { return xs_; }
+
+private:
+  //----------------------------------------------------------------------------
+  // Data members
+
+  vector<double> xs_; //!< Majorant in each logarithmic energy bin in [1/cm]
+};
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace model {
+
+//! Majorants of delta-tracking regions followed by those created through the
+//! C API. All are rebuilt or removed when a simulation is initialized.
+extern vector<Majorant> majorants;
+
+//! Index of the majorant of the delta-tracking region filling each cell, or
+//! C_NONE. Empty unless delta tracking is used.
+extern vector<int> cell_majorant;
+
+} // namespace model
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Build the majorant cross sections of the delta-tracking regions
+void init_delta_tracking();
+
+//! Find the delta-tracking region a particle is in
+//
+//! \param[in] p  Particle
+//! \return Coordinate level of the outermost cell of a delta-tracking region
+//!   containing the particle, or C_NONE if it is tracked surface to surface
+int delta_tracking_level(const Particle& p);
+
+//! Report a total cross section that exceeds the majorant
+//
+//! A warning is only written the first time this happens.
+//! \param[in] E  Neutron energy in [eV]
+//! \param[in] total  Macroscopic total cross section in [1/cm]
+//! \param[in] majorant  Macroscopic majorant cross section in [1/cm]
+void majorant_exceeded(double E, double total, double majorant);
+
+//! Free memory associated with delta tracking
+void free_memory_delta_tracking();
+
+} // namespace openmc
+
+#endif // OPENMC_DELTA_TRACKING_H
@@ -5,12 +5,14 @@
 #define OPENMC_DISTRIBUTION_H
 
 #include <cstddef> // for size_t
+#include <utility> // for pair
 
 #include "pugixml.hpp"
 #include <gsl/gsl-lite.hpp>
 
 #include "openmc/constants.h"
 #include "openmc/memory.h" // for unique_ptr
+#include "openmc/search.h" // for GuideTable
 #include "openmc/vector.h" // for vector
 
 namespace openmc {
@@ -24,6 +26,14 @@ public:
   virtual ~Distribution() = default;
   virtual double sample(uint64_t* seed) const = 0;
 
+  //! Sample a value from a biased version of the distribution
+  //! \param seed Pseudorandom number seed pointer
+  //! \return Sampled value and the weight that compensates for the bias
+  virtual std::pair<double, double> sample_biased(uint64_t* seed) const
+  {
+    return {this->sample(seed), 1.0};
+  }
+
   //! Return integral of distribution
   //! \return Integral of distribution
   virtual double integral() const { return 1.0; };
@@ -71,6 +81,15 @@ private:
   void init_alias();
 };
 
+//! Compute the weights that compensate for sampling from a biased
+//! probability mass function
+//
+//! \param p Unnormalized probabilities of the unbiased distribution
+//! \param bias Unnormalized probabilities of the biased distribution
+//! \return Ratio of the normalized unbiased and biased probabilities
+vector<double> bias_weights(
+  gsl::span<const double> p, gsl::span<const double> bias);
+
 //==============================================================================
 //! A discrete distribution (probability mass function)
 //==============================================================================
@@ -85,17 +104,28 @@ public:
   //! \return Sampled value
   double sample(uint64_t* seed) const override;
 
+  //! Sample a value from the biased probabilities, if any
+  //! \param seed Pseudorandom number seed pointer
+  //! \return Sampled value and the weight that compensates for the bias
+  std::pair<double, double> sample_biased(uint64_t* seed) const override;
+
   double integral() const override { return di_.integral(); };
 
   // Properties
   const vector<double>& x() const { return x_; }
   const vector<double>& prob() const { return di_.prob(); }
   const vector<size_t>& alias() const { return di_.alias(); }
+  bool biased() const { return !bias_wgt_.empty(); }
 
 private:
   vector<double> x_; //!< Possible outcomes
   DiscreteIndex di_; //!< discrete probability distribution of
                      //!< outcome indices
+  DiscreteIndex bias_;      //!< biased distribution of outcome indices
+  vector<double> bias_wgt_; //!< weight of each outcome sampled with bias_
+
+  //! Read biased probabilities of the outcomes from XML
+  void read_bias(pugi::xml_node node, gsl::span<const double> p);
 };
 
 //==============================================================================
@@ -241,6 +271,7 @@ private:
   vector<double> c_;     //!< cumulative distribution at tabulated values
   Interpolation interp_; //!< interpolation rule
   double integral_;      //!< Integral of distribution
+  GuideTable guide_;     //!< Guide table for searching c_, empty if short
 
   //! Initialize tabulated probability density function
   //! \param x Array of values for independent variable
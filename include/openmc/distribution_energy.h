@@ -9,6 +9,7 @@
 
 #include "openmc/constants.h"
 #include "openmc/endf.h"
+#include "openmc/search.h"
 #include "openmc/vector.h"
 
 namespace openmc {
@@ -89,6 +90,7 @@ private:
     xt::xtensor<double, 1> e_out; //!< Outgoing energies in [eV]
     xt::xtensor<double, 1> p;     //!< Probability density
     xt::xtensor<double, 1> c;     //!< Cumulative distribution
+    GuideTable guide;             //!< Guide table for searching c
   };
 
   int n_region_;                        //!< Number of inteprolation regions
@@ -20,6 +20,14 @@ public:
   //! Sample a position from the distribution
   virtual Position sample(uint64_t* seed) const = 0;
 
+  //! Sample a position from a biased version of the distribution
+  //! \param seed Pseudorandom number seed pointer
+  //! \return Sampled position and the weight that compensates for the bias
+  virtual std::pair<Position, double> sample_biased(uint64_t* seed) const
+  {
+    return {this->sample(seed), 1.0};
+  }
+
   static unique_ptr<SpatialDistribution> create(pugi::xml_node node);
 };
 
@@ -116,11 +124,28 @@ public:
   //! \return Sampled element index and position within that element
   std::pair<int32_t, Position> sample_mesh(uint64_t* seed) const;
 
+  //! Sample a position from the biased element strengths, if any
+  //! \param seed Pseudorandom number seed pointer
+  //! \return Sampled position and the weight that compensates for the bias
+  std::pair<Position, double> sample_biased(uint64_t* seed) const override;
+
   //! Sample a mesh element
   //! \param seed Pseudorandom number seed pointer
   //! \return Sampled element index
   int32_t sample_element_index(uint64_t* seed) const;
 
+  //! Sample a mesh element from the biased element strengths, if any
+  //! \param seed Pseudorandom number seed pointer
+  //! \return Sampled element index and the weight that compensates for the
+  //!   bias
+  std::pair<int32_t, double> sample_element_biased(uint64_t* seed) const;
+
+  //! Sample elements in proportion to biased strengths
+  //! \param strengths Unbiased strength of each element
+  //! \param bias Biased strength of each element
+  void set_bias(
+    gsl::span<const double> strengths, gsl::span<const double> bias);
+
   //! For unstructured meshes, ensure that elements are all linear tetrahedra
   void check_element_types() const;
 
@@ -129,11 +154,14 @@ public:
   int32_t n_sources() const { return this->mesh()->n_bins(); }
 
   double total_strength() { return this->elem_idx_dist_.integral(); }
+  bool biased() const { return !bias_wgt_.empty(); }
 
 private:
   int32_t mesh_idx_ {C_NONE};
   DiscreteIndex elem_idx_dist_; //!< Distribution of
                                 //!< mesh element indices
+  DiscreteIndex bias_;          //!< Biased distribution of element indices
+  vector<double> bias_wgt_;     //!< Weight of each element sampled with bias_
 };
 
 //==============================================================================
@@ -143,6 +171,10 @@ private:
 class SpatialBox : public SpatialDistribution {
 public:
   explicit SpatialBox(pugi::xml_node node, bool fission = false);
+  SpatialBox(Position lower_left, Position upper_right, bool fission = false)
+    : lower_left_ {lower_left}, upper_right_ {upper_right},
+      only_fissionable_ {fission}
+  {}
 
   //! Sample a position from the distribution
   //! \param seed Pseudorandom number seed pointer
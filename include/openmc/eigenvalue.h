@@ -26,6 +26,12 @@ extern array<double, 2> k_sum; //!< Used to reduce sum and sum_sq
 extern vector<double> entropy; //!< Shannon entropy at each generation
 extern xt::xtensor<double, 1> source_frac; //!< Source fraction for UFS
 
+//! Weight of fission sites produced in each bin of the fission matrix mesh
+//! (row) by source sites in each bin (column), summed over inactive batches
+extern vector<double> fission_matrix;
+extern vector<double> fission_matrix_source; //!< Source weight in each bin
+extern vector<double> fission_matrix_vector; //!< Dominant eigenvector
+
 } // namespace simulation
 
 //==============================================================================
@@ -57,8 +63,38 @@ void calculate_average_keff();
 extern "C" int openmc_get_keff(double* k_combined);
 
 //! Sample/redistribute source sites from accumulated fission sites
+//
+//! With overlap_bank_sync, source sites from other processes may still be in
+//! flight on return. They are completed by receive_source_sites() during
+//! transport or by finish_bank_synchronization().
 void synchronize_bank();
 
+//! Wait for any source sites still being received from other processes
+void finish_bank_synchronization();
+
+//! Whether source sites are still being received from other processes
+bool source_sites_pending();
+
+//! Get the next part of the source bank that is ready to be transported
+//
+//! The sites sampled on this process are returned first, followed by the
+//! sites of each message from another process as it arrives.
+//!
+//! \param[out] first  Index in the source bank of the first site
+//! \param[out] last  Index in the source bank one past the last site
+//! \return Whether any sites were returned
+bool receive_source_sites(int64_t& first, int64_t& last);
+
+//! Score the fission sites of the current generation to the fission matrix
+//
+//! The fission bank must be sorted and the source bank must still hold the
+//! source sites that the fission sites were produced by.
+void fission_matrix_tally();
+
+//! Reweight the source bank so that its distribution over the fission matrix
+//! mesh matches the dominant eigenvector of the fission matrix
+void fission_matrix_reweight();
+
 //! Calculates the Shannon entropy of the fission source distribution to assess
 //! source convergence
 void shannon_entropy();
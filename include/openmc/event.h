@@ -49,6 +49,18 @@ struct EventQueueItem {
   }
 };
 
+// A secondary particle waiting in the shared secondary queue for a free slot
+// of the particle buffer. Its random number seeds are derived from those of its
+// parent and from its index among the parent's secondaries, so its history does
+// not depend on which slot it is transported in.
+struct SecondaryQueueItem {
+  SourceSite site; //!< secondary particle, with the ID of its history as
+                   //!< parent_id and its index among the secondaries of its
+                   //!< parent as progeny_id
+  uint64_t seeds[N_STREAMS]; //!< random number seeds of the secondary
+  int n_split;               //!< number of splits of its history so far
+};
+
 //==============================================================================
 // Global variable declarations
 //==============================================================================
@@ -59,12 +71,24 @@ namespace simulation {
 // vector, as they will be shared between threads and may be appended to at the
 // same time. To facilitate this, the SharedArray thread_safe_append() method
 // is provided which controls the append operations using atomics.
-extern SharedArray<EventQueueItem> calculate_fuel_xs_queue;
-extern SharedArray<EventQueueItem> calculate_nonfuel_xs_queue;
+//
+// Particles needing a cross section lookup are partitioned into one or more
+// queues so that each lookup kernel only touches the nuclear data of a subset
+// of materials. By default, there are two queues, one for fissionable and one
+// for non-fissionable materials. The index of the queue used for each material
+// is given by xs_queue_index.
+extern vector<SharedArray<EventQueueItem>> calculate_xs_queues;
+extern vector<int> xs_queue_index;
 extern SharedArray<EventQueueItem> advance_particle_queue;
 extern SharedArray<EventQueueItem> surface_crossing_queue;
 extern SharedArray<EventQueueItem> collision_queue;
 
+// Secondary particles waiting for a free slot of the particle buffer and the
+// indices of the slots whose particles have died, used when
+// settings::event_secondary_queue is on
+extern SharedArray<SecondaryQueueItem> secondary_queue;
+extern SharedArray<int64_t> free_slots;
+
 // Particle buffer
 extern vector<Particle> particles;
 
@@ -74,6 +98,11 @@ extern vector<Particle> particles;
 // Functions
 //==============================================================================
 
+//! Assign each material to one of the cross section event queues
+//
+//! \return The number of cross section event queues needed
+int assign_xs_queues();
+
 //! Allocate space for the event queues and particle buffer
 //
 //! \param n_particles The number of particles in the particle buffer
@@ -82,17 +111,46 @@ void init_event_queues(int64_t n_particles);
 //! Free the event queues and particle buffer
 void free_event_queues(void);
 
-//! Enqueue a particle based on if it is in fuel or a non-fuel material
+//! Enqueue a particle in the cross section queue assigned to its material
 //
 //! \param buffer_idx The particle's actual index in the particle buffer
 void dispatch_xs_event(int64_t buffer_idx);
 
+//! Whether secondary particles are passed between particle slots through the
+//! shared secondary queue. This requires each history's tallies to be
+//! independent of the slot it is transported in, so it only applies to fixed
+//! source calculations without pulse-height tallies.
+bool secondary_queue_active();
+
+//! Revive a particle that died from its secondary bank and enqueue it for a
+//! cross section lookup as needed. With the shared secondary queue, the
+//! secondaries of a particle that died are instead moved to the queue and its
+//! slot is released.
+//
+//! \param buffer_idx The particle's actual index in the particle buffer
+void revive_from_secondary(int64_t buffer_idx);
+
+//! Sort a queue by particle type, material, and energy using all threads
+//
+//! \param queue A reference to the queue to sort
+void sort_queue(SharedArray<EventQueueItem>& queue);
+
+//! Execute the calculate XS event for a sorted queue, evaluating runs of
+//! neutrons in the same material with the batched lookup kernel
+//
+//! \param queue A reference to the sorted queue
+void calculate_xs_batched(SharedArray<EventQueueItem>& queue);
+
 //! Execute the initialization event for all particles
 //
 //! \param n_particles The number of particles in the particle buffer
 //! \param source_offset The offset index in the source bank to use
 void process_init_events(int64_t n_particles, int64_t source_offset);
 
+//! Start secondary particles from the shared secondary queue in the free slots
+//! of the particle buffer
+void process_secondary_events();
+
 //! Execute the calculate XS event for all particles in this event's buffer
 //
 //! \param queue A reference to the desired XS lookup queue
@@ -107,6 +165,10 @@ void process_surface_crossing_events();
 //! Execute the collision event for all particles in this event's buffer
 void process_collision_events();
 
+//! Finish all particles remaining in any event queue using history-based
+//! transport and empty the queues
+void process_history_based_tail();
+
 //! Execute the death event for all particles
 //
 //! \param n_particles The number of particles in the particle buffer
@@ -52,6 +52,21 @@ bool check_cell_overlap(GeometryState& p, bool error = true);
 
 int cell_instance_at_level(const GeometryState& p, int level);
 
+//==============================================================================
+//! Get the cell instance of a particle at its lowest universe level
+//!
+//! The offsets of the levels above are computed once and kept on the
+//! particle's coordinates. They stay valid while the particle moves within a
+//! universe, cross_lattice updates them for the new tile, and find_cell
+//! resets those of the levels it searches below.
+//!
+//! \param p A particle whose coordinates were set by find_cell
+//! 
+eturn The instance of the cell at the lowest level
+//==============================================================================
+
+int lowest_cell_instance(GeometryState& p);
+
 //==============================================================================
 //! Locate a particle in the geometry tree and set its geometry data fields.
 //!
@@ -73,9 +88,24 @@ void cross_lattice(
 
 //==============================================================================
 //! Find the next boundary a particle will intersect.
+//!
+//! \param p  Geometry state of the particle
+//! \param n_levels  Number of coordinate levels, starting from the root
+//!   universe, whose boundaries are considered. All levels are considered if
+//!   C_NONE is given.
+//==============================================================================
+
+BoundaryInfo distance_to_boundary(GeometryState& p, int n_levels = C_NONE);
+
+//==============================================================================
+//! Find where a ray outside of the geometry enters it.
+//!
+//! \param p  Geometry state of the ray
+//! \return Distance along the ray to the geometry, or INFTY if the ray never
+//!   enters it
 //==============================================================================
 
-BoundaryInfo distance_to_boundary(GeometryState& p);
+double distance_to_geometry(GeometryState& p);
 
 } // namespace openmc
 
@@ -101,8 +101,17 @@ void count_cell_instances(int32_t univ_indx);
 //!   search_univ.
 //==============================================================================
 
-int count_universe_instances(int32_t search_univ, int32_t target_univ_id,
-  std::unordered_map<int32_t, int32_t>& univ_count_memo);
+int64_t count_universe_instances(int32_t search_univ, int32_t target_univ_id,
+  std::unordered_map<int32_t, int64_t>& univ_count_memo);
+
+//==============================================================================
+//! Convert a distribcell offset, which is counted in 64 bits, to the 32 bits
+//! stored in the offset tables
+//! \param offset The number of instances preceding a cell or lattice tile
+//! eturn The offset, which must be representable as a 32-bit integer
+//==============================================================================
+
+int32_t narrow_offset(int64_t offset);
 
 //==============================================================================
 //! Build a character array representing the path to a distribcell instance.
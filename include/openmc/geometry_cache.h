@@ -0,0 +1,35 @@
+//! \file geometry_cache.h
+//! Cache of the distribcell offsets and neighbor lists of a geometry, reused
+//! by later runs of the same input files
+
+#ifndef OPENMC_GEOMETRY_CACHE_H
+#define OPENMC_GEOMETRY_CACHE_H
+
+namespace openmc {
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Hash the input files and check whether the cache given by
+//! settings::path_geometry_cache was written for the same contents
+//
+//! Geometries with DAGMC universes are not cached since their cells are read
+//! from files that are not hashed.
+void open_geometry_cache();
+
+//! Read the distribcell offsets of cells and lattices from the cache
+//! \return Whether the cache held offsets matching the allocated tables
+bool read_cached_offsets();
+
+//! Read the neighbor lists of cells from the cache
+//! \return Whether the cache held neighbor lists
+bool read_cached_neighbor_lists();
+
+//! Write the cache if it is missing or was written for other input files.
+//! Only the master process writes the file.
+void write_geometry_cache();
+
+} // namespace openmc
+
+#endif // OPENMC_GEOMETRY_CACHE_H
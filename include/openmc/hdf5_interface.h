@@ -15,6 +15,7 @@
 #include "xtensor/xarray.hpp"
 
 #include "openmc/array.h"
+#include "openmc/constants.h"
 #include "openmc/error.h"
 #include "openmc/position.h"
 #include "openmc/vector.h"
@@ -35,10 +36,28 @@ void read_dataset_lowlevel(hid_t obj_id, const char* name, hid_t mem_type_id,
 
 void write_dataset_lowlevel(hid_t group_id, int ndim, const hsize_t* dims,
   const char* name, hid_t mem_type_id, hid_t mem_space_id, bool indep,
-  const void* buffer);
+  const void* buffer, hid_t dcpl = H5P_DEFAULT);
 
 bool using_mpio_device(hid_t obj_id);
 
+//! Create a dataset creation property list for a large dataset
+//
+//! The dataset is chunked and compressed with the filter chosen in the output
+//! settings. Datasets no larger than one chunk are stored contiguously.
+//! HDF5 only writes filtered datasets in parallel files collectively.
+//! \param[in] ndim  Number of dimensions of the dataset
+//! \param[in] dims  Size of each dimension
+//! \param[in] type_size  Size in bytes of one element
+//! \param[in] max_rows  Largest extent of a chunk in the first dimension, or 0
+//!   for no limit
+//! \return Property list to close with H5Pclose, or H5P_DEFAULT if the dataset
+//!   is not compressed
+hid_t create_compressed_plist(
+  int ndim, const hsize_t* dims, size_t type_size, hsize_t max_rows = 0);
+
+//! Whether HDF5 can apply a compression filter
+bool compression_available(OutputCompression filter);
+
 //==============================================================================
 // Normal functions that are used to read/write files
 //==============================================================================
@@ -51,6 +70,17 @@ inline hid_t create_group(hid_t parent_id, const std::stringstream& name)
 }
 
 hid_t file_open(const std::string& filename, char mode, bool parallel = false);
+
+//! Create an HDF5 file that is only held in memory
+//! \param[in] filename  Name of the file, used only in messages
+//! \return HDF5 identifier of the file
+hid_t file_open_memory(const std::string& filename);
+
+//! Close an HDF5 file and return its contents as they would be stored on disk
+//! \param[in] file_id  HDF5 identifier of the file
+//! \return Image of the file
+vector<char> file_close_image(hid_t file_id);
+
 hid_t open_group(hid_t group_id, const std::string& name);
 void write_string(
   hid_t group_id, const char* name, const std::string& buffer, bool indep);
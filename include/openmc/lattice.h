@@ -22,7 +22,7 @@ namespace openmc {
 
 constexpr int32_t NO_OUTER_UNIVERSE {-1};
 
-enum class LatticeType { rect, hex };
+enum class LatticeType { rect, hex, sphere_pack };
 
 //==============================================================================
 // Global variables
@@ -75,8 +75,8 @@ public:
   }
 
   //! Populate the distribcell offset tables.
-  int32_t fill_offset_table(int32_t offset, int32_t target_univ_id, int map,
-    std::unordered_map<int32_t, int32_t>& univ_count_memo);
+  int64_t fill_offset_table(int64_t offset, int32_t target_univ_id, int map,
+    std::unordered_map<int32_t, int64_t>& univ_count_memo);
 
   //! \brief Check lattice indices.
   //! \param i_xyz[3] The indices for a lattice tile.
@@ -294,6 +294,80 @@ private:
   Orientation orientation_; //!< Orientation of lattice
   Position center_;         //!< Global center of lattice
   array<double, 2> pitch_;  //!< Lattice tile width and height
+
+  //! Unit vectors in the xy-plane towards the flat sides of a tile in the
+  //! beta, gamma, and delta directions
+  array<array<double, 2>, 3> normals_;
+};
+
+//==============================================================================
+//! Spheres of equal radius, each filled with a universe, surrounded by the
+//! outer universe. This represents packed TRISO particles or pebbles without a
+//! cell for each sphere.
+//!
+//! Element i of the lattice is the inside of sphere i and the last element is
+//! the space between the spheres. Only the first index of a set of lattice
+//! indices is used, and coordinates local to a sphere are relative to its
+//! center. Spheres are found through a uniform grid over their centers.
+//==============================================================================
+
+class SpherePackLattice : public Lattice {
+public:
+  explicit SpherePackLattice(pugi::xml_node lat_node);
+
+  const int32_t& operator[](const array<int, 3>& i_xyz) override;
+
+  bool are_valid_indices(const array<int, 3>& i_xyz) const override;
+
+  std::pair<double, array<int, 3>> distance(
+    Position r, Direction u, const array<int, 3>& i_xyz) const override;
+
+  void get_indices(
+    Position r, Direction u, array<int, 3>& result) const override;
+
+  int get_flat_index(const array<int, 3>& i_xyz) const override;
+
+  Position get_local_position(
+    Position r, const array<int, 3>& i_xyz) const override;
+
+  int32_t& offset(int map, const array<int, 3>& i_xyz) override;
+
+  int32_t offset(int map, int indx) const override;
+
+  std::string index_to_string(int indx) const override;
+
+  void to_hdf5_inner(hid_t group_id) const override;
+
+private:
+  //! Index of the element for the space between the spheres
+  int matrix_index() const { return centers_.size(); }
+
+  //! Grid element containing a point, clamped to the grid
+  array<int, 3> grid_element(Position r) const;
+
+  //! Flat index of a grid element
+  int grid_flat_index(const array<int, 3>& ijk) const
+  {
+    return (ijk[2] * grid_shape_[1] + ijk[1]) * grid_shape_[0] + ijk[0];
+  }
+
+  //! Find the first sphere entered along a ray from the space between spheres
+  //! \param r Position relative to the lattice
+  //! \param u Direction
+  //! \return Distance to the sphere and its index, or C_NONE if none is hit
+  std::pair<double, int> next_sphere(Position r, Direction u) const;
+
+  double radius_;            //!< Radius of the spheres
+  vector<Position> centers_; //!< Centers of the spheres
+
+  Position grid_lower_left_; //!< Lower-left corner of the grid
+  double grid_width_;        //!< Width of each grid element
+  array<int, 3> grid_shape_; //!< Number of grid elements along each axis
+
+  //! Spheres overlapping each grid element, stored contiguously. The spheres
+  //! of element i are grid_spheres_[grid_offsets_[i]:grid_offsets_[i + 1]].
+  vector<int> grid_offsets_;
+  vector<int> grid_spheres_;
 };
 
 //==============================================================================
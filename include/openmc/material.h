@@ -14,6 +14,7 @@
 #include "openmc/memory.h" // for unique_ptr
 #include "openmc/ncrystal_interface.h"
 #include "openmc/particle.h"
+#include "openmc/photon.h"
 #include "openmc/vector.h"
 
 namespace openmc {
@@ -28,6 +29,7 @@ namespace model {
 
 extern std::unordered_map<int32_t, int32_t> material_map;
 extern vector<unique_ptr<Material>> materials;
+extern int max_material_nuclides; //!< Most nuclides in any one material
 
 } // namespace model
 
@@ -56,6 +58,25 @@ public:
 
   void calculate_xs(Particle& p) const;
 
+  //! Calculate neutron cross sections for several particles in this material
+  //! at once, looping over nuclides in the outer loop so that each nuclide's
+  //! data stays in cache while it is used by every particle
+  //
+  //! \param[in,out] particles  Neutrons currently in this material
+  void calculate_neutron_xs_batch(gsl::span<Particle*> particles) const;
+
+  //! Calculate photon cross sections by summing those of each element
+  //
+  //! The microscopic cross sections of the elements and the running sum used
+  //! to sample the collision element are always set, even when the material
+  //! has tabulated photon cross sections.
+  //! \param[in,out] p  Photon in this material
+  void calculate_element_photon_xs(Particle& p) const;
+
+  //! Tabulate macroscopic photon cross sections on a log-uniform energy grid
+  //! to within settings::photon_xs_tolerance
+  void init_photon_xs_table();
+
   //! Assign thermal scattering tables to specific nuclides within the material
   //! so the code knows when to apply bound thermal scattering data
   void init_thermal();
@@ -192,6 +213,10 @@ public:
 
   unique_ptr<Bremsstrahlung> ttb_;
 
+  // Macroscopic photon cross sections on a log-uniform energy grid. Empty
+  // unless settings::photon_material_xs is set.
+  PhotonXSTable photon_xs_table_;
+
 private:
   //----------------------------------------------------------------------------
   // Private methods
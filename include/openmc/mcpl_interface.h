@@ -23,11 +23,17 @@ extern "C" const bool MCPL_ENABLED;
 //! Get a vector of source sites from an MCPL file
 //
 //! \param[in] path  Path to MCPL file
+//! \param[in] partitioned  Whether to read only the contiguous part of the
+//!                         file that belongs to this MPI rank
 //! \return  Vector of source sites
-vector<SourceSite> mcpl_source_sites(std::string path);
+vector<SourceSite> mcpl_source_sites(
+  std::string path, bool partitioned = false);
 
 //! Write an MCPL source file
 //
+//! With more than one MPI rank, each rank writes its sites to a file of its
+//! own and the master rank joins the files.
+//!
 //! \param[in] filename     Path to MCPL file
 //! \param[in] source_bank  Vector of SourceSites to write to file for this
 //!                         MPI rank
@@ -37,6 +43,21 @@ vector<SourceSite> mcpl_source_sites(std::string path);
 //!                         source_bank.size().
 void write_mcpl_source_point(const char* filename,
   gsl::span<SourceSite> source_bank, vector<int64_t> const& bank_index);
+
+//! Create an MCPL file that source sites are appended to by
+//! append_mcpl_source_sites(). Only one such file can be open at a time.
+//
+//! \param[in] filename  Path to MCPL file
+void open_mcpl_appended_file(const std::string& filename);
+
+//! Append source sites to the file opened by open_mcpl_appended_file()
+//
+//! \param[in] sites  Source sites to write
+void append_mcpl_source_sites(gsl::span<const SourceSite> sites);
+
+//! Close the file opened by open_mcpl_appended_file()
+void close_mcpl_appended_file();
+
 } // namespace openmc
 
 #endif // OPENMC_MCPL_INTERFACE_H
@@ -0,0 +1,78 @@
+//! \file memory_report.h
+//! Accounting of the memory used by each part of a simulation
+
+#ifndef OPENMC_MEMORY_REPORT_H
+#define OPENMC_MEMORY_REPORT_H
+
+#include <string>
+
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Memory used by one object or by a group of objects
+//==============================================================================
+
+struct MemoryUse {
+  std::string category; //!< Subsystem, e.g. "Tallies"
+  std::string name;     //!< Object within the subsystem, e.g. "Tally 3"
+  double size;          //!< Memory used in [MB]
+};
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace data {
+
+//! Growth of the resident memory while cross sections were read in [MB]
+extern double nuclear_data_memory;
+
+} // namespace data
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Memory allocated by the elements of a vector in [MB]
+template<typename T>
+double vector_memory(const vector<T>& v)
+{
+  return v.capacity() * sizeof(T) / 1.0e6;
+}
+
+//! Memory allocated by the elements of a vector of vectors in [MB]
+template<typename T>
+double vector_memory(const vector<vector<T>>& v)
+{
+  double size = vector_memory<vector<T>>(v);
+  for (const auto& x : v)
+    size += vector_memory(x);
+  return size;
+}
+
+//! Resident memory of this process in [MB], or zero if it cannot be
+//! determined
+double resident_memory();
+
+//! Largest resident memory of this process so far in [MB], or zero if it
+//! cannot be determined
+double max_resident_memory();
+
+//! Memory used by the nuclear data, tallies, meshes, particle buffers, banks,
+//! geometry, and weight windows of this process
+vector<MemoryUse> memory_usage();
+
+//! Display the memory used by each subsystem per process and in total along
+//! with the largest tallies and meshes. This must be called on all processes.
+//
+//! \param[in] title  Title of the report
+//! \param[in] extra  Memory used by objects that are not global, such as the
+//!   source regions of a random ray solve
+void print_memory_report(
+  const std::string& title, const vector<MemoryUse>& extra = {});
+
+} // namespace openmc
+
+#endif // OPENMC_MEMORY_REPORT_H
@@ -11,6 +11,7 @@
 #include "xtensor/xtensor.hpp"
 #include <gsl/gsl-lite.hpp>
 
+#include "openmc/array.h"
 #include "openmc/bounding_box.h"
 #include "openmc/error.h"
 #include "openmc/memory.h" // for unique_ptr
@@ -124,6 +125,21 @@ public:
   //! \return Mesh bin
   virtual int get_bin(Position r) const = 0;
 
+  //! Get bin at a position in space, given the bin at a nearby position
+  //
+  //! \param[in] r Position to get bin for
+  //! \param[in] bin Mesh bin at a nearby position, or a negative value if
+  //!   unknown
+  //! \return Mesh bin
+  virtual int get_bin_near(Position r, int bin) const { return get_bin(r); }
+
+  //! Get the bins of many positions in space
+  //
+  //! \param[in] r Positions to get bins for
+  //! \param[out] bins Mesh bin of each position, or -1 if it is outside the
+  //!   mesh
+  virtual void get_bins(gsl::span<const Position> r, gsl::span<int> bins) const;
+
   //! Get the number of mesh cells.
   virtual int n_bins() const = 0;
 
@@ -167,6 +183,10 @@ public:
 
   virtual std::string get_mesh_type() const = 0;
 
+  //! Memory used by the definition of the mesh elements in [MB]. This is zero
+  //! for meshes defined by a few parameters or held by an external library.
+  virtual double memory() const { return 0.0; }
+
   //! Determine volume of materials within a single mesh elemenet
   //
   //! \param[in] n_sample Number of samples within each element
@@ -186,6 +206,18 @@ public:
   vector<MaterialVolume> material_volumes(
     int n_sample, int bin, uint64_t* seed) const;
 
+  //! Determine volume of materials within all mesh elements by ray tracing
+  //
+  //! Rays are traced along each axis from a uniform grid over the opposite
+  //! face of the bounding box of the mesh. The exact length of each ray in
+  //! each material within an element, multiplied by the area the ray
+  //! represents, gives the volumes, which are averaged over the three axes.
+  //
+  //! \param[in] n_rays Number of rays across the bounding box in each direction
+  //! \return Vector of (material index, volume) for each element
+  vector<vector<MaterialVolume>> traced_material_volumes(
+    const array<int, 3>& n_rays) const;
+
   //! Determine bounding box of mesh
   //
   //! \return Bounding box of mesh
@@ -247,6 +279,18 @@ public:
   void surface_bins_crossed(Position r0, Position r1, const Direction& u,
     vector<int>& bins) const override;
 
+  //! Determine which bins were crossed by a particle and where along the track
+  //! each was entered
+  //
+  //! \param[in] r0 Previous position of the particle
+  //! \param[in] r1 Current position of the particle
+  //! \param[in] u Particle direction
+  //! \param[out] bins Bins that were crossed, in order along the track
+  //! \param[out] starts Fraction of tracklength before entering each bin
+  //! \param[out] lengths Fraction of tracklength in each bin
+  void segments_crossed(Position r0, Position r1, const Direction& u,
+    vector<int>& bins, vector<double>& starts, vector<double>& lengths) const;
+
   //! Determine which cell or surface bins were crossed by a particle
   //
   //! \param[in] r0 Previous position of the particle
@@ -400,6 +444,13 @@ public:
   // Overridden methods
   int get_index_in_direction(double r, int i) const override;
 
+  //! Get the bin at a position directly from the uniform spacing, without
+  //! finding the index along each direction through virtual calls
+  int get_bin(Position r) const final;
+
+  void get_bins(
+    gsl::span<const Position> r, gsl::span<int> bins) const override;
+
   virtual std::string get_mesh_type() const override;
 
   static const std::string mesh_type;
@@ -407,6 +458,12 @@ public:
   MeshDistance distance_to_grid_boundary(const MeshIndex& ijk, int i,
     const Position& r0, const Direction& u, double l) const override;
 
+  //! Determine which bins were crossed by a particle with a 3D-DDA traversal
+  //! that takes advantage of the uniform spacing of the mesh. Tracks starting
+  //! outside of the mesh use the general traversal.
+  void bins_crossed(Position r0, Position r1, const Direction& u,
+    vector<int>& bins, vector<double>& lengths) const override;
+
   std::pair<vector<double>, vector<double>> plot(
     Position plot_ll, Position plot_ur) const override;
 
@@ -450,8 +507,12 @@ public:
   // Overridden methods
   int get_index_in_direction(double r, int i) const override;
 
+  int get_bin_near(Position r, int bin) const override;
+
   virtual std::string get_mesh_type() const override;
 
+  double memory() const override;
+
   static const std::string mesh_type;
 
   MeshDistance distance_to_grid_boundary(const MeshIndex& ijk, int i,
@@ -496,6 +557,8 @@ public:
 
   virtual std::string get_mesh_type() const override;
 
+  double memory() const override;
+
   static const std::string mesh_type;
 
   Position sample_element(const MeshIndex& ijk, uint64_t* seed) const override;
@@ -521,7 +584,8 @@ public:
   array<vector<double>, 3> grid_;
 
 private:
-  double find_r_crossing(
+  //! Find the nearest crossing of the inner or outer boundary of a shell
+  StructuredMesh::MeshDistance find_r_crossing(
     const Position& r, const Direction& u, double l, int shell) const;
   double find_phi_crossing(
     const Position& r, const Direction& u, double l, int shell) const;
@@ -530,6 +594,10 @@ private:
 
   bool full_phi_ {false};
 
+  vector<double> r_sq_;    //!< Square of each r-grid value
+  vector<double> phi_cos_; //!< Cosine of each phi-grid value
+  vector<double> phi_sin_; //!< Sine of each phi-grid value
+
   inline int sanitize_angular_index(int idx, bool full, int N) const
   {
     if ((idx > 0) and (idx <= N)) {
@@ -560,6 +628,8 @@ public:
 
   virtual std::string get_mesh_type() const override;
 
+  double memory() const override;
+
   static const std::string mesh_type;
 
   Position sample_element(const MeshIndex& ijk, uint64_t* seed) const override;
@@ -582,9 +652,11 @@ public:
   array<vector<double>, 3> grid_;
 
 private:
-  double find_r_crossing(
+  //! Find the nearest crossing of the inner or outer boundary of a shell
+  StructuredMesh::MeshDistance find_r_crossing(
     const Position& r, const Direction& u, double l, int shell) const;
-  double find_theta_crossing(
+  //! Find the nearest crossing of either theta boundary of a shell
+  StructuredMesh::MeshDistance find_theta_crossing(
     const Position& r, const Direction& u, double l, int shell) const;
   double find_phi_crossing(
     const Position& r, const Direction& u, double l, int shell) const;
@@ -592,6 +664,11 @@ private:
   bool full_theta_ {false};
   bool full_phi_ {false};
 
+  vector<double> r_sq_;      //!< Square of each r-grid value
+  vector<double> theta_cos_; //!< Cosine of each theta-grid value
+  vector<double> phi_cos_;   //!< Cosine of each phi-grid value
+  vector<double> phi_sin_;   //!< Sine of each phi-grid value
+
   inline int sanitize_angular_index(int idx, bool full, int N) const
   {
     if ((idx > 0) and (idx <= N)) {
@@ -615,6 +692,94 @@ private:
   }
 };
 
+//==============================================================================
+//! Regular grid of root cells, each recursively split into eight octants
+//! where finer resolution is needed
+//
+//! The refinement of each root cell is given by a preorder list of flags: 1 if
+//! the cell is split, followed by the flags of its eight octants ordered with x
+//! varying fastest, or 0 if it is an element of the mesh. Elements are numbered
+//! in the order their flags appear.
+//==============================================================================
+
+class OctreeMesh : public Mesh {
+public:
+  // Constructors
+  OctreeMesh() = default;
+  OctreeMesh(pugi::xml_node node);
+
+  // Overridden methods
+  Position sample_element(int32_t bin, uint64_t* seed) const override;
+
+  //! Determine which bins were crossed by a particle by stepping from element
+  //! to element through the exit face of each
+  void bins_crossed(Position r0, Position r1, const Direction& u,
+    vector<int>& bins, vector<double>& lengths) const override;
+
+  void surface_bins_crossed(Position r0, Position r1, const Direction& u,
+    vector<int>& bins) const override;
+
+  int get_bin(Position r) const override;
+
+  int n_bins() const override { return boxes_.size(); }
+
+  int n_surface_bins() const override { return 0; }
+
+  void to_hdf5(hid_t group) const override;
+
+  //! Find the root grid lines that intersect an axis-aligned slice plot
+  std::pair<vector<double>, vector<double>> plot(
+    Position plot_ll, Position plot_ur) const override;
+
+  std::string bin_label(int bin) const override;
+
+  double volume(int bin) const override;
+
+  std::string get_mesh_type() const override;
+
+  double memory() const override;
+
+  static const std::string mesh_type;
+
+  Position lower_left() const override
+  {
+    return {lower_left_[0], lower_left_[1], lower_left_[2]};
+  }
+  Position upper_right() const override
+  {
+    return {upper_right_[0], upper_right_[1], upper_right_[2]};
+  }
+
+  // Accessors
+  //! Bounding box of a mesh element
+  const BoundingBox& element_box(int bin) const { return boxes_[bin]; }
+
+  //! Number of times the root cell of a mesh element was split to reach it
+  int level(int bin) const { return levels_[bin]; }
+
+private:
+  struct Node {
+    int child {-1}; //!< Index of the first of eight octants, or -1 if a leaf
+    int bin {-1};   //!< Mesh bin of a leaf
+  };
+
+  //! Build the tree of one root cell from the flags starting at a position
+  //
+  //! \param[in] node Index of the node in nodes_
+  //! \param[in] box Bounding box of the node
+  //! \param[in] level Refinement level of the node
+  //! \param[inout] pos Position in refinement_ of the flag of the node
+  void build(int node, const BoundingBox& box, int level, size_t& pos);
+
+  // Data members
+  array<int, 3> shape_;       //!< Number of root cells in each direction
+  Position width_;            //!< Width of the root cells
+  vector<int> refinement_;    //!< Preorder split flags of the root cells
+  vector<Node> nodes_;        //!< Root cells followed by split octants
+  vector<BoundingBox> boxes_; //!< Bounding box of each element
+  vector<int> levels_;        //!< Refinement level of each element
+};
+
 // Abstract class for unstructured meshes
 class UnstructuredMesh : public Mesh {
 
@@ -799,6 +964,32 @@ private:
   void intersect_track(const moab::CartVect& start, const moab::CartVect& dir,
     double track_len, vector<double>& hits) const;
 
+  //! Find the tetrahedra crossed by a track by walking from tet to tet
+  //! across their faces
+  //
+  //! \param[in] r0 Starting position of the track
+  //! \param[in] u Direction of the track
+  //! \param[in] track_len Length of the track
+  //! \param[out] bins Bins crossed by the track
+  //! \param[out] lengths Fraction of the track length in each bin
+  void walk_track(Position r0, const Direction& u, double track_len,
+    vector<int>& bins, vector<double>& lengths) const;
+
+  //! Find where a track outside of the mesh next enters it
+  //
+  //! \param[in] r0 Starting position of the track
+  //! \param[in] u Direction of the track
+  //! \param[in] t Distance along the track from which to search
+  //! \param[in] track_len Length of the track
+  //! \param[out] t_entry Distance along the track at which the mesh is entered
+  //! \return Bin entered, or -1 if the track does not enter the mesh
+  int find_entry(Position r0, const Direction& u, double t, double track_len,
+    double* t_entry) const;
+
+  //! Compute the face adjacency of all tetrahedra and, for the adjacency
+  //! walk, the planes of their faces
+  void compute_adjacency_data();
+
   //! Calculate the volume for a given tetrahedron handle.
   //
   // \param[in] tet MOAB EntityHandle of the tetrahedron
@@ -887,6 +1078,17 @@ private:
   std::shared_ptr<moab::Interface> mbi_;    //!< MOAB instance
   unique_ptr<moab::AdaptiveKDTree> kdtree_; //!< MOAB KDTree instance
   vector<moab::Matrix3> baryc_data_;        //!< Barycentric data for tetrahedra
+  bool adjacency_walk_ {false}; //!< Whether tracks walk across tet faces
+
+  // Outward unit normals and offsets of the planes of the tet faces, with four
+  // consecutive entries per bin. The face at index 4*bin + k is opposite the
+  // k-th vertex of the tet.
+  vector<double> face_nx_;
+  vector<double> face_ny_;
+  vector<double> face_nz_;
+  vector<double> face_d_;
+  vector<int> face_neighbor_; //!< Bin across each face, or -1 on the boundary
+  mutable vector<int> last_bin_; //!< Per-thread bin of the last tet found
   vector<std::string> tag_names_; //!< Names of score tags added to the mesh
 };
 
@@ -957,6 +1159,24 @@ private:
   //! Translate an element pointer to a bin index
   int get_bin_from_element(const libMesh::Elem* elem) const;
 
+  //! Find the element containing a point, checking the element found last by
+  //! the calling thread and its neighbors before the point locator
+  //
+  //! \param[in] p  Point to locate
+  //! \return Element containing the point, or nullptr if outside the mesh
+  const libMesh::Elem* locate(const libMesh::Point& p) const;
+
+  //! Find where a track first enters the mesh through a boundary side
+  //
+  //! \param[in] r0  Start of the track
+  //! \param[in] u  Direction of the track
+  //! \param[in] t_min  Distance along the track at which to start searching
+  //! \param[in] t_max  Length of the track
+  //! \return Element entered and distance along the track at which it is
+  //!   entered, or nullptr and t_max if the track does not enter the mesh
+  std::pair<const libMesh::Elem*, double> find_entry(
+    Position r0, Direction u, double t_min, double t_max) const;
+
   // Data members
   unique_ptr<libMesh::MeshBase> unique_m_ =
     nullptr; //!< pointer to the libMesh MeshBase instance, only used if mesh is
@@ -965,6 +1185,8 @@ private:
                          //!< during intialization
   vector<unique_ptr<libMesh::PointLocatorBase>>
     pl_; //!< per-thread point locators
+  mutable vector<const libMesh::Elem*>
+    last_elem_; //!< per-thread element found by the last point location
   unique_ptr<libMesh::EquationSystems>
     equation_systems_; //!< pointer to the equation systems of the mesh
   std::string
@@ -973,6 +1195,9 @@ private:
     variable_map_; //!< mapping of variable names (tally scores) to libMesh
                    //!< variable numbers
   libMesh::BoundingBox bbox_; //!< bounding box of the mesh
+  vector<std::pair<libMesh::dof_id_type, unsigned int>>
+    boundary_sides_; //!< element and side index of each side on the
+                     //!< boundary of the mesh or of a hole in it
   libMesh::dof_id_type
     first_element_id_; //!< id of the first element in the mesh
 };
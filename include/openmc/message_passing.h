@@ -7,6 +7,8 @@
 #include <mpi.h>
 #endif
 
+#include <gsl/gsl-lite.hpp>
+
 #include "openmc/vector.h"
 
 namespace openmc {
@@ -18,8 +20,13 @@ extern bool master;
 
 #ifdef OPENMC_MPI
 extern MPI_Datatype source_site;
+extern MPI_Datatype fission_site; //!< source site without unused fields
 extern MPI_Comm intracomm;
+extern MPI_Comm node_intracomm; //!< processes on the same node
+//! First process of each node, or MPI_COMM_NULL on the other processes
+extern MPI_Comm leader_intracomm;
 #endif
+extern int n_nodes; //!< number of nodes the processes run on
 
 // Calculates global indices of the bank particles
 // across all ranks using a parallel scan. This is used to write
@@ -33,6 +40,49 @@ extern MPI_Comm intracomm;
 // plus one.
 vector<int64_t> calculate_parallel_index_vector(int64_t size);
 
+//! Move an array to memory shared by all processes on the same node
+//
+//! This must be called by every process on the node in the same order with
+//! arrays of the same size. The array of the first process on the node is
+//! copied into memory shared by the node and the array of every process is
+//! then released. Without MPI, the array is left in place.
+//!
+//! \param[inout] data  Array to share
+//! \return View of the shared array
+gsl::span<double> share_on_node(vector<double>& data);
+gsl::span<float> share_on_node(vector<float>& data);
+
+//! Release all memory shared by the processes on a node
+void free_shared_memory();
+
+#ifdef OPENMC_MPI
+//! Sum an array onto the master process
+//
+//! When settings::hierarchical_reduce is on and there are several processes
+//! on several nodes, the array is first summed onto the first process of each
+//! node, which only moves data through the shared memory of the node, and the
+//! node sums are then reduced across nodes. The array is split into segments
+//! so that the reduction of one segment across nodes proceeds while the next
+//! is summed on the node. This must be called on all processes.
+//!
+//! \param[in] values  Values of this process
+//! \param[out] reduced  Sums, only written on the master process
+//! \param[in] n  Number of values
+//! \param[out] requests  If given, the reductions across nodes, or all
+//!   reductions without a hierarchy, are started without waiting for them to
+//!   complete and their requests are appended. Only one such reduction may be
+//!   in progress at a time.
+void reduce_sum(const double* values, double* reduced, int64_t n,
+  vector<MPI_Request>* requests = nullptr);
+
+//! Sum an array in place over all processes, with the same hierarchy and
+//! segments as reduce_sum(). This must be called on all processes.
+//
+//! \param[inout] values  Values of this process, replaced by the sums
+//! \param[in] n  Number of values
+void allreduce_sum(double* values, int64_t n);
+#endif
+
 } // namespace mpi
 } // namespace openmc
 
@@ -34,6 +34,13 @@ private:
   vector<double> polar;
   vector<double> azimuthal;
 
+  //! Total, absorption, and nu-fission cross sections, in that order, for
+  //! each temperature, angle, and group, stored contiguously for lookups
+  //! during tracking
+  vector<double> tracking_xs;
+  int n_ang {0};           //!< Number of angles in tracking_xs
+  void init_tracking_xs(); //!< Pack the cross sections into tracking_xs
+
   //! \brief Initializes the Mgxs object metadata
   //!
   //! @param in_name Name of the object.
@@ -173,6 +180,9 @@ public:
 
   //! \brief Sets the angle index in the particle's cache.
   //!
+  //! The index is only found again if the direction or the angular bins
+  //! differ from those it was last found for.
+  //!
   //! @param p Particle.
   void set_angle_index(Particle& p);
 
@@ -7,9 +7,12 @@
 #endif
 
 #include "openmc/particle.h"
+#include "openmc/vector.h"
 
-#include <cstdint> // for uint64_t
-#include <limits>  // for numeric_limits
+#include <cstdint>    // for uint64_t
+#include <functional> // for function
+#include <limits>     // for numeric_limits
+#include <memory>     // for shared_ptr
 #include <string>
 
 namespace openmc {
@@ -23,6 +26,53 @@ extern "C" const bool NCRYSTAL_ENABLED;
 //! Energy in [eV] to switch between NCrystal and ENDF
 constexpr double NCRYSTAL_MAX_ENERGY {5.0};
 
+//! Lowest energy in [eV] of the tabulated NCrystal cross sections
+constexpr double NCRYSTAL_TABLE_MIN_ENERGY {1.0e-5};
+
+//==============================================================================
+//! Cross section of an isotropic NCrystal material tabulated on a log-uniform
+//! energy grid
+//==============================================================================
+
+class NCrystalXSTable {
+public:
+  //! Tabulate a cross section on a grid that is refined until linear
+  //! interpolation reproduces it to within a relative tolerance at the middle
+  //! of each interval
+  //
+  //! Intervals that still miss the tolerance on the finest grid, such as
+  //! those containing a large Bragg edge, are not interpolated.
+  //! \param[in] log_E_min Log of the lowest energy in [eV]
+  //! \param[in] log_E_max Log of the highest energy in [eV]
+  //! \param[in] tolerance Relative tolerance
+  //! \param[in] evaluate Function giving the cross section at a log energy
+  NCrystalXSTable(double log_E_min, double log_E_max, double tolerance,
+    const std::function<double(double)>& evaluate);
+
+  //! Interpolate the cross section
+  //
+  //! \param[in] log_E Log of the energy in [eV]
+  //! \param[out] xs Cross section in [b]
+  //! \return Whether the table could be interpolated at the energy
+  bool interpolate(double log_E, double& xs) const
+  {
+    double x = (log_E - log_E_min_) * inv_spacing_;
+    if (!(x >= 0.0 && x < exact_.size()))
+      return false;
+    int j = x;
+    if (exact_[j])
+      return false;
+    xs = values_[j] + (x - j) * (values_[j + 1] - values_[j]);
+    return true;
+  }
+
+private:
+  vector<double> values_;    //!< Cross section at each point of the grid
+  vector<bool> exact_;       //!< Is each interval evaluated by NCrystal?
+  double log_E_min_ {0.0};   //!< Log of the lowest energy of the grid
+  double inv_spacing_ {0.0}; //!< Inverse spacing of the grid in log E
+};
+
 //==============================================================================
 // Wrapper class an NCrystal material
 //==============================================================================
@@ -80,6 +130,11 @@ private:
   std::string cfg_; //!< NCrystal configuration string
   std::shared_ptr<const NCrystal::ProcImpl::Process>
     ptr_; //!< Pointer to NCrystal material object
+
+  //! Tabulated cross section, shared by the copies of the material. Null
+  //! unless settings::ncrystal_xs_tolerance is positive and the material is
+  //! not oriented.
+  std::shared_ptr<const NCrystalXSTable> table_;
 #endif
 };
 
@@ -2,63 +2,106 @@
 #define OPENMC_NEIGHBOR_LIST_H
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <forward_list>
-#include <mutex>
+#include <utility> // for pair
 
-#include "openmc/openmp_interface.h"
+#include "openmc/array.h"
+#include "openmc/constants.h"
 
 namespace openmc {
 
 //==============================================================================
-//! A threadsafe, dynamic container for listing neighboring cells.
+//! A threadsafe, fixed-capacity container for listing neighboring cells.
 //
-//! This container is a reduced interface for a linked list with an added OpenMP
-//! lock for write operations.  It allows for threadsafe dynamic growth; any
-//! number of threads can safely read data without locks or reference counting.
+//! Elements are stored contiguously and appended without locks by claiming
+//! the first empty slot with a compare-and-swap, so any number of threads can
+//! read and add elements at the same time. Once the list is full, further
+//! neighbors are not recorded and are found by an exhaustive search instead.
+//!
+//! The number of times each element was found to contain a particle can be
+//! counted, and the elements reordered so that the most likely neighbor is
+//! checked first. Reordering is not threadsafe and may only be done between
+//! batches.
 //==============================================================================
 
 class NeighborList {
 public:
   using value_type = int32_t;
-  using const_iterator = std::forward_list<value_type>::const_iterator;
 
-  // Attempt to add an element.
+  //! Maximum number of neighbors recorded per cell
+  static constexpr int CAPACITY {16};
+
+  NeighborList()
+  {
+    for (int i = 0; i < CAPACITY; ++i) {
+      elems_[i].store(C_NONE, std::memory_order_relaxed);
+      hits_[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  NeighborList(const NeighborList& other) { *this = other; }
+
+  NeighborList& operator=(const NeighborList& other)
+  {
+    for (int i = 0; i < CAPACITY; ++i) {
+      elems_[i].store(other.elems_[i].load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+      hits_[i].store(other.hits_[i].load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    }
+    return *this;
+  }
+
+  //! Add an element unless it is already present or the list is full
   //
-  // If the relevant OpenMP lock is currently owned by another thread, this
-  // function will return without actually modifying the data.  It has been
-  // found that returning the transport calculation and possibly re-adding the
-  // element later is slightly faster than waiting on the lock to be released.
-  void push_back(int new_elem)
+  //! It is possible another thread already added this element to the list
+  //! while this thread was searching for a cell, in which case the element is
+  //! found while looking for an empty slot.
+  void push_back(value_type new_elem)
   {
-    // Try to acquire the lock.
-    std::unique_lock<OpenMPMutex> lock(mutex_, std::try_to_lock);
-    if (lock) {
-      // It is possible another thread already added this element to the list
-      // while this thread was searching for a cell so make sure the given
-      // element isn't a duplicate before adding it.
-      if (std::find(list_.cbegin(), list_.cend(), new_elem) == list_.cend()) {
-        // Find the end of the list and add the the new element there.
-        if (!list_.empty()) {
-          auto it1 = list_.cbegin();
-          auto it2 = ++list_.cbegin();
-          while (it2 != list_.cend())
-            it1 = it2++;
-          list_.insert_after(it1, new_elem);
-        } else {
-          list_.push_front(new_elem);
-        }
-      }
+    for (auto& slot : elems_) {
+      value_type elem = slot.load(std::memory_order_acquire);
+      if (elem == C_NONE && slot.compare_exchange_strong(elem, new_elem,
+                              std::memory_order_acq_rel))
+        return;
+      // On failure, elem holds the element another thread stored in the slot
+      if (elem == new_elem)
+        return;
     }
   }
 
-  const_iterator cbegin() const { return list_.cbegin(); }
+  //! Element at a position, or C_NONE past the last element
+  value_type operator[](int i) const
+  {
+    return elems_[i].load(std::memory_order_acquire);
+  }
+
+  //! Count that the element at a position contained a particle
+  void hit(int i) const { hits_[i].fetch_add(1, std::memory_order_relaxed); }
 
-  const_iterator cend() const { return list_.cend(); }
+  //! Sort the elements by decreasing number of hits
+  void reorder()
+  {
+    array<std::pair<uint32_t, value_type>, CAPACITY> entries;
+    int n = 0;
+    for (; n < CAPACITY; ++n) {
+      value_type elem = elems_[n].load(std::memory_order_relaxed);
+      if (elem == C_NONE)
+        break;
+      entries[n] = {hits_[n].load(std::memory_order_relaxed), elem};
+    }
+    std::stable_sort(entries.begin(), entries.begin() + n,
+      [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (int i = 0; i < n; ++i) {
+      hits_[i].store(entries[i].first, std::memory_order_relaxed);
+      elems_[i].store(entries[i].second, std::memory_order_relaxed);
+    }
+  }
 
 private:
-  std::forward_list<value_type> list_;
-  OpenMPMutex mutex_;
+  array<std::atomic<value_type>, CAPACITY> elems_;
+  mutable array<std::atomic<uint32_t>, CAPACITY> hits_;
 };
 
 } // namespace openmc
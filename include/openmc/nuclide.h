@@ -17,12 +17,29 @@
 #include "openmc/particle.h"
 #include "openmc/reaction.h"
 #include "openmc/reaction_product.h"
+#include "openmc/search.h"
 #include "openmc/urr.h"
 #include "openmc/vector.h"
 #include "openmc/wmp.h"
 
+#include "xtensor/xadapt.hpp"
+
 namespace openmc {
 
+//==============================================================================
+//! Tabulated cross sections of every nuclide and temperature stored end to
+//! end, one array per reaction, so that lookups for several nuclides can be
+//! gathered from a common base address
+//==============================================================================
+
+struct PackedXS {
+  vector<double> total;
+  vector<double> absorption;
+  vector<double> fission;
+  vector<double> nu_fission;
+  vector<double> photon_prod;
+};
+
 //==============================================================================
 // Data for a nuclide
 //==============================================================================
@@ -34,27 +51,155 @@ public:
   using EmissionMode = ReactionProduct::EmissionMode;
   struct EnergyGrid {
     vector<int> grid_index;
+    vector<int> union_index; //!< Index on this grid for each unionized point
     vector<double> energy;
   };
 
+  //! Running sums of the cross sections of a sequence of reactions, e.g. those
+  //! of index_inelastic_scatter_, at each energy point from the lowest
+  //! threshold
+  struct ReactionCDF {
+    int i_start {0};      //!< Index on the energy grid of the first point
+    vector<double> value; //!< Running sums with a row for each energy point
+  };
+
+  //! Cross sections at one temperature with a row for each energy point. The
+  //! table views either xs_data_, memory shared by the processes on a node,
+  //! or the cross section cache.
+  using XsTable = decltype(xt::adapt(std::declval<double*>(), size_t {},
+    xt::no_ownership(), std::declval<array<size_t, 2>>()));
+
   //============================================================================
   // Constructors/destructors
-  Nuclide(hid_t group, const vector<double>& temperature);
+  //! Read a nuclide from HDF5 data
+  //
+  //! \param[in] group  HDF5 group containing the nuclide data
+  //! \param[in] temperature  Desired temperatures in [K]
+  //! \param[in] derive  Whether to set up derived cross sections, otherwise
+  //!   create_derived() must be called before the nuclide is used
+  Nuclide(
+    hid_t group, const vector<double>& temperature, bool derive = true);
   ~Nuclide();
 
   //============================================================================
   // Methods
 
   //! Initialize logarithmic grid for energy searches
-  void init_grid();
+  //
+  //! The grid is left as is if it was built for the same energy limits and
+  //! number of bins by an earlier simulation.
+  //! \return Whether the grid was rebuilt
+  bool init_grid();
 
   //! Calculate microscopic cross sections
   //
   //! \param[in] i_sab  Index in data::thermal_scatt
-  //! \param[in] i_log_union  Log-grid search index
+  //! \param[in] i_log_union  Log-grid or unionized grid search index
   //! \param[in] sab_frac  S(a,b) table fraction
   //! \param[in,out] p  Particle object
-  void calculate_xs(int i_sab, int i_log_union, double sab_frac, Particle& p);
+  //! \param[in] i_temp  Temperature index if already selected, otherwise
+  //!   C_NONE
+  void calculate_xs(int i_sab, int i_log_union, double sab_frac, Particle& p,
+    int i_temp = C_NONE);
+
+  //! Calculate microscopic cross sections from multipole data for several
+  //! neutrons with energies in the multipole range
+  //
+  //! Neutrons sorted by energy are evaluated together so that the poles of
+  //! each window are read once for all neutrons in the window.
+  //
+  //! \param[in,out] particles  Particles to calculate cross sections for
+  //! \param[in] i_sab  Index in data::thermal_scatt for each particle
+  //! \param[in] sab_frac  S(a,b) table fraction for each particle
+  void calculate_multipole_xs(gsl::span<Particle* const> particles,
+    const int* i_sab, const double* sab_frac);
+
+  //! Sample an inelastic scattering reaction
+  //
+  //! \param[in] micro  Microscopic cross sections of the nuclide
+  //! \param[in] prob  Cumulative probability before the inelastic reactions
+  //! \param[in] cutoff  Random cutoff to compare the cumulative probability to
+  //! \return Index in reactions_ of the sampled reaction
+  int sample_inelastic_scatter(
+    const NuclideMicroXS& micro, double prob, double cutoff) const;
+
+  //! Find the photon product at which the tabulated running sums of the
+  //! photon production cross sections first exceed a cutoff
+  //
+  //! \param[in] micro  Microscopic cross sections of the nuclide
+  //! \param[in] cutoff  Random cutoff between zero and micro.photon_prod
+  //! \return Index in photon_products_, or C_NONE if the sums are not
+  //!   tabulated at the temperature of micro
+  int find_photon_product(const NuclideMicroXS& micro, double cutoff) const;
+
+  //! Determine the temperature index used to evaluate cross sections,
+  //! sampling between bounding temperatures when interpolating
+  //
+  //! \param[in,out] p  Particle object
+  //! \return Index in kTs_
+  int temperature_index(Particle& p) const;
+
+  //! Determine the lower bounding index on the energy grid
+  //
+  //! \param[in] i_temp  Temperature index
+  //! \param[in] i_log_union  Log-grid or unionized grid search index
+  //! \param[in] E  Energy in [eV]
+  //! \return Index on the energy grid at the given temperature
+  int energy_grid_index(int i_temp, int i_log_union, double E) const;
+
+  //! Tabulated total cross section at a point of the energy grid
+  //
+  //! \param[in] i_temp  Temperature index
+  //! \param[in] i_grid  Index on the energy grid at the given temperature
+  //! \return Total cross section in [b]
+  double total_xs(int i_temp, int i_grid) const
+  {
+    return xs_[i_temp](i_grid, XS_TOTAL);
+  }
+
+  //! Calculate depletion reaction cross sections from tabulated data
+  //
+  //! \param[in] i_temp  Temperature index
+  //! \param[in] i_grid  Energy grid index
+  //! \param[in] f  Interpolation factor on the energy grid
+  //! \param[in,out] micro  Microscopic cross section cache for this nuclide
+  void calculate_depletion_xs(
+    int i_temp, int i_grid, double f, NuclideMicroXS& micro) const;
+
+  //! Check whether cross sections at an energy can be interpolated directly
+  //! from data::packed_xs, i.e., neither multipole data nor URR probability
+  //! tables apply
+  //
+  //! \param[in] E  Energy in [eV]
+  //! \return Whether the packed tables can be used
+  bool use_packed_xs(double E) const;
+
+  //! Copy tabulated cross sections into packed arrays at packed_offset_
+  //
+  //! \param[in,out] packed  Packed cross sections of all nuclides
+  void pack_xs(PackedXS& packed) const;
+
+  //! Set up total, absorption, fission, nu-fission, and photon production
+  //! cross sections and other data derived from the reactions. This does not
+  //! read any HDF5 data and may be called concurrently for several nuclides.
+  void create_derived();
+
+  //! Move tabulated cross sections of the nuclide and its reactions to memory
+  //! shared by the processes on a node
+  //
+  //! This must be called by every process on the node in the same order.
+  void share_xs();
+
+  //! Free data of the reactions that the simulation cannot use: photon
+  //! products when photons are not transported, and the cross sections and
+  //! products of redundant reactions that are neither fission nor kept
+  //
+  //! \param[in] keep  Whether the reaction with each MT value is needed
+  //! \param[in,out] n_products  Incremented by the number of products freed
+  //! \param[in,out] n_reactions  Incremented by the number of reactions freed
+  //! \return Memory of the cross section values freed in [MB]
+  double prune_data(
+    const array<bool, 902>& keep, int64_t& n_products, int64_t& n_reactions);
 
   //! Calculate thermal scattering cross section
   //
@@ -96,7 +241,10 @@ public:
   // Temperature dependent cross section data
   vector<double> kTs_;                //!< temperatures in eV (k*T)
   vector<EnergyGrid> grid_;           //!< Energy grid at each temperature
-  vector<xt::xtensor<double, 2>> xs_; //!< Cross sections at each temperature
+  array<double, 2> grid_limits_ {0.0, 0.0}; //!< Limits of log grid in [eV]
+  vector<XsTable> xs_;                //!< Cross sections at each temperature
+  vector<vector<double>> xs_data_; //!< Storage for xs_ unless shared/cached
+  vector<int64_t> packed_offset_; //!< Offset in data::packed_xs at each T
 
   // Multipole data
   unique_ptr<WindowedMultipole> multipole_;
@@ -120,6 +268,7 @@ public:
   vector<double> energy_0K_;
   vector<double> elastic_0K_;
   vector<double> xs_cdf_;
+  RangeMaximum elastic_0K_max_; //!< Block maxima of the 0K elastic xs
 
   // Unresolved resonance range information
   bool urr_present_ {false};
@@ -129,10 +278,19 @@ public:
   vector<unique_ptr<Reaction>> reactions_; //!< Reactions
   array<size_t, 902> reaction_index_;      //!< Index of each reaction
   vector<int> index_inelastic_scatter_;
+  vector<ReactionCDF> inelastic_cdf_;  //!< Inelastic xs sums at each T
+
+  //! Indices in reactions_ and in the products of that reaction of every
+  //! photon product, in the order photons are sampled from
+  vector<std::pair<int, int>> photon_products_;
+  vector<ReactionCDF> photon_product_cdf_; //!< Photon production sums at each T
 
 private:
-  void create_derived(
-    const Function1D* prompt_photons, const Function1D* delayed_photons);
+  //! Tabulate running sums of the inelastic scattering cross sections
+  void init_inelastic_cdf();
+
+  //! Tabulate running sums of the photon production cross sections
+  void init_photon_product_cdf();
 
   //! Determine temperature index and interpolation factor
   //
@@ -140,6 +298,10 @@ private:
   //! \return Temperature index and interpolation factor
   std::pair<gsl::index, double> find_temperature(double T) const;
 
+  //! Set microscopic cross sections evaluated from multipole data
+  void set_multipole_xs(double sig_s, double sig_a, double sig_f, int i_sab,
+    double sab_frac, Particle& p);
+
   static int XS_TOTAL;
   static int XS_ABSORPTION;
   static int XS_FISSION;
@@ -156,6 +318,43 @@ void check_data_version(hid_t file_id);
 
 bool multipole_in_range(const Nuclide& nuc, double E);
 
+//! Build the unionized energy grid and each nuclide's index into it, provided
+//! the memory required stays within settings::union_grid_memory
+void init_union_grid();
+
+//! Read a nuclide, and the photon data of its element if needed, unless it
+//! has already been read
+//
+//! \param[in] name  Name of the nuclide
+//! \param[in] temps  Desired temperatures in [K]
+//! \param[in] n  Number of temperatures
+//! \param[in] derive  Whether to set up derived cross sections of the nuclide
+//! \return Error code
+int load_nuclide(const char* name, const double* temps, int n, bool derive);
+
+//! Determine the search index passed to Nuclide::calculate_xs
+//
+//! \param[in] E  Neutron energy in [eV]
+//! \return Index on the unionized grid if it exists, else on the log grid
+int energy_search_index(double E);
+
+//! Pack the tabulated cross sections of all nuclides into data::packed_xs
+void init_packed_xs();
+
+//! Interpolate cross sections from data::packed_xs for several lookups at once
+//
+//! \param[in] n  Number of lookups
+//! \param[in] index  Lower bounding index in data::packed_xs for each lookup
+//! \param[in] f  Interpolation factor for each lookup
+//! \param[out] total  Total cross section for each lookup
+//! \param[out] absorption  Absorption cross section for each lookup
+//! \param[out] fission  Fission cross section for each lookup
+//! \param[out] nu_fission  Nu-fission cross section for each lookup
+//! \param[out] photon_prod  Photon production cross section for each lookup
+void interpolate_packed_xs(int n, const int64_t* index, const double* f,
+  double* total, double* absorption, double* fission, double* nu_fission,
+  double* photon_prod);
+
 //==============================================================================
 // Global variables
 //==============================================================================
@@ -176,6 +375,14 @@ extern double temperature_max;
 extern std::unordered_map<std::string, int> nuclide_map;
 extern vector<unique_ptr<Nuclide>> nuclides;
 
+//! Unionized energy grid in [eV] over all nuclides and temperatures. Empty
+//! unless settings::union_grid_memory allows it to be built.
+extern vector<double> union_energy;
+
+//! Packed copy of nuclide cross sections. Empty unless settings::vectorized_xs
+//! is enabled.
+extern PackedXS packed_xs;
+
 } // namespace data
 
 //==============================================================================
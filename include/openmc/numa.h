@@ -0,0 +1,37 @@
+//! \file numa.h
+//! Placement of threads and memory on the NUMA nodes of a shared-memory node
+
+#ifndef OPENMC_NUMA_H
+#define OPENMC_NUMA_H
+
+namespace openmc {
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Pin each OpenMP thread to a core according to settings::thread_affinity
+//
+//! The cores are those the process is allowed to run on, in the order given
+//! by the operating system. With compact affinity, consecutive threads share
+//! neighboring cores; with spread affinity, threads are spaced evenly over all
+//! the cores so that each NUMA node receives its share of threads. Pinning
+//! relies on the OpenMP runtime reusing the same threads in later parallel
+//! regions, which all common runtimes do.
+void pin_threads();
+
+//! Interleave the pages allocated from now on over all NUMA nodes when
+//! settings::numa_interleave is on
+//
+//! Nuclear data are read by the master thread but looked up by every thread.
+//! Interleaving their pages spreads the remote accesses evenly over the
+//! memory controllers instead of having every thread use those of the node
+//! the master thread runs on.
+void begin_interleave();
+
+//! Restore the default placement of pages on the node that first touches them
+void end_interleave();
+
+} // namespace openmc
+
+#endif // OPENMC_NUMA_H
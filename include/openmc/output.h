@@ -5,6 +5,7 @@
 #define OPENMC_OUTPUT_H
 
 #include <string>
+#include <utility> // for pair
 
 #include "openmc/particle.h"
 
@@ -52,6 +53,11 @@ void print_generation();
 //! Display time elapsed for various stages of a run
 void print_runtime();
 
+//! Calculate the number of particles simulated per second of batch time
+//! \return Rates in inactive and active batches, which are zero if no such
+//!   batches have been run
+std::pair<double, double> calculation_rates();
+
 //! Display results for global tallies including k-effective estimators
 void print_results();
 
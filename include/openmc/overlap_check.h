@@ -0,0 +1,25 @@
+//! \file overlap_check.h
+//! Search for overlapping cells along rays traced through the geometry
+
+#ifndef OPENMC_OVERLAP_CHECK_H
+#define OPENMC_OVERLAP_CHECK_H
+
+namespace openmc {
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Trace settings::n_particles rays across the bounding box of the geometry
+//! and report the cells that overlap
+//
+//! Each ray is tracked from surface to surface without any physics. At the
+//! midpoint of each segment, the cells of every universe level that could
+//! contain the point, according to the universe partitioner and the bounding
+//! boxes of the cells, are tested against the cell the ray is in. Rays are
+//! divided over processes and threads.
+void run_overlap_check();
+
+} // namespace openmc
+
+#endif // OPENMC_OVERLAP_CHECK_H
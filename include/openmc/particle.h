@@ -53,6 +53,20 @@ public:
   //! \param type Particle type
   void create_secondary(double wgt, Direction u, double E, ParticleType type);
 
+  //! split the particle
+  //
+  //! banks copies of the particle with its current phase space attributes as
+  //! a single site in the secondary bank, which is expanded into the copies as
+  //! they are revived.
+  //! \param n_copies Number of copies to bank
+  //! \param wgt Weight of each copy
+  void split(int n_copies, double wgt);
+
+  //! energy of the secondary particles banked in the current event
+  //
+  //! \return Total energy in [eV], counting each copy of a split particle
+  double energy_banked_second();
+
   //! initialize from a source site
   //
   //! initializes a particle from data stored in a source site. The source
@@ -69,6 +83,22 @@ public:
   void event_revive_from_secondary();
   void event_death();
 
+  //! Perform all of a cross section event except the continuous-energy
+  //! material lookup itself
+  //
+  //! \return Whether Material::calculate_xs still needs to be called
+  bool event_calculate_xs_prepare();
+
+  //! Advance a neutron through a delta-tracking region
+  //
+  //! Tentative collision sites are sampled from the majorant cross section of
+  //! the region and accepted as real collisions with probability
+  //! sigma_t/sigma_maj, so the boundaries of the cells inside the region are
+  //! never found. The flight ends at a real collision or on the boundary of
+  //! the region.
+  //! \param level  Coordinate level of the cell filled by the region
+  void event_advance_delta(int level);
+
   //! pulse-height recording
   void pht_collision_energy();
   void pht_secondary_particles();
@@ -53,6 +53,13 @@ struct SourceSite {
   int64_t progeny_id;
 };
 
+//! Identical copies of a split particle that share one site in the secondary
+//! bank. The site is only removed from the bank with the last copy.
+struct SplitRecord {
+  int64_t i_site; //!< Index of the shared site in the secondary bank
+  int n_copies;   //!< Number of copies not yet transported
+};
+
 //! State of a particle used for particle track files
 struct TrackState {
   Position r;           //!< Position in [cm]
@@ -78,6 +85,8 @@ struct NuBank {
   int delayed_group; //!< particle delayed group
 };
 
+class Region;
+
 class LocalCoord {
 public:
   void rotate(const vector<double>& rotation);
@@ -92,6 +101,11 @@ public:
   int lattice {-1};
   array<int, 3> lattice_i {{-1, -1, -1}};
   bool rotated {false}; //!< Is the level rotated?
+
+  // Distribcell offset of the universe at this level, i.e. the instances of
+  // the cells of the map preceding it, which is computed when first needed
+  int instance_map {-1};   //!< Offset map of instance_offset, or -1
+  int instance_offset {0}; //!< Sum of the offsets of the levels above
 };
 
 //==============================================================================
@@ -125,6 +139,15 @@ struct NuclideMicroXS {
   double sab_frac;      //!< Fraction of atoms affected by S(a,b)
   bool use_ptable;      //!< In URR range with probability tables?
 
+  // Probability table interval and bands last sampled in the unresolved
+  // resonance range. The bands only depend on the random number stream, so
+  // they are reused while the energy stays within the same interval.
+  int urr_index_energy {-1}; //!< Index on the probability table energy grid
+  int urr_index_temp;        //!< Temperature index of the probability table
+  int urr_band_low;          //!< Band at the lower energy of the interval
+  int urr_band_up;           //!< Band at the upper energy of the interval
+  uint64_t urr_seed;         //!< URR stream seed used to sample the bands
+
   // Energy and temperature last used to evaluate these cross sections.  If
   // these values have changed, then the cross sections must be re-evaluated.
   double last_E {0.0};      //!< Last evaluated energy
@@ -177,12 +200,28 @@ struct CacheDataMG {
   int t {0};         //!< temperature index
   int a {0};         //!< angle index
   Direction u;       //!< angle that corresponds to a
+  int n_pol {0};     //!< number of polar bins a was found for (0 = none)
+  int n_azi {0};     //!< number of azimuthal bins a was found for
 };
 
 //==============================================================================
 // Information about nearest boundary crossing
 //==============================================================================
 
+//==============================================================================
+//! Distances to the surfaces of a region along a ray. These stay valid while a
+//! particle moves along the ray without leaving the region.
+//==============================================================================
+
+struct SurfaceDistances {
+  const Region* region {nullptr}; //!< Region the distances belong to
+  Position r;                     //!< Start of the ray
+  Direction u;                    //!< Direction of the ray
+  vector<double> distances; //!< Distance from r to the surface of each token
+};
+
+//==============================================================================
+
 struct BoundaryInfo {
   double distance {INFINITY}; //!< distance to nearest boundary
   int surface_index {0}; //!< if boundary is surface, index in surfaces vector
@@ -191,6 +230,49 @@ struct BoundaryInfo {
     lattice_translation {}; //!< which way lattice indices will change
 };
 
+#ifdef OPENMC_PARTICLE_SOA
+//==============================================================================
+//! Frequently accessed fields of the event-based particle buffer laid out as a
+//! structure of arrays. Particles in the buffer refer to their slot by index
+//! while all other particles keep these fields inline.
+//==============================================================================
+
+struct ParticleSoA {
+  vector<double> E;          //!< energy in [eV]
+  vector<double> E_last;     //!< pre-collision energy in [eV]
+  vector<double> wgt;        //!< statistical weight
+  vector<int> material;      //!< index for current material
+  vector<double> sqrtkT;     //!< sqrt(k_Boltzmann * temperature) in eV
+  vector<MacroXS> macro_xs;  //!< macroscopic cross sections
+
+  void resize(int64_t n)
+  {
+    E.resize(n);
+    E_last.resize(n);
+    wgt.resize(n);
+    material.resize(n);
+    sqrtkT.resize(n);
+    macro_xs.resize(n);
+  }
+
+  void clear()
+  {
+    E.clear();
+    E_last.clear();
+    wgt.clear();
+    material.clear();
+    sqrtkT.clear();
+    macro_xs.clear();
+  }
+};
+
+namespace simulation {
+
+extern ParticleSoA particle_soa; //!< Storage for event-based particle buffer
+
+} // namespace simulation
+#endif
+
 /*
  * Contains all geometry state information for a particle.
  */
@@ -220,6 +302,17 @@ public:
       cell = C_NONE;
     }
     n_coord_last_ = 1;
+
+    clear_surface_distances();
+  }
+
+  // Forget the distances to surfaces on all coordinate levels, which is needed
+  // whenever the coordinates are found again
+  void clear_surface_distances()
+  {
+    for (auto& d : surface_distances_) {
+      d.region = nullptr;
+    }
   }
 
   // Initialize all internal state from position and direction
@@ -303,23 +396,69 @@ public:
   // Boundary information
   BoundaryInfo& boundary() { return boundary_; }
 
+  // Distances to the surfaces of the cell on each coordinate level
+  SurfaceDistances& surface_distances(int i) { return surface_distances_[i]; }
+
 #ifdef DAGMC
+  //! Last ray fired in a DAGMC cell along with its intersection
+  struct DAGRayCache {
+    int32_t universe {C_NONE};  //!< Index of the DAGMC universe
+    int32_t dag_index {C_NONE}; //!< DAGMC index of the volume
+    Position r;                 //!< Origin of the ray
+    Direction u;                //!< Direction of the ray
+    double distance;            //!< Distance to the intersection
+    int32_t surface;            //!< Index of the surface intersected
+    moab::DagMC::RayHistory history; //!< Ray history after the intersection
+  };
+
   // DagMC state variables
   moab::DagMC::RayHistory& history() { return history_; }
   Direction& last_dir() { return last_dir_; }
+  DAGRayCache& dag_ray_cache() { return dag_ray_cache_; }
 #endif
 
   // material of current and last cell
+#ifdef OPENMC_PARTICLE_SOA
+  int& material()
+  {
+    return soa_index_ < 0 ? material_
+                          : simulation::particle_soa.material[soa_index_];
+  }
+  const int& material() const
+  {
+    return soa_index_ < 0 ? material_
+                          : simulation::particle_soa.material[soa_index_];
+  }
+#else
   int& material() { return material_; }
   const int& material() const { return material_; }
+#endif
   int& material_last() { return material_last_; }
   const int& material_last() const { return material_last_; }
 
   // temperature of current and last cell
+#ifdef OPENMC_PARTICLE_SOA
+  double& sqrtkT()
+  {
+    return soa_index_ < 0 ? sqrtkT_
+                          : simulation::particle_soa.sqrtkT[soa_index_];
+  }
+  const double& sqrtkT() const
+  {
+    return soa_index_ < 0 ? sqrtkT_
+                          : simulation::particle_soa.sqrtkT[soa_index_];
+  }
+#else
   double& sqrtkT() { return sqrtkT_; }
   const double& sqrtkT() const { return sqrtkT_; }
+#endif
   double& sqrtkT_last() { return sqrtkT_last_; }
 
+#ifdef OPENMC_PARTICLE_SOA
+protected:
+  int64_t soa_index_ {-1}; //!< slot in particle_soa (-1 if stored inline)
+#endif
+
 private:
   int64_t id_ {-1}; //!< Unique ID
 
@@ -341,6 +480,9 @@ private:
 
   BoundaryInfo boundary_; //!< Info about the next intersection
 
+  //! Distances to surfaces for all levels
+  vector<SurfaceDistances> surface_distances_;
+
   int material_ {-1};      //!< index for current material
   int material_last_ {-1}; //!< index for last material
 
@@ -350,6 +492,7 @@ private:
 #ifdef DAGMC
   moab::DagMC::RayHistory history_;
   Direction last_dir_;
+  DAGRayCache dag_ray_cache_;
 #endif
 };
 
@@ -394,8 +537,12 @@ private:
   // Data members -- see public: below for descriptions
 
   vector<NuclideMicroXS> neutron_xs_;
+  bool compact_neutron_xs_ {false};
+  const int* neutron_xs_slot_ {nullptr};
+  int neutron_xs_overflow_ {-1};
   vector<ElementMicroXS> photon_xs_;
   MacroXS macro_xs_;
+  vector<double> macro_total_cdf_;
   CacheDataMG mg_xs_cache_;
 
   ParticleType type_ {ParticleType::neutron};
@@ -420,6 +567,7 @@ private:
   int n_bank_ {0};
   int n_bank_second_ {0};
   double wgt_bank_ {0.0};
+  double wgt_absorb_ {0.0};
   int n_delayed_bank_[MAX_DELAYED_GROUPS];
 
   int cell_born_ {-1};
@@ -432,6 +580,7 @@ private:
   int stream_;
 
   vector<SourceSite> secondary_bank_;
+  vector<SplitRecord> split_records_;
 
   int64_t current_work_;
 
@@ -439,6 +588,13 @@ private:
 
   vector<FilterMatch> filter_matches_;
 
+  vector<FilterBinCache> filter_bin_caches_;
+
+  MeshSegments mesh_segments_;
+  FilterMatch time_mesh_match_;
+
+  vector<int> tally_candidates_;
+
   vector<TrackStateHistory> tracks_;
 
   vector<NuBank> nu_bank_;
@@ -450,6 +606,9 @@ private:
   double keff_tally_tracklength_ {0.0};
   double keff_tally_leakage_ {0.0};
 
+  int64_t xs_temperature_hits_ {0};
+  int64_t xs_temperature_misses_ {0};
+
   bool trace_ {false};
 
   double collision_distance_;
@@ -458,6 +617,9 @@ private:
 
   int n_split_ {0};
   double ww_factor_ {0.0};
+  int ww_index_ {C_NONE};
+  int ww_mesh_bin_ {C_NONE};
+  int ww_energy_bin_ {C_NONE};
 
   int64_t n_progeny_ {0};
 
@@ -469,19 +631,68 @@ public:
   //==========================================================================
   // Methods and accessors
 
-  // Cross section caches
+  // Microscopic neutron cross sections. When the compact cache is used, only
+  // the nuclides in the current material have their own slot, and any other
+  // nuclide (e.g., one requested by a tally) shares a single overflow slot.
   NuclideMicroXS& neutron_xs(int i)
   {
-    return neutron_xs_[i];
-  } // Microscopic neutron cross sections
-  const NuclideMicroXS& neutron_xs(int i) const { return neutron_xs_[i]; }
+    if (!compact_neutron_xs_)
+      return neutron_xs_[i];
+    int j = neutron_xs_slot_ ? neutron_xs_slot_[i] : C_NONE;
+    if (j != C_NONE)
+      return neutron_xs_[j];
+    if (neutron_xs_overflow_ != i) {
+      neutron_xs_.back().last_E = 0.0;
+      neutron_xs_overflow_ = i;
+    }
+    return neutron_xs_.back();
+  }
+  const NuclideMicroXS& neutron_xs(int i) const
+  {
+    if (!compact_neutron_xs_)
+      return neutron_xs_[i];
+    int j = neutron_xs_slot_ ? neutron_xs_slot_[i] : C_NONE;
+    return j != C_NONE ? neutron_xs_[j] : neutron_xs_.back();
+  }
+
+  //! Point the compact microscopic cross section cache at the nuclides of a
+  //! material, invalidating the cache if the material has changed
+  //
+  //! \param slots Map from global nuclide index to slot, with C_NONE for
+  //!   nuclides not in the material
+  void set_neutron_xs_slots(const int* slots)
+  {
+    if (compact_neutron_xs_ && slots != neutron_xs_slot_) {
+      neutron_xs_slot_ = slots;
+      neutron_xs_overflow_ = -1;
+      invalidate_neutron_xs();
+    }
+  }
 
   // Microscopic photon cross sections
   ElementMicroXS& photon_xs(int i) { return photon_xs_[i]; }
 
   // Macroscopic cross sections
+#ifdef OPENMC_PARTICLE_SOA
+  MacroXS& macro_xs()
+  {
+    return soa_index_ < 0 ? macro_xs_
+                          : simulation::particle_soa.macro_xs[soa_index_];
+  }
+  const MacroXS& macro_xs() const
+  {
+    return soa_index_ < 0 ? macro_xs_
+                          : simulation::particle_soa.macro_xs[soa_index_];
+  }
+#else
   MacroXS& macro_xs() { return macro_xs_; }
   const MacroXS& macro_xs() const { return macro_xs_; }
+#endif
+
+  // Running sum of the macroscopic total cross section over the nuclides (or
+  // elements) of the current material, used to sample a collision target
+  vector<double>& macro_total_cdf() { return macro_total_cdf_; }
+  const vector<double>& macro_total_cdf() const { return macro_total_cdf_; }
 
   // Multigroup macroscopic cross sections
   CacheDataMG& mg_xs_cache() { return mg_xs_cache_; }
@@ -494,10 +705,31 @@ public:
   // Current particle energy, energy before collision,
   // and corresponding multigroup group indices. Energy
   // units are eV.
+#ifdef OPENMC_PARTICLE_SOA
+  double& E()
+  {
+    return soa_index_ < 0 ? E_ : simulation::particle_soa.E[soa_index_];
+  }
+  const double& E() const
+  {
+    return soa_index_ < 0 ? E_ : simulation::particle_soa.E[soa_index_];
+  }
+  double& E_last()
+  {
+    return soa_index_ < 0 ? E_last_
+                          : simulation::particle_soa.E_last[soa_index_];
+  }
+  const double& E_last() const
+  {
+    return soa_index_ < 0 ? E_last_
+                          : simulation::particle_soa.E_last[soa_index_];
+  }
+#else
   double& E() { return E_; }
   const double& E() const { return E_; }
   double& E_last() { return E_last_; }
   const double& E_last() const { return E_last_; }
+#endif
   int& g() { return g_; }
   const int& g() const { return g_; }
   int& g_last() { return g_last_; }
@@ -505,11 +737,22 @@ public:
 
   // Statistic weight of particle. Setting to zero
   // indicates that the particle is dead.
+#ifdef OPENMC_PARTICLE_SOA
+  double& wgt()
+  {
+    return soa_index_ < 0 ? wgt_ : simulation::particle_soa.wgt[soa_index_];
+  }
+  double wgt() const
+  {
+    return soa_index_ < 0 ? wgt_ : simulation::particle_soa.wgt[soa_index_];
+  }
+#else
   double& wgt() { return wgt_; }
   double wgt() const { return wgt_; }
+#endif
   double& wgt_last() { return wgt_last_; }
   const double& wgt_last() const { return wgt_last_; }
-  bool alive() const { return wgt_ != 0.0; }
+  bool alive() const { return wgt() != 0.0; }
 
   // Polar scattering angle after a collision
   double& mu() { return mu_; }
@@ -538,6 +781,9 @@ public:
     return n_bank_second_;
   }                                        // number of secondaries banked
   double& wgt_bank() { return wgt_bank_; } // weight of banked fission sites
+  //! Weight removed by implicit capture in the last collision
+  double& wgt_absorb() { return wgt_absorb_; }
+  double wgt_absorb() const { return wgt_absorb_; }
   int* n_delayed_bank()
   {
     return n_delayed_bank_;
@@ -568,6 +814,9 @@ public:
   SourceSite& secondary_bank(int i) { return secondary_bank_[i]; }
   decltype(secondary_bank_)& secondary_bank() { return secondary_bank_; }
 
+  // sites of the secondary bank holding more than one split particle
+  decltype(split_records_)& split_records() { return split_records_; }
+
   // Current simulation work index
   int64_t& current_work() { return current_work_; }
   const int64_t& current_work() const { return current_work_; }
@@ -580,6 +829,21 @@ public:
   decltype(filter_matches_)& filter_matches() { return filter_matches_; }
   FilterMatch& filter_matches(int i) { return filter_matches_[i]; }
 
+  // Filter bin combinations shared by tallies with identical filters
+  decltype(filter_bin_caches_)& filter_bin_caches()
+  {
+    return filter_bin_caches_;
+  }
+  FilterBinCache& filter_bin_caches(int i) { return filter_bin_caches_[i]; }
+
+  // Mesh bins crossed by the current track and their combinations with time
+  // bins, for tallies whose time and mesh bins are found together
+  MeshSegments& mesh_segments() { return mesh_segments_; }
+  FilterMatch& time_mesh_match() { return time_mesh_match_; }
+
+  // Tallies whose spatial domain may contain the current event
+  decltype(tally_candidates_)& tally_candidates() { return tally_candidates_; }
+
   // Tracks to output to file
   decltype(tracks_)& tracks() { return tracks_; }
 
@@ -589,6 +853,7 @@ public:
 
   // Interim pulse height tally storage
   vector<double>& pht_storage() { return pht_storage_; }
+  const vector<double>& pht_storage() const { return pht_storage_; }
 
   // Global tally accumulators
   double& keff_tally_absorption() { return keff_tally_absorption_; }
@@ -596,6 +861,11 @@ public:
   double& keff_tally_tracklength() { return keff_tally_tracklength_; }
   double& keff_tally_leakage() { return keff_tally_leakage_; }
 
+  // Number of times microscopic cross sections were reused (hits) or
+  // recalculated (misses) after only the temperature changed
+  int64_t& xs_temperature_hits() { return xs_temperature_hits_; }
+  int64_t& xs_temperature_misses() { return xs_temperature_misses_; }
+
   // Shows debug info
   bool& trace() { return trace_; }
 
@@ -613,6 +883,12 @@ public:
   double ww_factor() const { return ww_factor_; }
   double& ww_factor() { return ww_factor_; }
 
+  // Weight windows last applied to the particle and the mesh and energy bins
+  // they were found in, as a starting point for the next search
+  int& ww_index() { return ww_index_; }
+  int& ww_mesh_bin() { return ww_mesh_bin_; }
+  int& ww_energy_bin() { return ww_energy_bin_; }
+
   // Number of progeny produced by this particle
   int64_t& n_progeny() { return n_progeny_; }
 
@@ -630,6 +906,14 @@ public:
   //! Get track information based on particle's current state
   TrackState get_track_state() const;
 
+#ifdef OPENMC_PARTICLE_SOA
+  //! Move the frequently accessed fields of this particle into a slot of the
+  //! structure-of-arrays storage
+  //
+  //! \param i Index of the slot in simulation::particle_soa
+  void use_soa_slot(int64_t i);
+#endif
+
   void zero_delayed_bank()
   {
     for (int& n : n_delayed_bank_) {
@@ -4,18 +4,89 @@
 #include "openmc/endf.h"
 #include "openmc/memory.h" // for unique_ptr
 #include "openmc/particle.h"
+#include "openmc/search.h"
 #include "openmc/vector.h"
 
 #include "xtensor/xtensor.hpp"
 #include <gsl/gsl-lite.hpp>
 #include <hdf5.h>
 
+#include <functional> // for function
 #include <string>
 #include <unordered_map>
 #include <utility> // for pair
 
 namespace openmc {
 
+//==============================================================================
+//! Photon cross sections tabulated on a log-uniform energy grid
+//
+//! The coherent, incoherent, photoelectric, and pair production cross sections
+//! are stored at each point of the grid and linearly interpolated in log
+//! energy, so a lookup needs neither a search nor any exponentials.
+//==============================================================================
+
+class PhotonXSTable {
+public:
+  // Constructors
+  PhotonXSTable() = default;
+
+  //! Tabulate cross sections on a grid that is refined until linear
+  //! interpolation reproduces them to within a tolerance relative to the
+  //! total cross section
+  //
+  //! Intervals that contain a discontinuity, or that still miss the tolerance
+  //! on the finest grid, are not interpolated.
+  //! \param[in] log_E_min Log of the lowest energy in [eV]
+  //! \param[in] log_E_max Log of the highest energy in [eV]
+  //! \param[in] edges Log of the energies in [eV] where the cross sections are
+  //!   discontinuous
+  //! \param[in] kinks Log of the energies in [eV] where the cross sections have
+  //!   kinks, at which the interpolation error is also checked
+  //! \param[in] tolerance Relative tolerance
+  //! \param[in] evaluate Function giving the cross sections at a log energy
+  PhotonXSTable(double log_E_min, double log_E_max,
+    const vector<double>& edges, const vector<double>& kinks, double tolerance,
+    const std::function<void(double, double*)>& evaluate);
+
+  // Methods
+
+  //! Interpolate the cross sections
+  //
+  //! \param[in] log_E Log of the energy in [eV]
+  //! \param[out] xs Coherent, incoherent, photoelectric, and pair production
+  //!   cross sections
+  //! \return Whether the table could be interpolated at the energy
+  bool interpolate(double log_E, double* xs) const
+  {
+    double x = (log_E - log_E_min_) * inv_spacing_;
+    if (!(x >= 0.0 && x < exact_.size()))
+      return false;
+    int j = x;
+    if (exact_[j])
+      return false;
+    double g = x - j;
+    const double* lo = &values_[4 * j];
+    for (int k = 0; k < 4; ++k) {
+      xs[k] = lo[k] + g * (lo[k + 4] - lo[k]);
+    }
+    return true;
+  }
+
+  //! Multiply all cross sections by a factor
+  void scale(double f);
+
+  // Accessors
+  bool empty() const { return values_.empty(); }
+
+private:
+  // Data members
+  vector<double> values_;   //!< Cross sections at each point of the grid
+  vector<bool> exact_;      //!< Is each interval evaluated from the data?
+  double log_E_min_ {0.0};  //!< Log of the lowest energy of the grid
+  double inv_spacing_ {0.0}; //!< Inverse spacing of the grid in log E
+};
+
 //==============================================================================
 //! Photon interaction data for a single element
 //==============================================================================
@@ -48,6 +119,26 @@ public:
   // Methods
   void calculate_xs(Particle& p) const;
 
+  //! Find the interval of the energy grid containing an energy
+  //
+  //! \param[in] log_E Logarithm of the energy in [eV]
+  //! \param[out] i_grid Index of the lower point of the interval
+  //! \param[out] f Interpolation factor in log energy
+  void find_grid_index(double log_E, int& i_grid, double& f) const;
+
+  //! Interpolate the cross sections on the energy grid of the element
+  //
+  //! \param[in] log_E Logarithm of the energy in [eV]
+  //! \param[out] xs Coherent, incoherent, photoelectric, and pair production
+  //!   cross sections in [b]
+  void interpolate_xs(double log_E, double* xs) const;
+
+  //! Energies at which the cross sections are discontinuous
+  //
+  //! \return Logarithm of the energies in [eV] of repeated grid points and of
+  //!   the thresholds of the photoelectric subshells
+  vector<double> edges() const;
+
   void compton_scatter(double alpha, bool doppler, double* alpha_out,
     double* mu, int* i_shell, uint64_t* seed) const;
 
@@ -91,6 +182,12 @@ public:
   xt::xtensor<double, 1> binding_energy_;
   xt::xtensor<double, 1> electron_pdf_;
 
+  // Guide tables for sampling the electron shell and the Compton profile of
+  // each shell. Empty unless settings::guide_table_cells is positive.
+  vector<double> electron_cdf_; //!< Running sum of electron_pdf_
+  GuideTable electron_guide_;   //!< Guide table for searching electron_cdf_
+  vector<GuideTable> profile_guide_; //!< Guide tables for profile_cdf_ / total
+
   // Stopping power data
   double I_; // mean excitation energy
   xt::xtensor<int, 1> n_electrons_;
@@ -103,10 +200,22 @@ public:
   // Whether atomic relaxation data is present
   bool has_atomic_relaxation_ {false};
 
+  // Cross sections tabulated on a log-uniform energy grid. Empty unless
+  // settings::photon_xs_tolerance is positive.
+  PhotonXSTable xs_table_;
+
   // Constant data
   static constexpr int MAX_STACK_SIZE =
     7; //!< maximum possible size of atomic relaxation stack
 private:
+  //! Interpolate the cross sections on the energy grid of the element
+  //
+  //! \param[in] i_grid Index of the lower point of the interval
+  //! \param[in] f Interpolation factor in log energy
+  //! \param[out] xs Coherent, incoherent, photoelectric, and pair production
+  //!   cross sections in [b]
+  void interpolate_xs(int i_grid, double f, double* xs) const;
+
   void compton_doppler(
     double alpha, double mu, double* E_out, int* i_shell, uint64_t* seed) const;
 
@@ -2,6 +2,7 @@
 #define OPENMC_PLOT_H
 
 #include <cmath>
+#include <memory>
 #include <sstream>
 #include <unordered_map>
 
@@ -145,8 +146,29 @@ struct PropertyData {
 // Plot class
 //===============================================================================
 
+//! Find the cells containing a point on a pixel row and the distance along
+//! the row over which they do not change
+//
+//! \param[in,out] p  Geometry state located at the point
+//! \param[in] r  Point in the coordinates of the root universe
+//! \param[in] u  Direction along the pixel row
+//! \return Distance to the next boundary crossed along the row, or a negative
+//!   value if the point is outside the geometry
+double slice_span_length(GeometryState& p, Position r, Direction u);
+
+//! Whether slice plots can be traced along pixel rows, which requires CSG
+//! geometry
+bool slice_ray_trace_supported();
+
 class SlicePlotBase {
 public:
+  //! Find the cells of each pixel of the slice
+  //
+  //! Each pixel row is traced along its direction. A full cell search is done
+  //! at the first pixel of each span between boundary crossings, and the
+  //! other pixels of the span, which lie inside the same cells, reuse its
+  //! result. When overlaps are colored, or the geometry includes DAGMC
+  //! universes, every pixel is searched instead.
   template<class T>
   T get_map() const;
 
@@ -204,12 +226,18 @@ T SlicePlotBase::get_map() const
   // arbitrary direction
   Direction dir = {1. / std::sqrt(2.), 1. / std::sqrt(2.), 0.0};
 
+  // direction along each pixel row
+  Direction row_dir {0.0, 0.0, 0.0};
+  row_dir[in_i] = 1.0;
+  bool ray_trace = !slice_color_overlaps_ && slice_ray_trace_supported();
+
 #pragma omp parallel
   {
     GeometryState p;
     p.r() = xyz;
     p.u() = dir;
     p.coord(0).universe = model::root_universe;
+    GeometryState span;
     int level = slice_level_;
     int j {};
 
@@ -231,6 +259,21 @@ T SlicePlotBase::get_map() const
         if (slice_color_overlaps_ && check_cell_overlap(p, false)) {
           data.set_overlap(y, x);
         }
+
+        // The following pixels that lie inside the same cells along the row,
+        // away from the next boundary, are given the same values
+        if (!ray_trace || !found_cell)
+          continue;
+        double d = slice_span_length(span, p.r(), row_dir);
+        if (d < 0.0)
+          continue;
+        int j_span = level >= 0 ? level : span.n_coord() - 1;
+        double start = xyz[in_i] + in_pixel * x;
+        while (x + 1 < width &&
+               xyz[in_i] + in_pixel * (x + 1) - start < d - TINY_BIT) {
+          ++x;
+          data.set_value(y, x, span, j_span);
+        }
       } // inner for
     }   // outer for
   }     // omp parallel
@@ -324,6 +367,9 @@ private:
   // loop:
   static const int MAX_INTERSECTIONS = 1000000;
 
+  // Number of lines of pixels in each tile rendered by a thread
+  static const int TILE_ROWS = 16;
+
   std::array<int, 2> pixels_;              // pixel dimension of resulting image
   double horizontal_field_of_view_ {70.0}; // horiz. f.o.v. in degrees
   Position camera_position_;               // where camera is
@@ -373,10 +419,13 @@ void voxel_init(hid_t file_id, const hsize_t* dims, hid_t* dspace, hid_t* dset,
   hid_t* memspace);
 
 //! Write a section of the voxel data to hdf5
+//!
+//! When the file is open for parallel I/O the write is collective, and a
+//! process without a slice to write passes a null pointer.
 //! \param[in] voxel slice
 //! \param[out] dataspace pointer to voxel data
 //! \param[out] dataset pointer to voxesl data
-//! \param[out] pointer to data to write
+//! \param[out] pointer to data to write, or nullptr
 void voxel_write_slice(
   int x, hid_t dspace, hid_t dset, hid_t memspace, void* buf);
 
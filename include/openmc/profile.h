@@ -0,0 +1,118 @@
+//! \file profile.h
+//! Counts of transport events in each material, cell, and nuclide
+
+#ifndef OPENMC_PROFILE_H
+#define OPENMC_PROFILE_H
+
+#include <cstdint>
+
+#include "openmc/constants.h"
+#include "openmc/openmp_interface.h"
+#include "openmc/particle.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Events that took place in one material or cell
+//==============================================================================
+
+struct ProfileCounts {
+  int64_t xs_lookups {0};        //!< macroscopic cross section evaluations
+  int64_t segments {0};          //!< tracks advanced between events
+  int64_t collisions {0};        //!< collisions
+  int64_t surface_crossings {0}; //!< surfaces crossed out of the cell
+  double track_length {0.0};     //!< summed length of the tracks in [cm]
+};
+
+//==============================================================================
+//! Counts of one thread, which only it updates
+//==============================================================================
+
+struct ThreadProfile {
+  vector<ProfileCounts> materials;    //!< counts in each material
+  vector<ProfileCounts> cells;        //!< counts in each cell
+  vector<int64_t> nuclide_collisions; //!< collisions with each nuclide
+};
+
+namespace simulation {
+
+//! Counts of each thread, indexed by thread number. Empty unless
+//! settings::profile is set.
+extern vector<ThreadProfile> profile;
+
+} // namespace simulation
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Allocate and zero the counts of each thread if a profile is requested
+void reset_profile();
+
+//! Sum the counts over all threads and processes and write them to
+//! profile.h5 in the output directory
+void write_profile();
+
+//! Free memory associated with the profile
+void free_memory_profile();
+
+// The functions below record an event of a particle. Each only tests whether
+// a profile is kept when it is not.
+
+//! Record a lookup of the cross sections of the particle's material
+inline void profile_xs_lookup(const Particle& p)
+{
+  if (simulation::profile.empty())
+    return;
+  auto& prof = simulation::profile[thread_num()];
+  ++prof.cells[p.lowest_coord().cell].xs_lookups;
+  ++prof.materials[p.material()].xs_lookups;
+}
+
+//! Record a track through the particle's cell and material
+//! \param distance Length of the track in [cm]
+inline void profile_segment(const Particle& p, double distance)
+{
+  if (simulation::profile.empty())
+    return;
+  auto& prof = simulation::profile[thread_num()];
+  auto& cell = prof.cells[p.lowest_coord().cell];
+  ++cell.segments;
+  cell.track_length += distance;
+  if (p.material() != MATERIAL_VOID) {
+    auto& mat = prof.materials[p.material()];
+    ++mat.segments;
+    mat.track_length += distance;
+  }
+}
+
+//! Record a collision in the particle's cell and material along with the
+//! nuclide it collided with
+inline void profile_collision(const Particle& p)
+{
+  if (simulation::profile.empty())
+    return;
+  auto& prof = simulation::profile[thread_num()];
+  ++prof.cells[p.lowest_coord().cell].collisions;
+  if (p.material() != MATERIAL_VOID)
+    ++prof.materials[p.material()].collisions;
+  int i_nuclide = p.event_nuclide();
+  if (i_nuclide >= 0 && i_nuclide < prof.nuclide_collisions.size())
+    ++prof.nuclide_collisions[i_nuclide];
+}
+
+//! Record a surface crossing out of the particle's cell and material
+inline void profile_surface_crossing(const Particle& p)
+{
+  if (simulation::profile.empty())
+    return;
+  auto& prof = simulation::profile[thread_num()];
+  ++prof.cells[p.lowest_coord().cell].surface_crossings;
+  if (p.material() != MATERIAL_VOID)
+    ++prof.materials[p.material()].surface_crossings;
+}
+
+} // namespace openmc
+
+#endif // OPENMC_PROFILE_H
@@ -24,6 +24,47 @@ constexpr int64_t DEFAULT_SEED {1};
 
 double prn(uint64_t* seed);
 
+//==============================================================================
+//! Generate one pseudo-random number from each of several seeds.
+//!
+//! The result for each seed is the same as from calling `prn()` on it, so
+//! the streams of particles processed together in an event kernel stay
+//! reproducible. The seeds are independent, which lets the loop over them be
+//! vectorized.
+//! @param n Number of seeds
+//! @param seeds Pseudorandom number seeds, each of which is advanced
+//! @param values Random numbers between 0 and 1, one per seed
+//==============================================================================
+
+void prn(int64_t n, uint64_t* seeds, double* values);
+
+//==============================================================================
+//! Generate a pseudo-random number using a counter-based generator.
+//!
+//! The number is a Threefry-2x64 hash of the counter, keyed by the key and
+//! the master seed, so it depends only on its arguments rather than on a
+//! state updated by earlier draws. Keying by a particle ID and counting its
+//! events gives a stream that is reproducible no matter how the particle's
+//! events are scheduled.
+//! @param key Key of the stream, e.g. a particle ID
+//! @param counter Position in the stream, e.g. an event counter
+//! @return A random number in [0, 1)
+//==============================================================================
+
+double counter_prn(uint64_t key, uint64_t counter);
+
+//==============================================================================
+//! Generate pseudo-random numbers at one position of several counter-based
+//! streams.
+//! @param n Number of streams
+//! @param keys Key of each stream
+//! @param counter Position in the streams
+//! @param values Random numbers in [0, 1), one per stream
+//==============================================================================
+
+void counter_prn(
+  int64_t n, const uint64_t* keys, uint64_t counter, double* values);
+
 //==============================================================================
 //! Generate a random number which is 'n' times ahead from the current seed.
 //!
@@ -1,48 +1,17 @@
 #ifndef OPENMC_RANDOM_RAY_FLAT_SOURCE_DOMAIN_H
 #define OPENMC_RANDOM_RAY_FLAT_SOURCE_DOMAIN_H
 
+#include <unordered_set>
+#include <utility> // for pair
+
 #include "openmc/constants.h"
+#include "openmc/mesh.h"
 #include "openmc/openmp_interface.h"
 #include "openmc/position.h"
 #include "openmc/source.h"
 
 namespace openmc {
 
-//----------------------------------------------------------------------------
-// Helper Functions
-
-// The hash_combine function is the standard hash combine function from boost
-// that is typically used for combining multiple hash values into a single hash
-// as is needed for larger objects being stored in a hash map. The function is
-// taken from:
-// https://www.boost.org/doc/libs/1_55_0/doc/html/hash/reference.html#boost.hash_combine
-// which carries the following license:
-//
-// Boost Software License - Version 1.0 - August 17th, 2003
-// Permission is hereby granted, free of charge, to any person or organization
-// obtaining a copy of the software and accompanying documentation covered by
-// this license (the "Software") to use, reproduce, display, distribute,
-// execute, and transmit the Software, and to prepare derivative works of the
-// Software, and to permit third-parties to whom the Software is furnished to
-// do so, all subject to the following:
-// The copyright notices in the Software and this entire statement, including
-// the above license grant, this restriction and the following disclaimer,
-// must be included in all copies of the Software, in whole or in part, and
-// all derivative works of the Software, unless such copies or derivative
-// works are solely in the form of machine-executable object code generated by
-// a source language processor.
-// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
-// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
-// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
-// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
-// DEALINGS IN THE SOFTWARE.
-inline void hash_combine(size_t& seed, const size_t v)
-{
-  seed ^= (v + 0x9e3779b9 + (seed << 6) + (seed >> 2));
-}
-
 //----------------------------------------------------------------------------
 // Helper Structs
 
@@ -60,25 +29,11 @@ struct TallyTask {
   {}
   TallyTask() = default;
 
-  // Comparison and Hash operators are defined to allow usage of the
-  // TallyTask struct as a key in an unordered_set
   bool operator==(const TallyTask& other) const
   {
     return tally_idx == other.tally_idx && filter_idx == other.filter_idx &&
            score_idx == other.score_idx && score_type == other.score_type;
   }
-
-  struct HashFunctor {
-    size_t operator()(const TallyTask& task) const
-    {
-      size_t seed = 0;
-      hash_combine(seed, task.tally_idx);
-      hash_combine(seed, task.filter_idx);
-      hash_combine(seed, task.score_idx);
-      hash_combine(seed, task.score_type);
-      return seed;
-    }
-  };
 };
 
 /*
@@ -92,7 +47,7 @@ public:
   //----------------------------------------------------------------------------
   // Constructors and Destructors
   FlatSourceDomain();
-  virtual ~FlatSourceDomain() = default;
+  virtual ~FlatSourceDomain();
 
   //----------------------------------------------------------------------------
   // Methods
@@ -104,6 +59,7 @@ public:
   int64_t add_source_to_scalar_flux();
   virtual void batch_reset();
   void convert_source_regions_to_tallies();
+  std::pair<int64_t, int64_t> tally_source_regions() const;
   void reset_tally_volumes();
   void random_ray_tally();
   virtual void accumulate_iteration_flux();
@@ -114,6 +70,22 @@ public:
   virtual void flux_swap();
   virtual double evaluate_flux_at_point(Position r, int64_t sr, int g) const;
   double compute_fixed_source_normalization_factor() const;
+  void reduce_thread_accumulators();
+
+  //! Memory used by the source regions and the arrays indexed by them in [MB]
+  virtual double memory() const;
+  void accelerate_scalar_flux();
+  void set_adjoint_sources(vector<float> forward_flux);
+  const vector<float>& scalar_flux_final() const { return scalar_flux_final_; }
+  int mesh_bin(int i_cell, Position r) const;
+
+  //! Index of the source region of a mesh bin within a cell instance
+  int64_t source_region_index(int i_cell, int instance, int mesh_bin) const
+  {
+    return source_region_offsets_[i_cell] +
+           static_cast<int64_t>(instance) * source_region_bins_[i_cell] +
+           mesh_bin;
+  }
 
   //----------------------------------------------------------------------------
   // Static Data members
@@ -122,12 +94,30 @@ public:
   //----------------------------------------------------------------------------
   // Static data members
   static RandomRayVolumeEstimator volume_estimator_;
+  static int32_t source_region_mesh_id_; // Mesh subdividing source regions
+  static std::unordered_set<int32_t>
+    source_region_mesh_cells_; // IDs of cells subdivided (all if empty)
+  static int anderson_depth_; // Previous iterations used for extrapolation
+  static bool adjoint_;        // Whether an adjoint solve follows the forward
+  static bool adjoint_active_; // Whether the adjoint equation is being solved
+
+  // Maximum number of values in the per-thread scalar flux buffers for them to
+  // be used to accumulate the flux of flat source regions
+  static constexpr int64_t MAX_PRIVATE_ACCUMULATOR_SIZE {1 << 24};
+
+  // Maximum number of energy groups for the flux of flat source regions to be
+  // accumulated with atomic operations
+  static constexpr int MAX_ATOMIC_ACCUMULATOR_GROUPS {8};
 
   //----------------------------------------------------------------------------
   // Public Data members
 
   bool mapped_all_tallies_ {false}; // If all source regions have been visited
 
+  // How ray segments accumulate the flux and volume of source regions during
+  // the transport sweep
+  RandomRayAccumulation accumulation_ {RandomRayAccumulation::LOCK};
+
   int64_t n_source_regions_ {0}; // Total number of source regions in the model
   int64_t n_external_source_regions_ {0}; // Total number of source regions with
                                           // non-zero external source terms
@@ -136,6 +126,12 @@ public:
   // in model::cells
   vector<int64_t> source_region_offsets_;
 
+  // 1D arrays representing the number of source regions in each instance of
+  // each OpenMC Cell in model::cells, and the mesh subdividing them if any.
+  // Parts of a subdivided cell outside the mesh form one more source region.
+  vector<int> source_region_bins_;
+  vector<const StructuredMesh*> source_region_meshes_;
+
   // 1D arrays representing values for all source regions
   vector<OpenMPMutex> lock_;
   vector<double> volume_;
@@ -151,9 +147,24 @@ public:
   vector<float> external_source_;
   vector<bool> external_source_present_;
 
+  // Scalar flux and volume accumulated by each thread during the transport
+  // sweep, when using private accumulation
+  vector<vector<double>> thread_scalar_flux_;
+  vector<vector<double>> thread_volume_;
+
+  // 2D array stored in 1D representing the total cross section of all
+  // materials x energy groups, read by the flux attenuation of each segment
+  vector<float> sigma_t_;
+
 protected:
   //----------------------------------------------------------------------------
   // Methods
+  void flatten_xs();
+  void transpose_xs();
+  void partition_source_regions();
+  vector<int> gather_counts(int values_per_region) const;
+  vector<int> gather_offsets(int values_per_region) const;
+  virtual void allgather_source();
   void apply_external_source_to_source_region(
     Discrete* discrete, double strength_factor, int64_t source_region);
   void apply_external_source_to_cell_instances(int32_t i_cell,
@@ -176,20 +187,47 @@ protected:
     simulation_volume_; // Total physical volume of the simulation domain, as
                         // defined by the 3D box of the random ray source
 
-  // 2D array representing values for all source elements x tally
-  // tasks
-  vector<vector<TallyTask>> tally_task_;
+  // Tally tasks of all source elements in compressed sparse row form. The
+  // tasks of source element se are tally_tasks_[tally_task_offsets_[se]] up to
+  // but excluding tally_tasks_[tally_task_offsets_[se + 1]].
+  vector<int64_t> tally_task_offsets_;
+  vector<TallyTask> tally_tasks_;
 
-  // 1D array representing values for all source regions, with each region
-  // containing a set of volume tally tasks. This more complicated data
-  // structure is convenient for ensuring that volumes are only tallied once per
-  // source region, regardless of how many energy groups are used for tallying.
-  vector<std::unordered_set<TallyTask, TallyTask::HashFunctor>> volume_task_;
+  // Flux tally tasks of all source regions in the same form, without
+  // duplicates across energy groups, so that volumes are only tallied once per
+  // source region regardless of how many energy groups are used for tallying.
+  vector<int64_t> volume_task_offsets_;
+  vector<TallyTask> volume_tasks_;
+
+  // 1D array indicating whether the tally tasks of each source region have
+  // been found. Only the source regions tallied by this process are mapped.
+  vector<int> tally_mapped_;
 
   // 1D arrays representing values for all source regions
   vector<int> material_;
   vector<double> volume_naive_;
 
+  // Range of source regions whose source is updated by this process. The
+  // updated sources are then gathered on all processes.
+  int64_t sr_begin_ {0};
+  int64_t sr_end_ {0};
+
+  // Cross sections of all materials used to update the source, stored in 1D
+  // with the energy group of the incoming neutron varying fastest
+  vector<double> source_sigma_t_; // materials x groups
+  vector<double> nu_sigma_f_;     // materials x groups
+  vector<double> nu_sigma_s_;     // materials x outgoing x incoming groups
+  vector<double> chi_;            // materials x outgoing x incoming groups
+
+  // Changes in the scalar flux computed by the transport sweep and in its
+  // residual over the last anderson_depth_ iterations, used to extrapolate the
+  // scalar flux, stored as a ring buffer starting at anderson_next_
+  vector<vector<double>> anderson_dg_;
+  vector<vector<double>> anderson_df_;
+  vector<double> anderson_g_prev_; // Flux computed by the last sweep
+  vector<double> anderson_f_prev_; // Residual of the last sweep
+  int anderson_next_ {0};
+
   // 2D arrays stored in 1D representing values for all source regions x energy
   // groups
   vector<float> scalar_flux_final_;
@@ -40,6 +40,7 @@ public:
   void count_external_source_regions();
   void flux_swap() override;
   double evaluate_flux_at_point(Position r, int64_t sr, int g) const override;
+  double memory() const override;
 
   //----------------------------------------------------------------------------
   // Public Data members
@@ -60,6 +61,7 @@ protected:
   void set_flux_to_flux_plus_source(
     int64_t idx, double volume, int material, int g) override;
   void set_flux_to_old_flux(int64_t idx) override;
+  void allgather_source() override;
 
 }; // class LinearSourceDomain
 
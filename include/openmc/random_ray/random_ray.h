@@ -9,6 +9,20 @@
 
 namespace openmc {
 
+// A segment of a ray within a source region, as recorded for replay
+struct RaySegment {
+  int64_t source_region;
+  double distance;
+  int32_t material;
+  bool is_active; // Whether the segment is in the active length of the ray
+};
+
+// The starting source region and the segments of a traced ray
+struct CachedRay {
+  int64_t start_region;
+  vector<RaySegment> segments;
+};
+
 /*
  * The RandomRay class encompasses data and methods for transporting random rays
  * through the model. It is a small extension of the Particle class.
@@ -25,12 +39,26 @@ public:
   //----------------------------------------------------------------------------
   // Methods
   void event_advance_ray();
+  void event_find_segment();
+  void event_attenuate_segment();
+  void event_move_along_segment();
   void attenuate_flux(double distance, bool is_active);
   void attenuate_flux_flat_source(double distance, bool is_active);
   void attenuate_flux_linear_source(double distance, bool is_active);
+  void attenuate_flux_flat_source_region(int64_t source_region, int material,
+    double distance, bool is_active, const Position* midpoint);
 
   void initialize_ray(uint64_t ray_id, FlatSourceDomain* domain);
   uint64_t transport_history_based_single_ray();
+  void record_segments(CachedRay* cached_ray);
+  int64_t current_source_region() const;
+  double update_mesh_bin();
+  uint64_t replay_cached_ray(
+    const CachedRay& cached_ray, FlatSourceDomain* domain);
+
+  //----------------------------------------------------------------------------
+  // Accessors
+  bool mesh_crossed() const { return mesh_crossed_; }
 
   //----------------------------------------------------------------------------
   // Static data members
@@ -38,6 +66,8 @@ public:
   static double distance_active_;            // Active ray length
   static unique_ptr<Source> ray_source_;     // Starting source for ray sampling
   static RandomRaySourceShape source_shape_; // Flag for linear source
+  static int segment_cache_iterations_; // Iterations that traced rays are used
+  static double segment_cache_memory_;  // Max memory of cached rays in [MB]
 
   //----------------------------------------------------------------------------
   // Public data members
@@ -50,10 +80,16 @@ private:
   // Private data members
   vector<float> delta_psi_;
   vector<MomentArray> delta_moments_;
+  vector<float> exp_g_;  // exponentialG of each group for the segment
+  vector<float> exp_g2_; // exponentialG2 of each group for the segment
 
   int negroups_;
   FlatSourceDomain* domain_ {nullptr}; // pointer to domain that has flat source
                                        // data needed for ray transport
+  CachedRay* cached_ray_ {nullptr}; // where segments are recorded, if at all
+  int mesh_bin_ {0};            // bin of the mesh subdividing the cell
+  bool mesh_crossed_ {false};   // if the last segment ended on a mesh boundary
+  double segment_distance_ {0}; // length of the current segment
   double distance_travelled_ {0};
   bool is_active_ {false};
   bool is_alive_ {true};
@@ -1,8 +1,10 @@
 #ifndef OPENMC_RANDOM_RAY_SIMULATION_H
 #define OPENMC_RANDOM_RAY_SIMULATION_H
 
+#include "openmc/memory_report.h"
 #include "openmc/random_ray/flat_source_domain.h"
 #include "openmc/random_ray/linear_source_domain.h"
+#include "openmc/random_ray/random_ray.h"
 
 namespace openmc {
 
@@ -20,7 +22,10 @@ public:
   //----------------------------------------------------------------------------
   // Methods
   void compute_segment_correction_factors();
+  void prepare_fixed_sources();
+  void prepare_fixed_sources_adjoint(const vector<float>& forward_flux);
   void simulate();
+  uint64_t transport_sweep_event_based();
   void reduce_simulation_statistics();
   void output_simulation_results() const;
   void instability_check(
@@ -29,6 +34,13 @@ public:
     double avg_miss_rate, int negroups, int64_t n_source_regions,
     int64_t n_external_source_regions) const;
 
+  //! Memory used by the source regions and the cached rays
+  vector<MemoryUse> memory_usage() const;
+
+  //----------------------------------------------------------------------------
+  // Accessors
+  const FlatSourceDomain* domain() const { return domain_.get(); }
+
   //----------------------------------------------------------------------------
   // Data members
 private:
@@ -48,6 +60,12 @@ private:
   // Number of energy groups
   int negroups_;
 
+  // Segments of the rays traced in the last iteration in which rays were
+  // sampled, which are replayed in the following iterations
+  vector<CachedRay> cached_rays_;
+  bool cache_valid_ {false};
+  bool cache_overflow_ {false}; // If segments did not fit in memory
+
 }; // class RandomRaySimulation
 
 //============================================================================
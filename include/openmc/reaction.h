@@ -50,10 +50,23 @@ public:
   double collapse_rate(gsl::index i_temp, gsl::span<const double> energy,
     gsl::span<const double> flux, const vector<double>& grid) const;
 
+  //! Move cross sections to memory shared by the processes on a node
+  //
+  //! This must be called by every process on the node in the same order.
+  void share_xs();
+
+  //! Type in which cross section values are stored
+#ifdef OPENMC_SINGLE_PRECISION_XS
+  using XsValue = float;
+#else
+  using XsValue = double;
+#endif
+
   //! Cross section at a single temperature
   struct TemperatureXS {
     int threshold;
-    vector<double> value;
+    gsl::span<const XsValue> value; //!< Values, possibly shared or cached
+    vector<XsValue> storage; //!< Values, unless shared on a node or cached
   };
 
   int mt_;                           //!< ENDF MT value
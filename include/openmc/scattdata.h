@@ -7,6 +7,7 @@
 #include "xtensor/xtensor.hpp"
 
 #include "openmc/constants.h"
+#include "openmc/distribution.h"
 #include "openmc/vector.h"
 
 namespace openmc {
@@ -44,6 +45,15 @@ public:
   xt::xtensor<int, 1> gmax;       // maximum outgoing group
   xt::xtensor<double, 1> scattxs; // Isotropic Sigma_{s,g_{in}}
 
+  //! Cumulative sums of energy for all incoming groups in one array, with
+  //! those of group gin starting at energy_cdf_start[gin]
+  vector<double> energy_cdf;
+  vector<int> energy_cdf_start;
+
+  //! Alias tables of energy for each incoming group, empty unless
+  //! settings::mg_alias_sampling is set
+  vector<DiscreteIndex> energy_alias;
+
   //! \brief Calculates the value of normalized f(mu).
   //!
   //! The value of f(mu) is normalized as in the integral of f(mu)dmu across
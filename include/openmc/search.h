@@ -4,7 +4,9 @@
 #ifndef OPENMC_SEARCH_H
 #define OPENMC_SEARCH_H
 
-#include <algorithm> // for lower_bound, upper_bound
+#include <algorithm> // for lower_bound, max, min, upper_bound
+
+#include "openmc/vector.h"
 
 namespace openmc {
 
@@ -26,6 +28,148 @@ typename std::iterator_traits<It>::difference_type upper_bound_index(
   return std::upper_bound(first, last, value) - first - 1;
 }
 
+//==============================================================================
+//! Guide table for searching a tabulated CDF in constant expected time
+//
+//! The unit interval is split into equal cells and each cell stores the bin of
+//! the CDF containing its lower edge, where bin j lies between cdf[j] and
+//! cdf[j+1]. A linear search for the bin containing a random number can then
+//! start at the bin of its cell instead of the first bin and still finds the
+//! same bin, visiting about n_bins / n_cells + 1 bins on average.
+//==============================================================================
+
+class GuideTable {
+public:
+  GuideTable() = default;
+
+  //! Build the table for a CDF
+  //
+  //! \param[in] cdf  Nondecreasing CDF values
+  //! \param[in] n_cells  Number of cells
+  template<class T>
+  GuideTable(const T& cdf, int n_cells) : start_(n_cells)
+  {
+    int n_bins = cdf.size() - 1;
+    int j = 0;
+    for (int g = 0; g < n_cells; ++g) {
+      double r = static_cast<double>(g) / n_cells;
+      while (j + 1 < n_bins && cdf[j + 1] <= r) {
+        ++j;
+      }
+      start_[g] = j;
+    }
+  }
+
+  //! Whether the table has been built
+  bool empty() const { return start_.empty(); }
+
+  //! Bin at which to start searching for a random number in [0,1)
+  int start(double r) const
+  {
+    return start_[static_cast<int>(r * start_.size())];
+  }
+
+  //! Find the bin of a tabulated function containing a value
+  //
+  //! The table may have been built for the tabulated values after a linear
+  //! normalization to [0,1]. The search steps back from the start bin in case
+  //! rounding of the normalized values placed it past the bin, so that the
+  //! bin is the same as given by lower_bound_index for values within the
+  //! range of the table.
+  //! \param[in] x  Nondecreasing tabulated values
+  //! \param[in] n  Number of tabulated values
+  //! \param[in] value  Value to search for
+  //! \param[in] r  Normalized value
+  //! \return Index of the lower bound of the bin, between 0 and n - 2
+  template<class T>
+  int find(const T& x, int n, double value, double r) const
+  {
+    int i = (r >= 0.0 && r < 1.0) ? this->start(r) : (r < 0.0 ? 0 : n - 2);
+    i = std::min(i, n - 2);
+    while (i > 0 && x[i] >= value) {
+      --i;
+    }
+    while (i + 2 < n && x[i + 1] < value) {
+      ++i;
+    }
+    return i;
+  }
+
+private:
+  vector<int> start_; //!< First bin to search in each cell
+};
+
+//==============================================================================
+//! Maximum of tabulated values over index ranges
+//
+//! The values are split into blocks of equal size and the maximum of each
+//! block is stored, so that the maximum over a range only needs to look at
+//! the values in the partial blocks at its ends and at the maxima of the
+//! blocks in between.
+//==============================================================================
+
+class RangeMaximum {
+public:
+  RangeMaximum() = default;
+
+  //! Build the block maxima of tabulated values
+  //
+  //! \param[in] x  Tabulated values
+  //! \param[in] block_size  Number of values in each block
+  template<class T>
+  RangeMaximum(const T& x, int block_size) : block_size_(block_size)
+  {
+    int n = x.size();
+    for (int i = 0; i < n; i += block_size_) {
+      double m = x[i];
+      for (int j = i + 1; j < std::min(i + block_size_, n); ++j) {
+        m = std::max(m, static_cast<double>(x[j]));
+      }
+      block_max_.push_back(m);
+    }
+  }
+
+  //! Whether the block maxima have been built
+  bool empty() const { return block_max_.empty(); }
+
+  //! Maximum of the tabulated values with indices in [first, last)
+  //
+  //! \param[in] x  Tabulated values the block maxima were built for
+  //! \param[in] first  Index of the first value, less than last
+  //! \param[in] last  One past the index of the last value
+  //! 
+eturn Same value as std::max_element over the range
+  template<class T>
+  double operator()(const T& x, int first, int last) const
+  {
+    int b_first = (first + block_size_ - 1) / block_size_;
+    int b_last = last / block_size_;
+    if (b_first >= b_last) {
+      double m = x[first];
+      for (int i = first + 1; i < last; ++i) {
+        m = std::max(m, static_cast<double>(x[i]));
+      }
+      return m;
+    }
+
+    double m = block_max_[b_first];
+    for (int b = b_first + 1; b < b_last; ++b) {
+      m = std::max(m, block_max_[b]);
+    }
+    for (int i = first; i < b_first * block_size_; ++i) {
+      m = std::max(m, static_cast<double>(x[i]));
+    }
+    for (int i = b_last * block_size_; i < last; ++i) {
+      m = std::max(m, static_cast<double>(x[i]));
+    }
+    return m;
+  }
+
+private:
+  int block_size_ {1};       //!< Number of values in each block
+  vector<double> block_max_; //!< Maximum of the values in each block
+};
+
 } // namespace openmc
 
 #endif // OPENMC_SEARCH_H
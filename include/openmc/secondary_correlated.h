@@ -10,6 +10,7 @@
 #include "openmc/angle_energy.h"
 #include "openmc/distribution.h"
 #include "openmc/endf.h"
+#include "openmc/search.h"
 #include "openmc/vector.h"
 
 namespace openmc {
@@ -28,6 +29,7 @@ public:
     xt::xtensor<double, 1> e_out;      //!< Outgoing energies [eV]
     xt::xtensor<double, 1> p;          //!< Probability density
     xt::xtensor<double, 1> c;          //!< Cumulative distribution
+    GuideTable guide;                  //!< Guide table for searching c
     vector<unique_ptr<Tabular>> angle; //!< Angle distribution
   };
 
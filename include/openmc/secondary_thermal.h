@@ -6,6 +6,7 @@
 
 #include "openmc/angle_energy.h"
 #include "openmc/endf.h"
+#include "openmc/search.h"
 #include "openmc/secondary_correlated.h"
 #include "openmc/vector.h"
 
@@ -143,6 +144,7 @@ private:
     xt::xtensor<double, 1> e_out_pdf; //!< Probability density function
     xt::xtensor<double, 1> e_out_cdf; //!< Cumulative distribution function
     xt::xtensor<double, 2> mu; //!< Equiprobable angles at each outgoing energy
+    GuideTable e_out_guide;    //!< Guide table for searching e_out_cdf
   };
 
   vector<double> energy_;              //!< Incident energies
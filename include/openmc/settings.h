@@ -33,39 +33,67 @@ namespace settings {
 // Boolean flags
 extern bool assume_separate;      //!< assume tallies are spatially separate?
 extern bool check_overlaps;       //!< check overlaps in geometry?
+extern bool compact_micro_xs; //!< only cache micro xs of current material?
 extern bool confidence_intervals; //!< use confidence intervals for results?
 extern bool
   create_fission_neutrons; //!< create fission neutrons (fixed source)?
 extern bool create_delayed_neutrons; //!< create delayed fission neutrons?
 extern "C" bool cmfd_run;            //!< is a CMFD run?
+extern bool dry_run; //!< stop after reporting the memory of initialization?
 extern bool
   delayed_photon_scaling;   //!< Scale fission photon yield to include delayed
 extern "C" bool entropy_on; //!< calculate Shannon entropy?
 extern "C" bool
   event_based; //!< use event-based mode (instead of history-based)
+extern bool event_autotune; //!< tune event-based transport in first batches?
+extern bool event_queue_sort; //!< sort XS event queues before lookups?
+extern bool
+  event_secondary_queue; //!< share secondaries between event-based slots?
+extern bool fission_matrix_on; //!< accelerate source with a fission matrix?
 extern bool legendre_to_tabular; //!< convert Legendre distributions to tabular?
+extern bool load_balancing; //!< rebalance particles across ranks by speed?
 extern bool material_cell_offsets; //!< create material cells offsets?
+extern bool memory_report; //!< report the memory used by each subsystem?
+extern bool mg_alias_sampling; //!< sample MG outgoing groups by alias tables?
+extern bool neighbor_list_precompute; //!< fill neighbor lists before transport?
+extern bool neighbor_list_reorder; //!< sort neighbor lists by hits?
+extern bool numa_interleave; //!< interleave nuclear data over NUMA nodes?
 extern "C" bool output_summary;    //!< write summary.h5?
+extern bool overlap_bank_sync; //!< overlap bank exchange with transport?
+extern bool overlap_reduction; //!< overlap tally reduction with transport?
+extern bool hierarchical_reduce; //!< reduce on each node, then across nodes?
 extern bool output_tallies;        //!< write tallies.out?
 extern bool particle_restart_run;  //!< particle restart run?
+extern bool pipeline_batches; //!< finish batches while the next transports?
 extern "C" bool photon_transport;  //!< photon transport turned on?
+extern bool profile; //!< count events in each material, cell and nuclide?
 extern "C" bool reduce_tallies;    //!< reduce tallies at end of batch?
 extern bool res_scat_on;           //!< use resonance upscattering method?
 extern "C" bool restart_run;       //!< restart run?
 extern "C" bool run_CE;            //!< run with continuous-energy data?
+extern bool shared_xs; //!< share cross sections between processes on a node?
+extern bool simplify_regions; //!< remove redundant half-spaces of regions?
 extern bool source_latest;         //!< write latest source at each batch?
 extern bool source_separate;       //!< write source to separate file?
+extern bool source_shards; //!< write source of each process to its own file?
+extern bool source_domain_bounds; //!< sample box sources within domains?
+extern bool statepoint_async; //!< write state points in the background?
 extern bool source_write;          //!< write source in HDF5 files?
 extern bool source_mcpl_write;     //!< write source in mcpl files?
 extern bool surf_source_write;     //!< write surface source file?
 extern bool surf_mcpl_write;       //!< write surface mcpl file?
+extern bool surf_source_stream; //!< write surface source while banking?
 extern bool surf_source_read;      //!< read surface source file?
+extern bool surface_distance_cache; //!< reuse surface distances along a ray?
 extern bool survival_biasing;      //!< use survival biasing?
+extern bool tally_stream;          //!< stream tally results each batch?
 extern bool temperature_multipole; //!< use multipole data?
+extern bool thread_stats;          //!< keep the work done by each thread?
 extern "C" bool trigger_on;        //!< tally triggers enabled?
 extern bool trigger_predict;       //!< predict batches for triggers?
 extern bool ufs_on;                //!< uniform fission site method on?
 extern bool urr_ptables_on;        //!< use unresolved resonance prob. tables?
+extern bool vectorized_xs; //!< interpolate several nuclide xs at once?
 extern "C" bool weight_windows_on; //!< are weight windows are enabled?
 extern bool weight_window_checkpoint_surface;   //!< enable weight window check
                                                 //!< upon surface crossing?
@@ -76,11 +104,16 @@ extern bool write_initial_source; //!< write out initial source file?
 
 // Paths to various files
 extern std::string path_cross_sections; //!< path to cross_sections.xml
+extern std::string path_geometry_cache; //!< path to a geometry cache
 extern std::string path_input;  //!< directory where main .xml files resides
 extern std::string path_output; //!< directory where output files are written
 extern std::string path_particle_restart; //!< path to a particle restart file
 extern std::string path_sourcepoint;      //!< path to a source file
 extern std::string path_statepoint;       //!< path to a statepoint file
+extern std::string path_telemetry;        //!< path to a telemetry file
+extern std::string path_xs_cache;         //!< path to a cross section cache
+extern std::string tally_stream_engine;   //!< ADIOS2 engine of tally stream
+extern std::string tally_stream_name;     //!< name of the tally stream
 extern std::string weight_windows_file;   //!< Location of weight window file to
                                           //!< load on simulation initialization
 
@@ -103,12 +136,33 @@ extern "C" int64_t n_particles;   //!< number of particles per generation
 extern int64_t
   max_particles_in_flight;      //!< Max num. event-based particles in flight
 extern int max_particle_events; //!< Maximum number of particle events
+extern int64_t event_thread_pool; //!< Number of particles in each thread's
+                                  //!< private event-based pool (0 = shared)
+extern int64_t event_history_tail; //!< Number of in-flight particles below
+                                   //!< which event-based transport switches
+                                   //!< to history-based
+extern int event_xs_queue_groups; //!< Number of material groups with their
+                                  //!< own XS event queue (0 = fissionable
+                                  //!< and non-fissionable split)
+extern vector<int32_t>
+  delta_tracking_cells; //!< IDs of cells in which delta tracking is used
+extern bool electron_inline_deposition; //!< deposit LED electrons at the
+                                       //!< collision creating them?
 extern ElectronTreatment
   electron_treatment; //!< how to treat secondary electrons
+extern OutputCompression
+  output_compression; //!< filter for large HDF5 datasets
+extern int output_compression_level; //!< level of the compression filter
+extern int64_t output_chunk_size;    //!< bytes in a compressed dataset chunk
 extern array<double, 4>
   energy_cutoff; //!< Energy cutoff in [eV] for each particle type
 extern array<double, 4>
   time_cutoff; //!< Time cutoff in [s] for each particle type
+extern vector<double> census_times; //!< Increasing census times in [s]
+extern vector<int32_t> tally_stream_ids; //!< IDs of streamed tallies
+extern int guide_table_cells; //!< Number of guide table cells for sampling
+                              //!< tabulated distributions (0 = none)
+extern bool inelastic_scatter_cdf; //!< tabulate sums of inelastic xs?
 extern int
   legendre_to_tabular_points; //!< number of points to convert Legendres
 extern int max_order;         //!< Maximum Legendre order for multigroup data
@@ -116,6 +170,14 @@ extern int n_log_bins;        //!< number of bins for logarithmic energy grid
 extern int n_batches;         //!< number of (inactive+active) batches
 extern int n_max_batches;     //!< Maximum number of batches
 extern int max_tracks; //!< Maximum number of particle tracks written to file
+extern bool photon_material_xs; //!< tabulate photon xs of each material?
+extern bool photon_only; //!< transport photons without neutron data?
+extern bool photon_product_cdf; //!< tabulate sums of photon production xs?
+extern bool prune_nuclear_data; //!< free nuclear data the run cannot use?
+extern double
+  photon_xs_tolerance; //!< Rel. tolerance of tabulated photon xs, 0 if unused
+extern double
+  ncrystal_xs_tolerance; //!< Rel. tolerance of NCrystal xs tables, 0 if unused
 extern ResScatMethod res_scat_method; //!< resonance upscattering method
 extern double res_scat_energy_min; //!< Min energy in [eV] for res. upscattering
 extern double res_scat_energy_max; //!< Max energy in [eV] for res. upscattering
@@ -123,6 +185,14 @@ extern vector<std::string>
   res_scat_nuclides;           //!< Nuclides using res. upscattering treatment
 extern RunMode run_mode;       //!< Run mode (eigenvalue, fixed src, etc.)
 extern SolverType solver_type; //!< Solver Type (Monte Carlo or Random Ray)
+extern int source_convergence_min; //!< Fewest inactive batches ended by the
+                                   //!< source convergence test
+extern double source_convergence_threshold; //!< Largest difference of the
+                                            //!< half-window means in
+                                            //!< standard errors
+extern int source_convergence_window; //!< Batches tested for source
+                                      //!< convergence, or 0 if unused
+extern ThreadAffinity thread_affinity; //!< placement of threads on cores
 extern std::unordered_set<int>
   sourcepoint_batch; //!< Batches when source should be written
 extern std::unordered_set<int>
@@ -139,20 +209,32 @@ extern SSWCellType ssw_cell_type;     //!< Type of option for the cell
                                       //!< argument of surface source write
 extern TemperatureMethod
   temperature_method; //!< method for choosing temperatures
+extern double
+  tally_private_memory; //!< Max memory in [MB] for a tally's thread copies
 extern double
   temperature_tolerance; //!< Tolerance in [K] on choosing temperatures
+extern double
+  track_buffer_memory; //!< Max memory in [MB] for a thread's pending tracks
 extern double temperature_default; //!< Default T in [K]
 extern array<double, 2>
   temperature_range;           //!< Min/max T in [K] over which to load xs
+extern int statepoint_delta; //!< Max delta state points between full ones
 extern int trace_batch;        //!< Batch to trace particle on
 extern int trace_gen;          //!< Generation to trace particle on
 extern int64_t trace_particle; //!< Particle ID to enable trace on
 extern vector<array<int, 3>>
   track_identifiers;               //!< Particle numbers for writing tracks
 extern int trigger_batch_interval; //!< Batch interval for triggers
+extern double
+  union_grid_memory; //!< Max memory in [MB] for unionized energy grid
 extern "C" int verbosity;          //!< How verbose to make output
+extern double warm_start_entropy_tolerance; //!< Entropy change ending the
+                                            //!< inactive batches of a warm
+                                            //!< start
+extern int warm_start_inactive; //!< Inactive batches of a warm start, or -1
 extern double weight_cutoff;       //!< Weight cutoff for Russian roulette
 extern double weight_survive;      //!< Survival weight after Russian roulette
+extern double wielandt_shift;      //!< Shift of k for Wielandt iteration
 
 } // namespace settings
 
@@ -169,6 +251,14 @@ void read_settings_xml(pugi::xml_node root);
 
 void free_memory_settings();
 
+//! Whether the run mode only needs the geometry, so that no nuclear data or
+//! tallies are read
+inline bool geometry_only()
+{
+  return settings::run_mode == RunMode::PLOTTING ||
+         settings::run_mode == RunMode::OVERLAP_CHECK;
+}
+
 } // namespace openmc
 
 #endif // OPENMC_SETTINGS_H
@@ -4,6 +4,8 @@
 //! \file shared_array.h
 //! \brief Shared array data structure
 
+#include <utility> // for swap
+
 #include "openmc/memory.h"
 
 namespace openmc {
@@ -107,6 +109,16 @@ public:
   //! \param size The new size of the container
   void resize(int64_t size) { size_ = size; }
 
+  //! Exchange the elements, size, and capacity with another container
+  //
+  //! \param other The container to exchange contents with
+  void swap(SharedArray& other)
+  {
+    data_.swap(other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  }
+
   //! Return whether the array is full
   bool full() const { return size_ == capacity_; }
 
@@ -16,6 +16,23 @@ constexpr int STATUS_EXIT_NORMAL {0};
 constexpr int STATUS_EXIT_MAX_BATCH {1};
 constexpr int STATUS_EXIT_ON_TRIGGER {2};
 
+//==============================================================================
+//! Quantities summed over the histories of a generation by one thread. The
+//! sums of each thread start on their own cache line so that threads adding
+//! to them at the end of each history do not write to the same line.
+//==============================================================================
+
+struct alignas(64) HistorySums {
+  double absorption {0.0};           //!< absorption estimate of k
+  double collision {0.0};            //!< collision estimate of k
+  double tracklength {0.0};          //!< track-length estimate of k
+  double leakage {0.0};              //!< weight leaking out of the geometry
+  double source_weight {0.0};        //!< starting weight of the histories
+  double wielandt_weight {0.0};      //!< weight born in-generation by Wielandt
+  int64_t xs_temperature_hits {0};   //!< xs reused at new temperatures
+  int64_t xs_temperature_misses {0}; //!< xs updated at new temperatures
+};
+
 //==============================================================================
 // Global variable declarations
 //==============================================================================
@@ -34,19 +51,35 @@ extern "C" double
   k_abs_tra;               //!< sum over batches of k_absorption * k_tracklength
 extern double log_spacing; //!< lethargy spacing for energy grid searches
 extern "C" int n_lost_particles;   //!< cumulative number of lost particles
+extern int64_t n_xs_temperature_hits;   //!< xs reused at new temperatures
+extern int64_t n_xs_temperature_misses; //!< xs updated at new temperatures
 extern "C" bool need_depletion_rx; //!< need to calculate depletion rx?
+extern bool persistent; //!< keep the source for the next simulation?
+extern bool need_element_photon_xs; //!< need photon xs of every element?
 extern "C" int restart_batch;      //!< batch at which a restart job resumed
 extern "C" bool satisfy_triggers;  //!< have tally triggers been satisfied?
+extern bool source_kept; //!< does the source bank hold the last source?
 extern "C" int total_gen;          //!< total number of generations simulated
+extern double time_transport_balanced; //!< transport time at last balance
+extern double time_transport_batch;    //!< transport time at batch start
 extern double total_weight;        //!< Total source weight in a batch
+extern double wielandt_weight; //!< weight born in-generation by Wielandt shift
 extern int64_t work_per_rank;      //!< number of particles per MPI rank
 
 extern const RegularMesh* entropy_mesh;
 extern const RegularMesh* ufs_mesh;
+extern const RegularMesh* fission_matrix_mesh;
 
 extern vector<double> k_generation;
 extern vector<int64_t> work_index;
 
+//! Ratio of the longest to the mean transport time across processes for each
+//! batch
+extern vector<double> load_imbalance;
+
+//! Sums of each thread over the current generation, indexed by thread number
+extern vector<HistorySums> history_sums;
+
 } // namespace simulation
 
 //==============================================================================
@@ -59,6 +92,35 @@ void allocate_banks();
 //! Determine number of particles to transport per process
 void calculate_work();
 
+//! Measure the transport time of each process during the current batch and,
+//! if load balancing is enabled, reassign particles to processes for the next
+//! batch in proportion to the rate at which each process transported them
+//
+//! \return Whether the number of particles on this process changed
+bool balance_work();
+
+//! Save the numbers of batches given in the settings, which the tests of
+//! source convergence may reduce
+void save_batch_counts();
+
+//! Use settings::warm_start_inactive inactive batches if the simulation starts
+//! from the source kept from the previous one
+void begin_warm_start();
+
+//! End the inactive batches of a warm-started simulation once the mean
+//! Shannon entropy of the last batches differs from that of the batches before
+//! them by less than settings::warm_start_entropy_tolerance
+void check_warm_start_convergence();
+
+//! End the inactive batches once neither k nor the Shannon entropy of the
+//! generations in the last settings::source_convergence_window batches shows
+//! a trend, skipping the remaining inactive batches
+void check_source_convergence();
+
+//! Restore the numbers of batches and the output batches given in the
+//! settings
+void restore_batch_counts();
+
 //! Initialize nuclear data before a simulation
 void initialize_data();
 
@@ -78,6 +140,21 @@ void initialize_history(Particle& p, int64_t index_source);
 //! appropriate
 void finalize_batch();
 
+//! Start completing the work deferred from the end of the last batch on a
+//! helper thread. Does nothing if no work is pending.
+void start_pipelined_batch();
+
+//! Complete the work deferred from the end of the last batch, waiting for the
+//! helper thread if it was started. Does nothing if no work is pending.
+void finish_pipelined_batch();
+
+//! Allocate the sums over the histories of a generation of each thread
+void init_history_sums();
+
+//! Add the sums of each thread over the histories of the generation to the
+//! global tallies, source weight and cross section statistics, and reset them
+void reduce_history_sums();
+
 //! Finalize a fission generation
 void finalize_generation();
 
@@ -90,6 +167,10 @@ void broadcast_results();
 
 void free_memory_simulation();
 
+//! Simulate the remaining events of a particle history (and all generated
+//! secondary particles, if enabled) up to, but not including, its death
+void transport_history_based_remaining(Particle& p);
+
 //! Simulate a single particle history (and all generated secondary particles,
 //!  if enabled), from birth to death
 void transport_history_based_single_particle(Particle& p);
@@ -100,6 +181,10 @@ void transport_history_based();
 //! Simulate all particle histories using event-based parallelism
 void transport_event_based();
 
+//! Simulate all particle histories using event-based parallelism where each
+//! thread runs the event kernels on its own private pool of particles
+void transport_event_based_thread_pool();
+
 } // namespace openmc
 
 #endif // OPENMC_SIMULATION_H
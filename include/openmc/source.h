@@ -8,7 +8,9 @@
 #include <unordered_set>
 
 #include "pugixml.hpp"
+#include <gsl/gsl-lite.hpp>
 
+#include "openmc/bounding_box.h"
 #include "openmc/distribution_multi.h"
 #include "openmc/distribution_spatial.h"
 #include "openmc/memory.h"
@@ -32,6 +34,26 @@ constexpr double EXTSRC_REJECT_FRACTION {0.05};
 
 class Source;
 
+//==============================================================================
+//! Numbers of sampled values accepted and rejected by the constraints of a
+//! source. They are updated atomically so that threads can share them.
+//==============================================================================
+
+class RejectionCounter {
+public:
+  //! Record an accepted value
+  void accept() const;
+
+  //! Record a rejected value and abort if too many values have been rejected
+  //
+  //! \param[in] hint  Part of the source definition the user should check
+  void reject(const char* hint) const;
+
+private:
+  mutable int64_t n_accept_ {0}; //!< Number of values accepted
+  mutable int64_t n_reject_ {0}; //!< Number of values rejected
+};
+
 namespace model {
 
 extern vector<unique_ptr<Source>> external_sources;
@@ -75,6 +97,19 @@ public:
   //! \return Sampled site
   virtual SourceSite sample(uint64_t* seed) const = 0;
 
+  //! Sample a source site at a given position
+  //
+  //! Used by sources whose position has already been sampled elsewhere, such
+  //! as those of mesh elements. By default a full site is sampled with
+  //! constraints and its position is replaced.
+  //! \param[in] r Position of the site
+  //! \param[inout] seed Pseudorandom seed pointer
+  //! \return Sampled site
+  virtual SourceSite sample_at(Position r, uint64_t* seed) const;
+
+  //! Prepare sampling once the geometry is known. By default nothing is done.
+  virtual void init_domains() {}
+
   static unique_ptr<Source> create(pugi::xml_node node);
 
 protected:
@@ -93,6 +128,13 @@ protected:
   bool satisfies_energy_constraints(double E) const;
   bool satisfies_time_constraints(double time) const;
 
+  //! Bounding box of the cells of the root universe that may contain sites
+  //! satisfying the domain and fissionable constraints
+  //
+  //! \return Bounding box, which is infinite when there are no such
+  //!   constraints or the cells cannot be bounded
+  BoundingBox domain_bounding_box() const;
+
   // Data members
   double strength_ {1.0};                  //!< Source strength
   std::unordered_set<int32_t> domain_ids_; //!< Domains to reject from
@@ -105,6 +147,7 @@ protected:
     false}; //!< Whether site must be in fissionable material
   RejectionStrategy rejection_strategy_ {
     RejectionStrategy::RESAMPLE}; //!< Procedure for rejecting
+  RejectionCounter rejections_;   //!< Sites accepted and rejected
 };
 
 //==============================================================================
@@ -124,6 +167,18 @@ public:
   //! \return Sampled site
   SourceSite sample(uint64_t* seed) const override;
 
+  //! Sample the angle, energy, and time of a site at a given position
+  //
+  //! Neither the spatial distribution nor the spatial constraints are used.
+  //! \param[in] r Position of the site
+  //! \param[inout] seed Pseudorandom seed pointer
+  //! \return Sampled site
+  SourceSite sample_at(Position r, uint64_t* seed) const override;
+
+  //! Sample positions of a box distribution from the part of the box that
+  //! overlaps the cells able to satisfy the domain constraints
+  void init_domains() override;
+
   // Properties
   ParticleType particle_type() const { return particle_; }
 
@@ -148,6 +203,8 @@ private:
   UPtrAngle angle_;                               //!< Angular distribution
   UPtrDist energy_;                               //!< Energy distribution
   UPtrDist time_;                                 //!< Time distribution
+  unique_ptr<SpatialBox> domain_space_; //!< Box restricted to the domains
+  RejectionCounter energy_rejections_;  //!< Energies accepted and rejected
 };
 
 //==============================================================================
@@ -160,6 +217,14 @@ public:
   explicit FileSource(pugi::xml_node node);
   explicit FileSource(const std::string& path);
 
+  //! Sample from source sites held by the caller without copying them
+  //
+  //! \param[in] sites  Source sites, which must remain valid while the source
+  //!   is used
+  //! \param[in] n  Number of source sites
+  //! \param[in] strength  Source strength
+  FileSource(const SourceSite* sites, size_t n, double strength);
+
   // Methods
   void load_sites_from_file(
     const std::string& path); //!< Load source sites from file
@@ -169,6 +234,9 @@ protected:
 
 private:
   vector<SourceSite> sites_; //!< Source sites from a file
+  const SourceSite* external_sites_ {nullptr}; //!< Sites held by the caller
+  size_t n_external_ {0}; //!< Number of sites held by the caller
+  bool partitioned_ {false}; //!< Read only the sites of this process?
 };
 
 //==============================================================================
@@ -238,12 +306,26 @@ private:
 //! Initialize source bank from file/distribution
 extern "C" void initialize_source();
 
+//! Let the external sources prepare their sampling for the geometry, which
+//! restricts box distributions to their domains when
+//! settings::source_domain_bounds is on
+void init_source_domains();
+
 //! Sample a site from all external source distributions in proportion to their
 //! source strength
 //! \param[inout] seed Pseudorandom seed pointer
 //! \return Sampled source site
 SourceSite sample_external_source(uint64_t* seed);
 
+//! Sample many sites from all external source distributions
+//
+//! The strengths of the source distributions are only summed once. Each site
+//! uses its own pseudorandom seed, so results do not depend on how the sites
+//! are divided among threads.
+//! \param[out] sites Sampled source sites
+//! \param[in] first_id Particle ID of the first site, used to seed each site
+void sample_external_sources(gsl::span<SourceSite> sites, int64_t first_id);
+
 void free_memory_source();
 
 } // namespace openmc
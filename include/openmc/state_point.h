@@ -2,6 +2,7 @@
 #define OPENMC_STATE_POINT_H
 
 #include <cstdint>
+#include <string>
 
 #include <gsl/gsl-lite.hpp>
 
@@ -16,6 +17,22 @@ namespace openmc {
 
 void load_state_point();
 
+//! Create the HDF5 compound datatype of a source site
+//! \return HDF5 identifier of the datatype, to be closed by the caller
+hid_t h5banktype();
+
+//! Write a state point file with the results as of the end of a batch
+//! \param[in] filename  Name of the file, or nullptr for the default name
+//! \param[in] write_source  Whether to include the source bank, or nullptr to
+//!   include it
+//! \param[in] batch  Batch whose results are written
+//! \return Error code
+int write_state_point(const char* filename, bool* write_source, int batch);
+
+//! Wait for a state point file that is written in the background to be
+//! complete. Does nothing if none is being written.
+void finish_statepoint_write();
+
 // By passing in a filename, source bank, and list of source indices
 // on each MPI rank, this writes an HDF5 file which contains that
 // information which can later be read in by read_source_bank
@@ -41,11 +58,23 @@ void write_source_point(const char* filename, gsl::span<SourceSite> source_bank,
 void write_source_bank(hid_t group_id, gsl::span<SourceSite> source_bank,
   const vector<int64_t>& bank_index);
 
+// This writes the source sites of each process to its own file named after
+// the given file, without any communication between processes, and an index
+// of those files to the group on the master process. read_source_bank reads
+// the sites back from the files listed in the index.
+void write_source_shards(hid_t group_id, const std::string& filename,
+  gsl::span<SourceSite> source_bank, const vector<int64_t>& bank_index);
+
 void read_source_bank(
   hid_t group_id, vector<SourceSite>& sites, bool distribute);
+
+// This reads the part of a source bank that belongs to this process. The
+// sites are divided into contiguous parts of nearly equal size, one for each
+// process, and only that part is held in memory.
+void read_source_bank_partition(hid_t group_id, vector<SourceSite>& sites);
 void write_tally_results_nr(hid_t file_id);
 void restart_set_keff();
-void write_unstructured_mesh_results();
+void write_unstructured_mesh_results(int batch);
 
 } // namespace openmc
 #endif // OPENMC_STATE_POINT_H
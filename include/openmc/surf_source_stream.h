@@ -0,0 +1,31 @@
+#ifndef OPENMC_SURF_SOURCE_STREAM_H
+#define OPENMC_SURF_SOURCE_STREAM_H
+
+#include "openmc/particle_data.h"
+
+namespace openmc {
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Create the surface source file and allocate a buffer of sites for each
+//! thread. Sites added to a buffer are appended to the file whenever the
+//! buffer is full, so the number of sites is not limited by memory.
+void open_surf_source_stream();
+
+//! Add a site to the buffer of the calling thread, appending the buffer to the
+//! surface source file if it is full
+//
+//! \param[in] site  Site of a particle crossing a surface
+//! \return Whether the site was added, which it is not once the maximum
+//!   number of particles for this process has been reached
+bool add_surf_source_to_stream(const SourceSite& site);
+
+//! Append the sites left in all buffers and close the surface source file.
+//! Does nothing if the file is not open.
+void close_surf_source_stream();
+
+} // namespace openmc
+
+#endif // OPENMC_SURF_SOURCE_STREAM_H
@@ -1,6 +1,7 @@
 #ifndef OPENMC_SURFACE_H
 #define OPENMC_SURFACE_H
 
+#include <cmath>  // for abs, sqrt
 #include <limits> // For numeric_limits
 #include <string>
 #include <unordered_map>
@@ -8,6 +9,7 @@
 #include "hdf5.h"
 #include "pugixml.hpp"
 
+#include "openmc/array.h"
 #include "openmc/boundary_condition.h"
 #include "openmc/bounding_box.h"
 #include "openmc/constants.h"
@@ -372,12 +374,305 @@ public:
   double x0_, y0_, z0_, A_, B_, C_;
 };
 
+//==============================================================================
+// Kernels shared by the surface classes and the packed surface table
+//==============================================================================
+
+// The template parameter indicates the axis normal to the plane.
+template<int i>
+inline double axis_aligned_plane_distance(
+  Position r, Direction u, bool coincident, double offset)
+{
+  const double f = offset - r[i];
+  if (coincident || std::abs(f) < FP_COINCIDENT || u[i] == 0.0)
+    return INFTY;
+  const double d = f / u[i];
+  if (d < 0.0)
+    return INFTY;
+  return d;
+}
+
+inline double plane_distance(Position r, Direction u, bool coincident,
+  double A, double B, double C, double D)
+{
+  const double f = A * r.x + B * r.y + C * r.z - D;
+  const double projection = A * u.x + B * u.y + C * u.z;
+  if (coincident || std::abs(f) < FP_COINCIDENT || projection == 0.0) {
+    return INFTY;
+  } else {
+    const double d = -f / projection;
+    if (d < 0.0)
+      return INFTY;
+    return d;
+  }
+}
+
+// The template parameters indicate the axes perpendicular to the axis of the
+// cylinder.  offset1 and offset2 should correspond with i1 and i2,
+// respectively.
+template<int i1, int i2>
+inline double axis_aligned_cylinder_evaluate(
+  Position r, double offset1, double offset2, double radius)
+{
+  const double r1 = r.get<i1>() - offset1;
+  const double r2 = r.get<i2>() - offset2;
+  return r1 * r1 + r2 * r2 - radius * radius;
+}
+
+// The first template parameter indicates which axis the cylinder is aligned to.
+// The other two parameters indicate the other two axes.  offset1 and offset2
+// should correspond with i2 and i3, respectively.
+template<int i1, int i2, int i3>
+inline double axis_aligned_cylinder_distance(Position r, Direction u,
+  bool coincident, double offset1, double offset2, double radius)
+{
+  const double a = 1.0 - u.get<i1>() * u.get<i1>(); // u^2 + v^2
+  if (a == 0.0)
+    return INFTY;
+
+  const double r2 = r.get<i2>() - offset1;
+  const double r3 = r.get<i3>() - offset2;
+  const double k = r2 * u.get<i2>() + r3 * u.get<i3>();
+  const double c = r2 * r2 + r3 * r3 - radius * radius;
+  const double quad = k * k - a * c;
+
+  if (quad < 0.0) {
+    // No intersection with cylinder.
+    return INFTY;
+
+  } else if (coincident || std::abs(c) < FP_COINCIDENT) {
+    // Particle is on the cylinder, thus one distance is positive/negative
+    // and the other is zero. The sign of k determines if we are facing in or
+    // out.
+    if (k >= 0.0) {
+      return INFTY;
+    } else {
+      return (-k + std::sqrt(quad)) / a;
+    }
+
+  } else if (c < 0.0) {
+    // Particle is inside the cylinder, thus one distance must be negative
+    // and one must be positive. The positive distance will be the one with
+    // negative sign on sqrt(quad).
+    return (-k + std::sqrt(quad)) / a;
+
+  } else {
+    // Particle is outside the cylinder, thus both distances are either
+    // positive or negative. If positive, the smaller distance is the one
+    // with positive sign on sqrt(quad).
+    const double d = (-k - std::sqrt(quad)) / a;
+    if (d < 0.0)
+      return INFTY;
+    return d;
+  }
+}
+
+// The first template parameter indicates which axis the cylinder is aligned to.
+// The other two parameters indicate the other two axes.  offset1 and offset2
+// should correspond with i2 and i3, respectively.
+template<int i1, int i2, int i3>
+inline Direction axis_aligned_cylinder_normal(
+  Position r, double offset1, double offset2)
+{
+  Direction u;
+  u.get<i2>() = 2.0 * (r.get<i2>() - offset1);
+  u.get<i3>() = 2.0 * (r.get<i3>() - offset2);
+  u.get<i1>() = 0.0;
+  return u;
+}
+
+inline double sphere_evaluate(
+  Position r, double x0, double y0, double z0, double radius)
+{
+  const double x = r.x - x0;
+  const double y = r.y - y0;
+  const double z = r.z - z0;
+  return x * x + y * y + z * z - radius * radius;
+}
+
+inline double sphere_distance(Position r, Direction u, bool coincident,
+  double x0, double y0, double z0, double radius)
+{
+  const double x = r.x - x0;
+  const double y = r.y - y0;
+  const double z = r.z - z0;
+  const double k = x * u.x + y * u.y + z * u.z;
+  const double c = x * x + y * y + z * z - radius * radius;
+  const double quad = k * k - c;
+
+  if (quad < 0.0) {
+    // No intersection with sphere.
+    return INFTY;
+
+  } else if (coincident || std::abs(c) < FP_COINCIDENT) {
+    // Particle is on the sphere, thus one distance is positive/negative and
+    // the other is zero. The sign of k determines if we are facing in or out.
+    if (k >= 0.0) {
+      return INFTY;
+    } else {
+      return -k + std::sqrt(quad);
+    }
+
+  } else if (c < 0.0) {
+    // Particle is inside the sphere, thus one distance must be negative and
+    // one must be positive. The positive distance will be the one with
+    // negative sign on sqrt(quad)
+    return -k + std::sqrt(quad);
+
+  } else {
+    // Particle is outside the sphere, thus both distances are either positive
+    // or negative. If positive, the smaller distance is the one with positive
+    // sign on sqrt(quad).
+    const double d = -k - std::sqrt(quad);
+    if (d < 0.0)
+      return INFTY;
+    return d;
+  }
+}
+
+inline Direction sphere_normal(Position r, double x0, double y0, double z0)
+{
+  return {2.0 * (r.x - x0), 2.0 * (r.y - y0), 2.0 * (r.z - z0)};
+}
+
+//==============================================================================
+//! Surface types that are stored by value in the packed surface table
+//==============================================================================
+
+enum class SurfaceKind {
+  X_PLANE,
+  Y_PLANE,
+  Z_PLANE,
+  PLANE,
+  X_CYLINDER,
+  Y_CYLINDER,
+  Z_CYLINDER,
+  SPHERE,
+  OTHER //!< Any other surface, which is evaluated through model::surfaces
+};
+
+//==============================================================================
+//! The type and coefficients of a surface, stored contiguously with those of
+//! all other surfaces so that regions can evaluate their half-spaces without
+//! virtual calls or following pointers to each surface.
+//
+//! Coefficients are stored in the order in which they are read from the
+//! "coeffs" attribute of the surface.
+//==============================================================================
+
+struct PackedSurface {
+  SurfaceKind kind {SurfaceKind::OTHER};
+  array<double, 4> c {};
+
+  double evaluate(Position r) const
+  {
+    switch (kind) {
+    case SurfaceKind::X_PLANE:
+      return r.x - c[0];
+    case SurfaceKind::Y_PLANE:
+      return r.y - c[0];
+    case SurfaceKind::Z_PLANE:
+      return r.z - c[0];
+    case SurfaceKind::PLANE:
+      return c[0] * r.x + c[1] * r.y + c[2] * r.z - c[3];
+    case SurfaceKind::X_CYLINDER:
+      return axis_aligned_cylinder_evaluate<1, 2>(r, c[0], c[1], c[2]);
+    case SurfaceKind::Y_CYLINDER:
+      return axis_aligned_cylinder_evaluate<0, 2>(r, c[0], c[1], c[2]);
+    case SurfaceKind::Z_CYLINDER:
+      return axis_aligned_cylinder_evaluate<0, 1>(r, c[0], c[1], c[2]);
+    default:
+      return sphere_evaluate(r, c[0], c[1], c[2], c[3]);
+    }
+  }
+
+  double distance(Position r, Direction u, bool coincident) const
+  {
+    switch (kind) {
+    case SurfaceKind::X_PLANE:
+      return axis_aligned_plane_distance<0>(r, u, coincident, c[0]);
+    case SurfaceKind::Y_PLANE:
+      return axis_aligned_plane_distance<1>(r, u, coincident, c[0]);
+    case SurfaceKind::Z_PLANE:
+      return axis_aligned_plane_distance<2>(r, u, coincident, c[0]);
+    case SurfaceKind::PLANE:
+      return plane_distance(r, u, coincident, c[0], c[1], c[2], c[3]);
+    case SurfaceKind::X_CYLINDER:
+      return axis_aligned_cylinder_distance<0, 1, 2>(
+        r, u, coincident, c[0], c[1], c[2]);
+    case SurfaceKind::Y_CYLINDER:
+      return axis_aligned_cylinder_distance<1, 0, 2>(
+        r, u, coincident, c[0], c[1], c[2]);
+    case SurfaceKind::Z_CYLINDER:
+      return axis_aligned_cylinder_distance<2, 0, 1>(
+        r, u, coincident, c[0], c[1], c[2]);
+    default:
+      return sphere_distance(r, u, coincident, c[0], c[1], c[2], c[3]);
+    }
+  }
+
+  Direction normal(Position r) const
+  {
+    switch (kind) {
+    case SurfaceKind::X_PLANE:
+      return {1., 0., 0.};
+    case SurfaceKind::Y_PLANE:
+      return {0., 1., 0.};
+    case SurfaceKind::Z_PLANE:
+      return {0., 0., 1.};
+    case SurfaceKind::PLANE:
+      return {c[0], c[1], c[2]};
+    case SurfaceKind::X_CYLINDER:
+      return axis_aligned_cylinder_normal<0, 1, 2>(r, c[0], c[1]);
+    case SurfaceKind::Y_CYLINDER:
+      return axis_aligned_cylinder_normal<1, 0, 2>(r, c[0], c[1]);
+    case SurfaceKind::Z_CYLINDER:
+      return axis_aligned_cylinder_normal<2, 0, 1>(r, c[0], c[1]);
+    default:
+      return sphere_normal(r, c[0], c[1], c[2]);
+    }
+  }
+};
+
+namespace model {
+extern vector<PackedSurface> packed_surfaces;
+} // namespace model
+
+//! Determine which side of a surface a point lies on, as Surface::sense does
+//! \param i_surf Index of the surface in model::surfaces
+inline bool surface_sense(int i_surf, Position r, Direction u)
+{
+  const auto& surf = model::packed_surfaces[i_surf];
+  if (surf.kind == SurfaceKind::OTHER)
+    return model::surfaces[i_surf]->sense(r, u);
+
+  const double f = surf.evaluate(r);
+  if (std::abs(f) < FP_COINCIDENT)
+    return u.dot(surf.normal(r)) > 0.0;
+  return f > 0.0;
+}
+
+//! Compute the distance to a surface along a ray, as Surface::distance does
+//! \param i_surf Index of the surface in model::surfaces
+inline double surface_distance(
+  int i_surf, Position r, Direction u, bool coincident)
+{
+  const auto& surf = model::packed_surfaces[i_surf];
+  if (surf.kind == SurfaceKind::OTHER)
+    return model::surfaces[i_surf]->distance(r, u, coincident);
+  return surf.distance(r, u, coincident);
+}
+
 //==============================================================================
 // Non-member functions
 //==============================================================================
 
 void read_surfaces(pugi::xml_node node);
 
+//! Fill model::packed_surfaces from model::surfaces. Surfaces added later, such
+//! as those of DAGMC universes, are never referenced by CSG regions.
+void pack_surfaces();
+
 void free_memory_surfaces();
 
 } // namespace openmc
@@ -35,6 +35,10 @@ struct TallyDerivative {
 //! Read tally derivatives from a tallies.xml file
 void read_tally_derivatives(pugi::xml_node node);
 
+//! Group the derivatives by the material they are applied to, so that only
+//! the derivatives of the particle's material are updated at each event
+void init_material_derivs();
+
 //! Scale the given score by its logarithmic derivative
 
 void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
@@ -67,6 +71,8 @@ namespace openmc {
 namespace model {
 extern std::unordered_map<int, int> tally_deriv_map;
 extern vector<TallyDerivative> tally_derivs;
+extern vector<vector<int>>
+  material_derivs; //!< Indices of the derivatives of each material
 } // namespace model
 
 } // namespace openmc
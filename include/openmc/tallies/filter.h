@@ -27,6 +27,7 @@ enum class FilterType {
   DELAYED_GROUP,
   DISTRIBCELL,
   ENERGY_FUNCTION,
+  ENERGY_RESPONSE,
   ENERGY,
   ENERGY_OUT,
   LEGENDRE,
@@ -1,8 +1,11 @@
 #ifndef OPENMC_TALLIES_FILTER_ENERGY_H
 #define OPENMC_TALLIES_FILTER_ENERGY_H
 
+#include <memory> // for shared_ptr
+
 #include <gsl/gsl-lite.hpp>
 
+#include "openmc/search.h"
 #include "openmc/tallies/filter.h"
 #include "openmc/vector.h"
 
@@ -42,6 +45,12 @@ public:
 
   bool matches_transport_groups() const { return matches_transport_groups_; }
 
+  //! Find the bin containing an energy between the first and last bin edges
+  //
+  //! \param[in] E  Energy in [eV]
+  //! \return The same bin as given by lower_bound_index over the bin edges
+  int find_bin(double E) const;
+
 protected:
   //----------------------------------------------------------------------------
   // Data members
@@ -50,6 +59,13 @@ protected:
 
   //! True if transport group number can be used directly to get bin number
   bool matches_transport_groups_ {false};
+
+  //! Guide table over the logarithm of the bin edges normalized to [0,1],
+  //! shared by all filters with the same bins. Filters with few bins, or
+  //! whose second edge is not positive, use a binary search instead.
+  std::shared_ptr<const GuideTable> log_guide_;
+  double log_lower_ {0.0};     //!< logarithm of the lowest positive edge
+  double inv_log_width_ {0.0};   //!< inverse of the logarithmic bin range
 };
 
 //==============================================================================
@@ -0,0 +1,75 @@
+#ifndef OPENMC_TALLIES_FILTER_ENERGYRESPONSE_H
+#define OPENMC_TALLIES_FILTER_ENERGYRESPONSE_H
+
+#include <gsl/gsl-lite.hpp>
+
+#include "openmc/constants.h"
+#include "openmc/tallies/filter.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Folds tally scores with a set of response functions of incident energy.
+//!
+//! Each bin multiplies scores by one response, so many responses are scored
+//! in one pass while storing one value per response rather than per energy
+//! group. The responses are either multigroup values over a common group
+//! structure or pointwise values linearly interpolated on a common energy grid.
+//==============================================================================
+
+class EnergyResponseFilter : public Filter {
+public:
+  //----------------------------------------------------------------------------
+  // Constructors, destructors
+
+  ~EnergyResponseFilter() = default;
+
+  //----------------------------------------------------------------------------
+  // Methods
+
+  std::string type_str() const override { return "energyresponse"; }
+  FilterType type() const override { return FilterType::ENERGY_RESPONSE; }
+
+  void from_xml(pugi::xml_node node) override;
+
+  void get_all_bins(const Particle& p, TallyEstimator estimator,
+    FilterMatch& match) const override;
+
+  void to_statepoint(hid_t filter_group) const override;
+
+  std::string text_label(int bin) const override;
+
+  //----------------------------------------------------------------------------
+  // Accessors
+
+  const vector<double>& energy() const { return energy_; }
+  Interpolation interpolation() const { return interpolation_; }
+
+  //! Set the energy grid and response values
+  //
+  //! \param[in] energy Group boundaries for histogram interpolation or grid
+  //!   energies for linear-linear interpolation in [eV]
+  //! \param[in] responses Values of each response in each group or at each
+  //!   grid energy, ordered by response
+  //! \param[in] interpolation Interpolation of the responses in energy
+  void set_data(gsl::span<const double> energy,
+    gsl::span<const double> responses, Interpolation interpolation);
+
+private:
+  //----------------------------------------------------------------------------
+  // Data members
+
+  //! Group boundaries or grid energies in [eV]
+  vector<double> energy_;
+
+  //! Response values ordered by group or grid energy, then by response, so the
+  //! values scored at one energy are contiguous
+  vector<double> values_;
+
+  //! Interpolation scheme, either histogram or linear-linear
+  Interpolation interpolation_ {Interpolation::histogram};
+};
+
+} // namespace openmc
+#endif // OPENMC_TALLIES_FILTER_ENERGYRESPONSE_H
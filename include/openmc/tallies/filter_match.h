@@ -9,11 +9,51 @@ namespace openmc {
 
 class FilterMatch {
 public:
+  //! Append bins 0 to n - 1, whose weights are then written by the caller
+  //
+  //! \param n  Number of bins
+  //! \return Pointer to the weights of the appended bins
+  double* append_bins(int n)
+  {
+    int first = bins_.size();
+    bins_.resize(first + n);
+    for (int i = 0; i < n; ++i) {
+      bins_[first + i] = i;
+    }
+    weights_.resize(first + n);
+    return weights_.data() + first;
+  }
+
   vector<int> bins_;
   vector<double> weights_;
   int i_bin_;
   bool bins_present_ {false};
 };
 
+//==============================================================================
+//! Stores the filter bin combinations found for an event by one of a group of
+//! tallies that have identical filters.
+//==============================================================================
+
+class FilterBinCache {
+public:
+  vector<int> indices_;
+  vector<double> weights_;
+  bool present_ {false};
+};
+
+//==============================================================================
+//! Stores the bins of a mesh crossed by a track along with the fractions of
+//! the track before and within each, from which the combinations with the bins
+//! of a time filter are found.
+//==============================================================================
+
+class MeshSegments {
+public:
+  vector<int> bins_;
+  vector<double> starts_;
+  vector<double> lengths_;
+};
+
 } // namespace openmc
 #endif // OPENMC_TALLIES_FILTERMATCH_H
@@ -0,0 +1,123 @@
+#ifndef OPENMC_TALLIES_REACTION_RATES_H
+#define OPENMC_TALLIES_REACTION_RATES_H
+
+#include <cstdint>
+
+#include "xtensor/xtensor.hpp"
+
+#include "openmc/particle.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Accumulates microscopic reaction rates of selected nuclides in selected
+//! materials, which is what a depletion step needs. Rates are accumulated in a
+//! compact (material, nuclide, reaction) array straight from the cross
+//! sections computed for transport, bypassing the general tally machinery.
+//!
+//! When energy group boundaries are given, only the group-wise flux in each
+//! material is accumulated during transport and reaction rates are found by
+//! collapsing cross sections with that flux.
+//==============================================================================
+
+class ReactionRates {
+public:
+  //----------------------------------------------------------------------------
+  // Methods
+
+  //! Select what to accumulate and allocate the results
+  //
+  //! \param[in] materials  Indices of the materials in model::materials
+  //! \param[in] nuclides  Indices of the nuclides in data::nuclides
+  //! \param[in] reactions  ENDF MT values of the reactions
+  //! \param[in] energies  Energy group boundaries in [eV] for flux collapse.
+  //!   If empty, rates are accumulated directly, which is only possible for
+  //!   fission and the reactions in DEPLETION_RX.
+  void set(vector<int32_t> materials, vector<int> nuclides,
+    vector<int> reactions, vector<double> energies);
+
+  //! Remove all materials, nuclides, and reactions
+  void clear();
+
+  //! Zero all accumulated results
+  void reset();
+
+  //! Whether anything is being accumulated
+  bool configured() const { return !materials_.empty(); }
+
+  //! Whether rates are found by flux collapse rather than accumulated
+  bool collapse() const { return !energies_.empty(); }
+
+  //! Score the track-length estimate of the flux and reaction rates
+  //
+  //! \param[in] p  Particle that has just moved
+  //! \param[in] distance  Distance the particle moved in [cm]
+  void score_tracklength(Particle& p, double distance);
+
+  //! Combine values from all processes, normalize them, and add them to the
+  //! accumulated sums
+  //
+  //! \param[in] norm  Normalization applied to the values of this batch
+  void accumulate(double norm);
+
+  //! Mean reaction rate of each (material, nuclide, reaction) per source
+  //! particle, with the flux in [particle-cm] and without atom densities
+  //
+  //! \param[out] rates  Array of size n_materials * n_nuclides * n_reactions
+  void rates(double* rates) const;
+
+  //! Mean flux in each (material, energy group) per source particle
+  //
+  //! \param[out] flux  Array of size n_materials * n_groups
+  void flux(double* flux) const;
+
+  int n_materials() const { return materials_.size(); }
+  int n_nuclides() const { return nuclides_.size(); }
+  int n_reactions() const { return reactions_.size(); }
+  int n_groups() const { return collapse() ? energies_.size() - 1 : 1; }
+  int n_realizations() const { return n_realizations_; }
+
+  //----------------------------------------------------------------------------
+  // Data members
+
+  bool active_ {false}; //!< Whether results are being accumulated
+
+private:
+  vector<int32_t> materials_; //!< Indices in model::materials
+  vector<int> nuclides_;      //!< Indices in data::nuclides
+  vector<int> reactions_;     //!< ENDF MT values
+  vector<double> energies_;   //!< Group boundaries for flux collapse in [eV]
+
+  //! Position in materials_ of each material in the model, or C_NONE
+  vector<int> material_index_;
+
+  //! Position in nuclides_ of each nuclide in the problem, or C_NONE
+  vector<int> nuclide_index_;
+
+  //! Position of each reaction in NuclideMicroXS::reaction, or C_NONE for
+  //! fission
+  vector<int> rx_index_;
+
+  //! Values of the current batch and accumulated sums
+  xt::xtensor<double, 3> rate_values_;
+  xt::xtensor<double, 3> rate_sum_;
+  xt::xtensor<double, 2> flux_values_;
+  xt::xtensor<double, 2> flux_sum_;
+
+  int n_realizations_ {0};
+};
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+extern ReactionRates reaction_rates;
+
+} // namespace simulation
+
+} // namespace openmc
+
+#endif // OPENMC_TALLIES_REACTION_RATES_H
@@ -0,0 +1,127 @@
+#ifndef OPENMC_TALLIES_SPARSE_RESULTS_H
+#define OPENMC_TALLIES_SPARSE_RESULTS_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "xtensor/xtensor.hpp"
+
+#include "openmc/constants.h"
+#include "openmc/memory.h" // for unique_ptr
+#include "openmc/openmp_interface.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Tally results stored in tiles of consecutive filter bins. A tile is only
+//! allocated the first time one of its bins is scored, so tallies where most
+//! bins never see a particle use a fraction of the memory of a dense array.
+//!
+//! Each tile holds TILE_BINS filter bins laid out exactly like the
+//! corresponding rows of a dense (filter bin, score, result) array.
+//==============================================================================
+
+class SparseResults {
+public:
+  //! Number of filter bins in each tile
+  static constexpr int TILE_BINS {64};
+
+  //----------------------------------------------------------------------------
+  // Constructors, destructors
+  SparseResults() = default;
+  ~SparseResults();
+  SparseResults(const SparseResults&) = delete;
+  SparseResults& operator=(const SparseResults&) = delete;
+
+  //----------------------------------------------------------------------------
+  // Methods
+
+  //! Set the dimensions of the results and free any allocated tiles
+  //
+  //! \param[in] n_filter_bins  Number of filter bin combinations
+  //! \param[in] n_scores  Number of nuclide/score combinations
+  void init(int32_t n_filter_bins, int n_scores);
+
+  //! Add to the value of a bin for the current realization, allocating its
+  //! tile if needed. This is safe to call from multiple threads.
+  void add(int filter_index, int score_index, double value)
+  {
+    int64_t t = filter_index / TILE_BINS;
+    double* tile = tiles_[t].load(std::memory_order_acquire);
+    if (!tile)
+      tile = this->allocate_tile(t);
+    int64_t i = index(filter_index % TILE_BINS, score_index, TallyResult::VALUE);
+#pragma omp atomic
+    tile[i] += value;
+  }
+
+  //! Get a result for a bin, which is zero if its tile was never allocated
+  double get(int filter_index, int score_index, TallyResult k) const;
+
+  //! Zero all allocated tiles
+  void reset();
+
+  //! Add the normalized values of the current realization to the sum and sum
+  //! of squares and reset the values
+  //
+  //! \param[in] norm  Normalization applied to each value
+  void accumulate(double norm);
+
+  //! Copy all results into a dense array
+  //
+  //! \param[out] dense  Array of shape (n_filter_bins, n_scores, 3)
+  void to_dense(xt::xtensor<double, 3>& dense) const;
+
+  //! Replace all results with those from a dense array. Only tiles containing
+  //! nonzero results are allocated.
+  //
+  //! \param[in] dense  Array of shape (n_filter_bins, n_scores, 3)
+  void from_dense(const xt::xtensor<double, 3>& dense);
+
+  //! Number of tiles currently allocated
+  int64_t n_allocated() const;
+
+  //! Memory used by allocated tiles in [MB]
+  double memory() const;
+
+#ifdef OPENMC_MPI
+  //! Sum values of the current realization onto the master process and reset
+  //! them on the other processes
+  void reduce();
+
+  //! Send all results from the master process to the other processes
+  void broadcast();
+#endif
+
+private:
+  //! Allocate a zeroed tile unless another thread already has
+  double* allocate_tile(int64_t t);
+
+#ifdef OPENMC_MPI
+  //! Allocate every tile that is allocated on any process
+  void allocate_union();
+#endif
+
+  //! Index within a tile of a bin's result
+  int64_t index(int bin, int score_index, TallyResult k) const
+  {
+    return (static_cast<int64_t>(bin) * n_scores_ + score_index) * 3 +
+           static_cast<int>(k);
+  }
+
+  //! Number of values stored in each tile
+  int64_t tile_length() const
+  {
+    return static_cast<int64_t>(TILE_BINS) * n_scores_ * 3;
+  }
+
+  int32_t n_filter_bins_ {0};
+  int n_scores_ {0};
+  int64_t n_tiles_ {0};
+  unique_ptr<std::atomic<double*>[]> tiles_;
+  OpenMPMutex mutex_;
+};
+
+} // namespace openmc
+
+#endif // OPENMC_TALLIES_SPARSE_RESULTS_H
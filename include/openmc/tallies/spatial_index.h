@@ -0,0 +1,76 @@
+#ifndef OPENMC_TALLIES_SPATIAL_INDEX_H
+#define OPENMC_TALLIES_SPATIAL_INDEX_H
+
+#include <cstdint>
+#include <utility> // for pair
+
+#include "openmc/bounding_box.h"
+#include "openmc/particle.h"
+#include "openmc/tallies/tally.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Maps the spatial domain of an event to the tallies that can score it.
+//!
+//! Tallies with a cell filter are indexed by the cells in the filter and
+//! tallies with a material filter by the materials in the filter. Tallies
+//! with a mesh filter are indexed by the bounding box of the mesh. Any other
+//! tally may score anywhere and is always a candidate.
+//==============================================================================
+
+class TallySpatialIndex {
+public:
+  //----------------------------------------------------------------------------
+  // Methods
+
+  //! Build the index over a set of tallies
+  //
+  //! \param[in] tallies  Indices of the tallies in model::tallies in the order
+  //!   in which they are scored
+  //! \param[in] estimator  Estimator of the events the tallies score
+  void build(const vector<int>& tallies, TallyEstimator estimator);
+
+  //! Remove all tallies from the index
+  void clear();
+
+  //! Whether any tally can be skipped based on its spatial domain
+  bool enabled() const { return enabled_; }
+
+  //! Find the tallies whose spatial domain may contain an event
+  //
+  //! \param[in] p  Particle at the event
+  //! \param[out] tallies  Indices of the candidate tallies, in the order in
+  //!   which they were given when building the index
+  void candidates(const Particle& p, vector<int>& tallies) const;
+
+private:
+  //----------------------------------------------------------------------------
+  // Data members
+
+  bool enabled_ {false};
+  bool tracklength_ {false}; //!< Whether events are track segments
+
+  vector<int> unindexed_;           //!< Tallies that may score anywhere
+  vector<vector<int>> by_cell_;     //!< Tallies for each cell
+  vector<vector<int>> by_material_; //!< Tallies for each material
+
+  //! Tallies with a mesh filter and the bounding box of the mesh
+  vector<std::pair<int, BoundingBox>> by_mesh_;
+};
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace model {
+
+extern TallySpatialIndex tracklength_tally_index;
+extern TallySpatialIndex collision_tally_index;
+
+} // namespace model
+
+} // namespace openmc
+
+#endif // OPENMC_TALLIES_SPATIAL_INDEX_H
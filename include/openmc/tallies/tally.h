@@ -3,7 +3,9 @@
 
 #include "openmc/constants.h"
 #include "openmc/memory.h" // for unique_ptr
+#include "openmc/openmp_interface.h"
 #include "openmc/tallies/filter.h"
+#include "openmc/tallies/sparse_results.h"
 #include "openmc/tallies/trigger.h"
 #include "openmc/vector.h"
 
@@ -12,11 +14,27 @@
 #include "xtensor/xtensor.hpp"
 #include <gsl/gsl-lite.hpp>
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <utility> // for pair
 
 namespace openmc {
 
+//==============================================================================
+//! Figure of merit 1/(R^2 T) of a tally at the end of a batch, where R is the
+//! largest relative error over the scored bins of the tally and T is the
+//! transport time while the tally was active
+//==============================================================================
+
+struct FigureOfMerit {
+  int batch;             //!< Batch at whose end the figure was computed
+  double time;           //!< Transport time while the tally was active [s]
+  double max_rel_err;    //!< Largest relative error over scored bins
+  double median_rel_err; //!< Median relative error over scored bins
+  double value;          //!< Figure of merit [1/s]
+};
+
 //==============================================================================
 //! A user-specified flux-weighted (or current) measurement.
 //==============================================================================
@@ -41,6 +59,14 @@ public:
 
   void set_multiply_density(bool value) { multiply_density_ = value; }
 
+  void set_thread_private(bool value) { thread_private_ = value; }
+
+  void set_sparse_storage(bool value) { sparse_storage_ = value; }
+
+  void set_partitioned(bool value) { partitioned_ = value; }
+
+  void set_single_precision(bool value) { single_precision_ = value; }
+
   void set_writable(bool writable) { writable_ = writable; }
 
   void set_scores(pugi::xml_node node);
@@ -104,6 +130,14 @@ public:
 
   bool multiply_density() const { return multiply_density_; }
 
+  bool thread_private() const { return thread_private_; }
+
+  bool sparse_storage() const { return sparse_storage_; }
+
+  bool partitioned() const { return partitioned_; }
+
+  bool single_precision() const { return single_precision_; }
+
   bool writable() const { return writable_; }
 
   //----------------------------------------------------------------------------
@@ -119,6 +153,102 @@ public:
 
   void accumulate();
 
+  //! Accumulate a realization whose values were reduced separately from
+  //! results_
+  //
+  //! \param values  Values of each (filter bin, nuclide/score) combination,
+  //!   only used on the master process
+  //! \param norm  Normalization applied to each value
+  void accumulate(const double* values, double norm);
+
+  //! Add a score to the value of a bin for the current realization. With
+  //! thread-private results, the score goes to the calling thread's own copy
+  //! and no atomic update is needed.
+  //
+  //! \param filter_index  Index of the filter bin combination
+  //! \param score_index  Index of the nuclide/score combination
+  //! \param value  Contribution to add
+  void add_result(int filter_index, int score_index, double value)
+  {
+    if (sparse_storage_) {
+      sparse_results_.add(filter_index, score_index, value);
+      return;
+    }
+    if (partitioned_) {
+      // Scores to bins owned by another process are sent to it at the end of
+      // the batch
+      int64_t i = filter_index - bin_begin_;
+      if (i < 0 || i >= results_.shape()[0]) {
+        int64_t index =
+          static_cast<int64_t>(filter_index) * results_.shape()[1] +
+          score_index;
+        remote_scores_[thread_num()].push_back({index, value});
+        return;
+      }
+      filter_index = i;
+    }
+    if (!thread_results_.empty()) {
+      int64_t i =
+        static_cast<int64_t>(filter_index) * results_.shape()[1] + score_index;
+      thread_results_[thread_num()][i] += value;
+      return;
+    }
+    if (!single_values_.empty()) {
+      int64_t i =
+        static_cast<int64_t>(filter_index) * results_.shape()[1] + score_index;
+      float v = value;
+#pragma omp atomic
+      single_values_[i] += v;
+      return;
+    }
+#pragma omp atomic
+    results_(filter_index, score_index, TallyResult::VALUE) += value;
+  }
+
+  //! Add thread-private and single-precision values into results_ and reset
+  //! them
+  void reduce_thread_results();
+
+  //! Compute the figure of merit from the accumulated results and add it to
+  //! the history
+  //
+  //! \param time  Transport time of the batch that was just accumulated [s]
+  void record_figure_of_merit(double time);
+
+  //! Get a result for a bin regardless of how the results are stored
+  double result(int filter_index, int score_index, TallyResult k) const
+  {
+    if (sparse_storage_)
+      return sparse_results_.get(filter_index, score_index, k);
+    return results_(filter_index, score_index, k);
+  }
+
+  //! Fill results_ from sparse storage so that it can be read directly. This
+  //! does nothing for tallies with dense storage.
+  void materialize_results();
+
+  //! Free the dense copy made by materialize_results()
+  void release_results();
+
+  //! Replace sparse results with the contents of results_ and free it
+  void store_results();
+
+  //! Memory used by the results and the buffers that accumulate them in [MB]
+  double memory() const;
+
+#ifdef OPENMC_MPI
+  //! Send scores of the current realization to the processes owning their
+  //! bins and add the scores received from other processes
+  void exchange_remote_scores();
+
+  //! Collect the results of all processes in results_ on the master process
+  void gather_results();
+
+  //! Send the results of each process from the master process and keep only
+  //! the bins owned by this process
+  void scatter_results();
+#endif
+
   //! return the index of a score specified by name
   int score_index(const std::string& score) const;
 
@@ -160,6 +290,14 @@ public:
   //! reaction rate, fission reaction rate, etc.)
   xt::xtensor<double, 3> results_;
 
+  //! Results stored in tiles that are allocated on first use. When sparse
+  //! storage is on, results_ is only allocated while it is being read.
+  SparseResults sparse_results_;
+
+  //! Whether each filter bin changed since the last state point. Changes are
+  //! only tracked for delta state points while this is not empty.
+  vector<uint8_t> changed_rows_;
+
   //! True if this tally should be written to statepoint files
   bool writable_ {true};
 
@@ -174,8 +312,44 @@ public:
   int delayedgroup_filter_ {C_NONE};
   int cell_filter_ {C_NONE};
 
+  //! Index of the group of tallies whose filter bin combinations are shared
+  //! because their filters are identical, or C_NONE if not shared
+  int filter_group_ {C_NONE};
+
+  //! Index among the filters of an expansion filter whose bins are all scored
+  //! from one evaluation of each score, or C_NONE if there is none
+  int expansion_filter_ {C_NONE};
+
+  //! Index among the filters of a mesh surface filter on a regular mesh whose
+  //! crossings are added straight to the face bins, or C_NONE if there is none
+  int current_filter_ {C_NONE};
+
+  //! Indices among the filters of a time filter and a mesh filter on a
+  //! structured mesh whose bins are found together in one pass along each
+  //! track, or C_NONE if there are none
+  int time_filter_ {C_NONE};
+  int time_mesh_filter_ {C_NONE};
+
+  //! Detector cells scored by a pulse-height tally, each given by the index of
+  //! the cell in model::pulse_height_cells and the part of the filter index
+  //! from the cell filters
+  vector<std::pair<int, int>> pulse_height_bins_;
+
+  //! Indices among the filters of the energy filters of a pulse-height tally
+  vector<int> pulse_height_energy_filters_;
+
+  //! Whether every bin is a density-weighted reaction rate of a specific
+  //! nuclide, which allows all nuclides to be scored in a single pass
+  bool nuclide_rates_ {false};
+
   vector<Trigger> triggers_;
 
+  //! Whether the figure of merit is recorded at the end of each active batch
+  bool figure_of_merit_ {false};
+
+  //! Figure of merit at the end of each active batch
+  vector<FigureOfMerit> fom_history_;
+
   int deriv_ {C_NONE}; //!< Index of a TallyDerivative object for diff tallies.
 
 private:
@@ -192,6 +366,46 @@ private:
   //! Whether to multiply by atom density for reaction rates
   bool multiply_density_ {true};
 
+  //! Transport time while the tally was active, for the figure of merit [s]
+  double fom_time_ {0.0};
+
+  //! Whether each thread should score into its own copy of the values
+  bool thread_private_ {false};
+
+  //! Per-thread values for the current realization, stored in the same order
+  //! as the VALUE slice of results_. Empty when scores are added atomically.
+  vector<vector<double>> thread_results_;
+
+  //! Whether results are stored in sparse tiles rather than results_
+  bool sparse_storage_ {false};
+
+  //! Whether filter bins are divided among MPI processes, each of which only
+  //! stores the results of its own contiguous range of bins
+  bool partitioned_ {false};
+
+  //! First filter bin of each process, followed by the number of filter bins
+  vector<int64_t> bin_offsets_;
+
+  //! First filter bin owned by this process
+  int64_t bin_begin_ {0};
+
+  //! A score to a bin owned by another process
+  struct RemoteScore {
+    int64_t index; //!< Index of the (filter bin, nuclide/score) combination
+    double value;
+  };
+
+  //! Per-thread scores to bins owned by other processes
+  vector<vector<RemoteScore>> remote_scores_;
+
+  //! Whether values of the current realization are scored in single precision
+  bool single_precision_ {false};
+
+  //! Single-precision values for the current realization, stored in the same
+  //! order as the VALUE slice of results_. Empty unless single precision is in
+  //! use.
+  vector<float> single_values_;
+
   gsl::index index_;
 };
 
@@ -209,7 +423,14 @@ extern vector<int> active_collision_tallies;
 extern vector<int> active_meshsurf_tallies;
 extern vector<int> active_surface_tallies;
 extern vector<int> active_pulse_height_tallies;
+
+//! Number of groups of tallies that share filter bin combinations
+extern int n_filter_groups;
 extern vector<int> pulse_height_cells;
+
+//! Index in pulse_height_cells of each cell, or C_NONE for cells that are not
+//! scored by a pulse-height tally
+extern vector<int> pulse_height_index;
 } // namespace model
 
 namespace simulation {
@@ -239,11 +460,35 @@ void read_tallies_xml(pugi::xml_node root);
 
 //! \brief Accumulate the sum of the contributions from each history within the
 //! batch to a new random variable
-void accumulate_tallies();
+//
+//! \param[in] defer  Save the values of tallies so that they are accumulated
+//!   later by accumulate_deferred_tallies() instead
+void accumulate_tallies(bool defer = false);
+
+//! Accumulate the values of tallies deferred by accumulate_tallies(). Does
+//! nothing if none are pending.
+void accumulate_deferred_tallies();
+
+//! Normalization of the scores of one batch per source particle
+double batch_normalization();
+
+//! Whether any active tally records its figure of merit
+bool figures_of_merit_needed();
+
+//! Record the figure of merit of each active tally that tracks it. This must
+//! be called once the results of the batch have been accumulated.
+void update_figures_of_merit();
 
 //! Determine which tallies should be active
 void setup_active_tallies();
 
+//! Find groups of tallies that can share filter bin combinations
+void setup_filter_groups();
+
+//! Find the filter bins of the detector cells of pulse-height tallies. This
+//! must be called after the strides of the tallies are set.
+void setup_pulse_height_tallies();
+
 // Alias for the type returned by xt::adapt(...). N is the dimension of the
 // multidimensional array
 template<std::size_t N>
@@ -251,10 +496,16 @@ using adaptor_type =
   xt::xtensor_adaptor<xt::xbuffer_adaptor<double*&, xt::no_ownership>, N>;
 
 #ifdef OPENMC_MPI
-//! Collect all tally results onto master process
+//! Collect all tally results onto master process. With overlap_reduction, the
+//! reduction is only started and is completed by finish_tally_reduction().
 void reduce_tally_results();
 #endif
 
+//! Wait for an overlapped reduction of tally results to complete and add the
+//! reduced values to the tally sums, along with any deferred values. Does
+//! nothing if none is in progress.
+void finish_tally_reduction();
+
 void free_memory_tally();
 
 } // namespace openmc
@@ -21,7 +21,11 @@ namespace openmc {
 class FilterBinIter {
 public:
   //! Construct an iterator over bins that match a given particle's state.
-  FilterBinIter(const Tally& tally, Particle& p);
+  //
+  //! \param fuse if true, the bins of the tally's expansion filter or current
+  //!   filter are left out of the combinations and scored together, by
+  //!   add_tally_result() or score_surface_tally() respectively
+  FilterBinIter(const Tally& tally, Particle& p, bool fuse = false);
 
   //! Construct an iterator over all filter bin combinations.
   //
@@ -47,15 +51,57 @@ public:
   vector<FilterMatch>& filter_matches_;
 
 private:
+  //! Find the matching bins of each filter and the first combination
+  void find_bins(Particle& p);
+
+  //! Advance to the next combination of matching bins
+  void next_combination();
+
+  //! Use the i-th combination stored in the shared cache
+  void set_cached_combination(int i);
+
   void compute_index_weight();
 
+  //! Whether the i-th filter of the tally is left out of the combinations
+  bool skipped(int i) const;
+
   const Tally& tally_;
+
+  //! Index among the tally's filters of a filter left out of the
+  //! combinations, or C_NONE
+  int skipped_filter_ {C_NONE};
+
+  //! Combinations shared with tallies that have identical filters
+  const FilterBinCache* cache_ {nullptr};
+  int i_cache_ {0};
+
+  //! Combined bins of the time and mesh filters of the tally, which take the
+  //! place of their matches, and the one in the current combination
+  const FilterMatch* joint_ {nullptr};
+  int i_joint_ {0};
 };
 
 //==============================================================================
 // Non-member functions
 //==============================================================================
 
+//! Add a contribution to a tally bin. For a tally whose expansion filter bins
+//! are scored together, the contribution is added to each matching bin of the
+//! expansion filter, multiplied by the weight of the bin.
+//
+//! \param p The particle being tracked
+//! \param tally The tally to add to
+//! \param filter_index Index of the combination of the other filter bins
+//! \param score_index Index of the nuclide/score combination
+//! \param value Contribution to add
+void add_tally_result(Particle& p, Tally& tally, int filter_index,
+  int score_index, double value);
+
+//! Mark the filter matches of a particle as stale for the next tally event.
+//
+//! \param p The particle being tracked
+void reset_filter_matches(Particle& p);
+
 //! Score tallies using a 1 / Sigma_t estimate of the flux.
 //
 //! This is triggered after every collision.  It is invalid for tallies that
@@ -102,7 +148,7 @@ void score_surface_tally(Particle& p, const vector<int>& tallies);
 //
 //! \param p The particle being tracked
 //! \param tallies A vector of the indices of the tallies to score to
-void score_pulse_height_tally(Particle& p, const vector<int>& tallies);
+void score_pulse_height_tally(const Particle& p, const vector<int>& tallies);
 
 } // namespace openmc
 
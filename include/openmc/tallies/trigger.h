@@ -25,6 +25,12 @@ struct Trigger {
   double threshold;     //!< Uncertainty value below which trigger is satisfied
   bool ignore_zeros;    //!< Whether to allow zero tally bins to be ignored
   int score_index;      //!< Index of the relevant score in the tally's arrays
+  double fraction {1.0}; //!< Fraction of the bins that must be satisfied
+
+  // Results of the last check, also reported at the end of the run
+  int batch {0};          //!< Batch of the last check, or zero if unchecked
+  double ratio {0.0};     //!< Uncertainty/threshold ratio of the trigger
+  double satisfied {0.0}; //!< Fraction of the bins below the threshold
 };
 
 //! Stops the simulation early if a desired k-effective uncertainty is reached.
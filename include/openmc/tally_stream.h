@@ -0,0 +1,45 @@
+//! \file tally_stream.h
+//! Streaming of tally results and random ray fluxes through ADIOS2 at the end
+//! of each active batch, for codes coupled to a run in progress
+
+#ifndef OPENMC_TALLY_STREAM_H
+#define OPENMC_TALLY_STREAM_H
+
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+extern "C" const bool ADIOS2_ENABLED;
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Open the stream on the master process and define a variable for the
+//! results of each streamed tally, if tally streaming is requested
+void open_tally_stream();
+
+//! Stream the flux of the source regions of a random ray solve along with the
+//! tallies. The flux must stay allocated until the stream is closed.
+//
+//! \param flux      Scalar flux accumulated over the active batches, indexed
+//!   by source region and energy group
+//! \param negroups  Number of energy groups
+void stream_source_region_flux(const vector<float>& flux, int negroups);
+
+//! Write one step holding the results of the batch that just finished. This
+//! must be called on all processes.
+//
+//! \param batch  Batch whose results are streamed
+void write_tally_stream(int batch);
+
+//! Close the stream, signalling the end of the run to its readers
+void close_tally_stream();
+
+} // namespace openmc
+
+#endif // OPENMC_TALLY_STREAM_H
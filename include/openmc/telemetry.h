@@ -0,0 +1,60 @@
+//! \file telemetry.h
+//! Summary of each batch written while a run is in progress
+
+#ifndef OPENMC_TELEMETRY_H
+#define OPENMC_TELEMETRY_H
+
+#include <cstdint>
+
+#include "openmc/openmp_interface.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Secondary particles handled by one thread during a batch
+//==============================================================================
+
+struct alignas(64) TelemetryCounts {
+  int64_t secondaries {0};        //!< secondary particles transported
+  int64_t max_secondary_bank {0}; //!< largest size of a secondary bank
+};
+
+namespace simulation {
+
+//! Counts of each thread, indexed by thread number. Empty unless
+//! settings::path_telemetry is set.
+extern vector<TelemetryCounts> telemetry_counts;
+
+} // namespace simulation
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Open the telemetry file on the master process and allocate the counts of
+//! each thread, if telemetry is requested
+void open_telemetry();
+
+//! Write a line describing the batch that just finished to the telemetry file.
+//! This must be called on all processes.
+void write_telemetry();
+
+//! Close the telemetry file
+void close_telemetry();
+
+//! Record that a particle was revived from its secondary bank
+//! \param bank_size Size of the secondary bank before the particle was taken
+inline void count_secondary(int64_t bank_size)
+{
+  if (simulation::telemetry_counts.empty())
+    return;
+  auto& counts = simulation::telemetry_counts[thread_num()];
+  ++counts.secondaries;
+  if (bank_size > counts.max_secondary_bank)
+    counts.max_secondary_bank = bank_size;
+}
+
+} // namespace openmc
+
+#endif // OPENMC_TELEMETRY_H
@@ -0,0 +1,80 @@
+//! \file thread_stats.h
+//! Work done by each thread during transport
+
+#ifndef OPENMC_THREAD_STATS_H
+#define OPENMC_THREAD_STATS_H
+
+#include <chrono>
+#include <cstdint>
+
+#include "openmc/openmp_interface.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Time and events accumulated by one thread. Each is aligned to a cache line
+//! so that threads incrementing their own counters do not contend.
+//==============================================================================
+
+struct alignas(64) ThreadStats {
+  double time {0.0};             //!< time spent transporting in [s]
+  int64_t histories {0};         //!< source particles started
+  int64_t segments {0};          //!< tracks advanced between events
+  int64_t collisions {0};        //!< collisions
+  int64_t surface_crossings {0}; //!< surface crossings
+};
+
+namespace simulation {
+
+//! Work of each thread of this process, indexed by thread number. Empty
+//! unless settings::thread_stats is set.
+extern vector<ThreadStats> thread_stats;
+
+} // namespace simulation
+
+//==============================================================================
+//! Adds the time the calling thread spends in the scope of an object to its
+//! statistics. An object is created at the start of a parallel region, before
+//! a loop without a closing barrier, so that only the thread's share of the
+//! work is timed and not the time it waits on other threads.
+//==============================================================================
+
+class ThreadTimer {
+public:
+  ThreadTimer();
+  ~ThreadTimer();
+
+private:
+  bool active_;                                 //!< are stats kept?
+  std::chrono::steady_clock::time_point start_; //!< time of creation
+};
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Allocate and zero the statistics of each thread if they are requested
+void reset_thread_stats();
+
+//! Increment a counter of the calling thread if statistics are kept
+//! \param counter Member of ThreadStats to increment
+inline void count_thread_event(int64_t ThreadStats::*counter)
+{
+  if (!simulation::thread_stats.empty())
+    ++(simulation::thread_stats[thread_num()].*counter);
+}
+
+//! Collect the statistics of all threads on all processes
+//! \param[out] n_threads Number of threads on each process, on the master
+//! \return Statistics of the threads of each process in turn, on the master;
+//!   empty on other processes
+vector<ThreadStats> gather_thread_stats(vector<int>& n_threads);
+
+//! Display the smallest, mean, and largest work of a thread
+//! \param stats Statistics of all threads, as returned by gather_thread_stats
+void print_thread_stats(const vector<ThreadStats>& stats);
+
+} // namespace openmc
+
+#endif // OPENMC_THREAD_STATS_H
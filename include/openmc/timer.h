@@ -2,6 +2,7 @@
 #define OPENMC_TIMER_H
 
 #include <chrono>
+#include <cstdint>
 
 namespace openmc {
 
@@ -17,19 +18,28 @@ extern Timer time_active;
 extern Timer time_bank;
 extern Timer time_bank_sample;
 extern Timer time_bank_sendrecv;
+extern Timer time_energy_grids;
 extern Timer time_finalize;
 extern Timer time_inactive;
+extern Timer time_pipeline;
+extern Timer time_pipeline_wait;
 extern Timer time_initialize;
 extern Timer time_read_xs;
+extern Timer time_read_geometry;
+extern Timer time_read_materials;
+extern Timer time_setup_geometry;
+extern Timer time_distribcell;
 extern Timer time_statepoint;
 extern Timer time_tallies;
 extern Timer time_total;
 extern Timer time_transport;
 extern Timer time_event_init;
 extern Timer time_event_calculate_xs;
+extern Timer time_event_sort;
 extern Timer time_event_advance_particle;
 extern Timer time_event_surface_crossing;
 extern Timer time_event_collision;
+extern Timer time_event_tail;
 extern Timer time_event_death;
 extern Timer time_update_src;
 
@@ -45,6 +55,11 @@ public:
 
   Timer() {};
 
+  //! Create a timer whose running periods are marked as ranges for profilers
+  //! when OpenMC is built with tracing
+  //! \param name Name of the ranges
+  explicit Timer(const char* name) : name_ {name} {}
+
   //! Start running the timer
   void start();
 
@@ -62,6 +77,8 @@ private:
   bool running_ {false};                 //!< is timer running?
   std::chrono::time_point<clock> start_; //!< starting point for clock
   double elapsed_ {0.0};                 //!< elapsed time in [s]
+  const char* name_ {nullptr};           //!< name of traced ranges
+  uint64_t trace_ {0};                   //!< handle of the current range
 };
 
 //==============================================================================
@@ -0,0 +1,62 @@
+//! \file trace.h
+//! Ranges marking phases of a run for external profilers
+
+#ifndef OPENMC_TRACE_H
+#define OPENMC_TRACE_H
+
+#include <cstdint>
+
+namespace openmc {
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+// When OpenMC is built without OPENMC_TRACE, these functions do nothing and
+// are inlined away.
+
+#ifdef OPENMC_TRACE
+
+//! Begin a range shown by the profiler the build is instrumented for
+//! \param name Name of the range, which must outlive the range
+//! \return Handle identifying the range
+uint64_t trace_begin(const char* name);
+
+//! End a range
+//! \param handle Handle returned when the range began
+void trace_end(uint64_t handle);
+
+//! Write the ranges recorded so far to trace.json, or trace.<rank>.json with
+//! several processes, if they are kept in memory for the Chrome trace format
+void write_trace();
+
+#else
+
+inline uint64_t trace_begin(const char*)
+{
+  return 0;
+}
+inline void trace_end(uint64_t) {}
+inline void write_trace() {}
+
+#endif
+
+//==============================================================================
+//! Range covering the lifetime of an object
+//==============================================================================
+
+class TraceRange {
+public:
+  explicit TraceRange(const char* name) : handle_ {trace_begin(name)} {}
+  ~TraceRange() { trace_end(handle_); }
+
+  TraceRange(const TraceRange&) = delete;
+  TraceRange& operator=(const TraceRange&) = delete;
+
+private:
+  uint64_t handle_; //!< handle of the range
+};
+
+} // namespace openmc
+
+#endif // OPENMC_TRACE_H
@@ -15,6 +15,11 @@ void open_track_file();
 //! Close HDF5 resources for track file
 void close_track_file();
 
+//! Write the tracks held in the buffer of each thread to the track file
+//
+//! This must be called outside of a parallel region.
+void flush_track_buffers();
+
 //! Determine whether a given particle should collect/write track information
 //
 //! \param[in] p  Current particle
@@ -33,6 +38,10 @@ void write_particle_track(Particle& p);
 
 //! Write full particle state history to HDF5 track file
 //
+//! The track is held in a buffer of the calling thread until the buffer
+//! reaches the memory limit given by settings::track_buffer_memory or the
+//! batch ends.
+//
 //! \param[in] p  Current particle
 void finalize_particle_track(Particle& p);
 
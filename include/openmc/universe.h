@@ -49,18 +49,25 @@ private:
 
 //==============================================================================
 //! Speeds up geometry searches by grouping cells in a search tree.
-//
-//! Currently this object only works with universes that are divided up by a
-//! bunch of z-planes.  It could be generalized to other planes, cylinders,
-//! and spheres.
 //==============================================================================
 
 class UniversePartitioner {
 public:
-  explicit UniversePartitioner(const Universe& univ);
+  virtual ~UniversePartitioner() = default;
 
   //! Return the list of cells that could contain the given coordinates.
-  const vector<int32_t>& get_cells(Position r, Direction u) const;
+  virtual const vector<int32_t>& get_cells(Position r, Direction u) const = 0;
+};
+
+//==============================================================================
+//! Partitions a universe that is divided up by a bunch of z-planes.
+//==============================================================================
+
+class ZPlanePartitioner : public UniversePartitioner {
+public:
+  explicit ZPlanePartitioner(const Universe& univ);
+
+  const vector<int32_t>& get_cells(Position r, Direction u) const override;
 
 private:
   //! A sorted vector of indices to surfaces that partition the universe
@@ -76,5 +83,62 @@ private:
   vector<vector<int32_t>> partitions_;
 };
 
+//==============================================================================
+//! Partitions a universe with an octree built from the bounding boxes of its
+//! cells.
+//
+//! The octree covers the finite extent of the cell bounding boxes. Each leaf
+//! lists the cells whose bounding boxes overlap it. Cells that are unbounded in
+//! some direction are also the only candidates outside of the octree.
+//==============================================================================
+
+class OctreePartitioner : public UniversePartitioner {
+public:
+  explicit OctreePartitioner(const Universe& univ);
+
+  const vector<int32_t>& get_cells(Position r, Direction u) const override;
+
+  //! Mean number of cells in a leaf, weighted by the volume of the leaf
+  double mean_cells() const { return mean_cells_; }
+
+  //----------------------------------------------------------------------------
+  // Constants
+
+  static constexpr int MAX_DEPTH {6};  //!< Maximum depth of a leaf
+  static constexpr int LEAF_CELLS {8}; //!< Cells in leaves that are not split
+
+private:
+  struct Node {
+    Position center; //!< Point at which the node is divided into octants
+    int first_child {-1}; //!< Index of the first of 8 children, or -1 if leaf
+    int leaf {-1};        //!< Index in leaves_ of a leaf's cells
+  };
+
+  //! Set up the node for a box, dividing it while that reduces the number of
+  //! candidate cells
+  //
+  //! \param[in] i_node  Index of the node in nodes_
+  //! \param[in] lower  Lower corner of the box
+  //! \param[in] upper  Upper corner of the box
+  //! \param[in] cells  Positions in cells_ of the cells overlapping the box
+  //! \param[in] depth  Depth of the node in the tree
+  void build(int i_node, Position lower, Position upper,
+    const vector<int>& cells, int depth);
+
+  Position lower_; //!< Lower corner of the octree
+  Position upper_; //!< Upper corner of the octree
+
+  //! Cells of the universe with the lower and upper corners of their padded
+  //! bounding boxes
+  vector<int32_t> cells_;
+  vector<Position> cell_lower_;
+  vector<Position> cell_upper_;
+
+  vector<Node> nodes_;             //!< Nodes with the root first
+  vector<vector<int32_t>> leaves_; //!< Cells overlapping each leaf
+  vector<int32_t> outside_;        //!< Cells not bounded by the octree
+  double mean_cells_ {0.0};
+};
+
 } // namespace openmc
 #endif // OPENMC_UNIVERSE_H
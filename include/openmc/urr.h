@@ -49,6 +49,24 @@ public:
   //! \brief Load the URR data from the provided HDF5 group
   explicit UrrData(hid_t group_id);
 
+  //! \brief Find the band sampled by a random number at an incident energy
+  //!
+  //! The band is the number of CDF values that do not exceed the random
+  //! number, which is counted without branches over the row of cdf_values_
+  //! so that it vectorizes. This relies on cdf_values_ being row major and on
+  //! the CDF being nondecreasing.
+  int band_index(int i_energy, double r) const
+  {
+    const double* cdf = &cdf_values_(i_energy, 0);
+    int n = n_cdf();
+    int i_band = 0;
+#pragma omp simd reduction(+ : i_band)
+    for (int k = 0; k < n; ++k) {
+      i_band += (cdf[k] <= r);
+    }
+    return i_band;
+  }
+
   // Checks if any negative CDF or XS values are present
   bool has_negative() const;
 
@@ -61,8 +61,14 @@ public:
   // Tally filter and map types
   enum class TallyDomain { UNIVERSE, MATERIAL, CELL };
 
+  // Estimators of the fraction of the bounding box in each domain. POINT
+  // checks which domains contain points sampled in the box and RAY measures
+  // the length of random chords of the box within each domain.
+  enum class Estimator { POINT, RAY };
+
   // Data members
   TallyDomain domain_type_; //!< Type of domain (cell, material, etc.)
+  Estimator estimator_ {Estimator::POINT}; //!< Estimator of domain fractions
   size_t n_samples_;        //!< Number of samples to use
   double threshold_ {-1.0}; //!< Error threshold for domain volumes
   TriggerMetric trigger_type_ {
@@ -70,16 +76,6 @@ public:
   Position lower_left_;         //!< Lower-left position of bounding box
   Position upper_right_;        //!< Upper-right position of bounding box
   vector<int> domain_ids_;      //!< IDs of domains to find volumes of
-
-private:
-  //! \brief Check whether a material has already been hit for a given domain.
-  //! If not, add new entries to the vectors
-  //
-  //! \param[in] i_material Index in global materials vector
-  //! \param[in,out] indices Vector of material indices
-  //! \param[in,out] hits Number of hits corresponding to each material
-  void check_hit(
-    int i_material, vector<uint64_t>& indices, vector<uint64_t>& hits) const;
 };
 
 //==============================================================================
@@ -1,6 +1,7 @@
 #ifndef OPENMC_WEIGHT_WINDOWS_H
 #define OPENMC_WEIGHT_WINDOWS_H
 
+#include <algorithm> // for max, min
 #include <cstdint>
 #include <unordered_map>
 
@@ -8,6 +9,7 @@
 #include <hdf5.h>
 #include <pugixml.hpp>
 
+#include "openmc/array.h"
 #include "openmc/constants.h"
 #include "openmc/memory.h"
 #include "openmc/mesh.h"
@@ -19,6 +21,7 @@ namespace openmc {
 
 enum class WeightWindowUpdateMethod {
   MAGIC,
+  FW_CADIS,
 };
 
 //==============================================================================
@@ -33,23 +36,37 @@ constexpr double DEFAULT_WEIGHT_CUTOFF {1.0e-38}; // default low weight cutoff
 
 //! Apply weight windows to a particle
 //! \param[in] p  Particle to apply weight windows to
-void apply_weight_windows(Particle& p);
+//! \return Whether a weight window was found for the particle
+bool apply_weight_windows(Particle& p);
 
 //! Free memory associated with weight windows
 void free_memory_weight_windows();
 
+class ExponentialTransform;
+
+//! Find the exponential transform applied to a particle
+//! \param[in] p  Particle in its current cell
+//! \return Exponential transform of the cell, or nullptr if there is none
+const ExponentialTransform* get_exponential_transform(const Particle& p);
+
 //==============================================================================
 // Global variables
 //==============================================================================
 
 class WeightWindows;
 class WeightWindowsGenerator;
+class WeightWindowsIndex;
 
 namespace variance_reduction {
 
 extern std::unordered_map<int32_t, int32_t> ww_map;
 extern vector<unique_ptr<WeightWindows>> weight_windows;
 extern vector<unique_ptr<WeightWindowsGenerator>> weight_windows_generators;
+extern WeightWindowsIndex ww_index;
+extern vector<ExponentialTransform> exponential_transforms;
+
+//! Index of the exponential transform applied in each cell, or C_NONE
+extern vector<int> cell_exponential_transform;
 
 } // namespace variance_reduction
 
@@ -102,6 +119,13 @@ private:
 
   void check_tally_update_compatibility(const Tally* tally);
 
+  //! Compute the bounds from a view of tally results indexed by (particle,
+  //! energy, mesh, score, result)
+  template<class T>
+  void compute_bounds(const T& transposed_view, int particle_idx,
+    int score_index, int n, WeightWindowUpdateMethod method,
+    const std::string& value, double threshold, double ratio, double damping);
+
 public:
   //! Set the weight window ID
   void set_id(int32_t id = -1);
@@ -130,6 +154,22 @@ public:
   void update_magic(const Tally* tally, const std::string& value = "mean",
     double threshold = 1.0, double ratio = 5.0);
 
+  //! Update weight window boundaries using tally results
+  //! \param[in] tally Pointer to the tally whose results will be used to
+  //! update weight windows. With FW-CADIS, its flux score is the adjoint flux.
+  //! \param[in] method Method used to compute the bounds from the flux
+  //! \param[in] value String representing the type of value to use for weight
+  //! window generation (one of "mean" or "rel_err")
+  //! \param[in] threshold Relative error threshold. Results over this
+  //! threshold will be ignored \param[in] ratio Ratio of upper to lower
+  //! weight window bounds
+  //! \param[in] damping Exponent of the new bounds when they are blended
+  //! geometrically with the current ones. Below one, bins whose results are
+  //! ignored keep their current bounds.
+  void update_weights(const Tally* tally, WeightWindowUpdateMethod method,
+    const std::string& value = "mean", double threshold = 1.0,
+    double ratio = 5.0, double damping = 1.0);
+
   // NOTE: This is unused for now but may be used in the future
   //! Write weight window settings to an HDF5 file
   //! \param[in] group  HDF5 group to write to
@@ -139,6 +179,16 @@ public:
   //! \param[in] p  Particle to get weight window for
   WeightWindow get_weight_window(const Particle& p) const;
 
+  //! Retrieve the weight window for a particle, starting from the bins it was
+  //! found in earlier
+  //! \param[in] p  Particle to get weight window for
+  //! \param[inout] mesh_bin  Mesh bin of the particle at an earlier position,
+  //!   or C_NONE. Set to the mesh bin at its current position.
+  //! \param[inout] energy_bin  Energy bin of the particle at an earlier
+  //!   energy, or C_NONE. Set to the energy bin at its current energy.
+  WeightWindow get_weight_window(
+    const Particle& p, int& mesh_bin, int& energy_bin) const;
+
   std::array<int, 2> bounds_size() const;
 
   const vector<double>& energy_bounds() const { return energy_bounds_; }
@@ -182,6 +232,8 @@ public:
 
   const std::unique_ptr<Mesh>& mesh() const { return model::meshes[mesh_idx_]; }
 
+  bool has_mesh() const { return mesh_idx_ != C_NONE; }
+
   const xt::xtensor<double, 2>& lower_ww_bounds() const { return lower_ww_; }
   xt::xtensor<double, 2>& lower_ww_bounds() { return lower_ww_; }
 
@@ -209,6 +261,66 @@ private:
   int32_t mesh_idx_ {-1}; //!< Index in meshes vector
 };
 
+//==============================================================================
+//! Maps the position and type of a particle to the weight windows whose mesh
+//! may contain it.
+//!
+//! The box around the meshes of all weight windows is divided into a coarse
+//! grid. Each grid cell lists the weight windows of each particle type whose
+//! mesh overlaps the cell, in the order in which weight windows are searched,
+//! so that only the few meshes near a particle are checked.
+//==============================================================================
+
+class WeightWindowsIndex {
+public:
+  //----------------------------------------------------------------------------
+  // Methods
+
+  //! Build the index over all weight windows
+  void build();
+
+  //! Remove all weight windows from the index. It needs to be rebuilt once
+  //! the mesh or particle type of a weight window changes.
+  void clear();
+
+  //! Whether weight windows are searched through the index
+  bool enabled() const { return enabled_; }
+
+  //! Find the weight windows whose mesh may contain a particle
+  //
+  //! \param[in] type  Type of the particle
+  //! \param[in] r  Position of the particle
+  //! \return Indices of the weight windows in search order
+  const vector<int>& candidates(ParticleType type, Position r) const;
+
+private:
+  //! Index of the grid cell containing a coordinate along a dimension
+  int grid_index(int i, double x) const
+  {
+    if (n_[i] == 1)
+      return 0;
+    int j = (x - lower_left_[i]) * inv_width_[i];
+    return std::max(0, std::min(j, n_[i] - 1));
+  }
+
+  //----------------------------------------------------------------------------
+  // Constants
+
+  static constexpr int MAX_DIVISIONS {16}; //!< Grid cells per dimension
+  static constexpr int N_TYPES {2};        //!< Neutrons and photons
+
+  //----------------------------------------------------------------------------
+  // Data members
+
+  bool enabled_ {false};
+  Position lower_left_;            //!< Lower corner of all meshes
+  Position upper_right_;           //!< Upper corner of all meshes
+  array<int, 3> n_ {1, 1, 1};      //!< Number of grid cells per dimension
+  array<double, 3> inv_width_ {};  //!< Inverse width of a grid cell
+  vector<vector<int>> candidates_; //!< Weight windows for each type and cell
+  vector<int> none_;               //!< Empty list for positions outside
+};
+
 class WeightWindowsGenerator {
 public:
   // Constructors
@@ -223,19 +335,55 @@ public:
   // Data members
   int32_t tally_idx_;  //!< Index of the tally used to update the weight windows
   int32_t ww_idx_;     //!< Index of the weight windows object being generated
-  std::string method_; //!< Method used to update weight window. Only "magic"
-                       //!< is valid for now.
+  std::string method_; //!< Method used to update weight window, one of
+                       //!< "magic" or "fw_cadis"
+  WeightWindowUpdateMethod update_method_ {
+    WeightWindowUpdateMethod::MAGIC}; //!< Method as an enum
   int32_t max_realizations_; //!< Maximum number of tally realizations
   int32_t update_interval_;  //!< Determines how often updates occur
   bool on_the_fly_; //!< Whether or not to keep tally results between batches or
                     //!< realizations
 
-  // MAGIC update parameters
+  // MAGIC and FW-CADIS update parameters
   std::string tally_value_ {
     "mean"};               //<! Tally value to use (one of {"mean", "rel_err"})
   double threshold_ {1.0}; //<! Relative error threshold for values used to
                            // update weight windows
   double ratio_ {5.0};     //<! ratio of lower to upper weight window bounds
+  double damping_ {1.0};   //<! exponent blending new bounds with current ones
+};
+
+//==============================================================================
+//! Exponential transform applied to neutrons and photons in a set of cells
+//!
+//! Distances to collision are sampled from a total cross section stretched to
+//! sigma_t * (1 - p * mu), where p is the stretching parameter and mu is the
+//! cosine of the angle between the particle direction and the preferred
+//! direction, so that particles travel further in the preferred direction.
+//! The weight of a particle is corrected at the end of each flight so that
+//! estimates remain unbiased.
+//==============================================================================
+
+class ExponentialTransform {
+public:
+  // Constructors
+  ExponentialTransform(pugi::xml_node node);
+
+  // Methods
+
+  //! Stretched total cross section for a particle direction
+  //! \param[in] total  Total cross section
+  //! \param[in] u  Direction of the particle
+  //! \return Total cross section used to sample the distance to collision
+  double stretched_total(double total, Direction u) const
+  {
+    return total * (1.0 - stretching_ * u.dot(direction_));
+  }
+
+  // Data members
+  vector<int32_t> cell_ids_; //!< IDs of the cells the transform applies to
+  double stretching_;        //!< Stretching parameter, between -1 and 1
+  Direction direction_;      //!< Preferred direction
 };
 
 //! Finalize variance reduction objects after all inputs have been read
@@ -58,6 +58,22 @@ public:
   //! sections in [b]
   std::tuple<double, double, double> evaluate(double E, double sqrtkT) const;
 
+  //! \brief Evaluate the windowed multipole equations for several lookups
+  //!
+  //! Lookups with energies in the same window that are adjacent, e.g. because
+  //! they are sorted by energy, are evaluated together so that the poles of
+  //! the window are read once for all of them.
+  //!
+  //! \param n Number of lookups
+  //! \param E Incident neutron energy in [eV] of each lookup
+  //! \param sqrtkT Square root of temperature times Boltzmann constant of each
+  //!   lookup
+  //! \param[out] sig_s Elastic scattering cross section in [b]
+  //! \param[out] sig_a Absorption cross section in [b]
+  //! \param[out] sig_f Fission cross section in [b]
+  void evaluate_batch(int n, const double* E, const double* sqrtkT,
+    double* sig_s, double* sig_a, double* sig_f) const;
+
   //! \brief Evaluates the windowed multipole equations for the derivative of
   //! cross sections in the resolved resonance regions with respect to
   //! temperature.
@@ -85,6 +101,19 @@ public:
   // Constant data
   static constexpr int MAX_POLY_COEFFICIENTS =
     11; //!< Max order of polynomial fit plus one
+  static constexpr int POLE_BLOCK {32}; //!< Poles summed at a time
+
+private:
+  //! Index of the window containing an energy
+  int window_index(double E) const;
+
+  //! Set cross sections to the curvefit of a window at an energy
+  void evaluate_curvefit(int i_window, double E, double sqrtkT,
+    double& sig_s, double& sig_a, double& sig_f) const;
+
+  //! Add the contribution of at most POLE_BLOCK poles to cross sections
+  void add_poles(int i_start, int n, double E, double sqrtkT, double& sig_s,
+    double& sig_a, double& sig_f) const;
 };
 
 //========================================================================
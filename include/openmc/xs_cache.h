@@ -0,0 +1,82 @@
+//! \file xs_cache.h
+//! Memory-mapped cache of tabulated cross sections
+
+#ifndef OPENMC_XS_CACHE_H
+#define OPENMC_XS_CACHE_H
+
+#include <cstddef> // for size_t
+#include <string>
+#include <unordered_map>
+
+#include <gsl/gsl-lite.hpp>
+
+namespace openmc {
+
+//==============================================================================
+//! Read-only memory map of the tabulated cross sections of nuclides written by
+//! a previous run.
+//!
+//! The file consists of a header, a directory giving the name, offset, and
+//! length of each array, and the arrays themselves aligned to cache lines, so
+//! that arrays can be used in place without being copied. Since the file is
+//! mapped read-only, the operating system page cache holds a single copy of
+//! the data for all processes on a node.
+//==============================================================================
+
+class CrossSectionCache {
+public:
+  ~CrossSectionCache() { this->close(); }
+
+  //! Map a cache file
+  //
+  //! \param[in] path  Path to the cache file
+  //! \return Whether the file could be mapped and matches the current settings
+  bool open(const std::string& path);
+
+  //! Unmap the cache file
+  void close();
+
+  //! Whether a cache file is mapped
+  bool is_open() const { return data_ != nullptr; }
+
+  //! Find an array in the cache
+  //
+  //! \param[in] key  Name of the array
+  //! \param[out] values  View of the array, if present
+  //! \return Whether the array is present
+  bool find(const std::string& key, gsl::span<const double>& values) const;
+
+private:
+  void* data_ {nullptr}; //!< Start of the mapped file
+  size_t size_ {0};      //!< Size of the mapped file in bytes
+  std::unordered_map<std::string, gsl::span<const double>> arrays_;
+};
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Name of the derived cross section table of a nuclide in the cache
+std::string xs_cache_key(const std::string& nuclide, int T);
+
+//! Name of the cross section of a reaction in the cache
+std::string xs_cache_key(const std::string& nuclide, int mt, int T);
+
+//! Write the tabulated cross sections of all nuclides to a cache file
+//
+//! \param[in] path  Path to the cache file
+void write_xs_cache(const std::string& path);
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace data {
+
+extern CrossSectionCache xs_cache;
+
+} // namespace data
+
+} // namespace openmc
+
+#endif // OPENMC_XS_CACHE_H
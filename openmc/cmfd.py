@@ -311,7 +311,26 @@ class CMFDRun:
         of Gauss-Seidel iterations during CMFD power iteration.
     gauss_seidel_tolerance : Iterable of float
         Two parameters specifying the absolute inner tolerance and the relative
-        inner tolerance for Gauss-Seidel iterations when performing CMFD.
+        inner tolerance for Gauss-Seidel iterations when performing CMFD. The
+        same tolerances apply to the relative residual of BiCGStab iterations.
+    linear_solver : {'gauss-seidel', 'bicgstab'}
+        Linear solver used for the inner iterations of CMFD power iteration.
+        Options are:
+
+        * "gauss-seidel" - Red/black Gauss-Seidel iterations with
+          overrelaxation
+        * "bicgstab" - Preconditioned biconjugate gradient stabilized method,
+          which converges in fewer iterations on fine CMFD meshes
+
+        .. versionadded:: 0.15.1
+    preconditioner : {'jacobi', 'ilu'}
+        Preconditioner used by the BiCGStab linear solver. Options are:
+
+        * "jacobi" - Diagonal preconditioner, which is fully threaded
+        * "ilu" - Incomplete LU factorization with zero fill-in, which is more
+          effective but applied serially
+
+        .. versionadded:: 0.15.1
     adjoint_type : {'physical', 'math'}
         Stores type of adjoint calculation that should be performed.
         ``run_adjoint`` must be true for an adjoint calculation to be
@@ -393,6 +412,8 @@ class CMFDRun:
         self._write_matrices = False
         self._spectral = 0.0
         self._gauss_seidel_tolerance = [1.e-10, 1.e-5]
+        self._linear_solver = 'gauss-seidel'
+        self._preconditioner = 'ilu'
         self._adjoint_type = 'physical'
         self._window_type = 'none'
         self._window_size = 10
@@ -556,6 +577,14 @@ class CMFDRun:
     def gauss_seidel_tolerance(self):
         return self._gauss_seidel_tolerance
 
+    @property
+    def linear_solver(self):
+        return self._linear_solver
+
+    @property
+    def preconditioner(self):
+        return self._preconditioner
+
     @property
     def indices(self):
         return self._indices
@@ -757,6 +786,19 @@ class CMFDRun:
         check_length('Gauss-Seidel tolerance', gauss_seidel_tolerance, 2)
         self._gauss_seidel_tolerance = gauss_seidel_tolerance
 
+    @linear_solver.setter
+    def linear_solver(self, linear_solver):
+        check_type('CMFD linear solver', linear_solver, str)
+        check_value('CMFD linear solver', linear_solver,
+                    ['gauss-seidel', 'bicgstab'])
+        self._linear_solver = linear_solver
+
+    @preconditioner.setter
+    def preconditioner(self, preconditioner):
+        check_type('CMFD preconditioner', preconditioner, str)
+        check_value('CMFD preconditioner', preconditioner, ['jacobi', 'ilu'])
+        self._preconditioner = preconditioner
+
     @use_all_threads.setter
     def use_all_threads(self, use_all_threads):
         check_type('CMFD use all threads', use_all_threads, bool)
@@ -987,10 +1029,18 @@ class CMFDRun:
         # Pass coremap as 1-d array of 32-bit integers
         coremap = np.swapaxes(self._coremap, 0, 2).flatten().astype(np.int32)
 
+        # Index of linear solver in the C++ CMFD solver
+        if self._linear_solver == 'gauss-seidel':
+            solver = 0
+        elif self._preconditioner == 'jacobi':
+            solver = 1
+        else:
+            solver = 2
+
         return openmc.lib._dll.openmc_initialize_linsolver(
             temp_loss.indptr.astype(np.int32), len(temp_loss.indptr),
             temp_loss.indices.astype(np.int32), len(temp_loss.indices), n,
-            self._spectral, coremap, self._use_all_threads
+            self._spectral, coremap, self._use_all_threads, solver
         )
 
     def _write_cmfd_output(self):
@@ -2986,6 +3036,11 @@ class CMFDRun:
             # Set all tallies to be active from beginning
             cmfd_tally.active = True
 
+            # The coarse mesh has few bins that every thread scores into, so
+            # each thread accumulates its own copy rather than adding scores
+            # atomically
+            cmfd_tally.thread_private = True
+
         # Initialize CMFD mesh and energy grid in C++ for CMFD reweight
         args = self._tally_ids[0], self._indices, self._norm
         openmc.lib._dll.openmc_initialize_mesh_egrid(*args)
@@ -172,6 +172,15 @@ class CoupledOperator(OpenMCOperator):
         material to volume of the cell they fill.
 
         .. versionadded:: 0.14.0
+    persistent : bool, optional
+        Whether cross sections of every nuclide in the depletion chain are
+        loaded before the first transport solve and the fission source at the
+        end of each solve is used as the initial source of the next one. Later
+        steps then neither read cross sections nor start from an unconverged
+        source, at the cost of the memory used by nuclides that are not yet
+        present in any material.
+
+        .. versionadded:: 0.15.1
 
     Attributes
     ----------
@@ -202,6 +211,9 @@ class CoupledOperator(OpenMCOperator):
     cleanup_when_done : bool
         Whether to finalize and clear the shared library memory when the
         depletion operation is complete. Defaults to clearing the library.
+    persistent : bool
+        Whether the chain cross sections are preloaded and the fission source
+        is kept between transport solves.
     """
     _fission_helpers = {
         "average": AveragedFissionYieldHelper,
@@ -214,7 +226,8 @@ class CoupledOperator(OpenMCOperator):
                  normalization_mode="fission-q", fission_q=None,
                  fission_yield_mode="constant", fission_yield_opts=None,
                  reaction_rate_mode="direct", reaction_rate_opts=None,
-                 reduce_chain=False, reduce_chain_level=None):
+                 reduce_chain=False, reduce_chain_level=None,
+                 persistent=False):
 
         # check for old call to constructor
         if isinstance(model, openmc.Geometry):
@@ -245,6 +258,7 @@ class CoupledOperator(OpenMCOperator):
             )
 
         self.cleanup_when_done = True
+        self.persistent = persistent
 
         if reaction_rate_opts is None:
             reaction_rate_opts = {}
@@ -386,6 +400,15 @@ class CoupledOperator(OpenMCOperator):
         if not openmc.lib.is_initialized:
             openmc.lib.init(intracomm=comm)
 
+        # Load cross sections of the whole chain once rather than as nuclides
+        # first appear in later steps
+        if self.persistent:
+            for nuc in self.number.nuclides:
+                if nuc in self.nuclides_with_data and \
+                        nuc not in openmc.lib.nuclides:
+                    openmc.lib.load_nuclide(nuc)
+            openmc.lib.simulation_set_persistent(True)
+
         # Generate tallies in memory
         materials = [openmc.lib.materials[int(i)] for i in self.burnable_mats]
 
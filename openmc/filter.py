@@ -25,7 +25,7 @@ _FILTER_TYPES = (
     'energyout', 'mu', 'polar', 'azimuthal', 'distribcell', 'delayedgroup',
     'energyfunction', 'cellfrom', 'materialfrom', 'legendre', 'spatiallegendre',
     'sphericalharmonics', 'zernike', 'zernikeradial', 'particle', 'cellinstance',
-    'collision', 'time'
+    'collision', 'time', 'energyresponse'
 )
 
 _CURRENT_NAMES = (
@@ -2263,3 +2263,196 @@ class EnergyFunctionFilter(Filter):
             {self.short_name.lower(): filter_bins})])
 
         return df
+
+
+class EnergyResponseFilter(Filter):
+    """Folds tally scores with a set of response functions of incident energy.
+
+    Each bin of the filter multiplies scores by one response function, so a
+    tally with this filter scores every response in one pass while storing
+    only one value per response. This gives reaction rates for many responses,
+    e.g., on a mesh for activation, without the memory of an
+    :class:`EnergyFilter` with a fine group structure. Responses are either
+    multigroup values over a common group structure or pointwise values
+    linearly interpolated on a common energy grid. Values outside of the
+    energy range are zero.
+
+    .. versionadded:: 0.15.1
+
+    Parameters
+    ----------
+    energy : Iterable of Real
+        Group boundaries in [eV] for histogram interpolation or grid energies
+        in [eV] for linear-linear interpolation
+    responses : Iterable of Iterable of Real
+        Values of each response in each group, with shape (n_responses,
+        n_groups), or at each grid energy, with shape (n_responses, n_energy)
+    interpolation : {'histogram', 'linear-linear'}
+        Interpolation of the responses in energy
+    filter_id : int
+        Unique identifier for the filter
+
+    Attributes
+    ----------
+    energy : numpy.ndarray
+        Group boundaries or grid energies in [eV]
+    responses : numpy.ndarray
+        Values of each response with shape (n_responses, n_groups) or
+        (n_responses, n_energy)
+    interpolation : {'histogram', 'linear-linear'}
+        Interpolation of the responses in energy
+    bins : numpy.ndarray
+        Index of each response
+    id : int
+        Unique identifier for the filter
+    num_bins : Integral
+        The number of responses
+
+    """
+
+    def __init__(self, energy, responses, interpolation='histogram',
+                 filter_id=None):
+        self.energy = energy
+        self.responses = responses
+        self.interpolation = interpolation
+        self.id = filter_id
+
+    def __eq__(self, other):
+        if type(self) is not type(other):
+            return False
+        elif self.interpolation != other.interpolation:
+            return False
+        elif self.energy.shape != other.energy.shape or \
+                self.responses.shape != other.responses.shape:
+            return False
+        else:
+            return np.array_equal(self.energy, other.energy) and \
+                np.array_equal(self.responses, other.responses)
+
+    def __hash__(self):
+        string = type(self).__name__ + '\n'
+        string += '{: <16}=\t{}\n'.format('\tEnergy', self.energy)
+        string += '{: <16}=\t{}\n'.format('\tResponses', self.responses)
+        string += '{: <16}=\t{}\n'.format('\tInterpolation', self.interpolation)
+        return hash(string)
+
+    def __repr__(self):
+        string = type(self).__name__ + '\n'
+        string += '{: <16}=\t{}\n'.format('\tEnergy', self.energy)
+        string += '{: <16}=\t{}\n'.format('\tResponses', self.responses)
+        string += '{: <16}=\t{}\n'.format('\tInterpolation', self.interpolation)
+        string += '{: <16}=\t{}\n'.format('\tID', self.id)
+        return string
+
+    @classmethod
+    def from_hdf5(cls, group, **kwargs):
+        if group['type'][()].decode() != cls.short_name.lower():
+            raise ValueError("Expected HDF5 data for filter type '"
+                             + cls.short_name.lower() + "' but got '"
+                             + group['type'][()].decode() + " instead")
+
+        energy = group['energy'][()]
+        responses = group['responses'][()]
+        interpolation = group['interpolation'][()].decode()
+        filter_id = int(group.name.split('/')[-1].lstrip('filter '))
+        return cls(energy, responses, interpolation, filter_id=filter_id)
+
+    @property
+    def energy(self):
+        return self._energy
+
+    @energy.setter
+    def energy(self, energy):
+        energy = np.atleast_1d(np.asarray(energy, dtype=float))
+        cv.check_type('filter energy grid', energy, Iterable, Real)
+        cv.check_greater_than('filter energy grid size', energy.size, 2,
+                              equality=True)
+        for E in energy:
+            cv.check_greater_than('filter energy grid', E, 0, equality=True)
+        if np.any(np.diff(energy) <= 0.0):
+            raise ValueError('Energy grid of an EnergyResponseFilter must be '
+                             'monotonically increasing.')
+        self._energy = energy
+
+    @property
+    def responses(self):
+        return self._responses
+
+    @responses.setter
+    def responses(self, responses):
+        responses = np.asarray(responses, dtype=float)
+        if responses.ndim == 1:
+            responses = responses[np.newaxis, :]
+        if responses.ndim != 2 or responses.shape[0] == 0:
+            raise ValueError('Responses of an EnergyResponseFilter must be '
+                             'given as an array of shape (n_responses, '
+                             'n_values).')
+        self._responses = responses
+
+    @property
+    def interpolation(self):
+        return self._interpolation
+
+    @interpolation.setter
+    def interpolation(self, val):
+        cv.check_value('interpolation', val, ('histogram', 'linear-linear'))
+        n_values = self.energy.size - (val == 'histogram')
+        if self.responses.shape[1] != n_values:
+            raise ValueError(
+                f'Responses with {val} interpolation on {self.energy.size} '
+                f'energies need {n_values} values each but '
+                f'{self.responses.shape[1]} were given.')
+        self._interpolation = val
+
+    @property
+    def bins(self):
+        return np.arange(self.num_bins)
+
+    @bins.setter
+    def bins(self, bins):
+        raise RuntimeError('EnergyResponseFilter bins are set by its '
+                           'responses.')
+
+    @property
+    def num_bins(self):
+        return self.responses.shape[0]
+
+    def to_xml_element(self):
+        """Return XML Element representing the Filter.
+
+        Returns
+        -------
+        element : lxml.etree._Element
+            XML element containing filter data
+
+        """
+        element = ET.Element('filter')
+        element.set('id', str(self.id))
+        element.set('type', self.short_name.lower())
+
+        subelement = ET.SubElement(element, 'energy')
+        subelement.text = ' '.join(str(e) for e in self.energy)
+
+        subelement = ET.SubElement(element, 'responses')
+        subelement.text = ' '.join(str(y) for y in self.responses.flat)
+
+        subelement = ET.SubElement(element, 'interpolation')
+        subelement.text = self.interpolation
+
+        return element
+
+    @classmethod
+    def from_xml_element(cls, elem, **kwargs):
+        filter_id = int(elem.get('id'))
+        energy = [float(x) for x in get_text(elem, 'energy').split()]
+        values = [float(x) for x in get_text(elem, 'responses').split()]
+        interpolation = get_text(elem, 'interpolation', 'histogram')
+        n_values = len(energy) - (interpolation == 'histogram')
+        responses = np.reshape(values, (-1, n_values))
+        return cls(energy, responses, interpolation, filter_id=filter_id)
+
+    def can_merge(self, other):
+        return False
+
+    def is_subset(self, other):
+        return self == other
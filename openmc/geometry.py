@@ -249,6 +249,13 @@ class Geometry:
                         for u in ring:
                             child_of[u].append(lat)
 
+        for e in elem.findall('sphere_pack'):
+            lat = openmc.SpherePack.from_xml_element(e, get_universe)
+            universes[lat.id] = lat
+            child_of[lat.outer].append(lat)
+            for u in lat.universes:
+                child_of[u].append(lat)
+
         for e in elem.findall('cell'):
             c = openmc.Cell.from_xml_element(e, surfaces, mats, get_universe)
             if c.fill_type in ('universe', 'lattice'):
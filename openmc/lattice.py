@@ -104,6 +104,8 @@ class Lattice(IDManagerMixin, ABC):
             return openmc.RectLattice.from_hdf5(group, universes)
         elif lattice_type == 'hexagonal':
             return openmc.HexLattice.from_hdf5(group, universes)
+        elif lattice_type == 'sphere_pack':
+            return openmc.SpherePack.from_hdf5(group, universes)
         else:
             raise ValueError(f'Unknown lattice type: {lattice_type}')
 
@@ -2220,3 +2222,335 @@ class HexLattice(Lattice):
             lattice.universes = uarray[0]
 
         return lattice
+
+
+class SpherePack(Lattice):
+    """Spheres of equal radius, each filled with a universe, surrounded by
+    another universe.
+
+    A sphere pack represents many TRISO particles or pebbles without a cell for
+    each sphere. It fills a cell in the same way as a lattice. Element
+    :math:`i` is the inside of sphere :math:`i`, where coordinates are relative
+    to its center, and element :math:`N`, where :math:`N` is the number of
+    spheres, is the space between the spheres, which is filled with the
+    :attr:`SpherePack.outer` universe.
+
+    .. versionadded:: 0.15.1
+
+    Parameters
+    ----------
+    lattice_id : int, optional
+        Unique identifier for the sphere pack. If not specified, an identifier
+        will automatically be assigned.
+    name : str, optional
+        Name of the sphere pack. If not specified, the name is the empty
+        string.
+
+    Attributes
+    ----------
+    id : int
+        Unique identifier for the sphere pack
+    name : str
+        Name of the sphere pack
+    radius : float
+        Radius of the spheres in [cm]
+    centers : numpy.ndarray
+        Cartesian coordinates of the center of each sphere with shape (N, 3).
+        Spheres may not overlap.
+    universes : list of openmc.UniverseBase
+        Universe filling each sphere
+    outer : openmc.UniverseBase
+        Universe filling the space between the spheres
+    indices : list of int
+        Indices of the spheres
+
+    """
+
+    def __init__(self, lattice_id=None, name=''):
+        super().__init__(lattice_id, name)
+        self._radius = None
+        self._centers = None
+
+    def __repr__(self):
+        string = 'SpherePack\n'
+        string += '{0: <16}{1}{2}\n'.format('\tID', '=\t', self._id)
+        string += '{0: <16}{1}{2}\n'.format('\tName', '=\t', self._name)
+        string += '{0: <16}{1}{2}\n'.format('\tRadius', '=\t', self._radius)
+        n = 0 if self._centers is None else len(self._centers)
+        string += '{0: <16}{1}{2}\n'.format('\t# Spheres', '=\t', n)
+        outer = None if self._outer is None else self._outer._id
+        string += '{0: <16}{1}{2}\n'.format('\tOuter', '=\t', outer)
+        return string
+
+    @property
+    def radius(self):
+        return self._radius
+
+    @radius.setter
+    def radius(self, radius):
+        cv.check_type('sphere pack radius', radius, Real)
+        cv.check_greater_than('sphere pack radius', radius, 0.0)
+        self._radius = radius
+
+    @property
+    def centers(self):
+        return self._centers
+
+    @centers.setter
+    def centers(self, centers):
+        centers = np.asarray(centers, dtype=float)
+        if centers.ndim != 2 or centers.shape[1] != 3:
+            raise ValueError('Centers of a sphere pack must have shape (N, 3).')
+        self._centers = centers
+
+    @Lattice.universes.setter
+    def universes(self, universes):
+        cv.check_iterable_type('sphere pack universes', universes,
+                               openmc.UniverseBase)
+        self._universes = list(universes)
+
+    @property
+    def indices(self):
+        return list(range(len(self._centers)))
+
+    @property
+    def _natural_indices(self):
+        """Indices of all elements, including the space between the spheres
+
+        """
+        return [(i,) for i in range(len(self._centers) + 1)]
+
+    @property
+    def ndim(self):
+        return 1
+
+    def get_unique_universes(self):
+        """Determine all unique universes in the sphere pack
+
+        Returns
+        -------
+        universes : dict
+            Dictionary whose keys are universe IDs and values are
+            :class:`openmc.UniverseBase` instances
+
+        """
+        univs = {u._id: u for u in self._universes}
+        if self.outer is not None:
+            univs[self.outer._id] = self.outer
+        return univs
+
+    def get_universe(self, idx):
+        """Return the universe filling an element of the sphere pack
+
+        Parameters
+        ----------
+        idx : int or 1-tuple of int
+            Index of the sphere, or the number of spheres for the space between
+            them
+
+        Returns
+        -------
+        openmc.UniverseBase
+            Universe filling the element
+
+        """
+        if isinstance(idx, Iterable):
+            idx = idx[0]
+        if idx == len(self._universes):
+            return self.outer
+        return self._universes[idx]
+
+    def is_valid_index(self, idx):
+        """Determine whether an index is that of a sphere
+
+        Parameters
+        ----------
+        idx : int
+            Element index
+
+        Returns
+        -------
+        bool
+            Whether the index is that of a sphere
+
+        """
+        return 0 <= idx < len(self._centers)
+
+    def find_element(self, point):
+        """Determine the element containing a point and its local coordinates
+
+        Parameters
+        ----------
+        point : Iterable of float
+            Cartesian coordinates of point
+
+        Returns
+        -------
+        int
+            Index of the sphere containing the point, or the number of spheres
+            if it is between them
+        3-tuple of float
+            Cartesian coordinates of the point relative to the center of the
+            sphere, or unchanged if it is between spheres
+
+        """
+        point = np.asarray(point, dtype=float)
+        dist2 = np.sum((self._centers - point)**2, axis=1)
+        idx = int(np.argmin(dist2))
+        if dist2[idx] < self._radius**2:
+            return idx, self.get_local_coordinates(point, idx)
+        return len(self._centers), tuple(point)
+
+    def get_local_coordinates(self, point, idx):
+        """Determine the coordinates of a point relative to a sphere
+
+        Parameters
+        ----------
+        point : Iterable of float
+            Cartesian coordinates of point
+        idx : int
+            Index of the sphere
+
+        Returns
+        -------
+        3-tuple of float
+            Cartesian coordinates of the point relative to the center of the
+            sphere
+
+        """
+        return tuple(np.asarray(point, dtype=float) - self._centers[idx])
+
+    def clone(self, clone_materials=True, clone_regions=True, memo=None):
+        """Create a copy of this sphere pack with a new unique ID, and clones
+        all universes within it.
+
+        Parameters
+        ----------
+        clone_materials : bool
+            Whether to create separate copies of the materials filling cells
+            contained in this sphere pack and its outer universe.
+        clone_regions : bool
+            Whether to create separate copies of the regions bounding cells
+            contained in this sphere pack and its outer universe.
+        memo : dict or None
+            A nested dictionary of previously cloned objects. This parameter
+            is used internally and should not be specified by the user.
+
+        Returns
+        -------
+        clone : openmc.SpherePack
+            The clone of this sphere pack
+
+        """
+        if memo is None:
+            memo = {}
+
+        if self not in memo:
+            clone = deepcopy(self)
+            clone.id = None
+            if self.outer is not None:
+                clone.outer = self.outer.clone(
+                    clone_materials, clone_regions, memo)
+            clone.universes = [u.clone(clone_materials, clone_regions, memo)
+                               for u in self.universes]
+            memo[self] = clone
+
+        return memo[self]
+
+    def create_xml_subelement(self, xml_element, memo=None):
+        # If this subelement has already been written, return
+        if memo is None:
+            memo = set()
+        elif self in memo:
+            return
+        memo.add(self)
+
+        if self._outer is None:
+            raise ValueError(
+                f"Sphere pack {self.id} does not have an outer universe.")
+        if self._universes is None or self._centers is None:
+            raise ValueError(
+                f"Sphere pack {self.id} does not have spheres assigned.")
+        if len(self._universes) != len(self._centers):
+            raise ValueError(
+                f"Sphere pack {self.id} has {len(self._centers)} spheres but "
+                f"{len(self._universes)} universes.")
+
+        subelement = ET.Element("sphere_pack")
+        subelement.set("id", str(self._id))
+        if len(self._name) > 0:
+            subelement.set("name", str(self._name))
+        subelement.set("radius", str(self._radius))
+
+        outer = ET.SubElement(subelement, "outer")
+        outer.text = str(self._outer._id)
+        self._outer.create_xml_subelement(xml_element, memo)
+
+        centers = ET.SubElement(subelement, "centers")
+        centers.text = '\n' + '\n'.join(
+            ' '.join(map(str, c)) for c in self._centers)
+
+        for universe in self._universes:
+            universe.create_xml_subelement(xml_element, memo)
+        universes = ET.SubElement(subelement, "universes")
+        universes.text = ' '.join(str(u._id) for u in self._universes)
+
+        # Append the XML subelement for this sphere pack to the XML element
+        xml_element.append(subelement)
+
+    @classmethod
+    def from_xml_element(cls, elem, get_universe):
+        """Generate sphere pack from XML element
+
+        Parameters
+        ----------
+        elem : lxml.etree._Element
+            `<sphere_pack>` element
+        get_universe : function
+            Function returning universe (defined in
+            :meth:`openmc.Geometry.from_xml`)
+
+        Returns
+        -------
+        SpherePack
+            Sphere pack
+
+        """
+        lat_id = int(get_text(elem, 'id'))
+        name = get_text(elem, 'name')
+        lat = cls(lat_id, name)
+        lat.radius = float(get_text(elem, 'radius'))
+        lat.outer = get_universe(int(get_text(elem, 'outer')))
+        centers = [float(x) for x in get_text(elem, 'centers').split()]
+        lat.centers = np.reshape(centers, (-1, 3))
+        lat.universes = [get_universe(int(i))
+                         for i in get_text(elem, 'universes').split()]
+        return lat
+
+    @classmethod
+    def from_hdf5(cls, group, universes):
+        """Create sphere pack from HDF5 group
+
+        Parameters
+        ----------
+        group : h5py.Group
+            Group in HDF5 file
+        universes : dict
+            Dictionary mapping universe IDs to instances of
+            :class:`openmc.UniverseBase`.
+
+        Returns
+        -------
+        openmc.SpherePack
+            Sphere pack
+
+        """
+        lattice_id = int(group.name.split('/')[-1].lstrip('lattice '))
+        name = group['name'][()].decode() if 'name' in group else ''
+        lattice = cls(lattice_id, name)
+        lattice.radius = float(group['radius'][()])
+        lattice.centers = group['centers'][()]
+        lattice.outer = universes[group['outer'][()]]
+        lattice.universes = [universes[u_id]
+                             for u_id in group['universes'][()]]
+        return lattice
@@ -52,6 +52,9 @@ def _libmesh_enabled():
 def _mcpl_enabled():
     return c_bool.in_dll(_dll, "MCPL_ENABLED").value
 
+def _adios2_enabled():
+    return c_bool.in_dll(_dll, "ADIOS2_ENABLED").value
+
 def _uwuw_enabled():
     return c_bool.in_dll(_dll, "UWUW_ENABLED").value
 
@@ -64,10 +67,13 @@ from .cell import *
 from .mesh import *
 from .filter import *
 from .tally import *
+from .reaction_rates import *
+from .majorant import *
 from .settings import settings
 from .math import *
 from .plot import *
 from .weight_windows import *
+from .ensemble import *
 
 # Flag to denote whether or not openmc.lib.init has been called
 # TODO: Establish and use a flag in the C++ code to represent the status of the
@@ -15,6 +15,9 @@ from openmc.checkvalue import PathLike
 import openmc.lib
 import openmc
 
+# Source sites passed to set_source_sites, which OpenMC samples in place
+_source_sites = None
+
 
 class _SourceSite(Structure):
     _fields_ = [('r', c_double*3),
@@ -59,7 +62,7 @@ _dll.openmc_initialize_mesh_egrid.argtypes = [
 ]
 _dll.openmc_initialize_mesh_egrid.restype = None
 _init_linsolver_argtypes = [_array_1d_int, c_int, _array_1d_int, c_int, c_int,
-                            c_double, _array_1d_int, c_bool]
+                            c_double, _array_1d_int, c_bool, c_int]
 _dll.openmc_initialize_linsolver.argtypes = _init_linsolver_argtypes
 _dll.openmc_initialize_linsolver.restype = None
 _dll.openmc_is_statepoint_batch.restype = c_bool
@@ -92,6 +95,9 @@ _dll.openmc_simulation_init.restype = c_int
 _dll.openmc_simulation_init.errcheck = _error_handler
 _dll.openmc_simulation_finalize.restype = c_int
 _dll.openmc_simulation_finalize.errcheck = _error_handler
+_dll.openmc_simulation_set_persistent.argtypes = [c_bool]
+_dll.openmc_simulation_set_persistent.restype = c_int
+_dll.openmc_simulation_set_persistent.errcheck = _error_handler
 _dll.openmc_statepoint_write.argtypes = [c_char_p, POINTER(c_bool)]
 _dll.openmc_statepoint_write.restype = c_int
 _dll.openmc_statepoint_write.errcheck = _error_handler
@@ -107,6 +113,9 @@ _dll.openmc_global_bounding_box.errcheck = _error_handler
 _dll.openmc_sample_external_source.argtypes = [c_size_t, POINTER(c_uint64), POINTER(_SourceSite)]
 _dll.openmc_sample_external_source.restype = c_int
 _dll.openmc_sample_external_source.errcheck = _error_handler
+_dll.openmc_set_source_sites.argtypes = [c_void_p, c_int64, c_double]
+_dll.openmc_set_source_sites.restype = c_int
+_dll.openmc_set_source_sites.errcheck = _error_handler
 
 def global_bounding_box():
     """Calculate a global bounding box for the model"""
@@ -513,6 +522,41 @@ def sample_external_source(n_samples=1, prn_seed=None):
     ]
 
 
+def set_source_sites(sites, strength=1.0):
+    """Replace the external sources with source sites held in memory
+
+    The sites are sampled in place without being copied or written to a file.
+    They are used until the sources are replaced again or OpenMC is finalized.
+    In an eigenvalue calculation, the initial source is sampled by
+    :func:`simulation_init`.
+
+    .. versionadded:: 0.15.1
+
+    Parameters
+    ----------
+    sites : numpy.ndarray or iterable of openmc.SourceParticle
+        Source sites. An array with the datatype of :func:`source_bank` is
+        used directly; other sites are first converted to such an array.
+    strength : float
+        Source strength
+
+    """
+    bank_dtype = np.dtype(_SourceSite)
+    if not (isinstance(sites, np.ndarray) and sites.dtype == bank_dtype
+            and sites.flags.c_contiguous):
+        particles = list(sites)
+        sites = np.zeros(len(particles), dtype=bank_dtype)
+        for i, p in enumerate(particles):
+            sites[i] = (p.r, p.u, p.E, p.time, p.wgt, p.delayed_group,
+                        p.surf_id, int(p.particle), 0, 0)
+
+    _dll.openmc_set_source_sites(sites.ctypes.data, len(sites), strength)
+
+    # Keep the sites alive while OpenMC samples from them
+    global _source_sites
+    _source_sites = sites
+
+
 def simulation_init():
     """Initialize simulation"""
     _dll.openmc_simulation_init()
@@ -523,6 +567,29 @@ def simulation_finalize():
     _dll.openmc_simulation_finalize()
 
 
+def simulation_set_persistent(persistent=True):
+    """Keep the fission source between eigenvalue simulations
+
+    When on, the source bank at the end of each simulation is used as the
+    initial source of the next one instead of sampling the external sources
+    again, as long as each process transports the same number of particles.
+    This is meant for calculations that rerun transport after small changes to
+    the model, such as the steps of a depletion calculation, where the source
+    of the previous step is already close to convergence. The number of
+    inactive batches of such simulations is controlled by
+    :attr:`openmc.Settings.warm_start`, which also turns this on.
+
+    .. versionadded:: 0.15.1
+
+    Parameters
+    ----------
+    persistent : bool
+        Whether the source is kept
+
+    """
+    _dll.openmc_simulation_set_persistent(persistent)
+
+
 def source_bank():
     """Return source bank as NumPy array
 
@@ -0,0 +1,125 @@
+import os
+from pathlib import Path
+
+import openmc.lib
+from openmc.utility_funcs import change_directory
+from .core import finalize, hard_reset, init, master, run
+from .settings import settings
+
+__all__ = ['run_ensemble']
+
+
+def _apply_variant(variant):
+    """Change the materials, temperatures, and seed of the model in memory
+
+    Returns
+    -------
+    list of callable
+        Functions that restore the properties that were changed
+
+    """
+    restore = []
+
+    # Material densities are kept in atom/b-cm so that the composition of each
+    # material can be restored exactly
+    densities = variant.get('densities', {})
+    nuclide_densities = variant.get('nuclide_densities', {})
+    for mat_id in set(densities) | set(nuclide_densities):
+        mat = openmc.lib.materials[mat_id]
+        nuclides, values = mat.nuclides, mat.densities.copy()
+        restore.append(lambda m=mat, n=nuclides, d=values:
+                       m.set_densities(n, d))
+        if mat_id in nuclide_densities:
+            composition = nuclide_densities[mat_id]
+            mat.set_densities(list(composition), list(composition.values()))
+        if mat_id in densities:
+            mat.set_density(densities[mat_id], 'g/cm3')
+
+    for cell_id, T in variant.get('temperatures', {}).items():
+        cell = openmc.lib.cells[cell_id]
+        values = [cell.get_temperature(i) for i in range(cell.num_instances)]
+        restore.append(lambda c=cell, v=values:
+                       [c.set_temperature(t, i) for i, t in enumerate(v)])
+        cell.set_temperature(T)
+
+    return restore
+
+
+def run_ensemble(variants, groups=1, intracomm=None, args=None, output=True):
+    """Run independent variants of the model in the working directory
+
+    The model is initialized once in each process, so the nuclear data are
+    read once and shared by all the variants that the process runs. With
+    several groups, the processes of *intracomm* are split into groups that
+    each run every *groups*-th variant in a subdirectory of their own. Each
+    variant starts from fresh tallies and its final statepoint is moved to
+    ``statepoint.variant<i>.h5`` in the working directory.
+
+    .. versionadded:: 0.15.1
+
+    Parameters
+    ----------
+    variants : iterable of dict
+        Changes made to the model for each variant, which may have the keys
+        'seed' (int), 'densities' (dict mapping material IDs to densities in
+        [g/cm3]), 'nuclide_densities' (dict mapping material IDs to dicts of
+        nuclide densities in [atom/b-cm]), and 'temperatures' (dict mapping
+        cell IDs to temperatures in [K]). The changes of one variant are undone
+        before the next one is run.
+    groups : int, optional
+        Number of groups of processes that run variants concurrently
+    intracomm : mpi4py.MPI.Intracomm or None, optional
+        MPI intracommunicator split into *groups* groups
+    args : list of str, optional
+        Additional command-line arguments passed to :func:`init`
+    output : bool, optional
+        Whether or not to show output
+
+    Returns
+    -------
+    list of pathlib.Path
+        Paths of the statepoints of all the variants
+
+    """
+    variants = list(variants)
+    cwd = Path.cwd()
+    paths = [cwd / f'statepoint.variant{i}.h5' for i in range(len(variants))]
+
+    group = 0
+    comm = intracomm
+    if groups > 1:
+        if intracomm is None:
+            raise ValueError('An MPI intracommunicator is needed to run '
+                             'variants in several groups.')
+        if groups > intracomm.size:
+            raise ValueError(f'Cannot split {intracomm.size} processes into '
+                             f'{groups} groups.')
+        group = intracomm.rank * groups // intracomm.size
+        comm = intracomm.Split(group, intracomm.rank)
+
+    # Groups write their files in separate directories so that the statepoints
+    # of the variants they run at the same time do not collide
+    directory = cwd / f'ensemble_group{group}' if groups > 1 else cwd
+    directory.mkdir(exist_ok=True)
+    args = list(args or []) + [str(cwd)]
+
+    with change_directory(directory):
+        init(args, intracomm=comm, output=output)
+        try:
+            seed = settings.seed
+            for i in range(group, len(variants), groups):
+                restore = _apply_variant(variants[i])
+                hard_reset()
+                settings.seed = variants[i].get('seed', seed)
+                run(output)
+                if master():
+                    os.replace(settings.path_statepoint, paths[i])
+                for func in restore:
+                    func()
+        finally:
+            finalize()
+
+    if groups > 1:
+        comm.Free()
+        intracomm.Barrier()
+    return paths
@@ -19,7 +19,8 @@ from .mesh import _get_mesh
 __all__ = [
     'Filter', 'AzimuthalFilter', 'CellFilter', 'CellbornFilter', 'CellfromFilter',
     'CellInstanceFilter', 'CollisionFilter', 'DistribcellFilter', 'DelayedGroupFilter',
-    'EnergyFilter', 'EnergyoutFilter', 'EnergyFunctionFilter', 'LegendreFilter',
+    'EnergyFilter', 'EnergyoutFilter', 'EnergyFunctionFilter',
+    'EnergyResponseFilter', 'LegendreFilter',
     'MaterialFilter', 'MaterialFromFilter', 'MeshFilter', 'MeshBornFilter',
     'MeshSurfaceFilter', 'MuFilter', 'ParticleFilter',
     'PolarFilter', 'SphericalHarmonicsFilter', 'SpatialLegendreFilter', 'SurfaceFilter',
@@ -319,6 +320,10 @@ class EnergyFunctionFilter(Filter):
         return as_array(array_p, (n.value, ))
 
 
+class EnergyResponseFilter(Filter):
+    filter_type = 'energyresponse'
+
+
 class LegendreFilter(Filter):
     filter_type = 'legendre'
 
@@ -635,6 +640,7 @@ _FILTER_TYPE_MAP = {
     'energy': EnergyFilter,
     'energyout': EnergyoutFilter,
     'energyfunction': EnergyFunctionFilter,
+    'energyresponse': EnergyResponseFilter,
     'legendre': LegendreFilter,
     'material': MaterialFilter,
     'materialfrom': MaterialFromFilter,
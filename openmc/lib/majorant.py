@@ -0,0 +1,93 @@
+from ctypes import c_double, c_int, c_int32, POINTER
+
+import numpy as np
+from numpy.ctypeslib import as_array
+
+from . import _dll
+from .error import _error_handler
+
+
+__all__ = ['Majorant']
+
+_array_1d_int32 = np.ctypeslib.ndpointer(
+    dtype=np.int32, ndim=1, flags='CONTIGUOUS')
+
+_dll.openmc_majorant_create.argtypes = [
+    c_int, _array_1d_int32, POINTER(c_int32)]
+_dll.openmc_majorant_create.restype = c_int
+_dll.openmc_majorant_create.errcheck = _error_handler
+_dll.openmc_majorant_evaluate.argtypes = [c_int32, c_double, POINTER(c_double)]
+_dll.openmc_majorant_evaluate.restype = c_int
+_dll.openmc_majorant_evaluate.errcheck = _error_handler
+_dll.openmc_majorant_get_xs.argtypes = [
+    c_int32, POINTER(POINTER(c_double)), POINTER(c_int), POINTER(c_double),
+    POINTER(c_double)]
+_dll.openmc_majorant_get_xs.restype = c_int
+_dll.openmc_majorant_get_xs.errcheck = _error_handler
+
+
+class Majorant:
+    """Majorant total cross section of a set of materials.
+
+    The majorant is an upper bound on the macroscopic total cross section of
+    every material in the set, at all temperatures of the loaded data, in each
+    bin of the logarithmic energy grid used for cross section lookups. It can
+    only be built once a continuous-energy simulation has been initialized and
+    remains valid until the next initialization.
+
+    .. versionadded:: 0.15.1
+
+    Parameters
+    ----------
+    materials : iterable of openmc.lib.Material
+        Materials to bound the total cross section of
+
+    Attributes
+    ----------
+    energy : numpy.ndarray
+        Boundaries of the energy bins in [eV]
+    xs : numpy.ndarray
+        Majorant cross section in each energy bin in [1/cm]
+
+    """
+
+    def __init__(self, materials):
+        indices = np.array([m._index for m in materials], dtype=np.int32)
+        index = c_int32()
+        _dll.openmc_majorant_create(len(indices), indices, index)
+        self._index = index.value
+
+    def __call__(self, E):
+        """Evaluate the majorant cross section.
+
+        Parameters
+        ----------
+        E : float
+            Neutron energy in [eV]
+
+        Returns
+        -------
+        float
+            Majorant cross section in [1/cm]
+
+        """
+        xs = c_double()
+        _dll.openmc_majorant_evaluate(self._index, E, xs)
+        return xs.value
+
+    def _get_xs(self):
+        xs = POINTER(c_double)()
+        n = c_int()
+        energy_min = c_double()
+        energy_max = c_double()
+        _dll.openmc_majorant_get_xs(self._index, xs, n, energy_min, energy_max)
+        return as_array(xs, (n.value,)), energy_min.value, energy_max.value
+
+    @property
+    def energy(self):
+        xs, energy_min, energy_max = self._get_xs()
+        return np.geomspace(energy_min, energy_max, xs.size + 1)
+
+    @property
+    def xs(self):
+        return self._get_xs()[0].copy()
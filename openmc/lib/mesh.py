@@ -18,7 +18,7 @@ from ..bounding_box import BoundingBox
 
 __all__ = [
     'Mesh', 'RegularMesh', 'RectilinearMesh', 'CylindricalMesh',
-    'SphericalMesh', 'UnstructuredMesh', 'meshes'
+    'SphericalMesh', 'UnstructuredMesh', 'OctreeMesh', 'meshes'
 ]
 
 
@@ -46,6 +46,10 @@ _dll.openmc_mesh_get_n_elements.errcheck = _error_handler
 _dll.openmc_mesh_get_volumes.argtypes = [c_int32, POINTER(c_double)]
 _dll.openmc_mesh_get_volumes.restype = c_int
 _dll.openmc_mesh_get_volumes.errcheck = _error_handler
+_dll.openmc_mesh_get_bins.argtypes = [
+    c_int32, c_size_t, POINTER(c_double), POINTER(c_int)]
+_dll.openmc_mesh_get_bins.restype = c_int
+_dll.openmc_mesh_get_bins.errcheck = _error_handler
 _dll.openmc_mesh_bounding_box.argtypes = [
     c_int32, POINTER(c_double), POINTER(c_double)]
 _dll.openmc_mesh_bounding_box.restype = c_int
@@ -55,6 +59,11 @@ _dll.openmc_mesh_material_volumes.argtypes = [
     POINTER(c_int), POINTER(c_uint64)]
 _dll.openmc_mesh_material_volumes.restype = c_int
 _dll.openmc_mesh_material_volumes.errcheck = _error_handler
+_dll.openmc_mesh_traced_material_volumes.argtypes = [
+    c_int32, POINTER(c_int), c_int, POINTER(c_int), POINTER(c_int32),
+    POINTER(c_double)]
+_dll.openmc_mesh_traced_material_volumes.restype = c_int
+_dll.openmc_mesh_traced_material_volumes.errcheck = _error_handler
 _dll.openmc_mesh_get_plot_bins.argtypes = [
     c_int32, _Position, _Position, c_int, POINTER(c_int), POINTER(c_int32)
 ]
@@ -172,6 +181,30 @@ class Mesh(_FortranObjectWithID):
             self._index, volumes.ctypes.data_as(POINTER(c_double)))
         return volumes
 
+    def get_bins(self, points) -> np.ndarray:
+        """Get the mesh bins of a set of points
+
+        .. versionadded:: 0.15.1
+
+        Parameters
+        ----------
+        points : numpy.ndarray
+            Coordinates of the points with shape (n_points, 3)
+
+        Returns
+        -------
+        numpy.ndarray
+            Mesh bin of each point, or -1 for points outside of the mesh
+
+        """
+        points = np.ascontiguousarray(points, dtype=float).reshape((-1, 3))
+        bins = np.empty(points.shape[0], dtype=np.intc)
+        _dll.openmc_mesh_get_bins(
+            self._index, points.shape[0],
+            points.ctypes.data_as(POINTER(c_double)),
+            bins.ctypes.data_as(POINTER(c_int)))
+        return bins
+
     @property
     def bounding_box(self) -> BoundingBox:
         inf = sys.float_info.max
@@ -243,6 +276,58 @@ class Mesh(_FortranObjectWithID):
             ])
         return volumes
 
+    def traced_material_volumes(
+            self,
+            n_rays: Sequence[int] = (100, 100, 100)
+    ) -> list[list[tuple[Material, float]]]:
+        """Determine volume of materials in each mesh element by ray tracing
+
+        Rays are traced along each axis from a uniform grid over the bounding
+        box of the mesh, and the exact length of each ray in each material
+        within an element gives its material volumes. All elements are
+        computed at once, in parallel over the rays.
+
+        .. versionadded:: 0.15.1
+
+        Parameters
+        ----------
+        n_rays : iterable of int
+            Number of rays across the bounding box of the mesh in the x, y,
+            and z directions
+
+        Returns
+        -------
+        List of tuple of (material, volume) for each mesh element. Void volume
+        is represented by having a value of None in the first element of a
+        tuple.
+
+        """
+        n_rays = (c_int * 3)(*n_rays)
+        n_elements = self.n_elements
+        n_materials = np.zeros(n_elements, dtype=np.intc)
+
+        max_materials = 8
+        while True:
+            materials = np.zeros((n_elements, max_materials), dtype=np.int32)
+            volumes = np.zeros((n_elements, max_materials))
+            try:
+                _dll.openmc_mesh_traced_material_volumes(
+                    self._index, n_rays, max_materials,
+                    n_materials.ctypes.data_as(POINTER(c_int)),
+                    materials.ctypes.data_as(POINTER(c_int32)),
+                    volumes.ctypes.data_as(POINTER(c_double)))
+            except AllocationError:
+                # Retry with enough space for every element
+                max_materials = int(n_materials.max())
+            else:
+                break
+
+        return [
+            [(Material(index=int(materials[i, j])), float(volumes[i, j]))
+             for j in range(n_materials[i])]
+            for i in range(n_elements)
+        ]
+
     def get_plot_bins(
             self,
             origin: Sequence[float],
@@ -693,12 +778,17 @@ class UnstructuredMesh(Mesh):
     pass
 
 
+class OctreeMesh(Mesh):
+    pass
+
+
 _MESH_TYPE_MAP = {
     'regular': RegularMesh,
     'rectilinear': RectilinearMesh,
     'cylindrical': CylindricalMesh,
     'spherical': SphericalMesh,
-    'unstructured': UnstructuredMesh
+    'unstructured': UnstructuredMesh,
+    'octree': OctreeMesh
 }
 
 
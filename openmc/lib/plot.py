@@ -1,5 +1,9 @@
+from collections import OrderedDict
+from concurrent.futures import Future, ThreadPoolExecutor
 from ctypes import (c_bool, c_int, c_size_t, c_int32,
                     c_double, Structure, POINTER)
+from math import ceil
+from threading import Lock
 
 from . import _dll
 from .error import _error_handler
@@ -263,3 +267,230 @@ def property_map(plot):
     prop_data = np.zeros((plot.v_res, plot.h_res, 2))
     _dll.openmc_property_map(plot, prop_data.ctypes.data_as(POINTER(c_double)))
     return prop_data
+
+
+def _tile_plot(view, tile_size, i, j, level):
+    """Create the slice plot covering a tile of a view.
+
+    The tile spans pixel columns [i*tile_size, (i+1)*tile_size) and rows
+    [j*tile_size, (j+1)*tile_size) of the view, clipped to its resolution,
+    with each pixel at the given level covering 2**level pixels of the view
+    along each axis.
+
+    """
+    c0 = i*tile_size
+    c1 = min(c0 + tile_size, view.h_res)
+    r0 = j*tile_size
+    r1 = min(r0 + tile_size, view.v_res)
+    if c0 >= c1 or r0 >= r1:
+        raise ValueError(f"Tile ({i}, {j}) is outside of the view.")
+
+    dh = view.width / view.h_res
+    dv = view.height / view.v_res
+    h, v = {'xy': (0, 1), 'xz': (0, 2), 'yz': (1, 2)}[view.basis]
+    origin = list(view.origin)
+    origin[h] += (0.5*(c0 + c1) - 0.5*view.h_res)*dh
+    origin[v] -= (0.5*(r0 + r1) - 0.5*view.v_res)*dv
+
+    factor = 2**level
+    plot = _PlotBase()
+    plot.origin = origin
+    plot.width = (c1 - c0)*dh
+    plot.height = (r1 - r0)*dv
+    plot.basis = view.basis
+    plot.h_res = ceil((c1 - c0) / factor)
+    plot.v_res = ceil((r1 - r0) / factor)
+    plot.level = view.level
+    plot.color_overlaps = view.color_overlaps
+    return plot, (r1 - r0, c1 - c0)
+
+
+class TileMapper:
+    """Asynchronous, cached id or property maps of tiles of a slice plot.
+
+    A view of the model, described by a slice plot, is divided into square
+    tiles of pixels that are generated on a pool of threads so that an
+    interactive plotter can display tiles as they complete. Tiles can be
+    requested at coarse levels, where each generated pixel covers 2**level
+    pixels of the view along each axis, to show an approximate image quickly
+    before it is refined. Finished tiles are cached by the parameters of the
+    view so that panning back over a region does not generate it again.
+
+    Each tile is generated by :func:`id_map` or :func:`property_map`, which
+    are themselves parallelized over the OpenMP threads of the library, so a
+    small number of workers is usually sufficient.
+
+    .. versionadded:: 0.15.1
+
+    Parameters
+    ----------
+    properties : bool
+        Whether to generate property maps rather than id maps
+    tile_size : int
+        Number of pixels along each side of a tile
+    max_workers : int
+        Number of threads generating tiles
+    cache_size : int
+        Maximum number of finished tiles kept in the cache
+
+    """
+
+    def __init__(self, properties=False, tile_size=256, max_workers=1,
+                 cache_size=1024):
+        if tile_size < 1:
+            raise ValueError("Tile size must be positive.")
+        self.properties = properties
+        self.tile_size = tile_size
+        self.cache_size = cache_size
+        self._executor = ThreadPoolExecutor(max_workers=max_workers)
+        self._cache = OrderedDict()
+        self._pending = {}
+        self._lock = Lock()
+
+    @staticmethod
+    def _view_key(view):
+        return (view.basis, tuple(view.origin), view.width, view.height,
+                view.h_res, view.v_res, view.level, bool(view.color_overlaps))
+
+    def n_tiles(self, view):
+        """Number of tiles covering a view.
+
+        Parameters
+        ----------
+        view : openmc.lib.plot._PlotBase
+            Object describing the full slice of the model
+
+        Returns
+        -------
+        tuple of int
+            Number of tiles along the horizontal and vertical axes
+
+        """
+        return (ceil(view.h_res / self.tile_size),
+                ceil(view.v_res / self.tile_size))
+
+    def _generate(self, key, plot, shape, factor):
+        if self.properties:
+            data = property_map(plot)
+        else:
+            data = id_map(plot)
+        if factor > 1:
+            data = np.repeat(np.repeat(data, factor, axis=0), factor, axis=1)
+            data = data[:shape[0], :shape[1]]
+
+        with self._lock:
+            self._pending.pop(key, None)
+            self._cache[key] = data
+            self._cache.move_to_end(key)
+            while len(self._cache) > self.cache_size:
+                self._cache.popitem(last=False)
+        return data
+
+    def request(self, view, i, j, level=0):
+        """Request a tile of a view.
+
+        Parameters
+        ----------
+        view : openmc.lib.plot._PlotBase
+            Object describing the full slice of the model
+        i : int
+            Horizontal index of the tile, starting from the left of the view
+        j : int
+            Vertical index of the tile, starting from the top of the view
+        level : int
+            Refinement level of the tile. Each generated pixel covers 2**level
+            pixels of the view along each axis.
+
+        Returns
+        -------
+        concurrent.futures.Future
+            Future whose result is the map of the tile with the same layout as
+            :func:`id_map` or :func:`property_map`. Coarse tiles are expanded
+            to the full resolution of the view.
+
+        """
+        key = (self._view_key(view), self.tile_size, i, j, level)
+        with self._lock:
+            if key in self._cache:
+                self._cache.move_to_end(key)
+                future = Future()
+                future.set_result(self._cache[key])
+                return future
+            if key in self._pending:
+                return self._pending[key]
+
+            # The tile has its own plot, so the view can be modified by the
+            # caller while the tile is queued
+            plot, shape = _tile_plot(view, self.tile_size, i, j, level)
+            future = self._executor.submit(
+                self._generate, key, plot, shape, 2**level)
+            self._pending[key] = future
+            return future
+
+    def request_progressive(self, view, i, j, levels=3, callback=None):
+        """Request a tile of a view from coarse to fine refinement levels.
+
+        Parameters
+        ----------
+        view : openmc.lib.plot._PlotBase
+            Object describing the full slice of the model
+        i : int
+            Horizontal index of the tile, starting from the left of the view
+        j : int
+            Vertical index of the tile, starting from the top of the view
+        levels : int
+            Number of coarse levels requested before the full resolution
+        callback : callable, optional
+            Function called with the map of the tile and its level as each
+            level finishes. It is called from a worker thread.
+
+        Returns
+        -------
+        list of concurrent.futures.Future
+            Futures of each level, from the coarsest to the full resolution
+
+        """
+        futures = []
+        for level in range(levels, -1, -1):
+            future = self.request(view, i, j, level)
+            if callback is not None:
+                def done(f, level=level):
+                    if not f.cancelled():
+                        callback(f.result(), level)
+                future.add_done_callback(done)
+            futures.append(future)
+        return futures
+
+    def cancel(self, view=None):
+        """Cancel requests that have not started.
+
+        Parameters
+        ----------
+        view : openmc.lib.plot._PlotBase, optional
+            If given, requests for this view are kept and requests for any
+            other view, which are stale once the plotter has moved on, are
+            cancelled. Otherwise all requests are cancelled.
+
+        """
+        keep = None if view is None else self._view_key(view)
+        with self._lock:
+            for key, future in list(self._pending.items()):
+                if key[0] != keep and future.cancel():
+                    del self._pending[key]
+
+    def clear_cache(self):
+        """Remove all finished tiles from the cache."""
+        with self._lock:
+            self._cache.clear()
+
+    def shutdown(self, wait=True):
+        """Cancel pending requests and stop the worker threads.
+
+        Parameters
+        ----------
+        wait : bool
+            Whether to wait for tiles being generated to finish
+
+        """
+        self.cancel()
+        self._executor.shutdown(wait=wait)
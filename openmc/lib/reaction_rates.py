@@ -0,0 +1,128 @@
+from ctypes import c_int
+
+import numpy as np
+from numpy.ctypeslib import ndpointer
+
+from openmc.data.reaction import REACTION_MT
+from ..exceptions import AllocationError
+from . import _dll
+from .error import _error_handler
+from .material import Material
+from .nuclide import nuclides as _nuclides
+
+
+__all__ = ['set_reaction_rates', 'reaction_rates', 'reaction_rate_flux',
+           'clear_reaction_rates']
+
+_array_1d_int32 = ndpointer(dtype=np.int32, ndim=1, flags='CONTIGUOUS')
+_array_1d_dble = ndpointer(dtype=np.double, ndim=1, flags='CONTIGUOUS')
+
+# Reaction rate functions
+_dll.openmc_reaction_rates_set.argtypes = [
+    c_int, _array_1d_int32, c_int, _array_1d_int32, c_int, _array_1d_int32,
+    c_int, _array_1d_dble]
+_dll.openmc_reaction_rates_set.restype = c_int
+_dll.openmc_reaction_rates_set.errcheck = _error_handler
+_dll.openmc_reaction_rates_get.argtypes = [_array_1d_dble]
+_dll.openmc_reaction_rates_get.restype = c_int
+_dll.openmc_reaction_rates_get.errcheck = _error_handler
+_dll.openmc_reaction_rates_flux.argtypes = [_array_1d_dble]
+_dll.openmc_reaction_rates_flux.restype = c_int
+_dll.openmc_reaction_rates_flux.errcheck = _error_handler
+_dll.openmc_reaction_rates_clear.restype = c_int
+_dll.openmc_reaction_rates_clear.errcheck = _error_handler
+
+# Number of materials, nuclides, reactions, and energy groups
+_shape = None
+
+
+def set_reaction_rates(materials, nuclides, reactions, energies=None):
+    """Accumulate reaction rates during active batches without a tally.
+
+    Without energy group boundaries, rates are accumulated from the
+    microscopic cross sections calculated during transport. This is only
+    possible for fission, (n,gamma), (n,p), (n,a), (n,2n), (n,3n), and (n,4n),
+    and only nuclides present in a material contribute to its rates. With
+    energy group boundaries, only the group-wise flux in each material is
+    accumulated and reaction rates are found by collapsing cross sections
+    with it.
+
+    .. versionadded:: 0.15.1
+
+    Parameters
+    ----------
+    materials : iterable of openmc.lib.Material
+        Materials to accumulate reaction rates in
+    nuclides : iterable of str
+        Names of the nuclides
+    reactions : iterable of str or int
+        Reactions given by name, e.g. '(n,gamma)', or ENDF MT value
+    energies : iterable of float, optional
+        Energy group boundaries in [eV] used for flux collapse
+
+    """
+    global _shape
+    mat_indices = np.array([m._index for m in materials], dtype=np.int32)
+    nuc_indices = np.array([_nuclides[name]._index for name in nuclides],
+                           dtype=np.int32)
+    mts = np.array([REACTION_MT[rx] if isinstance(rx, str) else rx
+                    for rx in reactions], dtype=np.int32)
+    if energies is None:
+        energies = np.empty(0)
+    energies = np.asarray(energies, dtype=float)
+
+    _dll.openmc_reaction_rates_set(
+        len(mat_indices), mat_indices, len(nuc_indices), nuc_indices,
+        len(mts), mts, len(energies), energies)
+    n_groups = len(energies) - 1 if len(energies) > 0 else 1
+    _shape = (len(mat_indices), len(nuc_indices), len(mts), n_groups)
+
+
+def reaction_rates():
+    """Mean reaction rates per source particle.
+
+    .. versionadded:: 0.15.1
+
+    Returns
+    -------
+    numpy.ndarray
+        Microscopic reaction rates in [reactions-cm/source], not multiplied by
+        atom densities, indexed by (material, nuclide, reaction) in the order
+        passed to :func:`set_reaction_rates`
+
+    """
+    if _shape is None:
+        raise AllocationError("Reaction rates have not been set.")
+    rates = np.zeros(_shape[0] * _shape[1] * _shape[2])
+    _dll.openmc_reaction_rates_get(rates)
+    return rates.reshape(_shape[:3])
+
+
+def reaction_rate_flux():
+    """Mean flux per source particle in each material and energy group.
+
+    .. versionadded:: 0.15.1
+
+    Returns
+    -------
+    numpy.ndarray
+        Flux in [particle-cm/source] indexed by (material, energy group).
+        Without energy group boundaries, there is a single group.
+
+    """
+    if _shape is None:
+        raise AllocationError("Reaction rates have not been set.")
+    flux = np.zeros(_shape[0] * _shape[3])
+    _dll.openmc_reaction_rates_flux(flux)
+    return flux.reshape((_shape[0], _shape[3]))
+
+
+def clear_reaction_rates():
+    """Stop accumulating reaction rates.
+
+    .. versionadded:: 0.15.1
+
+    """
+    global _shape
+    _dll.openmc_reaction_rates_clear()
+    _shape = None
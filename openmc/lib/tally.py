@@ -53,6 +53,9 @@ _dll.openmc_tally_get_scores.argtypes = [
     c_int32, POINTER(POINTER(c_int)), POINTER(c_int)]
 _dll.openmc_tally_get_scores.restype = c_int
 _dll.openmc_tally_get_scores.errcheck = _error_handler
+_dll.openmc_tally_get_thread_private.argtypes = [c_int32, POINTER(c_bool)]
+_dll.openmc_tally_get_thread_private.restype = c_int
+_dll.openmc_tally_get_thread_private.errcheck = _error_handler
 _dll.openmc_tally_get_type.argtypes = [c_int32, POINTER(c_int32)]
 _dll.openmc_tally_get_type.restype = c_int
 _dll.openmc_tally_get_type.errcheck = _error_handler
@@ -87,6 +90,9 @@ _dll.openmc_tally_set_nuclides.errcheck = _error_handler
 _dll.openmc_tally_set_scores.argtypes = [c_int32, c_int, POINTER(c_char_p)]
 _dll.openmc_tally_set_scores.restype = c_int
 _dll.openmc_tally_set_scores.errcheck = _error_handler
+_dll.openmc_tally_set_thread_private.argtypes = [c_int32, c_bool]
+_dll.openmc_tally_set_thread_private.restype = c_int
+_dll.openmc_tally_set_thread_private.errcheck = _error_handler
 _dll.openmc_tally_set_type.argtypes = [c_int32, c_char_p]
 _dll.openmc_tally_set_type.restype = c_int
 _dll.openmc_tally_set_type.errcheck = _error_handler
@@ -192,6 +198,11 @@ class Tally(_FortranObjectWithID):
         Array of tally results
     std_dev : numpy.ndarray
         An array containing the sample standard deviation for each bin
+    thread_private : bool
+        Whether each thread scores into its own copy of the results, which
+        must be set before the simulation is initialized
+
+        .. versionadded:: 0.15.1
     type : str
         Type of tally (volume, mesh_surface, surface)
 
@@ -407,6 +418,16 @@ class Tally(_FortranObjectWithID):
     def multiply_density(self, multiply_density):
         _dll.openmc_tally_set_multiply_density(self._index, multiply_density)
 
+    @property
+    def thread_private(self):
+        thread_private = c_bool()
+        _dll.openmc_tally_get_thread_private(self._index, thread_private)
+        return thread_private.value
+
+    @thread_private.setter
+    def thread_private(self, thread_private):
+        _dll.openmc_tally_set_thread_private(self._index, thread_private)
+
     def reset(self):
         """Reset results and num_realizations of tally"""
         _dll.openmc_tally_reset(self._index)
@@ -3,6 +3,7 @@ import warnings
 from abc import ABC, abstractmethod
 from collections.abc import Iterable, Sequence
 from functools import wraps
+import hashlib
 from math import pi, sqrt, atan2
 from numbers import Integral, Real
 from pathlib import Path
@@ -110,6 +111,8 @@ class MeshBase(IDManagerMixin, ABC):
             return CylindricalMesh.from_hdf5(group)
         elif mesh_type == 'spherical':
             return SphericalMesh.from_hdf5(group)
+        elif mesh_type == 'octree':
+            return OctreeMesh.from_hdf5(group)
         elif mesh_type == 'unstructured':
             return UnstructuredMesh.from_hdf5(group)
         else:
@@ -140,46 +143,70 @@ class MeshBase(IDManagerMixin, ABC):
             return CylindricalMesh.from_xml_element(elem)
         elif mesh_type == 'spherical':
             return SphericalMesh.from_xml_element(elem)
+        elif mesh_type == 'octree':
+            return OctreeMesh.from_xml_element(elem)
         elif mesh_type == 'unstructured':
             return UnstructuredMesh.from_xml_element(elem)
         else:
             raise ValueError(f'Unrecognized mesh type "{mesh_type}" found.')
 
-    def get_homogenized_materials(
+    def material_volumes(
             self,
             model: openmc.Model,
             n_samples: int = 10_000,
             prn_seed: int | None = None,
-            include_void: bool = True,
+            n_rays: Sequence[int] | None = None,
+            cache_file: PathLike | None = None,
             **kwargs
-    ) -> list[openmc.Material]:
-        """Generate homogenized materials over each element in a mesh.
+    ) -> list[list[tuple[int | None, float]]]:
+        """Determine volume of materials in each element of the mesh.
 
-        .. versionadded:: 0.15.0
+        .. versionadded:: 0.15.1
 
         Parameters
         ----------
         model : openmc.Model
-            Model containing materials to be homogenized and the associated
-            geometry.
+            Model containing the geometry the mesh is laid over.
         n_samples : int
-            Number of samples in each mesh element.
+            Number of samples in each mesh element. Only used if `n_rays` is
+            None.
         prn_seed : int, optional
             Pseudorandom number generator (PRNG) seed; if None, one will be
-            generated randomly.
-        include_void : bool, optional
-            Whether homogenization should include voids.
+            generated randomly. Only used if `n_rays` is None.
+        n_rays : iterable of int, optional
+            Number of rays across the bounding box of the mesh in the x, y, and
+            z directions. If given, volumes are found for all elements at once
+            from the exact lengths of rays traced through the geometry instead
+            of by sampling points in each element.
+        cache_file : str or pathlib.Path, optional
+            HDF5 file in which ray-traced volumes are cached. Volumes are
+            stored under a hash of the geometry, the mesh, and `n_rays` and are
+            read back instead of being recomputed when the same hash is found.
+            Requires `n_rays`.
         **kwargs
             Keyword-arguments passed to :func:`openmc.lib.init`.
 
         Returns
         -------
-        list of openmc.Material
-            Homogenized material in each mesh element
+        list of list of tuple
+            (material ID, volume) pairs for each mesh element. Void volume is
+            represented by a material ID of None.
 
         """
         import openmc.lib
 
+        key = None
+        if cache_file is not None:
+            if n_rays is None:
+                raise ValueError('Only ray-traced material volumes can be '
+                                 'cached.')
+            cache_file = Path(cache_file).resolve()
+            key = self._material_volumes_key(model, n_rays)
+            if cache_file.exists():
+                with h5py.File(cache_file, 'r') as fh:
+                    if key in fh:
+                        return _read_material_volumes(fh[key])
+
         with change_directory(tmpdir=True):
             # In order to get mesh into model, we temporarily replace the
             # tallies with a single mesh tally using the current mesh
@@ -195,18 +222,90 @@ class MeshBase(IDManagerMixin, ABC):
             # Get material volume fractions
             openmc.lib.init(**kwargs)
             mesh = openmc.lib.tallies[new_tally.id].filters[0].mesh
+            if n_rays is None:
+                volumes = mesh.material_volumes(n_samples, prn_seed)
+            else:
+                volumes = mesh.traced_material_volumes(n_rays)
             mat_volume_by_element = [
                 [
                     (mat.id if mat is not None else None, volume)
                     for mat, volume in mat_volume_list
                 ]
-                for mat_volume_list in mesh.material_volumes(n_samples, prn_seed)
+                for mat_volume_list in volumes
             ]
             openmc.lib.finalize()
 
             # Restore original tallies
             model.tallies = original_tallies
 
+        if key is not None:
+            with h5py.File(cache_file, 'a') as fh:
+                _write_material_volumes(
+                    fh.create_group(key), mat_volume_by_element)
+
+        return mat_volume_by_element
+
+    def _material_volumes_key(self, model, n_rays):
+        """Hash identifying the ray-traced material volumes of the mesh"""
+        # The mesh ID does not change the volumes
+        mesh_elem = self.to_xml_element()
+        mesh_elem.attrib.pop('id', None)
+
+        hash_fun = hashlib.sha256()
+        hash_fun.update(ET.tostring(model.geometry.to_xml_element()))
+        hash_fun.update(ET.tostring(mesh_elem))
+        hash_fun.update(repr(tuple(int(n) for n in n_rays)).encode())
+        return hash_fun.hexdigest()
+
+    def get_homogenized_materials(
+            self,
+            model: openmc.Model,
+            n_samples: int = 10_000,
+            prn_seed: int | None = None,
+            include_void: bool = True,
+            n_rays: Sequence[int] | None = None,
+            cache_file: PathLike | None = None,
+            **kwargs
+    ) -> list[openmc.Material]:
+        """Generate homogenized materials over each element in a mesh.
+
+        .. versionadded:: 0.15.0
+
+        Parameters
+        ----------
+        model : openmc.Model
+            Model containing materials to be homogenized and the associated
+            geometry.
+        n_samples : int
+            Number of samples in each mesh element.
+        prn_seed : int, optional
+            Pseudorandom number generator (PRNG) seed; if None, one will be
+            generated randomly.
+        include_void : bool, optional
+            Whether homogenization should include voids.
+        n_rays : iterable of int, optional
+            Number of rays across the bounding box of the mesh in each
+            direction used to ray trace the material volumes. See
+            :meth:`MeshBase.material_volumes`.
+
+            .. versionadded:: 0.15.1
+        cache_file : str or pathlib.Path, optional
+            HDF5 file in which ray-traced material volumes are cached. See
+            :meth:`MeshBase.material_volumes`.
+
+            .. versionadded:: 0.15.1
+        **kwargs
+            Keyword-arguments passed to :func:`openmc.lib.init`.
+
+        Returns
+        -------
+        list of openmc.Material
+            Homogenized material in each mesh element
+
+        """
+        mat_volume_by_element = self.material_volumes(
+            model, n_samples, prn_seed, n_rays, cache_file, **kwargs)
+
         # Create homogenized material for each element
         materials = model.geometry.get_all_materials()
 
@@ -253,6 +352,33 @@ class MeshBase(IDManagerMixin, ABC):
         return homogenized_materials
 
 
+def _write_material_volumes(group, mat_volume_by_element):
+    """Write (material ID, volume) pairs of each mesh element to HDF5"""
+    n_materials = np.array([len(v) for v in mat_volume_by_element])
+    max_materials = max(n_materials, default=0)
+    materials = np.full((len(n_materials), max_materials), -1, dtype=np.int32)
+    volumes = np.zeros((len(n_materials), max_materials))
+    for i, mat_volume_list in enumerate(mat_volume_by_element):
+        for j, (mat_id, volume) in enumerate(mat_volume_list):
+            materials[i, j] = -1 if mat_id is None else mat_id
+            volumes[i, j] = volume
+    group.create_dataset('n_materials', data=n_materials)
+    group.create_dataset('materials', data=materials)
+    group.create_dataset('volumes', data=volumes)
+
+
+def _read_material_volumes(group):
+    """Read (material ID, volume) pairs of each mesh element from HDF5"""
+    n_materials = group['n_materials'][()]
+    materials = group['materials'][()]
+    volumes = group['volumes'][()]
+    return [
+        [(None if materials[i, j] == -1 else int(materials[i, j]),
+          float(volumes[i, j])) for j in range(n)]
+        for i, n in enumerate(n_materials)
+    ]
+
+
 class StructuredMesh(MeshBase):
     """A base class for structured mesh functionality
 
@@ -2051,6 +2177,479 @@ class SphericalMesh(StructuredMesh):
         return arr
 
 
+class OctreeMesh(MeshBase):
+    """A Cartesian mesh whose cells are recursively split into octants
+
+    The mesh starts from a regular grid of root cells, each of which may be
+    split into eight octants, which may in turn be split, wherever finer
+    resolution is needed. This avoids the many bins a regular mesh fine enough
+    for localized detail has elsewhere. Refinement can be given up front with
+    :meth:`refine` and :meth:`refine_region` or grown between simulations from
+    the statistics of a previous tally with :meth:`refine_by_error`.
+
+    .. versionadded:: 0.15.1
+
+    Parameters
+    ----------
+    root_dimension : Iterable of int
+        Number of root cells in each direction (x, y, z)
+    lower_left : Iterable of float
+        Lower-left corner of the mesh
+    upper_right : Iterable of float
+        Upper-right corner of the mesh
+    mesh_id : int
+        Unique identifier for the mesh
+    name : str
+        Name of the mesh
+
+    Attributes
+    ----------
+    id : int
+        Unique identifier for the mesh
+    name : str
+        Name of the mesh
+    root_dimension : Iterable of int
+        Number of root cells in each direction (x, y, z)
+    lower_left : numpy.ndarray
+        Lower-left corner of the mesh
+    upper_right : numpy.ndarray
+        Upper-right corner of the mesh
+    refinement : list of int
+        Preorder split flags of the root cells, which are ordered with x varying
+        fastest. Each cell has a flag of 1 if it is split, followed by the flags
+        of its eight octants ordered with x varying fastest, or 0 if it is an
+        element of the mesh. Elements are numbered in the order their flags
+        appear.
+    dimension : tuple of int
+        Number of mesh elements as a one-element tuple
+    n_dimension : int
+        Number of mesh dimensions, which is always 3
+    n_elements : int
+        Number of mesh elements
+    element_lower_left : numpy.ndarray
+        Lower-left corner of each element with shape (n_elements, 3)
+    element_upper_right : numpy.ndarray
+        Upper-right corner of each element with shape (n_elements, 3)
+    levels : numpy.ndarray
+        Number of times the root cell of each element was split to reach it
+    volumes : numpy.ndarray
+        Volume of each element
+    total_volume : float
+        Volume of the mesh
+    centroids : numpy.ndarray
+        Centroid of each element with shape (n_elements, 3)
+    indices : list of tuple
+        Index of each mesh element, e.g. [(0,), (1,), ...]
+    bounding_box : openmc.BoundingBox
+        Axis-aligned bounding box of the mesh as defined by the upper-right and
+        lower-left coordinates.
+
+    """
+
+    # Refinement is capped like it is when the mesh is read in OpenMC
+    _MAX_LEVEL = 20
+
+    def __init__(
+            self,
+            root_dimension: Sequence[int],
+            lower_left: Sequence[float],
+            upper_right: Sequence[float],
+            mesh_id: int | None = None,
+            name: str = ''
+    ):
+        super().__init__(mesh_id, name)
+        self.root_dimension = root_dimension
+        self.lower_left = lower_left
+        self.upper_right = upper_right
+        self._refinement = [0] * int(np.prod(self.root_dimension))
+        self._elements = None
+
+    @property
+    def root_dimension(self):
+        return self._root_dimension
+
+    @root_dimension.setter
+    def root_dimension(self, dimension: Sequence[int]):
+        cv.check_type('octree mesh root dimension', dimension, Iterable,
+                      Integral)
+        cv.check_length('octree mesh root dimension', dimension, 3)
+        for d in dimension:
+            cv.check_greater_than('octree mesh root dimension', d, 0)
+        self._root_dimension = tuple(int(d) for d in dimension)
+        self._refinement = [0] * int(np.prod(self._root_dimension))
+        self._elements = None
+
+    @property
+    def lower_left(self):
+        return self._lower_left
+
+    @lower_left.setter
+    def lower_left(self, lower_left: Sequence[float]):
+        cv.check_type('octree mesh lower_left', lower_left, Iterable, Real)
+        cv.check_length('octree mesh lower_left', lower_left, 3)
+        self._lower_left = np.array(lower_left, dtype=float)
+        self._elements = None
+
+    @property
+    def upper_right(self):
+        return self._upper_right
+
+    @upper_right.setter
+    def upper_right(self, upper_right: Sequence[float]):
+        cv.check_type('octree mesh upper_right', upper_right, Iterable, Real)
+        cv.check_length('octree mesh upper_right', upper_right, 3)
+        self._upper_right = np.array(upper_right, dtype=float)
+        self._elements = None
+
+    @property
+    def refinement(self):
+        return self._refinement
+
+    @refinement.setter
+    def refinement(self, refinement: Sequence[int]):
+        cv.check_type('octree mesh refinement', refinement, Iterable, Integral)
+        refinement = [int(flag) for flag in refinement]
+        for flag in refinement:
+            cv.check_value('octree mesh refinement flag', flag, (0, 1))
+        old = self._refinement
+        self._refinement = refinement
+        self._elements = None
+        try:
+            self._get_elements()
+        except ValueError:
+            self._refinement = old
+            self._elements = None
+            raise
+
+    @property
+    def dimension(self):
+        return (self.n_elements,)
+
+    @property
+    def n_dimension(self):
+        return 3
+
+    @property
+    def n_elements(self):
+        return self.refinement.count(0)
+
+    @property
+    def element_lower_left(self):
+        return self._get_elements()[0]
+
+    @property
+    def element_upper_right(self):
+        return self._get_elements()[1]
+
+    @property
+    def levels(self):
+        return self._get_elements()[2]
+
+    @property
+    def volumes(self):
+        return np.prod(self.element_upper_right - self.element_lower_left,
+                       axis=1)
+
+    @property
+    def total_volume(self):
+        return np.prod(self.upper_right - self.lower_left)
+
+    @property
+    def centroids(self):
+        return 0.5 * (self.element_lower_left + self.element_upper_right)
+
+    @property
+    def indices(self):
+        return [(i,) for i in range(self.n_elements)]
+
+    def __repr__(self):
+        string = super().__repr__()
+        string += '{0: <16}{1}{2}\n'.format('\tRoot cells', '=\t', self.root_dimension)
+        string += '{0: <16}{1}{2}\n'.format('\tElements', '=\t', self.n_elements)
+        string += '{0: <16}{1}{2}\n'.format('\tLower left', '=\t', self.lower_left)
+        string += '{0: <16}{1}{2}\n'.format('\tUpper Right', '=\t', self.upper_right)
+        return string
+
+    def _get_elements(self):
+        """Return the lower-left corner, upper-right corner, and level of each
+        element given by the refinement flags"""
+        if self._elements is not None:
+            return self._elements
+
+        width = (self.upper_right - self.lower_left) / self.root_dimension
+        octants = np.array([[(o >> i) & 1 for i in range(3)]
+                            for o in range(8)])
+        flags = iter(self.refinement)
+        lower = []
+        levels = []
+
+        # Visit cells in preorder using a stack of (corner, level) pairs
+        nx, ny, nz = self.root_dimension
+        for k in range(nz):
+            for j in range(ny):
+                for i in range(nx):
+                    stack = [(self.lower_left + (i, j, k)*width, 0)]
+                    while stack:
+                        corner, level = stack.pop()
+                        flag = next(flags, None)
+                        if flag is None:
+                            raise ValueError(
+                                'Octree mesh refinement ends before all cells '
+                                'are given.')
+                        if flag == 0:
+                            lower.append(corner)
+                            levels.append(level)
+                            continue
+                        if level == self._MAX_LEVEL:
+                            raise ValueError(
+                                'Cells of an octree mesh cannot be split more '
+                                f'than {self._MAX_LEVEL} times.')
+                        w = width / 2**(level + 1)
+                        for o in reversed(octants):
+                            stack.append((corner + o*w, level + 1))
+        if next(flags, None) is not None:
+            raise ValueError('Octree mesh refinement has more flags than '
+                             'cells.')
+
+        lower = np.array(lower).reshape((-1, 3))
+        levels = np.array(levels, dtype=int)
+        upper = lower + width / 2.0**levels[:, np.newaxis]
+        self._elements = (lower, upper, levels)
+        return self._elements
+
+    def refine(self, bins: Iterable[int]):
+        """Split elements into their eight octants
+
+        Elements are renumbered, so results of tallies on the mesh before it
+        was refined no longer apply to it.
+
+        Parameters
+        ----------
+        bins : Iterable of int
+            Indices of the elements to split
+
+        """
+        split = set(int(b) for b in bins)
+        for b in split:
+            cv.check_greater_than('octree mesh element', b, 0, True)
+            cv.check_less_than('octree mesh element', b, self.n_elements)
+
+        refinement = []
+        bin = 0
+        for flag in self.refinement:
+            if flag == 1:
+                refinement.append(1)
+                continue
+            if bin in split:
+                refinement.extend([1] + [0]*8)
+            else:
+                refinement.append(0)
+            bin += 1
+        self.refinement = refinement
+
+    def refine_region(self, bounding_box: openmc.BoundingBox, level: int):
+        """Split the elements overlapping a region until they reach a level
+
+        Parameters
+        ----------
+        bounding_box : openmc.BoundingBox
+            Region to refine
+        level : int
+            Number of times the root cells overlapping the region are split
+
+        """
+        cv.check_type('bounding box', bounding_box, openmc.BoundingBox)
+        cv.check_less_than('octree mesh level', level, self._MAX_LEVEL, True)
+        while True:
+            lower = self.element_lower_left
+            upper = self.element_upper_right
+            overlap = np.all((lower < bounding_box.upper_right) &
+                             (upper > bounding_box.lower_left), axis=1)
+            bins = np.flatnonzero(overlap & (self.levels < level))
+            if bins.size == 0:
+                break
+            self.refine(bins)
+
+    def refine_by_error(
+            self,
+            mean: Sequence[float],
+            std_dev: Sequence[float],
+            max_rel_err: float,
+            max_level: int | None = None
+    ) -> int:
+        """Split elements whose tally result is well converged
+
+        Elements with a relative error at most a threshold have enough scores
+        to resolve finer detail, so refining them between simulations grows the
+        mesh where the tallied quantity is concentrated. Elements with no score
+        are never split.
+
+        Parameters
+        ----------
+        mean : Iterable of float
+            Mean of the tally in each element from a previous simulation using
+            this mesh
+        std_dev : Iterable of float
+            Standard deviation of the mean in each element
+        max_rel_err : float
+            Largest relative error of an element that is split
+        max_level : int, optional
+            Number of times a root cell can be split at most
+
+        Returns
+        -------
+        int
+            Number of elements that were split
+
+        """
+        mean = np.ravel(mean)
+        std_dev = np.ravel(std_dev)
+        if mean.size != self.n_elements or std_dev.size != self.n_elements:
+            raise ValueError(
+                f'Tally results have {mean.size} values but octree mesh '
+                f'{self.id} has {self.n_elements} elements.')
+        cv.check_greater_than('maximum relative error', max_rel_err, 0.0)
+        if max_level is None:
+            max_level = self._MAX_LEVEL
+        cv.check_less_than('octree mesh level', max_level, self._MAX_LEVEL,
+                           True)
+
+        rel_err = np.full(mean.shape, np.inf)
+        scored = mean > 0.0
+        rel_err[scored] = std_dev[scored] / mean[scored]
+        bins = np.flatnonzero((rel_err <= max_rel_err) &
+                              (self.levels < max_level))
+        self.refine(bins)
+        return bins.size
+
+    def write_data_to_vtk(
+            self,
+            filename: PathLike | None = None,
+            datasets: dict | None = None,
+            volume_normalization: bool = True
+    ):
+        """Map data to the mesh elements as VTK voxels
+
+        Parameters
+        ----------
+        filename : str or pathlib.Path
+            Name of the VTK file to write
+        datasets : dict
+            Dictionary whose keys are the data labels and values are numpy
+            arrays with a value for each mesh element
+        volume_normalization : bool
+            Whether or not to normalize the data by the volume of the mesh
+            elements
+
+        """
+        import vtk
+        from vtk.util import numpy_support as nps
+
+        if filename is None:
+            filename = f'mesh_{self.id}.vtk'
+
+        # Each voxel has its own eight corners ordered with x varying fastest
+        lower = self.element_lower_left
+        upper = self.element_upper_right
+        octants = np.array([[(o >> i) & 1 for i in range(3)]
+                            for o in range(8)])
+        corners = lower[:, np.newaxis, :] + \
+            octants[np.newaxis, :, :] * (upper - lower)[:, np.newaxis, :]
+
+        grid = vtk.vtkUnstructuredGrid()
+        vtk_pnts = vtk.vtkPoints()
+        vtk_pnts.SetData(nps.numpy_to_vtk(corners.reshape((-1, 3)), deep=True))
+        grid.SetPoints(vtk_pnts)
+        voxel = vtk.vtkVoxel()
+        for i in range(self.n_elements):
+            for j in range(8):
+                voxel.GetPointIds().SetId(j, 8*i + j)
+            grid.InsertNextCell(voxel.GetCellType(), voxel.GetPointIds())
+
+        if datasets is not None:
+            volumes = self.volumes
+            for name, data in datasets.items():
+                data = np.ravel(data)
+                if data.size != self.n_elements:
+                    raise ValueError(f'Cannot apply dataset "{name}" with '
+                                     f'{data.size} values to mesh {self.id} '
+                                     f'with {self.n_elements} elements')
+                if volume_normalization:
+                    if np.issubdtype(data.dtype, np.integer):
+                        warnings.warn(f'Integer data set "{name}" will '
+                                      'not be volume-normalized.')
+                    else:
+                        data = data / volumes
+                arr = nps.numpy_to_vtk(data, deep=True)
+                arr.SetName(name)
+                grid.GetCellData().AddArray(arr)
+
+        writer = vtk.vtkUnstructuredGridWriter()
+        writer.SetFileName(str(filename))
+        writer.SetInputData(grid)
+        writer.Write()
+
+    @classmethod
+    def from_hdf5(cls, group: h5py.Group):
+        mesh_id = int(group.name.split('/')[-1].lstrip('mesh '))
+        mesh = cls(group['dimension'][()], group['lower_left'][()],
+                   group['upper_right'][()], mesh_id=mesh_id)
+        mesh.refinement = group['refinement'][()]
+        return mesh
+
+    def to_xml_element(self):
+        """Return XML representation of the mesh
+
+        Returns
+        -------
+        element : lxml.etree._Element
+            XML element containing mesh data
+
+        """
+        element = ET.Element("mesh")
+        element.set("id", str(self._id))
+        element.set("type", "octree")
+
+        subelement = ET.SubElement(element, "dimension")
+        subelement.text = ' '.join(map(str, self.root_dimension))
+        subelement = ET.SubElement(element, "lower_left")
+        subelement.text = ' '.join(map(str, self.lower_left))
+        subelement = ET.SubElement(element, "upper_right")
+        subelement.text = ' '.join(map(str, self.upper_right))
+        if any(self.refinement):
+            subelement = ET.SubElement(element, "refinement")
+            subelement.text = ' '.join(map(str, self.refinement))
+
+        return element
+
+    @classmethod
+    def from_xml_element(cls, elem: ET.Element):
+        """Generate an octree mesh from an XML element
+
+        Parameters
+        ----------
+        elem : lxml.etree._Element
+            XML element
+
+        Returns
+        -------
+        openmc.OctreeMesh
+            Octree mesh generated from an XML element
+
+        """
+        mesh_id = int(get_text(elem, 'id'))
+        dimension = [int(x) for x in get_text(elem, 'dimension').split()]
+        lower_left = [float(x) for x in get_text(elem, 'lower_left').split()]
+        upper_right = [float(x) for x in get_text(elem, 'upper_right').split()]
+        mesh = cls(dimension, lower_left, upper_right, mesh_id=mesh_id)
+
+        refinement = get_text(elem, 'refinement')
+        if refinement is not None:
+            mesh.refinement = [int(x) for x in refinement.split()]
+
+        return mesh
+
+
 def require_statepoint_data(func):
     @wraps(func)
     def wrapper(self: UnstructuredMesh, *args, **kwargs):
@@ -2087,6 +2686,15 @@ class UnstructuredMesh(MeshBase):
         is currently only used to set `parameters
         <https://tinyurl.com/kdtree-params>`_ for MOAB's AdaptiveKDTree. If
         None, OpenMC internally uses a default of "MAX_DEPTH=20;PLANE_SET=2;".
+    tracker : {'kdtree', 'adjacency'}
+        Method used to find the elements crossed by a track for MOAB meshes.
+        The 'kdtree' tracker intersects each track with the faces of the mesh
+        using MOAB's AdaptiveKDTree. The 'adjacency' tracker only uses the tree
+        to locate the start of a track and then walks from tetrahedron to
+        tetrahedron across their shared faces, which is faster for large
+        meshes at the cost of storing the face planes and adjacency.
+
+        .. versionadded:: 0.15.1
 
     Attributes
     ----------
@@ -2105,6 +2713,10 @@ class UnstructuredMesh(MeshBase):
         is currently only used to set `parameters
         <https://tinyurl.com/kdtree-params>`_ for MOAB's AdaptiveKDTree. If
         None, OpenMC internally uses a default of "MAX_DEPTH=20;PLANE_SET=2;".
+    tracker : {'kdtree', 'adjacency'}
+        Method used to find the elements crossed by a track for MOAB meshes
+
+        .. versionadded:: 0.15.1
     output : bool
         Indicates whether or not automatic tally output should be generated for
         this mesh
@@ -2139,7 +2751,7 @@ class UnstructuredMesh(MeshBase):
 
     def __init__(self, filename: PathLike, library: str, mesh_id: int | None = None,
                  name: str = '', length_multiplier: float = 1.0,
-                 options: str | None = None):
+                 options: str | None = None, tracker: str = 'kdtree'):
         super().__init__(mesh_id, name)
         self.filename = filename
         self._volumes = None
@@ -2150,6 +2762,7 @@ class UnstructuredMesh(MeshBase):
         self._output = False
         self.length_multiplier = length_multiplier
         self.options = options
+        self.tracker = tracker
         self._has_statepoint_data = False
 
     @property
@@ -2179,6 +2792,16 @@ class UnstructuredMesh(MeshBase):
         cv.check_type('options', options, (str, type(None)))
         self._options = options
 
+    @property
+    def tracker(self) -> str:
+        return self._tracker
+
+    @tracker.setter
+    def tracker(self, tracker: str):
+        cv.check_value('Unstructured mesh tracker', tracker,
+                       ('kdtree', 'adjacency'))
+        self._tracker = tracker
+
     @property
     @require_statepoint_data
     def size(self):
@@ -2292,6 +2915,8 @@ class UnstructuredMesh(MeshBase):
                                               self.length_multiplier)
         if self.options is not None:
             string += '{: <16}=\t{}\n'.format('\tOptions', self.options)
+        if self.tracker != 'kdtree':
+            string += '{: <16}=\t{}\n'.format('\tTracker', self.tracker)
         return string
 
     @property
@@ -2485,6 +3110,8 @@ class UnstructuredMesh(MeshBase):
         element.set("library", self._library)
         if self.options is not None:
             element.set('options', self.options)
+        if self.tracker != 'kdtree':
+            element.set('tracker', self.tracker)
         subelement = ET.SubElement(element, "filename")
         subelement.text = str(self.filename)
 
@@ -2512,8 +3139,10 @@ class UnstructuredMesh(MeshBase):
         library = get_text(elem, 'library')
         length_multiplier = float(get_text(elem, 'length_multiplier', 1.0))
         options = elem.get('options')
+        tracker = elem.get('tracker', 'kdtree')
 
-        return cls(filename, library, mesh_id, '', length_multiplier, options)
+        return cls(filename, library, mesh_id, '', length_multiplier, options,
+                   tracker)
 
 
 def _read_meshes(elem):
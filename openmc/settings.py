@@ -9,8 +9,9 @@ import lxml.etree as ET
 
 import openmc.checkvalue as cv
 from openmc.stats.multivariate import MeshSpatial
-from . import (RegularMesh, SourceBase, MeshSource, IndependentSource,
-               VolumeCalculation, WeightWindows, WeightWindowGenerator)
+from . import (Cell, RegularMesh, StructuredMesh, SourceBase, MeshSource,
+               IndependentSource, VolumeCalculation, WeightWindows,
+               WeightWindowGenerator)
 from ._xml import clean_indentation, get_text, reorder_attributes
 from openmc.checkvalue import PathLike
 from .mesh import _read_meshes
@@ -22,6 +23,7 @@ class RunMode(Enum):
     PLOT = 'plot'
     VOLUME = 'volume'
     PARTICLE_RESTART = 'particle restart'
+    OVERLAP_CHECK = 'overlap check'
 
 
 _RES_SCAT_METHODS = {'dbrc', 'rvs'}
@@ -39,6 +41,23 @@ class Settings:
     ----------
     batches : int
         Number of batches to simulate
+    census_times : Iterable of float
+        Increasing times in [s] at which the particles of a fixed source
+        calculation are stopped. The particles stopped at each census time,
+        including the delayed neutrons whose precursors have not yet decayed,
+        are combed into the number of particles per batch, each with an equal
+        share of their total weight, before they are transported to the next
+        census time.
+
+        .. versionadded:: 0.15.1
+    compact_micro_xs : bool
+        Indicate whether each particle's microscopic cross section cache should
+        only hold the nuclides of its current material rather than every nuclide
+        in the problem. This reduces memory for problems with many nuclides and
+        many particles in flight, at the cost of recomputing cross sections
+        whenever a particle enters a different material.
+
+        .. versionadded:: 0.15.1
     confidence_intervals : bool
         If True, uncertainties on tally results will be reported as the
         half-width of the 95% two-sided confidence interval. If False,
@@ -63,6 +82,22 @@ class Settings:
         release of delayed photons.
 
         .. versionadded:: 0.12
+    delta_tracking_cells : iterable of openmc.Cell or int
+        Cells filled with a universe or lattice in which neutrons are
+        transported with delta (Woodcock) tracking. Distances to collision are
+        sampled from a majorant cross section of all materials in the cell, so
+        the boundaries of the cells inside it are never found. Track-length
+        tallies are scored with collision estimators when delta tracking is
+        used.
+
+        .. versionadded:: 0.15.1
+    electron_inline_deposition : bool
+        Whether secondary electrons and positrons are handled at the photon
+        collision that creates them, with their energy deposited there, instead
+        of being banked as particles. Requires the 'led' electron treatment.
+        Tallies of electrons and positrons then receive no scores.
+
+        .. versionadded:: 0.15.1
     electron_treatment : {'led', 'ttb'}
         Whether to deposit all energy from electrons locally ('led') or create
         secondary bremsstrahlung photons ('ttb').
@@ -77,12 +112,156 @@ class Settings:
         history-based parallelism.
 
         .. versionadded:: 0.12
+    event_autotune : bool
+        Whether the number of particles in flight and the OpenMP loop
+        schedule of event-based transport are chosen by trying several of
+        them in the first batches and keeping the fastest.
+
+        .. versionadded:: 0.15.1
+    event_history_tail : int
+        Number of particles in flight at or below which event-based transport
+        hands the remaining particles to history-based transport. A value of
+        zero disables the switch.
+
+        .. versionadded:: 0.15.1
+    event_queue_sort : bool
+        Indicate whether to sort the cross section event queues by particle
+        type, material, and energy before each lookup kernel when using
+        event-based parallelism. Consecutive neutrons in the same material
+        are then evaluated together, one nuclide at a time.
+
+        .. versionadded:: 0.15.1
+    event_secondary_queue : bool
+        Indicate whether secondary particles created in event-based fixed
+        source calculations are placed in a queue shared by all particle
+        slots and started in the slots of particles that died, rather than
+        transported one after another in the slot of their parent.
+
+        .. versionadded:: 0.15.1
+    event_thread_pool : int
+        Number of particles in each thread's private pool when using event-based
+        parallelism. When nonzero, each thread runs the event kernels on its own
+        pool rather than sharing global event queues. A value of zero uses the
+        shared queues.
+
+        .. versionadded:: 0.15.1
+    event_xs_queue_groups : int
+        Number of material groups that each receive their own cross section
+        event queue when using event-based parallelism. Materials with similar
+        nuclide lists are placed in the same group. A value of zero splits
+        particles into fissionable and non-fissionable queues.
+
+        .. versionadded:: 0.15.1
+    exponential_transforms : list of dict
+        Exponential transforms that stretch the distances to collision of
+        neutrons and photons in a set of cells. Each dictionary has a 'cells'
+        key with an iterable of :class:`openmc.Cell` or cell IDs, a
+        'stretching' key with a parameter between -1 and 1, and a 'direction'
+        key with the preferred direction of travel. The total cross section used
+        to sample distances is multiplied by one minus the stretching parameter
+        times the cosine with the preferred direction.
+
+        .. versionadded:: 0.15.1
+    fission_matrix_mesh : openmc.RegularMesh
+        Mesh on which a fission matrix is tallied during inactive batches. The
+        weights of source sites are adjusted at each inactive generation so that
+        the source distribution over the mesh follows the dominant eigenvector
+        of the fission matrix, which accelerates convergence of the source.
+
+        .. versionadded:: 0.15.1
     generations_per_batch : int
         Number of generations per batch
+    geometry_cache : Pathlike
+        HDF5 file caching the distributed cell offsets and, if
+        :attr:`Settings.neighbor_list_precompute` is set, the neighbor lists of
+        the geometry. The file is written by the first run and read by later
+        runs of the same input files.
+
+        .. versionadded:: 0.15.1
+    guide_table_cells : int
+        Number of cells in the guide tables built at load time to search
+        tabulated outgoing energy distributions of secondary neutrons, of
+        S(a,b) incoherent inelastic scattering, of the electron shell and
+        momentum in Doppler-broadened Compton scattering, and of photon
+        energies in thick-target bremsstrahlung. More cells make sampling
+        faster at the expense of memory. A value of zero disables the guide
+        tables.
+
+        .. versionadded:: 0.15.1
+    hierarchical_reduce : bool
+        If True, tally results, random ray source region data, and the
+        generation estimate of k are summed over the processes of each node
+        before they are reduced across nodes, in segments so that the two
+        stages overlap. This reduces the traffic between nodes when many
+        processes run on each node. Sums may differ in the last digits from
+        those of a flat reduction.
+
+        .. versionadded:: 0.15.1
+    inelastic_scatter_cdf : bool
+        Whether running sums of the inelastic scattering cross sections of
+        each nuclide are tabulated when data is loaded, so that the inelastic
+        reaction at a collision is found by a search instead of evaluating
+        every reaction. Uses memory proportional to the number of inelastic
+        reactions and energy points.
+
+        .. versionadded:: 0.15.1
+    load_balancing : bool
+        Whether to reassign particles between MPI processes after each batch in
+        proportion to the rate at which each process transported particles
+        during the batch. This balances the work on machines whose processes run
+        at different speeds without changing the results beyond round-off.
+
+        .. versionadded:: 0.15.1
     max_lost_particles : int
         Maximum number of lost particles
 
         .. versionadded:: 0.12
+    ncrystal_xs_tolerance : float
+        Relative tolerance of the cross sections of NCrystal materials
+        tabulated on a log-uniform energy grid below 5 eV. Oriented materials
+        are not tabulated. Scattering is still sampled by NCrystal. A value of
+        zero disables the tables.
+
+        .. versionadded:: 0.15.1
+    neighbor_list_precompute : bool
+        Whether the neighbor list of each cell is filled before transport with
+        the cells of the same universe on the other side of its surfaces, rather
+        than only as neighbors are found during transport.
+
+        .. versionadded:: 0.15.1
+    numa_interleave : bool
+        Whether the pages of the nuclear data are interleaved over all NUMA
+        nodes while they are read, so that threads on every socket share the
+        cost of remote memory accesses. Only supported on Linux.
+
+        .. versionadded:: 0.15.1
+    neighbor_list_reorder : bool
+        Whether the neighbor list of each cell is sorted at the end of each
+        batch by how often its cells were found to contain a particle, so that
+        the most likely neighbor is checked first.
+
+        .. versionadded:: 0.15.1
+    overlap_bank_sync : bool
+        Whether source sites received from other MPI processes when
+        synchronizing the fission bank are transported as they arrive. Particles
+        whose source sites were sampled on the same process start transporting
+        while the other sites are still being received. This has no effect with
+        event-based parallelism or uniform fission site weighting.
+
+        .. versionadded:: 0.15.1
+    overlap_reduction : bool
+        If True, tally results are reduced across MPI processes with a
+        nonblocking reduction that overlaps with transport in the following
+        batch. Results of a batch are then added to the tally sums one batch
+        later, except in batches whose results are needed right away.
+
+        .. versionadded:: 0.15.1
+    pipeline_batches : bool
+        Whether the accumulation of tallies and the writing of state point and
+        source files at the end of a batch are completed on a separate thread
+        while the first generation of the next batch is transported.
+
+        .. versionadded:: 0.15.1
     rel_max_lost_particles : float
         Maximum number of lost particles, relative to the total number of
         particles
@@ -114,6 +293,19 @@ class Settings:
         .. versionadded:: 0.15.0
     max_order : None or int
         Maximum scattering order to apply globally when in multi-group mode.
+    memory_report : bool
+        Whether the memory used by nuclear data, tallies, meshes, particles,
+        banks, and other parts of the simulation is reported after
+        initialization and at the end of the run.
+
+        .. versionadded:: 0.15.1
+    mg_alias_sampling : bool
+        Whether the outgoing group of a multi-group scattering collision is
+        sampled from alias tables built when data is loaded, which takes the
+        same time for any number of groups. This changes which group a given
+        random number selects.
+
+        .. versionadded:: 0.15.1
     max_history_splits : int
         Maximum number of times a particle can split during a history
 
@@ -137,12 +329,64 @@ class Settings:
                written
         :summary: Whether the 'summary.h5' file should be written (bool)
         :tallies: Whether the 'tallies.out' file should be written (bool)
+        :compression: Filter used to compress tally results and voxel plots
+                      ('none', 'deflate', 'szip', or 'zstd')
+        :compression_level: Level of the compression filter (int)
+        :chunk_size: Largest size in bytes of a compressed chunk (int)
     particles : int
         Number of particles per generation
     photon_transport : bool
         Whether to use photon transport.
+    photon_material_xs : bool
+        Whether macroscopic photon cross sections of each material are
+        tabulated on a log-uniform energy grid to within
+        :attr:`photon_xs_tolerance`, so that a lookup is a single
+        interpolation. The cross sections of each element are then only
+        evaluated at collisions. Requires a positive
+        :attr:`photon_xs_tolerance`.
+
+        .. versionadded:: 0.15.1
+    photon_only : bool
+        Whether only photons are transported in a fixed source calculation.
+        Neutron cross sections are then not read beyond the atomic weight
+        ratio of each nuclide, and particles hold no neutron cross section
+        caches. Every source must emit photons. Turns on
+        :attr:`photon_transport`.
+
+        .. versionadded:: 0.15.1
+    photon_product_cdf : bool
+        Whether running sums of the photon production cross sections of each
+        nuclide are tabulated when data is loaded, so that the reaction and
+        product of a secondary photon are found by a search instead of
+        evaluating every photon product. Only applies with photon transport
+        and uses memory proportional to the number of photon products and
+        energy points.
+
+        .. versionadded:: 0.15.1
+    photon_xs_tolerance : float
+        Relative tolerance of photon cross sections tabulated on a log-uniform
+        energy grid for each element. The tables are linearly interpolated, so
+        no exponentials are evaluated per lookup. A value of zero disables the
+        tables.
+
+        .. versionadded:: 0.15.1
     plot_seed : int
        Initial seed for randomly generated plot colors.
+    profile : bool
+        Whether cross section lookups, track segments, track lengths,
+        collisions, and surface crossings are counted in each material and
+        cell, along with collisions with each nuclide. The counts are written
+        to ``profile.h5`` at the end of the run.
+
+        .. versionadded:: 0.15.1
+    prune_nuclear_data : bool
+        Whether nuclear data that the run cannot use is freed once the tallies
+        are known: the photon products of every reaction when photons are not
+        transported, and the cross sections of redundant reactions that are
+        not tallied, not fission and not used by depletion. Tallies created
+        later through :mod:`openmc.lib` cannot score the freed reactions.
+
+        .. versionadded:: 0.15.1
     ptables : bool
         Determine whether probability tables are used.
     random_ray : dict
@@ -168,6 +412,34 @@ class Settings:
             cm/cm^3. When disabled, flux tallies will be reported in units
             of cm (i.e., total distance traveled by neutrons in the spatial
             tally region).
+        :segment_cache_iterations:
+            Number of iterations each set of sampled rays is used for (int).
+            Rays are traced through the geometry in the first of these
+            iterations and the segments recorded then are replayed in the
+            others. Only supported with flat sources. The default is 1, in
+            which case segments are not cached.
+        :segment_cache_memory:
+            Maximum memory in [MB] used to cache ray segments on each process
+            (float). If the segments do not fit, rays are traced in every
+            iteration. The default is 1000.
+        :source_region_mesh:
+            Structured mesh used to subdivide source regions, as a
+            :class:`openmc.StructuredMesh` or a tuple of the mesh and an
+            iterable of the :class:`openmc.Cell` objects or IDs of the cells
+            it subdivides. Each cell instance is split into a source region
+            for each mesh element it overlaps and one for its parts outside
+            the mesh. If no cells are given, all cells are subdivided.
+        :adjoint:
+            Whether to follow the forward solve with a solve of the adjoint
+            equation (bool). In fixed source mode, the adjoint source is the
+            inverse of the forward flux, so the adjoint flux can be used to
+            generate weight windows with the FW-CADIS method. The default is
+            False.
+        :anderson_depth:
+            Number of previous iterations whose scalar fluxes are combined
+            to extrapolate the scalar flux during inactive iterations with
+            Anderson acceleration (int). The default is 0, in which case the
+            flux is not extrapolated.
 
         .. versionadded:: 0.15.0
     resonance_scattering : dict
@@ -181,12 +453,50 @@ class Settings:
         The 'nuclides' list indicates what nuclides the method should be applied
         to. In its absence, the method will be applied to all nuclides with 0 K
         elastic scattering data present.
-    run_mode : {'eigenvalue', 'fixed source', 'plot', 'volume', 'particle restart'}
-        The type of calculation to perform (default is 'eigenvalue')
+    run_mode : {'eigenvalue', 'fixed source', 'plot', 'volume', 'particle restart', 'overlap check'}
+        The type of calculation to perform (default is 'eigenvalue'). An
+        overlap check traces :attr:`Settings.particles` rays through the
+        geometry and reports the cells that overlap.
     seed : int
         Seed for the linear congruential pseudorandom number generator
+    shared_xs : bool
+        Indicate whether tabulated cross sections of nuclides and their
+        reactions should be stored once per node in memory shared by all MPI
+        processes on the node rather than once per process.
+
+        .. versionadded:: 0.15.1
+    simplify_regions : bool
+        Whether the region of each cell is simplified as the geometry is read.
+        Half-spaces that cannot change the region are removed, nested
+        operators of the same kind are merged and the cheapest operands of
+        each operator are evaluated first.
+
+        .. versionadded:: 0.15.1
     source : Iterable of openmc.SourceBase
         Distribution of source sites in space, angle, and energy
+    source_convergence : dict
+        End the inactive batches of an eigenvalue calculation once neither k
+        nor the Shannon entropy of the generations in the last batches shows a
+        trend. The number of inactive batches then acts as an upper limit, and
+        the number of batches is reduced by the inactive batches that are
+        skipped. Acceptable keys are:
+
+        :window:
+          Number of batches whose generations are tested (int)
+        :min_inactive:
+          Smallest number of inactive batches (int)
+        :threshold:
+          Largest difference between the means of the older and newer halves
+          of the window, in standard errors of the difference (float)
+
+        .. versionadded:: 0.15.1
+    source_domain_bounds : bool
+        Indicate whether box spatial distributions of sources with domain or
+        fissionable constraints are sampled within the bounding box of the
+        cells of the root universe that may satisfy the constraints, which
+        rejects fewer sites without changing their distribution.
+
+        .. versionadded:: 0.15.1
     sourcepoint : dict
         Options for writing source points. Acceptable keys are:
 
@@ -196,10 +506,17 @@ class Settings:
                    separate file
         :write: bool indicating whether or not to write the source
         :mcpl: bool indicating whether to write the source as an MCPL file
+        :sharded: bool indicating whether each process writes its source sites
+                  to its own file
     statepoint : dict
         Options for writing state points. Acceptable keys are:
 
         :batches: list of batches at which to write statepoint files
+        :async: bool indicating whether statepoint files are written to disk
+                in the background while the simulation continues
+        :delta: maximum number of statepoint files that only hold the tally
+                bins changed since the previous statepoint, written between
+                two complete statepoint files (int)
     surf_source_read : dict
         Options for reading surface source points. Acceptable keys are:
 
@@ -221,6 +538,17 @@ class Settings:
         :cellto: Cell ID used to determine if particles crossing identified
                  surfaces are to be banked. Particles going to this declared
                  cell will be banked (int)
+        :streaming: Write banked particles to the file as they are banked so
+                    that their number is not limited by memory. The
+                    maximum number of particles is then optional (bool)
+    surface_distance_cache : bool
+        Whether distances to the surfaces of a cell are stored for each particle
+        and reused while it moves in the same direction within the cell, for
+        example after a collision that does not change its direction. This
+        avoids recalculating distances to every surface of cells with many
+        surfaces.
+
+        .. versionadded:: 0.15.1
     survival_biasing : bool
         Indicate whether survival biasing is to be used
     tabular_legendre : dict
@@ -230,6 +558,33 @@ class Settings:
         is a bool stating whether the conversion to tabular is performed; the
         value for 'num_points' sets the number of points to use in the tabular
         distribution, should 'enable' be True.
+    tally_private_memory : float
+        Maximum memory in [MB] that may be used for the per-thread copies of
+        results of a single tally with :attr:`openmc.Tally.thread_private` set.
+        Tallies that would exceed it use atomic updates instead.
+
+        .. versionadded:: 0.15.1
+    tally_stream : dict
+        Options for streaming tally results through ADIOS2 at the end of each
+        active batch, so that coupled codes can read them while the run
+        continues. This requires OpenMC to be built with ADIOS2. Acceptable
+        keys are:
+
+        :engine: ADIOS2 engine writing the stream, e.g. 'SST' or 'BP5' (str)
+        :name: Name of the stream opened by readers (str)
+        :tally_ids: IDs of the tallies to stream. All tallies are streamed if
+                    not given (Iterable of int)
+
+        .. versionadded:: 0.15.1
+    telemetry : PathLike
+        Path to a file to which one line of JSON describing each batch is
+        appended as soon as the batch finishes. Each line gives the
+        calculation rate, numbers of lost and secondary particles, bank sizes,
+        the largest memory used by any process, the transport time of each
+        process, and, when available, k-effective and the Shannon entropy.
+        The path may be a named pipe read by a monitoring process.
+
+        .. versionadded:: 0.15.1
     temperature : dict
         Defines a default temperature and method for treating intermediate
         temperatures at which nuclear data doesn't exist. Accepted keys are
@@ -245,6 +600,21 @@ class Settings:
         sections be loaded at all temperatures within the range. 'multipole' is
         a boolean indicating whether or not the windowed multipole method should
         be used to evaluate resolved resonance cross sections.
+    thread_affinity : {'none', 'compact', 'spread'}
+        How OpenMP threads are pinned to the cores available to each process.
+        With 'compact', consecutive threads are placed on neighboring cores;
+        with 'spread', threads are spaced evenly over all cores so that each
+        NUMA node receives its share. Only supported on Linux.
+
+        .. versionadded:: 0.15.1
+    thread_stats : bool
+        Whether the time spent transporting particles and the numbers of
+        histories, track segments, collisions, and surface crossings are
+        recorded for each thread. Their spread over all threads of all
+        processes is shown at the end of the run and the values are written
+        to the ``runtime/threads`` group of statepoints.
+
+        .. versionadded:: 0.15.1
     trace : tuple or list
         Show detailed information about a single particle, indicated by three
         integers: the batch number, generation number, and particle number
@@ -252,6 +622,13 @@ class Settings:
         Specify particles for which track files should be written. Each particle
         is identified by a tuple with the batch number, generation number, and
         particle number.
+    track_buffer_memory : float
+        Maximum memory in MB of the particle tracks that each thread holds
+        before writing them to the track file. Tracks are also written at the
+        end of every batch. A value of zero writes each track as soon as it is
+        finished.
+
+        .. versionadded:: 0.15.1
     trigger_active : bool
         Indicate whether tally triggers are used
     trigger_batch_interval : int
@@ -263,6 +640,21 @@ class Settings:
     ufs_mesh : openmc.RegularMesh
         Mesh to be used for redistributing source sites via the uniform fission
         site (UFS) method.
+    union_grid_memory : float
+        Maximum memory in [MB] that may be used for a unionized energy grid over
+        all nuclides. With a unionized grid, a single search per cross section
+        lookup gives the grid index for every nuclide. If the grid would need
+        more memory than this, the logarithmic grid is used instead. A value of
+        zero disables the unionized grid.
+
+        .. versionadded:: 0.15.1
+    vectorized_xs : bool
+        Indicate whether microscopic cross sections of nuclides that only need
+        interpolation on their tabulated data (no S(a,b), multipole, or
+        probability tables) should be evaluated several nuclides at a time from
+        a packed copy of the cross section data.
+
+        .. versionadded:: 0.15.1
     verbosity : int
         Verbosity during simulation between 1 and 10. Verbosity levels are
         described in :ref:`verbosity`.
@@ -291,18 +683,50 @@ class Settings:
 
         .. versionadded:: 0.13
 
+    warm_start : dict
+        Start each eigenvalue simulation run through :mod:`openmc.lib` from the
+        fission source at the end of the previous one rather than from the
+        external source. Acceptable keys are:
+
+        :inactive:
+          Number of inactive batches used when starting from the previous
+          source, at most the number of inactive batches (int)
+        :entropy_tolerance:
+          Relative change in the mean Shannon entropy of the last three
+          batches from the three before them below which the remaining
+          inactive batches of a warm start become active batches. Requires an
+          entropy mesh (float)
+
+        .. versionadded:: 0.15.1
     weight_windows_file: Pathlike
         Path to a weight window file to load during simulation initialization
 
         .. versionadded::0.14.0
+    wielandt_shift : float
+        Shift of the eigenvalue used for Wielandt iteration. Fission neutrons
+        are transported in the generation they were born in with probability
+        1/k_e, where k_e is the current estimate of k-effective plus this shift,
+        which reduces the dominance ratio. A value of zero disables the shift.
+
+        .. versionadded:: 0.15.1
     write_initial_source : bool
         Indicate whether to write the initial source distribution to file
+    xs_cache : PathLike
+        Path to a cache of tabulated cross sections. If the file does not exist,
+        the cross sections of all nuclides are written to it once they have been
+        read. Otherwise, the file is memory-mapped read-only and the cross
+        sections it contains are used in place rather than being read from the
+        HDF5 library. The cache must be removed whenever the library changes.
+
+        .. versionadded:: 0.15.1
     """
 
     def __init__(self, **kwargs):
         self._run_mode = RunMode.EIGENVALUE
         self._batches = None
         self._generations_per_batch = None
+        self._guide_table_cells = None
+        self._inelastic_scatter_cdf = None
         self._inactive = None
         self._max_lost_particles = None
         self._rel_max_lost_particles = None
@@ -313,17 +737,42 @@ class Settings:
         # Energy mode subelement
         self._energy_mode = None
         self._max_order = None
+        self._mg_alias_sampling = None
 
         # Source subelement
         self._source = cv.CheckedList(SourceBase, 'source distributions')
+        self._source_convergence = None
+        self._source_domain_bounds = None
+        self._census_times = None
 
         self._confidence_intervals = None
+        self._electron_inline_deposition = None
         self._electron_treatment = None
         self._photon_transport = None
+        self._photon_material_xs = None
+        self._photon_only = None
+        self._photon_product_cdf = None
+        self._photon_xs_tolerance = None
+        self._ncrystal_xs_tolerance = None
         self._plot_seed = None
         self._ptables = None
+        self._prune_nuclear_data = None
+        self._vectorized_xs = None
+        self._shared_xs = None
+        self._simplify_regions = None
+        self._xs_cache = None
+        self._telemetry = None
         self._seed = None
         self._survival_biasing = None
+        self._surface_distance_cache = None
+        self._neighbor_list_reorder = None
+        self._neighbor_list_precompute = None
+        self._geometry_cache = None
+        self._thread_stats = None
+        self._thread_affinity = None
+        self._numa_interleave = None
+        self._profile = None
+        self._memory_report = None
 
         # Shannon entropy mesh
         self._entropy_mesh = None
@@ -343,6 +792,10 @@ class Settings:
         self._surf_source_write = {}
 
         self._no_reduce = None
+        self._overlap_reduction = None
+        self._hierarchical_reduce = None
+        self._overlap_bank_sync = None
+        self._pipeline_batches = None
 
         self._verbosity = None
 
@@ -358,6 +811,7 @@ class Settings:
 
         # Uniform fission source subelement
         self._ufs_mesh = None
+        self._fission_matrix_mesh = None
 
         self._resonance_scattering = {}
         self._volume_calculations = cv.CheckedList(
@@ -366,13 +820,28 @@ class Settings:
         self._create_fission_neutrons = None
         self._create_delayed_neutrons = None
         self._delayed_photon_scaling = None
+        self._delta_tracking_cells = []
+        self._compact_micro_xs = None
         self._material_cell_offsets = None
         self._log_grid_bins = None
+        self._union_grid_memory = None
+        self._tally_private_memory = None
+        self._tally_stream = {}
+        self._track_buffer_memory = None
 
         self._event_based = None
+        self._event_queue_sort = None
+        self._event_autotune = None
+        self._load_balancing = None
+        self._event_xs_queue_groups = None
+        self._event_history_tail = None
+        self._event_secondary_queue = None
+        self._event_thread_pool = None
         self._max_particles_in_flight = None
         self._max_particle_events = None
         self._write_initial_source = None
+        self._wielandt_shift = None
+        self._warm_start = None
         self._weight_windows = cv.CheckedList(WeightWindows, 'weight windows')
         self._weight_window_generators = cv.CheckedList(WeightWindowGenerator, 'weight window generators')
         self._weight_windows_on = None
@@ -380,6 +849,7 @@ class Settings:
         self._weight_window_checkpoints = {}
         self._max_history_splits = None
         self._max_tracks = None
+        self._exponential_transforms = []
 
         self._random_ray = {}
 
@@ -417,6 +887,25 @@ class Settings:
         cv.check_greater_than('generations per batch', generations_per_batch, 0)
         self._generations_per_batch = generations_per_batch
 
+    @property
+    def guide_table_cells(self) -> int:
+        return self._guide_table_cells
+
+    @guide_table_cells.setter
+    def guide_table_cells(self, value: int):
+        cv.check_type('guide table cells', value, Integral)
+        cv.check_greater_than('guide table cells', value, 0, True)
+        self._guide_table_cells = value
+
+    @property
+    def inelastic_scatter_cdf(self) -> bool:
+        return self._inelastic_scatter_cdf
+
+    @inelastic_scatter_cdf.setter
+    def inelastic_scatter_cdf(self, value: bool):
+        cv.check_type('inelastic scatter cdf', value, bool)
+        self._inelastic_scatter_cdf = value
+
     @property
     def inactive(self) -> int:
         return self._inactive
@@ -523,6 +1012,15 @@ class Settings:
                                   True)
         self._max_order = max_order
 
+    @property
+    def mg_alias_sampling(self) -> bool:
+        return self._mg_alias_sampling
+
+    @mg_alias_sampling.setter
+    def mg_alias_sampling(self, value: bool):
+        cv.check_type('multi-group alias sampling', value, bool)
+        self._mg_alias_sampling = value
+
     @property
     def source(self) -> list[SourceBase]:
         return self._source
@@ -533,6 +1031,53 @@ class Settings:
             source = [source]
         self._source = cv.CheckedList(SourceBase, 'source distributions', source)
 
+    @property
+    def source_convergence(self) -> dict:
+        return self._source_convergence
+
+    @source_convergence.setter
+    def source_convergence(self, source_convergence: dict):
+        cv.check_type('source convergence', source_convergence, Mapping)
+        for key, value in source_convergence.items():
+            if key == 'window':
+                cv.check_type('source convergence window', value, Integral)
+                cv.check_greater_than('source convergence window', value, 4,
+                                      True)
+            elif key == 'min_inactive':
+                cv.check_type('minimum inactive batches', value, Integral)
+                cv.check_greater_than('minimum inactive batches', value, 0,
+                                      True)
+            elif key == 'threshold':
+                cv.check_type('source convergence threshold', value, Real)
+                cv.check_greater_than('source convergence threshold', value,
+                                      0.0)
+            else:
+                raise ValueError(f'Unable to set source convergence to "{key}" '
+                                 'which is unsupported by OpenMC')
+        self._source_convergence = source_convergence
+
+    @property
+    def source_domain_bounds(self) -> bool:
+        return self._source_domain_bounds
+
+    @source_domain_bounds.setter
+    def source_domain_bounds(self, value: bool):
+        cv.check_type('source domain bounds', value, bool)
+        self._source_domain_bounds = value
+
+    @property
+    def census_times(self) -> list[float]:
+        return self._census_times
+
+    @census_times.setter
+    def census_times(self, value: Iterable[float]):
+        cv.check_type('census times', value, Iterable, Real)
+        value = list(value)
+        for t in value:
+            cv.check_greater_than('census time', t, 0.0)
+        cv.check_increasing('census times', value)
+        self._census_times = value
+
     @property
     def confidence_intervals(self) -> bool:
         return self._confidence_intervals
@@ -542,6 +1087,15 @@ class Settings:
         cv.check_type('confidence interval', confidence_intervals, bool)
         self._confidence_intervals = confidence_intervals
 
+    @property
+    def electron_inline_deposition(self) -> bool:
+        return self._electron_inline_deposition
+
+    @electron_inline_deposition.setter
+    def electron_inline_deposition(self, value: bool):
+        cv.check_type('electron inline deposition', value, bool)
+        self._electron_inline_deposition = value
+
     @property
     def electron_treatment(self) -> str:
         return self._electron_treatment
@@ -551,6 +1105,15 @@ class Settings:
         cv.check_value('electron treatment', electron_treatment, ['led', 'ttb'])
         self._electron_treatment = electron_treatment
 
+    @property
+    def prune_nuclear_data(self) -> bool:
+        return self._prune_nuclear_data
+
+    @prune_nuclear_data.setter
+    def prune_nuclear_data(self, value: bool):
+        cv.check_type('prune nuclear data', value, bool)
+        self._prune_nuclear_data = value
+
     @property
     def ptables(self) -> bool:
         return self._ptables
@@ -560,6 +1123,51 @@ class Settings:
         cv.check_type('probability tables', ptables, bool)
         self._ptables = ptables
 
+    @property
+    def vectorized_xs(self) -> bool:
+        return self._vectorized_xs
+
+    @vectorized_xs.setter
+    def vectorized_xs(self, value: bool):
+        cv.check_type('vectorized xs', value, bool)
+        self._vectorized_xs = value
+
+    @property
+    def shared_xs(self) -> bool:
+        return self._shared_xs
+
+    @shared_xs.setter
+    def shared_xs(self, value: bool):
+        cv.check_type('shared cross sections', value, bool)
+        self._shared_xs = value
+
+    @property
+    def simplify_regions(self) -> bool:
+        return self._simplify_regions
+
+    @simplify_regions.setter
+    def simplify_regions(self, value: bool):
+        cv.check_type('simplify regions', value, bool)
+        self._simplify_regions = value
+
+    @property
+    def xs_cache(self) -> PathLike | None:
+        return self._xs_cache
+
+    @xs_cache.setter
+    def xs_cache(self, value: PathLike):
+        cv.check_type('cross section cache', value, (str, Path))
+        self._xs_cache = value
+
+    @property
+    def telemetry(self) -> PathLike | None:
+        return self._telemetry
+
+    @telemetry.setter
+    def telemetry(self, value: PathLike):
+        cv.check_type('telemetry file', value, (str, Path))
+        self._telemetry = value
+
     @property
     def photon_transport(self) -> bool:
         return self._photon_transport
@@ -569,6 +1177,53 @@ class Settings:
         cv.check_type('photon transport', photon_transport, bool)
         self._photon_transport = photon_transport
 
+    @property
+    def photon_material_xs(self) -> bool:
+        return self._photon_material_xs
+
+    @photon_material_xs.setter
+    def photon_material_xs(self, value: bool):
+        cv.check_type('photon material xs', value, bool)
+        self._photon_material_xs = value
+
+    @property
+    def photon_only(self) -> bool:
+        return self._photon_only
+
+    @photon_only.setter
+    def photon_only(self, value: bool):
+        cv.check_type('photon only', value, bool)
+        self._photon_only = value
+
+    @property
+    def photon_product_cdf(self) -> bool:
+        return self._photon_product_cdf
+
+    @photon_product_cdf.setter
+    def photon_product_cdf(self, value: bool):
+        cv.check_type('photon product cdf', value, bool)
+        self._photon_product_cdf = value
+
+    @property
+    def photon_xs_tolerance(self) -> float:
+        return self._photon_xs_tolerance
+
+    @photon_xs_tolerance.setter
+    def photon_xs_tolerance(self, value: float):
+        cv.check_type('photon xs tolerance', value, Real)
+        cv.check_greater_than('photon xs tolerance', value, 0.0, True)
+        self._photon_xs_tolerance = value
+
+    @property
+    def ncrystal_xs_tolerance(self) -> float:
+        return self._ncrystal_xs_tolerance
+
+    @ncrystal_xs_tolerance.setter
+    def ncrystal_xs_tolerance(self, value: float):
+        cv.check_type('NCrystal xs tolerance', value, Real)
+        cv.check_greater_than('NCrystal xs tolerance', value, 0.0, True)
+        self._ncrystal_xs_tolerance = value
+
     @property
     def plot_seed(self):
         return self._plot_seed
@@ -598,6 +1253,87 @@ class Settings:
         cv.check_type('survival biasing', survival_biasing, bool)
         self._survival_biasing = survival_biasing
 
+    @property
+    def surface_distance_cache(self) -> bool:
+        return self._surface_distance_cache
+
+    @surface_distance_cache.setter
+    def surface_distance_cache(self, value: bool):
+        cv.check_type('surface distance cache', value, bool)
+        self._surface_distance_cache = value
+
+    @property
+    def neighbor_list_reorder(self) -> bool:
+        return self._neighbor_list_reorder
+
+    @neighbor_list_reorder.setter
+    def neighbor_list_reorder(self, value: bool):
+        cv.check_type('neighbor list reorder', value, bool)
+        self._neighbor_list_reorder = value
+
+    @property
+    def neighbor_list_precompute(self) -> bool:
+        return self._neighbor_list_precompute
+
+    @neighbor_list_precompute.setter
+    def neighbor_list_precompute(self, value: bool):
+        cv.check_type('neighbor list precompute', value, bool)
+        self._neighbor_list_precompute = value
+
+    @property
+    def geometry_cache(self) -> PathLike | None:
+        return self._geometry_cache
+
+    @geometry_cache.setter
+    def geometry_cache(self, value: PathLike):
+        cv.check_type('geometry cache', value, (str, Path))
+        self._geometry_cache = value
+
+    @property
+    def thread_stats(self) -> bool:
+        return self._thread_stats
+
+    @thread_stats.setter
+    def thread_stats(self, value: bool):
+        cv.check_type('thread stats', value, bool)
+        self._thread_stats = value
+
+    @property
+    def thread_affinity(self) -> str:
+        return self._thread_affinity
+
+    @thread_affinity.setter
+    def thread_affinity(self, value: str):
+        cv.check_value('thread affinity', value, ['none', 'compact', 'spread'])
+        self._thread_affinity = value
+
+    @property
+    def numa_interleave(self) -> bool:
+        return self._numa_interleave
+
+    @numa_interleave.setter
+    def numa_interleave(self, value: bool):
+        cv.check_type('NUMA interleave', value, bool)
+        self._numa_interleave = value
+
+    @property
+    def profile(self) -> bool:
+        return self._profile
+
+    @profile.setter
+    def profile(self, value: bool):
+        cv.check_type('profile', value, bool)
+        self._profile = value
+
+    @property
+    def memory_report(self) -> bool:
+        return self._memory_report
+
+    @memory_report.setter
+    def memory_report(self, value: bool):
+        cv.check_type('memory report', value, bool)
+        self._memory_report = value
+
     @property
     def entropy_mesh(self) -> RegularMesh:
         return self._entropy_mesh
@@ -644,9 +1380,20 @@ class Settings:
     def output(self, output: dict):
         cv.check_type('output', output, Mapping)
         for key, value in output.items():
-            cv.check_value('output key', key, ('summary', 'tallies', 'path'))
+            cv.check_value('output key', key, ('summary', 'tallies', 'path',
+                'compression', 'compression_level', 'chunk_size'))
             if key in ('summary', 'tallies'):
                 cv.check_type(f"output['{key}']", value, bool)
+            elif key == 'compression':
+                cv.check_value("output['compression']", value,
+                               ('none', 'deflate', 'szip', 'zstd'))
+            elif key == 'compression_level':
+                cv.check_type("output['compression_level']", value, Integral)
+                cv.check_greater_than("output['compression_level']", value,
+                                      0, True)
+            elif key == 'chunk_size':
+                cv.check_type("output['chunk_size']", value, Integral)
+                cv.check_greater_than("output['chunk_size']", value, 0)
             else:
                 cv.check_type("output['path']", value, str)
         self._output = output
@@ -671,6 +1418,8 @@ class Settings:
                 cv.check_type('sourcepoint overwrite', value, bool)
             elif key == 'mcpl':
                 cv.check_type('sourcepoint mcpl', value, bool)
+            elif key == 'sharded':
+                cv.check_type('sourcepoint sharded', value, bool)
             else:
                 raise ValueError(f"Unknown key '{key}' encountered when "
                                  "setting sourcepoint options.")
@@ -688,6 +1437,11 @@ class Settings:
                 cv.check_type('statepoint batches', value, Iterable, Integral)
                 for batch in value:
                     cv.check_greater_than('statepoint batch', batch, 0)
+            elif key == 'async':
+                cv.check_type('statepoint async', value, bool)
+            elif key == 'delta':
+                cv.check_type('statepoint delta', value, Integral)
+                cv.check_greater_than('statepoint delta', value, 0, True)
             else:
                 raise ValueError(f"Unknown key '{key}' encountered when "
                                  "setting statepoint options.")
@@ -718,7 +1472,8 @@ class Settings:
             cv.check_value(
                 "surface source writing key",
                 key,
-                ("surface_ids", "max_particles", "mcpl", "cell", "cellfrom", "cellto"),
+                ("surface_ids", "max_particles", "mcpl", "cell", "cellfrom",
+                 "cellto", "streaming"),
             )
             if key == "surface_ids":
                 cv.check_type(
@@ -728,6 +1483,9 @@ class Settings:
                     cv.check_greater_than("surface id for source banking", surf_id, 0)
             elif key == "mcpl":
                 cv.check_type("write to an MCPL-format file", value, bool)
+            elif key == "streaming":
+                cv.check_type("write banked particles as they are banked",
+                              value, bool)
             elif key in ("max_particles", "cell", "cellfrom", "cellto"):
                 name = {
                     "max_particles": "maximum particle banks on surfaces per process",
@@ -749,6 +1507,42 @@ class Settings:
         cv.check_type('no reduction option', no_reduce, bool)
         self._no_reduce = no_reduce
 
+    @property
+    def overlap_reduction(self) -> bool:
+        return self._overlap_reduction
+
+    @overlap_reduction.setter
+    def overlap_reduction(self, value: bool):
+        cv.check_type('overlap reduction', value, bool)
+        self._overlap_reduction = value
+
+    @property
+    def hierarchical_reduce(self) -> bool:
+        return self._hierarchical_reduce
+
+    @hierarchical_reduce.setter
+    def hierarchical_reduce(self, value: bool):
+        cv.check_type('hierarchical reduce', value, bool)
+        self._hierarchical_reduce = value
+
+    @property
+    def overlap_bank_sync(self) -> bool:
+        return self._overlap_bank_sync
+
+    @overlap_bank_sync.setter
+    def overlap_bank_sync(self, value: bool):
+        cv.check_type('overlap bank sync', value, bool)
+        self._overlap_bank_sync = value
+
+    @property
+    def pipeline_batches(self) -> bool:
+        return self._pipeline_batches
+
+    @pipeline_batches.setter
+    def pipeline_batches(self, value: bool):
+        cv.check_type('pipeline batches', value, bool)
+        self._pipeline_batches = value
+
     @property
     def verbosity(self) -> int:
         return self._verbosity
@@ -877,6 +1671,15 @@ class Settings:
         cv.check_length('UFS mesh upper-right corner', ufs_mesh.upper_right, 3)
         self._ufs_mesh = ufs_mesh
 
+    @property
+    def fission_matrix_mesh(self) -> RegularMesh:
+        return self._fission_matrix_mesh
+
+    @fission_matrix_mesh.setter
+    def fission_matrix_mesh(self, mesh: RegularMesh):
+        cv.check_type('fission matrix mesh', mesh, RegularMesh)
+        self._fission_matrix_mesh = mesh
+
     @property
     def resonance_scattering(self) -> dict:
         return self._resonance_scattering
@@ -947,6 +1750,24 @@ class Settings:
         cv.check_type('delayed photon scaling', value, bool)
         self._delayed_photon_scaling = value
 
+    @property
+    def delta_tracking_cells(self) -> list[Cell | int]:
+        return self._delta_tracking_cells
+
+    @delta_tracking_cells.setter
+    def delta_tracking_cells(self, cells: Iterable[Cell | int]):
+        cv.check_type('delta tracking cells', cells, Iterable, (Cell, Integral))
+        self._delta_tracking_cells = list(cells)
+
+    @property
+    def compact_micro_xs(self) -> bool:
+        return self._compact_micro_xs
+
+    @compact_micro_xs.setter
+    def compact_micro_xs(self, value: bool):
+        cv.check_type('compact micro xs', value, bool)
+        self._compact_micro_xs = value
+
     @property
     def material_cell_offsets(self) -> bool:
         return self._material_cell_offsets
@@ -966,6 +1787,54 @@ class Settings:
         cv.check_greater_than('log grid bins', log_grid_bins, 0)
         self._log_grid_bins = log_grid_bins
 
+    @property
+    def union_grid_memory(self) -> float:
+        return self._union_grid_memory
+
+    @union_grid_memory.setter
+    def union_grid_memory(self, value: float):
+        cv.check_type('union grid memory', value, Real)
+        cv.check_greater_than('union grid memory', value, 0.0, True)
+        self._union_grid_memory = value
+
+    @property
+    def tally_private_memory(self) -> float:
+        return self._tally_private_memory
+
+    @tally_private_memory.setter
+    def tally_private_memory(self, value: float):
+        cv.check_type('tally private memory', value, Real)
+        cv.check_greater_than('tally private memory', value, 0.0, True)
+        self._tally_private_memory = value
+
+    @property
+    def tally_stream(self) -> dict:
+        return self._tally_stream
+
+    @tally_stream.setter
+    def tally_stream(self, tally_stream: dict):
+        cv.check_type('tally streaming options', tally_stream, Mapping)
+        for key, value in tally_stream.items():
+            cv.check_value('tally streaming key', key,
+                           ('engine', 'name', 'tally_ids'))
+            if key in ('engine', 'name'):
+                cv.check_type(f'tally stream {key}', value, str)
+            elif key == 'tally_ids':
+                cv.check_type('streamed tally ids', value, Iterable, Integral)
+                for tally_id in value:
+                    cv.check_greater_than('streamed tally id', tally_id, 0)
+        self._tally_stream = tally_stream
+
+    @property
+    def track_buffer_memory(self) -> float:
+        return self._track_buffer_memory
+
+    @track_buffer_memory.setter
+    def track_buffer_memory(self, value: float):
+        cv.check_type('track buffer memory', value, Real)
+        cv.check_greater_than('track buffer memory', value, 0.0, True)
+        self._track_buffer_memory = value
+
     @property
     def event_based(self) -> bool:
         return self._event_based
@@ -975,6 +1844,72 @@ class Settings:
         cv.check_type('event based', value, bool)
         self._event_based = value
 
+    @property
+    def event_queue_sort(self) -> bool:
+        return self._event_queue_sort
+
+    @event_queue_sort.setter
+    def event_queue_sort(self, value: bool):
+        cv.check_type('event queue sort', value, bool)
+        self._event_queue_sort = value
+
+    @property
+    def event_secondary_queue(self) -> bool:
+        return self._event_secondary_queue
+
+    @event_secondary_queue.setter
+    def event_secondary_queue(self, value: bool):
+        cv.check_type('event secondary queue', value, bool)
+        self._event_secondary_queue = value
+
+    @property
+    def event_autotune(self) -> bool:
+        return self._event_autotune
+
+    @event_autotune.setter
+    def event_autotune(self, value: bool):
+        cv.check_type('event autotune', value, bool)
+        self._event_autotune = value
+
+    @property
+    def load_balancing(self) -> bool:
+        return self._load_balancing
+
+    @load_balancing.setter
+    def load_balancing(self, value: bool):
+        cv.check_type('load balancing', value, bool)
+        self._load_balancing = value
+
+    @property
+    def event_xs_queue_groups(self) -> int:
+        return self._event_xs_queue_groups
+
+    @event_xs_queue_groups.setter
+    def event_xs_queue_groups(self, value: int):
+        cv.check_type('event XS queue groups', value, Integral)
+        cv.check_greater_than('event XS queue groups', value, 0, True)
+        self._event_xs_queue_groups = value
+
+    @property
+    def event_history_tail(self) -> int:
+        return self._event_history_tail
+
+    @event_history_tail.setter
+    def event_history_tail(self, value: int):
+        cv.check_type('event history tail', value, Integral)
+        cv.check_greater_than('event history tail', value, 0, True)
+        self._event_history_tail = value
+
+    @property
+    def event_thread_pool(self) -> int:
+        return self._event_thread_pool
+
+    @event_thread_pool.setter
+    def event_thread_pool(self, value: int):
+        cv.check_type('event thread pool', value, Integral)
+        cv.check_greater_than('event thread pool', value, 0, True)
+        self._event_thread_pool = value
+
     @property
     def max_particles_in_flight(self) -> int:
         return self._max_particles_in_flight
@@ -1004,6 +1939,37 @@ class Settings:
         cv.check_type('write initial source', value, bool)
         self._write_initial_source = value
 
+    @property
+    def wielandt_shift(self) -> float:
+        return self._wielandt_shift
+
+    @wielandt_shift.setter
+    def wielandt_shift(self, value: float):
+        cv.check_type('wielandt shift', value, Real)
+        cv.check_greater_than('wielandt shift', value, 0.0, True)
+        self._wielandt_shift = value
+
+    @property
+    def warm_start(self) -> dict:
+        return self._warm_start
+
+    @warm_start.setter
+    def warm_start(self, warm_start: dict):
+        cv.check_type('warm start', warm_start, Mapping)
+        for key, value in warm_start.items():
+            if key == 'inactive':
+                cv.check_type('warm-start inactive batches', value, Integral)
+                cv.check_greater_than('warm-start inactive batches', value,
+                                      0, True)
+            elif key == 'entropy_tolerance':
+                cv.check_type('warm-start entropy tolerance', value, Real)
+                cv.check_greater_than('warm-start entropy tolerance', value,
+                                      0.0, True)
+            else:
+                raise ValueError(f'Unable to set warm start to "{key}" which '
+                                 'is unsupported by OpenMC')
+        self._warm_start = warm_start
+
     @property
     def weight_windows(self) -> list[WeightWindows]:
         return self._weight_windows
@@ -1033,6 +1999,35 @@ class Settings:
             cv.check_value('weight_window_checkpoints', key, ('collision', 'surface'))
         self._weight_window_checkpoints = weight_window_checkpoints
 
+    @property
+    def exponential_transforms(self) -> list[dict]:
+        return self._exponential_transforms
+
+    @exponential_transforms.setter
+    def exponential_transforms(self, transforms: Iterable[dict]):
+        cv.check_type('exponential transforms', transforms, Iterable, Mapping)
+        for transform in transforms:
+            for key in transform:
+                cv.check_value('exponential transform key', key,
+                               ('cells', 'stretching', 'direction'))
+            for key in ('cells', 'stretching', 'direction'):
+                if key not in transform:
+                    raise ValueError(
+                        f'Exponential transform is missing the "{key}" key.')
+            cv.check_type('exponential transform cells', transform['cells'],
+                          Iterable, (Cell, Integral))
+            stretching = transform['stretching']
+            cv.check_type('exponential transform stretching', stretching, Real)
+            cv.check_greater_than('exponential transform stretching',
+                                  stretching, -1.0)
+            cv.check_less_than('exponential transform stretching',
+                               stretching, 1.0)
+            cv.check_type('exponential transform direction',
+                          transform['direction'], Iterable, Real)
+            cv.check_length('exponential transform direction',
+                            transform['direction'], 3)
+        self._exponential_transforms = list(transforms)
+
     @property
     def max_splits(self):
         raise AttributeError('max_splits has been deprecated. Please use max_history_splits instead')
@@ -1104,6 +2099,31 @@ class Settings:
                                ('flat', 'linear', 'linear_xy'))
             elif key == 'volume_normalized_flux_tallies':
                 cv.check_type('volume normalized flux tallies', random_ray[key], bool)
+            elif key == 'segment_cache_iterations':
+                cv.check_type('segment cache iterations', random_ray[key],
+                              Integral)
+                cv.check_greater_than('segment cache iterations',
+                                      random_ray[key], 1, True)
+            elif key == 'segment_cache_memory':
+                cv.check_type('segment cache memory', random_ray[key], Real)
+                cv.check_greater_than('segment cache memory',
+                                      random_ray[key], 0.0)
+            elif key == 'adjoint':
+                cv.check_type('adjoint', random_ray[key], bool)
+            elif key == 'anderson_depth':
+                cv.check_type('Anderson depth', random_ray[key], Integral)
+                cv.check_greater_than('Anderson depth', random_ray[key], 0,
+                                      True)
+            elif key == 'source_region_mesh':
+                value = random_ray[key]
+                if isinstance(value, tuple):
+                    cv.check_length('source region mesh', value, 2)
+                    mesh, cells = value
+                    cv.check_type('source region mesh cells', cells,
+                                  Iterable, (Integral, Cell))
+                else:
+                    mesh = value
+                cv.check_type('source region mesh', mesh, StructuredMesh)
             else:
                 raise ValueError(f'Unable to set random ray to "{key}" which is '
                                  'unsupported by OpenMC')
@@ -1124,6 +2144,16 @@ class Settings:
             element = ET.SubElement(root, "generations_per_batch")
             element.text = str(self._generations_per_batch)
 
+    def _create_guide_table_cells_subelement(self, root):
+        if self._guide_table_cells is not None:
+            elem = ET.SubElement(root, "guide_table_cells")
+            elem.text = str(self._guide_table_cells)
+
+    def _create_inelastic_scatter_cdf_subelement(self, root):
+        if self._inelastic_scatter_cdf is not None:
+            elem = ET.SubElement(root, "inelastic_scatter_cdf")
+            elem.text = str(self._inelastic_scatter_cdf).lower()
+
     def _create_inactive_subelement(self, root):
         if self._inactive is not None:
             element = ET.SubElement(root, "inactive")
@@ -1156,6 +2186,23 @@ class Settings:
                 subelement = ET.SubElement(element, key)
                 subelement.text = str(value).lower()
 
+    def _create_source_convergence_subelement(self, root):
+        if self._source_convergence is not None:
+            element = ET.SubElement(root, "source_convergence")
+            for key, value in self._source_convergence.items():
+                subelement = ET.SubElement(element, key)
+                subelement.text = str(value)
+
+    def _create_source_domain_bounds_subelement(self, root):
+        if self._source_domain_bounds is not None:
+            elem = ET.SubElement(root, "source_domain_bounds")
+            elem.text = str(self._source_domain_bounds).lower()
+
+    def _create_census_times_subelement(self, root):
+        if self._census_times is not None:
+            elem = ET.SubElement(root, "census_times")
+            elem.text = ' '.join(str(t) for t in self._census_times)
+
     def _create_energy_mode_subelement(self, root):
         if self._energy_mode is not None:
             element = ET.SubElement(root, "energy_mode")
@@ -1166,6 +2213,11 @@ class Settings:
             element = ET.SubElement(root, "max_order")
             element.text = str(self._max_order)
 
+    def _create_mg_alias_sampling_subelement(self, root):
+        if self._mg_alias_sampling is not None:
+            elem = ET.SubElement(root, "mg_alias_sampling")
+            elem.text = str(self._mg_alias_sampling).lower()
+
     def _create_source_subelement(self, root, mesh_memo=None):
         for source in self.source:
             root.append(source.to_xml_element())
@@ -1192,7 +2244,7 @@ class Settings:
                 if key in ('summary', 'tallies'):
                     subelement.text = str(value).lower()
                 else:
-                    subelement.text = value
+                    subelement.text = str(value)
 
     def _create_verbosity_subelement(self, root):
         if self._verbosity is not None:
@@ -1206,6 +2258,12 @@ class Settings:
                 subelement = ET.SubElement(element, "batches")
                 subelement.text = ' '.join(
                     str(x) for x in self._statepoint['batches'])
+            if 'async' in self._statepoint:
+                subelement = ET.SubElement(element, "async")
+                subelement.text = str(self._statepoint['async']).lower()
+            if 'delta' in self._statepoint:
+                subelement = ET.SubElement(element, "delta")
+                subelement.text = str(self._statepoint['delta'])
 
     def _create_sourcepoint_subelement(self, root):
         if self._sourcepoint:
@@ -1233,6 +2291,10 @@ class Settings:
                 subelement = ET.SubElement(element, "mcpl")
                 subelement.text = str(self._sourcepoint['mcpl']).lower()
 
+            if 'sharded' in self._sourcepoint:
+                subelement = ET.SubElement(element, "sharded")
+                subelement.text = str(self._sourcepoint['sharded']).lower()
+
     def _create_surf_source_read_subelement(self, root):
         if self._surf_source_read:
             element = ET.SubElement(root, "surf_source_read")
@@ -1248,9 +2310,10 @@ class Settings:
                 subelement.text = " ".join(
                     str(x) for x in self._surf_source_write["surface_ids"]
                 )
-            if "mcpl" in self._surf_source_write:
-                subelement = ET.SubElement(element, "mcpl")
-                subelement.text = str(self._surf_source_write["mcpl"]).lower()
+            for key in ("mcpl", "streaming"):
+                if key in self._surf_source_write:
+                    subelement = ET.SubElement(element, key)
+                    subelement.text = str(self._surf_source_write[key]).lower()
             for key in ("max_particles", "cell", "cellfrom", "cellto"):
                 if key in self._surf_source_write:
                     subelement = ET.SubElement(element, key)
@@ -1266,21 +2329,81 @@ class Settings:
             element = ET.SubElement(root, "electron_treatment")
             element.text = str(self._electron_treatment)
 
+    def _create_electron_inline_deposition_subelement(self, root):
+        if self._electron_inline_deposition is not None:
+            elem = ET.SubElement(root, "electron_inline_deposition")
+            elem.text = str(self._electron_inline_deposition).lower()
+
     def _create_photon_transport_subelement(self, root):
         if self._photon_transport is not None:
             element = ET.SubElement(root, "photon_transport")
             element.text = str(self._photon_transport).lower()
 
+    def _create_photon_material_xs_subelement(self, root):
+        if self._photon_material_xs is not None:
+            elem = ET.SubElement(root, "photon_material_xs")
+            elem.text = str(self._photon_material_xs).lower()
+
+    def _create_photon_only_subelement(self, root):
+        if self._photon_only is not None:
+            elem = ET.SubElement(root, "photon_only")
+            elem.text = str(self._photon_only).lower()
+
+    def _create_photon_product_cdf_subelement(self, root):
+        if self._photon_product_cdf is not None:
+            elem = ET.SubElement(root, "photon_product_cdf")
+            elem.text = str(self._photon_product_cdf).lower()
+
+    def _create_photon_xs_tolerance_subelement(self, root):
+        if self._photon_xs_tolerance is not None:
+            elem = ET.SubElement(root, "photon_xs_tolerance")
+            elem.text = str(self._photon_xs_tolerance)
+
+    def _create_ncrystal_xs_tolerance_subelement(self, root):
+        if self._ncrystal_xs_tolerance is not None:
+            elem = ET.SubElement(root, "ncrystal_xs_tolerance")
+            elem.text = str(self._ncrystal_xs_tolerance)
+
     def _create_plot_seed_subelement(self, root):
         if self._plot_seed is not None:
             element = ET.SubElement(root, "plot_seed")
             element.text = str(self._plot_seed)
 
+    def _create_prune_nuclear_data_subelement(self, root):
+        if self._prune_nuclear_data is not None:
+            elem = ET.SubElement(root, "prune_nuclear_data")
+            elem.text = str(self._prune_nuclear_data).lower()
+
     def _create_ptables_subelement(self, root):
         if self._ptables is not None:
             element = ET.SubElement(root, "ptables")
             element.text = str(self._ptables).lower()
 
+    def _create_vectorized_xs_subelement(self, root):
+        if self._vectorized_xs is not None:
+            elem = ET.SubElement(root, "vectorized_xs")
+            elem.text = str(self._vectorized_xs).lower()
+
+    def _create_shared_xs_subelement(self, root):
+        if self._shared_xs is not None:
+            elem = ET.SubElement(root, "shared_xs")
+            elem.text = str(self._shared_xs).lower()
+
+    def _create_simplify_regions_subelement(self, root):
+        if self._simplify_regions is not None:
+            elem = ET.SubElement(root, "simplify_regions")
+            elem.text = str(self._simplify_regions).lower()
+
+    def _create_xs_cache_subelement(self, root):
+        if self._xs_cache is not None:
+            elem = ET.SubElement(root, "xs_cache")
+            elem.text = str(self._xs_cache)
+
+    def _create_telemetry_subelement(self, root):
+        if self._telemetry is not None:
+            elem = ET.SubElement(root, "telemetry")
+            elem.text = str(self._telemetry)
+
     def _create_seed_subelement(self, root):
         if self._seed is not None:
             element = ET.SubElement(root, "seed")
@@ -1291,6 +2414,51 @@ class Settings:
             element = ET.SubElement(root, "survival_biasing")
             element.text = str(self._survival_biasing).lower()
 
+    def _create_surface_distance_cache_subelement(self, root):
+        if self._surface_distance_cache is not None:
+            elem = ET.SubElement(root, "surface_distance_cache")
+            elem.text = str(self._surface_distance_cache).lower()
+
+    def _create_neighbor_list_reorder_subelement(self, root):
+        if self._neighbor_list_reorder is not None:
+            elem = ET.SubElement(root, "neighbor_list_reorder")
+            elem.text = str(self._neighbor_list_reorder).lower()
+
+    def _create_neighbor_list_precompute_subelement(self, root):
+        if self._neighbor_list_precompute is not None:
+            elem = ET.SubElement(root, "neighbor_list_precompute")
+            elem.text = str(self._neighbor_list_precompute).lower()
+
+    def _create_geometry_cache_subelement(self, root):
+        if self._geometry_cache is not None:
+            elem = ET.SubElement(root, "geometry_cache")
+            elem.text = str(self._geometry_cache)
+
+    def _create_thread_stats_subelement(self, root):
+        if self._thread_stats is not None:
+            elem = ET.SubElement(root, "thread_stats")
+            elem.text = str(self._thread_stats).lower()
+
+    def _create_thread_affinity_subelement(self, root):
+        if self._thread_affinity is not None:
+            elem = ET.SubElement(root, "thread_affinity")
+            elem.text = self._thread_affinity
+
+    def _create_numa_interleave_subelement(self, root):
+        if self._numa_interleave is not None:
+            elem = ET.SubElement(root, "numa_interleave")
+            elem.text = str(self._numa_interleave).lower()
+
+    def _create_profile_subelement(self, root):
+        if self._profile is not None:
+            elem = ET.SubElement(root, "profile")
+            elem.text = str(self._profile).lower()
+
+    def _create_memory_report_subelement(self, root):
+        if self._memory_report is not None:
+            elem = ET.SubElement(root, "memory_report")
+            elem.text = str(self._memory_report).lower()
+
     def _create_cutoff_subelement(self, root):
         if self._cutoff is not None:
             element = ET.SubElement(root, "cutoff")
@@ -1347,6 +2515,26 @@ class Settings:
             element = ET.SubElement(root, "no_reduce")
             element.text = str(self._no_reduce).lower()
 
+    def _create_overlap_reduction_subelement(self, root):
+        if self._overlap_reduction is not None:
+            elem = ET.SubElement(root, "overlap_reduction")
+            elem.text = str(self._overlap_reduction).lower()
+
+    def _create_hierarchical_reduce_subelement(self, root):
+        if self._hierarchical_reduce is not None:
+            elem = ET.SubElement(root, "hierarchical_reduce")
+            elem.text = str(self._hierarchical_reduce).lower()
+
+    def _create_overlap_bank_sync_subelement(self, root):
+        if self._overlap_bank_sync is not None:
+            elem = ET.SubElement(root, "overlap_bank_sync")
+            elem.text = str(self._overlap_bank_sync).lower()
+
+    def _create_pipeline_batches_subelement(self, root):
+        if self._pipeline_batches is not None:
+            elem = ET.SubElement(root, "pipeline_batches")
+            elem.text = str(self._pipeline_batches).lower()
+
     def _create_tabular_legendre_subelements(self, root):
         if self.tabular_legendre:
             element = ET.SubElement(root, "tabular_legendre")
@@ -1393,6 +2581,23 @@ class Settings:
             root.append(self.ufs_mesh.to_xml_element())
             if mesh_memo is not None: mesh_memo.add(self.ufs_mesh.id)
 
+    def _create_fission_matrix_mesh_subelement(self, root, mesh_memo=None):
+        if self.fission_matrix_mesh is None:
+            return
+
+        subelement = ET.SubElement(root, "fission_matrix_mesh")
+        subelement.text = str(self.fission_matrix_mesh.id)
+
+        if mesh_memo and self.fission_matrix_mesh.id in mesh_memo:
+            return
+
+        # See if a <mesh> element already exists -- if not, add it
+        path = f"./mesh[@id='{self.fission_matrix_mesh.id}']"
+        if root.find(path) is None:
+            root.append(self.fission_matrix_mesh.to_xml_element())
+            if mesh_memo is not None:
+                mesh_memo.add(self.fission_matrix_mesh.id)
+
     def _create_resonance_scattering_subelement(self, root):
         res = self.resonance_scattering
         if res:
@@ -1428,11 +2633,58 @@ class Settings:
             elem = ET.SubElement(root, "delayed_photon_scaling")
             elem.text = str(self._delayed_photon_scaling).lower()
 
+    def _create_delta_tracking_cells_subelement(self, root):
+        if self._delta_tracking_cells:
+            elem = ET.SubElement(root, "delta_tracking_cells")
+            elem.text = ' '.join(
+                str(c.id if isinstance(c, Cell) else c)
+                for c in self._delta_tracking_cells)
+
+    def _create_compact_micro_xs_subelement(self, root):
+        if self._compact_micro_xs is not None:
+            elem = ET.SubElement(root, "compact_micro_xs")
+            elem.text = str(self._compact_micro_xs).lower()
+
     def _create_event_based_subelement(self, root):
         if self._event_based is not None:
             elem = ET.SubElement(root, "event_based")
             elem.text = str(self._event_based).lower()
 
+    def _create_event_queue_sort_subelement(self, root):
+        if self._event_queue_sort is not None:
+            elem = ET.SubElement(root, "event_queue_sort")
+            elem.text = str(self._event_queue_sort).lower()
+
+    def _create_event_autotune_subelement(self, root):
+        if self._event_autotune is not None:
+            elem = ET.SubElement(root, "event_autotune")
+            elem.text = str(self._event_autotune).lower()
+
+    def _create_load_balancing_subelement(self, root):
+        if self._load_balancing is not None:
+            elem = ET.SubElement(root, "load_balancing")
+            elem.text = str(self._load_balancing).lower()
+
+    def _create_event_xs_queue_groups_subelement(self, root):
+        if self._event_xs_queue_groups is not None:
+            elem = ET.SubElement(root, "event_xs_queue_groups")
+            elem.text = str(self._event_xs_queue_groups)
+
+    def _create_event_history_tail_subelement(self, root):
+        if self._event_history_tail is not None:
+            elem = ET.SubElement(root, "event_history_tail")
+            elem.text = str(self._event_history_tail)
+
+    def _create_event_secondary_queue_subelement(self, root):
+        if self._event_secondary_queue is not None:
+            elem = ET.SubElement(root, "event_secondary_queue")
+            elem.text = str(self._event_secondary_queue).lower()
+
+    def _create_event_thread_pool_subelement(self, root):
+        if self._event_thread_pool is not None:
+            elem = ET.SubElement(root, "event_thread_pool")
+            elem.text = str(self._event_thread_pool)
+
     def _create_max_particles_in_flight_subelement(self, root):
         if self._max_particles_in_flight is not None:
             elem = ET.SubElement(root, "max_particles_in_flight")
@@ -1453,11 +2705,50 @@ class Settings:
             elem = ET.SubElement(root, "log_grid_bins")
             elem.text = str(self._log_grid_bins)
 
+    def _create_union_grid_memory_subelement(self, root):
+        if self._union_grid_memory is not None:
+            elem = ET.SubElement(root, "union_grid_memory")
+            elem.text = str(self._union_grid_memory)
+
+    def _create_tally_private_memory_subelement(self, root):
+        if self._tally_private_memory is not None:
+            elem = ET.SubElement(root, "tally_private_memory")
+            elem.text = str(self._tally_private_memory)
+
+    def _create_tally_stream_subelement(self, root):
+        if self._tally_stream:
+            element = ET.SubElement(root, "tally_stream")
+            for key in ("engine", "name"):
+                if key in self._tally_stream:
+                    subelement = ET.SubElement(element, key)
+                    subelement.text = self._tally_stream[key]
+            if "tally_ids" in self._tally_stream:
+                subelement = ET.SubElement(element, "tally_ids")
+                subelement.text = " ".join(
+                    str(x) for x in self._tally_stream["tally_ids"])
+
+    def _create_track_buffer_memory_subelement(self, root):
+        if self._track_buffer_memory is not None:
+            elem = ET.SubElement(root, "track_buffer_memory")
+            elem.text = str(self._track_buffer_memory)
+
     def _create_write_initial_source_subelement(self, root):
         if self._write_initial_source is not None:
             elem = ET.SubElement(root, "write_initial_source")
             elem.text = str(self._write_initial_source).lower()
 
+    def _create_warm_start_subelement(self, root):
+        if self._warm_start is not None:
+            element = ET.SubElement(root, "warm_start")
+            for key, value in self._warm_start.items():
+                subelement = ET.SubElement(element, key)
+                subelement.text = str(value)
+
+    def _create_wielandt_shift_subelement(self, root):
+        if self._wielandt_shift is not None:
+            elem = ET.SubElement(root, "wielandt_shift")
+            elem.text = str(self._wielandt_shift)
+
     def _create_weight_windows_subelement(self, root, mesh_memo=None):
         for ww in self._weight_windows:
             # Add weight window information
@@ -1514,6 +2805,18 @@ class Settings:
             subelement = ET.SubElement(element, "surface")
             subelement.text = str(self._weight_window_checkpoints['surface']).lower()
 
+    def _create_exponential_transforms_subelement(self, root):
+        for transform in self._exponential_transforms:
+            element = ET.SubElement(root, "exponential_transform")
+            subelement = ET.SubElement(element, "cells")
+            subelement.text = ' '.join(
+                str(c.id if isinstance(c, Cell) else c)
+                for c in transform['cells'])
+            subelement = ET.SubElement(element, "stretching")
+            subelement.text = str(transform['stretching'])
+            subelement = ET.SubElement(element, "direction")
+            subelement.text = ' '.join(str(u) for u in transform['direction'])
+
     def _create_max_history_splits_subelement(self, root):
         if self._max_history_splits is not None:
             elem = ET.SubElement(root, "max_history_splits")
@@ -1524,13 +2827,34 @@ class Settings:
             elem = ET.SubElement(root, "max_tracks")
             elem.text = str(self._max_tracks)
 
-    def _create_random_ray_subelement(self, root):
+    def _create_random_ray_subelement(self, root, mesh_memo=None):
         if self._random_ray:
             element = ET.SubElement(root, "random_ray")
             for key, value in self._random_ray.items():
                 if key == 'ray_source' and isinstance(value, SourceBase):
                     source_element = value.to_xml_element()
                     element.append(source_element)
+                elif key == 'source_region_mesh':
+                    mesh, cells = value if isinstance(value, tuple) else \
+                        (value, None)
+                    subelement = ET.SubElement(element, key)
+                    subelement.set('mesh', str(mesh.id))
+                    if cells is not None:
+                        subelement.set('cells', ' '.join(
+                            str(c.id if isinstance(c, Cell) else c)
+                            for c in cells))
+
+                    # See if a <mesh> element already exists -- if not, add it
+                    if mesh_memo and mesh.id in mesh_memo:
+                        continue
+                    path = f"./mesh[@id='{mesh.id}']"
+                    if root.find(path) is None:
+                        root.append(mesh.to_xml_element())
+                        if mesh_memo is not None:
+                            mesh_memo.add(mesh.id)
+                elif isinstance(value, bool):
+                    subelement = ET.SubElement(element, key)
+                    subelement.text = str(value).lower()
                 else:
                     subelement = ET.SubElement(element, key)
                     subelement.text = str(value)
@@ -1587,6 +2911,16 @@ class Settings:
         if text is not None:
             self.generations_per_batch = int(text)
 
+    def _guide_table_cells_from_xml_element(self, root):
+        text = get_text(root, 'guide_table_cells')
+        if text is not None:
+            self.guide_table_cells = int(text)
+
+    def _inelastic_scatter_cdf_from_xml_element(self, root):
+        text = get_text(root, 'inelastic_scatter_cdf')
+        if text is not None:
+            self.inelastic_scatter_cdf = text in ('true', '1')
+
     def _keff_trigger_from_xml_element(self, root):
         elem = root.find('keff_trigger')
         if elem is not None:
@@ -1594,6 +2928,26 @@ class Settings:
             threshold = float(get_text(elem, 'threshold'))
             self.keff_trigger = {'type': trigger, 'threshold': threshold}
 
+    def _source_convergence_from_xml_element(self, root):
+        elem = root.find('source_convergence')
+        if elem is not None:
+            self.source_convergence = {}
+            for key, kind in (('window', int), ('min_inactive', int),
+                              ('threshold', float)):
+                value = get_text(elem, key)
+                if value is not None:
+                    self.source_convergence[key] = kind(value)
+
+    def _source_domain_bounds_from_xml_element(self, root):
+        text = get_text(root, 'source_domain_bounds')
+        if text is not None:
+            self.source_domain_bounds = text in ('true', '1')
+
+    def _census_times_from_xml_element(self, root):
+        text = get_text(root, 'census_times')
+        if text is not None:
+            self.census_times = [float(x) for x in text.split()]
+
     def _source_from_xml_element(self, root, meshes=None):
         for elem in root.findall('source'):
             src = SourceBase.from_xml_element(elem, meshes)
@@ -1610,11 +2964,14 @@ class Settings:
         elem = root.find('output')
         if elem is not None:
             self.output = {}
-            for key in ('summary', 'tallies', 'path'):
+            for key in ('summary', 'tallies', 'path', 'compression',
+                        'compression_level', 'chunk_size'):
                 value = get_text(elem, key)
                 if value is not None:
                     if key in ('summary', 'tallies'):
                         value = value in ('true', '1')
+                    elif key in ('compression_level', 'chunk_size'):
+                        value = int(value)
                     self.output[key] = value
 
     def _statepoint_from_xml_element(self, root):
@@ -1623,14 +2980,21 @@ class Settings:
             text = get_text(elem, 'batches')
             if text is not None:
                 self.statepoint['batches'] = [int(x) for x in text.split()]
+            text = get_text(elem, 'async')
+            if text is not None:
+                self.statepoint['async'] = text in ('true', '1')
+            text = get_text(elem, 'delta')
+            if text is not None:
+                self.statepoint['delta'] = int(text)
 
     def _sourcepoint_from_xml_element(self, root):
         elem = root.find('source_point')
         if elem is not None:
-            for key in ('separate', 'write', 'overwrite_latest', 'batches', 'mcpl'):
+            for key in ('separate', 'write', 'overwrite_latest', 'batches',
+                        'mcpl', 'sharded'):
                 value = get_text(elem, key)
                 if value is not None:
-                    if key in ('separate', 'write', 'mcpl'):
+                    if key in ('separate', 'write', 'mcpl', 'sharded'):
                         value = value in ('true', '1')
                     elif key == 'overwrite_latest':
                         value = value in ('true', '1')
@@ -1650,12 +3014,13 @@ class Settings:
         elem = root.find('surf_source_write')
         if elem is None:
             return
-        for key in ('surface_ids', 'max_particles', 'mcpl', 'cell', 'cellto', 'cellfrom'):
+        for key in ('surface_ids', 'max_particles', 'mcpl', 'cell', 'cellto',
+                    'cellfrom', 'streaming'):
             value = get_text(elem, key)
             if value is not None:
                 if key == 'surface_ids':
                     value = [int(x) for x in value.split()]
-                elif key == 'mcpl':
+                elif key in ('mcpl', 'streaming'):
                     value = value in ('true', '1')
                 elif key in ('max_particles', 'cell', 'cellfrom', 'cellto'):
                     value = int(value)
@@ -1671,6 +3036,11 @@ class Settings:
         if text is not None:
             self.electron_treatment = text
 
+    def _electron_inline_deposition_from_xml_element(self, root):
+        text = get_text(root, 'electron_inline_deposition')
+        if text is not None:
+            self.electron_inline_deposition = text in ('true', '1')
+
     def _energy_mode_from_xml_element(self, root):
         text = get_text(root, 'energy_mode')
         if text is not None:
@@ -1681,21 +3051,81 @@ class Settings:
         if text is not None:
             self.max_order = int(text)
 
+    def _mg_alias_sampling_from_xml_element(self, root):
+        text = get_text(root, 'mg_alias_sampling')
+        if text is not None:
+            self.mg_alias_sampling = text in ('true', '1')
+
     def _photon_transport_from_xml_element(self, root):
         text = get_text(root, 'photon_transport')
         if text is not None:
             self.photon_transport = text in ('true', '1')
 
+    def _photon_material_xs_from_xml_element(self, root):
+        text = get_text(root, 'photon_material_xs')
+        if text is not None:
+            self.photon_material_xs = text in ('true', '1')
+
+    def _photon_only_from_xml_element(self, root):
+        text = get_text(root, 'photon_only')
+        if text is not None:
+            self.photon_only = text in ('true', '1')
+
+    def _photon_product_cdf_from_xml_element(self, root):
+        text = get_text(root, 'photon_product_cdf')
+        if text is not None:
+            self.photon_product_cdf = text in ('true', '1')
+
+    def _photon_xs_tolerance_from_xml_element(self, root):
+        text = get_text(root, 'photon_xs_tolerance')
+        if text is not None:
+            self.photon_xs_tolerance = float(text)
+
+    def _ncrystal_xs_tolerance_from_xml_element(self, root):
+        text = get_text(root, 'ncrystal_xs_tolerance')
+        if text is not None:
+            self.ncrystal_xs_tolerance = float(text)
+
     def _plot_seed_from_xml_element(self, root):
         text = get_text(root, 'plot_seed')
         if text is not None:
             self.plot_seed = int(text)
 
+    def _prune_nuclear_data_from_xml_element(self, root):
+        text = get_text(root, 'prune_nuclear_data')
+        if text is not None:
+            self.prune_nuclear_data = text in ('true', '1')
+
     def _ptables_from_xml_element(self, root):
         text = get_text(root, 'ptables')
         if text is not None:
             self.ptables = text in ('true', '1')
 
+    def _vectorized_xs_from_xml_element(self, root):
+        text = get_text(root, 'vectorized_xs')
+        if text is not None:
+            self.vectorized_xs = text in ('true', '1')
+
+    def _shared_xs_from_xml_element(self, root):
+        text = get_text(root, 'shared_xs')
+        if text is not None:
+            self.shared_xs = text in ('true', '1')
+
+    def _simplify_regions_from_xml_element(self, root):
+        text = get_text(root, 'simplify_regions')
+        if text is not None:
+            self.simplify_regions = text in ('true', '1')
+
+    def _xs_cache_from_xml_element(self, root):
+        text = get_text(root, 'xs_cache')
+        if text is not None:
+            self.xs_cache = text
+
+    def _telemetry_from_xml_element(self, root):
+        text = get_text(root, 'telemetry')
+        if text is not None:
+            self.telemetry = text
+
     def _seed_from_xml_element(self, root):
         text = get_text(root, 'seed')
         if text is not None:
@@ -1706,6 +3136,51 @@ class Settings:
         if text is not None:
             self.survival_biasing = text in ('true', '1')
 
+    def _surface_distance_cache_from_xml_element(self, root):
+        text = get_text(root, 'surface_distance_cache')
+        if text is not None:
+            self.surface_distance_cache = text in ('true', '1')
+
+    def _neighbor_list_reorder_from_xml_element(self, root):
+        text = get_text(root, 'neighbor_list_reorder')
+        if text is not None:
+            self.neighbor_list_reorder = text in ('true', '1')
+
+    def _neighbor_list_precompute_from_xml_element(self, root):
+        text = get_text(root, 'neighbor_list_precompute')
+        if text is not None:
+            self.neighbor_list_precompute = text in ('true', '1')
+
+    def _geometry_cache_from_xml_element(self, root):
+        text = get_text(root, 'geometry_cache')
+        if text is not None:
+            self.geometry_cache = text
+
+    def _thread_stats_from_xml_element(self, root):
+        text = get_text(root, 'thread_stats')
+        if text is not None:
+            self.thread_stats = text in ('true', '1')
+
+    def _thread_affinity_from_xml_element(self, root):
+        text = get_text(root, 'thread_affinity')
+        if text is not None:
+            self.thread_affinity = text
+
+    def _numa_interleave_from_xml_element(self, root):
+        text = get_text(root, 'numa_interleave')
+        if text is not None:
+            self.numa_interleave = text in ('true', '1')
+
+    def _profile_from_xml_element(self, root):
+        text = get_text(root, 'profile')
+        if text is not None:
+            self.profile = text in ('true', '1')
+
+    def _memory_report_from_xml_element(self, root):
+        text = get_text(root, 'memory_report')
+        if text is not None:
+            self.memory_report = text in ('true', '1')
+
     def _cutoff_from_xml_element(self, root):
         elem = root.find('cutoff')
         if elem is not None:
@@ -1742,6 +3217,26 @@ class Settings:
         if text is not None:
             self.no_reduce = text in ('true', '1')
 
+    def _overlap_reduction_from_xml_element(self, root):
+        text = get_text(root, 'overlap_reduction')
+        if text is not None:
+            self.overlap_reduction = text in ('true', '1')
+
+    def _hierarchical_reduce_from_xml_element(self, root):
+        text = get_text(root, 'hierarchical_reduce')
+        if text is not None:
+            self.hierarchical_reduce = text in ('true', '1')
+
+    def _overlap_bank_sync_from_xml_element(self, root):
+        text = get_text(root, 'overlap_bank_sync')
+        if text is not None:
+            self.overlap_bank_sync = text in ('true', '1')
+
+    def _pipeline_batches_from_xml_element(self, root):
+        text = get_text(root, 'pipeline_batches')
+        if text is not None:
+            self.pipeline_batches = text in ('true', '1')
+
     def _verbosity_from_xml_element(self, root):
         text = get_text(root, 'verbosity')
         if text is not None:
@@ -1793,6 +3288,15 @@ class Settings:
             raise ValueError(f'Could not locate mesh with ID "{mesh_id}"')
         self.ufs_mesh = meshes[mesh_id]
 
+    def _fission_matrix_mesh_from_xml_element(self, root, meshes):
+        text = get_text(root, 'fission_matrix_mesh')
+        if text is None:
+            return
+        mesh_id = int(text)
+        if mesh_id not in meshes:
+            raise ValueError(f'Could not locate mesh with ID "{mesh_id}"')
+        self.fission_matrix_mesh = meshes[mesh_id]
+
     def _resonance_scattering_from_xml_element(self, root):
         elem = root.find('resonance_scattering')
         if elem is not None:
@@ -1823,11 +3327,56 @@ class Settings:
         if text is not None:
             self.delayed_photon_scaling = text in ('true', '1')
 
+    def _delta_tracking_cells_from_xml_element(self, root):
+        text = get_text(root, 'delta_tracking_cells')
+        if text is not None:
+            self.delta_tracking_cells = [int(x) for x in text.split()]
+
+    def _compact_micro_xs_from_xml_element(self, root):
+        text = get_text(root, 'compact_micro_xs')
+        if text is not None:
+            self.compact_micro_xs = text in ('true', '1')
+
     def _event_based_from_xml_element(self, root):
         text = get_text(root, 'event_based')
         if text is not None:
             self.event_based = text in ('true', '1')
 
+    def _event_queue_sort_from_xml_element(self, root):
+        text = get_text(root, 'event_queue_sort')
+        if text is not None:
+            self.event_queue_sort = text in ('true', '1')
+
+    def _event_autotune_from_xml_element(self, root):
+        text = get_text(root, 'event_autotune')
+        if text is not None:
+            self.event_autotune = text in ('true', '1')
+
+    def _load_balancing_from_xml_element(self, root):
+        text = get_text(root, 'load_balancing')
+        if text is not None:
+            self.load_balancing = text in ('true', '1')
+
+    def _event_xs_queue_groups_from_xml_element(self, root):
+        text = get_text(root, 'event_xs_queue_groups')
+        if text is not None:
+            self.event_xs_queue_groups = int(text)
+
+    def _event_history_tail_from_xml_element(self, root):
+        text = get_text(root, 'event_history_tail')
+        if text is not None:
+            self.event_history_tail = int(text)
+
+    def _event_secondary_queue_from_xml_element(self, root):
+        text = get_text(root, 'event_secondary_queue')
+        if text is not None:
+            self.event_secondary_queue = text in ('true', '1')
+
+    def _event_thread_pool_from_xml_element(self, root):
+        text = get_text(root, 'event_thread_pool')
+        if text is not None:
+            self.event_thread_pool = int(text)
+
     def _max_particles_in_flight_from_xml_element(self, root):
         text = get_text(root, 'max_particles_in_flight')
         if text is not None:
@@ -1848,11 +3397,53 @@ class Settings:
         if text is not None:
             self.log_grid_bins = int(text)
 
+    def _union_grid_memory_from_xml_element(self, root):
+        text = get_text(root, 'union_grid_memory')
+        if text is not None:
+            self.union_grid_memory = float(text)
+
+    def _tally_private_memory_from_xml_element(self, root):
+        text = get_text(root, 'tally_private_memory')
+        if text is not None:
+            self.tally_private_memory = float(text)
+
+    def _tally_stream_from_xml_element(self, root):
+        elem = root.find('tally_stream')
+        if elem is None:
+            return
+        for key in ('engine', 'name', 'tally_ids'):
+            value = get_text(elem, key)
+            if value is not None:
+                if key == 'tally_ids':
+                    value = [int(x) for x in value.split()]
+                self.tally_stream[key] = value
+
+    def _track_buffer_memory_from_xml_element(self, root):
+        text = get_text(root, 'track_buffer_memory')
+        if text is not None:
+            self.track_buffer_memory = float(text)
+
     def _write_initial_source_from_xml_element(self, root):
         text = get_text(root, 'write_initial_source')
         if text is not None:
             self.write_initial_source = text in ('true', '1')
 
+    def _warm_start_from_xml_element(self, root):
+        elem = root.find('warm_start')
+        if elem is not None:
+            self.warm_start = {}
+            value = get_text(elem, 'inactive')
+            if value is not None:
+                self.warm_start['inactive'] = int(value)
+            value = get_text(elem, 'entropy_tolerance')
+            if value is not None:
+                self.warm_start['entropy_tolerance'] = float(value)
+
+    def _wielandt_shift_from_xml_element(self, root):
+        text = get_text(root, 'wielandt_shift')
+        if text is not None:
+            self.wielandt_shift = float(text)
+
     def _weight_window_generators_from_xml_element(self, root, meshes=None):
         for elem in root.iter('weight_windows_generator'):
             wwg = WeightWindowGenerator.from_xml_element(elem, meshes)
@@ -1877,6 +3468,18 @@ class Settings:
                 value = value in ('true', '1')
                 self.weight_window_checkpoints[key] = value
 
+    def _exponential_transforms_from_xml_element(self, root):
+        transforms = []
+        for elem in root.findall('exponential_transform'):
+            transforms.append({
+                'cells': [int(x) for x in get_text(elem, 'cells').split()],
+                'stretching': float(get_text(elem, 'stretching')),
+                'direction': tuple(
+                    float(x) for x in get_text(elem, 'direction').split())
+            })
+        if transforms:
+            self.exponential_transforms = transforms
+
     def _max_history_splits_from_xml_element(self, root):
         text = get_text(root, 'max_history_splits')
         if text is not None:
@@ -1887,7 +3490,7 @@ class Settings:
         if text is not None:
             self.max_tracks = int(text)
 
-    def _random_ray_from_xml_element(self, root):
+    def _random_ray_from_xml_element(self, root, meshes=None):
         elem = root.find('random_ray')
         if elem is not None:
             self.random_ray = {}
@@ -1901,10 +3504,25 @@ class Settings:
                     self.random_ray['volume_estimator'] = child.text
                 elif child.tag == 'source_shape':
                     self.random_ray['source_shape'] = child.text
-                elif child.tag == 'volume_normalized_flux_tallies':
-                    self.random_ray['volume_normalized_flux_tallies'] = (
-                        child.text in ('true', '1')
-                    )
+                elif child.tag in ('volume_normalized_flux_tallies',
+                                   'adjoint'):
+                    self.random_ray[child.tag] = child.text in ('true', '1')
+                elif child.tag in ('segment_cache_iterations',
+                                   'anderson_depth'):
+                    self.random_ray[child.tag] = int(child.text)
+                elif child.tag == 'segment_cache_memory':
+                    self.random_ray[child.tag] = float(child.text)
+                elif child.tag == 'source_region_mesh':
+                    mesh_id = int(child.get('mesh'))
+                    if meshes is None or mesh_id not in meshes:
+                        raise ValueError(
+                            f'Could not locate mesh with ID "{mesh_id}"')
+                    cells = child.get('cells')
+                    if cells is None:
+                        self.random_ray[child.tag] = meshes[mesh_id]
+                    else:
+                        self.random_ray[child.tag] = (
+                            meshes[mesh_id], [int(c) for c in cells.split()])
 
     def to_xml_element(self, mesh_memo=None):
         """Create a 'settings' element to be written to an XML file.
@@ -1925,7 +3543,12 @@ class Settings:
         self._create_rel_max_lost_particles_subelement(element)
         self._create_max_write_lost_particles_subelement(element)
         self._create_generations_per_batch_subelement(element)
+        self._create_guide_table_cells_subelement(element)
+        self._create_inelastic_scatter_cdf_subelement(element)
         self._create_keff_trigger_subelement(element)
+        self._create_source_convergence_subelement(element)
+        self._create_source_domain_bounds_subelement(element)
+        self._create_census_times_subelement(element)
         self._create_source_subelement(element, mesh_memo)
         self._create_output_subelement(element)
         self._create_statepoint_subelement(element)
@@ -1934,41 +3557,84 @@ class Settings:
         self._create_surf_source_write_subelement(element)
         self._create_confidence_intervals(element)
         self._create_electron_treatment_subelement(element)
+        self._create_electron_inline_deposition_subelement(element)
         self._create_energy_mode_subelement(element)
         self._create_max_order_subelement(element)
+        self._create_mg_alias_sampling_subelement(element)
         self._create_photon_transport_subelement(element)
+        self._create_photon_xs_tolerance_subelement(element)
+        self._create_ncrystal_xs_tolerance_subelement(element)
+        self._create_photon_material_xs_subelement(element)
+        self._create_photon_only_subelement(element)
+        self._create_photon_product_cdf_subelement(element)
         self._create_plot_seed_subelement(element)
         self._create_ptables_subelement(element)
+        self._create_prune_nuclear_data_subelement(element)
+        self._create_vectorized_xs_subelement(element)
+        self._create_shared_xs_subelement(element)
+        self._create_simplify_regions_subelement(element)
+        self._create_xs_cache_subelement(element)
+        self._create_telemetry_subelement(element)
         self._create_seed_subelement(element)
         self._create_survival_biasing_subelement(element)
+        self._create_surface_distance_cache_subelement(element)
+        self._create_neighbor_list_reorder_subelement(element)
+        self._create_neighbor_list_precompute_subelement(element)
+        self._create_geometry_cache_subelement(element)
+        self._create_thread_stats_subelement(element)
+        self._create_thread_affinity_subelement(element)
+        self._create_numa_interleave_subelement(element)
+        self._create_profile_subelement(element)
+        self._create_memory_report_subelement(element)
         self._create_cutoff_subelement(element)
         self._create_entropy_mesh_subelement(element, mesh_memo)
         self._create_trigger_subelement(element)
         self._create_no_reduce_subelement(element)
+        self._create_overlap_reduction_subelement(element)
+        self._create_hierarchical_reduce_subelement(element)
+        self._create_overlap_bank_sync_subelement(element)
+        self._create_pipeline_batches_subelement(element)
         self._create_verbosity_subelement(element)
         self._create_tabular_legendre_subelements(element)
         self._create_temperature_subelements(element)
         self._create_trace_subelement(element)
         self._create_track_subelement(element)
         self._create_ufs_mesh_subelement(element, mesh_memo)
+        self._create_fission_matrix_mesh_subelement(element, mesh_memo)
         self._create_resonance_scattering_subelement(element)
         self._create_volume_calcs_subelement(element)
         self._create_create_fission_neutrons_subelement(element)
         self._create_create_delayed_neutrons_subelement(element)
         self._create_delayed_photon_scaling_subelement(element)
+        self._create_delta_tracking_cells_subelement(element)
+        self._create_compact_micro_xs_subelement(element)
         self._create_event_based_subelement(element)
+        self._create_event_queue_sort_subelement(element)
+        self._create_event_autotune_subelement(element)
+        self._create_load_balancing_subelement(element)
+        self._create_event_xs_queue_groups_subelement(element)
+        self._create_event_history_tail_subelement(element)
+        self._create_event_secondary_queue_subelement(element)
+        self._create_event_thread_pool_subelement(element)
         self._create_max_particles_in_flight_subelement(element)
         self._create_max_events_subelement(element)
         self._create_material_cell_offsets_subelement(element)
         self._create_log_grid_bins_subelement(element)
+        self._create_union_grid_memory_subelement(element)
+        self._create_tally_private_memory_subelement(element)
+        self._create_tally_stream_subelement(element)
+        self._create_track_buffer_memory_subelement(element)
         self._create_write_initial_source_subelement(element)
+        self._create_wielandt_shift_subelement(element)
+        self._create_warm_start_subelement(element)
         self._create_weight_windows_subelement(element, mesh_memo)
         self._create_weight_window_generators_subelement(element, mesh_memo)
         self._create_weight_windows_file_element(element)
         self._create_weight_window_checkpoints_subelement(element)
+        self._create_exponential_transforms_subelement(element)
         self._create_max_history_splits_subelement(element)
         self._create_max_tracks_subelement(element)
-        self._create_random_ray_subelement(element)
+        self._create_random_ray_subelement(element, mesh_memo)
 
         # Clean the indentation in the file to be user-readable
         clean_indentation(element)
@@ -2030,7 +3696,12 @@ class Settings:
         settings._rel_max_lost_particles_from_xml_element(elem)
         settings._max_write_lost_particles_from_xml_element(elem)
         settings._generations_per_batch_from_xml_element(elem)
+        settings._guide_table_cells_from_xml_element(elem)
+        settings._inelastic_scatter_cdf_from_xml_element(elem)
         settings._keff_trigger_from_xml_element(elem)
+        settings._source_convergence_from_xml_element(elem)
+        settings._source_domain_bounds_from_xml_element(elem)
+        settings._census_times_from_xml_element(elem)
         settings._source_from_xml_element(elem, meshes)
         settings._volume_calcs_from_xml_element(elem)
         settings._output_from_xml_element(elem)
@@ -2040,39 +3711,82 @@ class Settings:
         settings._surf_source_write_from_xml_element(elem)
         settings._confidence_intervals_from_xml_element(elem)
         settings._electron_treatment_from_xml_element(elem)
+        settings._electron_inline_deposition_from_xml_element(elem)
         settings._energy_mode_from_xml_element(elem)
         settings._max_order_from_xml_element(elem)
+        settings._mg_alias_sampling_from_xml_element(elem)
         settings._photon_transport_from_xml_element(elem)
+        settings._photon_xs_tolerance_from_xml_element(elem)
+        settings._ncrystal_xs_tolerance_from_xml_element(elem)
+        settings._photon_material_xs_from_xml_element(elem)
+        settings._photon_only_from_xml_element(elem)
+        settings._photon_product_cdf_from_xml_element(elem)
         settings._plot_seed_from_xml_element(elem)
         settings._ptables_from_xml_element(elem)
+        settings._prune_nuclear_data_from_xml_element(elem)
+        settings._vectorized_xs_from_xml_element(elem)
+        settings._shared_xs_from_xml_element(elem)
+        settings._simplify_regions_from_xml_element(elem)
+        settings._xs_cache_from_xml_element(elem)
+        settings._telemetry_from_xml_element(elem)
         settings._seed_from_xml_element(elem)
         settings._survival_biasing_from_xml_element(elem)
+        settings._surface_distance_cache_from_xml_element(elem)
+        settings._neighbor_list_reorder_from_xml_element(elem)
+        settings._neighbor_list_precompute_from_xml_element(elem)
+        settings._geometry_cache_from_xml_element(elem)
+        settings._thread_stats_from_xml_element(elem)
+        settings._thread_affinity_from_xml_element(elem)
+        settings._numa_interleave_from_xml_element(elem)
+        settings._profile_from_xml_element(elem)
+        settings._memory_report_from_xml_element(elem)
         settings._cutoff_from_xml_element(elem)
         settings._entropy_mesh_from_xml_element(elem, meshes)
         settings._trigger_from_xml_element(elem)
         settings._no_reduce_from_xml_element(elem)
+        settings._overlap_reduction_from_xml_element(elem)
+        settings._hierarchical_reduce_from_xml_element(elem)
+        settings._overlap_bank_sync_from_xml_element(elem)
+        settings._pipeline_batches_from_xml_element(elem)
         settings._verbosity_from_xml_element(elem)
         settings._tabular_legendre_from_xml_element(elem)
         settings._temperature_from_xml_element(elem)
         settings._trace_from_xml_element(elem)
         settings._track_from_xml_element(elem)
         settings._ufs_mesh_from_xml_element(elem, meshes)
+        settings._fission_matrix_mesh_from_xml_element(elem, meshes)
         settings._resonance_scattering_from_xml_element(elem)
         settings._create_fission_neutrons_from_xml_element(elem)
         settings._create_delayed_neutrons_from_xml_element(elem)
         settings._delayed_photon_scaling_from_xml_element(elem)
+        settings._delta_tracking_cells_from_xml_element(elem)
+        settings._compact_micro_xs_from_xml_element(elem)
         settings._event_based_from_xml_element(elem)
+        settings._event_queue_sort_from_xml_element(elem)
+        settings._event_autotune_from_xml_element(elem)
+        settings._load_balancing_from_xml_element(elem)
+        settings._event_xs_queue_groups_from_xml_element(elem)
+        settings._event_history_tail_from_xml_element(elem)
+        settings._event_secondary_queue_from_xml_element(elem)
+        settings._event_thread_pool_from_xml_element(elem)
         settings._max_particles_in_flight_from_xml_element(elem)
         settings._max_particle_events_from_xml_element(elem)
         settings._material_cell_offsets_from_xml_element(elem)
         settings._log_grid_bins_from_xml_element(elem)
+        settings._union_grid_memory_from_xml_element(elem)
+        settings._tally_private_memory_from_xml_element(elem)
+        settings._tally_stream_from_xml_element(elem)
+        settings._track_buffer_memory_from_xml_element(elem)
         settings._write_initial_source_from_xml_element(elem)
+        settings._wielandt_shift_from_xml_element(elem)
+        settings._warm_start_from_xml_element(elem)
         settings._weight_windows_from_xml_element(elem, meshes)
         settings._weight_window_generators_from_xml_element(elem, meshes)
         settings._weight_window_checkpoints_from_xml_element(elem)
+        settings._exponential_transforms_from_xml_element(elem)
         settings._max_history_splits_from_xml_element(elem)
         settings._max_tracks_from_xml_element(elem)
-        settings._random_ray_from_xml_element(elem)
+        settings._random_ray_from_xml_element(elem, meshes)
 
         # TODO: Get volume calculations
         return settings
@@ -505,6 +505,13 @@ class MeshSource(SourceBase):
         should be accepted. The 'rejection_strategy' indicates what should
         happen when a source particle is rejected: either 'resample' (pick a new
         particle) or 'kill' (accept and terminate).
+    bias : sequence of float, optional
+        Biased strengths of the elements, in the same order as the sources.
+        When given, elements are sampled in proportion to these values and
+        source sites are weighted by the ratio of the normalized source strength
+        to the normalized biased strength of their element.
+
+        .. versionadded:: 0.15.1
 
     Attributes
     ----------
@@ -512,6 +519,8 @@ class MeshSource(SourceBase):
         The mesh over which source sites will be generated.
     sources : numpy.ndarray of openmc.SourceBase
         Sources to apply to each element
+    bias : numpy.ndarray or None
+        Biased strengths of the elements
     strength : float
         Strength of the source
     type : str
@@ -527,10 +536,12 @@ class MeshSource(SourceBase):
             mesh: MeshBase,
             sources: Sequence[SourceBase],
             constraints: dict[str, Any] | None  = None,
+            bias: Sequence[float] | None = None
     ):
         super().__init__(strength=None, constraints=constraints)
         self.mesh = mesh
         self.sources = sources
+        self.bias = bias
 
     @property
     def type(self) -> str:
@@ -581,6 +592,27 @@ class MeshSource(SourceBase):
                               'distributions that will be ignored at runtime.')
                 break
 
+    @property
+    def bias(self) -> np.ndarray | None:
+        return self._bias
+
+    @bias.setter
+    def bias(self, bias):
+        if bias is None:
+            self._bias = None
+            return
+        cv.check_iterable_type('mesh source bias', bias, Real, max_depth=3)
+        bias = np.asarray(bias, dtype=float)
+        if bias.ndim > 1:
+            bias = bias.ravel(order='F')
+        if bias.size != self.sources.size:
+            raise ValueError(
+                f'The length of the bias array ({bias.size}) does not match '
+                f'the number of sources ({self.sources.size}).')
+        for b in bias:
+            cv.check_greater_than('mesh source bias', b, 0.0, True)
+        self._bias = bias
+
     @strength.setter
     def strength(self, val):
         if val is not None:
@@ -620,6 +652,10 @@ class MeshSource(SourceBase):
         for s in self.sources:
             elem.append(s.to_xml_element())
 
+        if self.bias is not None:
+            subelem = ET.SubElement(elem, 'bias')
+            subelem.text = ' '.join(str(b) for b in self.bias)
+
     @classmethod
     def from_xml_element(cls, elem: ET.Element, meshes) -> openmc.MeshSource:
         """
@@ -643,7 +679,10 @@ class MeshSource(SourceBase):
 
         sources = [SourceBase.from_xml_element(e) for e in elem.iterchildren('source')]
         constraints = cls._get_constraints(elem)
-        return cls(mesh, sources, constraints=constraints)
+        bias = get_text(elem, 'bias')
+        if bias is not None:
+            bias = [float(b) for b in bias.split()]
+        return cls(mesh, sources, constraints=constraints, bias=bias)
 
 
 def Source(*args, **kwargs):
@@ -796,6 +835,11 @@ class FileSource(SourceBase):
         Path to the source file from which sites should be sampled
     strength : float
         Strength of the source (default is 1.0)
+    partitioned : bool
+        Whether each process reads and samples only its own part of the sites
+        in the file (default is False)
+
+        .. versionadded:: 0.15.1
     constraints : dict
         Constraints on sampled source particles. Valid keys include 'domains',
         'time_bounds', 'energy_bounds', 'fissionable', and 'rejection_strategy'.
@@ -816,6 +860,9 @@ class FileSource(SourceBase):
         Source file from which sites should be sampled
     strength : float
         Strength of the source
+    partitioned : bool
+        Whether each process reads and samples only its own part of the sites
+        in the file
     type : str
         Indicator of source type: 'file'
     constraints : dict
@@ -829,12 +876,14 @@ class FileSource(SourceBase):
         self,
         path: PathLike | None = None,
         strength: float = 1.0,
-        constraints: dict[str, Any] | None = None
+        constraints: dict[str, Any] | None = None,
+        partitioned: bool = False
     ):
         super().__init__(strength=strength, constraints=constraints)
         self._path = None
         if path is not None:
             self.path = path
+        self.partitioned = partitioned
 
     @property
     def type(self) -> str:
@@ -849,6 +898,15 @@ class FileSource(SourceBase):
         cv.check_type('source file', p, str)
         self._path = p
 
+    @property
+    def partitioned(self) -> bool:
+        return self._partitioned
+
+    @partitioned.setter
+    def partitioned(self, partitioned: bool):
+        cv.check_type('partitioned source file', partitioned, bool)
+        self._partitioned = partitioned
+
     def populate_xml_element(self, element):
         """Add necessary file source information to an XML element
 
@@ -860,6 +918,8 @@ class FileSource(SourceBase):
         """
         if self.path is not None:
             element.set("file", self.path)
+        if self.partitioned:
+            element.set("partitioned", "true")
 
     @classmethod
     def from_xml_element(cls, elem: ET.Element) -> openmc.FileSource:
@@ -881,6 +941,9 @@ class FileSource(SourceBase):
         """
         kwargs = {'constraints': cls._get_constraints(elem)}
         kwargs['path'] = get_text(elem, 'file')
+        partitioned = get_text(elem, 'partitioned')
+        if partitioned is not None:
+            kwargs['partitioned'] = partitioned in ('true', '1')
         strength = get_text(elem, 'strength')
         if strength is not None:
             kwargs['strength'] = float(strength)
@@ -95,7 +95,8 @@ class StatePoint:
         Simulation run mode, e.g. 'eigenvalue'
     runtime : dict
         Dictionary whose keys are strings describing various runtime metrics
-        and whose values are time values in seconds.
+        and whose values are time values in seconds, or particles per second
+        for the calculation rates.
     seed : int
         Pseudorandom number generator seed
     source : numpy.ndarray of compound datatype
@@ -115,6 +116,14 @@ class StatePoint:
     tally_derivatives : dict
         Dictionary whose keys are tally derivative IDs and whose values are
         TallyDerivative objects
+    thread_stats : dict or None
+        Work done by each thread of each process in turn, if
+        :attr:`openmc.Settings.thread_stats` was set. The keys 'time',
+        'histories', 'segments', 'collisions', and 'surface_crossings' give
+        arrays with one value per thread, and 'n_threads' gives the number of
+        threads of each process.
+
+        .. versionadded:: 0.15.1
     version: tuple of Integral
         Version of OpenMC
     summary : None or openmc.Summary
@@ -349,7 +358,8 @@ class StatePoint:
     @property
     def runtime(self):
         return {name: dataset[()]
-                for name, dataset in self._f['runtime'].items()}
+                for name, dataset in self._f['runtime'].items()
+                if isinstance(dataset, h5py.Dataset)}
 
     @property
     def seed(self):
@@ -428,6 +438,14 @@ class StatePoint:
                     tally.estimator = group['estimator'][()].decode()
                     tally.num_realizations = n_realizations
 
+                    # Read the figure of merit of each active batch
+                    if 'figure_of_merit' in group:
+                        tally.figure_of_merit = True
+                        tally._fom_history = {
+                            key: value[()] for key, value in
+                            group['figure_of_merit'].items()
+                        }
+
                     # Read derivative information.
                     if 'derivative' in group:
                         deriv_id = group['derivative'][()]
@@ -496,6 +514,13 @@ class StatePoint:
 
         return self._derivs
 
+    @property
+    def thread_stats(self):
+        if 'threads' not in self._f['runtime']:
+            return None
+        return {name: dataset[()]
+                for name, dataset in self._f['runtime/threads'].items()}
+
     @property
     def version(self):
         return tuple(self._f.attrs['openmc_version'])
@@ -647,6 +647,14 @@ class MeshSpatial(Spatial):
     volume_normalized : bool, optional
         Whether or not the strengths will be multiplied by element volumes at
         runtime. Default is True.
+    bias : iterable of float, optional
+        Biased strengths of each element. When given, elements are sampled in
+        proportion to these values and sampled positions are weighted by the
+        ratio of the normalized strength to the normalized biased strength of
+        their element. Biased strengths are multiplied by element volumes when
+        `volume_normalized` is True.
+
+        .. versionadded:: 0.15.1
 
     Attributes
     ----------
@@ -657,12 +665,16 @@ class MeshSpatial(Spatial):
     volume_normalized : bool
         Whether or not the strengths will be multiplied by element volumes at
         runtime.
+    bias : numpy.ndarray or None
+        An array of biased strengths for each mesh element
     """
 
-    def __init__(self, mesh, strengths=None, volume_normalized=True):
+    def __init__(self, mesh, strengths=None, volume_normalized=True,
+                 bias=None):
         self.mesh = mesh
         self.strengths = strengths
         self.volume_normalized = volume_normalized
+        self.bias = bias
 
     @property
     def mesh(self):
@@ -695,6 +707,19 @@ class MeshSpatial(Spatial):
         else:
             self._strengths = None
 
+    @property
+    def bias(self):
+        return self._bias
+
+    @bias.setter
+    def bias(self, bias):
+        if bias is not None:
+            cv.check_type('bias array passed in', bias, Iterable, Real)
+            bias = np.asarray(bias, dtype=float).flatten()
+            for b in bias:
+                cv.check_greater_than('mesh spatial bias', b, 0.0, True)
+        self._bias = bias
+
     @property
     def num_strength_bins(self):
         if self.strengths is None:
@@ -720,6 +745,10 @@ class MeshSpatial(Spatial):
             subelement = ET.SubElement(element, 'strengths')
             subelement.text = ' '.join(str(e) for e in self.strengths)
 
+        if self.bias is not None:
+            subelement = ET.SubElement(element, 'bias')
+            subelement.text = ' '.join(str(e) for e in self.bias)
+
         return element
 
     @classmethod
@@ -752,8 +781,11 @@ class MeshSpatial(Spatial):
         strengths = get_text(elem, 'strengths')
         if strengths is not None:
             strengths = [float(b) for b in get_text(elem, 'strengths').split()]
+        bias = get_text(elem, 'bias')
+        if bias is not None:
+            bias = [float(b) for b in bias.split()]
 
-        return cls(meshes[mesh_id], strengths, volume_normalized)
+        return cls(meshes[mesh_id], strengths, volume_normalized, bias)
 
 
 class Box(Spatial):
@@ -110,6 +110,13 @@ class Discrete(Univariate):
         Values of the random variable
     p : Iterable of float
         Discrete probability for each value
+    bias : Iterable of float, optional
+        Biased probability for each value. When given, source particles are
+        sampled from these probabilities and weighted by the ratio of the
+        normalized probability to the normalized biased probability of the
+        sampled value.
+
+        .. versionadded:: 0.15.1
 
     Attributes
     ----------
@@ -117,12 +124,15 @@ class Discrete(Univariate):
         Values of the random variable
     p : numpy.ndarray
         Discrete probability for each value
+    bias : numpy.ndarray or None
+        Biased probability for each value
 
     """
 
-    def __init__(self, x, p):
+    def __init__(self, x, p, bias=None):
         self.x = x
         self.p = p
+        self.bias = bias
 
     def __len__(self):
         return len(self.x)
@@ -151,6 +161,24 @@ class Discrete(Univariate):
             cv.check_greater_than('discrete probability', pk, 0.0, True)
         self._p = np.array(p, dtype=float)
 
+    @property
+    def bias(self):
+        return self._bias
+
+    @bias.setter
+    def bias(self, bias):
+        if bias is not None:
+            if isinstance(bias, Real):
+                bias = [bias]
+            cv.check_type('discrete biased probabilities', bias, Iterable, Real)
+            cv.check_length('discrete biased probabilities', bias,
+                            len(self.x), len(self.x))
+            for bk in bias:
+                cv.check_greater_than('discrete biased probability', bk, 0.0,
+                                      True)
+            bias = np.array(bias, dtype=float)
+        self._bias = bias
+
     def cdf(self):
         return np.insert(np.cumsum(self.p), 0, 0.0)
 
@@ -184,6 +212,10 @@ class Discrete(Univariate):
         params = ET.SubElement(element, "parameters")
         params.text = ' '.join(map(str, self.x)) + ' ' + ' '.join(map(str, self.p))
 
+        if self.bias is not None:
+            bias = ET.SubElement(element, "bias")
+            bias.text = ' '.join(map(str, self.bias))
+
         return element
 
     @classmethod
@@ -204,7 +236,10 @@ class Discrete(Univariate):
         params = [float(x) for x in get_text(elem, 'parameters').split()]
         x = params[:len(params)//2]
         p = params[len(params)//2:]
-        return cls(x, p)
+        bias = get_text(elem, 'bias')
+        if bias is not None:
+            bias = [float(b) for b in bias.split()]
+        return cls(x, p, bias)
 
     @classmethod
     def merge(
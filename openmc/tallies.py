@@ -58,6 +58,47 @@ class Tally(IDManagerMixin):
         Whether reaction rates should be multiplied by atom density
 
         .. versionadded:: 0.14.0
+    thread_private : bool
+        Whether each thread should score into its own copy of the tally
+        results, which are combined at the end of each batch. This avoids
+        atomic updates at the cost of memory, which is limited by
+        :attr:`openmc.Settings.tally_private_memory`. Current tallies with a
+        mesh surface filter on a regular mesh use private copies regardless.
+
+        .. versionadded:: 0.15.1
+    sparse_storage : bool
+        Whether results should be stored in blocks of filter bins that are
+        only allocated once one of their bins is scored. This saves memory
+        for large tallies, such as mesh tallies, where most bins are empty.
+
+        .. versionadded:: 0.15.1
+    partitioned : bool
+        Whether the filter bins of the tally should be divided among MPI
+        processes, each of which only stores results for its own bins. Scores
+        to bins owned by another process are sent to it at the end of each
+        batch. This requires a mesh filter on a structured mesh.
+
+        .. versionadded:: 0.15.1
+    figure_of_merit : bool
+        Whether the figure of merit :math:`1/(R^2 T)` of the tally is recorded
+        at the end of each active batch, where :math:`R` is the largest
+        relative error over the bins of the tally and :math:`T` is the
+        transport time while the tally was active.
+
+        .. versionadded:: 0.15.1
+    fom_history : dict of numpy.ndarray or None
+        Figure of merit recorded at the end of each active batch, as read from
+        a statepoint. Keys are 'batches', 'time', 'max_rel_err',
+        'median_rel_err', and 'fom'.
+
+        .. versionadded:: 0.15.1
+    precision : {'double', 'single'}
+        Floating-point precision in which scores of each batch are summed
+        before they are added to the accumulated results, which are always in
+        double precision. Single precision reduces memory traffic for large
+        tallies that are updated atomically.
+
+        .. versionadded:: 0.15.1
     filters : list of openmc.Filter
         List of specified filters for the tally
     nuclides : list of str
@@ -116,6 +157,12 @@ class Tally(IDManagerMixin):
         self._triggers = cv.CheckedList(openmc.Trigger, 'tally triggers')
         self._derivative = None
         self._multiply_density = True
+        self._thread_private = False
+        self._sparse_storage = False
+        self._partitioned = False
+        self._figure_of_merit = False
+        self._fom_history = None
+        self._precision = 'double'
 
         self._num_realizations = 0
         self._with_summary = False
@@ -164,6 +211,55 @@ class Tally(IDManagerMixin):
         cv.check_type('multiply density', value, bool)
         self._multiply_density = value
 
+    @property
+    def thread_private(self):
+        return self._thread_private
+
+    @thread_private.setter
+    def thread_private(self, value):
+        cv.check_type('thread private', value, bool)
+        self._thread_private = value
+
+    @property
+    def sparse_storage(self):
+        return self._sparse_storage
+
+    @sparse_storage.setter
+    def sparse_storage(self, value):
+        cv.check_type('sparse storage', value, bool)
+        self._sparse_storage = value
+
+    @property
+    def partitioned(self):
+        return self._partitioned
+
+    @partitioned.setter
+    def partitioned(self, value):
+        cv.check_type('partitioned', value, bool)
+        self._partitioned = value
+
+    @property
+    def figure_of_merit(self):
+        return self._figure_of_merit
+
+    @figure_of_merit.setter
+    def figure_of_merit(self, value):
+        cv.check_type('figure of merit', value, bool)
+        self._figure_of_merit = value
+
+    @property
+    def fom_history(self):
+        return self._fom_history
+
+    @property
+    def precision(self):
+        return self._precision
+
+    @precision.setter
+    def precision(self, value):
+        cv.check_value('precision', value, ('double', 'single'))
+        self._precision = value
+
     @property
     def filters(self):
         return self._filters
@@ -848,6 +944,26 @@ class Tally(IDManagerMixin):
         if not self.multiply_density:
             element.set("multiply_density", str(self.multiply_density).lower())
 
+        # Thread-private results
+        if self.thread_private:
+            element.set("thread_private", str(self.thread_private).lower())
+
+        # Sparse result storage
+        if self.sparse_storage:
+            element.set("sparse_storage", str(self.sparse_storage).lower())
+
+        # Results divided among processes
+        if self.partitioned:
+            element.set("partitioned", str(self.partitioned).lower())
+
+        # Figure of merit recorded every batch
+        if self.figure_of_merit:
+            element.set("figure_of_merit", str(self.figure_of_merit).lower())
+
+        # Precision of batch values
+        if self.precision != 'double':
+            element.set("precision", self.precision)
+
         # Optional Tally filters
         if len(self.filters) > 0:
             subelement = ET.SubElement(element, "filters")
@@ -908,6 +1024,26 @@ class Tally(IDManagerMixin):
         if text is not None:
             tally.multiply_density = text in ('true', '1')
 
+        text = get_text(elem, 'thread_private')
+        if text is not None:
+            tally.thread_private = text in ('true', '1')
+
+        text = get_text(elem, 'sparse_storage')
+        if text is not None:
+            tally.sparse_storage = text in ('true', '1')
+
+        text = get_text(elem, 'partitioned')
+        if text is not None:
+            tally.partitioned = text in ('true', '1')
+
+        text = get_text(elem, 'figure_of_merit')
+        if text is not None:
+            tally.figure_of_merit = text in ('true', '1')
+
+        text = get_text(elem, 'precision')
+        if text is not None:
+            tally.precision = text
+
         # Read filters
         filters_elem = elem.find('filters')
         if filters_elem is not None:
@@ -23,6 +23,12 @@ class Trigger(EqualityMixin):
         any bin at the first evaluation.
 
         .. versionadded:: 0.15.0
+    fraction : float
+        Fraction of the bins whose uncertainty must be below the threshold.
+        When less than one, the trigger is checked on evenly spaced bins of
+        large tallies rather than on every bin.
+
+        .. versionadded:: 0.15.1
 
     Attributes
     ----------
@@ -35,13 +41,17 @@ class Trigger(EqualityMixin):
         Scores which should be checked against the trigger
     ignore_zeros : bool
         Whether to allow zero tally bins to be ignored.
+    fraction : float
+        Fraction of the bins whose uncertainty must be below the threshold.
 
     """
 
-    def __init__(self, trigger_type: str, threshold: float, ignore_zeros: bool = False):
+    def __init__(self, trigger_type: str, threshold: float,
+                 ignore_zeros: bool = False, fraction: float = 1.0):
         self.trigger_type = trigger_type
         self.threshold = threshold
         self.ignore_zeros = ignore_zeros
+        self.fraction = fraction
         self._scores = []
 
     def __repr__(self):
@@ -49,6 +59,7 @@ class Trigger(EqualityMixin):
         string += '{: <16}=\t{}\n'.format('\tType', self._trigger_type)
         string += '{: <16}=\t{}\n'.format('\tThreshold', self._threshold)
         string += '{: <16}=\t{}\n'.format('\tIgnore Zeros', self._ignore_zeros)
+        string += '{: <16}=\t{}\n'.format('\tFraction', self._fraction)
         string += '{: <16}=\t{}\n'.format('\tScores', self._scores)
         return string
 
@@ -80,6 +91,17 @@ class Trigger(EqualityMixin):
         cv.check_type('tally trigger ignores zeros', ignore_zeros, bool)
         self._ignore_zeros = ignore_zeros
 
+    @property
+    def fraction(self):
+        return self._fraction
+
+    @fraction.setter
+    def fraction(self, fraction):
+        cv.check_type('tally trigger fraction', fraction, Real)
+        cv.check_greater_than('tally trigger fraction', fraction, 0.0)
+        cv.check_less_than('tally trigger fraction', fraction, 1.0, True)
+        self._fraction = fraction
+
     @property
     def scores(self):
         return self._scores
@@ -109,6 +131,8 @@ class Trigger(EqualityMixin):
         element.set("threshold", str(self._threshold))
         if self._ignore_zeros:
             element.set("ignore_zeros", "true")
+        if self._fraction != 1.0:
+            element.set("fraction", str(self._fraction))
         if len(self._scores) != 0:
             element.set("scores", ' '.join(self._scores))
         return element
@@ -134,7 +158,8 @@ class Trigger(EqualityMixin):
         ignore_zeros = str(elem.get("ignore_zeros", "false")).lower()
         # Try to convert to bool. Let Trigger error out on instantiation.
         ignore_zeros = ignore_zeros in ('true', '1')
-        trigger = cls(trigger_type, threshold, ignore_zeros)
+        fraction = float(elem.get("fraction", 1.0))
+        trigger = cls(trigger_type, threshold, ignore_zeros, fraction)
 
         # Add scores if present
         scores = elem.get("scores")
@@ -66,6 +66,11 @@ class VolumeCalculation:
         Number of iterations over samples (for calculations with a trigger).
 
         .. versionadded:: 0.12
+    estimator : {'point', 'ray'}
+        Estimator used to score samples. With 'point', each sample is a point
+        that scores to the domain containing it. With 'ray', each sample is a
+        ray crossing the bounding box that scores the fraction of its length
+        in each domain, which has a lower variance for thin or small domains.
 
     """
     def __init__(self, domains, samples, lower_left=None, upper_right=None):
@@ -74,6 +79,7 @@ class VolumeCalculation:
         self._threshold = None
         self._trigger_type = None
         self._iterations = None
+        self._estimator = 'point'
 
         cv.check_type('domains', domains, Iterable,
                       (openmc.Cell, openmc.Material, openmc.Universe))
@@ -166,6 +172,15 @@ class VolumeCalculation:
         cv.check_length(name, upper_right, 3)
         self._upper_right = upper_right
 
+    @property
+    def estimator(self):
+        return self._estimator
+
+    @estimator.setter
+    def estimator(self, estimator):
+        cv.check_value('volume estimator', estimator, ('point', 'ray'))
+        self._estimator = estimator
+
     @property
     def threshold(self):
         return self._threshold
@@ -271,6 +286,7 @@ class VolumeCalculation:
             threshold = f.attrs.get('threshold')
             trigger_type = f.attrs.get('trigger_type')
             iterations = f.attrs.get('iterations', 1)
+            estimator = f.attrs.get('estimator', b'point')
 
             volumes = {}
             atoms = {}
@@ -307,6 +323,7 @@ class VolumeCalculation:
             vol.set_trigger(threshold, trigger_type.decode())
 
         vol.iterations = iterations
+        vol.estimator = estimator.decode()
         vol.volumes = volumes
         vol.atoms = atoms
         return vol
@@ -355,6 +372,9 @@ class VolumeCalculation:
             trigger_elem = ET.SubElement(element, "threshold")
             trigger_elem.set("type", self.trigger_type)
             trigger_elem.set("threshold", str(self.threshold))
+        if self.estimator != 'point':
+            estimator_elem = ET.SubElement(element, "estimator")
+            estimator_elem.text = self.estimator
         return element
 
     @classmethod
@@ -403,4 +423,8 @@ class VolumeCalculation:
             threshold = float(get_text(trigger_elem, "threshold"))
             vol.set_trigger(threshold, trigger_type)
 
+        estimator = get_text(elem, "estimator")
+        if estimator is not None:
+            vol.estimator = estimator
+
         return vol
@@ -659,9 +659,10 @@ class WeightWindowGenerator:
         maximum and minimum energy for the data available at runtime.
     particle_type : {'neutron', 'photon'}
         Particle type the weight windows apply to
-    method : {'magic'}
-        The weight window generation methodology applied during an update. Only
-        'magic' is currently supported.
+    method : {'magic', 'fw_cadis'}
+        The weight window generation methodology applied during an update.
+        'fw_cadis' uses the adjoint flux of a random ray solve and requires
+        the random ray 'adjoint' setting.
     max_realizations : int
         The upper limit for number of tally realizations when generating weight
         windows.
@@ -679,9 +680,10 @@ class WeightWindowGenerator:
         energies in [eV] for a single bin
     particle_type : {'neutron', 'photon'}
         Particle type the weight windows apply to
-    method : {'magic'}
-        The weight window generation methodology applied during an update. Only
-        'magic' is currently supported.
+    method : {'magic', 'fw_cadis'}
+        The weight window generation methodology applied during an update.
+        'fw_cadis' uses the adjoint flux of a random ray solve and requires
+        the random ray 'adjoint' setting.
     max_realizations : int
         The upper limit for number of tally realizations when generating weight
         windows.
@@ -693,7 +695,8 @@ class WeightWindowGenerator:
         Whether or not to apply weight windows on the fly.
     """
 
-    _MAGIC_PARAMS = {'value': str, 'threshold': float, 'ratio': float}
+    _MAGIC_PARAMS = {'value': str, 'threshold': float, 'ratio': float,
+                     'damping': float}
 
     def __init__(
         self,
@@ -766,11 +769,11 @@ class WeightWindowGenerator:
     @method.setter
     def method(self, m: str):
         cv.check_type('generation method', m, str)
-        cv.check_value('generation method', m, {'magic'})
+        cv.check_value('generation method', m, {'magic', 'fw_cadis'})
         self._method = m
         if self._update_parameters is not None:
             try:
-                self._check_update_parameters()
+                self._check_update_parameters(self._update_parameters)
             except (TypeError, KeyError):
                 warnings.warn(f'Update parameters are invalid for the "{m}" method.')
 
@@ -799,7 +802,7 @@ class WeightWindowGenerator:
         return self._update_parameters
 
     def _check_update_parameters(self, params: dict):
-        if self.method == 'magic':
+        if self.method in ('magic', 'fw_cadis'):
             check_params = self._MAGIC_PARAMS
 
         for key, val in params.items():
@@ -842,7 +845,7 @@ class WeightWindowGenerator:
         update_parameters : dict
             The update parameters as-read from the XML node (keys: str, values: str)
         """
-        if method == 'magic':
+        if method in ('magic', 'fw_cadis'):
             check_params = cls._MAGIC_PARAMS
 
         for param, param_type in check_params.items():
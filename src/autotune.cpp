@@ -0,0 +1,212 @@
+#include "openmc/autotune.h"
+
+#include <algorithm> // for max, max_element, min
+#include <cmath>     // for llround
+#include <cstdint>
+#include <string>
+#include <utility> // for pair
+
+#include <fmt/core.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "openmc/error.h"
+#include "openmc/event.h"
+#include "openmc/message_passing.h"
+#include "openmc/openmp_interface.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+#include "openmc/timer.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+namespace {
+
+//==============================================================================
+//! Number of particles in flight and OpenMP schedule of event-based transport
+//==============================================================================
+
+struct Configuration {
+  int64_t in_flight; //!< particles in flight, or in each thread's pool
+  int kind;          //!< OpenMP schedule kind, as an omp_sched_t
+  int chunk;         //!< OpenMP chunk size, or zero for the default
+  double rate {0.0}; //!< calculation rate in [particles/second]
+};
+
+//! Factors applied to the number of particles in flight given by the user
+constexpr double IN_FLIGHT_FACTORS[] {0.25, 1.0, 4.0};
+
+//! Chunk size tried with the dynamic schedule
+constexpr int DYNAMIC_CHUNK {64};
+
+bool active {false};          //!< are configurations still being tried?
+bool warm_up {true};          //!< is the current batch the warm-up batch?
+bool schedules_tried {false}; //!< have schedules started to be tried?
+vector<Configuration> trials; //!< configurations tried in the current phase
+vector<Configuration> tried;  //!< all configurations tried so far
+int i_trial {0};              //!< index in trials of the current batch
+double transport_start {0.0}; //!< transport time at the start of the batch
+
+//! Number of particles in flight that is tuned
+int64_t& in_flight()
+{
+  return settings::event_thread_pool > 0 ? settings::event_thread_pool
+                                         : settings::max_particles_in_flight;
+}
+
+Configuration current_configuration()
+{
+  Configuration c {in_flight(), 0, 0};
+#ifdef _OPENMP
+  omp_sched_t kind;
+  omp_get_schedule(&kind, &c.chunk);
+  c.kind = static_cast<int>(kind);
+#endif
+  return c;
+}
+
+void apply(const Configuration& c)
+{
+  in_flight() = c.in_flight;
+#ifdef _OPENMP
+  omp_set_schedule(static_cast<omp_sched_t>(c.kind), c.chunk);
+#endif
+
+  // Make sure the shared particle buffer can hold the particles in flight
+  if (settings::event_thread_pool == 0) {
+    int64_t length = std::min(simulation::work_per_rank, c.in_flight);
+    if (length > static_cast<int64_t>(simulation::particles.size()))
+      init_event_queues(length);
+  }
+}
+
+std::string describe(const Configuration& c)
+{
+  std::string schedule = "runtime";
+#ifdef _OPENMP
+  // Ignore the monotonic modifier, which is the most significant bit
+  switch (static_cast<omp_sched_t>(c.kind & 0x7fffffff)) {
+  case omp_sched_static:
+    schedule = "static";
+    break;
+  case omp_sched_dynamic:
+    schedule = "dynamic";
+    break;
+  case omp_sched_guided:
+    schedule = "guided";
+    break;
+  default:
+    schedule = "auto";
+  }
+  if (c.chunk > 0)
+    schedule += fmt::format(",{}", c.chunk);
+#endif
+  const char* label = settings::event_thread_pool > 0
+                        ? "particles per pool"
+                        : "particles in flight";
+  return fmt::format("{} {}, {} schedule", c.in_flight, label, schedule);
+}
+
+} // namespace
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void init_autotune()
+{
+  active = settings::event_autotune && settings::event_based &&
+           settings::solver_type == SolverType::MONTE_CARLO;
+  warm_up = true;
+  schedules_tried = false;
+  trials.clear();
+  tried.clear();
+  i_trial = 0;
+  if (!active)
+    return;
+
+  // A thread pool larger than its share of the particles leaves threads idle
+  Configuration user = current_configuration();
+  int64_t n_max = simulation::work_per_rank;
+  if (settings::event_thread_pool > 0)
+    n_max = std::max<int64_t>(1, n_max / num_threads());
+  int64_t base = std::min(user.in_flight, n_max);
+  for (double f : IN_FLIGHT_FACTORS) {
+    Configuration c = user;
+    auto n = static_cast<int64_t>(std::llround(f * base));
+    c.in_flight = std::max<int64_t>(1, std::min(n, n_max));
+    if (trials.empty() || trials.back().in_flight != c.in_flight)
+      trials.push_back(c);
+  }
+}
+
+void autotune_initialize_batch()
+{
+  if (!active)
+    return;
+  if (!warm_up)
+    apply(trials[i_trial]);
+  transport_start = simulation::time_transport.elapsed();
+}
+
+void autotune_finalize_batch()
+{
+  if (!active)
+    return;
+
+  // The rate of all processes is limited by the slowest one
+  double time = simulation::time_transport.elapsed() - transport_start;
+#ifdef OPENMC_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &time, 1, MPI_DOUBLE, MPI_MAX, mpi::intracomm);
+#endif
+  if (warm_up) {
+    warm_up = false;
+    return;
+  }
+
+  auto& trial = trials[i_trial];
+  int64_t n = settings::n_particles * settings::gen_per_batch;
+  trial.rate = time > 0.0 ? n / time : 0.0;
+  tried.push_back(trial);
+  if (++i_trial < trials.size())
+    return;
+
+  Configuration best = *std::max_element(trials.begin(), trials.end(),
+    [](const Configuration& a, const Configuration& b) {
+      return a.rate < b.rate;
+    });
+
+  // Try each schedule with the best number of particles in flight, skipping
+  // the schedule that was just measured
+  if (!schedules_tried) {
+    schedules_tried = true;
+    trials = {best};
+    i_trial = 1;
+#ifdef _OPENMP
+    const std::pair<omp_sched_t, int> schedules[] {{omp_sched_static, 0},
+      {omp_sched_dynamic, DYNAMIC_CHUNK}, {omp_sched_guided, 0}};
+    for (const auto& [kind, chunk] : schedules) {
+      if (static_cast<int>(kind) == best.kind && chunk == best.chunk)
+        continue;
+      trials.push_back({best.in_flight, static_cast<int>(kind), chunk});
+    }
+#endif
+    if (i_trial < trials.size())
+      return;
+  }
+
+  // Keep the fastest configuration for the rest of the run
+  apply(best);
+  active = false;
+  write_message(
+    6, "Tuned event-based transport over {} batches:", tried.size() + 1);
+  for (const auto& c : tried) {
+    write_message(6, "  {:<48} {:.6} particles/second", describe(c), c.rate);
+  }
+  write_message(6, "Selected {}", describe(best));
+}
+
+} // namespace openmc
@@ -1,11 +1,15 @@
 #include "openmc/bank.h"
 #include "openmc/capi.h"
+#include "openmc/eigenvalue.h"
 #include "openmc/error.h"
 #include "openmc/message_passing.h"
+#include "openmc/openmp_interface.h"
 #include "openmc/simulation.h"
 #include "openmc/vector.h"
 
+#include <algorithm> // for min
 #include <cstdint>
+#include <numeric> // for accumulate, exclusive_scan, partial_sum
 
 namespace openmc {
 
@@ -19,12 +23,12 @@ vector<SourceSite> source_bank;
 
 SharedArray<SourceSite> surf_source_bank;
 
-// The fission bank is allocated as a SharedArray, rather than a vector, as it
-// will be shared by all threads in the simulation. It will be allocated to a
-// fixed maximum capacity in the init_fission_bank() function. Then, Elements
-// will be added to it by using SharedArray's special thread_safe_append()
-// function.
+// The fission bank holds the sites of a generation once it is complete. It is
+// allocated to an initial capacity in the init_fission_bank() function and
+// filled by sort_fission_bank() from the banks of the threads, to which sites
+// are added during transport without synchronization.
 SharedArray<SourceSite> fission_bank;
+vector<ThreadFissionBank> thread_fission_banks;
 
 // Each entry in this vector corresponds to the number of progeny produced
 // this generation for the particle located at that index. This vector is
@@ -42,6 +46,7 @@ void free_memory_bank()
   simulation::source_bank.clear();
   simulation::surf_source_bank.clear();
   simulation::fission_bank.clear();
+  simulation::thread_fission_banks.clear();
   simulation::progeny_per_particle.clear();
 }
 
@@ -49,6 +54,24 @@ void init_fission_bank(int64_t max)
 {
   simulation::fission_bank.reserve(max);
   simulation::progeny_per_particle.resize(simulation::work_per_rank);
+  clear_fission_bank();
+}
+
+void bank_fission_site(const SourceSite& site)
+{
+  simulation::thread_fission_banks[thread_num()].sites.push_back(site);
+}
+
+void clear_fission_bank()
+{
+  simulation::fission_bank.resize(0);
+
+  // The number of threads may have changed since the last generation
+  auto& banks = simulation::thread_fission_banks;
+  banks.resize(num_threads());
+  for (auto& bank : banks) {
+    bank.sites.clear();
+  }
 }
 
 // Performs an O(n) sort on the fission bank, by leveraging
@@ -65,48 +88,61 @@ void sort_fission_bank()
   }
 
   // Perform exclusive scan summation to determine starting indices in fission
-  // bank for each parent particle id
-  int64_t tmp = simulation::progeny_per_particle[0];
-  simulation::progeny_per_particle[0] = 0;
-  for (int64_t i = 1; i < simulation::progeny_per_particle.size(); i++) {
-    int64_t value = simulation::progeny_per_particle[i - 1] + tmp;
-    tmp = simulation::progeny_per_particle[i];
-    simulation::progeny_per_particle[i] = value;
+  // bank for each parent particle id. The parents are split into one block per
+  // thread: the progeny of each block are summed, and each block is then
+  // scanned starting from the total of the blocks before it.
+  auto& progeny = simulation::progeny_per_particle;
+  int64_t n_parents = progeny.size();
+  int n_blocks = std::min<int64_t>(num_threads(), n_parents);
+  auto block_start = [&](int b) {
+    return progeny.begin() + n_parents * b / n_blocks;
+  };
+  vector<int64_t> block_offset(n_blocks + 1, 0);
+
+#pragma omp parallel for schedule(static)
+  for (int b = 0; b < n_blocks; ++b) {
+    block_offset[b + 1] =
+      std::accumulate(block_start(b), block_start(b + 1), int64_t {0});
   }
+  std::partial_sum(
+    block_offset.begin(), block_offset.end(), block_offset.begin());
 
-  // TODO: C++17 introduces the exclusive_scan() function which could be
-  // used to replace everything above this point in this function.
-
-  // We need a scratch vector to make permutation of the fission bank into
-  // sorted order easy. Under normal usage conditions, the fission bank is
-  // over provisioned, so we can use that as scratch space.
-  SourceSite* sorted_bank;
-  vector<SourceSite> sorted_bank_holder;
-
-  // If there is not enough space, allocate a temporary vector and point to it
-  if (simulation::fission_bank.size() >
-      simulation::fission_bank.capacity() / 2) {
-    sorted_bank_holder.resize(simulation::fission_bank.size());
-    sorted_bank = sorted_bank_holder.data();
-  } else { // otherwise, point sorted_bank to unused portion of the fission bank
-    sorted_bank = &simulation::fission_bank[simulation::fission_bank.size()];
+#pragma omp parallel for schedule(static)
+  for (int b = 0; b < n_blocks; ++b) {
+    std::exclusive_scan(
+      block_start(b), block_start(b + 1), block_start(b), block_offset[b]);
   }
 
-  // Use parent and progeny indices to sort fission bank
-  for (int64_t i = 0; i < simulation::fission_bank.size(); i++) {
-    const auto& site = simulation::fission_bank[i];
-    int64_t offset = site.parent_id - 1 - simulation::work_index[mpi::rank];
-    int64_t idx = simulation::progeny_per_particle[offset] + site.progeny_id;
-    if (idx >= simulation::fission_bank.size()) {
-      fatal_error("Mismatch detected between sum of all particle progeny and "
-                  "shared fission bank size.");
+  // The sites of every thread are moved into the fission bank, which grows if
+  // this generation produced more sites than it can hold
+  const auto& banks = simulation::thread_fission_banks;
+  int64_t n_bank = 0;
+  for (const auto& bank : banks) {
+    n_bank += bank.sites.size();
+  }
+  if (n_bank > simulation::fission_bank.capacity()) {
+    simulation::fission_bank.reserve(n_bank);
+  }
+  simulation::fission_bank.resize(n_bank);
+
+  // Use parent and progeny indices to place each site in sorted order. Every
+  // site has a distinct destination, so sites can be moved concurrently.
+  int64_t offset_rank = simulation::work_index[mpi::rank];
+#pragma omp parallel for schedule(dynamic)
+  for (int t = 0; t < banks.size(); ++t) {
+    for (const auto& site : banks[t].sites) {
+      int64_t offset = site.parent_id - 1 - offset_rank;
+      int64_t idx = progeny[offset] + site.progeny_id;
+      if (idx >= n_bank) {
+        fatal_error("Mismatch detected between sum of all particle progeny "
+                    "and fission bank size.");
+      }
+      simulation::fission_bank[idx] = site;
     }
-    sorted_bank[idx] = site;
   }
-
-  // Copy sorted bank into the fission bank
-  std::copy(sorted_bank, sorted_bank + simulation::fission_bank.size(),
-    simulation::fission_bank.data());
+  for (auto& bank : simulation::thread_fission_banks) {
+    bank.sites.clear();
+  }
 }
 
 //==============================================================================
@@ -124,6 +160,7 @@ extern "C" int openmc_source_bank(void** ptr, int64_t* n)
     set_errmsg("Source bank has not been allocated.");
     return OPENMC_E_ALLOCATE;
   } else {
+    finish_bank_synchronization();
     *ptr = simulation::source_bank.data();
     *n = simulation::source_bank.size();
     return 0;
@@ -19,6 +19,7 @@ namespace data {
 xt::xtensor<double, 1> ttb_e_grid;
 xt::xtensor<double, 1> ttb_k_grid;
 vector<Bremsstrahlung> ttb;
+GuideTable ttb_e_guide;
 
 } // namespace data
 
@@ -47,8 +48,15 @@ void thick_target_bremsstrahlung(Particle& p, double* E_lost)
   auto n_e = data::ttb_e_grid.size();
 
   // Find the lower bounding index of the incident electron energy
-  size_t j =
-    lower_bound_index(data::ttb_e_grid.cbegin(), data::ttb_e_grid.cend(), e);
+  size_t j;
+  if (!data::ttb_e_guide.empty()) {
+    double e_min = data::ttb_e_grid(0);
+    double r = (e - e_min) / (data::ttb_e_grid(n_e - 1) - e_min);
+    j = data::ttb_e_guide.find(data::ttb_e_grid, n_e, e, r);
+  } else {
+    j =
+      lower_bound_index(data::ttb_e_grid.cbegin(), data::ttb_e_grid.cend(), e);
+  }
   if (j == n_e - 1)
     --j;
 
@@ -99,7 +107,10 @@ void thick_target_bremsstrahlung(Particle& p, double* E_lost)
     // Generate a random number r and determine the index i for which
     // cdf(i) <= r*cdf,max <= cdf(i+1)
     double c = prn(p.current_seed()) * c_max;
-    int i_w = lower_bound_index(&mat->cdf(i_e, 0), &mat->cdf(i_e, 0) + i_e, c);
+    const double* cdf = &mat->cdf(i_e, 0);
+    int i_w = mat->guide.empty()
+                ? lower_bound_index(cdf, cdf + i_e, c)
+                : mat->guide[i_e].find(cdf, i_e + 1, c, c / cdf[i_e]);
 
     // Sample the photon energy
     double w_l = data::ttb_e_grid(i_w);
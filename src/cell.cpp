@@ -14,6 +14,7 @@
 
 #include "openmc/capi.h"
 #include "openmc/constants.h"
+#include "openmc/container_util.h"
 #include "openmc/dagmc.h"
 #include "openmc/error.h"
 #include "openmc/geometry.h"
@@ -21,6 +22,7 @@
 #include "openmc/lattice.h"
 #include "openmc/material.h"
 #include "openmc/nuclide.h"
+#include "openmc/particle_data.h"
 #include "openmc/settings.h"
 #include "openmc/xml_interface.h"
 
@@ -36,6 +38,304 @@ vector<unique_ptr<Cell>> cells;
 
 } // namespace model
 
+namespace {
+
+// Targets of a region branch that end the evaluation
+constexpr int32_t BRANCH_INSIDE {-1};
+constexpr int32_t BRANCH_OUTSIDE {-2};
+
+// Maximum number of surfaces whose senses are remembered during evaluation
+constexpr int MAX_BRANCH_SLOTS {64};
+
+// Number of surfaces in a simple region for which distances are batched. The
+// upper limit sets the size of the buffer of distances on the stack.
+constexpr int MIN_BATCH_SURFACES {4};
+constexpr int MAX_BATCH_SURFACES {128};
+
+//! Find the distances to cylinders aligned with axis i1, as
+//! axis_aligned_cylinder_distance does, for all cylinders at once
+template<int i1, int i2, int i3>
+void batch_cylinder_distances(Position r, Direction u, int n,
+  const double* offset1, const double* offset2, const double* radius,
+  double* distances)
+{
+  const double a = 1.0 - u.get<i1>() * u.get<i1>(); // u^2 + v^2
+  if (a == 0.0) {
+    for (int k = 0; k < n; ++k) {
+      distances[k] = INFTY;
+    }
+    return;
+  }
+
+  const double x2 = r.get<i2>();
+  const double x3 = r.get<i3>();
+  const double u2 = u.get<i2>();
+  const double u3 = u.get<i3>();
+#pragma omp simd
+  for (int k = 0; k < n; ++k) {
+    const double r2 = x2 - offset1[k];
+    const double r3 = x3 - offset2[k];
+    const double b = r2 * u2 + r3 * u3;
+    const double c = r2 * r2 + r3 * r3 - radius[k] * radius[k];
+    const double quad = b * b - a * c;
+    const double root = std::sqrt(std::max(quad, 0.0));
+    const double d_far = (-b + root) / a;
+    const double d_near = (-b - root) / a;
+
+    double d;
+    if (quad < 0.0) {
+      d = INFTY;
+    } else if (std::abs(c) < FP_COINCIDENT) {
+      d = (b >= 0.0) ? INFTY : d_far;
+    } else if (c < 0.0) {
+      d = d_far;
+    } else {
+      d = (d_near < 0.0) ? INFTY : d_near;
+    }
+    distances[k] = d;
+  }
+}
+
+//! Node in the tree of a region expression. Operators have their operands as
+//! children, with nested operators of the same kind merged into them.
+struct RegionNode {
+  int32_t token;
+  vector<int> children;
+};
+
+//! Add branches that evaluate a node of a region expression. Branches are
+//! added in reverse order so that their targets already exist.
+//
+//! \param[in] nodes  Nodes of the expression
+//! \param[in] i  Index of the node to evaluate
+//! \param[in] next_true  Target if the node contains the particle
+//! \param[in] next_false  Target if the node does not contain the particle
+//! \param[inout] branches  Branches added so far
+//! \return Index of the branch that begins the evaluation of the node
+int32_t add_branches(const vector<RegionNode>& nodes, int i, int32_t next_true,
+  int32_t next_false, vector<RegionBranch>& branches)
+{
+  const auto& node = nodes[i];
+  if (node.token < OP_UNION) {
+    branches.push_back({node.token, next_true, next_false, -1});
+    return branches.size() - 1;
+  }
+
+  // An intersection moves on to the next operand while the particle is
+  // inside, and a union while it is outside
+  bool intersection = (node.token == OP_INTERSECTION);
+  int32_t entry = intersection ? next_true : next_false;
+  for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) {
+    if (intersection) {
+      entry = add_branches(nodes, *it, entry, next_false, branches);
+    } else {
+      entry = add_branches(nodes, *it, next_true, entry, branches);
+    }
+  }
+  return entry;
+}
+
+//! Build the tree of a region expression from its postfix form
+//
+//! \param[in] postfix  Region expression in postfix notation
+//! \param[out] nodes  Nodes of the expression
+//! \return Index of the root node
+int build_region_tree(const vector<int32_t>& postfix, vector<RegionNode>& nodes)
+{
+  vector<int> stack;
+  for (int32_t token : postfix) {
+    RegionNode node {token, {}};
+    if (token >= OP_UNION) {
+      int rhs = stack.back();
+      stack.pop_back();
+      int lhs = stack.back();
+      stack.pop_back();
+      for (int child : {lhs, rhs}) {
+        if (nodes[child].token == token) {
+          const auto& grandchildren = nodes[child].children;
+          node.children.insert(
+            node.children.end(), grandchildren.begin(), grandchildren.end());
+        } else {
+          node.children.push_back(child);
+        }
+      }
+    }
+    nodes.push_back(std::move(node));
+    stack.push_back(nodes.size() - 1);
+  }
+  Ensures(stack.size() == 1);
+  return stack[0];
+}
+
+//! Bounding box of a node of a region expression
+BoundingBox node_bounding_box(const vector<RegionNode>& nodes, int i)
+{
+  const auto& node = nodes[i];
+  if (node.token < OP_UNION) {
+    return model::surfaces[std::abs(node.token) - 1]->bounding_box(
+      node.token > 0);
+  }
+  BoundingBox bbox = node_bounding_box(nodes, node.children[0]);
+  for (int k = 1; k < node.children.size(); ++k) {
+    if (node.token == OP_INTERSECTION) {
+      bbox &= node_bounding_box(nodes, node.children[k]);
+    } else {
+      bbox |= node_bounding_box(nodes, node.children[k]);
+    }
+  }
+  return bbox;
+}
+
+//! Whether a half-space of a plane normal to an axis contains a box. The box
+//! has to be clear of the plane, so that half-spaces bounding a face of the
+//! box are kept.
+bool half_space_contains(int32_t token, const BoundingBox& bbox)
+{
+  int32_t i_surf = std::abs(token) - 1;
+  if (i_surf >= model::packed_surfaces.size())
+    return false;
+  const auto& surf = model::packed_surfaces[i_surf];
+  double lower, upper;
+  switch (surf.kind) {
+  case SurfaceKind::X_PLANE:
+    lower = bbox.xmin;
+    upper = bbox.xmax;
+    break;
+  case SurfaceKind::Y_PLANE:
+    lower = bbox.ymin;
+    upper = bbox.ymax;
+    break;
+  case SurfaceKind::Z_PLANE:
+    lower = bbox.zmin;
+    upper = bbox.zmax;
+    break;
+  default:
+    return false;
+  }
+  double x0 = surf.c[0];
+  double margin = FP_COINCIDENT * std::max(1.0, std::abs(x0));
+  return token > 0 ? lower > x0 + margin : upper < x0 - margin;
+}
+
+//! Relative cost of evaluating a half-space and finding the distance to it
+int half_space_cost(int32_t token)
+{
+  int32_t i_surf = std::abs(token) - 1;
+  if (i_surf >= model::packed_surfaces.size())
+    return 8;
+  switch (model::packed_surfaces[i_surf].kind) {
+  case SurfaceKind::X_PLANE:
+  case SurfaceKind::Y_PLANE:
+  case SurfaceKind::Z_PLANE:
+    return 1;
+  case SurfaceKind::PLANE:
+    return 2;
+  case SurfaceKind::X_CYLINDER:
+  case SurfaceKind::Y_CYLINDER:
+  case SurfaceKind::Z_CYLINDER:
+    return 3;
+  case SurfaceKind::SPHERE:
+    return 4;
+  default:
+    return 8;
+  }
+}
+
+//! Remove the operands of a node that cannot change its region and order the
+//! others from the cheapest to evaluate to the most expensive. Operands that
+//! repeat another operand are removed, as are half-spaces of an intersection
+//! that contain the bounding box of the other operands.
+//
+//! \param[inout] nodes  Nodes of the expression
+//! \param[in] i  Index of the node to simplify
+//! \return Cost of evaluating the node
+int simplify_region_node(vector<RegionNode>& nodes, int i)
+{
+  int32_t token = nodes[i].token;
+  if (token < OP_UNION)
+    return half_space_cost(token);
+
+  vector<std::pair<int, int>> operands;
+  for (int child : nodes[i].children) {
+    operands.push_back({simplify_region_node(nodes, child), child});
+  }
+  auto is_repeated = [&](int k) {
+    int32_t t = nodes[operands[k].second].token;
+    for (int j = 0; j < k; ++j) {
+      if (t < OP_UNION && nodes[operands[j].second].token == t)
+        return true;
+    }
+    return false;
+  };
+  for (int k = 0; k < operands.size() && operands.size() > 1;) {
+    bool redundant = is_repeated(k);
+    int32_t t = nodes[operands[k].second].token;
+    if (!redundant && token == OP_INTERSECTION && t < OP_UNION) {
+      BoundingBox others;
+      for (int j = 0; j < operands.size(); ++j) {
+        if (j != k)
+          others &= node_bounding_box(nodes, operands[j].second);
+      }
+      redundant = half_space_contains(t, others);
+    }
+    if (redundant) {
+      operands.erase(operands.begin() + k);
+    } else {
+      ++k;
+    }
+  }
+
+  // Short circuiting skips the operands after the one that decides the node,
+  // so cheap operands are evaluated first
+  std::stable_sort(operands.begin(), operands.end(),
+    [](const auto& a, const auto& b) { return a.first < b.first; });
+  int cost = 0;
+  nodes[i].children.clear();
+  for (const auto& [c, child] : operands) {
+    cost += c;
+    nodes[i].children.push_back(child);
+  }
+  return cost;
+}
+
+//! Write a node of a region expression in infix notation, with parentheses
+//! only around operators that differ from the operator they are operands of
+//
+//! \param[in] nodes  Nodes of the expression
+//! \param[in] i  Index of the node to write
+//! \param[in] parent  Operator the node is an operand of
+//! \param[inout] infix  Expression written so far
+void write_region_node(const vector<RegionNode>& nodes, int i, int32_t parent,
+  vector<int32_t>& infix)
+{
+  while (nodes[i].token >= OP_UNION && nodes[i].children.size() == 1) {
+    i = nodes[i].children[0];
+  }
+  const auto& node = nodes[i];
+  if (node.token < OP_UNION) {
+    infix.push_back(node.token);
+    return;
+  }
+  bool parentheses = (node.token != parent);
+  if (parentheses)
+    infix.push_back(OP_LEFT_PAREN);
+  for (int k = 0; k < node.children.size(); ++k) {
+    if (k > 0)
+      infix.push_back(node.token);
+    write_region_node(nodes, node.children[k], node.token, infix);
+  }
+  if (parentheses)
+    infix.push_back(OP_RIGHT_PAREN);
+}
+
+//! Tokens and half-spaces of the regions read before and after simplification
+int64_t n_region_tokens {0};
+int64_t n_region_tokens_removed {0};
+int64_t n_region_half_spaces {0};
+int64_t n_region_half_spaces_removed {0};
+
+} // namespace
+
 //==============================================================================
 // Cell implementation
 //==============================================================================
@@ -540,6 +840,9 @@ Region::Region(std::string region_spec, int32_t cell_id)
       }
     }
 
+    if (settings::simplify_regions)
+      simplify(cell_id);
+
     // If this cell is simple, remove all the superfluous operator tokens.
     if (simple_) {
       for (auto it = expression_.begin(); it != expression_.end(); it++) {
@@ -551,6 +854,12 @@ Region::Region(std::string region_spec, int32_t cell_id)
     }
     expression_.shrink_to_fit();
 
+    if (simple_) {
+      build_batch();
+    } else {
+      compile_branches(cell_id);
+    }
+
   } else {
     simple_ = true;
   }
@@ -756,6 +1065,34 @@ vector<int32_t> Region::generate_postfix(int32_t cell_id) const
 
 //==============================================================================
 
+void Region::simplify(int32_t cell_id)
+{
+  vector<RegionNode> nodes;
+  int root = build_region_tree(generate_postfix(cell_id), nodes);
+  simplify_region_node(nodes, root);
+
+  auto count_half_spaces = [this]() {
+    return std::count_if(expression_.begin(), expression_.end(),
+      [](int32_t token) { return token < OP_UNION; });
+  };
+  int64_t n_tokens = expression_.size();
+  int64_t n_half_spaces = count_half_spaces();
+  expression_.clear();
+  write_region_node(nodes, root, nodes[root].token, expression_);
+  simple_ = !contains(expression_, OP_UNION);
+
+#pragma omp atomic
+  n_region_tokens += n_tokens;
+#pragma omp atomic
+  n_region_tokens_removed += n_tokens - expression_.size();
+#pragma omp atomic
+  n_region_half_spaces += n_half_spaces;
+#pragma omp atomic
+  n_region_half_spaces_removed += n_half_spaces - count_half_spaces();
+}
+
+//==============================================================================
+
 std::string Region::str() const
 {
   std::stringstream region_spec {};
@@ -788,15 +1125,24 @@ std::pair<double, int32_t> Region::distance(
   double min_dist {INFTY};
   int32_t i_surf {std::numeric_limits<int32_t>::max()};
 
-  for (int32_t token : expression_) {
+  // Find the distances to the surfaces of a simple region all at once
+  double batched[MAX_BATCH_SURFACES];
+  bool batch = !batch_.slot.empty();
+  if (batch)
+    batch_distances(r, u, batched);
+
+  for (int i = 0; i < expression_.size(); ++i) {
     // Ignore this token if it corresponds to an operator rather than a region.
+    int32_t token = expression_[i];
     if (token >= OP_UNION)
       continue;
 
     // Calculate the distance to this surface.
     // Note the off-by-one indexing
     bool coincident {std::abs(token) == std::abs(on_surface)};
-    double d {model::surfaces[abs(token) - 1]->distance(r, u, coincident)};
+    double d = (batch && !coincident)
+                 ? batched[batch_.slot[i]]
+                 : surface_distance(abs(token) - 1, r, u, coincident);
 
     // Check if this distance is the new minimum.
     if (d < min_dist) {
@@ -810,6 +1156,161 @@ std::pair<double, int32_t> Region::distance(
   return {min_dist, i_surf};
 }
 
+std::pair<double, int32_t> Region::distance(
+  Position r, Direction u, int32_t on_surface, SurfaceDistances& cache) const
+{
+  // Along the same ray, the distance to each surface only decreases by the
+  // distance travelled since the distances were calculated
+  bool reuse = (cache.region == this && cache.u == u);
+  double travelled = 0.0;
+  if (reuse) {
+    travelled = (r - cache.r).dot(u);
+  } else {
+    cache.region = this;
+    cache.r = r;
+    cache.u = u;
+    cache.distances.resize(expression_.size());
+  }
+
+  double batched[MAX_BATCH_SURFACES];
+  bool batch = !reuse && !batch_.slot.empty();
+  if (batch)
+    batch_distances(r, u, batched);
+
+  double min_dist {INFTY};
+  int32_t i_surf {std::numeric_limits<int32_t>::max()};
+
+  for (int i = 0; i < expression_.size(); ++i) {
+    int32_t token = expression_[i];
+    if (token >= OP_UNION)
+      continue;
+
+    double d;
+    if (reuse) {
+      d = cache.distances[i] - travelled;
+    } else {
+      bool coincident {std::abs(token) == std::abs(on_surface)};
+      d = (batch && !coincident)
+            ? batched[batch_.slot[i]]
+            : surface_distance(abs(token) - 1, r, u, coincident);
+      cache.distances[i] = d;
+    }
+
+    if (d < min_dist) {
+      if (min_dist - d >= FP_PRECISION * min_dist) {
+        min_dist = d;
+        i_surf = -token;
+      }
+    }
+  }
+
+  return {min_dist, i_surf};
+}
+
+//==============================================================================
+
+void Region::build_batch()
+{
+  batch_ = {};
+  int n = expression_.size();
+  if (n < MIN_BATCH_SURFACES || n > MAX_BATCH_SURFACES)
+    return;
+
+  // Find the group of each surface and its position within the group. Groups
+  // 0-2 are planes normal to x, y and z, groups 3-5 are cylinders along x, y
+  // and z, and group 6 holds all other surfaces.
+  vector<int> group(n);
+  vector<int> position(n);
+  array<int, 8> start {};
+  for (int i = 0; i < n; ++i) {
+    int32_t i_surf = std::abs(expression_[i]) - 1;
+    if (i_surf >= model::packed_surfaces.size())
+      return;
+    const auto& surf = model::packed_surfaces[i_surf];
+    int g;
+    switch (surf.kind) {
+    case SurfaceKind::X_PLANE:
+    case SurfaceKind::Y_PLANE:
+    case SurfaceKind::Z_PLANE:
+      g = static_cast<int>(surf.kind) - static_cast<int>(SurfaceKind::X_PLANE);
+      position[i] = batch_.plane_offset[g].size();
+      batch_.plane_offset[g].push_back(surf.c[0]);
+      break;
+    case SurfaceKind::X_CYLINDER:
+    case SurfaceKind::Y_CYLINDER:
+    case SurfaceKind::Z_CYLINDER: {
+      int axis = static_cast<int>(surf.kind) -
+                 static_cast<int>(SurfaceKind::X_CYLINDER);
+      g = 3 + axis;
+      position[i] = batch_.cylinder_radius[axis].size();
+      batch_.cylinder_offset1[axis].push_back(surf.c[0]);
+      batch_.cylinder_offset2[axis].push_back(surf.c[1]);
+      batch_.cylinder_radius[axis].push_back(surf.c[2]);
+      break;
+    }
+    default:
+      g = 6;
+      position[i] = batch_.other.size();
+      batch_.other.push_back(i_surf);
+    }
+    group[i] = g;
+    ++start[g + 1];
+  }
+
+  // Convert the sizes of the groups to their starting positions
+  for (int g = 1; g < start.size(); ++g) {
+    start[g] += start[g - 1];
+  }
+  batch_.slot.resize(n);
+  for (int i = 0; i < n; ++i) {
+    batch_.slot[i] = start[group[i]] + position[i];
+  }
+}
+
+//==============================================================================
+
+void Region::batch_distances(
+  Position r, Direction u, double* distances) const
+{
+  double* d = distances;
+
+  // Planes normal to each axis, as in axis_aligned_plane_distance
+  for (int i = 0; i < 3; ++i) {
+    const double* offset = batch_.plane_offset[i].data();
+    int n = batch_.plane_offset[i].size();
+    const double x = r[i];
+    const double ui = u[i];
+#pragma omp simd
+    for (int k = 0; k < n; ++k) {
+      const double f = offset[k] - x;
+      const double dist = f / ui;
+      d[k] = (std::abs(f) < FP_COINCIDENT || ui == 0.0 || dist < 0.0)
+               ? INFTY
+               : dist;
+    }
+    d += n;
+  }
+
+  // Cylinders along each axis
+  const auto& off1 = batch_.cylinder_offset1;
+  const auto& off2 = batch_.cylinder_offset2;
+  const auto& radius = batch_.cylinder_radius;
+  batch_cylinder_distances<0, 1, 2>(r, u, radius[0].size(), off1[0].data(),
+    off2[0].data(), radius[0].data(), d);
+  d += radius[0].size();
+  batch_cylinder_distances<1, 0, 2>(r, u, radius[1].size(), off1[1].data(),
+    off2[1].data(), radius[1].data(), d);
+  d += radius[1].size();
+  batch_cylinder_distances<2, 0, 1>(r, u, radius[2].size(), off1[2].data(),
+    off2[2].data(), radius[2].data(), d);
+  d += radius[2].size();
+
+  // Any other surfaces
+  for (auto i_surf : batch_.other) {
+    *d++ = surface_distance(i_surf, r, u, false);
+  }
+}
+
 //==============================================================================
 
 bool Region::contains(Position r, Direction u, int32_t on_surface) const
@@ -835,7 +1336,7 @@ bool Region::contains_simple(Position r, Direction u, int32_t on_surface) const
       return false;
     } else {
       // Note the off-by-one indexing
-      bool sense = model::surfaces[abs(token) - 1]->sense(r, u);
+      bool sense = surface_sense(abs(token) - 1, r, u);
       if (sense != (token > 0)) {
         return false;
       }
@@ -848,59 +1349,84 @@ bool Region::contains_simple(Position r, Direction u, int32_t on_surface) const
 
 bool Region::contains_complex(Position r, Direction u, int32_t on_surface) const
 {
-  bool in_cell = true;
-  int total_depth = 0;
-
-  // For each token
-  for (auto it = expression_.begin(); it != expression_.end(); it++) {
-    int32_t token = *it;
-
-    // If the token is a surface evaluate the sense
-    // If the token is a union or intersection check to
-    // short circuit
-    if (token < OP_UNION) {
-      if (token == on_surface) {
-        in_cell = true;
-      } else if (-token == on_surface) {
-        in_cell = false;
+  // Senses of surfaces that appear more than once in the region
+  uint64_t known = 0;
+  uint64_t senses = 0;
+
+  int32_t i = 0;
+  while (i >= 0) {
+    const auto& branch = branches_[i];
+    int32_t token = branch.token;
+
+    // If the particle's surface attribute is set and matches the token, that
+    // overrides the determination based on sense()
+    bool inside;
+    if (token == on_surface) {
+      inside = true;
+    } else if (-token == on_surface) {
+      inside = false;
+    } else {
+      uint64_t bit = (branch.slot >= 0) ? uint64_t {1} << branch.slot : 0;
+      bool sense;
+      if (known & bit) {
+        sense = senses & bit;
       } else {
         // Note the off-by-one indexing
-        bool sense = model::surfaces[abs(token) - 1]->sense(r, u);
-        in_cell = (sense == (token > 0));
-      }
-    } else if ((token == OP_UNION && in_cell == true) ||
-               (token == OP_INTERSECTION && in_cell == false)) {
-      // If the total depth is zero return
-      if (total_depth == 0) {
-        return in_cell;
+        sense = surface_sense(abs(token) - 1, r, u);
+        known |= bit;
+        if (sense)
+          senses |= bit;
       }
+      inside = (sense == (token > 0));
+    }
+    i = inside ? branch.next_true : branch.next_false;
+  }
+  return i == BRANCH_INSIDE;
+}
 
-      total_depth--;
+//==============================================================================
 
-      // While the iterator is within the bounds of the vector
-      int depth = 1;
-      do {
-        // Get next token
-        it++;
-        int32_t next_token = *it;
-
-        // If the token is an a parenthesis
-        if (next_token > OP_COMPLEMENT) {
-          // Adjust depth accordingly
-          if (next_token == OP_RIGHT_PAREN) {
-            depth--;
-          } else {
-            depth++;
-          }
-        }
-      } while (depth > 0);
-    } else if (token == OP_LEFT_PAREN) {
-      total_depth++;
-    } else if (token == OP_RIGHT_PAREN) {
-      total_depth--;
+void Region::compile_branches(int32_t cell_id)
+{
+  // Build the tree of the expression from its postfix form
+  vector<RegionNode> nodes;
+  int root = build_region_tree(generate_postfix(cell_id), nodes);
+
+  // Add the branches in reverse and then put them in evaluation order, so that
+  // the branch for the first operand comes first and jumps go forward
+  branches_.clear();
+  int32_t entry =
+    add_branches(nodes, root, BRANCH_INSIDE, BRANCH_OUTSIDE, branches_);
+  int32_t n = branches_.size();
+  std::reverse(branches_.begin(), branches_.end());
+  for (auto& branch : branches_) {
+    if (branch.next_true >= 0)
+      branch.next_true = n - 1 - branch.next_true;
+    if (branch.next_false >= 0)
+      branch.next_false = n - 1 - branch.next_false;
+  }
+  Ensures(n - 1 - entry == 0);
+
+  // Remember the senses of surfaces that appear more than once so that each
+  // surface is evaluated at most once
+  std::unordered_map<int32_t, int> count;
+  for (const auto& branch : branches_) {
+    ++count[std::abs(branch.token)];
+  }
+  std::unordered_map<int32_t, int> slots;
+  for (auto& branch : branches_) {
+    int32_t i_surf = std::abs(branch.token);
+    if (count[i_surf] < 2)
+      continue;
+    auto it = slots.find(i_surf);
+    if (it != slots.end()) {
+      branch.slot = it->second;
+    } else if (static_cast<int>(slots.size()) < MAX_BRANCH_SLOTS) {
+      branch.slot = slots.size();
+      slots[i_surf] = branch.slot;
     }
   }
-  return in_cell;
+  branches_.shrink_to_fit();
 }
 
 //==============================================================================
@@ -979,16 +1505,35 @@ vector<int32_t> Region::surfaces() const
 
 void read_cells(pugi::xml_node node)
 {
-  // Count the number of cells.
-  int n_cells = 0;
+  vector<pugi::xml_node> cell_nodes;
   for (pugi::xml_node cell_node : node.children("cell")) {
-    n_cells++;
+    cell_nodes.push_back(cell_node);
+  }
+
+  // Cells only read their own XML element and the surface map, so they are
+  // created in parallel for models with many cells. Exceptions cannot leave a
+  // parallel region and are reported where they occur.
+  int n_cells = cell_nodes.size();
+  model::cells.resize(n_cells);
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int i = 0; i < n_cells; ++i) {
+    try {
+      model::cells[i] = make_unique<CSGCell>(cell_nodes[i]);
+    } catch (const std::exception& e) {
+      fatal_error(e.what());
+    }
   }
 
-  // Loop over XML cell elements and populate the array.
-  model::cells.reserve(n_cells);
-  for (pugi::xml_node cell_node : node.children("cell")) {
-    model::cells.push_back(make_unique<CSGCell>(cell_node));
+  if (settings::simplify_regions) {
+    write_message(6,
+      "Simplified cell regions: removed {} of {} half-spaces and {} of {} "
+      "tokens",
+      n_region_half_spaces_removed, n_region_half_spaces,
+      n_region_tokens_removed, n_region_tokens);
+    n_region_tokens = 0;
+    n_region_tokens_removed = 0;
+    n_region_half_spaces = 0;
+    n_region_half_spaces_removed = 0;
   }
 
   // Fill the cell map.
@@ -0,0 +1,257 @@
+#include "openmc/census.h"
+
+#include <algorithm> // for clamp, max, min, sort
+#include <cmath>     // for ceil
+#include <cstdint>
+#include <tuple>     // for tie
+
+#include "openmc/bank.h"
+#include "openmc/constants.h"
+#include "openmc/message_passing.h"
+#include "openmc/openmp_interface.h"
+#include "openmc/random_lcg.h"
+#include "openmc/search.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+#include "openmc/timer.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+int census_step {0};
+double census_time {INFTY};
+vector<ThreadCensusBank> thread_census_banks;
+vector<SourceSite> census_bank;
+vector<SourceSite> census_source;
+
+} // namespace simulation
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+bool census_on()
+{
+  return !settings::census_times.empty();
+}
+
+int n_census_steps()
+{
+  return settings::census_times.size() + 1;
+}
+
+void init_census()
+{
+  simulation::thread_census_banks.assign(num_threads(), ThreadCensusBank {});
+  start_census();
+}
+
+void start_census()
+{
+  simulation::census_step = 0;
+  simulation::census_time =
+    census_on() ? settings::census_times.front() : INFTY;
+}
+
+void bank_census_site(Particle& p)
+{
+  SourceSite site;
+  site.r = p.r();
+  site.u = p.u();
+  site.E = settings::run_CE ? p.E() : static_cast<double>(p.g());
+  site.time = p.time();
+  site.wgt = p.wgt();
+  site.delayed_group = p.delayed_group();
+  site.surf_id = 0;
+  site.particle = p.type();
+  site.parent_id = p.id();
+  site.progeny_id = p.n_progeny()++;
+  simulation::thread_census_banks[thread_num()].sites.push_back(site);
+}
+
+bool census_population_control()
+{
+  using namespace simulation;
+
+  int n_times = settings::census_times.size();
+  if (census_step >= n_times)
+    return false;
+
+  time_bank.start();
+
+  // Gather the sites of each thread in an order that does not depend on the
+  // order the particles were transported in
+  census_bank.clear();
+  for (auto& bank : thread_census_banks) {
+    census_bank.insert(census_bank.end(), bank.sites.begin(), bank.sites.end());
+    bank.sites.clear();
+  }
+  std::sort(census_bank.begin(), census_bank.end(),
+    [](const SourceSite& a, const SourceSite& b) {
+      return std::tie(a.parent_id, a.progeny_id) <
+             std::tie(b.parent_id, b.progeny_id);
+    });
+
+  // Think of the sites of all processes as one global array of weights laid
+  // end to end. Each process needs the weight of the processes before it to
+  // find the teeth of the comb falling on its own sites. The sums are taken in
+  // the same order on every process so that the end of the weight of one
+  // process is exactly the start of the next.
+  double weight = 0.0;
+  for (const auto& site : census_bank) {
+    weight += site.wgt;
+  }
+  vector<double> weights(mpi::n_procs, weight);
+#ifdef OPENMC_MPI
+  MPI_Allgather(
+    &weight, 1, MPI_DOUBLE, weights.data(), 1, MPI_DOUBLE, mpi::intracomm);
+#endif
+  double begin = 0.0;
+  double total = 0.0;
+  for (int i = 0; i < mpi::n_procs; ++i) {
+    if (i == mpi::rank)
+      begin = total;
+    total += weights[i];
+  }
+  double end = begin + weight;
+
+  ++census_step;
+  census_time =
+    census_step < n_times ? settings::census_times[census_step] : INFTY;
+
+  // Nothing is left to transport if every particle died before the census
+  if (total == 0.0) {
+    census_step = n_times;
+    census_time = INFTY;
+    time_bank.stop();
+    return false;
+  }
+
+  // The teeth of the comb are evenly spaced over the total weight, shifted by
+  // a random offset common to all processes. A site receives one copy for each
+  // tooth falling on its weight and each copy carries the weight between two
+  // teeth, so that the total weight is preserved.
+  int64_t n_teeth = settings::n_particles;
+  double spacing = total / n_teeth;
+  int64_t id = (total_gen + overall_generation() - 1) * n_census_steps() +
+               census_step;
+  uint64_t seed = init_seed(id, STREAM_TRACKING);
+  double offset = prn(&seed);
+  auto teeth_below = [&](double x) -> int64_t {
+    if (x >= total)
+      return n_teeth;
+    auto n = static_cast<int64_t>(std::ceil(x / spacing - offset));
+    return std::clamp<int64_t>(n, 0, n_teeth);
+  };
+
+  // Copies whose position in the global array of combed sites falls within
+  // this process's share are stored directly. The others are buffered to be
+  // sent to the processes before and after this one.
+  int64_t start = teeth_below(begin);
+  int64_t work_start = work_index[mpi::rank];
+  int64_t work_end = work_index[mpi::rank + 1];
+  census_source.resize(work_per_rank);
+  vector<SourceSite> send_before;
+  vector<SourceSite> send_after;
+  int64_t position = start;
+  auto place = [&](const SourceSite& site) {
+    if (position < work_start) {
+      send_before.push_back(site);
+    } else if (position < work_end) {
+      census_source[position - work_start] = site;
+    } else {
+      send_after.push_back(site);
+    }
+    ++position;
+  };
+
+  double c = begin;
+  int64_t n_below = start;
+  for (int64_t i = 0; i < census_bank.size(); ++i) {
+    SourceSite site = census_bank[i];
+    double c_next = i + 1 < census_bank.size() ? c + site.wgt : end;
+    int64_t n_below_next = teeth_below(c_next);
+    site.wgt = spacing;
+    for (int64_t j = n_below; j < n_below_next; ++j) {
+      place(site);
+    }
+    c = c_next;
+    n_below = n_below_next;
+  }
+
+#ifdef OPENMC_MPI
+  // The buffered copies occupy consecutive positions of the global array, so
+  // the processes they belong to follow from the work indices alone. Unlike
+  // fission sites, they may be any type of particle and are sent whole.
+  constexpr int tag {1};
+  vector<MPI_Request> requests;
+  auto send = [&](const vector<SourceSite>& sites, int64_t first) {
+    int neighbor =
+      upper_bound_index(work_index.begin(), work_index.end(), first);
+    int64_t n_sites = sites.size();
+    for (int64_t i = 0; i < n_sites; ++neighbor) {
+      int64_t n = std::min(work_index[neighbor + 1] - (first + i), n_sites - i);
+      if (n > 0) {
+        requests.emplace_back();
+        MPI_Isend(&sites[i], static_cast<int>(n), mpi::source_site, neighbor,
+          tag, mpi::intracomm, &requests.back());
+      }
+      i += n;
+    }
+  };
+  send(send_before, start);
+  send(send_after, std::max(start, work_end));
+
+  // Copies made by processes before this one fill the positions ahead of its
+  // own copies and those made by processes after it the positions behind them
+  int64_t local_end = std::clamp(position, work_start, work_end) - work_start;
+  int64_t n_local =
+    local_end - (std::clamp(start, work_start, work_end) - work_start);
+  struct Incoming {
+    int source;
+    int count;
+    MPI_Message message;
+  };
+  vector<Incoming> incoming;
+  for (int64_t n_received = n_local; n_received < work_per_rank;) {
+    MPI_Status status;
+    Incoming msg;
+    MPI_Mprobe(MPI_ANY_SOURCE, tag, mpi::intracomm, &msg.message, &status);
+    MPI_Get_count(&status, mpi::source_site, &msg.count);
+    msg.source = status.MPI_SOURCE;
+    n_received += msg.count;
+    incoming.push_back(msg);
+  }
+  std::sort(incoming.begin(), incoming.end(),
+    [](const Incoming& a, const Incoming& b) { return a.source < b.source; });
+
+  int64_t index_before = 0;
+  int64_t index_after = local_end;
+  for (auto& msg : incoming) {
+    int64_t& index = msg.source < mpi::rank ? index_before : index_after;
+    MPI_Mrecv(&census_source[index], msg.count, mpi::source_site,
+      &msg.message, MPI_STATUS_IGNORE);
+    index += msg.count;
+  }
+  MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+#endif
+
+  time_bank.stop();
+  return true;
+}
+
+void free_memory_census()
+{
+  simulation::thread_census_banks.clear();
+  simulation::census_bank.clear();
+  simulation::census_source.clear();
+  simulation::census_step = 0;
+  simulation::census_time = INFTY;
+}
+
+} // namespace openmc
@@ -7,12 +7,14 @@
 #endif
 #include "xtensor/xtensor.hpp"
 
+#include "openmc/array.h"
 #include "openmc/bank.h"
 #include "openmc/capi.h"
 #include "openmc/constants.h"
 #include "openmc/error.h"
 #include "openmc/mesh.h"
 #include "openmc/message_passing.h"
+#include "openmc/search.h"
 #include "openmc/tallies/filter_energy.h"
 #include "openmc/tallies/filter_mesh.h"
 #include "openmc/tallies/tally.h"
@@ -30,6 +32,10 @@ vector<int> indptr;
 
 vector<int> indices;
 
+vector<int> diag;
+
+array<vector<int>, 2> colors;
+
 int dim;
 
 double spectral;
@@ -40,6 +46,10 @@ xt::xtensor<int, 2> indexmap;
 
 int use_all_threads;
 
+CMFDLinearSolver solver;
+
+vector<double> ilu;
+
 StructuredMesh* mesh;
 
 vector<double> egrid;
@@ -49,30 +59,18 @@ double norm;
 } // namespace cmfd
 
 //==============================================================================
-// GET_CMFD_ENERGY_BIN returns the energy bin for a source site energy
+// GET_CMFD_ENERGY_BIN returns the energy bin for a source site energy, or the
+// nearest bin for energies outside of the grid
 //==============================================================================
 
 int get_cmfd_energy_bin(const double E)
 {
-  // Check if energy is out of grid bounds
   if (E < cmfd::egrid[0]) {
-    // throw warning message
-    warning("Detected source point below energy grid");
     return 0;
   } else if (E >= cmfd::egrid[cmfd::ng]) {
-    // throw warning message
-    warning("Detected source point above energy grid");
     return cmfd::ng - 1;
-  } else {
-    // Iterate through energy grid to find matching bin
-    for (int g = 0; g < cmfd::ng; g++) {
-      if (E >= cmfd::egrid[g] && E < cmfd::egrid[g + 1]) {
-        return g;
-      }
-    }
   }
-  // Return -1 by default
-  return -1;
+  return upper_bound_index(cmfd::egrid.begin(), cmfd::egrid.end(), E);
 }
 
 //==============================================================================
@@ -90,27 +88,39 @@ xt::xtensor<double, 1> count_bank_sites(
   xt::xarray<double> cnt {cnt_shape, 0.0};
   bool outside_ = false;
 
-  auto bank_size = simulation::source_bank.size();
-  for (int i = 0; i < bank_size; i++) {
+  // Determine the bin of each site in parallel, with a bin of -1 for sites
+  // outside of the mesh. The bins are used again when updating weights.
+  int64_t bank_size = simulation::source_bank.size();
+  int64_t n_below = 0;
+  int64_t n_above = 0;
+#pragma omp parallel for schedule(static) reduction(+ : n_below, n_above)
+  for (int64_t i = 0; i < bank_size; i++) {
     const auto& site = simulation::source_bank[i];
-
-    // determine scoring bin for CMFD mesh
     int mesh_bin = cmfd::mesh->get_bin(site.r);
-
-    // if outside mesh, skip particle
     if (mesh_bin < 0) {
-      outside_ = true;
+      bins[i] = -1;
       continue;
     }
+    if (site.E < cmfd::egrid[0]) {
+      ++n_below;
+    } else if (site.E >= cmfd::egrid[cmfd::ng]) {
+      ++n_above;
+    }
+    bins[i] = mesh_bin * cmfd::ng + get_cmfd_energy_bin(site.E);
+  }
+  if (n_below > 0)
+    warning("Detected source point below energy grid");
+  if (n_above > 0)
+    warning("Detected source point above energy grid");
 
-    // determine scoring bin for CMFD energy
-    int energy_bin = get_cmfd_energy_bin(site.E);
-
-    // add to appropriate bin
-    cnt(mesh_bin * cmfd::ng + energy_bin) += site.wgt;
-
-    // store bin index which is used again when updating weights
-    bins[i] = mesh_bin * cmfd::ng + energy_bin;
+  // The weights are added in the order of the sites so that the counts are
+  // independent of the number of threads
+  for (int64_t i = 0; i < bank_size; i++) {
+    if (bins[i] < 0) {
+      outside_ = true;
+      continue;
+    }
+    cnt(bins[i]) += simulation::source_bank[i].wgt;
   }
 
   // Create copy of count data. Since ownership will be acquired by xtensor,
@@ -180,7 +190,10 @@ extern "C" void openmc_cmfd_reweight(
 #endif
 
   // Iterate through fission bank and update particle weights
+#pragma omp parallel for schedule(static)
   for (int64_t i = 0; i < bank_size; i++) {
+    if (bank_bins(i) < 0)
+      continue;
     auto& site = simulation::source_bank[i];
     site.wgt *= weightfactors(bank_bins(i));
   }
@@ -235,19 +248,6 @@ extern "C" void openmc_initialize_mesh_egrid(
   }
 }
 
-//==============================================================================
-// MATRIX_TO_INDICES converts a matrix index to spatial and group
-// indices
-//==============================================================================
-
-void matrix_to_indices(int irow, int& g, int& i, int& j, int& k)
-{
-  g = irow % cmfd::ng;
-  i = cmfd::indexmap(irow / cmfd::ng, 0);
-  j = cmfd::indexmap(irow / cmfd::ng, 1);
-  k = cmfd::indexmap(irow / cmfd::ng, 2);
-}
-
 //==============================================================================
 // GET_DIAGONAL_INDEX returns the index in CSR index array corresponding to
 // the diagonal element of a specified row
@@ -285,6 +285,25 @@ void set_indexmap(const int* coremap)
   }
 }
 
+//==============================================================================
+// SET_COLORS splits the accelerated cells into red and black cells such that
+// the neighbors of each cell have the other color
+//==============================================================================
+
+void set_colors()
+{
+  for (auto& cells : cmfd::colors)
+    cells.clear();
+
+  int n_cells = cmfd::dim / cmfd::ng;
+  for (int cell = 0; cell < n_cells; cell++) {
+    int i = cmfd::indexmap(cell, 0);
+    int j = cmfd::indexmap(cell, 1);
+    int k = cmfd::indexmap(cell, 2);
+    cmfd::colors[(i + j + k) % 2].push_back(cell);
+  }
+}
+
 //==============================================================================
 // CMFD_LINSOLVER_1G solves a one group CMFD linear system
 //==============================================================================
@@ -304,19 +323,16 @@ int cmfd_linsolver_1g(
 
     // Perform red/black Gauss-Seidel iterations
     for (int irb = 0; irb < 2; irb++) {
+      const auto& cells = cmfd::colors[irb];
+      int n_cells = cells.size();
 
-// Loop around matrix rows
+// Loop around matrix rows of cells with the current color
 #pragma omp parallel for reduction(+ : err) if (cmfd::use_all_threads)
-      for (int irow = 0; irow < cmfd::dim; irow++) {
-        int g, i, j, k;
-        matrix_to_indices(irow, g, i, j, k);
-
-        // Filter out black cells
-        if ((i + j + k) % 2 != irb)
-          continue;
+      for (int c = 0; c < n_cells; c++) {
+        int irow = cells[c];
 
         // Get index of diagonal for current row
-        int didx = get_diagonal_index(irow);
+        int didx = cmfd::diag[irow];
 
         // Perform temporary sums, first do left of diag, then right of diag
         double tmp1 = 0.0;
@@ -372,20 +388,17 @@ int cmfd_linsolver_2g(
 
     // Perform red/black Gauss-Seidel iterations
     for (int irb = 0; irb < 2; irb++) {
+      const auto& cells = cmfd::colors[irb];
+      int n_cells = cells.size();
 
-// Loop around matrix rows
+// Loop around matrix rows of cells with the current color
 #pragma omp parallel for reduction(+ : err) if (cmfd::use_all_threads)
-      for (int irow = 0; irow < cmfd::dim; irow += 2) {
-        int g, i, j, k;
-        matrix_to_indices(irow, g, i, j, k);
-
-        // Filter out black cells
-        if ((i + j + k) % 2 != irb)
-          continue;
+      for (int c = 0; c < n_cells; c++) {
+        int irow = 2 * cells[c];
 
         // Get index of diagonals for current row and next row
-        int d1idx = get_diagonal_index(irow);
-        int d2idx = get_diagonal_index(irow + 1);
+        int d1idx = cmfd::diag[irow];
+        int d2idx = cmfd::diag[irow + 1];
 
         // Get block diagonal
         double m11 = A_data[d1idx]; // group 1 diagonal
@@ -465,27 +478,50 @@ int cmfd_linsolver_ng(
     // Copy over x vector
     vector<double> tmpx {x, x + cmfd::dim};
 
-    // Loop around matrix rows
-    for (int irow = 0; irow < cmfd::dim; irow++) {
-      // Get index of diagonal for current row
-      int didx = get_diagonal_index(irow);
+    // Update the rows of all groups in a cell and return their error
+    auto sweep_cell = [&](int cell) {
+      double err_cell = 0.0;
+      for (int irow = cell * cmfd::ng; irow < (cell + 1) * cmfd::ng; irow++) {
+        // Get index of diagonal for current row
+        int didx = cmfd::diag[irow];
 
-      // Perform temporary sums, first do left of diag, then right of diag
-      double tmp1 = 0.0;
-      for (int icol = cmfd::indptr[irow]; icol < didx; icol++)
-        tmp1 += A_data[icol] * x[cmfd::indices[icol]];
-      for (int icol = didx + 1; icol < cmfd::indptr[irow + 1]; icol++)
-        tmp1 += A_data[icol] * x[cmfd::indices[icol]];
+        // Perform temporary sums, first do left of diag, then right of diag
+        double tmp1 = 0.0;
+        for (int icol = cmfd::indptr[irow]; icol < didx; icol++)
+          tmp1 += A_data[icol] * x[cmfd::indices[icol]];
+        for (int icol = didx + 1; icol < cmfd::indptr[irow + 1]; icol++)
+          tmp1 += A_data[icol] * x[cmfd::indices[icol]];
 
-      // Solve for new x
-      double x1 = (b[irow] - tmp1) / A_data[didx];
+        // Solve for new x
+        double x1 = (b[irow] - tmp1) / A_data[didx];
 
-      // Perform overrelaxation
-      x[irow] = (1.0 - w) * x[irow] + w * x1;
+        // Perform overrelaxation
+        x[irow] = (1.0 - w) * x[irow] + w * x1;
 
-      // Compute residual and update error
-      double res = (tmpx[irow] - x[irow]) / tmpx[irow];
-      err += res * res;
+        // Compute residual and update error
+        double res = (tmpx[irow] - x[irow]) / tmpx[irow];
+        err_cell += res * res;
+      }
+      return err_cell;
+    };
+
+    if (cmfd::use_all_threads) {
+      // Perform red/black Gauss-Seidel iterations. Cells only couple to
+      // neighboring cells, which have the other color, so all cells of one
+      // color can be updated at the same time.
+      for (int irb = 0; irb < 2; irb++) {
+        const auto& cells = cmfd::colors[irb];
+        int n_cells = cells.size();
+
+#pragma omp parallel for reduction(+ : err)
+        for (int c = 0; c < n_cells; c++)
+          err += sweep_cell(cells[c]);
+      }
+    } else {
+      // Loop around cells in the order of the matrix rows
+      int n_cells = cmfd::dim / cmfd::ng;
+      for (int cell = 0; cell < n_cells; cell++)
+        err += sweep_cell(cell);
     }
 
     // Check convergence
@@ -504,6 +540,178 @@ int cmfd_linsolver_ng(
   return -1;
 }
 
+//==============================================================================
+// CSR_MATVEC computes the product y = Ax of a CMFD matrix and a vector
+//==============================================================================
+
+void csr_matvec(const double* A_data, const double* x, double* y)
+{
+#pragma omp parallel for if (cmfd::use_all_threads)
+  for (int irow = 0; irow < cmfd::dim; irow++) {
+    double sum = 0.0;
+    for (int icol = cmfd::indptr[irow]; icol < cmfd::indptr[irow + 1]; icol++)
+      sum += A_data[icol] * x[cmfd::indices[icol]];
+    y[irow] = sum;
+  }
+}
+
+//==============================================================================
+// DOT_PRODUCT returns the inner product of two vectors
+//==============================================================================
+
+double dot_product(const vector<double>& x, const vector<double>& y)
+{
+  double sum = 0.0;
+#pragma omp parallel for reduction(+ : sum) if (cmfd::use_all_threads)
+  for (int i = 0; i < cmfd::dim; i++)
+    sum += x[i] * y[i];
+  return sum;
+}
+
+//==============================================================================
+// ILU0_FACTORIZE computes the incomplete LU factorization with zero fill-in of
+// a CMFD matrix. The factors share the sparsity pattern of the matrix, with
+// the unit diagonal of L omitted.
+//==============================================================================
+
+void ilu0_factorize(const double* A_data)
+{
+  cmfd::ilu.assign(A_data, A_data + cmfd::indices.size());
+  auto& lu = cmfd::ilu;
+
+  // Position of each column of the current row, or -1 if not in the row
+  vector<int> position(cmfd::dim, -1);
+
+  for (int irow = 0; irow < cmfd::dim; irow++) {
+    for (int icol = cmfd::indptr[irow]; icol < cmfd::indptr[irow + 1]; icol++)
+      position[cmfd::indices[icol]] = icol;
+
+    // Eliminate the entries left of the diagonal using the rows above
+    for (int icol = cmfd::indptr[irow]; icol < cmfd::diag[irow]; icol++) {
+      int k = cmfd::indices[icol];
+      lu[icol] /= lu[cmfd::diag[k]];
+      for (int kcol = cmfd::diag[k] + 1; kcol < cmfd::indptr[k + 1]; kcol++) {
+        int jcol = position[cmfd::indices[kcol]];
+        if (jcol >= 0)
+          lu[jcol] -= lu[icol] * lu[kcol];
+      }
+    }
+
+    for (int icol = cmfd::indptr[irow]; icol < cmfd::indptr[irow + 1]; icol++)
+      position[cmfd::indices[icol]] = -1;
+  }
+}
+
+//==============================================================================
+// APPLY_PRECONDITIONER solves Mz = r for the preconditioner M of the Krylov
+// solver
+//==============================================================================
+
+void apply_preconditioner(
+  const double* A_data, const vector<double>& r, vector<double>& z)
+{
+  if (cmfd::solver == CMFDLinearSolver::BICGSTAB_JACOBI) {
+#pragma omp parallel for if (cmfd::use_all_threads)
+    for (int irow = 0; irow < cmfd::dim; irow++)
+      z[irow] = r[irow] / A_data[cmfd::diag[irow]];
+    return;
+  }
+
+  // Forward substitution with the unit lower triangular factor
+  const auto& lu = cmfd::ilu;
+  for (int irow = 0; irow < cmfd::dim; irow++) {
+    double sum = r[irow];
+    for (int icol = cmfd::indptr[irow]; icol < cmfd::diag[irow]; icol++)
+      sum -= lu[icol] * z[cmfd::indices[icol]];
+    z[irow] = sum;
+  }
+
+  // Backward substitution with the upper triangular factor
+  for (int irow = cmfd::dim - 1; irow >= 0; irow--) {
+    double sum = z[irow];
+    for (int icol = cmfd::diag[irow] + 1; icol < cmfd::indptr[irow + 1];
+         icol++)
+      sum -= lu[icol] * z[cmfd::indices[icol]];
+    z[irow] = sum / lu[cmfd::diag[irow]];
+  }
+}
+
+//==============================================================================
+// CMFD_LINSOLVER_BICGSTAB solves a CMFD linear system with the preconditioned
+// biconjugate gradient stabilized method
+//==============================================================================
+
+int cmfd_linsolver_bicgstab(
+  const double* A_data, const double* b, double* x, double tol)
+{
+  int n = cmfd::dim;
+  vector<double> r(n), r0(n), p(n, 0.0), v(n, 0.0), s(n), t(n), y(n), z(n);
+
+  if (cmfd::solver == CMFDLinearSolver::BICGSTAB_ILU)
+    ilu0_factorize(A_data);
+
+  // Compute initial residual
+  csr_matvec(A_data, x, r.data());
+  for (int i = 0; i < n; i++)
+    r[i] = b[i] - r[i];
+  r0 = r;
+
+  // Iterations stop when the residual relative to the right hand side is
+  // below the tolerance
+  vector<double> b_vec {b, b + n};
+  double b_norm = std::sqrt(dot_product(b_vec, b_vec));
+  if (b_norm == 0.0)
+    b_norm = 1.0;
+  if (std::sqrt(dot_product(r, r)) / b_norm < tol)
+    return 0;
+
+  double rho = 1.0;
+  double alpha = 1.0;
+  double omega = 1.0;
+  for (int it = 1; it <= 10000; it++) {
+    double rho_new = dot_product(r0, r);
+    if (rho_new == 0.0)
+      fatal_error("Breakdown of BiCGStab iterations in CMFD linear solver.");
+
+    // Update search direction
+    double beta = (rho_new / rho) * (alpha / omega);
+    rho = rho_new;
+#pragma omp parallel for if (cmfd::use_all_threads)
+    for (int i = 0; i < n; i++)
+      p[i] = r[i] + beta * (p[i] - omega * v[i]);
+
+    // Take half step along the preconditioned search direction
+    apply_preconditioner(A_data, p, y);
+    csr_matvec(A_data, y.data(), v.data());
+    alpha = rho / dot_product(r0, v);
+#pragma omp parallel for if (cmfd::use_all_threads)
+    for (int i = 0; i < n; i++) {
+      x[i] += alpha * y[i];
+      s[i] = r[i] - alpha * v[i];
+    }
+    if (std::sqrt(dot_product(s, s)) / b_norm < tol)
+      return it;
+
+    // Take stabilizing step along the preconditioned residual
+    apply_preconditioner(A_data, s, z);
+    csr_matvec(A_data, z.data(), t.data());
+    omega = dot_product(t, s) / dot_product(t, t);
+#pragma omp parallel for if (cmfd::use_all_threads)
+    for (int i = 0; i < n; i++) {
+      x[i] += omega * z[i];
+      r[i] = s[i] - omega * t[i];
+    }
+    if (std::sqrt(dot_product(r, r)) / b_norm < tol)
+      return it;
+  }
+
+  // Throw error, as max iterations met
+  fatal_error("Maximum BiCGStab iterations encountered.");
+
+  // Return -1 by default, although error thrown before reaching this point
+  return -1;
+}
+
 //==============================================================================
 // OPENMC_INITIALIZE_LINSOLVER sets the fixed variables that are used for the
 // linear solver
@@ -511,7 +719,7 @@ int cmfd_linsolver_ng(
 
 extern "C" void openmc_initialize_linsolver(const int* indptr, int len_indptr,
   const int* indices, int n_elements, int dim, double spectral, const int* map,
-  bool use_all_threads)
+  bool use_all_threads, int solver)
 {
   // Store elements of indptr
   for (int i = 0; i < len_indptr; i++)
@@ -525,25 +733,34 @@ extern "C" void openmc_initialize_linsolver(const int* indptr, int len_indptr,
   cmfd::dim = dim;
   cmfd::spectral = spectral;
 
-  // Set indexmap if 1 or 2 group problem
-  if (cmfd::ng == 1 || cmfd::ng == 2) {
-    // Resize indexmap and set its elements
-    cmfd::indexmap.resize({static_cast<size_t>(dim), 3});
-    set_indexmap(map);
-  }
+  // Store index of diagonal element of each row
+  cmfd::diag.resize(dim);
+  for (int irow = 0; irow < dim; irow++)
+    cmfd::diag[irow] = get_diagonal_index(irow);
+
+  // Resize indexmap, set its elements and color cells for red/black sweeps
+  cmfd::indexmap.resize({static_cast<size_t>(dim / cmfd::ng), 3});
+  set_indexmap(map);
+  set_colors();
 
   // Use all threads allocated to OpenMC simulation to run CMFD solver
   cmfd::use_all_threads = use_all_threads;
+
+  // Set type of linear solver
+  cmfd::solver = static_cast<CMFDLinearSolver>(solver);
 }
 
 //==============================================================================
-// OPENMC_RUN_LINSOLVER runs a Gauss Seidel linear solver to solve CMFD matrix
-// equations
+// OPENMC_RUN_LINSOLVER runs a Gauss Seidel or BiCGStab linear solver to solve
+// CMFD matrix equations
 //==============================================================================
 
 extern "C" int openmc_run_linsolver(
   const double* A_data, const double* b, double* x, double tol)
 {
+  if (cmfd::solver != CMFDLinearSolver::GAUSS_SEIDEL)
+    return cmfd_linsolver_bicgstab(A_data, b, x, tol);
+
   switch (cmfd::ng) {
   case 1:
     return cmfd_linsolver_1g(A_data, b, x, tol);
@@ -559,6 +776,10 @@ void free_memory_cmfd()
   // Clear vectors
   cmfd::indptr.clear();
   cmfd::indices.clear();
+  cmfd::diag.clear();
+  for (auto& cells : cmfd::colors)
+    cells.clear();
+  cmfd::ilu.clear();
   cmfd::egrid.clear();
 
   // Resize xtensors to be empty
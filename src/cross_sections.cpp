@@ -8,21 +8,26 @@
 #include "openmc/geometry_aux.h"
 #include "openmc/hdf5_interface.h"
 #include "openmc/material.h"
+#include "openmc/memory_report.h"
 #include "openmc/message_passing.h"
 #include "openmc/mgxs_interface.h"
 #include "openmc/nuclide.h"
+#include "openmc/numa.h"
 #include "openmc/photon.h"
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
 #include "openmc/string_utils.h"
+#include "openmc/tallies/tally.h"
 #include "openmc/thermal.h"
 #include "openmc/timer.h"
 #include "openmc/wmp.h"
 #include "openmc/xml_interface.h"
+#include "openmc/xs_cache.h"
 
 #include "pugixml.hpp"
 
-#include <cstdlib> // for getenv
+#include <algorithm> // for max
+#include <cstdlib>   // for getenv
 #include <unordered_set>
 
 namespace openmc {
@@ -195,29 +200,70 @@ void read_ce_cross_sections(const vector<vector<double>>& nuc_temps,
     thermal_names[kv.second] = kv.first;
   }
 
-  // Read cross sections
-  for (const auto& mat : model::materials) {
-    for (int i_nuc : mat->nuclide_) {
-      // Find name of corresponding nuclide. Because we haven't actually loaded
-      // data, we don't have the name available, so instead we search through
-      // all key/value pairs in nuclide_map
-      std::string& name = nuclide_names[i_nuc];
-
-      // If we've already read this nuclide, skip it
-      if (already_read.find(name) != already_read.end())
-        continue;
+  // Map the cross sections cached by a previous run, or write them once all
+  // nuclides have been read if there is no cache yet
+  bool write_cache = false;
+  if (!settings::path_xs_cache.empty() && !settings::photon_only) {
+    write_cache = !file_exists(settings::path_xs_cache);
+    if (!write_cache)
+      data::xs_cache.open(settings::path_xs_cache);
+  }
 
-      const auto& temps = nuc_temps[i_nuc];
-      int err = openmc_load_nuclide(name.c_str(), temps.data(), temps.size());
+  // Read cross sections. Since HDF5 is not threadsafe, nuclides are read by a
+  // single thread while the derived cross sections of the nuclides already
+  // read are set up by other threads. Cross sections shared on a node must be
+  // complete before they are shared, so these nuclides are set up as they are
+  // read.
+  bool overlap = !settings::shared_xs;
+  int err = 0;
+
+#pragma omp parallel if (overlap)
+#pragma omp single
+  {
+    for (const auto& mat : model::materials) {
       if (err < 0)
-        throw std::runtime_error {openmc_err_msg};
-
-      already_read.insert(name);
+        break;
+      for (int i_nuc : mat->nuclide_) {
+        // Find name of corresponding nuclide. Because we haven't actually
+        // loaded data, we don't have the name available, so instead we search
+        // through all key/value pairs in nuclide_map
+        std::string& name = nuclide_names[i_nuc];
+
+        // If we've already read this nuclide, skip it
+        if (already_read.find(name) != already_read.end())
+          continue;
+
+        const auto& temps = nuc_temps[i_nuc];
+        auto n_read = data::nuclides.size();
+        err = load_nuclide(name.c_str(), temps.data(), temps.size(), !overlap);
+        if (err < 0)
+          break;
+        already_read.insert(name);
+        if (data::nuclides.size() == n_read)
+          continue;
+
+        Nuclide* nuc = data::nuclides.back().get();
+        if (overlap) {
+#pragma omp task firstprivate(nuc)
+          nuc->create_derived();
+        } else {
+          // Keep one copy of the tabulated cross sections on each node
+          nuc->share_xs();
+        }
+      }
     }
   }
+  if (err < 0)
+    throw std::runtime_error {openmc_err_msg};
+  if (write_cache && mpi::master)
+    write_xs_cache(settings::path_xs_cache);
 
   // Perform final tasks -- reading S(a,b) tables, normalizing densities
   for (auto& mat : model::materials) {
+    // Thermal scattering only affects neutrons
+    if (settings::photon_only)
+      mat->thermal_tables_.clear();
+
     for (const auto& table : mat->thermal_tables_) {
       // Get name of S(a,b) table
       int i_table = table.index_table;
@@ -250,17 +296,39 @@ void read_ce_cross_sections(const vector<vector<double>>& nuc_temps,
     mat->finalize();
   } // materials
 
+  // Tabulate macroscopic photon cross sections
+  if (settings::photon_transport && settings::photon_material_xs) {
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < model::materials.size(); ++i) {
+      model::materials[i]->init_photon_xs_table();
+    }
+  }
+
   if (settings::photon_transport &&
       settings::electron_treatment == ElectronTreatment::TTB) {
     // Take logarithm of energies since they are log-log interpolated
     data::ttb_e_grid = xt::log(data::ttb_e_grid);
+
+    // Build a guide table for finding the incident energy on the grid
+    if (settings::guide_table_cells > 0) {
+      auto n_e = data::ttb_e_grid.size();
+      double e_min = data::ttb_e_grid(0);
+      double e_max = data::ttb_e_grid(n_e - 1);
+      vector<double> e(n_e);
+      for (int i = 0; i < n_e; ++i) {
+        e[i] = (data::ttb_e_grid(i) - e_min) / (e_max - e_min);
+      }
+      data::ttb_e_guide = GuideTable(e, settings::guide_table_cells);
+    }
   }
 
   // Show minimum/maximum temperature
-  write_message(
-    4, "Minimum neutron data temperature: {} K", data::temperature_min);
-  write_message(
-    4, "Maximum neutron data temperature: {} K", data::temperature_max);
+  if (!settings::photon_only) {
+    write_message(
+      4, "Minimum neutron data temperature: {} K", data::temperature_min);
+    write_message(
+      4, "Maximum neutron data temperature: {} K", data::temperature_max);
+  }
 
   // If the user wants multipole, make sure we found a multipole library.
   if (settings::temperature_multipole) {
@@ -334,8 +402,10 @@ void read_ce_cross_sections_xml()
 
 void finalize_cross_sections()
 {
-  if (settings::run_mode != RunMode::PLOTTING) {
+  if (!geometry_only()) {
     simulation::time_read_xs.start();
+    double memory_before = resident_memory();
+    begin_interleave();
     if (settings::run_CE) {
       // Determine desired temperatures for each nuclide and S(a,b) table
       double_2dvec nuc_temps(data::nuclide_map.size());
@@ -350,10 +420,47 @@ void finalize_cross_sections()
       data::mg.init();
       mark_fissionable_mgxs_materials();
     }
+    end_interleave();
+    data::nuclear_data_memory = resident_memory() - memory_before;
     simulation::time_read_xs.stop();
   }
 }
 
+void prune_nuclear_data()
+{
+  if (!settings::prune_nuclear_data || !settings::run_CE || geometry_only())
+    return;
+
+  // Reactions that are tallied or that depletion reads by MT, including the
+  // charged-particle production sums that depletion chains refer to
+  array<bool, 902> keep;
+  keep.fill(false);
+  for (int mt : DEPLETION_RX) {
+    keep[mt] = true;
+  }
+  for (int mt : {N_P, N_D, N_T, N_3HE, N_A}) {
+    keep[mt] = true;
+  }
+  for (const auto& t : model::tallies) {
+    for (int score : t->scores_) {
+      if (score > 0 && score < keep.size())
+        keep[score] = true;
+    }
+  }
+
+  int64_t n_products = 0;
+  int64_t n_reactions = 0;
+  double memory = 0.0;
+  for (auto& nuc : data::nuclides) {
+    memory += nuc->prune_data(keep, n_products, n_reactions);
+  }
+  data::nuclear_data_memory = std::max(data::nuclear_data_memory - memory, 0.0);
+  write_message(6,
+    "Pruned {} reaction products and the cross sections of {} reactions, "
+    "freeing {:.1f} MB of cross sections",
+    n_products, n_reactions, memory);
+}
+
 void library_clear()
 {
   data::libraries.clear();
@@ -165,6 +165,13 @@ void DAGUniverse::init_geometry()
   cell_idx_offset_ = model::cells.size();
   next_cell_id++;
 
+#ifdef OPENMC_EMBREE
+  // load the triangles of the model into the ray tracer shared by its cells
+  // and surfaces
+  auto ray_tracer =
+    std::make_shared<const EmbreeRayTracer>(dagmc_instance_.get());
+#endif
+
   // initialize cell objects
   int n_cells = dagmc_instance_->num_entities(3);
   moab::EntityHandle graveyard = 0;
@@ -178,6 +185,9 @@ void DAGUniverse::init_geometry()
                : dagmc_instance_->id_by_index(3, c->dag_index());
     c->universe_ = this->id_;
     c->fill_ = C_NONE; // no fill, single universe
+#ifdef OPENMC_EMBREE
+    c->ray_tracer_ = ray_tracer;
+#endif
 
     auto in_map = model::cell_map.find(c->id_);
     if (in_map == model::cell_map.end()) {
@@ -269,6 +279,9 @@ void DAGUniverse::init_geometry()
     auto s = std::make_unique<DAGSurface>(dagmc_instance_, i + 1);
     s->id_ = adjust_geometry_ids_ ? next_surf_id++
                                   : dagmc_instance_->id_by_index(2, i + 1);
+#ifdef OPENMC_EMBREE
+    s->ray_tracer_ = ray_tracer;
+#endif
 
     // set surface source attribute if needed
     if (contains(settings::source_write_surf_id, s->id_) ||
@@ -407,10 +420,33 @@ bool DAGUniverse::find_cell(GeometryState& p) const
   if (!found && model::universe_map[this->id_] != model::root_universe) {
     p.lowest_coord().cell = implicit_complement_idx();
     found = true;
+  } else if (!found && partitioner_) {
+    // The partitioner leaves out the implicit complement, which is checked on
+    // its own in the root universe
+    int32_t i_cell = implicit_complement_idx();
+    if (model::cells[i_cell]->contains(
+          p.r_local(), p.u_local(), p.surface())) {
+      p.lowest_coord().cell = i_cell;
+      found = true;
+    }
   }
   return found;
 }
 
+void DAGUniverse::partition()
+{
+  Universe bounded;
+  int32_t i_complement = implicit_complement_idx();
+  for (auto i_cell : cells_) {
+    if (i_cell != i_complement)
+      bounded.cells_.push_back(i_cell);
+  }
+
+  auto octree = std::make_unique<OctreePartitioner>(bounded);
+  if (octree->mean_cells() < 0.5 * bounded.cells_.size())
+    partitioner_ = std::move(octree);
+}
+
 void DAGUniverse::to_hdf5(hid_t universes_group) const
 {
   // Create a group for this universe.
@@ -615,11 +651,41 @@ DAGCell::DAGCell(std::shared_ptr<moab::DagMC> dag_ptr, int32_t dag_idx)
   : Cell {}, dagmc_ptr_(dag_ptr), dag_index_(dag_idx)
 {
   geom_type_ = GeometryType::DAG;
+
+  // The implicit complement contains points outside of every other volume,
+  // so only the boxes of the other volumes can be used to reject points
+  moab::EntityHandle vol = dagmc_ptr_->entity_by_index(3, dag_index_);
+  if (!dagmc_ptr_->is_implicit_complement(vol)) {
+    bbox_ = bounding_box();
+    bbox_.xmin -= TINY_BIT;
+    bbox_.xmax += TINY_BIT;
+    bbox_.ymin -= TINY_BIT;
+    bbox_.ymax += TINY_BIT;
+    bbox_.zmin -= TINY_BIT;
+    bbox_.zmax += TINY_BIT;
+  }
 };
 
 std::pair<double, int32_t> DAGCell::distance(
   Position r, Direction u, int32_t on_surface, GeometryState* p) const
 {
+  // A query further along the last ray fired in this volume, such as after a
+  // step that ended without a collision or a change of direction, is
+  // answered by subtracting the distance travelled since then. This avoids
+  // another traversal of the bounding volume hierarchy.
+  auto& cache = p->dag_ray_cache();
+  if (cache.universe == p->lowest_coord().universe &&
+      cache.dag_index == dag_index_ && u == cache.u) {
+    Position dr = r - cache.r;
+    double s = dr.dot(u);
+    if (s >= 0.0 && s < cache.distance &&
+        (dr - s * u).norm() <= FP_COINCIDENT * std::max(1.0, r.norm())) {
+      p->last_dir() = u;
+      p->history() = cache.history;
+      return {cache.distance - s, cache.surface};
+    }
+  }
+
   // if we've changed direction or we're not on a surface,
   // reset the history and update last direction
   if (u != p->last_dir()) {
@@ -643,14 +709,27 @@ std::pair<double, int32_t> DAGCell::distance(
   moab::EntityHandle vol = dagmc_ptr_->entity_by_index(3, dag_index_);
   moab::EntityHandle hit_surf;
 
+#ifdef OPENMC_EMBREE
+  int i_hit;
+  dist = ray_tracer_->distance_to_boundary(dag_index_, r, u, i_hit);
+  hit_surf = i_hit > 0 ? dagmc_ptr_->entity_by_index(2, i_hit) : 0;
+#else
   // create the ray
   double pnt[3] = {r.x, r.y, r.z};
   double dir[3] = {u.x, u.y, u.z};
   MB_CHK_ERR_CONT(
     dagmc_ptr_->ray_fire(vol, pnt, dir, hit_surf, dist, &p->history()));
+#endif
   if (hit_surf != 0) {
     surf_idx =
       dag_univ->surf_idx_offset_ + dagmc_ptr_->index_by_handle(hit_surf);
+    cache.universe = p->lowest_coord().universe;
+    cache.dag_index = dag_index_;
+    cache.r = r;
+    cache.u = u;
+    cache.distance = dist;
+    cache.surface = surf_idx;
+    cache.history = p->history();
   } else if (!dagmc_ptr_->is_implicit_complement(vol) ||
              is_root_universe(dag_univ->id_)) {
     // surface boundary conditions are ignored for projection plotting, meaning
@@ -658,7 +737,7 @@ std::pair<double, int32_t> DAGCell::distance(
     // into the implicit complement on the other side where no intersection will
     // be found. Treating this as a lost particle is problematic when plotting.
     // Instead, the infinite distance and invalid surface index are returned.
-    if (settings::run_mode == RunMode::PLOTTING)
+    if (geometry_only())
       return {INFTY, -1};
 
     // the particle should be marked as lost immediately if an intersection
@@ -679,6 +758,11 @@ std::pair<double, int32_t> DAGCell::distance(
 
 bool DAGCell::contains(Position r, Direction u, int32_t on_surface) const
 {
+  // Points outside of the bounding box are rejected without firing rays
+  if (r.x < bbox_.xmin || r.x > bbox_.xmax || r.y < bbox_.ymin ||
+      r.y > bbox_.ymax || r.z < bbox_.zmin || r.z > bbox_.zmax)
+    return false;
+
   moab::ErrorCode rval;
   moab::EntityHandle vol = dagmc_ptr_->entity_by_index(3, dag_index_);
 
@@ -732,6 +816,9 @@ double DAGSurface::evaluate(Position r) const
 
 double DAGSurface::distance(Position r, Direction u, bool coincident) const
 {
+#ifdef OPENMC_EMBREE
+  return ray_tracer_->distance_to_surface(dag_index_, r, u);
+#else
   moab::ErrorCode rval;
   moab::EntityHandle surf = dagmc_ptr_->entity_by_index(2, dag_index_);
   moab::EntityHandle hit_surf;
@@ -743,6 +830,7 @@ double DAGSurface::distance(Position r, Direction u, bool coincident) const
   if (dist < 0.0)
     dist = INFTY;
   return dist;
+#endif
 }
 
 Direction DAGSurface::normal(Position r) const
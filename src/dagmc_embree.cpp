@@ -0,0 +1,239 @@
+#include "openmc/dagmc_embree.h"
+
+#if defined(DAGMC) && defined(OPENMC_EMBREE)
+
+#include <algorithm> // for max
+#include <cfloat>    // for FLT_EPSILON
+#include <cmath>
+
+#include <fmt/core.h>
+
+#include "openmc/constants.h"
+#include "openmc/error.h"
+
+namespace openmc {
+
+namespace {
+
+//! Identity transformation of an instance, as a column major 3x4 matrix
+constexpr float IDENTITY[12] {1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0};
+
+//! Relative distance by which rays are started behind their origin, so that
+//! a surface close to the origin is not missed due to the single precision
+//! arithmetic of Embree
+constexpr double BACKOFF {16.0 * FLT_EPSILON};
+
+void check_device(RTCDevice device)
+{
+  auto err = rtcGetDeviceError(device);
+  if (err != RTC_ERROR_NONE)
+    fatal_error(fmt::format("Embree error {} while building the ray tracing "
+                            "scenes of a DAGMC universe.",
+      static_cast<int>(err)));
+}
+
+} // namespace
+
+//==============================================================================
+// EmbreeRayTracer implementation
+//==============================================================================
+
+EmbreeRayTracer::EmbreeRayTracer(moab::DagMC* dagmc)
+{
+  device_ = rtcNewDevice(nullptr);
+  if (!device_)
+    fatal_error("Could not create an Embree device.");
+  auto* mbi = dagmc->moab_instance();
+
+  // Load the triangles of each surface into a scene of its own
+  int n_surfs = dagmc->num_entities(2);
+  surface_scenes_.resize(n_surfs);
+  facets_.resize(n_surfs);
+  for (int i = 0; i < n_surfs; ++i) {
+    moab::EntityHandle surf = dagmc->entity_by_index(2, i + 1);
+    moab::Range tris;
+    MB_CHK_ERR_CONT(mbi->get_entities_by_type(surf, moab::MBTRI, tris));
+
+    RTCGeometry geom = rtcNewGeometry(device_, RTC_GEOMETRY_TYPE_TRIANGLE);
+    auto* vertices = static_cast<float*>(
+      rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0,
+        RTC_FORMAT_FLOAT3, 3 * sizeof(float), 3 * tris.size()));
+    auto* indices = static_cast<unsigned*>(
+      rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0,
+        RTC_FORMAT_UINT3, 3 * sizeof(unsigned), tris.size()));
+    check_device(device_);
+
+    auto& facets = facets_[i];
+    facets.reserve(tris.size());
+    int j = 0;
+    for (auto tri : tris) {
+      const moab::EntityHandle* conn;
+      int n_conn;
+      MB_CHK_ERR_CONT(mbi->get_connectivity(tri, conn, n_conn));
+      double coords[9];
+      MB_CHK_ERR_CONT(mbi->get_coords(conn, 3, coords));
+
+      Position v0 {coords[0], coords[1], coords[2]};
+      Position v1 {coords[3], coords[4], coords[5]};
+      Position v2 {coords[6], coords[7], coords[8]};
+      Direction n = (v1 - v0).cross(v2 - v0);
+      facets.push_back({n, n.dot(v0)});
+
+      for (int k = 0; k < 9; ++k) {
+        vertices[9 * j + k] = static_cast<float>(coords[k]);
+      }
+      for (int k = 0; k < 3; ++k) {
+        indices[3 * j + k] = 3 * j + k;
+      }
+      ++j;
+    }
+
+    // The filter given to volume queries applies to the instanced triangles
+    rtcSetGeometryEnableFilterFunctionFromArguments(geom, true);
+    rtcCommitGeometry(geom);
+
+    surface_scenes_[i] = rtcNewScene(device_);
+    rtcSetSceneFlags(surface_scenes_[i], RTC_SCENE_FLAG_ROBUST);
+    rtcSetSceneBuildQuality(surface_scenes_[i], RTC_BUILD_QUALITY_HIGH);
+    rtcAttachGeometry(surface_scenes_[i], geom);
+    rtcReleaseGeometry(geom);
+    rtcCommitScene(surface_scenes_[i]);
+    check_device(device_);
+  }
+
+  // Each volume instances the scenes of the surfaces bounding it
+  int n_vols = dagmc->num_entities(3);
+  volume_scenes_.resize(n_vols);
+  volumes_.resize(n_vols);
+  for (int i = 0; i < n_vols; ++i) {
+    moab::EntityHandle vol = dagmc->entity_by_index(3, i + 1);
+    std::vector<moab::EntityHandle> surfs;
+    MB_CHK_ERR_CONT(mbi->get_child_meshsets(vol, surfs));
+
+    volume_scenes_[i] = rtcNewScene(device_);
+    rtcSetSceneFlags(volume_scenes_[i], RTC_SCENE_FLAG_ROBUST);
+    rtcSetSceneBuildQuality(volume_scenes_[i], RTC_BUILD_QUALITY_HIGH);
+    for (auto surf : surfs) {
+      int i_surf = dagmc->index_by_handle(surf);
+      int sense;
+      MB_CHK_ERR_CONT(dagmc->surface_sense(vol, surf, sense));
+
+      RTCGeometry inst = rtcNewGeometry(device_, RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(inst, surface_scenes_[i_surf - 1]);
+      rtcSetGeometryTransform(
+        inst, 0, RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR, IDENTITY);
+      rtcCommitGeometry(inst);
+      unsigned inst_id = rtcAttachGeometry(volume_scenes_[i], inst);
+      rtcReleaseGeometry(inst);
+
+      if (inst_id >= volumes_[i].size())
+        volumes_[i].resize(inst_id + 1);
+      volumes_[i][inst_id] = {i_surf, sense};
+    }
+    rtcCommitScene(volume_scenes_[i]);
+    check_device(device_);
+  }
+}
+
+EmbreeRayTracer::~EmbreeRayTracer()
+{
+  for (auto scene : volume_scenes_) {
+    rtcReleaseScene(scene);
+  }
+  for (auto scene : surface_scenes_) {
+    rtcReleaseScene(scene);
+  }
+  rtcReleaseDevice(device_);
+}
+
+void EmbreeRayTracer::exiting_filter(const RTCFilterFunctionNArguments* args)
+{
+  const auto* ctx = reinterpret_cast<const QueryContext*>(args->context);
+  for (unsigned i = 0; i < args->N; ++i) {
+    if (args->valid[i] != -1)
+      continue;
+
+    unsigned inst_id = RTCHitN_instID(args->hit, args->N, i, 0);
+    const auto& s = (*ctx->surfaces)[inst_id];
+    if (s.sense == 0)
+      continue;
+
+    unsigned prim_id = RTCHitN_primID(args->hit, args->N, i);
+    const auto& n = ctx->tracer->facets_[s.i_surf - 1][prim_id].n;
+    Direction u {RTCRayN_dir_x(args->ray, args->N, i),
+      RTCRayN_dir_y(args->ray, args->N, i),
+      RTCRayN_dir_z(args->ray, args->N, i)};
+    if (s.sense * n.dot(u) <= 0.0)
+      args->valid[i] = 0;
+  }
+}
+
+bool EmbreeRayTracer::trace(RTCScene scene, Position r, Direction u,
+  RTCIntersectArguments* args, RTCRayHit& rayhit) const
+{
+  // Intersections behind the starting point are found again in double
+  // precision by the caller
+  double backoff =
+    BACKOFF * (1.0 + std::max({std::abs(r.x), std::abs(r.y), std::abs(r.z)}));
+  Position origin = r - backoff * u;
+
+  auto& ray = rayhit.ray;
+  ray.org_x = origin.x;
+  ray.org_y = origin.y;
+  ray.org_z = origin.z;
+  ray.dir_x = u.x;
+  ray.dir_y = u.y;
+  ray.dir_z = u.z;
+  ray.tnear = 0.0f;
+  ray.tfar = INFINITY;
+  ray.time = 0.0f;
+  ray.mask = 0xFFFFFFFF;
+  ray.flags = 0;
+  rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+  rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
+
+  rtcIntersect1(scene, &rayhit, args);
+  return rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+}
+
+double EmbreeRayTracer::distance_to_boundary(
+  int i_vol, Position r, Direction u, int& i_surf) const
+{
+  QueryContext ctx;
+  rtcInitRayQueryContext(&ctx.base);
+  ctx.tracer = this;
+  ctx.surfaces = &volumes_[i_vol - 1];
+
+  RTCIntersectArguments args;
+  rtcInitIntersectArguments(&args);
+  args.context = &ctx.base;
+  args.filter = exiting_filter;
+  args.flags = static_cast<RTCRayQueryFlags>(
+    args.flags | RTC_RAY_QUERY_FLAG_INVOKE_ARGUMENT_FILTER);
+
+  RTCRayHit rayhit;
+  i_surf = 0;
+  if (!trace(volume_scenes_[i_vol - 1], r, u, &args, rayhit))
+    return INFTY;
+
+  i_surf = volumes_[i_vol - 1][rayhit.hit.instID[0]].i_surf;
+  const auto& f = facets_[i_surf - 1][rayhit.hit.primID];
+  return std::max(0.0, (f.d - f.n.dot(r)) / f.n.dot(u));
+}
+
+double EmbreeRayTracer::distance_to_surface(
+  int i_surf, Position r, Direction u) const
+{
+  RTCRayHit rayhit;
+  if (!trace(surface_scenes_[i_surf - 1], r, u, nullptr, rayhit))
+    return INFTY;
+
+  // A hit between the start of the ray and its origin means the origin is on
+  // the surface
+  const auto& f = facets_[i_surf - 1][rayhit.hit.primID];
+  return std::max(0.0, (f.d - f.n.dot(r)) / f.n.dot(u));
+}
+
+} // namespace openmc
+
+#endif // DAGMC && OPENMC_EMBREE
@@ -0,0 +1,368 @@
+#include "openmc/delta_tracking.h"
+
+#include <algorithm> // for fill, max, min
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <utility> // for pair
+
+#include <fmt/core.h>
+
+#include "openmc/capi.h"
+#include "openmc/cell.h"
+#include "openmc/constants.h"
+#include "openmc/error.h"
+#include "openmc/lattice.h"
+#include "openmc/material.h"
+#include "openmc/message_passing.h"
+#include "openmc/nuclide.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+#include "openmc/thermal.h"
+#include "openmc/universe.h"
+#include "openmc/urr.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace model {
+
+vector<Majorant> majorants;
+vector<int> cell_majorant;
+
+} // namespace model
+
+namespace {
+
+//! Number of energies per bin at which thermal scattering cross sections are
+//! evaluated to bound them
+constexpr int N_THERMAL_POINTS {8};
+
+//! Whether a total cross section exceeding a majorant has been reported
+std::atomic<bool> exceeded_reported {false};
+
+//! Collect the materials of all cells contained in a universe
+void collect_materials(
+  int32_t i_univ, std::set<int32_t>& visited, std::set<int32_t>& materials);
+
+//! Collect the materials of all cells contained in a cell, including itself
+void collect_materials(
+  const Cell& c, std::set<int32_t>& visited, std::set<int32_t>& materials)
+{
+  if (c.type_ == Fill::MATERIAL) {
+    for (auto i_mat : c.material_) {
+      if (i_mat != MATERIAL_VOID)
+        materials.insert(i_mat);
+    }
+  } else if (c.type_ == Fill::UNIVERSE) {
+    collect_materials(c.fill_, visited, materials);
+  } else {
+    const auto& lat = *model::lattices[c.fill_];
+    for (auto i_univ : lat.universes_) {
+      if (i_univ != C_NONE)
+        collect_materials(i_univ, visited, materials);
+    }
+    if (lat.outer_ != NO_OUTER_UNIVERSE)
+      collect_materials(lat.outer_, visited, materials);
+  }
+}
+
+void collect_materials(
+  int32_t i_univ, std::set<int32_t>& visited, std::set<int32_t>& materials)
+{
+  // Lattices usually repeat the same universes many times
+  if (!visited.insert(i_univ).second)
+    return;
+  for (auto i_cell : model::universes[i_univ]->cells_) {
+    collect_materials(*model::cells[i_cell], visited, materials);
+  }
+}
+
+//! Index in data::thermal_scatt of the thermal scattering table applied to a
+//! nuclide of a material, or C_NONE
+int thermal_table(const Material& mat, int i)
+{
+  for (const auto& table : mat.thermal_tables_) {
+    if (table.index_nuclide == i)
+      return table.index_table;
+  }
+  return C_NONE;
+}
+
+//! Bound the microscopic total cross section of a nuclide in each bin of the
+//! logarithmic energy grid
+//
+//! \param[in] nuc  Nuclide
+//! \param[in] i_sab  Index in data::thermal_scatt of the thermal scattering
+//!   table applied to the nuclide, or C_NONE
+//! \param[out] micro  Upper bound on the total cross section in [b]
+void nuclide_majorant(const Nuclide& nuc, int i_sab, vector<double>& micro)
+{
+  int neutron = static_cast<int>(ParticleType::neutron);
+  double E_min = data::energy_min[neutron];
+  int M = micro.size();
+  std::fill(micro.begin(), micro.end(), 0.0);
+
+  // Cross sections are linearly interpolated in energy, so they are bounded
+  // by the grid points bracketing each bin. Interpolating between
+  // temperatures is bounded by the largest value over all temperatures.
+  for (int t = 0; t < nuc.grid_.size(); ++t) {
+    const auto& grid = nuc.grid_[t];
+    int n = grid.energy.size();
+    for (int j = 0; j < M; ++j) {
+      int i_low = grid.grid_index[j];
+      int i_high = std::min(grid.grid_index[j + 1] + 1, n - 1);
+      for (int i = i_low; i <= i_high; ++i) {
+        micro[j] = std::max(micro[j], nuc.total_xs(t, i));
+      }
+    }
+  }
+
+  // Sampled probability tables are bounded by the largest band cross sections.
+  // Inelastic scattering is taken from the smooth cross section, which is
+  // bounded by the smooth total cross section.
+  if (settings::urr_ptables_on && nuc.urr_present_) {
+    for (const auto& urr : nuc.urr_data_) {
+      double band_max = 0.0;
+      for (const auto& band : urr.xs_values_) {
+        band_max = std::max(band_max, band.elastic + band.fission +
+                                        band.n_gamma);
+      }
+      for (int j = 0; j < M; ++j) {
+        double E_lo = E_min * std::exp(j * simulation::log_spacing);
+        double E_hi = E_min * std::exp((j + 1) * simulation::log_spacing);
+        if (E_hi <= urr.energy_.front() || E_lo >= urr.energy_.back())
+          continue;
+        micro[j] += urr.multiply_smooth_ ? band_max * micro[j] : band_max;
+      }
+    }
+  }
+
+  // Thermal scattering adds to the total cross section below its maximum
+  // energy. It is bounded by evaluating it at several energies in each bin.
+  if (i_sab != C_NONE) {
+    const auto& sab = *data::thermal_scatt[i_sab];
+    for (int j = 0; j < M; ++j) {
+      double E_lo = E_min * std::exp(j * simulation::log_spacing);
+      if (E_lo >= sab.energy_max_)
+        break;
+      double E_hi = std::min(
+        E_min * std::exp((j + 1) * simulation::log_spacing), sab.energy_max_);
+      double thermal_max = 0.0;
+      for (const auto& data : sab.data_) {
+        for (int k = 0; k <= N_THERMAL_POINTS; ++k) {
+          double E =
+            E_lo * std::pow(E_hi / E_lo, k / double(N_THERMAL_POINTS));
+          double elastic, inelastic;
+          data.calculate_xs(E, &elastic, &inelastic);
+          thermal_max = std::max(thermal_max, elastic + inelastic);
+        }
+      }
+      micro[j] += thermal_max;
+    }
+  }
+}
+
+} // namespace
+
+//==============================================================================
+// Majorant implementation
+//==============================================================================
+
+Majorant::Majorant(const vector<int32_t>& materials)
+{
+  // Find each distinct nuclide and thermal scattering table pair, since the
+  // same nuclides usually appear in many materials
+  vector<std::pair<int, int>> pairs;
+  std::map<std::pair<int, int>, int> pair_index;
+  for (auto i_mat : materials) {
+    const auto& mat = *model::materials[i_mat];
+    for (int i = 0; i < mat.nuclide_.size(); ++i) {
+      const auto& nuc = *data::nuclides[mat.nuclide_[i]];
+      if (settings::temperature_multipole && nuc.multipole_) {
+        throw std::runtime_error {fmt::format(
+          "Majorant cross sections cannot be built with windowed multipole "
+          "data, which is present for {} in material {}.",
+          nuc.name_, mat.id_)};
+      }
+
+      std::pair<int, int> key {mat.nuclide_[i], thermal_table(mat, i)};
+      if (pair_index.emplace(key, pairs.size()).second)
+        pairs.push_back(key);
+    }
+  }
+
+  // Bound the microscopic cross sections of each pair in parallel
+  int M = settings::n_log_bins;
+  vector<vector<double>> micro(pairs.size(), vector<double>(M));
+#pragma omp parallel for schedule(dynamic)
+  for (int k = 0; k < pairs.size(); ++k) {
+    nuclide_majorant(
+      *data::nuclides[pairs[k].first], pairs[k].second, micro[k]);
+  }
+
+  // The majorant is the largest macroscopic cross section of any material
+  xs_.assign(M, 0.0);
+  vector<double> macro(M);
+  for (auto i_mat : materials) {
+    const auto& mat = *model::materials[i_mat];
+    std::fill(macro.begin(), macro.end(), 0.0);
+    for (int i = 0; i < mat.nuclide_.size(); ++i) {
+      int k = pair_index[{mat.nuclide_[i], thermal_table(mat, i)}];
+      const auto& m = micro[k];
+      double density = mat.atom_density_(i);
+      for (int j = 0; j < M; ++j) {
+        macro[j] += density * m[j];
+      }
+    }
+
+    for (int j = 0; j < M; ++j) {
+      xs_[j] = std::max(xs_[j], macro[j]);
+    }
+  }
+}
+
+double Majorant::operator()(double E) const
+{
+  int neutron = static_cast<int>(ParticleType::neutron);
+  int j = std::log(E / data::energy_min[neutron]) / simulation::log_spacing;
+  j = std::max(0, std::min(j, static_cast<int>(xs_.size()) - 1));
+  return xs_[j];
+}
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void init_delta_tracking()
+{
+  model::majorants.clear();
+  model::cell_majorant.clear();
+  exceeded_reported = false;
+
+  // Only neutrons are delta-tracked
+  if (settings::delta_tracking_cells.empty() || settings::photon_only)
+    return;
+
+  if (!settings::run_CE) {
+    fatal_error("Delta tracking is only supported in continuous-energy mode.");
+  }
+
+  model::cell_majorant.assign(model::cells.size(), C_NONE);
+  for (auto id : settings::delta_tracking_cells) {
+    auto it = model::cell_map.find(id);
+    if (it == model::cell_map.end()) {
+      fatal_error(
+        fmt::format("Cell {} for delta tracking does not exist.", id));
+    }
+    if (model::cell_majorant[it->second] != C_NONE)
+      continue;
+
+    std::set<int32_t> visited;
+    std::set<int32_t> materials;
+    collect_materials(*model::cells[it->second], visited, materials);
+    model::cell_majorant[it->second] = model::majorants.size();
+    try {
+      model::majorants.emplace_back(
+        vector<int32_t>(materials.begin(), materials.end()));
+    } catch (const std::exception& e) {
+      fatal_error(e.what());
+    }
+  }
+
+  write_message(6, "Built majorant cross sections for {} delta-tracking "
+                   "region(s)",
+    model::majorants.size());
+}
+
+int delta_tracking_level(const Particle& p)
+{
+  if (model::cell_majorant.empty() || p.type() != ParticleType::neutron)
+    return C_NONE;
+
+  for (int j = 0; j < p.n_coord(); ++j) {
+    if (model::cell_majorant[p.coord(j).cell] != C_NONE)
+      return j;
+  }
+  return C_NONE;
+}
+
+void majorant_exceeded(double E, double total, double majorant)
+{
+  if (!exceeded_reported.exchange(true)) {
+    warning(fmt::format("Total cross section of {} /cm at {} eV exceeds the "
+                        "delta-tracking majorant of {} /cm. Collisions where "
+                        "this happens are biased.",
+      total, E, majorant));
+  }
+}
+
+void free_memory_delta_tracking()
+{
+  model::majorants.clear();
+  model::cell_majorant.clear();
+}
+
+//==============================================================================
+// C API
+//==============================================================================
+
+extern "C" int openmc_majorant_create(
+  int n, const int32_t* materials, int32_t* index)
+{
+  // The majorant is built on the logarithmic grid set up at initialization
+  if (!simulation::initialized || !settings::run_CE) {
+    set_errmsg("Majorant cross sections can only be built once a "
+               "continuous-energy simulation has been initialized.");
+    return OPENMC_E_ALLOCATE;
+  }
+
+  for (int i = 0; i < n; ++i) {
+    if (materials[i] < 0 || materials[i] >= model::materials.size()) {
+      set_errmsg("Index in materials array is out of bounds.");
+      return OPENMC_E_OUT_OF_BOUNDS;
+    }
+  }
+
+  try {
+    model::majorants.emplace_back(vector<int32_t>(materials, materials + n));
+  } catch (const std::exception& e) {
+    set_errmsg(e.what());
+    return OPENMC_E_DATA;
+  }
+  *index = model::majorants.size() - 1;
+  return 0;
+}
+
+extern "C" int openmc_majorant_evaluate(int32_t index, double E, double* xs)
+{
+  if (index < 0 || index >= model::majorants.size()) {
+    set_errmsg("Index in majorants array is out of bounds.");
+    return OPENMC_E_OUT_OF_BOUNDS;
+  }
+  *xs = model::majorants[index](E);
+  return 0;
+}
+
+extern "C" int openmc_majorant_get_xs(int32_t index, const double** xs,
+  int* n, double* energy_min, double* energy_max)
+{
+  if (index < 0 || index >= model::majorants.size()) {
+    set_errmsg("Index in majorants array is out of bounds.");
+    return OPENMC_E_OUT_OF_BOUNDS;
+  }
+  const auto& values = model::majorants[index].xs();
+  int neutron = static_cast<int>(ParticleType::neutron);
+  *xs = values.data();
+  *n = values.size();
+  *energy_min = data::energy_min[neutron];
+  *energy_max = data::energy_max[neutron];
+  return 0;
+}
+
+} // namespace openmc
@@ -8,6 +8,7 @@
 #include <stdexcept> // for runtime_error
 #include <string>    // for string, stod
 
+#include <fmt/core.h>
 #include <gsl/gsl-lite.hpp>
 
 #include "openmc/error.h"
@@ -113,6 +114,25 @@ void DiscreteIndex::normalize()
   }
 }
 
+vector<double> bias_weights(
+  gsl::span<const double> p, gsl::span<const double> bias)
+{
+  double p_sum = std::accumulate(p.begin(), p.end(), 0.0);
+  double bias_sum = std::accumulate(bias.begin(), bias.end(), 0.0);
+
+  vector<double> wgt(p.size(), 0.0);
+  for (size_t i = 0; i < p.size(); ++i) {
+    if (bias[i] > 0.0) {
+      wgt[i] = (p[i] / p_sum) / (bias[i] / bias_sum);
+    } else if (p[i] > 0.0) {
+      // Outcomes that are never sampled would bias the estimates
+      fatal_error("Biased probabilities must be nonzero wherever the "
+                  "unbiased probabilities are nonzero.");
+    }
+  }
+  return wgt;
+}
+
 //==============================================================================
 // Discrete implementation
 //==============================================================================
@@ -124,6 +144,23 @@ Discrete::Discrete(pugi::xml_node node) : di_(node)
   std::size_t n = params.size() / 2;
 
   x_.assign(params.begin(), params.begin() + n);
+
+  read_bias(node, {params.data() + n, n});
+}
+
+void Discrete::read_bias(pugi::xml_node node, gsl::span<const double> p)
+{
+  if (!check_for_node(node, "bias"))
+    return;
+
+  auto bias = get_node_array<double>(node, "bias");
+  if (bias.size() != p.size()) {
+    fatal_error(fmt::format("Number of biased probabilities ({}) does not "
+                            "match the number of discrete values ({}).",
+      bias.size(), p.size()));
+  }
+  bias_.assign(bias);
+  bias_wgt_ = bias_weights(p, bias);
 }
 
 Discrete::Discrete(const double* x, const double* p, size_t n) : di_({p, n})
@@ -137,6 +174,15 @@ double Discrete::sample(uint64_t* seed) const
   return x_[di_.sample(seed)];
 }
 
+std::pair<double, double> Discrete::sample_biased(uint64_t* seed) const
+{
+  if (!this->biased())
+    return {this->sample(seed), 1.0};
+
+  size_t i = bias_.sample(seed);
+  return {x_[i], bias_wgt_[i]};
+}
+
 //==============================================================================
 // Uniform implementation
 //==============================================================================
@@ -242,6 +288,10 @@ double Normal::sample(uint64_t* seed) const
 // Tabular implementation
 //==============================================================================
 
+//! Number of bins above which a tabular distribution is searched with a guide
+//! table having one cell per bin
+constexpr int TABULAR_GUIDE_MIN_BINS {16};
+
 Tabular::Tabular(pugi::xml_node node)
 {
   if (check_for_node(node, "interpolation")) {
@@ -310,6 +360,12 @@ void Tabular::init(
     p_[i] = p_[i] / integral_;
     c_[i] = c_[i] / integral_;
   }
+
+  // Long tables, such as measured source spectra, are searched starting from
+  // the bin given by a guide table so that sampling takes constant time
+  if (n - 1 > TABULAR_GUIDE_MIN_BINS) {
+    guide_ = GuideTable(c_, n - 1);
+  }
 }
 
 double Tabular::sample(uint64_t* seed) const
@@ -317,15 +373,22 @@ double Tabular::sample(uint64_t* seed) const
   // Sample value of CDF
   double c = prn(seed);
 
-  // Find first CDF bin which is above the sampled value
-  double c_i = c_[0];
-  int i;
-  std::size_t n = c_.size();
-  for (i = 0; i < n - 1; ++i) {
+  // Find first CDF bin which is above the sampled value. The guide table
+  // gives a bin at or before it, except when c equals the lower edge of its
+  // cell and that edge is a tabulated value, so it steps back for that case.
+  int i = 0;
+  int n = c_.size();
+  if (!guide_.empty()) {
+    i = guide_.start(c);
+    while (i > 0 && c <= c_[i]) {
+      --i;
+    }
+  }
+  for (; i < n - 1; ++i) {
     if (c <= c_[i + 1])
       break;
-    c_i = c_[i + 1];
   }
+  double c_i = c_[i];
 
   // Determine bounding PDF values
   double x_i = x_[i];
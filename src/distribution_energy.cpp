@@ -12,6 +12,7 @@
 #include "openmc/random_dist.h"
 #include "openmc/random_lcg.h"
 #include "openmc/search.h"
+#include "openmc/settings.h"
 
 namespace openmc {
 
@@ -143,6 +144,10 @@ ContinuousTabular::ContinuousTabular(hid_t group)
       d.c /= d.c[n - 1];
     }
 
+    if (settings::guide_table_cells > 0) {
+      d.guide = GuideTable(d.c, settings::guide_table_cells);
+    }
+
     distribution_.push_back(std::move(d));
   } // incoming energies
 }
@@ -199,9 +204,19 @@ double ContinuousTabular::sample(double E, uint64_t* seed) const
     }
   }
 
-  // Continuous portion
+  // Continuous portion. A guide table gives a bin at which to start the
+  // search that is not past the bin containing the random number.
+  int j_start = n_discrete;
+  if (end > n_discrete && !distribution_[l].guide.empty()) {
+    int j_guide = distribution_[l].guide.start(r1);
+    if (j_guide > n_discrete) {
+      j_start = std::min(j_guide, end);
+      k = j_start;
+      c_k = distribution_[l].c[k];
+    }
+  }
   double c_k1;
-  for (int j = n_discrete; j < end; ++j) {
+  for (int j = j_start; j < end; ++j) {
     k = j;
     c_k1 = distribution_[l].c[k + 1];
     if (r1 < c_k1)
@@ -258,6 +258,23 @@ MeshSpatial::MeshSpatial(pugi::xml_node node)
   }
 
   elem_idx_dist_.assign(strengths);
+
+  // Biased strengths are normalized by volume in the same way
+  if (check_for_node(node, "bias")) {
+    auto bias = get_node_array<double>(node, "bias");
+    if (bias.size() != n_bins) {
+      fatal_error(
+        fmt::format("Number of entries in the biased strengths array {} does "
+                    "not match the number of entities in mesh {} ({}).",
+          bias.size(), mesh_id, n_bins));
+    }
+    if (get_node_value_bool(node, "volume_normalized")) {
+      for (int i = 0; i < n_bins; i++) {
+        bias[i] *= this->mesh()->volume(i);
+      }
+    }
+    this->set_bias(strengths, bias);
+  }
 }
 
 MeshSpatial::MeshSpatial(int32_t mesh_idx, gsl::span<const double> strengths)
@@ -281,11 +298,28 @@ void MeshSpatial::check_element_types() const
   }
 }
 
+void MeshSpatial::set_bias(
+  gsl::span<const double> strengths, gsl::span<const double> bias)
+{
+  bias_.assign(bias);
+  bias_wgt_ = bias_weights(strengths, bias);
+}
+
 int32_t MeshSpatial::sample_element_index(uint64_t* seed) const
 {
   return elem_idx_dist_.sample(seed);
 }
 
+std::pair<int32_t, double> MeshSpatial::sample_element_biased(
+  uint64_t* seed) const
+{
+  if (!this->biased())
+    return {this->sample_element_index(seed), 1.0};
+
+  int32_t elem_idx = bias_.sample(seed);
+  return {elem_idx, bias_wgt_[elem_idx]};
+}
+
 std::pair<int32_t, Position> MeshSpatial::sample_mesh(uint64_t* seed) const
 {
   // Sample the CDF defined in initialization above
@@ -298,6 +332,12 @@ Position MeshSpatial::sample(uint64_t* seed) const
   return this->sample_mesh(seed).second;
 }
 
+std::pair<Position, double> MeshSpatial::sample_biased(uint64_t* seed) const
+{
+  auto [elem_idx, wgt] = this->sample_element_biased(seed);
+  return {mesh()->sample_element(elem_idx, seed), wgt};
+}
+
 //==============================================================================
 // SpatialBox implementation
 //==============================================================================
@@ -21,11 +21,13 @@
 #include "openmc/tallies/tally.h"
 #include "openmc/timer.h"
 
-#include <algorithm> // for min
+#include <algorithm> // for clamp, min, max, sort
 #include <cmath>     // for sqrt, abs, pow
 #include <iterator>  // for back_inserter
 #include <limits>    //for infinity
 #include <string>
+#include <tuple>   // for tie
+#include <utility> // for pair
 
 namespace openmc {
 
@@ -39,9 +41,43 @@ double keff_generation;
 array<double, 2> k_sum;
 vector<double> entropy;
 xt::xtensor<double, 1> source_frac;
+vector<double> fission_matrix;
+vector<double> fission_matrix_source;
+vector<double> fission_matrix_vector;
 
 } // namespace simulation
 
+#ifdef OPENMC_MPI
+namespace {
+
+//! An exchange of source sites between processes that has been started but not
+//! completed
+struct PendingBankExchange {
+  bool in_progress {false};
+  bool local_returned {false}; //!< Local sites were handed out for transport
+  int64_t local_begin {0};     //!< Start of the sites sampled on this process
+  int64_t local_end {0};       //!< End of the sites sampled on this process
+  vector<SourceSite> send_before; //!< Sites for processes before this one
+  vector<SourceSite> send_after;  //!< Sites for processes after this one
+  vector<MPI_Request> sends;      //!< Requests for each message sent
+  vector<MPI_Request> receives;   //!< Requests for each message received
+  vector<std::pair<int64_t, int64_t>> ranges; //!< Sites of each message
+};
+
+PendingBankExchange pending_exchange;
+
+//! Set the fields of received sites that are not communicated
+void set_received(int64_t first, int64_t last)
+{
+  for (int64_t i = first; i < last; ++i) {
+    simulation::source_bank[i].particle = ParticleType::neutron;
+    simulation::source_bank[i].surf_id = 0;
+  }
+}
+
+} // namespace
+#endif
+
 //==============================================================================
 // Non-member functions
 //==============================================================================
@@ -55,12 +91,18 @@ void calculate_generation_keff()
     gt(GlobalTally::K_TRACKLENGTH, TallyResult::VALUE) -
     simulation::keff_generation;
 
+  // Neutrons transported in the generation they were born in with a Wielandt
+  // shift are part of the source of this generation
+  double source_weight = simulation::wielandt_weight;
+
   double keff_reduced;
 #ifdef OPENMC_MPI
   if (settings::solver_type != SolverType::RANDOM_RAY) {
     // Combine values across all processors
-    MPI_Allreduce(&simulation::keff_generation, &keff_reduced, 1, MPI_DOUBLE,
-      MPI_SUM, mpi::intracomm);
+    keff_reduced = simulation::keff_generation;
+    mpi::allreduce_sum(&keff_reduced, 1);
+    if (settings::wielandt_shift > 0.0)
+      mpi::allreduce_sum(&source_weight, 1);
   } else {
     // If using random ray, MPI parallelism is provided by domain replication.
     // As such, all fluxes will be reduced at the end of each transport sweep,
@@ -76,7 +118,7 @@ void calculate_generation_keff()
   // Normalize single batch estimate of k
   // TODO: This should be normalized by total_weight, not by n_particles
   if (settings::solver_type != SolverType::RANDOM_RAY) {
-    keff_reduced /= settings::n_particles;
+    keff_reduced /= settings::n_particles + source_weight;
   }
 
   simulation::k_generation.push_back(keff_reduced);
@@ -148,78 +190,87 @@ void synchronize_bank()
   simulation::time_bank_sample.start();
 
   // ==========================================================================
-  // SAMPLE N_PARTICLES FROM FISSION BANK AND PLACE IN TEMP_SITES
+  // COUNT SOURCE SITES SAMPLED FROM THE FISSION BANK
 
-  // Allocate temporary source bank -- we don't really know how many fission
-  // sites were created, so overallocate by a factor of 3
-  int64_t index_temp = 0;
-  vector<SourceSite> temp_sites(3 * simulation::work_per_rank);
+  // If there are less than n_particles particles banked, automatically add
+  // int(n_particles/total) copies of each site. For example, if you need 1000
+  // and 300 were banked, this would add 3 source sites per banked site and the
+  // remaining 100 would be randomly sampled.
+  int64_t n_copies =
+    total < settings::n_particles ? settings::n_particles / total : 0;
 
+#ifdef OPENMC_MPI
+  // The position of the sampled sites in the 'global' source bank is only
+  // known once every processor has counted its sites, so the random numbers
+  // are drawn twice from the same seed: once here to count the sites and once
+  // below to place them. This avoids storing the sampled sites in a temporary
+  // bank before they can be placed.
+  int64_t n_sampled = 0;
+  uint64_t seed_count = seed;
   for (int64_t i = 0; i < simulation::fission_bank.size(); i++) {
-    const auto& site = simulation::fission_bank[i];
-
-    // If there are less than n_particles particles banked, automatically add
-    // int(n_particles/total) sites to temp_sites. For example, if you need
-    // 1000 and 300 were banked, this would add 3 source sites per banked site
-    // and the remaining 100 would be randomly sampled.
-    if (total < settings::n_particles) {
-      for (int64_t j = 1; j <= settings::n_particles / total; ++j) {
-        temp_sites[index_temp] = site;
-        ++index_temp;
-      }
-    }
-
-    // Randomly sample sites needed
-    if (prn(&seed) < p_sample) {
-      temp_sites[index_temp] = site;
-      ++index_temp;
-    }
+    n_sampled += n_copies + (prn(&seed_count) < p_sample);
   }
 
-  // At this point, the sampling of source sites is done and now we need to
-  // figure out where to send source sites. Since it is possible that one
-  // processor's share of the source bank spans more than just the immediate
-  // neighboring processors, we have to perform an ALLGATHER to determine the
-  // indices for all processors
-
-#ifdef OPENMC_MPI
-  // First do an exclusive scan to get the starting indices for
   start = 0;
-  MPI_Exscan(&index_temp, &start, 1, MPI_INT64_T, MPI_SUM, mpi::intracomm);
-  finish = start + index_temp;
-
-  // Allocate space for bank_position if this hasn't been done yet
-  int64_t bank_position[mpi::n_procs];
-  MPI_Allgather(
-    &start, 1, MPI_INT64_T, bank_position, 1, MPI_INT64_T, mpi::intracomm);
+  MPI_Exscan(&n_sampled, &start, 1, MPI_INT64_T, MPI_SUM, mpi::intracomm);
+  if (mpi::rank == 0)
+    start = 0;
 #else
   start = 0;
-  finish = index_temp;
 #endif
 
+  // ==========================================================================
+  // PLACE SOURCE SITES IN THE SOURCE BANK
+
+  // Sites whose position in the global source bank falls within this
+  // processor's share are stored directly. The others are buffered to be sent
+  // to the processors before and after this one, and sites past the end of the
+  // global source bank are discarded.
+  int64_t work_start = simulation::work_index[mpi::rank];
+  int64_t work_end = simulation::work_index[mpi::rank + 1];
+#ifdef OPENMC_MPI
+  // The buffers of the previous exchange are reused once it has completed
+  finish_bank_synchronization();
+  auto& ex = pending_exchange;
+  auto& send_before = ex.send_before;
+  auto& send_after = ex.send_after;
+  send_before.clear();
+  send_after.clear();
+#else
+  vector<SourceSite> send_before;
+  vector<SourceSite> send_after;
+#endif
+  int64_t position = start;
+  auto place = [&](const SourceSite& site) {
+    if (position < work_start) {
+      send_before.push_back(site);
+    } else if (position < work_end) {
+      simulation::source_bank[position - work_start] = site;
+    } else if (position < settings::n_particles) {
+      send_after.push_back(site);
+    }
+    ++position;
+  };
+
+  for (int64_t i = 0; i < simulation::fission_bank.size(); i++) {
+    const auto& site = simulation::fission_bank[i];
+    int64_t n = n_copies + (prn(&seed) < p_sample);
+    for (int64_t j = 0; j < n; ++j) {
+      place(site);
+    }
+  }
+
   // Now that the sampling is complete, we need to ensure that we have exactly
   // n_particles source sites. The way this is done in a reproducible manner is
-  // to adjust only the source sites on the last processor.
-
+  // to adjust only the source sites on the last processor. Extra sites have
+  // already been discarded; if there are too few, repeat sites from the very
+  // end of the fission bank.
   if (mpi::rank == mpi::n_procs - 1) {
-    if (finish > settings::n_particles) {
-      // If we have extra sites sampled, we will simply discard the extra
-      // ones on the last processor
-      index_temp = settings::n_particles - start;
-
-    } else if (finish < settings::n_particles) {
-      // If we have too few sites, repeat sites from the very end of the
-      // fission bank
-      sites_needed = settings::n_particles - finish;
-      for (int i = 0; i < sites_needed; ++i) {
-        int i_bank = simulation::fission_bank.size() - sites_needed + i;
-        temp_sites[index_temp] = simulation::fission_bank[i_bank];
-        ++index_temp;
-      }
+    int64_t n_missing = settings::n_particles - position;
+    for (int64_t i = 0; i < n_missing; ++i) {
+      int64_t i_bank = simulation::fission_bank.size() - n_missing + i;
+      place(simulation::fission_bank[i_bank]);
     }
-
-    // the last processor should not be sending sites to right
-    finish = simulation::work_index[mpi::rank + 1];
   }
 
   simulation::time_bank_sample.stop();
@@ -227,109 +278,151 @@ void synchronize_bank()
 
 #ifdef OPENMC_MPI
   // ==========================================================================
-  // SEND BANK SITES TO NEIGHBORS
-
-  int64_t index_local = 0;
-  vector<MPI_Request> requests;
-
-  if (start < settings::n_particles) {
-    // Determine the index of the processor which has the first part of the
-    // source_bank for the local processor
+  // SEND BANK SITES TO OTHER PROCESSORS
+
+  // The buffered sites occupy consecutive positions in the global source bank,
+  // so the processors they belong to follow from the work indices alone
+  constexpr int tag {0};
+  auto& requests = ex.sends;
+  requests.clear();
+  auto send = [&](const vector<SourceSite>& sites, int64_t first) {
     int neighbor = upper_bound_index(
-      simulation::work_index.begin(), simulation::work_index.end(), start);
-
-    while (start < finish) {
-      // Determine the number of sites to send
-      int64_t n =
-        std::min(simulation::work_index[neighbor + 1], finish) - start;
-
-      // Initiate an asynchronous send of source sites to the neighboring
-      // process
-      if (neighbor != mpi::rank) {
+      simulation::work_index.begin(), simulation::work_index.end(), first);
+    int64_t n_sites = sites.size();
+    for (int64_t i = 0; i < n_sites; ++neighbor) {
+      int64_t n_neighbor = simulation::work_index[neighbor + 1] - (first + i);
+      int64_t n = std::min(n_neighbor, n_sites - i);
+      if (n > 0) {
         requests.emplace_back();
-        MPI_Isend(&temp_sites[index_local], static_cast<int>(n),
-          mpi::source_site, neighbor, mpi::rank, mpi::intracomm,
-          &requests.back());
+        MPI_Isend(&sites[i], static_cast<int>(n), mpi::fission_site, neighbor,
+          tag, mpi::intracomm, &requests.back());
       }
-
-      // Increment all indices
-      start += n;
-      index_local += n;
-      ++neighbor;
-
-      // Check for sites out of bounds -- this only happens in the rare
-      // circumstance that a processor close to the end has so many sites that
-      // it would exceed the bank on the last processor
-      if (neighbor > mpi::n_procs - 1)
-        break;
+      i += n;
     }
-  }
+  };
+  send(send_before, start);
+  send(send_after, std::max(start, work_end));
 
   // ==========================================================================
-  // RECEIVE BANK SITES FROM NEIGHBORS OR TEMPORARY BANK
-
-  start = simulation::work_index[mpi::rank];
-  index_local = 0;
-
-  // Determine what process has the source sites that will need to be stored at
-  // the beginning of this processor's source bank.
-
-  int neighbor;
-  if (start >= bank_position[mpi::n_procs - 1]) {
-    neighbor = mpi::n_procs - 1;
-  } else {
-    neighbor =
-      upper_bound_index(bank_position, bank_position + mpi::n_procs, start);
+  // RECEIVE BANK SITES FROM OTHER PROCESSORS
+
+  // The rest of this processor's share was sampled by processors before it,
+  // filling the positions ahead of its own sites, and by processors after it,
+  // filling the positions behind them. Rather than gathering the number of
+  // sites sampled by every processor, messages are matched until all sites
+  // have arrived and are then placed in order of the processor sending them.
+  ex.local_begin = std::clamp(start, work_start, work_end) - work_start;
+  ex.local_end = std::clamp(position, work_start, work_end) - work_start;
+  int64_t n_local = ex.local_end - ex.local_begin;
+  int64_t n_needed = simulation::work_per_rank - n_local;
+
+  struct Incoming {
+    int source;
+    int count;
+    MPI_Message message;
+  };
+  vector<Incoming> incoming;
+  for (int64_t n_received = 0; n_received < n_needed;) {
+    MPI_Status status;
+    Incoming msg;
+    MPI_Mprobe(MPI_ANY_SOURCE, tag, mpi::intracomm, &msg.message, &status);
+    MPI_Get_count(&status, mpi::fission_site, &msg.count);
+    msg.source = status.MPI_SOURCE;
+    n_received += msg.count;
+    incoming.push_back(msg);
   }
-
-  while (start < simulation::work_index[mpi::rank + 1]) {
-    // Determine how many sites need to be received
-    int64_t n;
-    if (neighbor == mpi::n_procs - 1) {
-      n = simulation::work_index[mpi::rank + 1] - start;
-    } else {
-      n = std::min(bank_position[neighbor + 1],
-            simulation::work_index[mpi::rank + 1]) -
-          start;
-    }
-
-    if (neighbor != mpi::rank) {
-      // If the source sites are not on this processor, initiate an
-      // asynchronous receive for the source sites
-
-      requests.emplace_back();
-      MPI_Irecv(&simulation::source_bank[index_local], static_cast<int>(n),
-        mpi::source_site, neighbor, neighbor, mpi::intracomm, &requests.back());
-
-    } else {
-      // If the source sites are on this procesor, we can simply copy them
-      // from the temp_sites bank
-
-      index_temp = start - bank_position[mpi::rank];
-      std::copy(&temp_sites[index_temp], &temp_sites[index_temp + n],
-        &simulation::source_bank[index_local]);
-    }
-
-    // Increment all indices
-    start += n;
-    index_local += n;
-    ++neighbor;
+  std::sort(incoming.begin(), incoming.end(),
+    [](const Incoming& a, const Incoming& b) { return a.source < b.source; });
+
+  int64_t index_before = 0;
+  int64_t index_after = ex.local_end;
+  ex.receives.clear();
+  ex.ranges.clear();
+  for (auto& msg : incoming) {
+    int64_t& index = msg.source < mpi::rank ? index_before : index_after;
+    ex.receives.emplace_back();
+    MPI_Imrecv(&simulation::source_bank[index], msg.count, mpi::fission_site,
+      &msg.message, &ex.receives.back());
+    ex.ranges.emplace_back(index, index + msg.count);
+    index += msg.count;
   }
+  ex.in_progress = true;
+  ex.local_returned = false;
 
   // Since we initiated a series of asynchronous ISENDs and IRECVs, now we have
   // to ensure that the data has actually been communicated before moving on to
-  // the next generation
+  // the next generation. When overlapping the exchange with transport, the
+  // sites sampled on this process are transported first and the others as
+  // they arrive. This is not done when UFS needs every source site before
+  // transport starts or with event-based transport.
+  if (!settings::overlap_bank_sync || settings::ufs_on ||
+      settings::event_based) {
+    finish_bank_synchronization();
+  }
+#endif
+
+  simulation::time_bank_sendrecv.stop();
+  simulation::time_bank.stop();
+}
+
+void finish_bank_synchronization()
+{
+#ifdef OPENMC_MPI
+  auto& ex = pending_exchange;
+  if (!ex.in_progress)
+    return;
 
-  int n_request = requests.size();
-  MPI_Waitall(n_request, requests.data(), MPI_STATUSES_IGNORE);
+  MPI_Waitall(ex.receives.size(), ex.receives.data(), MPI_STATUSES_IGNORE);
+  for (const auto& range : ex.ranges) {
+    set_received(range.first, range.second);
+  }
+  MPI_Waitall(ex.sends.size(), ex.sends.data(), MPI_STATUSES_IGNORE);
+  ex.in_progress = false;
+#endif
+}
 
+bool source_sites_pending()
+{
+#ifdef OPENMC_MPI
+  return pending_exchange.in_progress;
 #else
-  std::copy(temp_sites.data(), temp_sites.data() + settings::n_particles,
-    simulation::source_bank.begin());
+  return false;
 #endif
+}
 
+bool receive_source_sites(int64_t& first, int64_t& last)
+{
+#ifdef OPENMC_MPI
+  auto& ex = pending_exchange;
+  if (!ex.in_progress)
+    return false;
+
+  // Sites sampled on this process are available immediately
+  if (!ex.local_returned) {
+    ex.local_returned = true;
+    first = ex.local_begin;
+    last = ex.local_end;
+    return true;
+  }
+
+  // Wait for the next message from another process
+  simulation::time_bank_sendrecv.start();
+  int index;
+  MPI_Waitany(
+    ex.receives.size(), ex.receives.data(), &index, MPI_STATUS_IGNORE);
+  if (index == MPI_UNDEFINED) {
+    MPI_Waitall(ex.sends.size(), ex.sends.data(), MPI_STATUSES_IGNORE);
+    ex.in_progress = false;
+    simulation::time_bank_sendrecv.stop();
+    return false;
+  }
+  std::tie(first, last) = ex.ranges[index];
+  set_received(first, last);
   simulation::time_bank_sendrecv.stop();
-  simulation::time_bank.stop();
+  return true;
+#else
+  return false;
+#endif
 }
 
 void calculate_average_keff()
@@ -552,12 +645,16 @@ void shannon_entropy()
     // Normalize to total weight of bank sites
     p /= xt::sum(p);
 
-    // Sum values to obtain Shannon entropy
+    // Evaluate the contribution of each bin in parallel and sum them in order
+    // to obtain Shannon entropy
+    int64_t n_bins = p.size();
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < n_bins; ++i) {
+      p(i) = p(i) > 0.0 ? -p(i) * std::log2(p(i)) : 0.0;
+    }
     double H = 0.0;
-    for (auto p_i : p) {
-      if (p_i > 0.0) {
-        H -= p_i * std::log2(p_i);
-      }
+    for (auto h_i : p) {
+      H += h_i;
     }
 
     // Add value to vector
@@ -624,6 +721,174 @@ double ufs_get_weight(const Particle& p)
   }
 }
 
+void fission_matrix_tally()
+{
+  const auto* m = simulation::fission_matrix_mesh;
+  int n = m->n_bins();
+  auto& matrix = simulation::fission_matrix;
+  auto& source = simulation::fission_matrix_source;
+  if (matrix.empty()) {
+    matrix.assign(static_cast<int64_t>(n) * n, 0.0);
+    source.assign(n, 0.0);
+  }
+
+  // Determine the mesh bins of the source and fission sites in parallel. The
+  // weights are then added in order so that the matrix is independent of the
+  // number of threads.
+  int64_t n_source = simulation::work_per_rank;
+  int64_t n_fission = simulation::fission_bank.size();
+  vector<int> source_bins(n_source);
+  vector<int> fission_bins(n_fission);
+#pragma omp parallel for schedule(static)
+  for (int64_t i = 0; i < n_source; ++i) {
+    source_bins[i] = m->get_bin(simulation::source_bank[i].r);
+  }
+#pragma omp parallel for schedule(static)
+  for (int64_t i = 0; i < n_fission; ++i) {
+    fission_bins[i] = m->get_bin(simulation::fission_bank[i].r);
+  }
+
+  for (int64_t i = 0; i < n_source; ++i) {
+    if (source_bins[i] >= 0)
+      source[source_bins[i]] += simulation::source_bank[i].wgt;
+  }
+
+  // The source site of each fission site is found from its parent ID
+  int64_t offset = simulation::work_index[mpi::rank] + 1;
+  for (int64_t i = 0; i < n_fission; ++i) {
+    const auto& site = simulation::fission_bank[i];
+    int i_source = source_bins[site.parent_id - offset];
+    if (i_source >= 0 && fission_bins[i] >= 0) {
+      matrix[static_cast<int64_t>(fission_bins[i]) * n + i_source] += site.wgt;
+    }
+  }
+}
+
+void fission_matrix_reweight()
+{
+  // Maximum number of power iterations and convergence criterion on the
+  // largest change in any element of the eigenvector
+  constexpr int MAX_ITERATIONS {10000};
+  constexpr double TOLERANCE {1e-8};
+
+  // All source sites are needed to determine their distribution
+  finish_bank_synchronization();
+
+  const auto* m = simulation::fission_matrix_mesh;
+  int n = m->n_bins();
+  int64_t n_elements = static_cast<int64_t>(n) * n;
+
+  // Combine the fission matrix of all processors
+  vector<double> matrix(n_elements);
+  vector<double> source(n);
+#ifdef OPENMC_MPI
+  MPI_Allreduce(simulation::fission_matrix.data(), matrix.data(),
+    static_cast<int>(n_elements), MPI_DOUBLE, MPI_SUM, mpi::intracomm);
+  MPI_Allreduce(simulation::fission_matrix_source.data(), source.data(), n,
+    MPI_DOUBLE, MPI_SUM, mpi::intracomm);
+#else
+  matrix = simulation::fission_matrix;
+  source = simulation::fission_matrix_source;
+#endif
+
+  // Normalize each column to the weight of fission sites produced per unit
+  // weight of source sites in its bin
+#pragma omp parallel for schedule(static)
+  for (int j = 0; j < n; ++j) {
+    for (int i = 0; i < n; ++i) {
+      if (source[i] > 0.0)
+        matrix[static_cast<int64_t>(j) * n + i] /= source[i];
+    }
+  }
+
+  // Weight of the source sites in each bin
+  int64_t n_source = simulation::work_per_rank;
+  vector<int> bins(n_source);
+#pragma omp parallel for schedule(static)
+  for (int64_t i = 0; i < n_source; ++i) {
+    bins[i] = m->get_bin(simulation::source_bank[i].r);
+  }
+  vector<double> weight(n, 0.0);
+  for (int64_t i = 0; i < n_source; ++i) {
+    if (bins[i] >= 0)
+      weight[bins[i]] += simulation::source_bank[i].wgt;
+  }
+#ifdef OPENMC_MPI
+  MPI_Allreduce(
+    MPI_IN_PLACE, weight.data(), n, MPI_DOUBLE, MPI_SUM, mpi::intracomm);
+#endif
+  double total = 0.0;
+  for (auto w : weight) {
+    total += w;
+  }
+  if (total <= 0.0)
+    return;
+
+  // Find the dominant eigenvector by power iteration, starting from the
+  // solution of the previous generation or else from the current source
+  auto& v = simulation::fission_matrix_vector;
+  if (static_cast<int>(v.size()) != n) {
+    v = weight;
+    for (auto& v_i : v) {
+      v_i /= total;
+    }
+  }
+  vector<double> v_next(n);
+  for (int iter = 0; iter < MAX_ITERATIONS; ++iter) {
+#pragma omp parallel for schedule(static)
+    for (int j = 0; j < n; ++j) {
+      double sum = 0.0;
+      for (int i = 0; i < n; ++i) {
+        sum += matrix[static_cast<int64_t>(j) * n + i] * v[i];
+      }
+      v_next[j] = sum;
+    }
+
+    double k = 0.0;
+    for (auto v_j : v_next) {
+      k += v_j;
+    }
+    if (k <= 0.0)
+      return;
+
+    double change = 0.0;
+    for (int j = 0; j < n; ++j) {
+      v_next[j] /= k;
+      change = std::max(change, std::abs(v_next[j] - v[j]));
+    }
+    std::swap(v, v_next);
+    if (change < TOLERANCE)
+      break;
+  }
+
+  // Scale the weight of source sites in each bin so that the source follows
+  // the eigenvector. Bins without source sites cannot be represented, so the
+  // factors are renormalized to preserve the total weight of the source.
+  vector<double> factor(n, 1.0);
+  double v_represented = 0.0;
+  double w_unchanged = 0.0;
+  for (int j = 0; j < n; ++j) {
+    if (weight[j] > 0.0 && v[j] > 0.0) {
+      v_represented += v[j];
+    } else {
+      w_unchanged += weight[j];
+    }
+  }
+  if (v_represented <= 0.0)
+    return;
+  double norm = (total - w_unchanged) / v_represented;
+  for (int j = 0; j < n; ++j) {
+    if (weight[j] > 0.0 && v[j] > 0.0)
+      factor[j] = v[j] * norm / weight[j];
+  }
+
+#pragma omp parallel for schedule(static)
+  for (int64_t i = 0; i < n_source; ++i) {
+    if (bins[i] >= 0)
+      simulation::source_bank[i].wgt *= factor[bins[i]];
+  }
+}
+
 void write_eigenvalue_hdf5(hid_t group)
 {
   write_dataset(group, "n_inactive", settings::n_inactive);
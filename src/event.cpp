@@ -1,8 +1,17 @@
 #include "openmc/event.h"
 #include "openmc/material.h"
+#include "openmc/message_passing.h"
+#include "openmc/openmp_interface.h"
+#include "openmc/random_lcg.h"
+#include "openmc/settings.h"
 #include "openmc/simulation.h"
+#include "openmc/tallies/tally.h"
+#include "openmc/thread_stats.h"
 #include "openmc/timer.h"
 
+#include <algorithm> // for sort, stable_sort, inplace_merge, min, max
+#include <numeric>   // for iota
+
 namespace openmc {
 
 //==============================================================================
@@ -11,50 +20,302 @@ namespace openmc {
 
 namespace simulation {
 
-SharedArray<EventQueueItem> calculate_fuel_xs_queue;
-SharedArray<EventQueueItem> calculate_nonfuel_xs_queue;
+vector<SharedArray<EventQueueItem>> calculate_xs_queues;
+vector<int> xs_queue_index;
 SharedArray<EventQueueItem> advance_particle_queue;
 SharedArray<EventQueueItem> surface_crossing_queue;
 SharedArray<EventQueueItem> collision_queue;
 
+SharedArray<SecondaryQueueItem> secondary_queue;
+SharedArray<int64_t> free_slots;
+
 vector<Particle> particles;
 
 } // namespace simulation
 
+namespace {
+
+//! Capacity of the shared secondary queue per slot of the particle buffer.
+//! Secondaries that do not fit stay in the bank of their parent.
+constexpr int64_t SECONDARY_QUEUE_FACTOR {4};
+
+//! Number of random numbers of its parent's streams skipped for each secondary
+//! placed in the shared secondary queue
+constexpr uint64_t SECONDARY_SEED_STRIDE {1 << 24};
+
+//! Move the secondaries of a particle that died to the shared secondary queue,
+//! with one entry for each copy of a split particle
+void share_secondaries(Particle& p)
+{
+  auto& bank = p.secondary_bank();
+  auto& records = p.split_records();
+  uint64_t k = 0;
+  while (!bank.empty()) {
+    int64_t i_site = bank.size() - 1;
+    bool split = !records.empty() && records.back().i_site == i_site;
+    int n_copies = split ? records.back().n_copies : 1;
+
+    for (; n_copies > 0; --n_copies, ++k) {
+      SecondaryQueueItem item;
+      item.site = bank.back();
+      item.site.parent_id = p.id();
+      item.site.progeny_id = k;
+      for (int s = 0; s < N_STREAMS; ++s) {
+        item.seeds[s] =
+          future_seed((k + 1) * SECONDARY_SEED_STRIDE, p.seeds(s));
+      }
+      item.n_split = p.n_split();
+
+      // Once the queue is full, the particle keeps the copies that are left
+      if (simulation::secondary_queue.thread_safe_append(item) < 0) {
+        if (split)
+          records.back().n_copies = n_copies;
+        return;
+      }
+    }
+
+    if (split)
+      records.pop_back();
+    bank.pop_back();
+  }
+}
+
+//! Start a secondary particle from the shared secondary queue in the slot of a
+//! particle that died
+void initialize_secondary(Particle& p, const SecondaryQueueItem& item)
+{
+  // Finish the history of the previous particle in the slot
+  p.event_death();
+
+  p.from_source(&item.site);
+  p.id() = item.site.parent_id;
+  p.current_work() = p.id() - simulation::work_index[mpi::rank];
+  p.n_progeny() = 0;
+  p.n_event() = 0;
+  p.n_split() = item.n_split;
+  p.ww_factor() = 0.0;
+  p.ww_index() = C_NONE;
+  std::copy(item.seeds, item.seeds + N_STREAMS, p.seeds());
+  p.trace() = false;
+  p.write_track() = false;
+  if (settings::run_CE) {
+    p.invalidate_neutron_xs();
+  }
+}
+
+} // namespace
+
 //==============================================================================
 // Non-member functions
 //==============================================================================
 
+int assign_xs_queues()
+{
+  int n_materials = model::materials.size();
+  simulation::xs_queue_index.resize(n_materials);
+
+  // By default, split materials into non-fissionable (queue 0) and
+  // fissionable (queue 1) materials
+  if (settings::event_xs_queue_groups == 0) {
+    for (int i = 0; i < n_materials; ++i) {
+      simulation::xs_queue_index[i] = model::materials[i]->fissionable() ? 1 : 0;
+    }
+    return 2;
+  }
+
+  // Otherwise, order materials by their nuclide lists so that materials with
+  // similar compositions are adjacent (e.g., burnable materials that differ only
+  // in densities) and then split that ordering into contiguous groups
+  vector<int> order(n_materials);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [](int a, int b) {
+    const auto& mat_a = *model::materials[a];
+    const auto& mat_b = *model::materials[b];
+    if (mat_a.fissionable() != mat_b.fissionable())
+      return mat_a.fissionable();
+    return mat_a.nuclide_ < mat_b.nuclide_;
+  });
+
+  int n_queues =
+    std::max(1, std::min(settings::event_xs_queue_groups, n_materials));
+  for (int i = 0; i < n_materials; ++i) {
+    simulation::xs_queue_index[order[i]] =
+      static_cast<int64_t>(i) * n_queues / n_materials;
+  }
+  return n_queues;
+}
+
 void init_event_queues(int64_t n_particles)
 {
-  simulation::calculate_fuel_xs_queue.reserve(n_particles);
-  simulation::calculate_nonfuel_xs_queue.reserve(n_particles);
+  int n_queues = assign_xs_queues();
+  simulation::calculate_xs_queues.resize(n_queues);
+  for (auto& queue : simulation::calculate_xs_queues) {
+    queue.reserve(n_particles);
+  }
   simulation::advance_particle_queue.reserve(n_particles);
   simulation::surface_crossing_queue.reserve(n_particles);
   simulation::collision_queue.reserve(n_particles);
+  if (settings::event_secondary_queue) {
+    simulation::secondary_queue.reserve(SECONDARY_QUEUE_FACTOR * n_particles);
+    simulation::free_slots.reserve(n_particles);
+  }
 
   simulation::particles.resize(n_particles);
+
+#ifdef OPENMC_PARTICLE_SOA
+  // Move frequently accessed particle fields into contiguous arrays so that
+  // each event kernel streams through them
+  simulation::particle_soa.resize(n_particles);
+  for (int64_t i = 0; i < n_particles; i++) {
+    simulation::particles[i].use_soa_slot(i);
+  }
+#endif
 }
 
 void free_event_queues(void)
 {
-  simulation::calculate_fuel_xs_queue.clear();
-  simulation::calculate_nonfuel_xs_queue.clear();
+  simulation::calculate_xs_queues.clear();
+  simulation::xs_queue_index.clear();
   simulation::advance_particle_queue.clear();
   simulation::surface_crossing_queue.clear();
   simulation::collision_queue.clear();
+  simulation::secondary_queue.clear();
+  simulation::free_slots.clear();
 
   simulation::particles.clear();
+
+#ifdef OPENMC_PARTICLE_SOA
+  simulation::particle_soa.clear();
+#endif
 }
 
 void dispatch_xs_event(int64_t buffer_idx)
 {
   Particle& p = simulation::particles[buffer_idx];
-  if (p.material() == MATERIAL_VOID ||
-      !model::materials[p.material()]->fissionable()) {
-    simulation::calculate_nonfuel_xs_queue.thread_safe_append({p, buffer_idx});
-  } else {
-    simulation::calculate_fuel_xs_queue.thread_safe_append({p, buffer_idx});
+  int i_queue = (p.material() == MATERIAL_VOID)
+                  ? 0
+                  : simulation::xs_queue_index[p.material()];
+  simulation::calculate_xs_queues[i_queue].thread_safe_append({p, buffer_idx});
+}
+
+bool secondary_queue_active()
+{
+  return settings::event_secondary_queue &&
+         settings::run_mode == RunMode::FIXED_SOURCE &&
+         model::active_pulse_height_tallies.empty();
+}
+
+void revive_from_secondary(int64_t buffer_idx)
+{
+  Particle& p = simulation::particles[buffer_idx];
+  bool shared = secondary_queue_active();
+
+  // Tracks are written per history, so a particle whose track is written
+  // keeps its secondaries
+  if (shared && !p.alive() && !p.write_track())
+    share_secondaries(p);
+
+  p.event_revive_from_secondary();
+  if (p.alive()) {
+    dispatch_xs_event(buffer_idx);
+  } else if (shared) {
+    simulation::free_slots.thread_safe_append(buffer_idx);
+  }
+}
+
+void sort_queue(SharedArray<EventQueueItem>& queue)
+{
+  simulation::time_event_sort.start();
+
+  // The standard library parallel algorithms require an external threading
+  // backend on most toolchains, so the queue is instead split into one chunk
+  // per thread. Each chunk is sorted independently and neighboring chunks are
+  // then merged pairwise until a single sorted range remains.
+  int64_t n = queue.size();
+  int n_chunks = std::max<int64_t>(1, std::min<int64_t>(num_threads(), n));
+  vector<int64_t> bounds(n_chunks + 1);
+  for (int i = 0; i <= n_chunks; ++i) {
+    bounds[i] = n * i / n_chunks;
+  }
+
+  EventQueueItem* data = queue.data();
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < n_chunks; ++i) {
+    std::sort(data + bounds[i], data + bounds[i + 1]);
+  }
+
+  for (int width = 1; width < n_chunks; width *= 2) {
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n_chunks - width; i += 2 * width) {
+      int64_t mid = bounds[i + width];
+      int64_t hi = bounds[std::min(i + 2 * width, n_chunks)];
+      std::inplace_merge(data + bounds[i], data + mid, data + hi);
+    }
+  }
+
+  simulation::time_event_sort.stop();
+}
+
+void calculate_xs_batched(SharedArray<EventQueueItem>& queue)
+{
+  // Maximum number of particles evaluated together. Long runs of a single
+  // material are split so that the work is spread across threads.
+  constexpr int64_t max_batch {128};
+
+  // Do the per-particle part of the event first since a cell search may
+  // change the particle's material
+  int64_t n = queue.size();
+  vector<char> need_xs(n);
+#pragma omp parallel for schedule(runtime)
+  for (int64_t i = 0; i < n; i++) {
+    Particle& p = simulation::particles[queue[i].idx];
+    need_xs[i] = p.event_calculate_xs_prepare();
+  }
+
+  // Split the queue into batches of neutrons that need a lookup in the same
+  // material. Any other particle forms a batch of its own.
+  auto batchable = [&](int64_t i) {
+    return need_xs[i] && queue[i].type == ParticleType::neutron;
+  };
+  vector<int64_t> batch_start;
+  for (int64_t i = 0; i < n;) {
+    int64_t j = i + 1;
+    if (batchable(i)) {
+      int mat = simulation::particles[queue[i].idx].material();
+      while (j < n && j - i < max_batch && batchable(j) &&
+             simulation::particles[queue[j].idx].material() == mat) {
+        ++j;
+      }
+    }
+    batch_start.push_back(i);
+    i = j;
+  }
+  batch_start.push_back(n);
+  int64_t n_batches = batch_start.size() - 1;
+
+#pragma omp parallel
+  {
+    vector<Particle*> batch;
+
+#pragma omp for schedule(runtime)
+    for (int64_t b = 0; b < n_batches; b++) {
+      int64_t i = batch_start[b];
+      if (!need_xs[i])
+        continue;
+
+      Particle& p = simulation::particles[queue[i].idx];
+      const auto& mat = model::materials[p.material()];
+      if (!batchable(i)) {
+        mat->calculate_xs(p);
+        continue;
+      }
+
+      batch.clear();
+      for (; i < batch_start[b + 1]; ++i) {
+        batch.push_back(&simulation::particles[queue[i].idx]);
+      }
+      mat->calculate_neutron_xs_batch(batch);
+    }
   }
 }
 
@@ -69,31 +330,63 @@ void process_init_events(int64_t n_particles, int64_t source_offset)
   simulation::time_event_init.stop();
 }
 
+void process_secondary_events()
+{
+  simulation::time_event_init.start();
+
+  // The most recently queued secondaries are started first, as they would be
+  // from the bank of their parent
+  auto& queue = simulation::secondary_queue;
+  auto& slots = simulation::free_slots;
+  int64_t n = std::min(queue.size(), slots.size());
+  int64_t first_item = queue.size() - n;
+  int64_t first_slot = slots.size() - n;
+#pragma omp parallel for schedule(runtime)
+  for (int64_t i = 0; i < n; i++) {
+    int64_t buffer_idx = slots[first_slot + i];
+    initialize_secondary(
+      simulation::particles[buffer_idx], queue[first_item + i]);
+    dispatch_xs_event(buffer_idx);
+  }
+  queue.resize(first_item);
+  slots.resize(first_slot);
+
+  simulation::time_event_init.stop();
+}
+
 void process_calculate_xs_events(SharedArray<EventQueueItem>& queue)
 {
   simulation::time_event_calculate_xs.start();
 
-  // TODO: If using C++17, perform a parallel sort of the queue
-  // by particle type, material type, and then energy, in order to
-  // improve cache locality and reduce thread divergence on GPU. Prior
-  // to C++17, std::sort is a serial only operation, which in this case
-  // makes it too slow to be practical for most test problems.
-  //
-  // std::sort(std::execution::par_unseq, queue.data(), queue.data() +
-  // queue.size());
-
   int64_t offset = simulation::advance_particle_queue.size();
-  ;
 
-#pragma omp parallel for schedule(runtime)
-  for (int64_t i = 0; i < queue.size(); i++) {
-    Particle* p = &simulation::particles[queue[i].idx];
-    p->event_calculate_xs();
+  // Sort the queue by particle type, material, and then energy, in order to
+  // improve cache locality of the nuclide data touched by neighboring
+  // particles. Neighboring neutrons in the same material can then be
+  // evaluated together.
+  if (settings::event_queue_sort) {
+    sort_queue(queue);
+    calculate_xs_batched(queue);
 
-    // After executing a calculate_xs event, particles will
-    // always require an advance event. Therefore, we don't need to use
-    // the protected enqueuing function.
-    simulation::advance_particle_queue[offset + i] = queue[i];
+#pragma omp parallel for schedule(runtime)
+    for (int64_t i = 0; i < queue.size(); i++) {
+      simulation::advance_particle_queue[offset + i] = queue[i];
+    }
+  } else {
+#pragma omp parallel
+    {
+      ThreadTimer timer;
+#pragma omp for schedule(runtime) nowait
+      for (int64_t i = 0; i < queue.size(); i++) {
+        Particle* p = &simulation::particles[queue[i].idx];
+        p->event_calculate_xs();
+
+        // After executing a calculate_xs event, particles will
+        // always require an advance event. Therefore, we don't need to use
+        // the protected enqueuing function.
+        simulation::advance_particle_queue[offset + i] = queue[i];
+      }
+    }
   }
 
   simulation::advance_particle_queue.resize(offset + queue.size());
@@ -107,17 +400,24 @@ void process_advance_particle_events()
 {
   simulation::time_event_advance_particle.start();
 
-#pragma omp parallel for schedule(runtime)
-  for (int64_t i = 0; i < simulation::advance_particle_queue.size(); i++) {
-    int64_t buffer_idx = simulation::advance_particle_queue[i].idx;
-    Particle& p = simulation::particles[buffer_idx];
-    p.event_advance();
-    if (!p.alive())
-      continue;
-    if (p.collision_distance() > p.boundary().distance) {
-      simulation::surface_crossing_queue.thread_safe_append({p, buffer_idx});
-    } else {
-      simulation::collision_queue.thread_safe_append({p, buffer_idx});
+#pragma omp parallel
+  {
+    ThreadTimer timer;
+#pragma omp for schedule(runtime) nowait
+    for (int64_t i = 0; i < simulation::advance_particle_queue.size(); i++) {
+      int64_t buffer_idx = simulation::advance_particle_queue[i].idx;
+      Particle& p = simulation::particles[buffer_idx];
+      p.event_advance();
+      if (!p.alive()) {
+        if (secondary_queue_active())
+          simulation::free_slots.thread_safe_append(buffer_idx);
+        continue;
+      }
+      if (p.collision_distance() > p.boundary().distance) {
+        simulation::surface_crossing_queue.thread_safe_append({p, buffer_idx});
+      } else {
+        simulation::collision_queue.thread_safe_append({p, buffer_idx});
+      }
     }
   }
 
@@ -130,14 +430,16 @@ void process_surface_crossing_events()
 {
   simulation::time_event_surface_crossing.start();
 
-#pragma omp parallel for schedule(runtime)
-  for (int64_t i = 0; i < simulation::surface_crossing_queue.size(); i++) {
-    int64_t buffer_idx = simulation::surface_crossing_queue[i].idx;
-    Particle& p = simulation::particles[buffer_idx];
-    p.event_cross_surface();
-    p.event_revive_from_secondary();
-    if (p.alive())
-      dispatch_xs_event(buffer_idx);
+#pragma omp parallel
+  {
+    ThreadTimer timer;
+#pragma omp for schedule(runtime) nowait
+    for (int64_t i = 0; i < simulation::surface_crossing_queue.size(); i++) {
+      int64_t buffer_idx = simulation::surface_crossing_queue[i].idx;
+      Particle& p = simulation::particles[buffer_idx];
+      p.event_cross_surface();
+      revive_from_secondary(buffer_idx);
+    }
   }
 
   simulation::surface_crossing_queue.resize(0);
@@ -149,19 +451,76 @@ void process_collision_events()
 {
   simulation::time_event_collision.start();
 
+#pragma omp parallel
+  {
+    ThreadTimer timer;
+#pragma omp for schedule(runtime) nowait
+    for (int64_t i = 0; i < simulation::collision_queue.size(); i++) {
+      int64_t buffer_idx = simulation::collision_queue[i].idx;
+      Particle& p = simulation::particles[buffer_idx];
+      p.event_collide();
+      revive_from_secondary(buffer_idx);
+    }
+  }
+
+  simulation::collision_queue.resize(0);
+
+  simulation::time_event_collision.stop();
+}
+
+void process_history_based_tail()
+{
+  simulation::time_event_tail.start();
+
+  // Particles waiting on a cross section lookup are at the start of an event
+  // and can be transported as-is
+  for (auto& queue : simulation::calculate_xs_queues) {
+#pragma omp parallel for schedule(runtime)
+    for (int64_t i = 0; i < queue.size(); i++) {
+      transport_history_based_remaining(simulation::particles[queue[i].idx]);
+    }
+    queue.resize(0);
+  }
+
+  // Particles in the other queues must first complete their pending event
+#pragma omp parallel for schedule(runtime)
+  for (int64_t i = 0; i < simulation::advance_particle_queue.size(); i++) {
+    int64_t buffer_idx = simulation::advance_particle_queue[i].idx;
+    Particle& p = simulation::particles[buffer_idx];
+    p.event_advance();
+    if (p.alive()) {
+      if (p.collision_distance() > p.boundary().distance) {
+        p.event_cross_surface();
+      } else {
+        p.event_collide();
+      }
+    }
+    p.event_revive_from_secondary();
+    transport_history_based_remaining(p);
+  }
+  simulation::advance_particle_queue.resize(0);
+
+#pragma omp parallel for schedule(runtime)
+  for (int64_t i = 0; i < simulation::surface_crossing_queue.size(); i++) {
+    int64_t buffer_idx = simulation::surface_crossing_queue[i].idx;
+    Particle& p = simulation::particles[buffer_idx];
+    p.event_cross_surface();
+    p.event_revive_from_secondary();
+    transport_history_based_remaining(p);
+  }
+  simulation::surface_crossing_queue.resize(0);
+
 #pragma omp parallel for schedule(runtime)
   for (int64_t i = 0; i < simulation::collision_queue.size(); i++) {
     int64_t buffer_idx = simulation::collision_queue[i].idx;
     Particle& p = simulation::particles[buffer_idx];
     p.event_collide();
     p.event_revive_from_secondary();
-    if (p.alive())
-      dispatch_xs_event(buffer_idx);
+    transport_history_based_remaining(p);
   }
-
   simulation::collision_queue.resize(0);
 
-  simulation::time_event_collision.stop();
+  simulation::time_event_tail.stop();
 }
 
 void process_death_events(int64_t n_particles)
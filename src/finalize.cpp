@@ -2,25 +2,31 @@
 
 #include "openmc/bank.h"
 #include "openmc/capi.h"
+#include "openmc/census.h"
 #include "openmc/cmfd_solver.h"
 #include "openmc/constants.h"
 #include "openmc/cross_sections.h"
 #include "openmc/dagmc.h"
+#include "openmc/delta_tracking.h"
 #include "openmc/eigenvalue.h"
 #include "openmc/event.h"
 #include "openmc/geometry.h"
 #include "openmc/geometry_aux.h"
 #include "openmc/material.h"
+#include "openmc/memory_report.h"
 #include "openmc/mesh.h"
 #include "openmc/message_passing.h"
 #include "openmc/nuclide.h"
 #include "openmc/photon.h"
 #include "openmc/plot.h"
+#include "openmc/profile.h"
 #include "openmc/random_lcg.h"
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
 #include "openmc/source.h"
+#include "openmc/state_point.h"
 #include "openmc/surface.h"
+#include "openmc/tallies/reaction_rates.h"
 #include "openmc/tallies/tally.h"
 #include "openmc/thermal.h"
 #include "openmc/timer.h"
@@ -47,8 +53,11 @@ void free_memory()
   free_memory_mesh();
   free_memory_tally();
   free_memory_bank();
+  free_memory_census();
   free_memory_plot();
   free_memory_weight_windows();
+  free_memory_delta_tracking();
+  free_memory_profile();
   if (mpi::master) {
     free_memory_cmfd();
   }
@@ -66,6 +75,9 @@ int openmc_finalize()
   if (simulation::initialized)
     openmc_simulation_finalize();
 
+  // Wait for a state point written in the background
+  finish_statepoint_write();
+
   // Clear results
   openmc_reset();
 
@@ -75,21 +87,39 @@ int openmc_finalize()
   // Reset global variables
   settings::assume_separate = false;
   settings::check_overlaps = false;
+  settings::compact_micro_xs = false;
   settings::confidence_intervals = false;
   settings::create_fission_neutrons = true;
   settings::create_delayed_neutrons = true;
+  settings::electron_inline_deposition = false;
   settings::electron_treatment = ElectronTreatment::LED;
   settings::delayed_photon_scaling = true;
+  settings::dry_run = false;
   settings::energy_cutoff = {0.0, 1000.0, 0.0, 0.0};
   settings::time_cutoff = {INFTY, INFTY, INFTY, INFTY};
+  settings::census_times.clear();
   settings::entropy_on = false;
   settings::event_based = false;
+  settings::event_history_tail = 0;
+  settings::event_autotune = false;
+  settings::event_queue_sort = false;
+  settings::event_secondary_queue = false;
+  settings::event_thread_pool = 0;
+  settings::event_xs_queue_groups = 0;
   settings::gen_per_batch = 1;
+  settings::guide_table_cells = 0;
+  settings::inelastic_scatter_cdf = false;
   settings::legendre_to_tabular = true;
+  settings::load_balancing = false;
   settings::legendre_to_tabular_points = -1;
   settings::material_cell_offsets = true;
+  settings::memory_report = false;
   settings::max_lost_particles = 10;
+  settings::neighbor_list_precompute = false;
+  settings::neighbor_list_reorder = false;
+  settings::numa_interleave = false;
   settings::max_order = 0;
+  settings::mg_alias_sampling = false;
   settings::max_particles_in_flight = 100000;
   settings::max_particle_events = 1'000'000;
   settings::max_history_splits = 10'000'000;
@@ -100,14 +130,25 @@ int openmc_finalize()
   settings::n_particles = -1;
   settings::output_summary = true;
   settings::output_tallies = true;
+  settings::output_compression = OutputCompression::none;
+  settings::output_compression_level = 4;
+  settings::output_chunk_size = 1 << 20;
+  settings::overlap_bank_sync = false;
+  settings::overlap_reduction = false;
+  settings::hierarchical_reduce = false;
   settings::particle_restart_run = false;
+  settings::pipeline_batches = false;
   settings::path_cross_sections.clear();
   settings::path_input.clear();
   settings::path_output.clear();
   settings::path_particle_restart.clear();
+  settings::path_geometry_cache.clear();
   settings::path_sourcepoint.clear();
   settings::path_statepoint.clear();
+  settings::path_telemetry.clear();
+  settings::path_xs_cache.clear();
   settings::photon_transport = false;
+  settings::profile = false;
   settings::reduce_tallies = true;
   settings::rel_max_lost_particles = 1.0e-6;
   settings::res_scat_on = false;
@@ -117,23 +158,54 @@ int openmc_finalize()
   settings::restart_run = false;
   settings::run_CE = true;
   settings::run_mode = RunMode::UNSET;
+  settings::source_convergence_min = 0;
+  settings::source_convergence_threshold = 2.0;
+  settings::source_convergence_window = 0;
+  settings::shared_xs = false;
+  settings::simplify_regions = false;
   settings::source_latest = false;
   settings::source_separate = false;
+  settings::source_shards = false;
+  settings::source_domain_bounds = false;
+  settings::statepoint_async = false;
+  settings::statepoint_delta = 0;
   settings::source_write = true;
+  settings::surf_source_stream = false;
+  settings::surface_distance_cache = false;
   settings::survival_biasing = false;
+  settings::tally_private_memory = 512.0;
+  settings::tally_stream = false;
+  settings::tally_stream_engine = "SST";
+  settings::tally_stream_ids.clear();
+  settings::tally_stream_name = "openmc-tallies";
   settings::temperature_default = 293.6;
   settings::temperature_method = TemperatureMethod::NEAREST;
   settings::temperature_multipole = false;
+  settings::thread_stats = false;
+  settings::thread_affinity = ThreadAffinity::NONE;
   settings::temperature_range = {0.0, 0.0};
   settings::temperature_tolerance = 10.0;
+  settings::track_buffer_memory = 16.0;
   settings::trigger_on = false;
   settings::trigger_predict = false;
   settings::trigger_batch_interval = 1;
   settings::ufs_on = false;
+  settings::fission_matrix_on = false;
+  settings::union_grid_memory = 0.0;
+  settings::photon_material_xs = false;
+  settings::photon_only = false;
+  settings::photon_product_cdf = false;
+  settings::prune_nuclear_data = false;
+  settings::photon_xs_tolerance = 0.0;
+  settings::ncrystal_xs_tolerance = 0.0;
   settings::urr_ptables_on = true;
+  settings::vectorized_xs = false;
   settings::verbosity = 7;
   settings::weight_cutoff = 0.25;
   settings::weight_survive = 1.0;
+  settings::wielandt_shift = 0.0;
+  settings::warm_start_entropy_tolerance = 0.0;
+  settings::warm_start_inactive = -1;
   settings::weight_windows_file.clear();
   settings::weight_windows_on = false;
   settings::write_all_tracks = false;
@@ -141,15 +213,20 @@ int openmc_finalize()
 
   simulation::keff = 1.0;
   simulation::need_depletion_rx = false;
+  simulation::need_element_photon_xs = false;
+  simulation::persistent = false;
+  simulation::source_kept = false;
   simulation::total_gen = 0;
 
   simulation::entropy_mesh = nullptr;
   simulation::ufs_mesh = nullptr;
+  simulation::fission_matrix_mesh = nullptr;
 
   data::energy_max = {INFTY, INFTY};
   data::energy_min = {0.0, 0.0};
   data::temperature_min = 0.0;
   data::temperature_max = INFTY;
+  data::nuclear_data_memory = 0.0;
   model::root_universe = -1;
   model::plotter_seed = 1;
   openmc::openmc_set_seed(DEFAULT_SEED);
@@ -161,10 +238,16 @@ int openmc_finalize()
   settings::libmesh_init.reset();
 #endif
 
-  // Free all MPI types
+  // Free all MPI types and communicators
 #ifdef OPENMC_MPI
   if (mpi::source_site != MPI_DATATYPE_NULL)
     MPI_Type_free(&mpi::source_site);
+  if (mpi::fission_site != MPI_DATATYPE_NULL)
+    MPI_Type_free(&mpi::fission_site);
+  if (mpi::node_intracomm != MPI_COMM_NULL)
+    MPI_Comm_free(&mpi::node_intracomm);
+  if (mpi::leader_intracomm != MPI_COMM_NULL)
+    MPI_Comm_free(&mpi::leader_intracomm);
 #endif
 
   return 0;
@@ -172,6 +255,10 @@ int openmc_finalize()
 
 int openmc_reset()
 {
+  // Results of a reduction or deferred batch still in progress are discarded
+  // below
+  finish_pipelined_batch();
+  finish_tally_reduction();
 
   model::universe_cell_counts.clear();
   model::universe_level_counts.clear();
@@ -179,6 +266,7 @@ int openmc_reset()
   for (auto& t : model::tallies) {
     t->reset();
   }
+  simulation::reaction_rates.reset();
 
   // Reset global tallies
   simulation::n_realizations = 0;
@@ -193,6 +281,8 @@ int openmc_reset()
   settings::cmfd_run = false;
 
   simulation::n_lost_particles = 0;
+  simulation::n_xs_temperature_hits = 0;
+  simulation::n_xs_temperature_misses = 0;
 
   return 0;
 }
@@ -209,9 +299,11 @@ int openmc_hard_reset()
   openmc_reset();
   reset_timers();
 
-  // Reset total generations and keff guess
+  // Reset total generations, keff guess, and any source kept from the
+  // previous simulation
   simulation::keff = 1.0;
   simulation::total_gen = 0;
+  simulation::source_kept = false;
 
   // Reset the random number generator state
   openmc::openmc_set_seed(DEFAULT_SEED);
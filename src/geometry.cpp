@@ -1,5 +1,7 @@
 #include "openmc/geometry.h"
 
+#include <algorithm> // for min
+
 #include <fmt/core.h>
 #include <fmt/ostream.h>
 
@@ -63,6 +65,50 @@ bool check_cell_overlap(GeometryState& p, bool error)
 
 //==============================================================================
 
+namespace {
+
+//! Offset added to the instance of a cell of the given map by the cell at one
+//! level above it and, for a lattice, by the tile the particle is in
+
+int level_offset(const GeometryState& p, int level, int map)
+{
+  const auto& c {*model::cells[p.coord(level).cell]};
+  int offset = 0;
+  if (c.type_ == Fill::UNIVERSE) {
+    offset += c.offset_[map];
+  } else if (c.type_ == Fill::LATTICE) {
+    offset += c.offset_[map];
+    auto& lat {*model::lattices[p.coord(level + 1).lattice]};
+    const auto& i_xyz {p.coord(level + 1).lattice_i};
+    if (lat.are_valid_indices(i_xyz)) {
+      offset += lat.offset(map, i_xyz);
+    }
+  }
+  return offset;
+}
+
+//! Update the distribcell offset kept on the lowest coordinate level, which is
+//! in a lattice, once the particle has moved to its tile from old_i_xyz
+
+void move_instance_offset(GeometryState& p, const array<int, 3>& old_i_xyz)
+{
+  auto& coord {p.lowest_coord()};
+  int map = coord.instance_map;
+  if (map == C_NONE)
+    return;
+
+  auto& lat {*model::lattices[coord.lattice]};
+  if (!lat.are_valid_indices(coord.lattice_i)) {
+    coord.instance_map = C_NONE;
+    return;
+  }
+  if (lat.are_valid_indices(old_i_xyz))
+    coord.instance_offset -= lat.offset(map, old_i_xyz);
+  coord.instance_offset += lat.offset(map, coord.lattice_i);
+}
+
+} // namespace
+
 int cell_instance_at_level(const GeometryState& p, int level)
 {
   // throw error if the requested level is too deep for the geometry
@@ -82,17 +128,32 @@ int cell_instance_at_level(const GeometryState& p, int level)
   // compute the cell's instance
   int instance = 0;
   for (int i = 0; i < level; i++) {
-    const auto& c_i {*model::cells[p.coord(i).cell]};
-    if (c_i.type_ == Fill::UNIVERSE) {
-      instance += c_i.offset_[c.distribcell_index_];
-    } else if (c_i.type_ == Fill::LATTICE) {
-      instance += c_i.offset_[c.distribcell_index_];
-      auto& lat {*model::lattices[p.coord(i + 1).lattice]};
-      const auto& i_xyz {p.coord(i + 1).lattice_i};
-      if (lat.are_valid_indices(i_xyz)) {
-        instance += lat.offset(c.distribcell_index_, i_xyz);
-      }
-    }
+    instance += level_offset(p, i, c.distribcell_index_);
+  }
+  return instance;
+}
+
+int lowest_cell_instance(GeometryState& p)
+{
+  int level = p.n_coord() - 1;
+  int map = model::cells[p.coord(level).cell]->distribcell_index_;
+  if (map == C_NONE)
+    return C_NONE;
+
+  // Start from the deepest level whose offset is known for this map. The
+  // offset of a level does not change while the particle moves within it and
+  // is carried along by cross_lattice when it moves to another tile.
+  int i = level;
+  while (i > 0 && p.coord(i).instance_map != map)
+    --i;
+  int instance = i > 0 ? p.coord(i).instance_offset : 0;
+
+  // Carry the offset down to the cell's level, keeping it on each level
+  for (; i < level; ++i) {
+    instance += level_offset(p, i, map);
+    auto& coord {p.coord(i + 1)};
+    coord.instance_map = map;
+    coord.instance_offset = instance;
   }
   return instance;
 }
@@ -102,13 +163,18 @@ int cell_instance_at_level(const GeometryState& p, int level)
 bool find_cell_inner(
   GeometryState& p, const NeighborList* neighbor_list, bool verbose)
 {
+  // Distances to surfaces are no longer valid if the coordinates change
+  p.clear_surface_distances();
+
   // Find which cell of this universe the particle is in.  Use the neighbor list
   // to shorten the search if one was provided.
   bool found = false;
   int32_t i_cell = C_NONE;
   if (neighbor_list) {
-    for (auto it = neighbor_list->cbegin(); it != neighbor_list->cend(); ++it) {
-      i_cell = *it;
+    for (int i = 0; i < NeighborList::CAPACITY; ++i) {
+      i_cell = (*neighbor_list)[i];
+      if (i_cell == C_NONE)
+        break;
 
       // Make sure the search cell is in the same universe.
       int i_universe = p.lowest_coord().universe;
@@ -121,6 +187,8 @@ bool find_cell_inner(
       auto surf = p.surface();
       if (model::cells[i_cell]->contains(r, u, surf)) {
         p.lowest_coord().cell = i_cell;
+        if (settings::neighbor_list_reorder)
+          neighbor_list->hit(i);
         found = true;
         break;
       }
@@ -169,7 +237,7 @@ bool find_cell_inner(
       p.cell_instance() = 0;
       // Find the distribcell instance number.
       if (c.distribcell_index_ >= 0) {
-        p.cell_instance() = cell_instance_at_level(p, p.n_coord() - 1);
+        p.cell_instance() = lowest_cell_instance(p);
       }
 
       // Set the material and temperature.
@@ -300,6 +368,7 @@ void cross_lattice(GeometryState& p, const BoundaryInfo& boundary, bool verbose)
 {
   auto& coord {p.lowest_coord()};
   auto& lat {*model::lattices[coord.lattice]};
+  int n_coord = p.n_coord();
 
   if (verbose) {
     write_message(
@@ -310,9 +379,11 @@ void cross_lattice(GeometryState& p, const BoundaryInfo& boundary, bool verbose)
   }
 
   // Set the lattice indices.
+  array<int, 3> old_i_xyz = coord.lattice_i;
   coord.lattice_i[0] += boundary.lattice_translation[0];
   coord.lattice_i[1] += boundary.lattice_translation[1];
   coord.lattice_i[2] += boundary.lattice_translation[2];
+  move_instance_offset(p, old_i_xyz);
 
   // Set the new coordinate position.
   const auto& upper_coord {p.coord(p.n_coord() - 2)};
@@ -341,8 +412,25 @@ void cross_lattice(GeometryState& p, const BoundaryInfo& boundary, bool verbose)
     bool found = exhaustive_find_cell(p);
 
     if (!found) {
-      // A particle crossing the corner of a lattice tile may not be found.  In
-      // this case, search for it from the base coords.
+      // A particle crossing the corner of a lattice tile may be in a diagonal
+      // neighbor of the element given by the translation.  Find the element
+      // it is in and search for it there, which keeps the coordinates of the
+      // levels above the lattice.
+      p.n_coord() = n_coord;
+      array<int, 3> i_xyz;
+      lat.get_indices(r, coord.u, i_xyz);
+      if (i_xyz != coord.lattice_i && lat.are_valid_indices(i_xyz)) {
+        old_i_xyz = coord.lattice_i;
+        coord.lattice_i = i_xyz;
+        move_instance_offset(p, old_i_xyz);
+        p.r_local() = lat.get_local_position(r, i_xyz);
+        coord.universe = lat[i_xyz];
+        found = exhaustive_find_cell(p);
+      }
+    }
+
+    if (!found) {
+      // Otherwise, search for it from the base coords.
       p.n_coord() = 1;
       bool found = exhaustive_find_cell(p);
       if (!found) {
@@ -356,7 +444,7 @@ void cross_lattice(GeometryState& p, const BoundaryInfo& boundary, bool verbose)
 
 //==============================================================================
 
-BoundaryInfo distance_to_boundary(GeometryState& p)
+BoundaryInfo distance_to_boundary(GeometryState& p, int n_levels)
 {
   BoundaryInfo info;
   double d_lat = INFINITY;
@@ -365,14 +453,24 @@ BoundaryInfo distance_to_boundary(GeometryState& p)
   array<int, 3> level_lat_trans {};
 
   // Loop over each coordinate level.
-  for (int i = 0; i < p.n_coord(); i++) {
+  if (n_levels == C_NONE)
+    n_levels = p.n_coord();
+  for (int i = 0; i < n_levels; i++) {
     const auto& coord {p.coord(i)};
     const Position& r {coord.r};
     const Direction& u {coord.u};
     Cell& c {*model::cells[coord.cell]};
 
-    // Find the oncoming surface in this cell and the distance to it.
-    auto surface_distance = c.distance(r, u, p.surface(), &p);
+    // Find the oncoming surface in this cell and the distance to it. For CSG
+    // cells, the distances to surfaces can be reused along the same ray.
+    std::pair<double, int32_t> surface_distance;
+    if (settings::surface_distance_cache &&
+        c.geom_type_ == GeometryType::CSG) {
+      surface_distance = static_cast<const CSGCell&>(c).distance(
+        r, u, p.surface(), p.surface_distances(i));
+    } else {
+      surface_distance = c.distance(r, u, p.surface(), &p);
+    }
     d_surf = surface_distance.first;
     level_surf_cross = surface_distance.second;
 
@@ -384,6 +482,7 @@ BoundaryInfo distance_to_boundary(GeometryState& p)
       std::pair<double, array<int, 3>> lattice_distance;
       switch (lat.type_) {
       case LatticeType::rect:
+      case LatticeType::sphere_pack:
         lattice_distance = lat.distance(r, u, coord.lattice_i);
         break;
       case LatticeType::hex:
@@ -450,6 +549,19 @@ BoundaryInfo distance_to_boundary(GeometryState& p)
   return info;
 }
 
+//==============================================================================
+
+double distance_to_geometry(GeometryState& p)
+{
+  double d_min = INFTY;
+  const auto& root = model::universes[model::root_universe];
+  for (auto i_cell : root->cells_) {
+    auto d = model::cells[i_cell]->distance(p.r(), p.u(), 0, &p);
+    d_min = std::min(d_min, d.first);
+  }
+  return d_min;
+}
+
 //==============================================================================
 // C API
 //==============================================================================
@@ -1,8 +1,11 @@
 #include "openmc/geometry_aux.h"
 
-#include <algorithm> // for std::max
+#include <algorithm> // for std::max, sort
+#include <limits>    // for numeric_limits
 #include <sstream>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility> // for pair
 
 #include <fmt/core.h>
 #include <pugixml.hpp>
@@ -14,6 +17,7 @@
 #include "openmc/error.h"
 #include "openmc/file_utils.h"
 #include "openmc/geometry.h"
+#include "openmc/geometry_cache.h"
 #include "openmc/lattice.h"
 #include "openmc/material.h"
 #include "openmc/settings.h"
@@ -21,6 +25,7 @@
 #include "openmc/tallies/filter.h"
 #include "openmc/tallies/filter_cell_instance.h"
 #include "openmc/tallies/filter_distribcell.h"
+#include "openmc/timer.h"
 
 namespace openmc {
 
@@ -66,6 +71,8 @@ void read_geometry_xml()
 
 void read_geometry_xml(pugi::xml_node root)
 {
+  simulation::time_read_geometry.start();
+
   // Read surfaces, cells, lattice
   read_surfaces(root);
   read_cells(root);
@@ -81,8 +88,8 @@ void read_geometry_xml(pugi::xml_node root)
     }
   }
 
-  if (settings::run_mode != RunMode::PLOTTING &&
-      settings::run_mode != RunMode::VOLUME && !boundary_exists) {
+  if (!geometry_only() && settings::run_mode != RunMode::VOLUME &&
+      !boundary_exists) {
     fatal_error("No boundary conditions were applied to any surfaces!");
   }
 
@@ -91,6 +98,8 @@ void read_geometry_xml(pugi::xml_node root)
 
   // if the root universe is DAGMC geometry, make sure the model is well-formed
   check_dagmc_root_univ();
+
+  simulation::time_read_geometry.stop();
 }
 
 //==============================================================================
@@ -149,14 +158,14 @@ void adjust_indices()
 }
 
 //==============================================================================
-//! Partition some universes with many z-planes for faster find_cell searches.
+//! Partition universes with many cells for faster find_cell searches.
 
 void partition_universes()
 {
   // Iterate over universes with more than 10 cells.  (Fewer than 10 is likely
   // not worth partitioning.)
   for (const auto& univ : model::universes) {
-    if (univ->cells_.size() > 10) {
+    if (univ->cells_.size() > 10 && univ->geom_type() == GeometryType::CSG) {
       // Collect the set of surfaces in this universe.
       std::unordered_set<int32_t> surf_inds;
       for (auto i_cell : univ->cells_) {
@@ -172,11 +181,106 @@ void partition_universes()
         if (dynamic_cast<const SurfaceZPlane*>(model::surfaces[i_surf].get())) {
           ++n_zplanes;
           if (n_zplanes > 5) {
-            univ->partitioner_ = make_unique<UniversePartitioner>(*univ);
+            univ->partitioner_ = make_unique<ZPlanePartitioner>(*univ);
             break;
           }
         }
       }
+
+      // Otherwise, partition the universe with an octree of cell bounding
+      // boxes if that is expected to at least halve the number of cells
+      // checked
+      if (!univ->partitioner_) {
+        auto octree = make_unique<OctreePartitioner>(*univ);
+        if (octree->mean_cells() < 0.5 * univ->cells_.size())
+          univ->partitioner_ = std::move(octree);
+      }
+    }
+
+#ifdef DAGMC
+    // DAGMC volumes are only partitioned by their bounding boxes
+    if (univ->cells_.size() > 10 && univ->geom_type() == GeometryType::DAG)
+      static_cast<DAGUniverse*>(univ.get())->partition();
+#endif
+  }
+}
+
+//==============================================================================
+//! Fill the neighbor list of each cell with the cells of the same universe that
+//! lie on the other side of its surfaces, so that surface crossings do not
+//! need an exhaustive search while the lists would otherwise be filling up.
+
+void build_neighbor_lists()
+{
+  for (const auto& univ : model::universes) {
+    if (univ->geom_type() != GeometryType::CSG)
+      continue;
+    const auto& cells = univ->cells_;
+    int n = cells.size();
+
+    // Find the bounding box of each cell and the cells bounded by each side of
+    // each surface
+    vector<BoundingBox> boxes(n);
+    vector<vector<int32_t>> tokens(n);
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < n; ++i) {
+      const auto& c {*model::cells[cells[i]]};
+      boxes[i] = c.bounding_box();
+      tokens[i] = c.surfaces();
+    }
+    std::unordered_map<int32_t, vector<int>> by_token;
+    for (int i = 0; i < n; ++i) {
+      for (auto token : tokens[i]) {
+        auto& v = by_token[token];
+        if (v.empty() || v.back() != i)
+          v.push_back(i);
+      }
+    }
+
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < n; ++i) {
+      auto& c {*model::cells[cells[i]]};
+
+      // A cell is a candidate if it is bounded by the opposite side of one of
+      // the surfaces of this cell and their bounding boxes touch. Either side
+      // is accepted when a cell is not simple, since a union may then take a
+      // surface with either sense.
+      vector<int> candidates;
+      for (auto token : tokens[i]) {
+        for (int sense : {-1, 1}) {
+          auto it = by_token.find(sense * token);
+          if (it == by_token.end())
+            continue;
+          for (auto j : it->second) {
+            if (j == i)
+              continue;
+            if (sense == 1 && c.is_simple() &&
+                model::cells[cells[j]]->is_simple())
+              continue;
+            BoundingBox box = boxes[i] & boxes[j];
+            if (box.xmin > box.xmax + TINY_BIT ||
+                box.ymin > box.ymax + TINY_BIT ||
+                box.zmin > box.zmax + TINY_BIT)
+              continue;
+            candidates.push_back(j);
+          }
+        }
+      }
+
+      // Check the cells sharing the most surfaces first
+      std::sort(candidates.begin(), candidates.end());
+      vector<std::pair<int, int>> counts;
+      for (auto j : candidates) {
+        if (!counts.empty() && counts.back().second == j) {
+          --counts.back().first;
+        } else {
+          counts.emplace_back(-1, j);
+        }
+      }
+      std::sort(counts.begin(), counts.end());
+      for (const auto& count : counts) {
+        c.neighbors_.push_back(cells[count.second]);
+      }
     }
   }
 }
@@ -261,16 +365,23 @@ void get_temperatures(
 
 void finalize_geometry()
 {
+  simulation::time_setup_geometry.start();
+
   // Perform some final operations to set up the geometry
   adjust_indices();
+  open_geometry_cache();
   count_cell_instances(model::root_universe);
   partition_universes();
+  if (settings::neighbor_list_precompute && !read_cached_neighbor_lists())
+    build_neighbor_lists();
 
   // Assign temperatures to cells that don't have temperatures already assigned
   assign_temperatures();
 
   // Determine number of nested coordinate levels in the geometry
   model::n_coord_levels = maximum_levels(model::root_universe);
+
+  simulation::time_setup_geometry.stop();
 }
 
 //==============================================================================
@@ -321,6 +432,7 @@ int32_t find_root_universe()
 void prepare_distribcell(const std::vector<int32_t>* user_distribcells)
 {
   write_message("Preparing distributed cell instances...", 5);
+  simulation::time_distribcell.start();
 
   std::unordered_set<int32_t> distribcells;
 
@@ -377,14 +489,18 @@ void prepare_distribcell(const std::vector<int32_t>* user_distribcells)
   }
 
   // Search through universes for material cells and assign each one a
-  // unique distribcell array index.
-  int distribcell_index = 0;
+  // distribcell array index. The offsets only depend on the universe that
+  // holds a cell, so the cells of one universe share an offset map.
   vector<int32_t> target_univ_ids;
   for (const auto& u : model::universes) {
+    int map = C_NONE;
     for (auto idx : u->cells_) {
       if (distribcells.find(idx) != distribcells.end()) {
-        model::cells[idx]->distribcell_index_ = distribcell_index++;
-        target_univ_ids.push_back(u->id_);
+        if (map == C_NONE) {
+          map = target_univ_ids.size();
+          target_univ_ids.push_back(u->id_);
+        }
+        model::cells[idx]->distribcell_index_ = map;
       }
     }
   }
@@ -400,24 +516,32 @@ void prepare_distribcell(const std::vector<int32_t>* user_distribcells)
     lat->allocate_offset_table(n_maps);
   }
 
-// Fill the cell and lattice offset tables.
-#pragma omp parallel for
+  // Offsets of the maps found from the input files may be read from the cache
+  if (!user_distribcells && read_cached_offsets()) {
+    simulation::time_distribcell.stop();
+    return;
+  }
+
+// Fill the cell and lattice offset tables. Maps of universes that are deep in
+// the geometry take much longer than the others, so they are balanced
+// dynamically.
+#pragma omp parallel for schedule(dynamic)
   for (int map = 0; map < target_univ_ids.size(); map++) {
     auto target_univ_id = target_univ_ids[map];
-    std::unordered_map<int32_t, int32_t> univ_count_memo;
+    std::unordered_map<int32_t, int64_t> univ_count_memo;
     for (const auto& univ : model::universes) {
-      int32_t offset = 0;
+      int64_t offset = 0;
       for (int32_t cell_indx : univ->cells_) {
         Cell& c = *model::cells[cell_indx];
 
         if (c.type_ == Fill::UNIVERSE) {
-          c.offset_[map] = offset;
+          c.offset_[map] = narrow_offset(offset);
           int32_t search_univ = c.fill_;
           offset += count_universe_instances(
             search_univ, target_univ_id, univ_count_memo);
 
         } else if (c.type_ == Fill::LATTICE) {
-          c.offset_[map] = offset;
+          c.offset_[map] = narrow_offset(offset);
           Lattice& lat = *model::lattices[c.fill_];
           offset +=
             lat.fill_offset_table(offset, target_univ_id, map, univ_count_memo);
@@ -425,6 +549,8 @@ void prepare_distribcell(const std::vector<int32_t>* user_distribcells)
       }
     }
   }
+
+  simulation::time_distribcell.stop();
 }
 
 //==============================================================================
@@ -460,8 +586,8 @@ void count_cell_instances(int32_t univ_indx)
 
 //==============================================================================
 
-int count_universe_instances(int32_t search_univ, int32_t target_univ_id,
-  std::unordered_map<int32_t, int32_t>& univ_count_memo)
+int64_t count_universe_instances(int32_t search_univ, int32_t target_univ_id,
+  std::unordered_map<int32_t, int64_t>& univ_count_memo)
 {
   // If this is the target, it can't contain itself.
   if (model::universes[search_univ]->id_ == target_univ_id) {
@@ -474,7 +600,7 @@ int count_universe_instances(int32_t search_univ, int32_t target_univ_id,
     return search->second;
   }
 
-  int count {0};
+  int64_t count {0};
   for (int32_t cell_indx : model::universes[search_univ]->cells_) {
     Cell& c = *model::cells[cell_indx];
 
@@ -501,6 +627,18 @@ int count_universe_instances(int32_t search_univ, int32_t target_univ_id,
 
 //==============================================================================
 
+int32_t narrow_offset(int64_t offset)
+{
+  if (offset > std::numeric_limits<int32_t>::max()) {
+    fatal_error(fmt::format("The geometry holds {} instances of a distributed "
+                            "cell, more than the offset tables can index.",
+      offset));
+  }
+  return offset;
+}
+
+//==============================================================================
+
 std::string distribcell_path_inner(int32_t target_cell, int32_t map,
   int32_t target_offset, const Universe& search_univ, int32_t offset)
 {
@@ -0,0 +1,195 @@
+#include "openmc/geometry_cache.h"
+
+#include <algorithm> // for copy
+#include <cstdint>
+#include <fstream>
+#include <iterator> // for istreambuf_iterator
+#include <string>
+
+#include <fmt/core.h>
+
+#include "openmc/cell.h"
+#include "openmc/constants.h"
+#include "openmc/error.h"
+#include "openmc/file_utils.h"
+#include "openmc/hdf5_interface.h"
+#include "openmc/lattice.h"
+#include "openmc/message_passing.h"
+#include "openmc/neighbor_list.h"
+#include "openmc/settings.h"
+#include "openmc/string_utils.h"
+#include "openmc/universe.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+namespace {
+
+bool enabled {false}; //!< is the geometry cached?
+bool valid {false};   //!< was the cache written for the same input files?
+std::string input_hash;
+
+//! Update a 64-bit FNV-1a hash with the contents of a file
+uint64_t hash_file(const std::string& filename, uint64_t hash)
+{
+  std::ifstream fh {filename, std::ios::binary};
+  for (auto it = std::istreambuf_iterator<char>(fh);
+       it != std::istreambuf_iterator<char>(); ++it) {
+    hash ^= static_cast<unsigned char>(*it);
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+//! Hash of the XML files the model is read from
+std::string hash_input()
+{
+  uint64_t hash = 0xcbf29ce484222325;
+  const auto& path = settings::path_input;
+  if (!path.empty() && file_exists(path) && !dir_exists(path)) {
+    hash = hash_file(path, hash);
+  } else if (file_exists(path + "model.xml")) {
+    hash = hash_file(path + "model.xml", hash);
+  } else {
+    for (const char* name :
+      {"settings.xml", "materials.xml", "geometry.xml", "tallies.xml"}) {
+      if (file_exists(path + name))
+        hash = hash_file(path + name, hash);
+    }
+  }
+  return fmt::format("{:016x}", hash);
+}
+
+} // namespace
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void open_geometry_cache()
+{
+  enabled = !settings::path_geometry_cache.empty();
+  valid = false;
+  if (!enabled)
+    return;
+  for (const auto& univ : model::universes) {
+    if (univ->geom_type() == GeometryType::DAG) {
+      warning("The geometry cache is not used with DAGMC universes.");
+      enabled = false;
+      return;
+    }
+  }
+
+  input_hash = hash_input();
+  const auto& filename = settings::path_geometry_cache;
+  if (!file_exists(filename))
+    return;
+  hid_t file_id = file_open(filename, 'r');
+  std::string filetype, hash;
+  if (attribute_exists(file_id, "filetype"))
+    read_attribute(file_id, "filetype", filetype);
+  if (attribute_exists(file_id, "input_hash"))
+    read_attribute(file_id, "input_hash", hash);
+  file_close(file_id);
+  valid = filetype == "geometry_cache" && hash == input_hash;
+  if (valid) {
+    write_message(5, "Reading geometry cache {}...", filename);
+  } else {
+    write_message(5, "Geometry cache {} is out of date", filename);
+  }
+}
+
+bool read_cached_offsets()
+{
+  if (!valid)
+    return false;
+  hid_t file_id = file_open(settings::path_geometry_cache, 'r');
+  vector<int32_t> cell_offsets, lattice_offsets;
+  read_dataset(file_id, "cell_offsets", cell_offsets);
+  read_dataset(file_id, "lattice_offsets", lattice_offsets);
+  file_close(file_id);
+
+  // The tables are only filled if they have the sizes they were allocated with
+  int64_t n_cell = 0;
+  for (const auto& c : model::cells) {
+    n_cell += c->offset_.size();
+  }
+  int64_t n_lattice = 0;
+  for (const auto& lat : model::lattices) {
+    n_lattice += lat->offsets_.size();
+  }
+  if (n_cell != cell_offsets.size() || n_lattice != lattice_offsets.size())
+    return false;
+
+  auto it = cell_offsets.begin();
+  for (auto& c : model::cells) {
+    std::copy(it, it + c->offset_.size(), c->offset_.begin());
+    it += c->offset_.size();
+  }
+  it = lattice_offsets.begin();
+  for (auto& lat : model::lattices) {
+    std::copy(it, it + lat->offsets_.size(), lat->offsets_.begin());
+    it += lat->offsets_.size();
+  }
+  return true;
+}
+
+bool read_cached_neighbor_lists()
+{
+  if (!valid)
+    return false;
+  hid_t file_id = file_open(settings::path_geometry_cache, 'r');
+  bool found = object_exists(file_id, "neighbors");
+  vector<int32_t> neighbors;
+  if (found)
+    read_dataset(file_id, "neighbors", neighbors);
+  file_close(file_id);
+  if (neighbors.size() != model::cells.size() * NeighborList::CAPACITY)
+    return false;
+
+  auto it = neighbors.begin();
+  for (auto& c : model::cells) {
+    for (int i = 0; i < NeighborList::CAPACITY; ++i, ++it) {
+      if (*it != C_NONE)
+        c->neighbors_.push_back(*it);
+    }
+  }
+  return true;
+}
+
+void write_geometry_cache()
+{
+  if (!enabled || valid || !mpi::master)
+    return;
+
+  vector<int32_t> cell_offsets, lattice_offsets;
+  for (const auto& c : model::cells) {
+    cell_offsets.insert(
+      cell_offsets.end(), c->offset_.begin(), c->offset_.end());
+  }
+  for (const auto& lat : model::lattices) {
+    lattice_offsets.insert(
+      lattice_offsets.end(), lat->offsets_.begin(), lat->offsets_.end());
+  }
+
+  write_message(
+    5, "Writing geometry cache {}...", settings::path_geometry_cache);
+  hid_t file_id = file_open(settings::path_geometry_cache, 'w');
+  write_attribute(file_id, "filetype", "geometry_cache");
+  write_attribute(file_id, "input_hash", input_hash);
+  write_dataset(file_id, "cell_offsets", cell_offsets);
+  write_dataset(file_id, "lattice_offsets", lattice_offsets);
+  if (settings::neighbor_list_precompute) {
+    vector<int32_t> neighbors;
+    neighbors.reserve(model::cells.size() * NeighborList::CAPACITY);
+    for (const auto& c : model::cells) {
+      for (int i = 0; i < NeighborList::CAPACITY; ++i) {
+        neighbors.push_back(c->neighbors_[i]);
+      }
+    }
+    write_dataset(file_id, "neighbors", neighbors);
+  }
+  file_close(file_id);
+}
+
+} // namespace openmc
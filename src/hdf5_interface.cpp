@@ -16,6 +16,7 @@
 #endif
 
 #include "openmc/array.h"
+#include "openmc/settings.h"
 
 namespace openmc {
 
@@ -216,6 +217,31 @@ hid_t open_group(hid_t group_id, const std::string& name)
   return open_group(group_id, name.c_str());
 }
 
+hid_t file_open_memory(const std::string& filename)
+{
+  // Use the core driver without saving the file to disk when it is closed
+  hid_t plist = H5Pcreate(H5P_FILE_ACCESS);
+  H5Pset_fapl_core(plist, 1 << 24, false);
+  hid_t file_id =
+    H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, plist);
+  H5Pclose(plist);
+  if (file_id < 0) {
+    fatal_error(
+      fmt::format("Failed to create HDF5 file in memory: {}", filename));
+  }
+  return file_id;
+}
+
+vector<char> file_close_image(hid_t file_id)
+{
+  ssize_t size = H5Fget_file_image(file_id, nullptr, 0);
+  vector<char> image(size > 0 ? size : 0);
+  if (size > 0)
+    H5Fget_file_image(file_id, image.data(), image.size());
+  H5Fclose(file_id);
+  return image;
+}
+
 void file_close(hid_t file_id)
 {
   H5Fclose(file_id);
@@ -607,7 +633,7 @@ void write_attr_string(hid_t obj_id, const char* name, const char* buffer)
 
 void write_dataset_lowlevel(hid_t group_id, int ndim, const hsize_t* dims,
   const char* name, hid_t mem_type_id, hid_t mem_space_id, bool indep,
-  const void* buffer)
+  const void* buffer, hid_t dcpl)
 {
   // If array is given, create a simple dataspace. Otherwise, create a scalar
   // datascape.
@@ -619,7 +645,7 @@ void write_dataset_lowlevel(hid_t group_id, int ndim, const hsize_t* dims,
   }
 
   hid_t dset = H5Dcreate(
-    group_id, name, mem_type_id, dspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    group_id, name, mem_type_id, dspace, H5P_DEFAULT, dcpl, H5P_DEFAULT);
 
   if (using_mpio_device(group_id)) {
 #ifdef PHDF5
@@ -700,14 +726,83 @@ void write_tally_results(
   hid_t memspace = H5Screate_simple(ndim, dims, nullptr);
   H5Sselect_hyperslab(memspace, H5S_SELECT_SET, start, nullptr, count, nullptr);
 
-  // Create and write dataset
+  // Create and write dataset, compressing it if requested
+  hid_t dcpl = create_compressed_plist(ndim, count, sizeof(double));
   write_dataset_lowlevel(group_id, ndim, count, "results", H5T_NATIVE_DOUBLE,
-    memspace, false, results);
+    memspace, false, results, dcpl);
 
   // Free resources
+  if (dcpl != H5P_DEFAULT)
+    H5Pclose(dcpl);
   H5Sclose(memspace);
 }
 
+hid_t create_compressed_plist(
+  int ndim, const hsize_t* dims, size_t type_size, hsize_t max_rows)
+{
+  if (settings::output_compression == OutputCompression::none || ndim == 0)
+    return H5P_DEFAULT;
+
+  auto n_bytes = [&](const vector<hsize_t>& shape) {
+    hsize_t n = type_size;
+    for (auto d : shape)
+      n *= d;
+    return n;
+  };
+
+  // Empty datasets and datasets that fit in one chunk are left contiguous
+  vector<hsize_t> chunk(dims, dims + ndim);
+  hsize_t chunk_size = settings::output_chunk_size;
+  if (n_bytes(chunk) == 0 || n_bytes(chunk) <= chunk_size)
+    return H5P_DEFAULT;
+
+  // Halve the chunk along each dimension in turn, starting with the slowest
+  // varying one, until it is no larger than the requested size
+  if (max_rows > 0)
+    chunk[0] = std::min(chunk[0], max_rows);
+  for (auto& d : chunk) {
+    while (d > 1 && n_bytes(chunk) > chunk_size)
+      d = (d + 1) / 2;
+  }
+
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(dcpl, ndim, chunk.data());
+  unsigned level = settings::output_compression_level;
+  switch (settings::output_compression) {
+  case OutputCompression::deflate:
+    // Grouping the bytes of each significance together compresses floating
+    // point values much better
+    H5Pset_shuffle(dcpl);
+    H5Pset_deflate(dcpl, level);
+    break;
+  case OutputCompression::szip:
+    H5Pset_szip(dcpl, H5_SZIP_NN_OPTION_MASK, 16);
+    break;
+  case OutputCompression::zstd:
+    H5Pset_shuffle(dcpl);
+    H5Pset_filter(dcpl, H5Z_FILTER_ZSTD, H5Z_FLAG_MANDATORY, 1, &level);
+    break;
+  default:
+    break;
+  }
+  return dcpl;
+}
+
+bool compression_available(OutputCompression filter)
+{
+  switch (filter) {
+  case OutputCompression::deflate:
+    return H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0;
+  case OutputCompression::szip:
+    return H5Zfilter_avail(H5Z_FILTER_SZIP) > 0;
+  case OutputCompression::zstd:
+    // Loads the filter plugin if it is found on HDF5_PLUGIN_PATH
+    return H5Zfilter_avail(H5Z_FILTER_ZSTD) > 0;
+  default:
+    return true;
+  }
+}
+
 bool using_mpio_device(hid_t obj_id)
 {
   // Determine file that this object is part of
@@ -742,6 +837,8 @@ const hid_t H5TypeMap<int64_t>::type_id = H5T_NATIVE_INT64;
 template<>
 const hid_t H5TypeMap<double>::type_id = H5T_NATIVE_DOUBLE;
 template<>
+const hid_t H5TypeMap<float>::type_id = H5T_NATIVE_FLOAT;
+template<>
 const hid_t H5TypeMap<char>::type_id = H5T_NATIVE_CHAR;
 
 } // namespace openmc
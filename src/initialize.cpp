@@ -17,12 +17,14 @@
 #include "openmc/error.h"
 #include "openmc/file_utils.h"
 #include "openmc/geometry_aux.h"
+#include "openmc/geometry_cache.h"
 #include "openmc/hdf5_interface.h"
 #include "openmc/material.h"
 #include "openmc/memory.h"
 #include "openmc/message_passing.h"
 #include "openmc/mgxs_interface.h"
 #include "openmc/nuclide.h"
+#include "openmc/numa.h"
 #include "openmc/openmp_interface.h"
 #include "openmc/output.h"
 #include "openmc/plot.h"
@@ -153,6 +155,18 @@ void initialize_mpi(MPI_Comm intracomm)
   MPI_Comm_rank(intracomm, &mpi::rank);
   mpi::master = (mpi::rank == 0);
 
+  // Group the processes that can share memory
+  MPI_Comm_split_type(intracomm, MPI_COMM_TYPE_SHARED, mpi::rank,
+    MPI_INFO_NULL, &mpi::node_intracomm);
+
+  // The first process of each node takes part in reductions across nodes
+  int node_rank;
+  MPI_Comm_rank(mpi::node_intracomm, &node_rank);
+  MPI_Comm_split(intracomm, node_rank == 0 ? 0 : MPI_UNDEFINED, mpi::rank,
+    &mpi::leader_intracomm);
+  int leader = (node_rank == 0);
+  MPI_Allreduce(&leader, &mpi::n_nodes, 1, MPI_INT, MPI_SUM, intracomm);
+
   // Create bank datatype
   SourceSite b;
   MPI_Aint disp[10];
@@ -175,6 +189,18 @@ void initialize_mpi(MPI_Comm intracomm)
     MPI_DOUBLE, MPI_INT, MPI_INT, MPI_INT, MPI_LONG, MPI_LONG};
   MPI_Type_create_struct(10, blocks, disp, types, &mpi::source_site);
   MPI_Type_commit(&mpi::source_site);
+
+  // Create datatype for sites exchanged when synchronizing the fission bank.
+  // Fission sites are always neutrons that were not born on a surface, and
+  // their parent and progeny IDs are only needed to sort the fission bank, so
+  // only the first six fields are sent. The extent is that of a full site so
+  // that arrays of sites can be sent directly.
+  MPI_Datatype fission_site;
+  MPI_Type_create_struct(6, blocks, disp, types, &fission_site);
+  MPI_Type_create_resized(
+    fission_site, 0, sizeof(SourceSite), &mpi::fission_site);
+  MPI_Type_free(&fission_site);
+  MPI_Type_commit(&mpi::fission_site);
 }
 #endif // OPENMC_MPI
 
@@ -247,10 +273,14 @@ int parse_command_line(int argc, char* argv[])
           settings::path_sourcepoint = settings::path_statepoint;
         }
 
+      } else if (arg == "-d" || arg == "--dry-run") {
+        settings::dry_run = true;
       } else if (arg == "-g" || arg == "--geometry-debug") {
         settings::check_overlaps = true;
       } else if (arg == "-c" || arg == "--volume") {
         settings::run_mode = RunMode::VOLUME;
+      } else if (arg == "-o" || arg == "--overlap-check") {
+        settings::run_mode = RunMode::OVERLAP_CHECK;
       } else if (arg == "-s" || arg == "--threads") {
         // Read number of threads
         i += 1;
@@ -357,6 +387,7 @@ bool read_model_xml()
     fmt::format("Reading model XML file '{}' ...", model_filename), 5);
 
   read_settings_xml(settings_root);
+  pin_threads();
 
   // If other XML files are present, display warning
   // that they will be ignored
@@ -377,7 +408,7 @@ bool read_model_xml()
       "No <materials> node present in the {} file.", model_filename));
   }
 
-  if (settings::run_mode != RunMode::PLOTTING) {
+  if (!geometry_only()) {
     read_cross_sections_xml(root.child("materials"));
   }
   read_materials_xml(root.child("materials"));
@@ -397,9 +428,11 @@ bool read_model_xml()
 
   if (check_for_node(root, "tallies"))
     read_tallies_xml(root.child("tallies"));
+  prune_nuclear_data();
 
   // Initialize distribcell_filters
   prepare_distribcell();
+  write_geometry_cache();
 
   if (check_for_node(root, "plots")) {
     read_plots_xml(root.child("plots"));
@@ -420,7 +453,8 @@ bool read_model_xml()
 void read_separate_xml_files()
 {
   read_settings_xml();
-  if (settings::run_mode != RunMode::PLOTTING) {
+  pin_threads();
+  if (!geometry_only()) {
     read_cross_sections_xml();
   }
   read_materials_xml();
@@ -432,9 +466,11 @@ void read_separate_xml_files()
   // Finalize cross sections having assigned temperatures
   finalize_cross_sections();
   read_tallies_xml();
+  prune_nuclear_data();
 
   // Initialize distribcell_filters
   prepare_distribcell();
+  write_geometry_cache();
 
   // Read the plots.xml regardless of plot mode in case plots are requested
   // via the API
@@ -446,9 +482,10 @@ void read_separate_xml_files()
 void initial_output()
 {
   // write initial output
-  if (settings::run_mode == RunMode::PLOTTING) {
+  if (geometry_only()) {
     // Read plots.xml if it exists
-    if (mpi::master && settings::verbosity >= 5)
+    if (mpi::master && settings::verbosity >= 5 &&
+        settings::run_mode == RunMode::PLOTTING)
       print_plot();
 
   } else {
@@ -1,5 +1,6 @@
 #include "openmc/lattice.h"
 
+#include <algorithm> // for clamp, max, min, swap
 #include <cmath>
 #include <string>
 
@@ -11,6 +12,7 @@
 #include "openmc/geometry_aux.h"
 #include "openmc/hdf5_interface.h"
 #include "openmc/string_utils.h"
+#include "openmc/surface.h"
 #include "openmc/vector.h"
 #include "openmc/xml_interface.h"
 
@@ -25,6 +27,14 @@ std::unordered_map<int32_t, int32_t> lattice_map;
 vector<unique_ptr<Lattice>> lattices;
 } // namespace model
 
+namespace {
+
+// Changes in the (x, alpha) or (alpha, y) indices of a hexagonal lattice when
+// crossing into the neighbor in the beta, gamma, and delta directions
+constexpr array<array<int, 2>, 3> HEX_STEPS {{{1, 0}, {1, -1}, {0, 1}}};
+
+} // namespace
+
 //==============================================================================
 // Lattice implementation
 //==============================================================================
@@ -103,8 +113,8 @@ void Lattice::adjust_indices()
 
 //==============================================================================
 
-int32_t Lattice::fill_offset_table(int32_t offset, int32_t target_univ_id,
-  int map, std::unordered_map<int32_t, int32_t>& univ_count_memo)
+int64_t Lattice::fill_offset_table(int64_t offset, int32_t target_univ_id,
+  int map, std::unordered_map<int32_t, int64_t>& univ_count_memo)
 {
   // If the offsets have already been determined for this "map", don't bother
   // recalculating all of them and just return the total offset. Note that the
@@ -112,7 +122,7 @@ int32_t Lattice::fill_offset_table(int32_t offset, int32_t target_univ_id,
   // universe, so we get the before-last offset for the given map and then
   // explicitly add the count for the last universe.
   if (offsets_[map * universes_.size() + this->begin().indx_] != C_NONE) {
-    int last_offset =
+    int64_t last_offset =
       offsets_[(map + 1) * universes_.size() - this->begin().indx_ - 1];
     int last_univ = this->back();
     return last_offset +
@@ -120,7 +130,7 @@ int32_t Lattice::fill_offset_table(int32_t offset, int32_t target_univ_id,
   }
 
   for (LatticeIter it = begin(); it != end(); ++it) {
-    offsets_[map * universes_.size() + it.indx_] = offset;
+    offsets_[map * universes_.size() + it.indx_] = narrow_offset(offset);
     offset += count_universe_instances(*it, target_univ_id, univ_count_memo);
   }
 
@@ -483,6 +493,23 @@ HexLattice::HexLattice(pugi::xml_node lat_node) : Lattice {lat_node}
     orientation_ = Orientation::y;
   }
 
+  // Directions towards the flat sides of each hexagonal tile.
+  // Y - orientation:
+  //   beta   = (sqrt(3)/2, 1/2)
+  //   gamma  = (sqrt(3)/2, -1/2) = -60 degrees from beta
+  //   delta  = (0, 1)            = +60 degrees from beta
+  // X - orientation:
+  //   beta   = (1, 0)
+  //   gamma  = (1/2, -sqrt(3)/2) = -60 degrees from beta
+  //   delta  = (1/2, sqrt(3)/2)  = +60 degrees from beta
+  if (orientation_ == Orientation::y) {
+    normals_ = {{{std::sqrt(3.0) / 2.0, 0.5}, {std::sqrt(3.0) / 2.0, -0.5},
+      {0.0, 1.0}}};
+  } else {
+    normals_ = {{{1.0, 0.0}, {0.5, -std::sqrt(3.0) / 2.0},
+      {0.5, std::sqrt(3.0) / 2.0}}};
+  }
+
   // Read the lattice center.
   std::string center_str {get_node_value(lat_node, "center")};
   vector<std::string> center_words {split(center_str)};
@@ -737,118 +764,39 @@ bool HexLattice::are_valid_indices(const array<int, 3>& i_xyz) const
 std::pair<double, array<int, 3>> HexLattice::distance(
   Position r, Direction u, const array<int, 3>& i_xyz) const
 {
-  // Short description of the direction vectors used here.  The beta, gamma, and
-  // delta vectors point towards the flat sides of each hexagonal tile.
-  // Y - orientation:
-  //   basis0 = (1, 0)
-  //   basis1 = (-1/sqrt(3), 1)   = +120 degrees from basis0
-  //   beta   = (sqrt(3)/2, 1/2)  = +30 degrees from basis0
-  //   gamma  = (sqrt(3)/2, -1/2) = -60 degrees from beta
-  //   delta  = (0, 1)            = +60 degrees from beta
-  // X - orientation:
-  //   basis0 = (1/sqrt(3), -1)
-  //   basis1 = (0, 1)            = +120 degrees from basis0
-  //   beta   = (1, 0)            = +30 degrees from basis0
-  //   gamma  = (1/2, -sqrt(3)/2) = -60 degrees from beta
-  //   delta  = (1/2, sqrt(3)/2)  = +60 degrees from beta
-  // The z-axis is considered separately.
-  double beta_dir;
-  double gamma_dir;
-  double delta_dir;
-  if (orientation_ == Orientation::y) {
-    beta_dir = u.x * std::sqrt(3.0) / 2.0 + u.y / 2.0;
-    gamma_dir = u.x * std::sqrt(3.0) / 2.0 - u.y / 2.0;
-    delta_dir = u.y;
-  } else {
-    beta_dir = u.x;
-    gamma_dir = u.x / 2.0 - u.y * std::sqrt(3.0) / 2.0;
-    delta_dir = u.x / 2.0 + u.y * std::sqrt(3.0) / 2.0;
-  }
-
   // Note that hexagonal lattice distance calculations are performed
   // using the particle's coordinates relative to the neighbor lattice
   // cells, not relative to the particle's current cell.  This is done
   // because there is significant disagreement between neighboring cells
   // on where the lattice boundary is due to finite precision issues.
-
-  // beta direction
+  //
+  // The beta, gamma, and delta directions point towards the flat sides of
+  // each hexagonal tile and are given by normals_. Only the oncoming side in
+  // each direction needs to be checked.
   double d {INFTY};
   array<int, 3> lattice_trans;
-  double edge = -copysign(0.5 * pitch_[0], beta_dir); // Oncoming edge
-  Position r_t;
-  if (beta_dir > 0) {
-    const array<int, 3> i_xyz_t {i_xyz[0] + 1, i_xyz[1], i_xyz[2]};
-    r_t = get_local_position(r, i_xyz_t);
-  } else {
-    const array<int, 3> i_xyz_t {i_xyz[0] - 1, i_xyz[1], i_xyz[2]};
-    r_t = get_local_position(r, i_xyz_t);
-  }
-  double beta;
-  if (orientation_ == Orientation::y) {
-    beta = r_t.x * std::sqrt(3.0) / 2.0 + r_t.y / 2.0;
-  } else {
-    beta = r_t.x;
-  }
-  if ((std::abs(beta - edge) > FP_PRECISION) && beta_dir != 0) {
-    d = (edge - beta) / beta_dir;
-    if (beta_dir > 0) {
-      lattice_trans = {1, 0, 0};
-    } else {
-      lattice_trans = {-1, 0, 0};
+  for (int k = 0; k < 3; ++k) {
+    const auto& n = normals_[k];
+    double dir = n[0] * u.x + n[1] * u.y;
+    double edge = -copysign(0.5 * pitch_[0], dir); // Oncoming edge
+
+    // Step to the neighbor across the oncoming side
+    int i0 = HEX_STEPS[k][0];
+    int i1 = HEX_STEPS[k][1];
+    if (dir <= 0) {
+      i0 = -i0;
+      i1 = -i1;
     }
-  }
+    const array<int, 3> i_xyz_t {i_xyz[0] + i0, i_xyz[1] + i1, i_xyz[2]};
+    Position r_t = get_local_position(r, i_xyz_t);
 
-  // gamma direction
-  edge = -copysign(0.5 * pitch_[0], gamma_dir);
-  if (gamma_dir > 0) {
-    const array<int, 3> i_xyz_t {i_xyz[0] + 1, i_xyz[1] - 1, i_xyz[2]};
-    r_t = get_local_position(r, i_xyz_t);
-  } else {
-    const array<int, 3> i_xyz_t {i_xyz[0] - 1, i_xyz[1] + 1, i_xyz[2]};
-    r_t = get_local_position(r, i_xyz_t);
-  }
-  double gamma;
-  if (orientation_ == Orientation::y) {
-    gamma = r_t.x * std::sqrt(3.0) / 2.0 - r_t.y / 2.0;
-  } else {
-    gamma = r_t.x / 2.0 - r_t.y * std::sqrt(3.0) / 2.0;
-  }
-  if ((std::abs(gamma - edge) > FP_PRECISION) && gamma_dir != 0) {
-    double this_d = (edge - gamma) / gamma_dir;
-    if (this_d < d) {
-      if (gamma_dir > 0) {
-        lattice_trans = {1, -1, 0};
-      } else {
-        lattice_trans = {-1, 1, 0};
-      }
-      d = this_d;
-    }
-  }
-
-  // delta direction
-  edge = -copysign(0.5 * pitch_[0], delta_dir);
-  if (delta_dir > 0) {
-    const array<int, 3> i_xyz_t {i_xyz[0], i_xyz[1] + 1, i_xyz[2]};
-    r_t = get_local_position(r, i_xyz_t);
-  } else {
-    const array<int, 3> i_xyz_t {i_xyz[0], i_xyz[1] - 1, i_xyz[2]};
-    r_t = get_local_position(r, i_xyz_t);
-  }
-  double delta;
-  if (orientation_ == Orientation::y) {
-    delta = r_t.y;
-  } else {
-    delta = r_t.x / 2.0 + r_t.y * std::sqrt(3.0) / 2.0;
-  }
-  if ((std::abs(delta - edge) > FP_PRECISION) && delta_dir != 0) {
-    double this_d = (edge - delta) / delta_dir;
-    if (this_d < d) {
-      if (delta_dir > 0) {
-        lattice_trans = {0, 1, 0};
-      } else {
-        lattice_trans = {0, -1, 0};
+    double dist = n[0] * r_t.x + n[1] * r_t.y;
+    if ((std::abs(dist - edge) > FP_PRECISION) && dir != 0) {
+      double this_d = (edge - dist) / dir;
+      if (this_d < d) {
+        d = this_d;
+        lattice_trans = {i0, i1, 0};
       }
-      d = this_d;
     }
   }
 
@@ -896,19 +844,30 @@ void HexLattice::get_indices(
     }
   }
 
+  double i0;
+  double i1;
   if (orientation_ == Orientation::y) {
     // Convert coordinates into skewed bases.  The (x, alpha) basis is used to
     // find the index of the global coordinates to within 4 cells.
     double alpha = r_o.y - r_o.x / std::sqrt(3.0);
-    result[0] = std::floor(r_o.x / (0.5 * std::sqrt(3.0) * pitch_[0]));
-    result[1] = std::floor(alpha / pitch_[0]);
+    i0 = r_o.x / (0.5 * std::sqrt(3.0) * pitch_[0]);
+    i1 = alpha / pitch_[0];
   } else {
     // Convert coordinates into skewed bases.  The (alpha, y) basis is used to
     // find the index of the global coordinates to within 4 cells.
     double alpha = r_o.y - r_o.x * std::sqrt(3.0);
-    result[0] = std::floor(-alpha / (std::sqrt(3.0) * pitch_[0]));
-    result[1] = std::floor(r_o.y / (0.5 * std::sqrt(3.0) * pitch_[0]));
+    i0 = -alpha / (std::sqrt(3.0) * pitch_[0]);
+    i1 = r_o.y / (0.5 * std::sqrt(3.0) * pitch_[0]);
   }
+  result[0] = std::floor(i0);
+  result[1] = std::floor(i1);
+
+  // The four cells form a rhombus whose short diagonal joins cells (1, 0)
+  // and (0, 1). The xyz is closest to one of the three cells at the corners
+  // of the half of the rhombus it lies in, so the farthest cell, which is at
+  // least (sqrt(3) - 1) / 2 pitches farther from it than the closest one, is
+  // not checked.
+  bool far_half = (i0 - result[0]) + (i1 - result[1]) > 1.0;
 
   // Add offset to indices (the center cell is (i1, i2) = (0, 0) but
   // the array is offset so that the indices never go below 0).
@@ -938,6 +897,9 @@ void HexLattice::get_indices(
   double dp_min {INFTY};
   for (int i = 0; i < 2; i++) {
     for (int j = 0; j < 2; j++) {
+      if ((i + j == 2 && !far_half) || (i + j == 0 && far_half))
+        continue;
+
       // get local coordinates
       const array<int, 3> i_xyz {result[0] + j, result[1] + i, 0};
       Position r_t = get_local_position(r, i_xyz);
@@ -1106,6 +1068,329 @@ void HexLattice::to_hdf5_inner(hid_t lat_group) const
   write_int(lat_group, 3, dims, "universes", out.data(), false);
 }
 
+//==============================================================================
+// SpherePackLattice implementation
+//==============================================================================
+
+SpherePackLattice::SpherePackLattice(pugi::xml_node lat_node)
+  : Lattice {lat_node}
+{
+  type_ = LatticeType::sphere_pack;
+  is_3d_ = true;
+
+  if (outer_ == NO_OUTER_UNIVERSE) {
+    fatal_error(fmt::format(
+      "Sphere pack {} must have an outer universe filling the space between "
+      "the spheres.",
+      id_));
+  }
+
+  radius_ = std::stod(get_node_value(lat_node, "radius"));
+  if (radius_ <= 0.0) {
+    fatal_error(fmt::format(
+      "Radius of the spheres in sphere pack {} must be positive.", id_));
+  }
+
+  // Read the centers of the spheres
+  auto coords = get_node_array<double>(lat_node, "centers");
+  if (coords.empty() || coords.size() % 3 != 0) {
+    fatal_error(fmt::format(
+      "Centers of the spheres in sphere pack {} must be given as a nonempty "
+      "list of (x, y, z) coordinates.",
+      id_));
+  }
+  for (int i = 0; i < coords.size(); i += 3) {
+    centers_.push_back({coords[i], coords[i + 1], coords[i + 2]});
+  }
+  int n = centers_.size();
+
+  // Read the universes filling each sphere. The outer universe fills the
+  // element for the space between the spheres.
+  std::string univ_str {get_node_value(lat_node, "universes")};
+  vector<std::string> univ_words {split(univ_str)};
+  if (univ_words.size() != n) {
+    fatal_error(fmt::format("Expected {} universes for sphere pack {} but {} "
+                            "were specified.",
+      n, id_, univ_words.size()));
+  }
+  for (const auto& word : univ_words) {
+    universes_.push_back(std::stoi(word));
+  }
+  universes_.push_back(outer_);
+
+  // Size the grid so that each sphere overlaps at most eight elements and
+  // there are no more elements than spheres
+  Position lower {INFTY, INFTY, INFTY};
+  Position upper {-INFTY, -INFTY, -INFTY};
+  for (const auto& c : centers_) {
+    for (int i = 0; i < 3; ++i) {
+      lower[i] = std::min(lower[i], c[i] - radius_);
+      upper[i] = std::max(upper[i], c[i] + radius_);
+    }
+  }
+  Position extent = upper - lower;
+  grid_width_ =
+    std::max(2.0 * radius_, std::cbrt(extent.x * extent.y * extent.z / n));
+  for (int i = 0; i < 3; ++i) {
+    grid_shape_[i] = std::max(1, static_cast<int>(extent[i] / grid_width_));
+    // Center the grid on the spheres
+    double width = grid_shape_[i] * grid_width_;
+    grid_lower_left_[i] = lower[i] - 0.5 * std::max(0.0, width - extent[i]);
+  }
+  // Make sure the grid covers all spheres
+  for (int i = 0; i < 3; ++i) {
+    while (grid_lower_left_[i] + grid_shape_[i] * grid_width_ < upper[i]) {
+      ++grid_shape_[i];
+    }
+  }
+
+  // Find the spheres overlapping each grid element
+  int n_elements = grid_shape_[0] * grid_shape_[1] * grid_shape_[2];
+  vector<vector<int>> spheres(n_elements);
+  for (int s = 0; s < n; ++s) {
+    Position r {radius_, radius_, radius_};
+    auto lo = grid_element(centers_[s] - r);
+    auto hi = grid_element(centers_[s] + r);
+    for (int k = lo[2]; k <= hi[2]; ++k) {
+      for (int j = lo[1]; j <= hi[1]; ++j) {
+        for (int i = lo[0]; i <= hi[0]; ++i) {
+          spheres[grid_flat_index({i, j, k})].push_back(s);
+        }
+      }
+    }
+  }
+  grid_offsets_.push_back(0);
+  for (const auto& v : spheres) {
+    grid_spheres_.insert(grid_spheres_.end(), v.begin(), v.end());
+    grid_offsets_.push_back(grid_spheres_.size());
+  }
+
+  // Spheres must not overlap. Two overlapping spheres share a grid element.
+  for (const auto& v : spheres) {
+    for (int a = 0; a < v.size(); ++a) {
+      for (int b = a + 1; b < v.size(); ++b) {
+        Position d = centers_[v[a]] - centers_[v[b]];
+        if (d.norm() < 2.0 * radius_ - FP_COINCIDENT) {
+          fatal_error(fmt::format(
+            "Spheres {} and {} in sphere pack {} overlap.", v[a], v[b], id_));
+        }
+      }
+    }
+  }
+}
+
+//==============================================================================
+
+const int32_t& SpherePackLattice::operator[](const array<int, 3>& i_xyz)
+{
+  return universes_[i_xyz[0]];
+}
+
+//==============================================================================
+
+bool SpherePackLattice::are_valid_indices(const array<int, 3>& i_xyz) const
+{
+  return i_xyz[0] >= 0 && i_xyz[0] <= matrix_index();
+}
+
+//==============================================================================
+
+array<int, 3> SpherePackLattice::grid_element(Position r) const
+{
+  array<int, 3> ijk;
+  for (int i = 0; i < 3; ++i) {
+    int index = std::floor((r[i] - grid_lower_left_[i]) / grid_width_);
+    ijk[i] = std::clamp(index, 0, grid_shape_[i] - 1);
+  }
+  return ijk;
+}
+
+//==============================================================================
+
+std::pair<double, array<int, 3>> SpherePackLattice::distance(
+  Position r, Direction u, const array<int, 3>& i_xyz) const
+{
+  int i = i_xyz[0];
+  if (i < matrix_index()) {
+    // Inside a sphere, with coordinates relative to its center
+    double d = sphere_distance(r, u, false, 0.0, 0.0, 0.0, radius_);
+    return {d, {matrix_index() - i, 0, 0}};
+  }
+
+  auto [d, s] = next_sphere(r, u);
+  if (s == C_NONE)
+    return {INFTY, {0, 0, 0}};
+  return {d, {s - i, 0, 0}};
+}
+
+//==============================================================================
+
+std::pair<double, int> SpherePackLattice::next_sphere(
+  Position r, Direction u) const
+{
+  // Find where the ray enters the grid
+  double t_enter = 0.0;
+  double t_leave = INFTY;
+  for (int i = 0; i < 3; ++i) {
+    double lo = grid_lower_left_[i];
+    double hi = lo + grid_shape_[i] * grid_width_;
+    if (u[i] == 0.0) {
+      if (r[i] < lo || r[i] > hi)
+        return {INFTY, C_NONE};
+    } else {
+      double t0 = (lo - r[i]) / u[i];
+      double t1 = (hi - r[i]) / u[i];
+      if (t0 > t1)
+        std::swap(t0, t1);
+      t_enter = std::max(t_enter, t0);
+      t_leave = std::min(t_leave, t1);
+    }
+  }
+  if (t_enter > t_leave)
+    return {INFTY, C_NONE};
+
+  // Walk through the grid elements along the ray until the closest sphere
+  // entered lies within the elements visited
+  auto ijk = grid_element(r + t_enter * u);
+  array<double, 3> t_next;
+  array<double, 3> t_delta;
+  array<int, 3> step;
+  for (int i = 0; i < 3; ++i) {
+    if (u[i] > 0.0) {
+      step[i] = 1;
+      t_next[i] =
+        (grid_lower_left_[i] + (ijk[i] + 1) * grid_width_ - r[i]) / u[i];
+      t_delta[i] = grid_width_ / u[i];
+    } else if (u[i] < 0.0) {
+      step[i] = -1;
+      t_next[i] = (grid_lower_left_[i] + ijk[i] * grid_width_ - r[i]) / u[i];
+      t_delta[i] = -grid_width_ / u[i];
+    } else {
+      step[i] = 0;
+      t_next[i] = INFTY;
+      t_delta[i] = INFTY;
+    }
+  }
+
+  double d_min = INFTY;
+  int s_min = C_NONE;
+  while (true) {
+    int e = grid_flat_index(ijk);
+    for (int k = grid_offsets_[e]; k < grid_offsets_[e + 1]; ++k) {
+      int s = grid_spheres_[k];
+      const auto& c = centers_[s];
+      double d = sphere_distance(r, u, false, c.x, c.y, c.z, radius_);
+      if (d < d_min) {
+        d_min = d;
+        s_min = s;
+      }
+    }
+
+    // Move to the next element along the ray
+    int axis = 0;
+    if (t_next[1] < t_next[axis])
+      axis = 1;
+    if (t_next[2] < t_next[axis])
+      axis = 2;
+    if (d_min <= t_next[axis] || t_next[axis] >= t_leave)
+      break;
+    ijk[axis] += step[axis];
+    if (ijk[axis] < 0 || ijk[axis] >= grid_shape_[axis])
+      break;
+    t_next[axis] += t_delta[axis];
+  }
+
+  return {d_min, s_min};
+}
+
+//==============================================================================
+
+void SpherePackLattice::get_indices(
+  Position r, Direction u, array<int, 3>& result) const
+{
+  result = {matrix_index(), 0, 0};
+
+  // Points outside the grid are not in any sphere
+  for (int i = 0; i < 3; ++i) {
+    double lo = grid_lower_left_[i];
+    if (r[i] < lo || r[i] > lo + grid_shape_[i] * grid_width_)
+      return;
+  }
+
+  // A point on the surface of a sphere is in it if the particle is moving
+  // towards its center
+  int e = grid_flat_index(grid_element(r));
+  for (int k = grid_offsets_[e]; k < grid_offsets_[e + 1]; ++k) {
+    int s = grid_spheres_[k];
+    Position x = r - centers_[s];
+    double f = x.dot(x) - radius_ * radius_;
+    if (f < -FP_COINCIDENT ||
+        (std::abs(f) < FP_COINCIDENT && x.dot(u) < 0.0)) {
+      result[0] = s;
+      return;
+    }
+  }
+}
+
+//==============================================================================
+
+int SpherePackLattice::get_flat_index(const array<int, 3>& i_xyz) const
+{
+  return i_xyz[0];
+}
+
+//==============================================================================
+
+Position SpherePackLattice::get_local_position(
+  Position r, const array<int, 3>& i_xyz) const
+{
+  if (i_xyz[0] < matrix_index())
+    r -= centers_[i_xyz[0]];
+  return r;
+}
+
+//==============================================================================
+
+int32_t& SpherePackLattice::offset(int map, const array<int, 3>& i_xyz)
+{
+  return offsets_[universes_.size() * map + i_xyz[0]];
+}
+
+//==============================================================================
+
+int32_t SpherePackLattice::offset(int map, int indx) const
+{
+  return offsets_[universes_.size() * map + indx];
+}
+
+//==============================================================================
+
+std::string SpherePackLattice::index_to_string(int indx) const
+{
+  return std::to_string(indx);
+}
+
+//==============================================================================
+
+void SpherePackLattice::to_hdf5_inner(hid_t lat_group) const
+{
+  write_string(lat_group, "type", "sphere_pack", false);
+  write_dataset(lat_group, "radius", radius_);
+
+  vector<double> centers;
+  for (const auto& c : centers_) {
+    centers.insert(centers.end(), {c.x, c.y, c.z});
+  }
+  hsize_t dims[2] {centers_.size(), 3};
+  write_double(lat_group, 2, dims, "centers", centers.data(), false);
+
+  vector<int> universe_ids;
+  for (int i = 0; i < matrix_index(); ++i) {
+    universe_ids.push_back(model::universes[universes_[i]]->id_);
+  }
+  write_dataset(lat_group, "universes", universe_ids);
+}
+
 //==============================================================================
 // Non-method functions
 //==============================================================================
@@ -1118,6 +1403,9 @@ void read_lattices(pugi::xml_node node)
   for (pugi::xml_node lat_node : node.children("hex_lattice")) {
     model::lattices.push_back(make_unique<HexLattice>(lat_node));
   }
+  for (pugi::xml_node lat_node : node.children("sphere_pack")) {
+    model::lattices.push_back(make_unique<SpherePackLattice>(lat_node));
+  }
 
   // Fill the lattice map.
   for (int i_lat = 0; i_lat < model::lattices.size(); i_lat++) {
@@ -5,6 +5,7 @@
 #include "openmc/constants.h"
 #include "openmc/error.h"
 #include "openmc/message_passing.h"
+#include "openmc/overlap_check.h"
 #include "openmc/particle_restart.h"
 #include "openmc/random_ray/random_ray_simulation.h"
 #include "openmc/settings.h"
@@ -53,6 +54,10 @@ int main(int argc, char* argv[])
   case RunMode::VOLUME:
     err = openmc_calculate_volumes();
     break;
+  case RunMode::OVERLAP_CHECK:
+    run_overlap_check();
+    err = 0;
+    break;
   default:
     break;
   }
@@ -27,6 +27,7 @@
 #include "openmc/simulation.h"
 #include "openmc/string_utils.h"
 #include "openmc/thermal.h"
+#include "openmc/timer.h"
 #include "openmc/xml_interface.h"
 
 namespace openmc {
@@ -39,6 +40,7 @@ namespace model {
 
 std::unordered_map<int32_t, int32_t> material_map;
 vector<unique_ptr<Material>> materials;
+int max_material_nuclides {0};
 
 } // namespace model
 
@@ -224,7 +226,7 @@ Material::Material(pugi::xml_node node)
 
     // Check that this nuclide is listed in the nuclear data library
     // (cross_sections.xml for CE and the MGXS HDF5 for MG)
-    if (settings::run_mode != RunMode::PLOTTING) {
+    if (!geometry_only()) {
       LibraryKey key {Library::Type::neutron, name};
       if (data::library_map.find(key) == data::library_map.end()) {
         fatal_error("Could not find nuclide " + name +
@@ -249,7 +251,7 @@ Material::Material(pugi::xml_node node)
       std::string element = to_element(name);
 
       // Make sure photon cross section data is available
-      if (settings::run_mode != RunMode::PLOTTING) {
+      if (!geometry_only()) {
         LibraryKey key {Library::Type::photon, element};
         if (data::library_map.find(key) == data::library_map.end()) {
           fatal_error(
@@ -328,7 +330,7 @@ Material::Material(pugi::xml_node node)
 
       // Check that the thermal scattering table is listed in the
       // cross_sections.xml file
-      if (settings::run_mode != RunMode::PLOTTING) {
+      if (!geometry_only()) {
         LibraryKey key {Library::Type::thermal, name};
         if (data::library_map.find(key) == data::library_map.end()) {
           fatal_error("Could not find thermal scattering data " + name +
@@ -791,6 +793,19 @@ void Material::init_bremsstrahlung()
       ttb->yield(j) = c;
     }
 
+    // Build guide tables so that the photon energy bin is found without
+    // searching from the start of each CDF
+    if (settings::guide_table_cells > 0) {
+      ttb->guide.resize(n_e);
+      for (int j = 1; j < n_e; ++j) {
+        vector<double> cdf(j + 1);
+        for (int i = 0; i <= j; ++i) {
+          cdf[i] = ttb->cdf(j, i) / ttb->cdf(j, j);
+        }
+        ttb->guide[j] = GuideTable(cdf, settings::guide_table_cells);
+      }
+    }
+
     // Use logarithm of number yield since it is log-log interpolated
     ttb->yield = xt::where(ttb->yield > 0.0, xt::log(ttb->yield), -500.0);
   }
@@ -824,9 +839,7 @@ void Material::calculate_xs(Particle& p) const
 void Material::calculate_neutron_xs(Particle& p) const
 {
   // Find energy index on energy grid
-  int neutron = static_cast<int>(ParticleType::neutron);
-  int i_grid =
-    std::log(p.E() / data::energy_min[neutron]) / simulation::log_spacing;
+  int i_grid = energy_search_index(p.E());
 
   // Determine if this material has S(a,b) tables
   bool check_sab = (thermal_tables_.size() > 0);
@@ -840,6 +853,57 @@ void Material::calculate_neutron_xs(Particle& p) const
     ncrystal_xs = ncrystal_mat_.xs(p);
   }
 
+  // If the compact microscopic cross section cache is used, its slots map to
+  // the nuclides of this material
+  p.set_neutron_xs_slots(mat_nuclide_index_.data());
+
+  // Running sum of the total cross section for sampling the collision nuclide
+  auto& cdf = p.macro_total_cdf();
+  cdf.resize(nuclide_.size());
+
+  // With vectorized lookups, nuclides that only need plain interpolation are
+  // deferred and evaluated in chunks from the packed cross section tables.
+  // Temperatures are still selected in nuclide order so that the random
+  // number stream matches the scalar path.
+  bool vectorize = settings::vectorized_xs && ncrystal_xs < 0.0;
+  constexpr int n_chunk = 32;
+  int n_packed = 0;
+  int packed_nuclide[n_chunk];
+  int64_t packed_index[n_chunk];
+  double packed_f[n_chunk];
+
+  auto evaluate_packed = [&]() {
+    double total[n_chunk];
+    double absorption[n_chunk];
+    double fission[n_chunk];
+    double nu_fission[n_chunk];
+    double photon_prod[n_chunk];
+    interpolate_packed_xs(n_packed, packed_index, packed_f, total, absorption,
+      fission, nu_fission, photon_prod);
+
+    for (int k = 0; k < n_packed; ++k) {
+      auto& micro = p.neutron_xs(packed_nuclide[k]);
+      micro.total = total[k];
+      micro.absorption = absorption[k];
+      micro.fission = fission[k];
+      micro.nu_fission = nu_fission[k];
+      micro.photon_prod = photon_prod[k];
+      micro.elastic = CACHE_INVALID;
+      micro.thermal = 0.0;
+      micro.thermal_elastic = 0.0;
+      if (simulation::need_depletion_rx) {
+        data::nuclides[packed_nuclide[k]]->calculate_depletion_xs(
+          micro.index_temp, micro.index_grid, micro.interp_factor, micro);
+      }
+      micro.index_sab = C_NONE;
+      micro.sab_frac = 0.0;
+      micro.use_ptable = false;
+      micro.last_E = p.E();
+      micro.last_sqrtkT = p.sqrtkT();
+    }
+    n_packed = 0;
+  };
+
   // Add contribution from each nuclide in material
   for (int i = 0; i < nuclide_.size(); ++i) {
     // ======================================================================
@@ -877,6 +941,36 @@ void Material::calculate_neutron_xs(Particle& p) const
     // Get nuclide index
     int i_nuclide = nuclide_[i];
 
+    if (vectorize) {
+      auto& micro = p.neutron_xs(i_nuclide);
+      const auto& nuc {*data::nuclides[i_nuclide]};
+      bool cached = p.E() == micro.last_E &&
+                    p.sqrtkT() == micro.last_sqrtkT &&
+                    i_sab == micro.index_sab && sab_frac == micro.sab_frac;
+      if (!cached && i_sab == C_NONE && nuc.use_packed_xs(p.E())) {
+        // Determine grid index and interpolation factor now and defer the
+        // interpolation itself
+        int i_temp = nuc.temperature_index(p);
+        int i_nuc_grid = nuc.energy_grid_index(i_temp, i_grid, p.E());
+        const auto& energy {nuc.grid_[i_temp].energy};
+        micro.index_temp = i_temp;
+        micro.index_grid = i_nuc_grid;
+        micro.interp_factor = (p.E() - energy[i_nuc_grid]) /
+                              (energy[i_nuc_grid + 1] - energy[i_nuc_grid]);
+
+        packed_nuclide[n_packed] = i_nuclide;
+        packed_index[n_packed] = nuc.packed_offset_[i_temp] + i_nuc_grid;
+        packed_f[n_packed] = micro.interp_factor;
+        if (++n_packed == n_chunk)
+          evaluate_packed();
+      } else {
+        p.update_neutron_xs(i_nuclide, i_grid, i_sab, sab_frac, ncrystal_xs);
+      }
+
+      // Contributions are added once all deferred lookups are evaluated
+      continue;
+    }
+
     // Update microscopic cross section for this nuclide
     p.update_neutron_xs(i_nuclide, i_grid, i_sab, sab_frac, ncrystal_xs);
     auto& micro = p.neutron_xs(i_nuclide);
@@ -892,16 +986,157 @@ void Material::calculate_neutron_xs(Particle& p) const
     p.macro_xs().absorption += atom_density * micro.absorption;
     p.macro_xs().fission += atom_density * micro.fission;
     p.macro_xs().nu_fission += atom_density * micro.nu_fission;
+    cdf[i] = p.macro_xs().total;
+  }
+
+  if (vectorize) {
+    evaluate_packed();
+
+    // Add contributions in nuclide order, as in the scalar path
+    for (int i = 0; i < nuclide_.size(); ++i) {
+      const auto& micro = p.neutron_xs(nuclide_[i]);
+      double atom_density = atom_density_(i);
+      p.macro_xs().total += atom_density * micro.total;
+      p.macro_xs().absorption += atom_density * micro.absorption;
+      p.macro_xs().fission += atom_density * micro.fission;
+      p.macro_xs().nu_fission += atom_density * micro.nu_fission;
+      cdf[i] = p.macro_xs().total;
+    }
+  }
+}
+
+void Material::calculate_neutron_xs_batch(gsl::span<Particle*> particles) const
+{
+  // NCrystal and vectorized lookups work on one particle at a time
+  if (ncrystal_mat_ || settings::vectorized_xs) {
+    for (Particle* p : particles) {
+      this->calculate_xs(*p);
+    }
+    return;
+  }
+
+  // Set all material macroscopic cross sections to zero and find each
+  // particle's index on the energy grid
+  int n = particles.size();
+  vector<int> i_grid(n);
+  for (int k = 0; k < n; ++k) {
+    Particle& p = *particles[k];
+    p.macro_xs().total = 0.0;
+    p.macro_xs().absorption = 0.0;
+    p.macro_xs().fission = 0.0;
+    p.macro_xs().nu_fission = 0.0;
+    p.set_neutron_xs_slots(mat_nuclide_index_.data());
+    p.macro_total_cdf().resize(nuclide_.size());
+    i_grid[k] = energy_search_index(p.E());
+  }
+
+  // S(a,b) table of each particle for the current nuclide and the particles
+  // whose cross sections are evaluated from multipole data
+  vector<int> i_sab(n);
+  vector<double> sab_frac(n);
+  vector<Particle*> mp_particles;
+  vector<int> mp_sab;
+  vector<double> mp_sab_frac;
+
+  // Initialize position in i_sab_nuclides
+  int j = 0;
+
+  for (int i = 0; i < nuclide_.size(); ++i) {
+    // Check if this nuclide matches one of the S(a,b) tables specified.
+    // This relies on thermal_tables_ being sorted by .index_nuclide
+    const ThermalTable* sab = nullptr;
+    if (j < thermal_tables_.size() && thermal_tables_[j].index_nuclide == i) {
+      sab = &thermal_tables_[j];
+      ++j;
+    }
+
+    int i_nuclide = nuclide_[i];
+    double atom_density = atom_density_(i);
+
+    // If particle energy is greater than the highest energy for the S(a,b)
+    // table, then don't use the S(a,b) table
+    for (int k = 0; k < n; ++k) {
+      i_sab[k] = C_NONE;
+      sab_frac[k] = 0.0;
+      if (sab) {
+        i_sab[k] = sab->index_table;
+        sab_frac[k] = sab->fraction;
+        if (particles[k]->E() > data::thermal_scatt[i_sab[k]]->energy_max_)
+          i_sab[k] = C_NONE;
+      }
+    }
+
+    // Evaluate multipole data for all neutrons in its range at once. Their
+    // cached cross sections are then current below.
+    auto& nuc {*data::nuclides[i_nuclide]};
+    if (nuc.multipole_) {
+      mp_particles.clear();
+      mp_sab.clear();
+      mp_sab_frac.clear();
+      for (int k = 0; k < n; ++k) {
+        Particle& p = *particles[k];
+        const auto& micro = p.neutron_xs(i_nuclide);
+        if (multipole_in_range(nuc, p.E()) &&
+            (p.E() != micro.last_E || p.sqrtkT() != micro.last_sqrtkT ||
+              i_sab[k] != micro.index_sab || sab_frac[k] != micro.sab_frac)) {
+          mp_particles.push_back(&p);
+          mp_sab.push_back(i_sab[k]);
+          mp_sab_frac.push_back(sab_frac[k]);
+        }
+      }
+      if (!mp_particles.empty()) {
+        nuc.calculate_multipole_xs(
+          mp_particles, mp_sab.data(), mp_sab_frac.data());
+      }
+    }
+
+    for (int k = 0; k < n; ++k) {
+      Particle& p = *particles[k];
+
+      // Update microscopic cross section and add contribution to
+      // macroscopic cross sections
+      p.update_neutron_xs(i_nuclide, i_grid[k], i_sab[k], sab_frac[k]);
+      const auto& micro = p.neutron_xs(i_nuclide);
+      p.macro_xs().total += atom_density * micro.total;
+      p.macro_xs().absorption += atom_density * micro.absorption;
+      p.macro_xs().fission += atom_density * micro.fission;
+      p.macro_xs().nu_fission += atom_density * micro.nu_fission;
+      p.macro_total_cdf()[i] = p.macro_xs().total;
+    }
   }
 }
 
 void Material::calculate_photon_xs(Particle& p) const
 {
+  // The cross sections of each element are only evaluated when a collision
+  // is sampled, unless tallies of specific nuclides need them
+  double xs[4];
+  if (!simulation::need_element_photon_xs &&
+      photon_xs_table_.interpolate(std::log(p.E()), xs)) {
+    p.macro_xs().coherent = xs[0];
+    p.macro_xs().incoherent = xs[1];
+    p.macro_xs().photoelectric = xs[2];
+    p.macro_xs().pair_production = xs[3];
+    p.macro_xs().total = xs[0] + xs[1] + xs[2] + xs[3];
+    p.macro_total_cdf().clear();
+    return;
+  }
+
+  this->calculate_element_photon_xs(p);
+}
+
+void Material::calculate_element_photon_xs(Particle& p) const
+{
+  p.macro_xs().total = 0.0;
   p.macro_xs().coherent = 0.0;
   p.macro_xs().incoherent = 0.0;
   p.macro_xs().photoelectric = 0.0;
   p.macro_xs().pair_production = 0.0;
 
+  // Running sum of the total cross section for sampling the collision element
+  auto& cdf = p.macro_total_cdf();
+  cdf.resize(nuclide_.size());
+
   // Add contribution from each nuclide in material
   for (int i = 0; i < nuclide_.size(); ++i) {
     // ========================================================================
@@ -928,9 +1163,48 @@ void Material::calculate_photon_xs(Particle& p) const
     p.macro_xs().incoherent += atom_density * micro.incoherent;
     p.macro_xs().photoelectric += atom_density * micro.photoelectric;
     p.macro_xs().pair_production += atom_density * micro.pair_production;
+    cdf[i] = p.macro_xs().total;
   }
 }
 
+void Material::init_photon_xs_table()
+{
+  photon_xs_table_ = {};
+  if (element_.empty())
+    return;
+
+  // The table covers the energies where every element has data
+  double log_E_min = -INFTY;
+  double log_E_max = INFTY;
+  vector<double> edges;
+  vector<double> kinks;
+  for (int i_element : element_) {
+    const auto& elm = *data::elements[i_element];
+    const auto& energy = elm.energy_;
+    log_E_min = std::max(log_E_min, energy(0));
+    log_E_max = std::min(log_E_max, energy(energy.size() - 1));
+    auto e = elm.edges();
+    edges.insert(edges.end(), e.begin(), e.end());
+    kinks.insert(kinks.end(), energy.begin(), energy.end());
+  }
+  if (log_E_max <= log_E_min)
+    return;
+  std::sort(kinks.begin(), kinks.end());
+  kinks.erase(std::unique(kinks.begin(), kinks.end()), kinks.end());
+
+  photon_xs_table_ = PhotonXSTable(log_E_min, log_E_max, edges, kinks,
+    settings::photon_xs_tolerance, [this](double log_E, double* xs) {
+      std::fill(xs, xs + 4, 0.0);
+      for (int i = 0; i < element_.size(); ++i) {
+        double micro[4];
+        data::elements[element_[i]]->interpolate_xs(log_E, micro);
+        for (int k = 0; k < 4; ++k) {
+          xs[k] += atom_density_(i) * micro[k];
+        }
+      }
+    });
+}
+
 void Material::set_id(int32_t id)
 {
   Expects(id >= 0 || id == C_NONE);
@@ -979,6 +1253,7 @@ void Material::set_density(double density, gsl::cstring_span units)
 
     // Recalculate nuclide atom densities based on given density
     atom_density_ *= density;
+    photon_xs_table_.scale(density / sum_percent);
 
     // Calculate density in g/cm^3.
     density_gpcc_ = 0.0;
@@ -996,6 +1271,7 @@ void Material::set_density(double density, gsl::cstring_span units)
     density_gpcc_ = density;
     density_ *= f;
     atom_density_ *= f;
+    photon_xs_table_.scale(f);
   } else {
     throw std::invalid_argument {
       "Invalid units '" + std::string(units.data()) + "' specified."};
@@ -1047,6 +1323,10 @@ void Material::set_densities(
 
   // Assign S(a,b) tables
   this->init_thermal();
+
+  // Tabulate photon cross sections for the new composition
+  if (settings::photon_transport && settings::photon_material_xs)
+    this->init_photon_xs_table();
 }
 
 double Material::volume() const
@@ -1332,10 +1612,14 @@ void read_materials_xml()
 
 void read_materials_xml(pugi::xml_node root)
 {
+  // Materials are created serially since they add their nuclides to the
+  // global nuclide map, whose order determines the nuclide indices
+  simulation::time_read_materials.start();
   for (pugi::xml_node material_node : root.children("material")) {
     model::materials.push_back(make_unique<Material>(material_node));
   }
   model::materials.shrink_to_fit();
+  simulation::time_read_materials.stop();
 }
 
 void free_memory_material()
@@ -647,78 +647,74 @@ void calc_rn(int n, Direction u, double rn[])
 
 void calc_zn(int n, double rho, double phi, double zn[])
 {
+  // The moments are ordered (0,0), (1,-1), (1,1), (2,-2), (2,0), (2, 2), ....
+  // in (p,q) indices. They are computed one azimuthal order q at a time so
+  // that the radial polynomials R_pq(rho) of the recurrence are kept in a few
+  // scalars instead of a matrix.
+  auto index = [](int p, int q) { return p * (p + 1) / 2 + (q + p) / 2; };
+
   // ===========================================================================
-  // Determine vector of sin(n*phi) and cos(n*phi). This takes advantage of the
+  // Determine sin(q*phi) and cos(q*phi). This takes advantage of the
   // following recurrence relations so that only a single sin/cos have to be
   // evaluated (http://mathworld.wolfram.com/Multiple-AngleFormulas.html)
   //
   // sin(nx) = 2 cos(x) sin((n-1)x) - sin((n-2)x)
   // cos(nx) = 2 cos(x) cos((n-1)x) - cos((n-2)x)
+  //
+  // The recurrence for the sines is applied to sin(nx) / sin(x).
 
   double sin_phi = std::sin(phi);
   double cos_phi = std::cos(phi);
 
-  vector<double> sin_phi_vec(n + 1); // Sin[n * phi]
-  vector<double> cos_phi_vec(n + 1); // Cos[n * phi]
-  sin_phi_vec[0] = 1.0;
-  cos_phi_vec[0] = 1.0;
-  sin_phi_vec[1] = 2.0 * cos_phi;
-  cos_phi_vec[1] = cos_phi;
-
-  for (int i = 2; i <= n; i++) {
-    sin_phi_vec[i] = 2. * cos_phi * sin_phi_vec[i - 1] - sin_phi_vec[i - 2];
-    cos_phi_vec[i] = 2. * cos_phi * cos_phi_vec[i - 1] - cos_phi_vec[i - 2];
-  }
-
-  for (int i = 0; i <= n; i++) {
-    sin_phi_vec[i] *= sin_phi;
-  }
-
-  // ===========================================================================
-  // Calculate R_pq(rho)
-  // Matrix forms of the coefficients which are easier to work with
-  vector<vector<double>> zn_mat(n + 1, vector<double>(n + 1));
-
-  // Fill the main diagonal first (Eq 3.9 in Chong)
-  for (int p = 0; p <= n; p++) {
-    zn_mat[p][p] = std::pow(rho, p);
-  }
-
-  // Fill the 2nd diagonal (Eq 3.10 in Chong)
-  for (int q = 0; q <= n - 2; q++) {
-    zn_mat[q][q + 2] = (q + 2) * zn_mat[q + 2][q + 2] - (q + 1) * zn_mat[q][q];
-  }
-
-  // Fill in the rest of the values using the original results (Eq. 3.8 in
-  // Chong)
-  for (int p = 4; p <= n; p++) {
-    double k2 = 2 * p * (p - 1) * (p - 2);
-    for (int q = p - 4; q >= 0; q -= 2) {
-      double k1 = ((p + q) * (p - q) * (p - 2)) / 2.;
-      double k3 = -q * q * (p - 1) - p * (p - 1) * (p - 2);
-      double k4 = (-p * (p + q - 2) * (p - q - 2)) / 2.;
-      zn_mat[q][p] =
-        ((k2 * rho * rho + k3) * zn_mat[q][p - 2] + k4 * zn_mat[q][p - 4]) / k1;
+  double cos_q = 1.0;    // cos(q*phi)
+  double cos_last = 1.0; // cos((q-1)*phi)
+  double u_q = 0.0;      // sin(q*phi) / sin(phi)
+  double u_last = 0.0;   // sin((q-1)*phi) / sin(phi)
+
+  for (int q = 0; q <= n; q++) {
+    if (q == 1) {
+      cos_last = cos_q;
+      cos_q = cos_phi;
+      u_q = 1.0;
+    } else if (q > 1) {
+      double c = 2. * cos_phi * cos_q - cos_last;
+      cos_last = cos_q;
+      cos_q = c;
+      double u = 2. * cos_phi * u_q - u_last;
+      u_last = u_q;
+      u_q = u;
     }
-  }
+    double sin_q = u_q * sin_phi;
+
+    // =========================================================================
+    // Calculate R_pq(rho) for p = q, q + 2, ..., n
+    double r_last2 = 0.0; // R_(p-2)q
+    double r_last4 = 0.0; // R_(p-4)q
+    for (int p = q; p <= n; p += 2) {
+      double r;
+      if (p == q) {
+        // Main diagonal (Eq 3.9 in Chong)
+        r = std::pow(rho, p);
+      } else if (p == q + 2) {
+        // 2nd diagonal (Eq 3.10 in Chong)
+        r = (q + 2) * std::pow(rho, p) - (q + 1) * r_last2;
+      } else {
+        // Rest of the values using the original results (Eq. 3.8 in Chong)
+        double k1 = ((p + q) * (p - q) * (p - 2)) / 2.;
+        double k2 = 2 * p * (p - 1) * (p - 2);
+        double k3 = -q * q * (p - 1) - p * (p - 1) * (p - 2);
+        double k4 = (-p * (p + q - 2) * (p - q - 2)) / 2.;
+        r = ((k2 * rho * rho + k3) * r_last2 + k4 * r_last4) / k1;
+      }
+      r_last4 = r_last2;
+      r_last2 = r;
 
-  // Roll into a single vector for easier computation later
-  // The vector is ordered (0,0), (1,-1), (1,1), (2,-2), (2,0),
-  // (2, 2), ....   in (n,m) indices
-  // Note that the cos and sin vectors are offset by one
-  // sin_phi_vec = [sin(x), sin(2x), sin(3x) ...]
-  // cos_phi_vec = [1.0, cos(x), cos(2x)... ]
-  int i = 0;
-  for (int p = 0; p <= n; p++) {
-    for (int q = -p; q <= p; q += 2) {
-      if (q < 0) {
-        zn[i] = zn_mat[std::abs(q)][p] * sin_phi_vec[std::abs(q) - 1];
-      } else if (q == 0) {
-        zn[i] = zn_mat[q][p];
+      if (q == 0) {
+        zn[index(p, 0)] = r;
       } else {
-        zn[i] = zn_mat[q][p] * cos_phi_vec[q];
+        zn[index(p, -q)] = r * sin_q;
+        zn[index(p, q)] = r * cos_q;
       }
-      i++;
     }
   }
 }
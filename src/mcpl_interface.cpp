@@ -11,6 +11,9 @@
 
 #include <fmt/core.h>
 
+#include <algorithm> // for min
+#include <cstdio>    // for remove
+
 #ifdef OPENMC_MCPL
 #include <mcpl.h>
 #endif
@@ -70,24 +73,38 @@ SourceSite mcpl_particle_to_site(const mcpl_particle_t* particle)
 
 //==============================================================================
 
-vector<SourceSite> mcpl_source_sites(std::string path)
+vector<SourceSite> mcpl_source_sites(std::string path, bool partitioned)
 {
   vector<SourceSite> sites;
 
 #ifdef OPENMC_MCPL
   // Open MCPL file and determine number of particles
   auto mcpl_file = mcpl_open_file(path.c_str());
-  size_t n_sites = mcpl_hdr_nparticles(mcpl_file);
+  uint64_t n_particles = mcpl_hdr_nparticles(mcpl_file);
+
+  // When partitioned, this process only reads its own contiguous part of the
+  // file. The first n_particles % n_procs processes read one more particle.
+  uint64_t first = 0;
+  uint64_t n_read = n_particles;
+  if (partitioned) {
+    uint64_t rank = mpi::rank;
+    uint64_t n_min = n_particles / mpi::n_procs;
+    uint64_t n_extra = n_particles % mpi::n_procs;
+    n_read = n_min + (rank < n_extra ? 1 : 0);
+    first = rank * n_min + std::min(rank, n_extra);
+    mcpl_seek(mcpl_file, first);
+  }
+  sites.reserve(n_read);
 
-  for (int i = 0; i < n_sites; i++) {
+  for (uint64_t i = 0; i < n_read; i++) {
     // Extract particle from mcpl-file, checking if it is a neutron, photon,
     // electron, or positron. Otherwise skip.
-    const mcpl_particle_t* particle;
-    int pdg = 0;
-    while (pdg != 2112 && pdg != 22 && pdg != 11 && pdg != -11) {
-      particle = mcpl_read(mcpl_file);
-      pdg = particle->pdgcode;
-    }
+    const mcpl_particle_t* particle = mcpl_read(mcpl_file);
+    if (!particle)
+      break;
+    int pdg = particle->pdgcode;
+    if (pdg != 2112 && pdg != 22 && pdg != 11 && pdg != -11)
+      continue;
 
     // Convert to source site and add to vector
     sites.push_back(mcpl_particle_to_site(particle));
@@ -95,8 +112,9 @@ vector<SourceSite> mcpl_source_sites(std::string path)
 
   // Check that some sites were read
   if (sites.empty()) {
-    fatal_error("MCPL file contained no neutron, photon, electron, or positron "
-                "source particles.");
+    fatal_error(fmt::format("MCPL file contained no neutron, photon, electron, "
+                            "or positron source particles{}.",
+      partitioned ? " in the part read by this process" : ""));
   }
 
   mcpl_close_file(mcpl_file);
@@ -111,79 +129,72 @@ vector<SourceSite> mcpl_source_sites(std::string path)
 //==============================================================================
 
 #ifdef OPENMC_MCPL
-void write_mcpl_source_bank(mcpl_outfile_t file_id,
-  gsl::span<SourceSite> source_bank, const vector<int64_t>& bank_index)
+namespace {
+
+//! MCPL file that source sites are appended to
+mcpl_outfile_t appended_file;
+
+//! Create an MCPL file with the name of this version of OpenMC as its source
+mcpl_outfile_t create_mcpl_file(const std::string& filename)
 {
-  int64_t dims_size = settings::n_particles;
-  int64_t count_size = simulation::work_per_rank;
+  mcpl_outfile_t file_id = mcpl_create_outfile(filename.c_str());
+  std::string line;
+  if (VERSION_DEV) {
+    line = fmt::format("OpenMC {0}.{1}.{2}-development", VERSION_MAJOR,
+      VERSION_MINOR, VERSION_RELEASE);
+  } else {
+    line = fmt::format(
+      "OpenMC {0}.{1}.{2}", VERSION_MAJOR, VERSION_MINOR, VERSION_RELEASE);
+  }
+  mcpl_hdr_set_srcname(file_id, line.c_str());
+  return file_id;
+}
 
-  if (mpi::master) {
-    // Particles are writeen to disk from the master node only
+//! Write one source site to an MCPL file
+void write_mcpl_site(mcpl_outfile_t file_id, const SourceSite& site)
+{
+  mcpl_particle_t p;
+  p.position[0] = site.r.x;
+  p.position[1] = site.r.y;
+  p.position[2] = site.r.z;
 
-    // Save source bank sites since the array is overwritten below
-#ifdef OPENMC_MPI
-    vector<SourceSite> temp_source {source_bank.begin(), source_bank.end()};
-#endif
+  // mcpl requires that the direction vector is unit length
+  // which is also the case in openmc
+  p.direction[0] = site.u.x;
+  p.direction[1] = site.u.y;
+  p.direction[2] = site.u.z;
 
-    // loop over the other nodes and receive data - then write those.
-    for (int i = 0; i < mpi::n_procs; ++i) {
-      // number of particles for node node i
-      size_t count[] {static_cast<size_t>(bank_index[i + 1] - bank_index[i])};
+  // MCPL stores kinetic energy in [MeV], time in [ms]
+  p.ekin = site.E * 1e-6;
+  p.time = site.time * 1e3;
+  p.weight = site.wgt;
 
-#ifdef OPENMC_MPI
-      if (i > 0)
-        MPI_Recv(source_bank.data(), count[0], mpi::source_site, i, i,
-          mpi::intracomm, MPI_STATUS_IGNORE);
-#endif
-      // now write the source_bank data again.
-      for (const auto& site : source_bank) {
-        // particle is now at the iterator
-        // write it to the mcpl-file
-        mcpl_particle_t p;
-        p.position[0] = site.r.x;
-        p.position[1] = site.r.y;
-        p.position[2] = site.r.z;
-
-        // mcpl requires that the direction vector is unit length
-        // which is also the case in openmc
-        p.direction[0] = site.u.x;
-        p.direction[1] = site.u.y;
-        p.direction[2] = site.u.z;
-
-        // MCPL stores kinetic energy in [MeV], time in [ms]
-        p.ekin = site.E * 1e-6;
-        p.time = site.time * 1e3;
-        p.weight = site.wgt;
-
-        switch (site.particle) {
-        case ParticleType::neutron:
-          p.pdgcode = 2112;
-          break;
-        case ParticleType::photon:
-          p.pdgcode = 22;
-          break;
-        case ParticleType::electron:
-          p.pdgcode = 11;
-          break;
-        case ParticleType::positron:
-          p.pdgcode = -11;
-          break;
-        }
-
-        mcpl_add_particle(file_id, &p);
-      }
-    }
-#ifdef OPENMC_MPI
-    // Restore state of source bank
-    std::copy(temp_source.begin(), temp_source.end(), source_bank.begin());
-#endif
-  } else {
-#ifdef OPENMC_MPI
-    MPI_Send(source_bank.data(), count_size, mpi::source_site, 0, mpi::rank,
-      mpi::intracomm);
-#endif
+  switch (site.particle) {
+  case ParticleType::neutron:
+    p.pdgcode = 2112;
+    break;
+  case ParticleType::photon:
+    p.pdgcode = 22;
+    break;
+  case ParticleType::electron:
+    p.pdgcode = 11;
+    break;
+  case ParticleType::positron:
+    p.pdgcode = -11;
+    break;
   }
+
+  mcpl_add_particle(file_id, &p);
+}
+
+//! Name of the file that one process writes its part of an MCPL file to
+std::string mcpl_part_filename(const std::string& filename, int rank)
+{
+  auto stem = filename.substr(0, filename.rfind('.'));
+  return fmt::format("{}_p{}.mcpl", stem, rank);
 }
+
+} // namespace
 #endif
 
 //==============================================================================
@@ -201,27 +212,74 @@ void write_mcpl_source_point(const char* filename,
   }
 
 #ifdef OPENMC_MCPL
-  mcpl_outfile_t file_id;
-
-  std::string line;
-  if (mpi::master) {
-    file_id = mcpl_create_outfile(filename_.c_str());
-    if (VERSION_DEV) {
-      line = fmt::format("OpenMC {0}.{1}.{2}-development", VERSION_MAJOR,
-        VERSION_MINOR, VERSION_RELEASE);
-    } else {
-      line = fmt::format(
-        "OpenMC {0}.{1}.{2}", VERSION_MAJOR, VERSION_MINOR, VERSION_RELEASE);
+  if (mpi::n_procs == 1) {
+    mcpl_outfile_t file_id = create_mcpl_file(filename_);
+    for (const auto& site : source_bank) {
+      write_mcpl_site(file_id, site);
     }
-    mcpl_hdr_set_srcname(file_id, line.c_str());
+    mcpl_close_outfile(file_id);
+    return;
+  }
+
+  // Each process converts and writes its own sites at the same time instead
+  // of sending them to the master process
+  auto part = mcpl_part_filename(filename_, mpi::rank);
+  mcpl_outfile_t part_id = create_mcpl_file(part);
+  for (const auto& site : source_bank) {
+    write_mcpl_site(part_id, site);
   }
+  mcpl_close_outfile(part_id);
 
-  write_mcpl_source_bank(file_id, source_bank, bank_index);
+#ifdef OPENMC_MPI
+  MPI_Barrier(mpi::intracomm);
+#endif
 
+  // The parts are then joined in the order of the processes, which only
+  // copies the particle records
   if (mpi::master) {
+    vector<std::string> parts;
+    for (int i = 0; i < mpi::n_procs; ++i) {
+      parts.push_back(mcpl_part_filename(filename_, i));
+    }
+    vector<const char*> part_names;
+    for (const auto& p : parts) {
+      part_names.push_back(p.c_str());
+    }
+    mcpl_outfile_t file_id =
+      mcpl_merge_files(filename_.c_str(), part_names.size(), part_names.data());
     mcpl_close_outfile(file_id);
+    for (const auto& p : parts) {
+      std::remove(p.c_str());
+    }
+  }
+#endif
+}
+
+//==============================================================================
+
+void open_mcpl_appended_file(const std::string& filename)
+{
+#ifdef OPENMC_MCPL
+  appended_file = create_mcpl_file(filename);
+#else
+  fatal_error("Your build of OpenMC does not support writing MCPL files.");
+#endif
+}
+
+void append_mcpl_source_sites(gsl::span<const SourceSite> sites)
+{
+#ifdef OPENMC_MCPL
+  for (const auto& site : sites) {
+    write_mcpl_site(appended_file, site);
   }
 #endif
 }
 
+void close_mcpl_appended_file()
+{
+#ifdef OPENMC_MCPL
+  mcpl_close_outfile(appended_file);
+#endif
+}
+
 } // namespace openmc
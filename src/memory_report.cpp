@@ -0,0 +1,256 @@
+#include "openmc/memory_report.h"
+
+#include <algorithm> // for min, sort
+#include <cstdio>
+#include <utility> // for pair
+
+#include <fmt/core.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h> // for getrusage
+#include <unistd.h>       // for sysconf
+#endif
+
+#include "openmc/bank.h"
+#include "openmc/cell.h"
+#include "openmc/event.h"
+#include "openmc/lattice.h"
+#include "openmc/material.h"
+#include "openmc/mesh.h"
+#include "openmc/message_passing.h"
+#include "openmc/nuclide.h"
+#include "openmc/openmp_interface.h"
+#include "openmc/output.h"
+#include "openmc/particle.h"
+#include "openmc/photon.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+#include "openmc/tallies/tally.h"
+#include "openmc/weight_windows.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace data {
+
+double nuclear_data_memory {0.0};
+
+} // namespace data
+
+namespace {
+
+//! Subsystems in the order they are reported
+const vector<std::string> CATEGORIES {"Nuclear data", "Tallies", "Meshes",
+  "Particles", "Banks", "Geometry", "Weight windows", "Random ray"};
+
+//! Number of objects listed for the categories broken down by object
+constexpr int N_LARGEST {5};
+
+} // namespace
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+double resident_memory()
+{
+#ifdef __linux__
+  // The second field is the number of resident pages
+  std::FILE* fh = std::fopen("/proc/self/statm", "r");
+  if (!fh)
+    return 0.0;
+  long size, resident;
+  int n = std::fscanf(fh, "%ld %ld", &size, &resident);
+  std::fclose(fh);
+  if (n != 2)
+    return 0.0;
+  return static_cast<double>(resident) * sysconf(_SC_PAGESIZE) / 1.0e6;
+#else
+  return 0.0;
+#endif
+}
+
+double max_resident_memory()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0.0;
+#ifdef __APPLE__
+  // Reported in bytes on macOS and in kilobytes elsewhere
+  return usage.ru_maxrss / 1.0e6;
+#else
+  return usage.ru_maxrss * 1024.0 / 1.0e6;
+#endif
+#else
+  return 0.0;
+#endif
+}
+
+vector<MemoryUse> memory_usage()
+{
+  vector<MemoryUse> items;
+
+  // Cross sections are read into many small objects, so their size is taken
+  // from the growth of the process while they were read
+  items.push_back(
+    {"Nuclear data", "Cross sections", data::nuclear_data_memory});
+
+  for (const auto& t : model::tallies) {
+    items.push_back({"Tallies", fmt::format("Tally {}", t->id_), t->memory()});
+  }
+  for (const auto& m : model::meshes) {
+    items.push_back({"Meshes", fmt::format("Mesh {}", m->id_), m->memory()});
+  }
+
+  // Particles in flight, each with its own microscopic cross section caches.
+  // Particles of history-based transport and of private event-based pools
+  // live on the stack of each thread, one pool per thread.
+  int64_t n_particles = num_threads();
+  if (settings::event_based && settings::event_thread_pool == 0) {
+    n_particles = simulation::particles.size();
+  } else if (settings::event_based) {
+    n_particles *=
+      std::min(simulation::work_per_rank, settings::event_thread_pool);
+  }
+  int64_t n_neutron_xs = 0;
+  if (!settings::photon_only) {
+    n_neutron_xs = settings::compact_micro_xs ? model::max_material_nuclides + 1
+                                              : data::nuclides.size();
+  }
+  double particle_size = sizeof(Particle) +
+                         n_neutron_xs * sizeof(NuclideMicroXS) +
+                         data::elements.size() * sizeof(ElementMicroXS);
+  items.push_back(
+    {"Particles", "Particles", n_particles * particle_size / 1.0e6});
+
+  int64_t n_queued = simulation::advance_particle_queue.capacity() +
+                     simulation::surface_crossing_queue.capacity() +
+                     simulation::collision_queue.capacity();
+  for (auto& queue : simulation::calculate_xs_queues) {
+    n_queued += queue.capacity();
+  }
+  items.push_back(
+    {"Particles", "Event queues", n_queued * sizeof(EventQueueItem) / 1.0e6});
+  items.push_back({"Particles", "Secondary queue",
+    simulation::secondary_queue.capacity() * sizeof(SecondaryQueueItem) /
+      1.0e6});
+
+  items.push_back(
+    {"Banks", "Source bank", vector_memory(simulation::source_bank)});
+  items.push_back({"Banks", "Fission bank",
+    simulation::fission_bank.capacity() * sizeof(SourceSite) / 1.0e6});
+  double thread_banks = 0.0;
+  for (const auto& bank : simulation::thread_fission_banks) {
+    thread_banks += vector_memory(bank.sites);
+  }
+  items.push_back({"Banks", "Thread fission banks", thread_banks});
+  items.push_back({"Banks", "Surface source bank",
+    simulation::surf_source_bank.capacity() * sizeof(SourceSite) / 1.0e6});
+
+  items.push_back({"Geometry", "Neighbor lists",
+    model::cells.size() * sizeof(NeighborList) / 1.0e6});
+  double offsets = 0.0;
+  for (const auto& c : model::cells) {
+    offsets += vector_memory(c->offset_);
+  }
+  for (const auto& lat : model::lattices) {
+    offsets += vector_memory(lat->offsets_);
+  }
+  items.push_back({"Geometry", "Distribcell offsets", offsets});
+
+  for (const auto& ww : variance_reduction::weight_windows) {
+    double size = (ww->lower_ww_bounds().size() +
+                    ww->upper_ww_bounds().size()) *
+                  sizeof(double) / 1.0e6;
+    items.push_back(
+      {"Weight windows", fmt::format("Weight windows {}", ww->id()), size});
+  }
+
+  return items;
+}
+
+void print_memory_report(
+  const std::string& title, const vector<MemoryUse>& extra)
+{
+  auto items = memory_usage();
+  items.insert(items.end(), extra.begin(), extra.end());
+
+  // Total of each category followed by the total of all categories and the
+  // resident and peak memory
+  int n = CATEGORIES.size();
+  vector<double> local(n + 3, 0.0);
+  for (const auto& item : items) {
+    auto it = std::find(CATEGORIES.begin(), CATEGORIES.end(), item.category);
+    local[it - CATEGORIES.begin()] += item.size;
+    local[n] += item.size;
+  }
+  local[n + 1] = resident_memory();
+  local[n + 2] = max_resident_memory();
+
+  vector<double> sum = local;
+  vector<double> max = local;
+#ifdef OPENMC_MPI
+  MPI_Reduce(mpi::master ? MPI_IN_PLACE : sum.data(), sum.data(), sum.size(),
+    MPI_DOUBLE, MPI_SUM, 0, mpi::intracomm);
+  MPI_Reduce(mpi::master ? MPI_IN_PLACE : max.data(), max.data(), max.size(),
+    MPI_DOUBLE, MPI_MAX, 0, mpi::intracomm);
+#endif
+  if (!mpi::master)
+    return;
+
+  header(title.c_str(), 4);
+
+  auto show = [](const std::string& label, double mean, double max) {
+    if (mpi::n_procs > 1) {
+      fmt::print(" {:<33} = {:>10.1f} / {:>10.1f} MB\n", label, mean, max);
+    } else {
+      fmt::print(" {:<33} = {:>10.1f} MB\n", label, mean);
+    }
+  };
+
+  if (mpi::n_procs > 1)
+    fmt::print(" Memory per process (mean / max) over {} processes\n",
+      mpi::n_procs);
+  for (int i = 0; i < n; ++i) {
+    if (max[i] > 0.0)
+      show(CATEGORIES[i], sum[i] / mpi::n_procs, max[i]);
+  }
+  show("Total accounted for", sum[n] / mpi::n_procs, max[n]);
+  if (max[n + 1] > 0.0)
+    show("Resident memory", sum[n + 1] / mpi::n_procs, max[n + 1]);
+  if (max[n + 2] > 0.0)
+    show("Peak resident memory", sum[n + 2] / mpi::n_procs, max[n + 2]);
+  if (mpi::n_procs > 1) {
+    fmt::print(" {:<33} = {:>10.1f} MB\n", "Resident memory of all processes",
+      sum[n + 1]);
+  }
+
+  // Largest objects of the categories whose memory scales with the model
+  const std::pair<std::string, const char*> breakdowns[] {
+    {"Tallies", "tallies"}, {"Meshes", "meshes"}};
+  for (const auto& [category, label] : breakdowns) {
+    vector<MemoryUse> largest;
+    for (const auto& item : items) {
+      if (item.category == category && item.size > 0.0)
+        largest.push_back(item);
+    }
+    if (largest.empty())
+      continue;
+    std::sort(largest.begin(), largest.end(),
+      [](const MemoryUse& a, const MemoryUse& b) { return a.size > b.size; });
+    if (largest.size() > N_LARGEST)
+      largest.resize(N_LARGEST);
+
+    fmt::print(" Largest {} on the master process\n", label);
+    for (const auto& item : largest) {
+      fmt::print("   {:<31} = {:>10.1f} MB\n", item.name, item.size);
+    }
+  }
+  fmt::print("\n");
+}
+
+} // namespace openmc
@@ -4,6 +4,8 @@
 #include <cstddef>   // for size_t
 #include <gsl/gsl-lite.hpp>
 #include <string>
+#include <tuple>   // for tie
+#include <utility> // for pair
 
 #ifdef OPENMC_MPI
 #include "mpi.h"
@@ -24,8 +26,10 @@
 #include "openmc/file_utils.h"
 #include "openmc/geometry.h"
 #include "openmc/hdf5_interface.h"
+#include "openmc/lattice.h"
 #include "openmc/material.h"
 #include "openmc/memory.h"
+#include "openmc/memory_report.h"
 #include "openmc/message_passing.h"
 #include "openmc/openmp_interface.h"
 #include "openmc/particle_data.h"
@@ -141,6 +145,13 @@ void Mesh::set_id(int32_t id)
   model::mesh_map[id] = model::meshes.size() - 1;
 }
 
+void Mesh::get_bins(gsl::span<const Position> r, gsl::span<int> bins) const
+{
+  for (gsl::index i = 0; i < r.size(); ++i) {
+    bins[i] = this->get_bin(r[i]);
+  }
+}
+
 vector<double> Mesh::volumes() const
 {
   vector<double> volumes(n_bins());
@@ -210,6 +221,134 @@ int Mesh::material_volumes(
   return hits.size();
 }
 
+namespace {
+
+// Maximum number of geometry segments a ray is tracked through
+constexpr int MAX_RAY_SEGMENTS {1000000};
+
+// Add a volume of a material to the list of material volumes of an element
+void add_material_volume(
+  vector<Mesh::MaterialVolume>& volumes, int32_t material, double volume)
+{
+  for (auto& v : volumes) {
+    if (v.material == material) {
+      v.volume += volume;
+      return;
+    }
+  }
+  volumes.push_back({material, volume});
+}
+
+} // namespace
+
+vector<vector<Mesh::MaterialVolume>> Mesh::traced_material_volumes(
+  const array<int, 3>& n_rays) const
+{
+  auto bbox = this->bounding_box();
+  Position ll {bbox.xmin, bbox.ymin, bbox.zmin};
+  Position width = Position {bbox.xmax, bbox.ymax, bbox.zmax} - ll;
+
+  vector<vector<MaterialVolume>> result(this->n_bins());
+
+#pragma omp parallel
+  {
+    // (bin, material volume) pairs found by this thread
+    vector<std::pair<int, MaterialVolume>> local;
+    vector<int> bins;
+    vector<double> lengths;
+    GeometryState p;
+
+    for (int axis = 0; axis < 3; ++axis) {
+      int a1 = (axis + 1) % 3;
+      int a2 = (axis + 2) % 3;
+      int n1 = n_rays[a1];
+      int n2 = n_rays[a2];
+      double area = width[a1] / n1 * width[a2] / n2;
+      double length = width[axis];
+      Direction u {0.0, 0.0, 0.0};
+      u[axis] = 1.0;
+
+#pragma omp for schedule(dynamic)
+      for (int k = 0; k < n1 * n2; ++k) {
+        Position r = ll;
+        r[a1] += (k % n1 + 0.5) * width[a1] / n1;
+        r[a2] += (k / n1 + 0.5) * width[a2] / n2;
+
+        // Track the ray through the geometry across the bounding box
+        p.init_from_r_u(r, u);
+        bool found = exhaustive_find_cell(p);
+        double traveled = 0.0;
+        for (int i = 0; i < MAX_RAY_SEGMENTS && traveled < length; ++i) {
+          if (!found) {
+            // Move through the void to where the ray enters the geometry
+            double d = distance_to_geometry(p) + TINY_BIT;
+            traveled += d;
+            if (traveled >= length)
+              break;
+            p.n_coord() = 1;
+            p.r() += d * u;
+            p.surface() = 0;
+            found = exhaustive_find_cell(p);
+            continue;
+          }
+
+          // Split the segment in the current cell over the mesh elements
+          auto boundary = distance_to_boundary(p);
+          double d = std::min(boundary.distance, length - traveled);
+          Position r0 = p.r();
+          bins.clear();
+          lengths.clear();
+          this->bins_crossed(r0, r0 + d * u, u, bins, lengths);
+          for (int j = 0; j < bins.size(); ++j) {
+            double volume = lengths[j] * d * area / 3.0;
+            if (!local.empty() && local.back().first == bins[j] &&
+                local.back().second.material == p.material()) {
+              local.back().second.volume += volume;
+            } else {
+              local.push_back({bins[j], {p.material(), volume}});
+            }
+          }
+          traveled += d;
+          if (traveled >= length)
+            break;
+
+          // Move to the boundary and find the cell on the other side
+          for (int j = 0; j < p.n_coord(); ++j) {
+            p.coord(j).r += d * p.coord(j).u;
+          }
+          p.surface() = boundary.surface_index;
+          p.n_coord_last() = p.n_coord();
+          p.n_coord() = boundary.coord_level;
+          const auto& t = boundary.lattice_translation;
+          if (t[0] != 0 || t[1] != 0 || t[2] != 0) {
+            // A ray leaving the lattice may leave the geometry, which must
+            // not be treated as a lost particle
+            const auto& coord = p.lowest_coord();
+            array<int, 3> i_xyz {coord.lattice_i[0] + t[0],
+              coord.lattice_i[1] + t[1], coord.lattice_i[2] + t[2]};
+            if (model::lattices[coord.lattice]->are_valid_indices(i_xyz)) {
+              cross_lattice(p, boundary);
+              continue;
+            }
+          } else if (neighbor_list_find_cell(p)) {
+            continue;
+          }
+          p.n_coord() = 1;
+          found = exhaustive_find_cell(p);
+        }
+      } // omp for
+    }
+
+    // Combine the volumes found by each thread
+#pragma omp critical(MeshMaterialVolumes)
+    for (const auto& v : local) {
+      add_material_volume(result[v.first], v.second.material, v.second.volume);
+    }
+  } // omp parallel
+
+  return result;
+}
+
 vector<Mesh::MaterialVolume> Mesh::material_volumes(
   int n_sample, int bin, uint64_t* seed) const
 {
@@ -552,20 +691,24 @@ xt::xtensor<double, 1> StructuredMesh::count_sites(
   xt::xarray<double> cnt {shape, 0.0};
   bool outside_ = false;
 
+  // Determine the mesh bin of each site in parallel. The weights are then added
+  // in the order of the sites so that the counts are independent of the number
+  // of threads.
+  vector<int> bins(length);
+#pragma omp parallel for schedule(static)
   for (int64_t i = 0; i < length; i++) {
-    const auto& site = bank[i];
-
-    // determine scoring bin for entropy mesh
-    int mesh_bin = get_bin(site.r);
+    bins[i] = get_bin(bank[i].r);
+  }
 
+  for (int64_t i = 0; i < length; i++) {
     // if outside mesh, skip particle
-    if (mesh_bin < 0) {
+    if (bins[i] < 0) {
       outside_ = true;
       continue;
     }
 
     // Add to appropriate bin
-    cnt(mesh_bin) += site.wgt;
+    cnt(bins[i]) += bank[i].wgt;
   }
 
   // Create copy of count data. Since ownership will be acquired by xtensor,
@@ -630,7 +773,7 @@ void StructuredMesh::raytrace_mesh(
   // Only the current cell will score and no surfaces
   if (total_distance < 2 * TINY_BIT) {
     if (in_mesh) {
-      tally.track(ijk, 1.0);
+      tally.track(ijk, 0.0, 1.0);
     }
     return;
   }
@@ -657,7 +800,7 @@ void StructuredMesh::raytrace_mesh(
                      distances.begin();
 
       // Tally track length delta since last step
-      tally.track(ijk,
+      tally.track(ijk, traveled_distance / total_distance,
         (std::min(distances[k].distance, total_distance) - traveled_distance) /
           total_distance);
 
@@ -727,7 +870,7 @@ void StructuredMesh::bins_crossed(Position r0, Position r1, const Direction& u,
       : mesh(_mesh), bins(_bins), lengths(_lengths)
     {}
     void surface(const MeshIndex& ijk, int k, bool max, bool inward) const {}
-    void track(const MeshIndex& ijk, double l) const
+    void track(const MeshIndex& ijk, double start, double l) const
     {
       bins.push_back(mesh->get_bin_from_indices(ijk));
       lengths.push_back(l);
@@ -742,6 +885,30 @@ void StructuredMesh::bins_crossed(Position r0, Position r1, const Direction& u,
   raytrace_mesh(r0, r1, u, TrackAggregator(this, bins, lengths));
 }
 
+void StructuredMesh::segments_crossed(Position r0, Position r1,
+  const Direction& u, vector<int>& bins, vector<double>& starts,
+  vector<double>& lengths) const
+{
+  // Helper tally class storing where each bin is entered along with the bin
+  // and the length within it
+  struct SegmentAggregator {
+    void surface(const MeshIndex& ijk, int k, bool max, bool inward) const {}
+    void track(const MeshIndex& ijk, double start, double l) const
+    {
+      bins.push_back(mesh->get_bin_from_indices(ijk));
+      starts.push_back(start);
+      lengths.push_back(l);
+    }
+
+    const StructuredMesh* mesh;
+    vector<int>& bins;
+    vector<double>& starts;
+    vector<double>& lengths;
+  };
+
+  raytrace_mesh(r0, r1, u, SegmentAggregator {this, bins, starts, lengths});
+}
+
 void StructuredMesh::surface_bins_crossed(
   Position r0, Position r1, const Direction& u, vector<int>& bins) const
 {
@@ -763,7 +930,7 @@ void StructuredMesh::surface_bins_crossed(
         i_bin += 1;
       bins.push_back(i_bin);
     }
-    void track(const MeshIndex& idx, double l) const {}
+    void track(const MeshIndex& idx, double start, double l) const {}
 
     const StructuredMesh* mesh;
     vector<int>& bins;
@@ -870,6 +1037,31 @@ int RegularMesh::get_index_in_direction(double r, int i) const
   return std::ceil((r - lower_left_[i]) / width_[i]);
 }
 
+int RegularMesh::get_bin(Position r) const
+{
+  // The index along each direction is found exactly as in
+  // get_index_in_direction so that both agree on positions at mesh lines
+  int bin = 0;
+  int stride = 1;
+  for (int i = 0; i < n_dimension_; ++i) {
+    int idx = std::ceil((r[i] - lower_left_[i]) / width_[i]);
+    if (idx < 1 || idx > shape_[i])
+      return -1;
+    bin += (idx - 1) * stride;
+    stride *= shape_[i];
+  }
+  return bin;
+}
+
+void RegularMesh::get_bins(
+  gsl::span<const Position> r, gsl::span<int> bins) const
+{
+  // Calls to the final get_bin are resolved statically and can be inlined
+  for (gsl::index i = 0; i < r.size(); ++i) {
+    bins[i] = this->get_bin(r[i]);
+  }
+}
+
 const std::string RegularMesh::mesh_type = "regular";
 
 std::string RegularMesh::get_mesh_type() const
@@ -907,6 +1099,86 @@ StructuredMesh::MeshDistance RegularMesh::distance_to_grid_boundary(
   return d;
 }
 
+void RegularMesh::bins_crossed(Position r0, Position r1, const Direction& u,
+  vector<int>& bins, vector<double>& lengths) const
+{
+  // Compute the length of the entire track.
+  double total_distance = (r1 - r0).norm();
+  if (total_distance == 0.0 && settings::solver_type != SolverType::RANDOM_RAY)
+    return;
+
+  // Calculate index of current cell. Offset the position a tiny bit in
+  // direction of flight
+  bool in_mesh;
+  MeshIndex ijk = get_indices(r0 + TINY_BIT * u, in_mesh);
+
+  // if track is very short, assume that it is completely inside one cell
+  if (total_distance < 2 * TINY_BIT) {
+    if (in_mesh) {
+      bins.push_back(get_bin_from_indices(ijk));
+      lengths.push_back(1.0);
+    }
+    return;
+  }
+
+  // Finding where a track enters the mesh is left to the general traversal
+  if (!in_mesh) {
+    StructuredMesh::bins_crossed(r0, r1, u, bins, lengths);
+    return;
+  }
+
+  // Set up the constant step in mesh index and bin along each axis, the index
+  // of the next grid plane to be crossed, and the distance to that plane.
+  // Distances are always measured from r0 so that they match those of the
+  // general traversal exactly.
+  const int n = n_dimension_;
+  array<double, 3> ll {0.0, 0.0, 0.0};
+  array<double, 3> width {0.0, 0.0, 0.0};
+  array<int, 3> step {0, 0, 0};
+  array<int, 3> bin_step {0, 0, 0};
+  array<int, 3> plane {0, 0, 0};
+  array<double, 3> t_max {INFTY, INFTY, INFTY};
+  int stride = 1;
+  for (int k = 0; k < n; ++k) {
+    ll[k] = lower_left_[k];
+    width[k] = width_[k];
+    if (std::abs(u[k]) >= FP_PRECISION) {
+      step[k] = (u[k] > 0) ? 1 : -1;
+      bin_step[k] = step[k] * stride;
+      plane[k] = (u[k] > 0) ? ijk[k] : ijk[k] - 1;
+      t_max[k] = (ll[k] + plane[k] * width[k] - r0[k]) / u[k];
+    }
+    stride *= shape_[k];
+  }
+
+  int bin = get_bin_from_indices(ijk);
+  double traveled_distance {0.0};
+  while (true) {
+    // find the first axis along which the next plane is crossed
+    int k = (t_max[1] < t_max[0]) ? 1 : 0;
+    if (t_max[2] < t_max[k])
+      k = 2;
+
+    bins.push_back(bin);
+    lengths.push_back(
+      (std::min(t_max[k], total_distance) - traveled_distance) /
+      total_distance);
+
+    // leave if we have reached the end position
+    traveled_distance = t_max[k];
+    if (traveled_distance >= total_distance)
+      return;
+
+    // move to the neighboring element, leaving if it is outside of the mesh
+    ijk[k] += step[k];
+    if (ijk[k] < 1 || ijk[k] > shape_[k])
+      return;
+    bin += bin_step[k];
+    plane[k] += step[k];
+    t_max[k] = (ll[k] + plane[k] * width[k] - r0[k]) / u[k];
+  }
+}
+
 std::pair<vector<double>, vector<double>> RegularMesh::plot(
   Position plot_ll, Position plot_ur) const
 {
@@ -972,20 +1244,24 @@ xt::xtensor<double, 1> RegularMesh::count_sites(
   xt::xarray<double> cnt {shape, 0.0};
   bool outside_ = false;
 
+  // Determine the mesh bin of each site in parallel. The weights are then added
+  // in the order of the sites so that the counts are independent of the number
+  // of threads.
+  vector<int> bins(length);
+#pragma omp parallel for schedule(static)
   for (int64_t i = 0; i < length; i++) {
-    const auto& site = bank[i];
-
-    // determine scoring bin for entropy mesh
-    int mesh_bin = get_bin(site.r);
+    bins[i] = get_bin(bank[i].r);
+  }
 
+  for (int64_t i = 0; i < length; i++) {
     // if outside mesh, skip particle
-    if (mesh_bin < 0) {
+    if (bins[i] < 0) {
       outside_ = true;
       continue;
     }
 
     // Add to appropriate bin
-    cnt(mesh_bin) += site.wgt;
+    cnt(bins[i]) += bank[i].wgt;
   }
 
   // Create copy of count data. Since ownership will be acquired by xtensor,
@@ -1045,6 +1321,12 @@ std::string RectilinearMesh::get_mesh_type() const
   return mesh_type;
 }
 
+double RectilinearMesh::memory() const
+{
+  return vector_memory(grid_[0]) + vector_memory(grid_[1]) +
+         vector_memory(grid_[2]);
+}
+
 double RectilinearMesh::positive_grid_boundary(
   const MeshIndex& ijk, int i) const
 {
@@ -1108,6 +1390,28 @@ int RectilinearMesh::get_index_in_direction(double r, int i) const
   return lower_bound_index(grid_[i].begin(), grid_[i].end(), r) + 1;
 }
 
+int RectilinearMesh::get_bin_near(Position r, int bin) const
+{
+  if (bin < 0 || bin >= n_bins())
+    return get_bin(r);
+
+  // Only search the grid along directions in which the position has left the
+  // interval of the given bin. Intervals are bounded as in lower_bound_index,
+  // so the indices are the same as those found by a full search.
+  MeshIndex ijk = get_indices_from_bin(bin);
+  for (int i = 0; i < n_dimension_; ++i) {
+    const auto& g = grid_[i];
+    int j = ijk[i];
+    if ((r[i] > g[j - 1] || (j == 1 && r[i] == g[0])) && r[i] <= g[j])
+      continue;
+
+    ijk[i] = get_index_in_direction(r[i], i);
+    if (ijk[i] < 1 || ijk[i] > shape_[i])
+      return -1;
+  }
+  return get_bin_from_indices(ijk);
+}
+
 std::pair<vector<double>, vector<double>> RectilinearMesh::plot(
   Position plot_ll, Position plot_ur) const
 {
@@ -1185,6 +1489,12 @@ std::string CylindricalMesh::get_mesh_type() const
   return mesh_type;
 }
 
+double CylindricalMesh::memory() const
+{
+  return vector_memory(grid_[0]) + vector_memory(grid_[1]) +
+         vector_memory(grid_[2]);
+}
+
 StructuredMesh::MeshIndex CylindricalMesh::get_indices(
   Position r, bool& in_mesh) const
 {
@@ -1233,49 +1543,57 @@ Position CylindricalMesh::sample_element(
   return origin_ + Position(x, y, z);
 }
 
-double CylindricalMesh::find_r_crossing(
+StructuredMesh::MeshDistance CylindricalMesh::find_r_crossing(
   const Position& r, const Direction& u, double l, int shell) const
 {
-
-  if ((shell < 0) || (shell > shape_[0]))
-    return INFTY;
+  MeshDistance d_outer(shell + 1, true, INFTY);
+  MeshDistance d_inner(shell - 1, false, INFTY);
 
   // solve r.x^2 + r.y^2 == r0^2
   // x^2 + 2*s*u*x + s^2*u^2 + s^2*v^2+2*s*v*y + y^2 -r0^2 = 0
   // s^2 * (u^2 + v^2) + 2*s*(u*x+v*y) + x^2+y^2-r0^2 = 0
-
-  const double r0 = grid_[0][shell];
-  if (r0 == 0.0)
-    return INFTY;
+  // Only the constant term depends on r0, so the rest is shared by the
+  // inner and outer boundaries of the shell.
 
   const double denominator = u.x * u.x + u.y * u.y;
 
   // Direction of flight is in z-direction. Will never intersect r.
   if (std::abs(denominator) < FP_PRECISION)
-    return INFTY;
+    return d_outer;
 
   // inverse of dominator to help the compiler to speed things up
   const double inv_denominator = 1.0 / denominator;
 
   const double p = (u.x * r.x + u.y * r.y) * inv_denominator;
-  double c = r.x * r.x + r.y * r.y - r0 * r0;
-  double D = p * p - c * inv_denominator;
+  const double rho_sq = r.x * r.x + r.y * r.y;
 
-  if (D < 0.0)
-    return INFTY;
+  auto crossing = [&](int i) {
+    if ((i < 0) || (i > shape_[0]) || (grid_[0][i] == 0.0))
+      return INFTY;
 
-  D = std::sqrt(D);
+    double c = rho_sq - r_sq_[i];
+    double D = p * p - c * inv_denominator;
 
-  // the solution -p - D is always smaller as -p + D : Check this one first
-  if (std::abs(c) <= RADIAL_MESH_TOL)
-    return INFTY;
+    if (D < 0.0)
+      return INFTY;
 
-  if (-p - D > l)
-    return -p - D;
-  if (-p + D > l)
-    return -p + D;
+    D = std::sqrt(D);
 
-  return INFTY;
+    // the solution -p - D is always smaller as -p + D : Check this one first
+    if (std::abs(c) <= RADIAL_MESH_TOL)
+      return INFTY;
+
+    if (-p - D > l)
+      return -p - D;
+    if (-p + D > l)
+      return -p + D;
+
+    return INFTY;
+  };
+
+  d_outer.distance = crossing(shell);
+  d_inner.distance = crossing(shell - 1);
+  return std::min(d_outer, d_inner);
 }
 
 double CylindricalMesh::find_phi_crossing(
@@ -1287,15 +1605,13 @@ double CylindricalMesh::find_phi_crossing(
 
   shell = sanitize_phi(shell);
 
-  const double p0 = grid_[1][shell];
-
   // solve y(s)/x(s) = tan(p0) = sin(p0)/cos(p0)
   // => x(s) * cos(p0) = y(s) * sin(p0)
   // => (y + s * v) * cos(p0) = (x + s * u) * sin(p0)
   // = s * (v * cos(p0) - u * sin(p0)) = - (y * cos(p0) - x * sin(p0))
 
-  const double c0 = std::cos(p0);
-  const double s0 = std::sin(p0);
+  const double c0 = phi_cos_[shell];
+  const double s0 = phi_sin_[shell];
 
   const double denominator = (u.x * s0 - u.y * c0);
 
@@ -1340,9 +1656,7 @@ StructuredMesh::MeshDistance CylindricalMesh::distance_to_grid_boundary(
 
   if (i == 0) {
 
-    return std::min(
-      MeshDistance(ijk[i] + 1, true, find_r_crossing(r, u, l, ijk[i])),
-      MeshDistance(ijk[i] - 1, false, find_r_crossing(r, u, l, ijk[i] - 1)));
+    return find_r_crossing(r, u, l, ijk[i]);
 
   } else if (i == 1) {
 
@@ -1394,6 +1708,18 @@ int CylindricalMesh::set_grid()
 
   full_phi_ = (grid_[1].front() == 0.0) && (grid_[1].back() == 2.0 * PI);
 
+  // Boundary data used on every crossing, computed once for each grid value
+  r_sq_.resize(grid_[0].size());
+  for (int i = 0; i < grid_[0].size(); ++i) {
+    r_sq_[i] = grid_[0][i] * grid_[0][i];
+  }
+  phi_cos_.resize(grid_[1].size());
+  phi_sin_.resize(grid_[1].size());
+  for (int i = 0; i < grid_[1].size(); ++i) {
+    phi_cos_[i] = std::cos(grid_[1][i]);
+    phi_sin_[i] = std::sin(grid_[1][i]);
+  }
+
   lower_left_ = {origin_[0] - grid_[0].back(), origin_[1] - grid_[0].back(),
     origin_[2] + grid_[2].front()};
   upper_right_ = {origin_[0] + grid_[0].back(), origin_[1] + grid_[0].back(),
@@ -1470,6 +1796,12 @@ std::string SphericalMesh::get_mesh_type() const
   return mesh_type;
 }
 
+double SphericalMesh::memory() const
+{
+  return vector_memory(grid_[0]) + vector_memory(grid_[1]) +
+         vector_memory(grid_[2]);
+}
+
 StructuredMesh::MeshIndex SphericalMesh::get_indices(
   Position r, bool& in_mesh) const
 {
@@ -1523,44 +1855,51 @@ Position SphericalMesh::sample_element(
   return origin_ + Position(x, y, z);
 }
 
-double SphericalMesh::find_r_crossing(
+StructuredMesh::MeshDistance SphericalMesh::find_r_crossing(
   const Position& r, const Direction& u, double l, int shell) const
 {
-  if ((shell < 0) || (shell > shape_[0]))
-    return INFTY;
-
   // solve |r+s*u| = r0
   // |r+s*u| = |r| + 2*s*r*u + s^2 (|u|==1 !)
-  const double r0 = grid_[0][shell];
-  if (r0 == 0.0)
-    return INFTY;
+  // Only the constant term depends on r0, so the rest is shared by the
+  // inner and outer boundaries of the shell.
   const double p = r.dot(u);
-  double c = r.dot(r) - r0 * r0;
-  double D = p * p - c;
+  const double r_dot_r = r.dot(r);
 
-  if (std::abs(c) <= RADIAL_MESH_TOL)
-    return INFTY;
+  auto crossing = [&](int i) {
+    if ((i < 0) || (i > shape_[0]) || (grid_[0][i] == 0.0))
+      return INFTY;
 
-  if (D >= 0.0) {
-    D = std::sqrt(D);
-    // the solution -p - D is always smaller as -p + D : Check this one first
-    if (-p - D > l)
-      return -p - D;
-    if (-p + D > l)
-      return -p + D;
-  }
+    double c = r_dot_r - r_sq_[i];
+    double D = p * p - c;
 
-  return INFTY;
+    if (std::abs(c) <= RADIAL_MESH_TOL)
+      return INFTY;
+
+    if (D >= 0.0) {
+      D = std::sqrt(D);
+      // the solution -p - D is always smaller as -p + D : Check this one first
+      if (-p - D > l)
+        return -p - D;
+      if (-p + D > l)
+        return -p + D;
+    }
+
+    return INFTY;
+  };
+
+  return std::min(MeshDistance(shell + 1, true, crossing(shell)),
+    MeshDistance(shell - 1, false, crossing(shell - 1)));
 }
 
-double SphericalMesh::find_theta_crossing(
+StructuredMesh::MeshDistance SphericalMesh::find_theta_crossing(
   const Position& r, const Direction& u, double l, int shell) const
 {
+  MeshDistance d_max(sanitize_theta(shell + 1), true, INFTY);
+  MeshDistance d_min(sanitize_theta(shell - 1), false, INFTY);
+
   // Theta grid is [0, π], thus there is no real surface to cross
   if (full_theta_ && (shape_[1] == 1))
-    return INFTY;
-
-  shell = sanitize_theta(shell);
+    return d_max;
 
   // solving z(s) = cos/theta) * r(s) with r(s) = r+s*u
   // yields
@@ -1568,51 +1907,66 @@ double SphericalMesh::find_theta_crossing(
   // a = cos(theta)^2 - u.z * u.z
   // b = r*u * cos(theta)^2 - u.z * r.z
   // c = r*r * cos(theta)^2 - r.z^2
+  // The dot products are shared by both boundaries of the shell.
+  const double r_dot_u = r.dot(u);
+  const double r_dot_r = r.dot(r);
+
+  auto crossing = [&](int i) {
+    i = sanitize_theta(i);
+
+    const double cos_t = theta_cos_[i];
+    const bool sgn = std::signbit(cos_t);
+    const double cos_t_2 = cos_t * cos_t;
+
+    const double a = cos_t_2 - u.z * u.z;
+    const double b = r_dot_u * cos_t_2 - r.z * u.z;
+    const double c = r_dot_r * cos_t_2 - r.z * r.z;
+
+    // if factor of s^2 is zero, direction of flight is parallel to theta
+    // surface
+    if (std::abs(a) < FP_PRECISION) {
+      // if b vanishes, direction of flight is within theta surface and
+      // crossing is not possible
+      if (std::abs(b) < FP_PRECISION)
+        return INFTY;
+
+      const double s = -0.5 * c / b;
+      // Check if solution is in positive direction of flight and has correct
+      // sign
+      if ((s > l) && (std::signbit(r.z + s * u.z) == sgn))
+        return s;
+
+      // no crossing is possible
+      return INFTY;
+    }
 
-  const double cos_t = std::cos(grid_[1][shell]);
-  const bool sgn = std::signbit(cos_t);
-  const double cos_t_2 = cos_t * cos_t;
-
-  const double a = cos_t_2 - u.z * u.z;
-  const double b = r.dot(u) * cos_t_2 - r.z * u.z;
-  const double c = r.dot(r) * cos_t_2 - r.z * r.z;
+    const double p = b / a;
+    double D = p * p - c / a;
 
-  // if factor of s^2 is zero, direction of flight is parallel to theta surface
-  if (std::abs(a) < FP_PRECISION) {
-    // if b vanishes, direction of flight is within theta surface and crossing
-    // is not possible
-    if (std::abs(b) < FP_PRECISION)
+    if (D < 0.0)
       return INFTY;
 
-    const double s = -0.5 * c / b;
-    // Check if solution is in positive direction of flight and has correct sign
+    D = std::sqrt(D);
+
+    // the solution -p-D is always smaller as -p+D : Check this one first
+    double s = -p - D;
+    // Check if solution is in positive direction of flight and has correct
+    // sign
     if ((s > l) && (std::signbit(r.z + s * u.z) == sgn))
       return s;
 
-    // no crossing is possible
-    return INFTY;
-  }
-
-  const double p = b / a;
-  double D = p * p - c / a;
+    s = -p + D;
+    // Check if solution is in positive direction of flight and has correct
+    // sign
+    if ((s > l) && (std::signbit(r.z + s * u.z) == sgn))
+      return s;
 
-  if (D < 0.0)
     return INFTY;
+  };
 
-  D = std::sqrt(D);
-
-  // the solution -p-D is always smaller as -p+D : Check this one first
-  double s = -p - D;
-  // Check if solution is in positive direction of flight and has correct sign
-  if ((s > l) && (std::signbit(r.z + s * u.z) == sgn))
-    return s;
-
-  s = -p + D;
-  // Check if solution is in positive direction of flight and has correct sign
-  if ((s > l) && (std::signbit(r.z + s * u.z) == sgn))
-    return s;
-
-  return INFTY;
+  d_max.distance = crossing(shell);
+  d_min.distance = crossing(shell - 1);
+  return std::min(d_max, d_min);
 }
 
 double SphericalMesh::find_phi_crossing(
@@ -1624,15 +1978,13 @@ double SphericalMesh::find_phi_crossing(
 
   shell = sanitize_phi(shell);
 
-  const double p0 = grid_[2][shell];
-
   // solve y(s)/x(s) = tan(p0) = sin(p0)/cos(p0)
   // => x(s) * cos(p0) = y(s) * sin(p0)
   // => (y + s * v) * cos(p0) = (x + s * u) * sin(p0)
   // = s * (v * cos(p0) - u * sin(p0)) = - (y * cos(p0) - x * sin(p0))
 
-  const double c0 = std::cos(p0);
-  const double s0 = std::sin(p0);
+  const double c0 = phi_cos_[shell];
+  const double s0 = phi_sin_[shell];
 
   const double denominator = (u.x * s0 - u.y * c0);
 
@@ -1654,15 +2006,10 @@ StructuredMesh::MeshDistance SphericalMesh::distance_to_grid_boundary(
 {
 
   if (i == 0) {
-    return std::min(
-      MeshDistance(ijk[i] + 1, true, find_r_crossing(r0, u, l, ijk[i])),
-      MeshDistance(ijk[i] - 1, false, find_r_crossing(r0, u, l, ijk[i] - 1)));
+    return find_r_crossing(r0, u, l, ijk[i]);
 
   } else if (i == 1) {
-    return std::min(MeshDistance(sanitize_theta(ijk[i] + 1), true,
-                      find_theta_crossing(r0, u, l, ijk[i])),
-      MeshDistance(sanitize_theta(ijk[i] - 1), false,
-        find_theta_crossing(r0, u, l, ijk[i] - 1)));
+    return find_theta_crossing(r0, u, l, ijk[i]);
 
   } else {
     return std::min(MeshDistance(sanitize_phi(ijk[i] + 1), true,
@@ -1711,6 +2058,22 @@ int SphericalMesh::set_grid()
   full_theta_ = (grid_[1].front() == 0.0) && (grid_[1].back() == PI);
   full_phi_ = (grid_[2].front() == 0.0) && (grid_[2].back() == 2 * PI);
 
+  // Boundary data used on every crossing, computed once for each grid value
+  r_sq_.resize(grid_[0].size());
+  for (int i = 0; i < grid_[0].size(); ++i) {
+    r_sq_[i] = grid_[0][i] * grid_[0][i];
+  }
+  theta_cos_.resize(grid_[1].size());
+  for (int i = 0; i < grid_[1].size(); ++i) {
+    theta_cos_[i] = std::cos(grid_[1][i]);
+  }
+  phi_cos_.resize(grid_[2].size());
+  phi_sin_.resize(grid_[2].size());
+  for (int i = 0; i < grid_[2].size(); ++i) {
+    phi_cos_[i] = std::cos(grid_[2][i]);
+    phi_sin_[i] = std::sin(grid_[2][i]);
+  }
+
   double r = grid_[0].back();
   lower_left_ = {origin_[0] - r, origin_[1] - r, origin_[2] - r};
   upper_right_ = {origin_[0] + r, origin_[1] + r, origin_[2] + r};
@@ -1761,6 +2124,286 @@ double SphericalMesh::volume(const MeshIndex& ijk) const
          (std::cos(theta_i) - std::cos(theta_o)) * (phi_o - phi_i);
 }
 
+//==============================================================================
+// OctreeMesh implementation
+//==============================================================================
+
+namespace {
+
+// Maximum number of times a root cell of an octree mesh can be split
+constexpr int MAX_OCTREE_LEVEL {20};
+
+} // namespace
+
+OctreeMesh::OctreeMesh(pugi::xml_node node) : Mesh {node}
+{
+  n_dimension_ = 3;
+
+  if (!check_for_node(node, "dimension")) {
+    fatal_error("Must specify <dimension> on an octree mesh.");
+  }
+  auto shape = get_node_array<int>(node, "dimension");
+  if (shape.size() != 3) {
+    fatal_error("Octree mesh must be three dimensional.");
+  }
+  for (int i = 0; i < 3; ++i) {
+    if (shape[i] <= 0) {
+      fatal_error("All entries on the <dimension> element for an octree "
+                  "mesh must be positive.");
+    }
+    shape_[i] = shape[i];
+  }
+
+  if (!check_for_node(node, "lower_left") ||
+      !check_for_node(node, "upper_right")) {
+    fatal_error(
+      "Must specify <lower_left> and <upper_right> on an octree mesh.");
+  }
+  lower_left_ = get_node_xarray<double>(node, "lower_left");
+  upper_right_ = get_node_xarray<double>(node, "upper_right");
+  if (lower_left_.size() != 3 || upper_right_.size() != 3) {
+    fatal_error("Number of entries on <lower_left> and <upper_right> of an "
+                "octree mesh must be three.");
+  }
+  if (xt::any(upper_right_ <= lower_left_)) {
+    fatal_error("The <upper_right> coordinates must be greater than "
+                "the <lower_left> coordinates on an octree mesh.");
+  }
+  for (int i = 0; i < 3; ++i) {
+    width_[i] = (upper_right_[i] - lower_left_[i]) / shape_[i];
+  }
+
+  // Without refinement, every root cell is an element
+  int n_root = shape_[0] * shape_[1] * shape_[2];
+  if (check_for_node(node, "refinement")) {
+    refinement_ = get_node_array<int>(node, "refinement");
+  } else {
+    refinement_.assign(n_root, 0);
+  }
+
+  nodes_.resize(n_root);
+  size_t pos = 0;
+  for (int k = 0; k < shape_[2]; ++k) {
+    for (int j = 0; j < shape_[1]; ++j) {
+      for (int i = 0; i < shape_[0]; ++i) {
+        Position ll {lower_left_[0] + i * width_.x,
+          lower_left_[1] + j * width_.y, lower_left_[2] + k * width_.z};
+        Position ur = ll + width_;
+        BoundingBox box {ll.x, ur.x, ll.y, ur.y, ll.z, ur.z};
+        build(i + shape_[0] * (j + shape_[1] * k), box, 0, pos);
+      }
+    }
+  }
+  if (pos != refinement_.size()) {
+    fatal_error(fmt::format("The <refinement> of octree mesh {} has {} flags "
+                            "but only {} are used.",
+      id_, refinement_.size(), pos));
+  }
+}
+
+void OctreeMesh::build(
+  int node, const BoundingBox& box, int level, size_t& pos)
+{
+  if (pos >= refinement_.size()) {
+    fatal_error(fmt::format(
+      "The <refinement> of octree mesh {} ends before all cells are given.",
+      id_));
+  }
+
+  int flag = refinement_[pos++];
+  if (flag == 0) {
+    nodes_[node].bin = boxes_.size();
+    boxes_.push_back(box);
+    levels_.push_back(level);
+    return;
+  } else if (flag != 1) {
+    fatal_error(fmt::format(
+      "Flags on the <refinement> of octree mesh {} must be 0 or 1.", id_));
+  } else if (level == MAX_OCTREE_LEVEL) {
+    fatal_error(fmt::format(
+      "Cells of octree mesh {} cannot be split more than {} times.", id_,
+      MAX_OCTREE_LEVEL));
+  }
+
+  int child = nodes_.size();
+  nodes_[node].child = child;
+  nodes_.resize(child + 8);
+  double xc = 0.5 * (box.xmin + box.xmax);
+  double yc = 0.5 * (box.ymin + box.ymax);
+  double zc = 0.5 * (box.zmin + box.zmax);
+  for (int o = 0; o < 8; ++o) {
+    BoundingBox octant {(o & 1) ? xc : box.xmin, (o & 1) ? box.xmax : xc,
+      (o & 2) ? yc : box.ymin, (o & 2) ? box.ymax : yc,
+      (o & 4) ? zc : box.zmin, (o & 4) ? box.zmax : zc};
+    build(child + o, octant, level + 1, pos);
+  }
+}
+
+const std::string OctreeMesh::mesh_type = "octree";
+
+std::string OctreeMesh::get_mesh_type() const
+{
+  return mesh_type;
+}
+
+double OctreeMesh::memory() const
+{
+  return vector_memory(refinement_) + vector_memory(nodes_) +
+         vector_memory(boxes_) + vector_memory(levels_);
+}
+
+int OctreeMesh::get_bin(Position r) const
+{
+  // Find the root cell
+  array<int, 3> ijk;
+  for (int i = 0; i < 3; ++i) {
+    ijk[i] = std::floor((r[i] - lower_left_[i]) / width_[i]);
+    if (ijk[i] < 0 || ijk[i] >= shape_[i])
+      return -1;
+  }
+  int root = ijk[0] + shape_[0] * (ijk[1] + shape_[1] * ijk[2]);
+  const Node* node = &nodes_[root];
+
+  // Descend into the octant containing the position until reaching a leaf
+  Position ll {lower_left_[0] + ijk[0] * width_.x,
+    lower_left_[1] + ijk[1] * width_.y, lower_left_[2] + ijk[2] * width_.z};
+  Position w = width_;
+  while (node->child >= 0) {
+    w *= 0.5;
+    int o = 0;
+    for (int i = 0; i < 3; ++i) {
+      if (r[i] >= ll[i] + w[i]) {
+        o |= 1 << i;
+        ll[i] += w[i];
+      }
+    }
+    node = &nodes_[node->child + o];
+  }
+  return node->bin;
+}
+
+void OctreeMesh::bins_crossed(Position r0, Position r1, const Direction& u,
+  vector<int>& bins, vector<double>& lengths) const
+{
+  double total_distance = (r1 - r0).norm();
+  if (total_distance == 0.0)
+    return;
+
+  // Clip the track to the bounding box of the mesh
+  double t_min = 0.0;
+  double t_max = total_distance;
+  for (int i = 0; i < 3; ++i) {
+    if (u[i] == 0.0) {
+      if (r0[i] < lower_left_[i] || r0[i] > upper_right_[i])
+        return;
+      continue;
+    }
+    double t0 = (lower_left_[i] - r0[i]) / u[i];
+    double t1 = (upper_right_[i] - r0[i]) / u[i];
+    if (t0 > t1)
+      std::swap(t0, t1);
+    t_min = std::max(t_min, t0);
+    t_max = std::min(t_max, t1);
+  }
+
+  // Locate each element slightly past where the track enters it and leave
+  // through the nearest face of its box in the direction of travel
+  double t = t_min;
+  while (t < t_max) {
+    double nudge = std::min(TINY_BIT, 0.5 * (t_max - t));
+    int bin = get_bin(r0 + (t + nudge) * u);
+    if (bin < 0)
+      break;
+
+    const auto& box = boxes_[bin];
+    Position lo {box.xmin, box.ymin, box.zmin};
+    Position hi {box.xmax, box.ymax, box.zmax};
+    double t_exit = t_max;
+    for (int i = 0; i < 3; ++i) {
+      if (u[i] > 0.0) {
+        t_exit = std::min(t_exit, (hi[i] - r0[i]) / u[i]);
+      } else if (u[i] < 0.0) {
+        t_exit = std::min(t_exit, (lo[i] - r0[i]) / u[i]);
+      }
+    }
+    t_exit = std::max(t_exit, t + nudge);
+    if (t_exit <= t)
+      break;
+
+    bins.push_back(bin);
+    lengths.push_back((t_exit - t) / total_distance);
+    t = t_exit;
+  }
+}
+
+void OctreeMesh::surface_bins_crossed(
+  Position r0, Position r1, const Direction& u, vector<int>& bins) const
+{
+  fatal_error("Octree mesh surface tallies are not implemented.");
+}
+
+Position OctreeMesh::sample_element(int32_t bin, uint64_t* seed) const
+{
+  const auto& box = boxes_[bin];
+  return {box.xmin + (box.xmax - box.xmin) * prn(seed),
+    box.ymin + (box.ymax - box.ymin) * prn(seed),
+    box.zmin + (box.zmax - box.zmin) * prn(seed)};
+}
+
+std::pair<vector<double>, vector<double>> OctreeMesh::plot(
+  Position plot_ll, Position plot_ur) const
+{
+  // Figure out which axes lie in the plane of the plot.
+  array<int, 2> axes;
+  if (plot_ur.z == plot_ll.z) {
+    axes = {0, 1};
+  } else if (plot_ur.y == plot_ll.y) {
+    axes = {0, 2};
+  } else if (plot_ur.x == plot_ll.x) {
+    axes = {1, 2};
+  } else {
+    fatal_error("Can only plot mesh lines on an axis-aligned plot");
+  }
+
+  // Refined elements do not span the plot, so only the root grid is drawn
+  array<vector<double>, 2> axis_lines;
+  for (int i_ax = 0; i_ax < 2; ++i_ax) {
+    int axis = axes[i_ax];
+    for (int i = 0; i < shape_[axis] + 1; ++i) {
+      double coord = lower_left_[axis] + i * width_[axis];
+      if (coord >= plot_ll[axis] && coord <= plot_ur[axis])
+        axis_lines[i_ax].push_back(coord);
+    }
+  }
+
+  return {axis_lines[0], axis_lines[1]};
+}
+
+void OctreeMesh::to_hdf5(hid_t group) const
+{
+  hid_t mesh_group = create_group(group, "mesh " + std::to_string(id_));
+
+  write_dataset(mesh_group, "type", OctreeMesh::mesh_type);
+  write_dataset(mesh_group, "dimension", shape_);
+  write_dataset(mesh_group, "lower_left", lower_left_);
+  write_dataset(mesh_group, "upper_right", upper_right_);
+  write_dataset(mesh_group, "refinement", refinement_);
+
+  close_group(mesh_group);
+}
+
+std::string OctreeMesh::bin_label(int bin) const
+{
+  return fmt::format("Mesh Index ({})", bin);
+}
+
+double OctreeMesh::volume(int bin) const
+{
+  const auto& box = boxes_[bin];
+  return (box.xmax - box.xmin) * (box.ymax - box.ymin) *
+         (box.zmax - box.zmin);
+}
+
 //==============================================================================
 // Helper functions for the C API
 //==============================================================================
@@ -1924,6 +2567,21 @@ extern "C" int openmc_mesh_get_volumes(int32_t index, double* volumes)
   return 0;
 }
 
+//! Get the mesh bins of a set of positions
+extern "C" int openmc_mesh_get_bins(
+  int32_t index, size_t n, const double* coords, int* bins)
+{
+  if (int err = check_mesh(index))
+    return err;
+
+  vector<Position> r(n);
+  for (size_t i = 0; i < n; ++i) {
+    r[i] = {coords[3 * i], coords[3 * i + 1], coords[3 * i + 2]};
+  }
+  model::meshes[index]->get_bins(r, {bins, n});
+  return 0;
+}
+
 //! Get the bounding box of a mesh
 extern "C" int openmc_mesh_bounding_box(int32_t index, double* ll, double* ur)
 {
@@ -1962,6 +2620,55 @@ extern "C" int openmc_mesh_material_volumes(int32_t index, int n_sample,
   return (n == -1) ? OPENMC_E_ALLOCATE : 0;
 }
 
+extern "C" int openmc_mesh_traced_material_volumes(int32_t index,
+  const int* n_rays, int max_materials, int* n_materials, int32_t* materials,
+  double* volumes)
+{
+  if (int err = check_mesh(index))
+    return err;
+
+  for (int i = 0; i < 3; ++i) {
+    if (n_rays[i] <= 0) {
+      set_errmsg("Number of rays must be positive.");
+      return OPENMC_E_INVALID_ARGUMENT;
+    }
+  }
+
+  const auto& mesh = model::meshes[index];
+  auto bbox = mesh->bounding_box();
+  if (!std::isfinite(bbox.xmin) || !std::isfinite(bbox.xmax) ||
+      !std::isfinite(bbox.ymin) || !std::isfinite(bbox.ymax) ||
+      !std::isfinite(bbox.zmin) || !std::isfinite(bbox.zmax)) {
+    set_errmsg("Material volumes can only be traced over a mesh with a finite "
+               "bounding box.");
+    return OPENMC_E_INVALID_ARGUMENT;
+  }
+
+  auto result =
+    mesh->traced_material_volumes({n_rays[0], n_rays[1], n_rays[2]});
+
+  // The number of materials of every element is returned even if there is
+  // not enough space for them so that the caller can allocate enough
+  bool fits = true;
+  for (int bin = 0; bin < result.size(); ++bin) {
+    const auto& v = result[bin];
+    n_materials[bin] = v.size();
+    if (v.size() > max_materials) {
+      fits = false;
+      continue;
+    }
+    for (int i = 0; i < v.size(); ++i) {
+      materials[bin * max_materials + i] = v[i].material;
+      volumes[bin * max_materials + i] = v[i].volume;
+    }
+  }
+  if (!fits) {
+    set_errmsg("Not enough space to store the materials of each mesh element.");
+    return OPENMC_E_ALLOCATE;
+  }
+  return 0;
+}
+
 extern "C" int openmc_mesh_get_plot_bins(int32_t index, Position origin,
   Position width, int basis, int* pixels, int32_t* data)
 {
@@ -2223,6 +2930,16 @@ const std::string MOABMesh::mesh_lib_type = "moab";
 
 MOABMesh::MOABMesh(pugi::xml_node node) : UnstructuredMesh(node)
 {
+  // check which method is used to find the tets crossed by a track
+  if (check_for_node(node, "tracker")) {
+    auto tracker = get_node_value(node, "tracker", true, true);
+    if (tracker == "adjacency") {
+      adjacency_walk_ = true;
+    } else if (tracker != "kdtree") {
+      fatal_error(fmt::format(
+        "Invalid tracker '{}' for unstructured mesh {}.", tracker, id_));
+    }
+  }
   initialize();
 }
 
@@ -2324,6 +3041,8 @@ void MOABMesh::prepare_for_tallies()
   // build acceleration data structures
   compute_barycentric_data(ehs_);
   build_kdtree(ehs_);
+  compute_adjacency_data();
+  last_bin_.assign(num_threads(), -1);
 }
 
 void MOABMesh::create_interface()
@@ -2421,6 +3140,13 @@ void MOABMesh::bins_crossed(Position r0, Position r1, const Direction& u,
   if (track_len == 0.0)
     return;
 
+  if (adjacency_walk_) {
+    bins.clear();
+    lengths.clear();
+    walk_track(r0, u, track_len, bins, lengths);
+    return;
+  }
+
   start -= TINY_BIT * dir;
   end += TINY_BIT * dir;
 
@@ -2482,6 +3208,85 @@ void MOABMesh::bins_crossed(Position r0, Position r1, const Direction& u,
   }
 };
 
+void MOABMesh::walk_track(Position r0, const Direction& u, double track_len,
+  vector<int>& bins, vector<double>& lengths) const
+{
+  // locate the tet containing the start of the track, entering the mesh
+  // further along the track if the start is outside of it
+  double t = 0.0;
+  int bin = get_bin(r0);
+  if (bin == -1) {
+    bin = find_entry(r0, u, t, track_len, &t);
+  }
+
+  // a straight track crosses each tet at most once
+  for (int n_steps = 0; bin != -1 && n_steps <= n_bins(); ++n_steps) {
+    // the track leaves through the nearest face it is heading out of.
+    // Distances are measured from the start of the track so that round-off
+    // does not accumulate along the walk.
+    int i_exit = -1;
+    double t_exit = INFTY;
+    for (int i = 4 * bin; i < 4 * bin + 4; ++i) {
+      double dot = u.x * face_nx_[i] + u.y * face_ny_[i] + u.z * face_nz_[i];
+      if (dot <= 0.0)
+        continue;
+      double dist = (face_d_[i] - r0.x * face_nx_[i] - r0.y * face_ny_[i] -
+                      r0.z * face_nz_[i]) /
+                    dot;
+      if (dist < t_exit) {
+        t_exit = dist;
+        i_exit = i;
+      }
+    }
+    if (i_exit == -1)
+      break;
+
+    double t_end = std::min(std::max(t_exit, t), track_len);
+    if (t_end > t) {
+      bins.push_back(bin);
+      lengths.push_back((t_end - t) / track_len);
+    }
+    t = t_end;
+    if (t >= track_len)
+      break;
+
+    // move into the neighboring tet or, at a boundary of the mesh, to where
+    // the track enters it again
+    bin = face_neighbor_[i_exit];
+    if (bin == -1) {
+      bin = find_entry(r0, u, t, track_len, &t);
+    }
+  }
+
+  // the next track of the particle starts where this one ends
+  if (!bins.empty() && thread_num() < last_bin_.size()) {
+    last_bin_[thread_num()] = bins.back();
+  }
+}
+
+int MOABMesh::find_entry(Position r0, const Direction& u, double t,
+  double track_len, double* t_entry) const
+{
+  Position r = r0 + u * t;
+  moab::CartVect start(r.x, r.y, r.z);
+  moab::CartVect dir(u.x, u.y, u.z);
+  vector<double> hits;
+  intersect_track(start, dir, track_len - t, hits);
+
+  // the first face hit with a tet just behind it is where the mesh is entered
+  for (auto hit : hits) {
+    double s = t + hit + TINY_BIT;
+    if (s >= track_len)
+      break;
+    int bin = get_bin(r0 + u * s);
+    if (bin != -1) {
+      *t_entry = t + hit;
+      return bin;
+    }
+  }
+  return -1;
+}
+
 moab::EntityHandle MOABMesh::get_tet(const Position& r) const
 {
   moab::CartVect pos(r.x, r.y, r.z);
@@ -2569,12 +3374,35 @@ double MOABMesh::tet_volume(moab::EntityHandle tet) const
 
 int MOABMesh::get_bin(Position r) const
 {
+  // successive lookups by a thread are usually for the same particle, so the
+  // tet found last and its neighbors are checked before the k-d tree
+  int* hint = nullptr;
+  if (thread_num() < last_bin_.size()) {
+    hint = &last_bin_[thread_num()];
+    if (*hint != -1) {
+      moab::CartVect pos(r.x, r.y, r.z);
+      if (point_in_tet(pos, get_ent_handle_from_bin(*hint)))
+        return *hint;
+      if (!face_neighbor_.empty()) {
+        for (int i = 4 * (*hint); i < 4 * (*hint) + 4; ++i) {
+          int bin = face_neighbor_[i];
+          if (bin != -1 && point_in_tet(pos, get_ent_handle_from_bin(bin))) {
+            *hint = bin;
+            return bin;
+          }
+        }
+      }
+    }
+  }
+
   moab::EntityHandle tet = get_tet(r);
   if (tet == 0) {
     return -1;
-  } else {
-    return get_bin_from_ent_handle(tet);
   }
+  int bin = get_bin_from_ent_handle(tet);
+  if (hint)
+    *hint = bin;
+  return bin;
 }
 
 void MOABMesh::compute_barycentric_data(const moab::Range& tets)
@@ -2607,6 +3435,85 @@ void MOABMesh::compute_barycentric_data(const moab::Range& tets)
   }
 }
 
+void MOABMesh::compute_adjacency_data()
+{
+  if (!ehs_.all_of_type(moab::MBTET)) {
+    if (adjacency_walk_) {
+      fatal_error(
+        "The adjacency tracker requires a mesh of only tetrahedra: " +
+        filename_);
+    }
+    return;
+  }
+
+  // face planes are only needed when walking tracks through the mesh
+  int n_faces = 4 * n_bins();
+  if (adjacency_walk_) {
+    face_nx_.resize(n_faces);
+    face_ny_.resize(n_faces);
+    face_nz_.resize(n_faces);
+    face_d_.resize(n_faces);
+  }
+  face_neighbor_.assign(n_faces, -1);
+
+  // vertices of each face, sorted so that a face shared by two tets has the
+  // same key in both
+  vector<std::pair<std::array<moab::EntityHandle, 3>, int>> keys;
+  keys.reserve(n_faces);
+
+  for (const auto& tet : ehs_) {
+    const moab::EntityHandle* conn;
+    int n_conn;
+    moab::ErrorCode rval = mbi_->get_connectivity(tet, conn, n_conn);
+    if (rval != moab::MB_SUCCESS || n_conn != 4) {
+      fatal_error("Failed to get connectivity of tet on umesh: " + filename_);
+    }
+
+    moab::CartVect p[4];
+    rval = mbi_->get_coords(conn, n_conn, p[0].array());
+    if (rval != moab::MB_SUCCESS) {
+      fatal_error("Failed to get coordinates of a tet in umesh: " + filename_);
+    }
+
+    int bin = get_bin_from_ent_handle(tet);
+    for (int k = 0; k < 4; ++k) {
+      int v1 = (k + 1) % 4;
+      int v2 = (k + 2) % 4;
+      int v3 = (k + 3) % 4;
+      int i = 4 * bin + k;
+
+      if (adjacency_walk_) {
+        // orient the normal away from the vertex opposite the face
+        moab::CartVect n = (p[v2] - p[v1]) * (p[v3] - p[v1]);
+        n.normalize();
+        double d = n % p[v1];
+        if (n % p[k] > d) {
+          n *= -1.0;
+          d = -d;
+        }
+        face_nx_[i] = n[0];
+        face_ny_[i] = n[1];
+        face_nz_[i] = n[2];
+        face_d_[i] = d;
+      }
+
+      std::array<moab::EntityHandle, 3> key {conn[v1], conn[v2], conn[v3]};
+      std::sort(key.begin(), key.end());
+      keys.emplace_back(key, i);
+    }
+  }
+
+  // once sorted, the two sides of an interior face are next to each other
+  std::sort(keys.begin(), keys.end());
+  for (int i = 0; i + 1 < keys.size(); ++i) {
+    if (keys[i].first == keys[i + 1].first) {
+      face_neighbor_[keys[i].second] = keys[i + 1].second / 4;
+      face_neighbor_[keys[i + 1].second] = keys[i].second / 4;
+      ++i;
+    }
+  }
+}
+
 bool MOABMesh::point_in_tet(
   const moab::CartVect& r, moab::EntityHandle tet) const
 {
@@ -2993,11 +3900,22 @@ void LibMesh::initialize()
     pl_.back()->set_contains_point_tol(FP_COINCIDENT);
     pl_.back()->enable_out_of_mesh_mode();
   }
+  last_elem_.assign(num_threads(), nullptr);
 
   // store first element in the mesh to use as an offset for bin indices
   auto first_elem = *m_->elements_begin();
   first_element_id_ = first_elem->id();
 
+  // sides on the outer boundary of the mesh or of holes in it, through which
+  // tracks may enter the mesh
+  boundary_sides_.clear();
+  for (const auto* elem : m_->active_element_ptr_range()) {
+    for (unsigned int s = 0; s < elem->n_sides(); ++s) {
+      if (!elem->neighbor_ptr(s))
+        boundary_sides_.emplace_back(elem->id(), s);
+    }
+  }
+
   // bounding box for the mesh for quick rejection checks
   bbox_ = libMesh::MeshTools::create_bounding_box(*m_);
   libMesh::Point ll = bbox_.min();
@@ -3122,18 +4040,20 @@ void LibMesh::set_score_data(const std::string& var_name,
   std::string std_dev_name = var_name + "_std_dev";
   unsigned int std_dev_num = variable_map_.at(std_dev_name);
 
+  // The index vectors are reused for all elements to avoid allocating them
+  // for each one
+  vector<libMesh::dof_id_type> value_dof_indices;
+  vector<libMesh::dof_id_type> std_dev_dof_indices;
   for (auto it = m_->local_elements_begin(); it != m_->local_elements_end();
        it++) {
     auto bin = get_bin_from_element(*it);
 
     // set value
-    vector<libMesh::dof_id_type> value_dof_indices;
     dof_map.dof_indices(*it, value_dof_indices, value_num);
     Ensures(value_dof_indices.size() == 1);
     eqn_sys.solution->set(value_dof_indices[0], values.at(bin));
 
     // set std dev
-    vector<libMesh::dof_id_type> std_dev_dof_indices;
     dof_map.dof_indices(*it, std_dev_dof_indices, std_dev_num);
     Ensures(std_dev_dof_indices.size() == 1);
     eqn_sys.solution->set(std_dev_dof_indices[0], std_dev.at(bin));
@@ -3150,11 +4070,170 @@ void LibMesh::write(const std::string& filename) const
     filename + ".e", *equation_systems_, &systems_out);
 }
 
+namespace {
+
+//! Average of the vertices of an element
+Position vertex_average(const libMesh::Elem& elem)
+{
+  Position center {0.0, 0.0, 0.0};
+  for (unsigned int i = 0; i < elem.n_vertices(); ++i) {
+    const auto& v = elem.point(i);
+    center += Position {v(0), v(1), v(2)};
+  }
+  return center / elem.n_vertices();
+}
+
+//! Plane through a side of an element
+//
+//! Sides of hexahedra need not be planar, so the plane passes through the
+//! average of the vertices with the normal found by Newell's method.
+//! \param[in] side  Side of the element
+//! \param[in] center  Point inside the element
+//! \return Point on the plane and normal pointing out of the element
+std::pair<Position, Direction> side_plane(
+  const libMesh::Elem& side, Position center)
+{
+  int n = side.n_vertices();
+  Position point {0.0, 0.0, 0.0};
+  Direction normal {0.0, 0.0, 0.0};
+  for (int i = 0; i < n; ++i) {
+    const auto& a = side.point(i);
+    const auto& b = side.point((i + 1) % n);
+    normal.x += (a(1) - b(1)) * (a(2) + b(2));
+    normal.y += (a(2) - b(2)) * (a(0) + b(0));
+    normal.z += (a(0) - b(0)) * (a(1) + b(1));
+    point += Position {a(0), a(1), a(2)};
+  }
+  point /= n;
+  if (normal.dot(point - center) < 0.0)
+    normal = -normal;
+  return {point, normal};
+}
+
+//! Whether a point on the plane of a side lies within the side
+bool side_contains(const libMesh::Elem& side, Position r, Direction normal)
+{
+  int n = side.n_vertices();
+  int n_pos = 0;
+  int n_neg = 0;
+  for (int i = 0; i < n; ++i) {
+    const auto& a = side.point(i);
+    const auto& b = side.point((i + 1) % n);
+    Position va {a(0), a(1), a(2)};
+    Position vb {b(0), b(1), b(2)};
+    double s = (vb - va).cross(r - va).dot(normal);
+    if (s > FP_COINCIDENT * normal.norm())
+      ++n_pos;
+    else if (s < -FP_COINCIDENT * normal.norm())
+      ++n_neg;
+  }
+  return n_pos == 0 || n_neg == 0;
+}
+
+} // namespace
+
+std::pair<const libMesh::Elem*, double> LibMesh::find_entry(
+  Position r0, Direction u, double t_min, double t_max) const
+{
+  const libMesh::Elem* entry = nullptr;
+  double t_entry = t_max;
+  for (const auto& boundary_side : boundary_sides_) {
+    const auto& elem = m_->elem_ref(boundary_side.first);
+    auto side = elem.side_ptr(boundary_side.second);
+    auto [point, normal] = side_plane(*side, vertex_average(elem));
+
+    // The track enters through sides it crosses against their normal
+    double proj = normal.dot(u);
+    if (proj >= 0.0)
+      continue;
+    double t = normal.dot(point - r0) / proj;
+    if (t < t_min || t >= t_entry)
+      continue;
+    if (side_contains(*side, r0 + t * u, normal)) {
+      entry = &elem;
+      t_entry = t;
+    }
+  }
+  return {entry, t_entry};
+}
+
 void LibMesh::bins_crossed(Position r0, Position r1, const Direction& u,
   vector<int>& bins, vector<double>& lengths) const
 {
-  // TODO: Implement triangle crossings here
-  fatal_error("Tracklength tallies on libMesh instances are not implemented.");
+  bins.clear();
+  lengths.clear();
+
+  double track_len = (r1 - r0).norm();
+  if (track_len == 0.0)
+    return;
+
+  // Quick rejection of tracks that miss the bounding box of the mesh
+  double t_lo = 0.0;
+  double t_hi = track_len;
+  for (int i = 0; i < 3; ++i) {
+    if (u[i] == 0.0) {
+      if (r0[i] < lower_left_[i] || r0[i] > upper_right_[i])
+        return;
+    } else {
+      double t1 = (lower_left_[i] - r0[i]) / u[i];
+      double t2 = (upper_right_[i] - r0[i]) / u[i];
+      t_lo = std::max(t_lo, std::min(t1, t2));
+      t_hi = std::min(t_hi, std::max(t1, t2));
+    }
+  }
+  if (t_lo > t_hi)
+    return;
+
+  // Locate the element containing the start of the track, or otherwise the
+  // element through which it first enters the mesh
+  double t = 0.0;
+  const libMesh::Elem* elem = locate(libMesh::Point(r0.x, r0.y, r0.z));
+  if (!elem)
+    std::tie(elem, t) = find_entry(r0, u, 0.0, track_len);
+
+  // Walk from each element to its neighbor through the side where the track
+  // leaves it. Elements are convex, so this is the nearest side the track
+  // crosses in the direction of its normal.
+  int n_steps = 0;
+  while (elem) {
+    Position center = vertex_average(*elem);
+    double t_exit = INFTY;
+    unsigned int s_exit = 0;
+    for (unsigned int s = 0; s < elem->n_sides(); ++s) {
+      auto side = elem->side_ptr(s);
+      auto [point, normal] = side_plane(*side, center);
+      double proj = normal.dot(u);
+      if (proj <= 0.0)
+        continue;
+      double t_side = normal.dot(point - r0) / proj;
+      if (t_side < t_exit) {
+        t_exit = t_side;
+        s_exit = s;
+      }
+    }
+    t_exit = std::max(t_exit, t);
+
+    double t_end = std::min(t_exit, track_len);
+    if (t_end > t) {
+      bins.push_back(get_bin_from_element(elem));
+      lengths.push_back((t_end - t) / track_len);
+    }
+
+    // Stop at the end of the track, or if the walk fails to make progress
+    // around a degenerate crossing. The next track of the particle starts in
+    // the element where this one ends.
+    if (t_exit >= track_len || ++n_steps > n_bins()) {
+      last_elem_[thread_num()] = elem;
+      break;
+    }
+
+    // Move to the neighbor, or search for where the track reenters the mesh
+    // if it leaves through the outer boundary or a hole
+    t = t_exit;
+    elem = elem->neighbor_ptr(s_exit);
+    if (!elem)
+      std::tie(elem, t) = find_entry(r0, u, t, track_len);
+  }
 }
 
 int LibMesh::get_bin(Position r) const
@@ -3167,12 +4246,33 @@ int LibMesh::get_bin(Position r) const
     return -1;
   }
 
-  const auto& point_locator = pl_.at(thread_num());
-
-  const auto elem_ptr = (*point_locator)(p);
+  const auto elem_ptr = locate(p);
   return elem_ptr ? get_bin_from_element(elem_ptr) : -1;
 }
 
+const libMesh::Elem* LibMesh::locate(const libMesh::Point& p) const
+{
+  // successive lookups by a thread are usually for the same particle, so the
+  // element found last and its neighbors are checked before the point locator
+  auto& hint = last_elem_.at(thread_num());
+  if (hint) {
+    if (hint->contains_point(p, FP_COINCIDENT))
+      return hint;
+    for (unsigned int s = 0; s < hint->n_sides(); ++s) {
+      const auto* neighbor = hint->neighbor_ptr(s);
+      if (neighbor && neighbor->contains_point(p, FP_COINCIDENT)) {
+        hint = neighbor;
+        return neighbor;
+      }
+    }
+  }
+
+  const auto elem_ptr = (*pl_.at(thread_num()))(p);
+  if (elem_ptr)
+    hint = elem_ptr;
+  return elem_ptr;
+}
+
 int LibMesh::get_bin_from_element(const libMesh::Elem* elem) const
 {
   int bin = elem->id() - first_element_id_;
@@ -3247,6 +4347,8 @@ void read_meshes(pugi::xml_node root)
       model::meshes.push_back(make_unique<CylindricalMesh>(node));
     } else if (mesh_type == SphericalMesh::mesh_type) {
       model::meshes.push_back(make_unique<SphericalMesh>(node));
+    } else if (mesh_type == OctreeMesh::mesh_type) {
+      model::meshes.push_back(make_unique<OctreeMesh>(node));
 #ifdef DAGMC
     } else if (mesh_type == UnstructuredMesh::mesh_type &&
                mesh_lib == MOABMesh::mesh_lib_type) {
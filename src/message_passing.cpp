@@ -1,15 +1,99 @@
 #include "openmc/message_passing.h"
 
+#include "openmc/settings.h"
+
+#include <algorithm> // for copy, max, min
+
 namespace openmc {
 namespace mpi {
 
 int rank {0};
 int n_procs {1};
 bool master {true};
+int n_nodes {1};
 
 #ifdef OPENMC_MPI
 MPI_Comm intracomm {MPI_COMM_NULL};
+MPI_Comm node_intracomm {MPI_COMM_NULL};
+MPI_Comm leader_intracomm {MPI_COMM_NULL};
 MPI_Datatype source_site {MPI_DATATYPE_NULL};
+MPI_Datatype fission_site {MPI_DATATYPE_NULL};
+
+namespace {
+
+//! Minimum number of values in a segment of memory shared on a node. Arrays
+//! are carved out of large segments since the number of windows that can be
+//! created is limited.
+constexpr size_t SHARED_SEGMENT_SIZE {size_t {1} << 25};
+
+struct SharedSegment {
+  MPI_Win win;  //!< Window exposing the segment
+  double* data; //!< Start of the segment on this process
+  size_t size;  //!< Number of values in the segment
+  size_t used;  //!< Number of values handed out
+};
+
+vector<SharedSegment> shared_segments;
+
+//! Number of values in each segment of a reduction. The count of every
+//! message stays within the range of an int, and segments of a hierarchical
+//! reduction are small enough to pipeline the two stages.
+constexpr int64_t REDUCE_SEGMENT {1 << 26};
+constexpr int64_t HIERARCHICAL_SEGMENT {1 << 20};
+
+//! Sums over the processes of the node on the first process of a node other
+//! than the master, kept until the reduction across nodes completes
+vector<double> node_sums;
+
+//! Whether reductions go through the first process of each node
+bool hierarchical()
+{
+  return settings::hierarchical_reduce && n_nodes > 1 && n_nodes < n_procs;
+}
+
+//! Copy an array into memory shared on the node and release the original
+template<typename T>
+gsl::span<T> share_values(vector<T>& data)
+{
+  // Number of segment values needed to hold the array
+  size_t n = (data.size() * sizeof(T) + sizeof(double) - 1) / sizeof(double);
+  int node_rank;
+  MPI_Comm_rank(node_intracomm, &node_rank);
+
+  // Allocate a new segment, owned by the first process on the node, if the
+  // array does not fit in the current one
+  if (shared_segments.empty() ||
+      shared_segments.back().used + n > shared_segments.back().size) {
+    SharedSegment seg;
+    seg.size = std::max(n, SHARED_SEGMENT_SIZE);
+    seg.used = 0;
+    MPI_Aint bytes = (node_rank == 0) ? seg.size * sizeof(double) : 0;
+    MPI_Win_allocate_shared(bytes, sizeof(double), MPI_INFO_NULL,
+      node_intracomm, &seg.data, &seg.win);
+    MPI_Aint size;
+    int disp_unit;
+    MPI_Win_shared_query(seg.win, 0, &size, &disp_unit, &seg.data);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, seg.win);
+    shared_segments.push_back(seg);
+  }
+  auto& seg = shared_segments.back();
+  T* ptr = reinterpret_cast<T*>(seg.data + seg.used);
+  seg.used += n;
+
+  // Make the values written by the first process visible to all others
+  if (node_rank == 0)
+    std::copy(data.begin(), data.end(), ptr);
+  MPI_Win_sync(seg.win);
+  MPI_Barrier(node_intracomm);
+  MPI_Win_sync(seg.win);
+
+  size_t size = data.size();
+  data.clear();
+  data.shrink_to_fit();
+  return {ptr, size};
+}
+
+} // namespace
 #endif
 
 extern "C" bool openmc_master()
@@ -38,6 +122,117 @@ vector<int64_t> calculate_parallel_index_vector(int64_t size)
   return result;
 }
 
+gsl::span<double> share_on_node(vector<double>& data)
+{
+#ifdef OPENMC_MPI
+  return share_values(data);
+#else
+  return {data.data(), data.size()};
+#endif
+}
+
+gsl::span<float> share_on_node(vector<float>& data)
+{
+#ifdef OPENMC_MPI
+  return share_values(data);
+#else
+  return {data.data(), data.size()};
+#endif
+}
+
+#ifdef OPENMC_MPI
+void reduce_sum(const double* values, double* reduced, int64_t n,
+  vector<MPI_Request>* requests)
+{
+  if (!hierarchical()) {
+    for (int64_t i = 0; i < n; i += REDUCE_SEGMENT) {
+      int m = std::min(REDUCE_SEGMENT, n - i);
+      double* recv = master ? reduced + i : nullptr;
+      if (requests) {
+        requests->emplace_back();
+        MPI_Ireduce(values + i, recv, m, MPI_DOUBLE, MPI_SUM, 0, intracomm,
+          &requests->back());
+      } else {
+        MPI_Reduce(values + i, recv, m, MPI_DOUBLE, MPI_SUM, 0, intracomm);
+      }
+    }
+    return;
+  }
+
+  // The master is the first process of its node, so its node sums can be
+  // reduced across nodes in place
+  bool leader = leader_intracomm != MPI_COMM_NULL;
+  double* sums = reduced;
+  if (leader && !master) {
+    node_sums.resize(n);
+    sums = node_sums.data();
+  }
+
+  vector<MPI_Request> pending;
+  auto& reqs = requests ? *requests : pending;
+  for (int64_t i = 0; i < n; i += HIERARCHICAL_SEGMENT) {
+    int m = std::min(HIERARCHICAL_SEGMENT, n - i);
+    MPI_Reduce(values + i, leader ? sums + i : nullptr, m, MPI_DOUBLE, MPI_SUM,
+      0, node_intracomm);
+    if (leader) {
+      reqs.emplace_back();
+      MPI_Ireduce(master ? MPI_IN_PLACE : sums + i, sums + i, m, MPI_DOUBLE,
+        MPI_SUM, 0, leader_intracomm, &reqs.back());
+    }
+  }
+  if (!requests)
+    MPI_Waitall(pending.size(), pending.data(), MPI_STATUSES_IGNORE);
+}
+
+void allreduce_sum(double* values, int64_t n)
+{
+  if (!hierarchical()) {
+    for (int64_t i = 0; i < n; i += REDUCE_SEGMENT) {
+      int m = std::min(REDUCE_SEGMENT, n - i);
+      MPI_Allreduce(
+        MPI_IN_PLACE, values + i, m, MPI_DOUBLE, MPI_SUM, intracomm);
+    }
+    return;
+  }
+
+  // Each segment summed on the node is reduced across nodes while the next
+  // segment is summed on the node. The sums are then broadcast on each node
+  // in the same order.
+  bool leader = leader_intracomm != MPI_COMM_NULL;
+  vector<MPI_Request> requests;
+  for (int64_t i = 0; i < n; i += HIERARCHICAL_SEGMENT) {
+    int m = std::min(HIERARCHICAL_SEGMENT, n - i);
+    if (leader) {
+      MPI_Reduce(
+        MPI_IN_PLACE, values + i, m, MPI_DOUBLE, MPI_SUM, 0, node_intracomm);
+      requests.emplace_back();
+      MPI_Iallreduce(MPI_IN_PLACE, values + i, m, MPI_DOUBLE, MPI_SUM,
+        leader_intracomm, &requests.back());
+    } else {
+      MPI_Reduce(
+        values + i, nullptr, m, MPI_DOUBLE, MPI_SUM, 0, node_intracomm);
+    }
+  }
+  for (int64_t i = 0, k = 0; i < n; i += HIERARCHICAL_SEGMENT, ++k) {
+    int m = std::min(HIERARCHICAL_SEGMENT, n - i);
+    if (leader)
+      MPI_Wait(&requests[k], MPI_STATUS_IGNORE);
+    MPI_Bcast(values + i, m, MPI_DOUBLE, 0, node_intracomm);
+  }
+}
+#endif
+
+void free_shared_memory()
+{
+#ifdef OPENMC_MPI
+  for (auto& seg : shared_segments) {
+    MPI_Win_unlock_all(seg.win);
+    MPI_Win_free(&seg.win);
+  }
+  shared_segments.clear();
+#endif
+}
+
 } // namespace mpi
 
 } // namespace openmc
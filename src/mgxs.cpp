@@ -289,6 +289,8 @@ Mgxs::Mgxs(
 
   // Make sure the scattering format is updated to the final case
   scatter_format = final_scatter_format;
+
+  init_tracking_xs();
 }
 
 //==============================================================================
@@ -397,6 +399,26 @@ Mgxs::Mgxs(const std::string& in_name, const vector<double>& mat_kTs,
     // And finally, combine the data
     combine(mgxs_to_combine, interpolant, temp_indices, t);
   } // end temperature (t) loop
+
+  init_tracking_xs();
+}
+
+//==============================================================================
+
+void Mgxs::init_tracking_xs()
+{
+  n_ang = xs.empty() ? 0 : xs[0].total.shape()[0];
+  tracking_xs.resize(3 * xs.size() * n_ang * num_groups);
+  int i = 0;
+  for (const auto& data : xs) {
+    for (int a = 0; a < n_ang; ++a) {
+      for (int g = 0; g < num_groups; ++g) {
+        tracking_xs[i++] = data.total(a, g);
+        tracking_xs[i++] = data.absorption(a, g);
+        tracking_xs[i++] = fissionable ? data.nu_fission(a, g) : 0.;
+      }
+    }
+  }
 }
 
 //==============================================================================
@@ -584,29 +606,25 @@ void Mgxs::sample_scatter(
 
 void Mgxs::calculate_xs(Particle& p)
 {
-  // If the material is different, then we need to do a full lookup
-  if (p.material() != p.mg_xs_cache().material) {
+  // The temperature index depends on the temperatures of the material, so it
+  // is found again whenever the material or temperature changes
+  if (p.material() != p.mg_xs_cache().material ||
+      p.sqrtkT() != p.mg_xs_cache().sqrtkT) {
     set_temperature_index(p);
-    set_angle_index(p);
     p.mg_xs_cache().material = p.material();
-  } else {
-    // If material is the same, but temperature is different, need to
-    // find the new temperature index
-    if (p.sqrtkT() != p.mg_xs_cache().sqrtkT) {
-      set_temperature_index(p);
-    }
-    // If the material is the same, but angle is different, need to
-    // find the new angle index
-    if (p.u_local() != p.mg_xs_cache().u) {
-      set_angle_index(p);
-    }
   }
+
+  // The angle index only depends on the direction and the angular bins, so it
+  // is kept across surface crossings into materials with the same bins
+  set_angle_index(p);
+
   int temperature = p.mg_xs_cache().t;
   int angle = p.mg_xs_cache().a;
-  p.macro_xs().total = xs[temperature].total(angle, p.g());
-  p.macro_xs().absorption = xs[temperature].absorption(angle, p.g());
-  p.macro_xs().nu_fission =
-    fissionable ? xs[temperature].nu_fission(angle, p.g()) : 0.;
+  const double* values =
+    &tracking_xs[3 * ((temperature * n_ang + angle) * num_groups + p.g())];
+  p.macro_xs().total = values[0];
+  p.macro_xs().absorption = values[1];
+  p.macro_xs().nu_fission = values[2];
 }
 
 //==============================================================================
@@ -626,7 +644,14 @@ bool Mgxs::equiv(const Mgxs& that)
 
 int Mgxs::get_temperature_index(double sqrtkT) const
 {
-  return xt::argmin(xt::abs(kTs - sqrtkT * sqrtkT))[0];
+  // Find the nearest temperature without building temporary arrays
+  double kT = sqrtkT * sqrtkT;
+  int t = 0;
+  for (int i = 1; i < kTs.size(); ++i) {
+    if (std::abs(kTs[i] - kT) < std::abs(kTs[t] - kT))
+      t = i;
+  }
+  return t;
 }
 
 //==============================================================================
@@ -662,10 +687,17 @@ int Mgxs::get_angle_index(const Direction& u) const
 
 void Mgxs::set_angle_index(Particle& p)
 {
-  // See if we need to find the new index
-  if (!is_isotropic) {
-    p.mg_xs_cache().a = get_angle_index(p.u_local());
-    p.mg_xs_cache().u = p.u_local();
+  auto& cache = p.mg_xs_cache();
+  if (is_isotropic) {
+    cache.a = 0;
+    cache.n_pol = 0;
+  } else if (p.u_local() != cache.u || cache.n_pol != n_pol ||
+             cache.n_azi != n_azi) {
+    // See if we need to find the new index
+    cache.a = get_angle_index(p.u_local());
+    cache.u = p.u_local();
+    cache.n_pol = n_pol;
+    cache.n_azi = n_azi;
   }
 }
 
@@ -3,6 +3,9 @@
 #include "openmc/error.h"
 #include "openmc/material.h"
 #include "openmc/random_lcg.h"
+#include "openmc/settings.h"
+
+#include <cmath> // for abs, exp, log
 
 namespace openmc {
 
@@ -16,6 +19,51 @@ const bool NCRYSTAL_ENABLED = true;
 const bool NCRYSTAL_ENABLED = false;
 #endif
 
+namespace {
+
+//! Number of intervals of the coarsest and finest log-uniform grids used to
+//! tabulate NCrystal cross sections
+constexpr int MIN_XS_TABLE_BINS {256};
+constexpr int MAX_XS_TABLE_BINS {65536};
+
+} // namespace
+
+//==============================================================================
+// NCrystalXSTable implementation
+//==============================================================================
+
+NCrystalXSTable::NCrystalXSTable(double log_E_min, double log_E_max,
+  double tolerance, const std::function<double(double)>& evaluate)
+  : log_E_min_ {log_E_min}
+{
+  int n_bins = MIN_XS_TABLE_BINS;
+  while (true) {
+    double spacing = (log_E_max - log_E_min) / n_bins;
+    values_.resize(n_bins + 1);
+    for (int j = 0; j <= n_bins; ++j) {
+      values_[j] = evaluate(log_E_min + j * spacing);
+    }
+
+    // A step anywhere in an interval makes the interpolation at its middle
+    // miss by half the step, so checking the middle also catches Bragg edges
+    exact_.assign(n_bins, false);
+    int n_failed = 0;
+    for (int j = 0; j < n_bins; ++j) {
+      double xs = evaluate(log_E_min + (j + 0.5) * spacing);
+      double value = 0.5 * (values_[j] + values_[j + 1]);
+      if (std::abs(value - xs) > tolerance * xs) {
+        exact_[j] = true;
+        ++n_failed;
+      }
+    }
+    if (n_failed == 0 || n_bins >= MAX_XS_TABLE_BINS)
+      break;
+    n_bins *= 2;
+  }
+
+  inv_spacing_ = n_bins / (log_E_max - log_E_min);
+}
+
 //==============================================================================
 // NCrystal wrapper class for the OpenMC random number generator
 //==============================================================================
@@ -46,6 +94,18 @@ NCrystalMat::NCrystalMat(const std::string& cfg)
 #ifdef NCRYSTAL
   cfg_ = cfg;
   ptr_ = NCrystal::FactImpl::createScatter(cfg);
+
+  // The cross section of an isotropic material only depends on the energy
+  if (settings::ncrystal_xs_tolerance > 0.0 && !ptr_->isOriented()) {
+    auto evaluate = [this](double log_E) {
+      NCrystal::CachePtr dummy_cache;
+      auto nc_energy = NCrystal::NeutronEnergy {std::exp(log_E)};
+      return ptr_->crossSectionIsotropic(dummy_cache, nc_energy).get();
+    };
+    table_ = std::make_shared<NCrystalXSTable>(
+      std::log(NCRYSTAL_TABLE_MIN_ENERGY), std::log(NCRYSTAL_MAX_ENERGY),
+      settings::ncrystal_xs_tolerance, evaluate);
+  }
 #else
   fatal_error("Your build of OpenMC does not support NCrystal materials.");
 #endif
@@ -59,6 +119,10 @@ std::string NCrystalMat::cfg() const
 
 double NCrystalMat::xs(const Particle& p) const
 {
+  double xs;
+  if (table_ && table_->interpolate(std::log(p.E()), xs))
+    return xs;
+
   // Calculate scattering XS per atom with NCrystal, only once per material
   NCrystal::CachePtr dummy_cache;
   auto nc_energy = NCrystal::NeutronEnergy {p.E()};
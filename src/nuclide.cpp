@@ -14,6 +14,7 @@
 #include "openmc/simulation.h"
 #include "openmc/string_utils.h"
 #include "openmc/thermal.h"
+#include "openmc/xs_cache.h"
 
 #include <fmt/core.h>
 
@@ -21,6 +22,7 @@
 #include "xtensor/xview.hpp"
 
 #include <algorithm> // for sort, min_element
+#include <limits>    // for numeric_limits
 #include <string>    // for to_string, stoi
 
 namespace openmc {
@@ -36,8 +38,18 @@ double temperature_min {INFTY};
 double temperature_max {0.0};
 std::unordered_map<std::string, int> nuclide_map;
 vector<unique_ptr<Nuclide>> nuclides;
+vector<double> union_energy;
+PackedXS packed_xs;
 } // namespace data
 
+namespace {
+
+//! Number of 0K elastic cross section points in each block of the maxima
+//! used for Doppler broadening rejection correction
+constexpr int ELASTIC_0K_BLOCK_SIZE {64};
+
+} // namespace
+
 //==============================================================================
 // Nuclide implementation
 //==============================================================================
@@ -48,7 +60,8 @@ int Nuclide::XS_FISSION {2};
 int Nuclide::XS_NU_FISSION {3};
 int Nuclide::XS_PHOTON_PROD {4};
 
-Nuclide::Nuclide(hid_t group, const vector<double>& temperature)
+Nuclide::Nuclide(
+  hid_t group, const vector<double>& temperature, bool derive)
 {
   // Set index of nuclide in global vector
   index_ = data::nuclides.size();
@@ -62,6 +75,10 @@ Nuclide::Nuclide(hid_t group, const vector<double>& temperature)
   read_attribute(group, "metastable", metastable_);
   read_attribute(group, "atomic_weight_ratio", awr_);
 
+  // Photons only need the atomic weight ratio to normalize material densities
+  if (settings::photon_only)
+    return;
+
   if (settings::run_mode == RunMode::VOLUME) {
     // Determine whether nuclide is fissionable and then exit
     int mt;
@@ -346,7 +363,8 @@ Nuclide::Nuclide(hid_t group, const vector<double>& temperature)
     close_group(fer_group);
   }
 
-  this->create_derived(prompt_photons_.get(), delayed_photons_.get());
+  if (derive)
+    this->create_derived();
 }
 
 Nuclide::~Nuclide()
@@ -354,13 +372,31 @@ Nuclide::~Nuclide()
   data::nuclide_map.erase(name_);
 }
 
-void Nuclide::create_derived(
-  const Function1D* prompt_photons, const Function1D* delayed_photons)
+void Nuclide::create_derived()
 {
-  for (const auto& grid : grid_) {
+  const Function1D* prompt_photons = prompt_photons_.get();
+  const Function1D* delayed_photons = delayed_photons_.get();
+
+  for (int t = 0; t < grid_.size(); ++t) {
+    array<size_t, 2> shape {grid_[t].energy.size(), 5};
+    size_t n = shape[0] * shape[1];
+
+    // Use the cross sections in the cache if present. The table is never
+    // modified in that case, so it can view the read-only mapping.
+    int T = std::round(kTs_[t] / K_BOLTZMANN);
+    gsl::span<const double> cached;
+    if (data::xs_cache.find(xs_cache_key(name_, T), cached) &&
+        cached.size() == n) {
+      xs_data_.emplace_back();
+      xs_.push_back(xt::adapt(
+        const_cast<double*>(cached.data()), n, xt::no_ownership(), shape));
+      continue;
+    }
+
     // Allocate and initialize cross section
-    array<size_t, 2> shape {grid.energy.size(), 5};
-    xs_.emplace_back(shape, 0.0);
+    xs_data_.emplace_back(n, 0.0);
+    xs_.push_back(
+      xt::adapt(xs_data_.back().data(), n, xt::no_ownership(), shape));
   }
 
   reaction_index_.fill(C_NONE);
@@ -372,11 +408,17 @@ void Nuclide::create_derived(
 
     for (int t = 0; t < kTs_.size(); ++t) {
       int j = rx->xs_[t].threshold;
-      int n = rx->xs_[t].value.size();
-      auto xs = xt::adapt(rx->xs_[t].value);
+      const auto& value = rx->xs_[t].value;
+      int n = value.size();
+      auto xs = xt::adapt(value.data(), value.size(), xt::no_ownership(),
+        array<size_t, 1> {value.size()});
+
+      // Tables from the cache already include the contribution of every
+      // reaction
+      bool add = !xs_data_[t].empty();
 
       for (const auto& p : rx->products_) {
-        if (p.particle_ == ParticleType::photon) {
+        if (add && p.particle_ == ParticleType::photon) {
           auto pprod = xt::view(xs_[t], xt::range(j, j + n), XS_PHOTON_PROD);
           for (int k = 0; k < n; ++k) {
             double E = grid_[t].energy[k + j];
@@ -403,21 +445,27 @@ void Nuclide::create_derived(
       if (rx->redundant_)
         continue;
 
-      // Add contribution to total cross section
-      auto total = xt::view(xs_[t], xt::range(j, j + n), XS_TOTAL);
-      total += xs;
+      if (add) {
+        // Add contribution to total cross section
+        auto total = xt::view(xs_[t], xt::range(j, j + n), XS_TOTAL);
+        total += xs;
+
+        // Add contribution to absorption cross section
+        auto absorption =
+          xt::view(xs_[t], xt::range(j, j + n), XS_ABSORPTION);
+        if (is_disappearance(rx->mt_)) {
+          absorption += xs;
+        }
 
-      // Add contribution to absorption cross section
-      auto absorption = xt::view(xs_[t], xt::range(j, j + n), XS_ABSORPTION);
-      if (is_disappearance(rx->mt_)) {
-        absorption += xs;
+        if (is_fission(rx->mt_)) {
+          auto fission = xt::view(xs_[t], xt::range(j, j + n), XS_FISSION);
+          fission += xs;
+          absorption += xs;
+        }
       }
 
       if (is_fission(rx->mt_)) {
         fissionable_ = true;
-        auto fission = xt::view(xs_[t], xt::range(j, j + n), XS_FISSION);
-        fission += xs;
-        absorption += xs;
 
         // Keep track of fission reactions
         if (t == 0) {
@@ -440,7 +488,7 @@ void Nuclide::create_derived(
 
   // Calculate nu-fission cross section
   for (int t = 0; t < kTs_.size(); ++t) {
-    if (fissionable_) {
+    if (fissionable_ && !xs_data_[t].empty()) {
       int n = grid_[t].energy.size();
       for (int i = 0; i < n; ++i) {
         double E = grid_[t].energy[i];
@@ -493,17 +541,236 @@ void Nuclide::create_derived(
           (E[i + 1] - E[i]);
         xs_cdf_[i + 1] = xs_cdf_sum;
       }
+
+      // Block maxima bound the 0K elastic cross section over the window of
+      // relative energies in DBRC without scanning every point in it
+      elastic_0K_max_ = RangeMaximum(elastic_0K_, ELASTIC_0K_BLOCK_SIZE);
+    }
+  }
+
+  if (settings::inelastic_scatter_cdf)
+    this->init_inelastic_cdf();
+  if (settings::photon_product_cdf && settings::photon_transport)
+    this->init_photon_product_cdf();
+}
+
+void Nuclide::init_inelastic_cdf()
+{
+  int n_rx = index_inelastic_scatter_.size();
+  inelastic_cdf_.resize(kTs_.size());
+  if (n_rx == 0)
+    return;
+
+  for (int t = 0; t < kTs_.size(); ++t) {
+    int n = grid_[t].energy.size();
+    auto& cdf = inelastic_cdf_[t];
+
+    // Interpolating the running sums between two points only gives the sum of
+    // the interpolated cross sections if each cross section is zero at its
+    // threshold, since Reaction::xs is zero in the interval below it. The sums
+    // also need to increase monotonically to be searched.
+    cdf.i_start = n;
+    bool valid = true;
+    for (auto i_rx : index_inelastic_scatter_) {
+      const auto& x = reactions_[i_rx]->xs_[t];
+      cdf.i_start = std::min(cdf.i_start, x.threshold);
+      for (auto v : x.value) {
+        if (v < 0.0)
+          valid = false;
+      }
+    }
+    for (auto i_rx : index_inelastic_scatter_) {
+      const auto& x = reactions_[i_rx]->xs_[t];
+      if (x.threshold > cdf.i_start && !x.value.empty() && x.value[0] != 0.0)
+        valid = false;
+    }
+    if (!valid || n - cdf.i_start < 2) {
+      cdf.i_start = 0;
+      continue;
+    }
+
+    cdf.value.assign((n - cdf.i_start) * n_rx, 0.0);
+    for (int i = cdf.i_start; i < n; ++i) {
+      double* row = &cdf.value[(i - cdf.i_start) * n_rx];
+      double sum = 0.0;
+      for (int j = 0; j < n_rx; ++j) {
+        const auto& x = reactions_[index_inelastic_scatter_[j]]->xs_[t];
+        int k = i - x.threshold;
+        if (k >= 0 && k < x.value.size())
+          sum += x.value[k];
+        row[j] = sum;
+      }
+    }
+  }
+}
+
+void Nuclide::init_photon_product_cdf()
+{
+  photon_products_.clear();
+  for (int i = 0; i < reactions_.size(); ++i) {
+    const auto& products = reactions_[i]->products_;
+    for (int j = 0; j < products.size(); ++j) {
+      if (products[j].particle_ == ParticleType::photon)
+        photon_products_.emplace_back(i, j);
+    }
+  }
+  int n_prod = photon_products_.size();
+  photon_product_cdf_.clear();
+  photon_product_cdf_.resize(kTs_.size());
+  if (n_prod == 0)
+    return;
+
+  for (int t = 0; t < kTs_.size(); ++t) {
+    const auto& energy = grid_[t].energy;
+    int n = energy.size();
+    auto& cdf = photon_product_cdf_[t];
+
+    // As for the inelastic sums, each cross section has to be zero at its
+    // threshold and the sums have to increase monotonically. Interpolating
+    // the sums then gives the same total as the photon production cross
+    // section, which is tabulated the same way.
+    cdf.i_start = n;
+    bool valid = true;
+    for (const auto& [i_rx, i_product] : photon_products_) {
+      const auto& x = reactions_[i_rx]->xs_[t];
+      cdf.i_start = std::min(cdf.i_start, x.threshold);
+    }
+    for (const auto& [i_rx, i_product] : photon_products_) {
+      const auto& x = reactions_[i_rx]->xs_[t];
+      if (x.threshold > cdf.i_start && !x.value.empty() && x.value[0] != 0.0)
+        valid = false;
+    }
+    if (!valid || n - cdf.i_start < 2) {
+      cdf.i_start = 0;
+      continue;
+    }
+
+    cdf.value.assign((n - cdf.i_start) * n_prod, 0.0);
+    for (int i = cdf.i_start; i < n && valid; ++i) {
+      double E = energy[i];
+      double* row = &cdf.value[(i - cdf.i_start) * n_prod];
+      double sum = 0.0;
+      for (int j = 0; j < n_prod; ++j) {
+        const auto& rx = *reactions_[photon_products_[j].first];
+        const auto& x = rx.xs_[t];
+        int k = i - x.threshold;
+        if (k >= 0 && k < x.value.size()) {
+          // For fission, artificially increase the photon yield to account
+          // for delayed photons
+          double f = 1.0;
+          if (settings::delayed_photon_scaling && is_fission(rx.mt_) &&
+              prompt_photons_ && delayed_photons_) {
+            double energy_prompt = (*prompt_photons_)(E);
+            double energy_delayed = (*delayed_photons_)(E);
+            f = (energy_prompt + energy_delayed) / energy_prompt;
+          }
+          const auto& product = rx.products_[photon_products_[j].second];
+          double term = f * x.value[k] * (*product.yield_)(E);
+          if (term < 0.0)
+            valid = false;
+          sum += term;
+        }
+        row[j] = sum;
+      }
+    }
+    if (!valid) {
+      cdf.i_start = 0;
+      cdf.value.clear();
+      cdf.value.shrink_to_fit();
     }
   }
 }
 
-void Nuclide::init_grid()
+int Nuclide::find_photon_product(
+  const NuclideMicroXS& micro, double cutoff) const
+{
+  int i_temp = micro.index_temp;
+  if (i_temp < 0 || i_temp >= photon_product_cdf_.size() ||
+      photon_product_cdf_[i_temp].value.empty())
+    return C_NONE;
+
+  // Below the lowest threshold no photons are produced, in which case the
+  // last product is chosen as by the loop over reactions
+  int n = photon_products_.size();
+  const auto& cdf = photon_product_cdf_[i_temp];
+  int i_row = micro.index_grid - cdf.i_start;
+  if (i_row < 0)
+    return n - 1;
+
+  // Find the first product at which the interpolated running sum exceeds the
+  // cutoff
+  const double* lower = &cdf.value[i_row * n];
+  const double* upper = lower + n;
+  double f = micro.interp_factor;
+  int j_low = 0;
+  int j_high = n - 1;
+  while (j_low < j_high) {
+    int j = (j_low + j_high) / 2;
+    if ((1.0 - f) * lower[j] + f * upper[j] <= cutoff) {
+      j_low = j + 1;
+    } else {
+      j_high = j;
+    }
+  }
+  return j_low;
+}
+
+int Nuclide::sample_inelastic_scatter(
+  const NuclideMicroXS& micro, double prob, double cutoff) const
+{
+  int n = index_inelastic_scatter_.size();
+  int i_temp = micro.index_temp;
+  if (i_temp >= 0 && i_temp < inelastic_cdf_.size() &&
+      !inelastic_cdf_[i_temp].value.empty()) {
+    // Every inelastic cross section is zero below the lowest threshold, in
+    // which case the last reaction is chosen as by the loop below
+    const auto& cdf = inelastic_cdf_[i_temp];
+    int i_row = micro.index_grid - cdf.i_start;
+    if (i_row < 0)
+      return index_inelastic_scatter_[n - 1];
+
+    // Find the first reaction at which the interpolated running sum reaches
+    // the cutoff
+    const double* lower = &cdf.value[i_row * n];
+    const double* upper = lower + n;
+    double f = micro.interp_factor;
+    int j_low = 0;
+    int j_high = n - 1;
+    while (j_low < j_high) {
+      int j = (j_low + j_high) / 2;
+      if (prob + (1.0 - f) * lower[j] + f * upper[j] < cutoff) {
+        j_low = j + 1;
+      } else {
+        j_high = j;
+      }
+    }
+    return index_inelastic_scatter_[j_low];
+  }
+
+  int i = 0;
+  for (int j = 0; j < n && prob < cutoff; ++j) {
+    i = index_inelastic_scatter_[j];
+
+    // add to cumulative probability
+    prob += reactions_[i]->xs(micro);
+  }
+  return i;
+}
+
+bool Nuclide::init_grid()
 {
   int neutron = static_cast<int>(ParticleType::neutron);
   double E_min = data::energy_min[neutron];
   double E_max = data::energy_max[neutron];
   int M = settings::n_log_bins;
 
+  // Simulations that follow each other, e.g. the steps of a depletion
+  // calculation, usually share the same energy limits
+  if (!grid_.empty() && grid_[0].grid_index.size() == M + 1 &&
+      grid_limits_[0] == E_min && grid_limits_[1] == E_max)
+    return false;
+  grid_limits_ = {E_min, E_max};
+
   // Determine equal-logarithmic energy spacing
   double spacing = std::log(E_max / E_min) / M;
 
@@ -528,6 +795,7 @@ void Nuclide::init_grid()
       grid.grid_index[k] = j;
     }
   }
+  return true;
 }
 
 double Nuclide::nu(double E, EmissionMode mode, int group) const
@@ -612,8 +880,16 @@ double Nuclide::elastic_xs_0K(double E) const
 }
 
 void Nuclide::calculate_xs(
-  int i_sab, int i_log_union, double sab_frac, Particle& p)
+  int i_sab, int i_log_union, double sab_frac, Particle& p, int i_temp)
 {
+  // Evaluate multipole if there is multipole data present at this energy
+  if (multipole_ && multipole_in_range(*this, p.E())) {
+    double sig_s, sig_a, sig_f;
+    std::tie(sig_s, sig_a, sig_f) = multipole_->evaluate(p.E(), p.sqrtkT());
+    this->set_multipole_xs(sig_s, sig_a, sig_f, i_sab, sab_frac, p);
+    return;
+  }
+
   auto& micro {p.neutron_xs(index_)};
 
   // Initialize cached cross sections to zero
@@ -621,219 +897,370 @@ void Nuclide::calculate_xs(
   micro.thermal = 0.0;
   micro.thermal_elastic = 0.0;
 
-  // Check to see if there is multipole data present at this energy
-  bool use_mp = false;
-  if (multipole_) {
-    use_mp = (p.E() >= multipole_->E_min_ && p.E() <= multipole_->E_max_);
-  }
+  // Find the appropriate temperature index.
+  if (i_temp == C_NONE)
+    i_temp = this->temperature_index(p);
 
-  // Evaluate multipole or interpolate
-  if (use_mp) {
-    // Call multipole kernel
-    double sig_s, sig_a, sig_f;
-    std::tie(sig_s, sig_a, sig_f) = multipole_->evaluate(p.E(), p.sqrtkT());
+  // Determine the energy grid index
+  const auto& grid {grid_[i_temp]};
+  const auto& xs {xs_[i_temp]};
 
-    micro.total = sig_s + sig_a;
-    micro.elastic = sig_s;
-    micro.absorption = sig_a;
-    micro.fission = sig_f;
-    micro.nu_fission =
-      fissionable_ ? sig_f * this->nu(p.E(), EmissionMode::total) : 0.0;
+  int i_grid = this->energy_grid_index(i_temp, i_log_union, p.E());
 
-    if (simulation::need_depletion_rx) {
-      // Only non-zero reaction is (n,gamma)
-      micro.reaction[0] = sig_a - sig_f;
+  // calculate interpolation factor
+  double f = (p.E() - grid.energy[i_grid]) /
+             (grid.energy[i_grid + 1] - grid.energy[i_grid]);
 
-      // Set all other reaction cross sections to zero
-      for (int i = 1; i < DEPLETION_RX.size(); ++i) {
-        micro.reaction[i] = 0.0;
-      }
-    }
+  micro.index_temp = i_temp;
+  micro.index_grid = i_grid;
+  micro.interp_factor = f;
+
+  // Calculate microscopic nuclide total cross section
+  micro.total = (1.0 - f) * xs(i_grid, XS_TOTAL) + f * xs(i_grid + 1, XS_TOTAL);
+
+  // Calculate microscopic nuclide absorption cross section
+  micro.absorption =
+    (1.0 - f) * xs(i_grid, XS_ABSORPTION) + f * xs(i_grid + 1, XS_ABSORPTION);
 
-    /*
-     * index_temp, index_grid, and interp_factor are used only in the
-     * following places:
-     *   1. physics.cpp - scatter - For inelastic scatter.
-     *   2. physics.cpp - sample_fission - For partial fissions.
-     *   3. tallies/tally_scoring.cpp - score_general -
-     *        For tallying on MTxxx reactions.
-     *   4. nuclide.cpp - calculate_urr_xs - For unresolved purposes.
-     * It is worth noting that none of these occur in the resolved resonance
-     * range, so the value here does not matter.  index_temp is set to -1 to
-     * force a segfault in case a developer messes up and tries to use it with
-     * multipole.
-     *
-     * However, a segfault is not necessarily guaranteed with an out-of-bounds
-     * access, so this technique should be replaced by something more robust
-     * in the future.
-     */
-    micro.index_temp = -1;
-    micro.index_grid = -1;
-    micro.interp_factor = 0.0;
+  if (fissionable_) {
+    // Calculate microscopic nuclide total cross section
+    micro.fission =
+      (1.0 - f) * xs(i_grid, XS_FISSION) + f * xs(i_grid + 1, XS_FISSION);
 
+    // Calculate microscopic nuclide nu-fission cross section
+    micro.nu_fission = (1.0 - f) * xs(i_grid, XS_NU_FISSION) +
+                       f * xs(i_grid + 1, XS_NU_FISSION);
   } else {
-    // Find the appropriate temperature index.
-    double kT = p.sqrtkT() * p.sqrtkT();
-    double f;
-    int i_temp = -1;
-    switch (settings::temperature_method) {
-    case TemperatureMethod::NEAREST: {
-      double max_diff = INFTY;
-      for (int t = 0; t < kTs_.size(); ++t) {
-        double diff = std::abs(kTs_[t] - kT);
-        if (diff < max_diff) {
-          i_temp = t;
-          max_diff = diff;
-        }
-      }
-    } break;
+    micro.fission = 0.0;
+    micro.nu_fission = 0.0;
+  }
 
-    case TemperatureMethod::INTERPOLATION:
-      // If current kT outside of the bounds of available, snap to the bound
-      if (kT < kTs_.front()) {
-        i_temp = 0;
-        break;
-      }
-      if (kT > kTs_.back()) {
-        i_temp = kTs_.size() - 1;
-        break;
-      }
+  // Calculate microscopic nuclide photon production cross section
+  micro.photon_prod = (1.0 - f) * xs(i_grid, XS_PHOTON_PROD) +
+                      f * xs(i_grid + 1, XS_PHOTON_PROD);
 
-      // Find temperatures that bound the actual temperature
-      for (i_temp = 0; i_temp < kTs_.size() - 1; ++i_temp) {
-        if (kTs_[i_temp] <= kT && kT < kTs_[i_temp + 1])
-          break;
-      }
+  // Depletion-related reactions
+  if (simulation::need_depletion_rx)
+    this->calculate_depletion_xs(i_temp, i_grid, f, micro);
 
-      // Randomly sample between temperature i and i+1
-      f = (kT - kTs_[i_temp]) / (kTs_[i_temp + 1] - kTs_[i_temp]);
-      if (f > prn(p.current_seed()))
-        ++i_temp;
-      break;
-    }
+  // Initialize sab treatment to false
+  micro.index_sab = C_NONE;
+  micro.sab_frac = 0.0;
 
-    // Determine the energy grid index using a logarithmic mapping to
-    // reduce the energy range over which a binary search needs to be
-    // performed
+  // Initialize URR probability table treatment to false
+  micro.use_ptable = false;
 
-    const auto& grid {grid_[i_temp]};
-    const auto& xs {xs_[i_temp]};
+  // If there is S(a,b) data for this nuclide, we need to set the sab_scatter
+  // and sab_elastic cross sections and correct the total and elastic cross
+  // sections.
 
-    int i_grid;
-    if (p.E() < grid.energy.front()) {
-      i_grid = 0;
-    } else if (p.E() > grid.energy.back()) {
-      i_grid = grid.energy.size() - 2;
-    } else {
-      // Determine bounding indices based on which equal log-spaced
-      // interval the energy is in
-      int i_low = grid.grid_index[i_log_union];
-      int i_high = grid.grid_index[i_log_union + 1] + 1;
-
-      // Perform binary search over reduced range
-      i_grid = i_low + lower_bound_index(
-                         &grid.energy[i_low], &grid.energy[i_high], p.E());
-    }
+  if (i_sab >= 0)
+    this->calculate_sab_xs(i_sab, sab_frac, p);
+
+  // If the particle is in the unresolved resonance range and there are
+  // probability tables, we need to determine cross sections from the table
+  if (settings::urr_ptables_on && urr_present_) {
+    if (urr_data_[micro.index_temp].energy_in_bounds(p.E()))
+      this->calculate_urr_xs(micro.index_temp, p);
+  }
 
-    // check for rare case where two energy points are the same
-    if (grid.energy[i_grid] == grid.energy[i_grid + 1])
-      ++i_grid;
+  micro.last_E = p.E();
+  micro.last_sqrtkT = p.sqrtkT();
+}
 
-    // calculate interpolation factor
-    f = (p.E() - grid.energy[i_grid]) /
-        (grid.energy[i_grid + 1] - grid.energy[i_grid]);
+void Nuclide::calculate_multipole_xs(gsl::span<Particle* const> particles,
+  const int* i_sab, const double* sab_frac)
+{
+  int n = particles.size();
+  vector<double> E(n);
+  vector<double> sqrtkT(n);
+  for (int k = 0; k < n; ++k) {
+    E[k] = particles[k]->E();
+    sqrtkT[k] = particles[k]->sqrtkT();
+  }
 
-    micro.index_temp = i_temp;
-    micro.index_grid = i_grid;
-    micro.interp_factor = f;
+  vector<double> sig_s(n);
+  vector<double> sig_a(n);
+  vector<double> sig_f(n);
+  multipole_->evaluate_batch(n, E.data(), sqrtkT.data(), sig_s.data(),
+    sig_a.data(), sig_f.data());
 
-    // Calculate microscopic nuclide total cross section
-    micro.total =
-      (1.0 - f) * xs(i_grid, XS_TOTAL) + f * xs(i_grid + 1, XS_TOTAL);
+  for (int k = 0; k < n; ++k) {
+    this->set_multipole_xs(
+      sig_s[k], sig_a[k], sig_f[k], i_sab[k], sab_frac[k], *particles[k]);
+  }
+}
 
-    // Calculate microscopic nuclide absorption cross section
-    micro.absorption =
-      (1.0 - f) * xs(i_grid, XS_ABSORPTION) + f * xs(i_grid + 1, XS_ABSORPTION);
+void Nuclide::set_multipole_xs(double sig_s, double sig_a, double sig_f,
+  int i_sab, double sab_frac, Particle& p)
+{
+  auto& micro {p.neutron_xs(index_)};
 
-    if (fissionable_) {
-      // Calculate microscopic nuclide total cross section
-      micro.fission =
-        (1.0 - f) * xs(i_grid, XS_FISSION) + f * xs(i_grid + 1, XS_FISSION);
+  micro.thermal = 0.0;
+  micro.thermal_elastic = 0.0;
+  micro.total = sig_s + sig_a;
+  micro.elastic = sig_s;
+  micro.absorption = sig_a;
+  micro.fission = sig_f;
+  micro.nu_fission =
+    fissionable_ ? sig_f * this->nu(p.E(), EmissionMode::total) : 0.0;
 
-      // Calculate microscopic nuclide nu-fission cross section
-      micro.nu_fission = (1.0 - f) * xs(i_grid, XS_NU_FISSION) +
-                         f * xs(i_grid + 1, XS_NU_FISSION);
-    } else {
-      micro.fission = 0.0;
-      micro.nu_fission = 0.0;
+  if (simulation::need_depletion_rx) {
+    // Only non-zero reaction is (n,gamma)
+    micro.reaction[0] = sig_a - sig_f;
+
+    // Set all other reaction cross sections to zero
+    for (int i = 1; i < DEPLETION_RX.size(); ++i) {
+      micro.reaction[i] = 0.0;
     }
+  }
 
-    // Calculate microscopic nuclide photon production cross section
-    micro.photon_prod = (1.0 - f) * xs(i_grid, XS_PHOTON_PROD) +
-                        f * xs(i_grid + 1, XS_PHOTON_PROD);
+  /*
+   * index_temp, index_grid, and interp_factor are used only in the
+   * following places:
+   *   1. physics.cpp - scatter - For inelastic scatter.
+   *   2. physics.cpp - sample_fission - For partial fissions.
+   *   3. tallies/tally_scoring.cpp - score_general -
+   *        For tallying on MTxxx reactions.
+   *   4. nuclide.cpp - calculate_urr_xs - For unresolved purposes.
+   * It is worth noting that none of these occur in the resolved resonance
+   * range, so the value here does not matter.  index_temp is set to -1 to
+   * force a segfault in case a developer messes up and tries to use it with
+   * multipole.
+   *
+   * However, a segfault is not necessarily guaranteed with an out-of-bounds
+   * access, so this technique should be replaced by something more robust
+   * in the future.
+   */
+  micro.index_temp = -1;
+  micro.index_grid = -1;
+  micro.interp_factor = 0.0;
+
+  // Initialize sab treatment to false. URR probability tables do not overlap
+  // the multipole range.
+  micro.index_sab = C_NONE;
+  micro.sab_frac = 0.0;
+  micro.use_ptable = false;
+  if (i_sab >= 0)
+    this->calculate_sab_xs(i_sab, sab_frac, p);
 
-    // Depletion-related reactions
-    if (simulation::need_depletion_rx) {
-      // Initialize all reaction cross sections to zero
-      for (double& xs_i : micro.reaction) {
-        xs_i = 0.0;
+  micro.last_E = p.E();
+  micro.last_sqrtkT = p.sqrtkT();
+}
+
+int Nuclide::temperature_index(Particle& p) const
+{
+  double kT = p.sqrtkT() * p.sqrtkT();
+  double f;
+  int i_temp = -1;
+  switch (settings::temperature_method) {
+  case TemperatureMethod::NEAREST: {
+    double max_diff = INFTY;
+    for (int t = 0; t < kTs_.size(); ++t) {
+      double diff = std::abs(kTs_[t] - kT);
+      if (diff < max_diff) {
+        i_temp = t;
+        max_diff = diff;
       }
+    }
+  } break;
 
-      for (int j = 0; j < DEPLETION_RX.size(); ++j) {
-        // If reaction is present and energy is greater than threshold, set the
-        // reaction xs appropriately
-        int i_rx = reaction_index_[DEPLETION_RX[j]];
-        if (i_rx >= 0) {
-          const auto& rx = reactions_[i_rx];
-          const auto& rx_xs = rx->xs_[i_temp].value;
-
-          // Physics says that (n,gamma) is not a threshold reaction, so we
-          // don't need to specifically check its threshold index
-          if (j == 0) {
-            micro.reaction[0] =
-              (1.0 - f) * rx_xs[i_grid] + f * rx_xs[i_grid + 1];
-            continue;
-          }
+  case TemperatureMethod::INTERPOLATION:
+    // If current kT outside of the bounds of available, snap to the bound
+    if (kT < kTs_.front()) {
+      i_temp = 0;
+      break;
+    }
+    if (kT > kTs_.back()) {
+      i_temp = kTs_.size() - 1;
+      break;
+    }
 
-          int threshold = rx->xs_[i_temp].threshold;
-          if (i_grid >= threshold) {
-            micro.reaction[j] = (1.0 - f) * rx_xs[i_grid - threshold] +
-                                f * rx_xs[i_grid - threshold + 1];
-          } else if (j >= 3) {
-            // One can show that the the threshold for (n,(x+1)n) is always
-            // higher than the threshold for (n,xn). Thus, if we are below
-            // the threshold for, e.g., (n,2n), there is no reason to check
-            // the threshold for (n,3n) and (n,4n).
-            break;
-          }
-        }
-      }
+    // Find temperatures that bound the actual temperature
+    for (i_temp = 0; i_temp < kTs_.size() - 1; ++i_temp) {
+      if (kTs_[i_temp] <= kT && kT < kTs_[i_temp + 1])
+        break;
     }
+
+    // Randomly sample between temperature i and i+1
+    f = (kT - kTs_[i_temp]) / (kTs_[i_temp + 1] - kTs_[i_temp]);
+    if (f > prn(p.current_seed()))
+      ++i_temp;
+    break;
   }
 
-  // Initialize sab treatment to false
-  micro.index_sab = C_NONE;
-  micro.sab_frac = 0.0;
+  return i_temp;
+}
 
-  // Initialize URR probability table treatment to false
-  micro.use_ptable = false;
+int Nuclide::energy_grid_index(int i_temp, int i_log_union, double E) const
+{
+  const auto& grid {grid_[i_temp]};
 
-  // If there is S(a,b) data for this nuclide, we need to set the sab_scatter
-  // and sab_elastic cross sections and correct the total and elastic cross
-  // sections.
+  // Use a logarithmic mapping (or the unionized grid) to reduce the energy
+  // range over which a binary search needs to be performed
+  int i_grid;
+  if (E < grid.energy.front()) {
+    i_grid = 0;
+  } else if (E > grid.energy.back()) {
+    i_grid = grid.energy.size() - 2;
+  } else if (!grid.union_index.empty()) {
+    // On the unionized grid, every nuclide grid point is also a union grid
+    // point so the index is known without any further search
+    i_grid = grid.union_index[i_log_union];
+  } else {
+    // Determine bounding indices based on which equal log-spaced
+    // interval the energy is in
+    int i_low = grid.grid_index[i_log_union];
+    int i_high = grid.grid_index[i_log_union + 1] + 1;
+
+    // Perform binary search over reduced range
+    i_grid =
+      i_low + lower_bound_index(&grid.energy[i_low], &grid.energy[i_high], E);
+  }
 
-  if (i_sab >= 0)
-    this->calculate_sab_xs(i_sab, sab_frac, p);
+  // check for rare case where two energy points are the same
+  if (grid.energy[i_grid] == grid.energy[i_grid + 1])
+    ++i_grid;
 
-  // If the particle is in the unresolved resonance range and there are
-  // probability tables, we need to determine cross sections from the table
-  if (settings::urr_ptables_on && urr_present_ && !use_mp) {
-    if (urr_data_[micro.index_temp].energy_in_bounds(p.E()))
-      this->calculate_urr_xs(micro.index_temp, p);
+  return i_grid;
+}
+
+void Nuclide::calculate_depletion_xs(
+  int i_temp, int i_grid, double f, NuclideMicroXS& micro) const
+{
+  // Initialize all reaction cross sections to zero
+  for (double& xs_i : micro.reaction) {
+    xs_i = 0.0;
   }
 
-  micro.last_E = p.E();
-  micro.last_sqrtkT = p.sqrtkT();
+  for (int j = 0; j < DEPLETION_RX.size(); ++j) {
+    // If reaction is present and energy is greater than threshold, set the
+    // reaction xs appropriately
+    int i_rx = reaction_index_[DEPLETION_RX[j]];
+    if (i_rx >= 0) {
+      const auto& rx = reactions_[i_rx];
+      const auto& rx_xs = rx->xs_[i_temp].value;
+
+      // Physics says that (n,gamma) is not a threshold reaction, so we
+      // don't need to specifically check its threshold index
+      if (j == 0) {
+        micro.reaction[0] = (1.0 - f) * rx_xs[i_grid] + f * rx_xs[i_grid + 1];
+        continue;
+      }
+
+      int threshold = rx->xs_[i_temp].threshold;
+      if (i_grid >= threshold) {
+        micro.reaction[j] = (1.0 - f) * rx_xs[i_grid - threshold] +
+                            f * rx_xs[i_grid - threshold + 1];
+      } else if (j >= 3) {
+        // One can show that the the threshold for (n,(x+1)n) is always
+        // higher than the threshold for (n,xn). Thus, if we are below
+        // the threshold for, e.g., (n,2n), there is no reason to check
+        // the threshold for (n,3n) and (n,4n).
+        break;
+      }
+    }
+  }
+}
+
+bool Nuclide::use_packed_xs(double E) const
+{
+  if (packed_offset_.empty())
+    return false;
+  if (multipole_ && multipole_in_range(*this, E))
+    return false;
+
+  // The temperature hasn't been selected yet, so avoid the packed tables if
+  // probability tables would apply at any temperature
+  if (settings::urr_ptables_on && urr_present_) {
+    for (const auto& urr : urr_data_) {
+      if (urr.energy_in_bounds(E))
+        return false;
+    }
+  }
+  return true;
+}
+
+void Nuclide::pack_xs(PackedXS& packed) const
+{
+  for (int t = 0; t < xs_.size(); ++t) {
+    const auto& xs {xs_[t]};
+    int64_t offset = packed_offset_[t];
+    for (int i = 0; i < xs.shape()[0]; ++i) {
+      packed.total[offset + i] = xs(i, XS_TOTAL);
+      packed.absorption[offset + i] = xs(i, XS_ABSORPTION);
+      packed.fission[offset + i] = xs(i, XS_FISSION);
+      packed.nu_fission[offset + i] = xs(i, XS_NU_FISSION);
+      packed.photon_prod[offset + i] = xs(i, XS_PHOTON_PROD);
+    }
+  }
+}
+
+void Nuclide::share_xs()
+{
+  for (auto& rx : reactions_) {
+    rx->share_xs();
+  }
+
+  vector<XsTable> xs;
+  for (int t = 0; t < xs_.size(); ++t) {
+    // Tables in the cache are already shared through the page cache
+    if (xs_data_[t].empty()) {
+      xs.push_back(std::move(xs_[t]));
+      continue;
+    }
+    array<size_t, 2> shape {xs_[t].shape()[0], xs_[t].shape()[1]};
+    auto data = mpi::share_on_node(xs_data_[t]);
+    xs.push_back(
+      xt::adapt(data.data(), data.size(), xt::no_ownership(), shape));
+  }
+  xs_ = std::move(xs);
+}
+
+double Nuclide::prune_data(
+  const array<bool, 902>& keep, int64_t& n_products, int64_t& n_reactions)
+{
+  double memory = 0.0;
+  for (auto& rx : reactions_) {
+    auto& products = rx->products_;
+
+    // The position of a delayed neutron product gives its delayed group, so
+    // only the photon products that follow all neutron products are freed
+    if (!settings::photon_transport) {
+      while (!products.empty() &&
+             products.back().particle_ == ParticleType::photon) {
+        products.pop_back();
+        ++n_products;
+      }
+      products.shrink_to_fit();
+    }
+
+    // Redundant reactions are never sampled, but the photon products of every
+    // reaction are sampled from their cross sections
+    if (!rx->redundant_ || is_fission(rx->mt_) || keep[rx->mt_])
+      continue;
+    bool photons = false;
+    for (const auto& product : products) {
+      if (product.particle_ == ParticleType::photon)
+        photons = true;
+    }
+    if (photons)
+      continue;
+
+    for (auto& x : rx->xs_) {
+      memory += x.storage.capacity() * sizeof(Reaction::XsValue) / 1.0e6;
+      vector<Reaction::XsValue>().swap(x.storage);
+      x.value = {};
+
+      // Past the end of the energy grid so that Reaction::xs() gives zero
+      x.threshold = std::numeric_limits<int>::max();
+    }
+    n_products += products.size();
+    vector<ReactionProduct>().swap(products);
+    reaction_index_[rx->mt_] = C_NONE;
+    ++n_reactions;
+  }
+  return memory;
 }
 
 void Nuclide::calculate_sab_xs(int i_sab, double sab_frac, Particle& p)
@@ -874,26 +1301,37 @@ void Nuclide::calculate_urr_xs(int i_temp, Particle& p) const
   // Create a shorthand for the URR data
   const auto& urr = urr_data_[i_temp];
 
-  // Determine the energy table
-  int i_energy =
-    lower_bound_index(urr.energy_.begin(), urr.energy_.end(), p.E());
-
-  // Sample the probability table using the cumulative distribution
-
-  // Random numbers for the xs calculation are sampled from a separate stream.
-  // This guarantees the randomness and, at the same time, makes sure we
-  // reuse random numbers for the same nuclide at different temperatures,
-  // therefore preserving correlation of temperature in probability tables.
-  double r =
-    future_prn(static_cast<int64_t>(index_), p.seeds(STREAM_URR_PTABLE));
-
-  // Warning: this assumes row-major order of cdf_values_
-  int i_low = upper_bound_index(&urr.cdf_values_(i_energy, 0),
-                &urr.cdf_values_(i_energy, 0) + urr.n_cdf(), r) +
-              1;
-  int i_up = upper_bound_index(&urr.cdf_values_(i_energy + 1, 0),
-               &urr.cdf_values_(i_energy + 1, 0) + urr.n_cdf(), r) +
-             1;
+  // The bands sampled at the last lookup are still valid if the energy is in
+  // the same interval of the table and the random number stream is unchanged
+  uint64_t seed = p.seeds(STREAM_URR_PTABLE);
+  int i_energy = micro.urr_index_energy;
+  int i_low, i_up;
+  if (i_energy >= 0 && micro.urr_index_temp == i_temp &&
+      micro.urr_seed == seed && urr.energy_[i_energy] < p.E() &&
+      p.E() <= urr.energy_[i_energy + 1]) {
+    i_low = micro.urr_band_low;
+    i_up = micro.urr_band_up;
+  } else {
+    // Determine the energy table
+    i_energy =
+      lower_bound_index(urr.energy_.begin(), urr.energy_.end(), p.E());
+
+    // Sample the probability table using the cumulative distribution
+
+    // Random numbers for the xs calculation are sampled from a separate
+    // stream. This guarantees the randomness and, at the same time, makes sure
+    // we reuse random numbers for the same nuclide at different temperatures,
+    // therefore preserving correlation of temperature in probability tables.
+    double r = future_prn(static_cast<int64_t>(index_), seed);
+    i_low = urr.band_index(i_energy, r);
+    i_up = urr.band_index(i_energy + 1, r);
+
+    micro.urr_index_energy = i_energy;
+    micro.urr_index_temp = i_temp;
+    micro.urr_band_low = i_low;
+    micro.urr_band_up = i_up;
+    micro.urr_seed = seed;
+  }
 
   // Determine elastic, fission, and capture cross sections from the
   // probability table
@@ -1105,11 +1543,7 @@ extern "C" size_t nuclides_size()
   return data::nuclides.size();
 }
 
-//==============================================================================
-// C API
-//==============================================================================
-
-extern "C" int openmc_load_nuclide(const char* name, const double* temps, int n)
+int load_nuclide(const char* name, const double* temps, int n, bool derive)
 {
   if (data::nuclide_map.find(name) == data::nuclide_map.end() ||
       data::nuclide_map.at(name) >= data::elements.size()) {
@@ -1133,7 +1567,8 @@ extern "C" int openmc_load_nuclide(const char* name, const double* temps, int n)
     // Read nuclide data from HDF5
     hid_t group = open_group(file_id, name);
     vector<double> temperature {temps, temps + n};
-    data::nuclides.push_back(make_unique<Nuclide>(group, temperature));
+    data::nuclides.push_back(
+      make_unique<Nuclide>(group, temperature, derive));
 
     close_group(group);
     file_close(file_id);
@@ -1177,6 +1612,15 @@ extern "C" int openmc_load_nuclide(const char* name, const double* temps, int n)
   return 0;
 }
 
+//==============================================================================
+// C API
+//==============================================================================
+
+extern "C" int openmc_load_nuclide(const char* name, const double* temps, int n)
+{
+  return load_nuclide(name, temps, n, true);
+}
+
 extern "C" int openmc_get_nuclide_index(const char* name, int* index)
 {
   auto it = data::nuclide_map.find(name);
@@ -1224,6 +1668,10 @@ void nuclides_clear()
 {
   data::nuclides.clear();
   data::nuclide_map.clear();
+  mpi::free_shared_memory();
+  data::xs_cache.close();
+  data::union_energy.clear();
+  data::packed_xs = {};
 }
 
 bool multipole_in_range(const Nuclide& nuc, double E)
@@ -1231,4 +1679,122 @@ bool multipole_in_range(const Nuclide& nuc, double E)
   return E >= nuc.multipole_->E_min_ && E <= nuc.multipole_->E_max_;
 }
 
+void init_union_grid()
+{
+  data::union_energy.clear();
+  if (settings::union_grid_memory <= 0.0)
+    return;
+
+  // Merge the energy points of every nuclide at every temperature
+  vector<double> union_energy;
+  int64_t n_grids = 0;
+  for (const auto& nuc : data::nuclides) {
+    for (const auto& grid : nuc->grid_) {
+      union_energy.insert(
+        union_energy.end(), grid.energy.begin(), grid.energy.end());
+      ++n_grids;
+    }
+  }
+  std::sort(union_energy.begin(), union_energy.end());
+  union_energy.erase(std::unique(union_energy.begin(), union_energy.end()),
+    union_energy.end());
+
+  // The grid itself is stored once and each nuclide grid stores one index per
+  // union point
+  int64_t n = union_energy.size();
+  double memory = n * (sizeof(double) + n_grids * sizeof(int)) / 1.0e6;
+  if (memory > settings::union_grid_memory) {
+    warning(fmt::format("Unionized energy grid requires {:.1f} MB, which "
+                        "exceeds the limit of {:.1f} MB. Using the "
+                        "logarithmic grid instead.",
+      memory, settings::union_grid_memory));
+    return;
+  }
+
+  // For each union point, find the lower bounding index on each nuclide grid
+  for (auto& nuc : data::nuclides) {
+    for (auto& grid : nuc->grid_) {
+      int n_energy = grid.energy.size();
+      grid.union_index.resize(n);
+      int j = 0;
+      for (int64_t k = 0; k < n; ++k) {
+        while (j + 2 < n_energy && grid.energy[j + 1] <= union_energy[k])
+          ++j;
+        grid.union_index[k] = j;
+      }
+    }
+  }
+  data::union_energy = std::move(union_energy);
+
+  write_message(6, "Unionized energy grid: {} points, {:.1f} MB", n, memory);
+}
+
+int energy_search_index(double E)
+{
+  if (data::union_energy.empty()) {
+    int neutron = static_cast<int>(ParticleType::neutron);
+    return std::log(E / data::energy_min[neutron]) / simulation::log_spacing;
+  }
+
+  // Find the union grid interval containing the energy, staying in bounds if
+  // it lies outside the grid
+  int n = data::union_energy.size();
+  int i = upper_bound_index(
+    data::union_energy.begin(), data::union_energy.end(), E);
+  return std::min(std::max(i, 0), n - 1);
+}
+
+void init_packed_xs()
+{
+  auto& packed = data::packed_xs;
+  packed = {};
+
+  // Determine where each nuclide and temperature starts in the packed arrays
+  int64_t n = 0;
+  for (auto& nuc : data::nuclides) {
+    nuc->packed_offset_.resize(nuc->xs_.size());
+    for (int t = 0; t < nuc->xs_.size(); ++t) {
+      nuc->packed_offset_[t] = n;
+      n += nuc->xs_[t].shape()[0];
+    }
+  }
+
+  packed.total.resize(n);
+  packed.absorption.resize(n);
+  packed.fission.resize(n);
+  packed.nu_fission.resize(n);
+  packed.photon_prod.resize(n);
+
+  // Copy the cross section tables of each nuclide
+  for (const auto& nuc : data::nuclides) {
+    nuc->pack_xs(packed);
+  }
+
+  double memory = 5 * n * sizeof(double) / 1.0e6;
+  write_message(6, "Packed cross sections for vectorized lookups: {:.1f} MB",
+    memory);
+}
+
+void interpolate_packed_xs(int n, const int64_t* index, const double* f,
+  double* total, double* absorption, double* fission, double* nu_fission,
+  double* photon_prod)
+{
+  const double* xs_total = data::packed_xs.total.data();
+  const double* xs_absorption = data::packed_xs.absorption.data();
+  const double* xs_fission = data::packed_xs.fission.data();
+  const double* xs_nu_fission = data::packed_xs.nu_fission.data();
+  const double* xs_photon_prod = data::packed_xs.photon_prod.data();
+
+#pragma omp simd
+  for (int k = 0; k < n; ++k) {
+    int64_t i = index[k];
+    double g = 1.0 - f[k];
+    total[k] = g * xs_total[i] + f[k] * xs_total[i + 1];
+    absorption[k] = g * xs_absorption[i] + f[k] * xs_absorption[i + 1];
+    fission[k] = g * xs_fission[i] + f[k] * xs_fission[i + 1];
+    nu_fission[k] = g * xs_nu_fission[i] + f[k] * xs_nu_fission[i + 1];
+    photon_prod[k] = g * xs_photon_prod[i] + f[k] * xs_photon_prod[i + 1];
+  }
+}
+
 } // namespace openmc
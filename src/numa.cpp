@@ -0,0 +1,158 @@
+#include "openmc/numa.h"
+
+#include <cstdio>
+#include <string>
+
+#ifdef __linux__
+#include <linux/mempolicy.h> // for MPOL_INTERLEAVE, MPOL_DEFAULT
+#include <sched.h>           // for sched_getaffinity, sched_setaffinity
+#include <sys/syscall.h>     // for SYS_set_mempolicy
+#include <unistd.h>          // for syscall
+#endif
+
+#include <fmt/core.h>
+
+#include "openmc/error.h"
+#include "openmc/openmp_interface.h"
+#include "openmc/settings.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+namespace {
+
+bool interleaving {false}; //!< is the interleave policy in effect?
+
+#ifdef __linux__
+//! Bit mask of the NUMA nodes that are online, or an empty vector if there is
+//! only one node or the nodes cannot be determined
+vector<unsigned long> online_nodes()
+{
+  vector<unsigned long> mask;
+  std::FILE* fh = std::fopen("/sys/devices/system/node/online", "r");
+  if (!fh)
+    return mask;
+  char buffer[256];
+  bool read = std::fgets(buffer, sizeof(buffer), fh) != nullptr;
+  std::fclose(fh);
+  if (!read)
+    return mask;
+
+  // The file holds comma-separated ranges of nodes, e.g. "0-1,4"
+  constexpr int BITS = 8 * sizeof(unsigned long);
+  int n_nodes = 0;
+  for (const char* p = buffer; *p != '\0' && *p != '\n';) {
+    int first, last, n;
+    if (std::sscanf(p, "%d%n", &first, &n) != 1)
+      break;
+    p += n;
+    last = first;
+    if (*p == '-') {
+      if (std::sscanf(p + 1, "%d%n", &last, &n) != 1)
+        break;
+      p += n + 1;
+    }
+    for (int i = first; i <= last; ++i) {
+      if (i / BITS >= mask.size())
+        mask.resize(i / BITS + 1, 0);
+      mask[i / BITS] |= 1UL << (i % BITS);
+      ++n_nodes;
+    }
+    if (*p == ',')
+      ++p;
+  }
+  if (n_nodes <= 1)
+    mask.clear();
+  return mask;
+}
+#endif
+
+} // namespace
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void pin_threads()
+{
+  if (settings::thread_affinity == ThreadAffinity::NONE)
+    return;
+
+#if defined(__linux__) && defined(_OPENMP)
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    warning("Could not determine the cores available to pin threads to.");
+    return;
+  }
+  vector<int> cpus;
+  for (int i = 0; i < CPU_SETSIZE; ++i) {
+    if (CPU_ISSET(i, &allowed))
+      cpus.push_back(i);
+  }
+
+  int n_threads = num_threads();
+  int n_cpus = cpus.size();
+  if (n_threads > n_cpus) {
+    warning(fmt::format("{} threads were requested but only {} cores are "
+                        "available; threads will share cores.",
+      n_threads, n_cpus));
+  }
+
+  bool spread = settings::thread_affinity == ThreadAffinity::SPREAD;
+  int n_failed = 0;
+#pragma omp parallel reduction(+ : n_failed)
+  {
+    int t = thread_num();
+    int i = spread && n_threads <= n_cpus
+              ? static_cast<int>(static_cast<long>(t) * n_cpus / n_threads)
+              : t % n_cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpus[i], &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0)
+      ++n_failed;
+  }
+
+  if (n_failed > 0) {
+    warning(
+      fmt::format("Could not pin {} of {} threads.", n_failed, n_threads));
+  } else {
+    write_message(6, "Pinned {} threads with {} affinity", n_threads,
+      spread ? "spread" : "compact");
+  }
+#else
+  warning("Thread affinity is only supported on Linux with OpenMP.");
+#endif
+}
+
+void begin_interleave()
+{
+  if (!settings::numa_interleave)
+    return;
+
+#ifdef __linux__
+  auto mask = online_nodes();
+  if (mask.empty())
+    return;
+  unsigned long max_node = 8 * sizeof(unsigned long) * mask.size();
+  if (syscall(SYS_set_mempolicy, MPOL_INTERLEAVE, mask.data(), max_node + 1) !=
+      0) {
+    warning("Could not interleave nuclear data over NUMA nodes.");
+    return;
+  }
+  interleaving = true;
+#endif
+}
+
+void end_interleave()
+{
+#ifdef __linux__
+  if (!interleaving)
+    return;
+  syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0);
+  interleaving = false;
+#endif
+}
+
+} // namespace openmc
@@ -272,8 +272,11 @@ void print_usage()
       "Usage: openmc [options] [path]\n\n"
       "Options:\n"
       "  -c, --volume           Run in stochastic volume calculation mode\n"
+      "  -d, --dry-run          Report the memory needed by a run without\n"
+      "                         transporting particles\n"
       "  -g, --geometry-debug   Run with geometry debugging on\n"
       "  -n, --particles        Number of particles per generation\n"
+      "  -o, --overlap-check    Search for overlapping cells along rays\n"
       "  -p, --plot             Run in plotting mode\n"
       "  -r, --restart          Restart a previous run from a state point\n"
       "                         or a particle restart file\n"
@@ -427,6 +430,30 @@ void show_rate(const char* label, double particles_per_sec)
   fmt::print(" {:<33} = {:.6} particles/second\n", label, particles_per_sec);
 }
 
+std::pair<double, double> calculation_rates()
+{
+  using namespace simulation;
+
+  // Batches run in this execution, which may have restarted from a previous
+  // one
+  int first = settings::restart_run ? simulation::restart_batch : 0;
+  int n_inactive =
+    std::max(0, std::min(simulation::current_batch, settings::n_inactive) -
+                  std::min(first, settings::n_inactive));
+  int n_active = std::max(0, simulation::current_batch -
+                               std::max(first, settings::n_inactive));
+
+  double per_batch = static_cast<double>(settings::n_particles) *
+                     settings::gen_per_batch;
+  double speed_inactive = 0.0;
+  double speed_active = 0.0;
+  if (n_inactive > 0 && time_inactive.elapsed() > 0.0)
+    speed_inactive = per_batch * n_inactive / time_inactive.elapsed();
+  if (n_active > 0 && time_active.elapsed() > 0.0)
+    speed_active = per_batch * n_active / time_active.elapsed();
+  return {speed_inactive, speed_active};
+}
+
 void print_runtime()
 {
   using namespace simulation;
@@ -438,16 +465,28 @@ void print_runtime()
 
   // display time elapsed for various sections
   show_time("Total time for initialization", time_initialize.elapsed());
+  show_time("Reading materials", time_read_materials.elapsed(), 1);
+  show_time("Reading geometry", time_read_geometry.elapsed(), 1);
+  show_time("Setting up geometry", time_setup_geometry.elapsed(), 1);
   show_time("Reading cross sections", time_read_xs.elapsed(), 1);
+  show_time("Preparing distributed cells", time_distribcell.elapsed(), 1);
+  if (settings::run_CE)
+    show_time("Setting up energy grids", time_energy_grids.elapsed(), 1);
   show_time("Total time in simulation",
     time_inactive.elapsed() + time_active.elapsed());
   show_time("Time in transport only", time_transport.elapsed(), 1);
   if (settings::event_based) {
     show_time("Particle initialization", time_event_init.elapsed(), 2);
     show_time("XS lookups", time_event_calculate_xs.elapsed(), 2);
+    if (settings::event_queue_sort) {
+      show_time("Sorting XS queues", time_event_sort.elapsed(), 3);
+    }
     show_time("Advancing", time_event_advance_particle.elapsed(), 2);
     show_time("Surface crossings", time_event_surface_crossing.elapsed(), 2);
     show_time("Collisions", time_event_collision.elapsed(), 2);
+    if (settings::event_history_tail > 0) {
+      show_time("History-based tail", time_event_tail.elapsed(), 2);
+    }
     show_time("Particle death", time_event_death.elapsed(), 2);
   }
   if (settings::run_mode == RunMode::EIGENVALUE) {
@@ -461,38 +500,20 @@ void print_runtime()
   }
   show_time("Time accumulating tallies", time_tallies.elapsed(), 1);
   show_time("Time writing statepoints", time_statepoint.elapsed(), 1);
+  if (settings::pipeline_batches) {
+    // Work on the helper thread is hidden unless transport waited for it
+    double hidden =
+      std::max(0.0, time_pipeline.elapsed() - time_pipeline_wait.elapsed());
+    show_time("Time completing batches on helper thread",
+      time_pipeline.elapsed(), 1);
+    show_time("Waiting for helper thread", time_pipeline_wait.elapsed(), 2);
+    show_time("Hidden by transport", hidden, 2);
+  }
   show_time("Total time for finalization", time_finalize.elapsed());
   show_time("Total time elapsed", time_total.elapsed());
 
   // Calculate particle rate in active/inactive batches
-  int n_active = simulation::current_batch - settings::n_inactive;
-  double speed_inactive = 0.0;
-  double speed_active;
-  if (settings::restart_run) {
-    if (simulation::restart_batch < settings::n_inactive) {
-      speed_inactive = (settings::n_particles *
-                         (settings::n_inactive - simulation::restart_batch) *
-                         settings::gen_per_batch) /
-                       time_inactive.elapsed();
-      speed_active =
-        (settings::n_particles * n_active * settings::gen_per_batch) /
-        time_active.elapsed();
-    } else {
-      speed_active = (settings::n_particles *
-                       (settings::n_batches - simulation::restart_batch) *
-                       settings::gen_per_batch) /
-                     time_active.elapsed();
-    }
-  } else {
-    if (settings::n_inactive > 0) {
-      speed_inactive = (settings::n_particles * settings::n_inactive *
-                         settings::gen_per_batch) /
-                       time_inactive.elapsed();
-    }
-    speed_active =
-      (settings::n_particles * n_active * settings::gen_per_batch) /
-      time_active.elapsed();
-  }
+  auto [speed_inactive, speed_active] = calculation_rates();
 
   // display calculation rate
   if (!(settings::restart_run &&
@@ -501,6 +522,27 @@ void print_runtime()
     show_rate("Calculation Rate (inactive)", speed_inactive);
   }
   show_rate("Calculation Rate (active)", speed_active);
+
+  // Show how unevenly transport was distributed across processes
+  if (!simulation::load_imbalance.empty()) {
+    double mean = 0.0;
+    double max = 0.0;
+    for (auto x : simulation::load_imbalance) {
+      mean += x / simulation::load_imbalance.size();
+      max = std::max(max, x);
+    }
+    fmt::print(" {:<33} = {:.3f} (mean), {:.3f} (max)\n",
+      "Load imbalance (max/mean time)", mean, max);
+  }
+
+  // Show how often cross sections could be reused after a temperature change
+  int64_t n_xs = simulation::n_xs_temperature_hits +
+                 simulation::n_xs_temperature_misses;
+  if (n_xs > 0) {
+    fmt::print(" {:<33} = {:.2f}% of {} lookups\n",
+      "XS reused at new temperatures",
+      100.0 * simulation::n_xs_temperature_hits / n_xs, n_xs);
+  }
 }
 
 //==============================================================================
@@ -577,6 +619,28 @@ void print_results()
     fmt::print(" Leakage Fraction           = {:.5f}\n",
       gt(GlobalTally::LEAKAGE, TallyResult::SUM) / n);
   }
+
+  // write the last figure of merit of tallies that record it
+  for (const auto& t : model::tallies) {
+    if (!t->figure_of_merit_ || t->fom_history_.empty())
+      continue;
+    const auto& fom = t->fom_history_.back();
+    fmt::print(" Tally {} Figure of Merit = {:.4e} /s (max. rel. error {:.4e}, "
+               "median {:.4e})\n",
+      t->id_, fom.value, fom.max_rel_err, fom.median_rel_err);
+  }
+
+  // write the tally triggers as of their last check
+  for (const auto& t : model::tallies) {
+    for (const auto& trigger : t->triggers_) {
+      if (trigger.batch == 0)
+        continue;
+      fmt::print(" Tally {} trigger on {} = {:.4f} unc./thresh., {:.1f}% of "
+                 "bins satisfied (batch {})\n",
+        t->id_, reaction_name(t->scores_[trigger.score_index]), trigger.ratio,
+        100.0 * trigger.satisfied, trigger.batch);
+    }
+  }
   fmt::print("\n");
   std::fflush(stdout);
 }
@@ -619,7 +683,7 @@ void write_tallies()
 
   // Loop over each tally.
   for (auto i_tally = 0; i_tally < model::tallies.size(); ++i_tally) {
-    const auto& tally {*model::tallies[i_tally]};
+    auto& tally {*model::tallies[i_tally]};
 
     // Write header block.
     std::string tally_header("TALLY " + std::to_string(tally.id_));
@@ -632,6 +696,12 @@ void write_tallies()
       continue;
     }
 
+    // The master process only holds some of the bins of a partitioned tally
+    if (tally.partitioned()) {
+      fmt::print(tallies_out, " Partitioned; see state point\n\n");
+      continue;
+    }
+
     // Calculate t-value for confidence intervals
     double t_value = 1;
     if (settings::confidence_intervals) {
@@ -663,6 +733,9 @@ void write_tallies()
       }
     }
 
+    // Sparse results are written from a temporary dense copy
+    tally.materialize_results();
+
     // Initialize Filter Matches Object
     vector<FilterMatch> filter_matches;
     // Allocate space for tally filter matches
@@ -720,6 +793,8 @@ void write_tallies()
         indent -= 2;
       }
     }
+
+    tally.release_results();
   }
 }
 
@@ -0,0 +1,293 @@
+#include "openmc/overlap_check.h"
+
+#include <algorithm> // for max, min
+#include <cmath>     // for cos, sin, sqrt
+#include <cstdint>
+#include <map>
+#include <tuple>
+
+#include <fmt/core.h>
+
+#include "openmc/bounding_box.h"
+#include "openmc/cell.h"
+#include "openmc/constants.h"
+#include "openmc/error.h"
+#include "openmc/geometry.h"
+#include "openmc/lattice.h"
+#include "openmc/message_passing.h"
+#include "openmc/output.h"
+#include "openmc/particle_data.h"
+#include "openmc/random_lcg.h"
+#include "openmc/settings.h"
+#include "openmc/timer.h"
+#include "openmc/universe.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+namespace {
+
+//! Maximum number of segments tracked along a ray
+constexpr int MAX_RAY_SEGMENTS {1000000};
+
+//! Number of values packed for each overlap sent to the master process
+constexpr int PACKED_SIZE {10};
+
+//==============================================================================
+//! Segments found in the overlap of two cells of a universe
+//==============================================================================
+
+struct Overlap {
+  int64_t count {0}; //!< Number of segments whose midpoint is in both cells
+  //! Box around those midpoints in the coordinates of the root universe
+  BoundingBox extent {INFTY, -INFTY, INFTY, -INFTY, INFTY, -INFTY};
+
+  void add(int64_t n, const BoundingBox& box)
+  {
+    count += n;
+    extent |= box;
+  }
+};
+
+//! Overlaps by universe index and indices of the two cells, lowest first
+using OverlapMap = std::map<std::tuple<int32_t, int32_t, int32_t>, Overlap>;
+
+bool in_box(const BoundingBox& b, Position r)
+{
+  return r.x >= b.xmin && r.x <= b.xmax && r.y >= b.ymin && r.y <= b.ymax &&
+         r.z >= b.zmin && r.z <= b.zmax;
+}
+
+//! Record the cells that contain the position of the particle on any level
+//! besides the cell it is in
+
+void check_point(const GeometryState& p, const vector<BoundingBox>& boxes,
+  OverlapMap& overlaps)
+{
+  Position r = p.r();
+  for (int j = 0; j < p.n_coord(); ++j) {
+    const auto& coord {p.coord(j)};
+    const auto& univ {*model::universes[coord.universe]};
+    const auto& cells = univ.partitioner_
+                          ? univ.partitioner_->get_cells(coord.r, coord.u)
+                          : univ.cells_;
+    for (auto i_cell : cells) {
+      if (i_cell == coord.cell || !in_box(boxes[i_cell], coord.r))
+        continue;
+      if (!model::cells[i_cell]->contains(coord.r, coord.u, 0))
+        continue;
+      auto key = std::make_tuple(coord.universe, std::min(i_cell, coord.cell),
+        std::max(i_cell, coord.cell));
+      overlaps[key].add(1, {r.x, r.x, r.y, r.y, r.z, r.z});
+    }
+  }
+}
+
+void move(GeometryState& p, double d)
+{
+  for (int j = 0; j < p.n_coord(); ++j) {
+    p.coord(j).r += d * p.coord(j).u;
+  }
+}
+
+//! Track a ray with a random position and direction from one side of the box
+//! to the other, checking the midpoint of each segment for overlaps
+
+void trace_ray(const BoundingBox& box, GeometryState& p, uint64_t* seed,
+  const vector<BoundingBox>& boxes, OverlapMap& overlaps)
+{
+  Position lower {box.xmin, box.ymin, box.zmin};
+  Position upper {box.xmax, box.ymax, box.zmax};
+  Position xi {prn(seed), prn(seed), prn(seed)};
+  Position r = lower + xi * (upper - lower);
+  double mu = 2.0 * prn(seed) - 1.0;
+  double phi = 2.0 * PI * prn(seed);
+  double s = std::sqrt(1.0 - mu * mu);
+  Direction u {s * std::cos(phi), s * std::sin(phi), mu};
+
+  // Find the chord of the box through the point
+  double t_min = -INFTY;
+  double t_max = INFTY;
+  for (int i = 0; i < 3; ++i) {
+    if (u[i] == 0.0)
+      continue;
+    double t0 = (lower[i] - r[i]) / u[i];
+    double t1 = (upper[i] - r[i]) / u[i];
+    t_min = std::max(t_min, std::min(t0, t1));
+    t_max = std::min(t_max, std::max(t0, t1));
+  }
+  double length = t_max - t_min;
+
+  p.init_from_r_u(r + t_min * u, u);
+  bool found = exhaustive_find_cell(p);
+  double traveled = 0.0;
+  for (int i = 0; i < MAX_RAY_SEGMENTS && traveled < length; ++i) {
+    if (!found) {
+      // Move through the void to where the ray enters the geometry again
+      double d = distance_to_geometry(p) + TINY_BIT;
+      traveled += d;
+      if (traveled >= length)
+        break;
+      p.n_coord() = 1;
+      p.r() += d * u;
+      p.surface() = 0;
+      found = exhaustive_find_cell(p);
+      continue;
+    }
+
+    // Test the midpoint of the segment, which is away from its surfaces
+    auto boundary = distance_to_boundary(p);
+    double d = std::min(boundary.distance, length - traveled);
+    move(p, 0.5 * d);
+    p.surface() = 0;
+    check_point(p, boxes, overlaps);
+    traveled += d;
+    if (traveled >= length)
+      break;
+
+    // Move to the boundary and find the cell on the other side
+    move(p, 0.5 * d);
+    p.surface() = boundary.surface_index;
+    p.n_coord_last() = p.n_coord();
+    p.n_coord() = boundary.coord_level;
+    const auto& t = boundary.lattice_translation;
+    if (t[0] != 0 || t[1] != 0 || t[2] != 0) {
+      const auto& coord = p.lowest_coord();
+      array<int, 3> i_xyz {coord.lattice_i[0] + t[0],
+        coord.lattice_i[1] + t[1], coord.lattice_i[2] + t[2]};
+      if (model::lattices[coord.lattice]->are_valid_indices(i_xyz)) {
+        cross_lattice(p, boundary);
+        continue;
+      }
+    } else if (neighbor_list_find_cell(p)) {
+      continue;
+    }
+    p.n_coord() = 1;
+    found = exhaustive_find_cell(p);
+  }
+}
+
+vector<double> pack(const OverlapMap& overlaps)
+{
+  vector<double> buffer;
+  buffer.reserve(PACKED_SIZE * overlaps.size());
+  for (const auto& [key, o] : overlaps) {
+    const auto& b {o.extent};
+    buffer.insert(buffer.end(),
+      {static_cast<double>(std::get<0>(key)),
+        static_cast<double>(std::get<1>(key)),
+        static_cast<double>(std::get<2>(key)), static_cast<double>(o.count),
+        b.xmin, b.xmax, b.ymin, b.ymax, b.zmin, b.zmax});
+  }
+  return buffer;
+}
+
+void add_packed(OverlapMap& overlaps, const vector<double>& buffer)
+{
+  for (int i = 0; i < buffer.size(); i += PACKED_SIZE) {
+    const double* x = &buffer[i];
+    auto key = std::make_tuple(static_cast<int32_t>(x[0]),
+      static_cast<int32_t>(x[1]), static_cast<int32_t>(x[2]));
+    overlaps[key].add(static_cast<int64_t>(x[3]),
+      {x[4], x[5], x[6], x[7], x[8], x[9]});
+  }
+}
+
+} // namespace
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void run_overlap_check()
+{
+  Timer timer;
+  timer.start();
+
+  BoundingBox box = model::universes[model::root_universe]->bounding_box();
+  if (box.xmin == -INFTY || box.xmax == INFTY || box.ymin == -INFTY ||
+      box.ymax == INFTY || box.zmin == -INFTY || box.zmax == INFTY) {
+    fatal_error("The overlap check requires a geometry whose bounding box is "
+                "finite.");
+  }
+
+  // Bounding boxes of the cells in the coordinates of their universes
+  vector<BoundingBox> boxes;
+  boxes.reserve(model::cells.size());
+  for (const auto& c : model::cells) {
+    boxes.push_back(c->bounding_box());
+  }
+
+  // Divide rays over MPI processes
+  int64_t n_rays = settings::n_particles;
+  int64_t min_rays = n_rays / mpi::n_procs;
+  int64_t remainder = n_rays % mpi::n_procs;
+  int64_t i_start =
+    min_rays * mpi::rank + std::min<int64_t>(mpi::rank, remainder);
+  int64_t i_end = i_start + min_rays + (mpi::rank < remainder ? 1 : 0);
+
+  OverlapMap overlaps;
+#pragma omp parallel
+  {
+    GeometryState p;
+    OverlapMap thread_overlaps;
+
+#pragma omp for schedule(dynamic, 64)
+    for (int64_t i = i_start; i < i_end; ++i) {
+      uint64_t seed = init_seed(i, STREAM_VOLUME);
+      trace_ray(box, p, &seed, boxes, thread_overlaps);
+    }
+
+#pragma omp critical(merge_overlaps)
+    for (const auto& [key, o] : thread_overlaps) {
+      overlaps[key].add(o.count, o.extent);
+    }
+  }
+
+#ifdef OPENMC_MPI
+  if (mpi::master) {
+    for (int j = 1; j < mpi::n_procs; j++) {
+      int64_t q;
+      MPI_Recv(&q, 1, MPI_INT64_T, j, 2 * j, mpi::intracomm, MPI_STATUS_IGNORE);
+      vector<double> buffer(q);
+      MPI_Recv(buffer.data(), q, MPI_DOUBLE, j, 2 * j + 1, mpi::intracomm,
+        MPI_STATUS_IGNORE);
+      add_packed(overlaps, buffer);
+    }
+  } else {
+    auto buffer = pack(overlaps);
+    int64_t q = buffer.size();
+    MPI_Send(&q, 1, MPI_INT64_T, 0, 2 * mpi::rank, mpi::intracomm);
+    MPI_Send(
+      buffer.data(), q, MPI_DOUBLE, 0, 2 * mpi::rank + 1, mpi::intracomm);
+  }
+#endif
+  timer.stop();
+
+  if (!mpi::master)
+    return;
+
+  header("cell overlap check summary", 1);
+  fmt::print(" Traced {} rays in {:.4} seconds\n\n", n_rays, timer.elapsed());
+  if (overlaps.empty()) {
+    fmt::print(" No overlapping cells were found\n\n");
+    return;
+  }
+
+  fmt::print(
+    " Universe     Cell     Cell   Segments  Extent of the midpoints\n");
+  for (const auto& [key, o] : overlaps) {
+    const auto& [i_univ, i_cell, j_cell] = key;
+    const auto& b {o.extent};
+    fmt::print(" {:8} {:8} {:8} {:10}  ({:.6g}, {:.6g}, {:.6g}) to "
+               "({:.6g}, {:.6g}, {:.6g})\n",
+      model::universes[i_univ]->id_, model::cells[i_cell]->id_,
+      model::cells[j_cell]->id_, o.count, b.xmin, b.ymin, b.zmin, b.xmax,
+      b.ymax, b.zmax);
+  }
+  fmt::print("\n");
+  warning(fmt::format(
+    "Found {} pairs of overlapping cells along the rays.", overlaps.size()));
+}
+
+} // namespace openmc
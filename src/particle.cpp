@@ -8,8 +8,11 @@
 #include "openmc/bank.h"
 #include "openmc/capi.h"
 #include "openmc/cell.h"
+#include "openmc/census.h"
 #include "openmc/constants.h"
 #include "openmc/dagmc.h"
+#include "openmc/delta_tracking.h"
+#include "openmc/distribution_multi.h"
 #include "openmc/error.h"
 #include "openmc/geometry.h"
 #include "openmc/hdf5_interface.h"
@@ -17,18 +20,24 @@
 #include "openmc/message_passing.h"
 #include "openmc/mgxs_interface.h"
 #include "openmc/nuclide.h"
+#include "openmc/openmp_interface.h"
 #include "openmc/particle_data.h"
 #include "openmc/photon.h"
+#include "openmc/profile.h"
 #include "openmc/physics.h"
 #include "openmc/physics_mg.h"
 #include "openmc/random_lcg.h"
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
 #include "openmc/source.h"
+#include "openmc/surf_source_stream.h"
 #include "openmc/surface.h"
 #include "openmc/tallies/derivative.h"
+#include "openmc/tallies/reaction_rates.h"
 #include "openmc/tallies/tally.h"
 #include "openmc/tallies/tally_scoring.h"
+#include "openmc/telemetry.h"
+#include "openmc/thread_stats.h"
 #include "openmc/track_output.h"
 #include "openmc/weight_windows.h"
 
@@ -91,6 +100,22 @@ void Particle::create_secondary(
     return;
   }
 
+  // With inline deposition, electrons and positrons created by photons are not
+  // banked, so their kinetic energy is part of the energy deposited by this
+  // collision. A positron annihilates here, as it would right after being
+  // created.
+  if (settings::electron_inline_deposition &&
+      this->type() == ParticleType::photon) {
+    if (type == ParticleType::electron)
+      return;
+    if (type == ParticleType::positron) {
+      Direction u_photon = isotropic_direction(current_seed());
+      create_secondary(wgt, u_photon, MASS_ELECTRON_EV, ParticleType::photon);
+      create_secondary(wgt, -u_photon, MASS_ELECTRON_EV, ParticleType::photon);
+      return;
+    }
+  }
+
   secondary_bank().emplace_back();
 
   auto& bank {secondary_bank().back()};
@@ -104,6 +129,37 @@ void Particle::create_secondary(
   n_bank_second() += 1;
 }
 
+void Particle::split(int n_copies, double wgt)
+{
+  if (n_copies <= 0)
+    return;
+
+  int64_t i_site = secondary_bank().size();
+  create_secondary(wgt, u(), E(), type());
+  if (n_copies > 1 && secondary_bank().size() > i_site) {
+    split_records().push_back({i_site, n_copies});
+  }
+}
+
+double Particle::energy_banked_second()
+{
+  const auto& bank = secondary_bank();
+  int64_t i_first = bank.size() - n_bank_second();
+  double E = 0.0;
+  for (int64_t i = i_first; i < bank.size(); ++i) {
+    E += bank[i].E;
+  }
+
+  // Add the copies of split particles beyond the first
+  const auto& records = split_records();
+  for (auto it = records.rbegin(); it != records.rend(); ++it) {
+    if (it->i_site < i_first)
+      break;
+    E += (it->n_copies - 1) * bank[it->i_site].E;
+  }
+  return E;
+}
+
 void Particle::from_source(const SourceSite* src)
 {
   // Reset some attributes
@@ -113,6 +169,7 @@ void Particle::from_source(const SourceSite* src)
   material() = C_NONE;
   n_collision() = 0;
   fission() = false;
+  wgt_absorb() = 0.0;
   zero_flux_derivs();
 
   // Copy attributes from source bank site
@@ -139,6 +196,12 @@ void Particle::from_source(const SourceSite* src)
 }
 
 void Particle::event_calculate_xs()
+{
+  if (this->event_calculate_xs_prepare())
+    model::materials[material()]->calculate_xs(*this);
+}
+
+bool Particle::event_calculate_xs_prepare()
 {
   // Set the random number stream
   stream() = STREAM_TRACKING;
@@ -162,7 +225,7 @@ void Particle::event_calculate_xs()
     if (!exhaustive_find_cell(*this)) {
       mark_as_lost(
         "Could not find the cell containing particle " + std::to_string(id()));
-      return;
+      return false;
     }
 
     // Set birth cell attribute
@@ -186,17 +249,20 @@ void Particle::event_calculate_xs()
   // Calculate microscopic and macroscopic cross sections
   if (material() != MATERIAL_VOID) {
     if (settings::run_CE) {
-      if (material() != material_last() || sqrtkT() != sqrtkT_last()) {
-        // If the material is the same as the last material and the
-        // temperature hasn't changed, we don't need to lookup cross
-        // sections again.
-        model::materials[material()]->calculate_xs(*this);
-      }
+      // If the material is the same as the last material and the
+      // temperature hasn't changed, we don't need to lookup cross
+      // sections again.
+      bool lookup =
+        material() != material_last() || sqrtkT() != sqrtkT_last();
+      if (lookup)
+        profile_xs_lookup(*this);
+      return lookup;
     } else {
       // Get the MG data; unlike the CE case above, we have to re-calculate
       // cross sections for every collision since the cross sections may
       // be angle-dependent
       data::mg.macro_xs_[material()].calculate_xs(*this);
+      profile_xs_lookup(*this);
 
       // Update the particle's group while we know we are multi-group
       g_last() = g();
@@ -207,25 +273,72 @@ void Particle::event_calculate_xs()
     macro_xs().fission = 0.0;
     macro_xs().nu_fission = 0.0;
   }
+  return false;
 }
 
 void Particle::event_advance()
 {
+  count_thread_event(&ThreadStats::segments);
+
+  // Particles born after the census time, such as delayed neutrons emitted
+  // by their precursors late in the time step, wait for a later step
+  double time_cutoff = settings::time_cutoff[static_cast<int>(type())];
+  bool census = simulation::census_time < time_cutoff;
+  if (time() >= simulation::census_time) {
+    if (census)
+      bank_census_site(*this);
+    wgt() = 0.0;
+    return;
+  }
+
+  // Neutrons in a delta-tracking region are tracked without finding the
+  // boundaries of the cells inside it
+  int level = delta_tracking_level(*this);
+  if (level != C_NONE) {
+    this->event_advance_delta(level);
+    return;
+  }
+
   // Find the distance to the nearest boundary
   boundary() = distance_to_boundary(*this);
 
-  // Sample a distance to collision
+  // Sample a distance to collision, from a stretched total cross section if
+  // an exponential transform applies in the current cell
+  double total = macro_xs().total;
+  const auto* transform = get_exponential_transform(*this);
+  if (transform && total > 0.0)
+    total = transform->stretched_total(total, u());
+
   if (type() == ParticleType::electron || type() == ParticleType::positron) {
     collision_distance() = 0.0;
   } else if (macro_xs().total == 0.0) {
     collision_distance() = INFINITY;
   } else {
-    collision_distance() = -std::log(prn(current_seed())) / macro_xs().total;
+    collision_distance() = -std::log(prn(current_seed())) / total;
   }
 
   // Select smaller of the two distances
   double distance = std::min(boundary().distance, collision_distance());
 
+  // A flight reaching the census time ends there, and only the part before it
+  // is scored
+  double census_distance = (simulation::census_time - time()) * speed();
+  bool hit_census = census && census_distance < distance;
+  if (hit_census)
+    distance = census_distance;
+
+  // With an exponential transform, the weight of the particle decreases by a
+  // factor exp(-(sigma_t - sigma_t*) * s) along the flight. Track-length
+  // estimates are scored with the mean weight along the flight.
+  double wgt_start = wgt();
+  double attenuation = 1.0;
+  if (transform && macro_xs().total > 0.0) {
+    double a = (macro_xs().total - total) * distance;
+    attenuation = std::exp(-a);
+    if (a != 0.0)
+      wgt() *= -std::expm1(-a) / a;
+  }
+
   // Advance particle in space and time
   // Short-term solution until the surface source is revised and we can use
   // this->move_distance(distance)
@@ -234,9 +347,11 @@ void Particle::event_advance()
   }
   this->time() += distance / this->speed();
 
+  if (hit_census)
+    time() = simulation::census_time;
+
   // Kill particle if its time exceeds the cutoff
   bool hit_time_boundary = false;
-  double time_cutoff = settings::time_cutoff[static_cast<int>(type())];
   if (time() > time_cutoff) {
     double dt = time() - time_cutoff;
     time() = time_cutoff;
@@ -245,12 +360,18 @@ void Particle::event_advance()
     this->move_distance(-push_back_distance);
     hit_time_boundary = true;
   }
+  profile_segment(*this, distance);
 
   // Score track-length tallies
   if (!model::active_tracklength_tallies.empty()) {
     score_tracklength_tally(*this, distance);
   }
 
+  // Score reaction rates for depletion
+  if (simulation::reaction_rates.active_) {
+    simulation::reaction_rates.score_tracklength(*this, distance);
+  }
+
   // Score track-length estimate of k-eff
   if (settings::run_mode == RunMode::EIGENVALUE &&
       type() == ParticleType::neutron) {
@@ -262,14 +383,127 @@ void Particle::event_advance()
     score_track_derivative(*this, distance);
   }
 
+  // Correct the weight for the flight sampled with the stretched cross
+  // section, including the ratio of the collision densities at a collision
+  if (transform && macro_xs().total > 0.0) {
+    wgt() = wgt_start * attenuation;
+    if (collision_distance() < boundary().distance && !hit_census)
+      wgt() *= macro_xs().total / total;
+
+    // Events at the end of the flight see the corrected weight
+    wgt_last() = wgt();
+  }
+
+  // A particle stopped at the census continues from its state in the next
+  // time step
+  if (hit_census)
+    bank_census_site(*this);
+
   // Set particle weight to zero if it hit the time boundary
-  if (hit_time_boundary) {
+  if (hit_time_boundary || hit_census) {
+    wgt() = 0.0;
+  }
+}
+
+void Particle::event_advance_delta(int level)
+{
+  // Only the boundaries of the region and of the cells containing it end the
+  // flight
+  boundary() = distance_to_boundary(*this, level + 1);
+  const auto& majorant =
+    model::majorants[model::cell_majorant[coord(level).cell]];
+  double sigma_maj = majorant(E());
+
+  // A flight reaching the census time ends there
+  double time_cutoff = settings::time_cutoff[static_cast<int>(type())];
+  double census_distance = simulation::census_time < time_cutoff
+                             ? (simulation::census_time - time()) * speed()
+                             : INFINITY;
+  double max_distance = std::min(boundary().distance, census_distance);
+
+  collision_distance() = INFINITY;
+  double distance = 0.0;
+  while (true) {
+    // Sample the distance to the next tentative collision
+    double d = (sigma_maj > 0.0) ? -std::log(prn(current_seed())) / sigma_maj
+                                 : INFINITY;
+    bool hit_end = (distance + d >= max_distance);
+    if (hit_end)
+      d = max_distance - distance;
+    for (int j = 0; j < n_coord(); ++j) {
+      coord(j).r += d * coord(j).u;
+    }
+    distance += d;
+    if (hit_end)
+      break;
+
+    // Find the cell and material at the tentative collision site, searching
+    // from the cell filled by the region
+    surface() = 0;
+    n_coord() = level + 1;
+    if (!exhaustive_find_cell(*this)) {
+      mark_as_lost(fmt::format(
+        "Could not find the cell containing particle {} in a delta-tracking "
+        "region.",
+        id()));
+      return;
+    }
+    if (material() == MATERIAL_VOID) {
+      macro_xs().total = 0.0;
+      macro_xs().absorption = 0.0;
+      macro_xs().fission = 0.0;
+      macro_xs().nu_fission = 0.0;
+    } else if (material() != material_last() || sqrtkT() != sqrtkT_last()) {
+      model::materials[material()]->calculate_xs(*this);
+      profile_xs_lookup(*this);
+    }
+
+    // Track-length estimates are replaced by estimates at every tentative
+    // collision, each scoring a flux of wgt/sigma_maj
+    if (settings::run_mode == RunMode::EIGENVALUE) {
+      keff_tally_tracklength() += wgt() * macro_xs().nu_fission / sigma_maj;
+    }
+    if (simulation::reaction_rates.active_) {
+      simulation::reaction_rates.score_tracklength(*this, 1.0 / sigma_maj);
+    }
+    if (!model::active_tallies.empty()) {
+      score_track_derivative(*this, 1.0 / sigma_maj);
+    }
+
+    // Accept the collision as real with probability sigma_t/sigma_maj
+    if (macro_xs().total > sigma_maj)
+      majorant_exceeded(E(), macro_xs().total, sigma_maj);
+    if (prn(current_seed()) * sigma_maj < macro_xs().total) {
+      collision_distance() = distance;
+      break;
+    }
+  }
+  this->time() += distance / this->speed();
+
+  // A particle stopped at the census continues from its state in the next
+  // time step
+  if (collision_distance() == INFINITY &&
+      census_distance < boundary().distance) {
+    time() = simulation::census_time;
+    bank_census_site(*this);
+    wgt() = 0.0;
+    return;
+  }
+
+  // Kill particle if its time exceeds the cutoff
+  if (time() > time_cutoff) {
+    double dt = time() - time_cutoff;
+    time() = time_cutoff;
+    this->move_distance(-speed() * dt);
     wgt() = 0.0;
   }
 }
 
 void Particle::event_cross_surface()
 {
+  count_thread_event(&ThreadStats::surface_crossings);
+  profile_surface_crossing(*this);
+
   // Saving previous cell data
   for (int j = 0; j < n_coord(); ++j) {
     cell_last(j) = coord(j).cell;
@@ -314,6 +548,8 @@ void Particle::event_cross_surface()
 
 void Particle::event_collide()
 {
+  count_thread_event(&ThreadStats::collisions);
+
   // Score collision estimate of keff
   if (settings::run_mode == RunMode::EIGENVALUE &&
       type() == ParticleType::neutron) {
@@ -335,6 +571,7 @@ void Particle::event_collide()
   } else {
     collision_mg(*this);
   }
+  profile_collision(*this);
 
   // Score collision estimator tallies -- this is done after a collision
   // has occurred rather than before because we need information on the
@@ -414,8 +651,20 @@ void Particle::event_revive_from_secondary()
     if (secondary_bank().empty())
       return;
 
+    // The last site is kept in the bank while copies of a split particle
+    // sharing it remain
+    count_secondary(secondary_bank().size());
     from_source(&secondary_bank().back());
-    secondary_bank().pop_back();
+    auto& records = split_records();
+    int64_t i_site = secondary_bank().size() - 1;
+    bool copies_left = false;
+    if (!records.empty() && records.back().i_site == i_site) {
+      copies_left = --records.back().n_copies > 0;
+      if (!copies_left)
+        records.pop_back();
+    }
+    if (!copies_left)
+      secondary_bank().pop_back();
     n_event() = 0;
 
     // Subtract secondary particle energy from interim pulse-height results
@@ -461,21 +710,23 @@ void Particle::event_death()
     finalize_particle_track(*this);
   }
 
-// Contribute tally reduction variables to global accumulator
-#pragma omp atomic
-  global_tally_absorption += keff_tally_absorption();
-#pragma omp atomic
-  global_tally_collision += keff_tally_collision();
-#pragma omp atomic
-  global_tally_tracklength += keff_tally_tracklength();
-#pragma omp atomic
-  global_tally_leakage += keff_tally_leakage();
+  // Contribute tally reduction variables to the sums of this thread, which
+  // are added to the global accumulators at the end of the generation
+  auto& sums = simulation::history_sums[thread_num()];
+  sums.absorption += keff_tally_absorption();
+  sums.collision += keff_tally_collision();
+  sums.tracklength += keff_tally_tracklength();
+  sums.leakage += keff_tally_leakage();
+  sums.xs_temperature_hits += xs_temperature_hits();
+  sums.xs_temperature_misses += xs_temperature_misses();
 
   // Reset particle tallies once accumulated
   keff_tally_absorption() = 0.0;
   keff_tally_collision() = 0.0;
   keff_tally_tracklength() = 0.0;
   keff_tally_leakage() = 0.0;
+  xs_temperature_hits() = 0;
+  xs_temperature_misses() = 0;
 
   if (!model::active_pulse_height_tallies.empty()) {
     score_pulse_height_tally(*this, model::active_pulse_height_tallies);
@@ -494,11 +745,9 @@ void Particle::pht_collision_energy()
   // Adds the energy particles lose in a collision to the pulse-height
 
   // determine index of cell in pulse_height_cells
-  auto it = std::find(model::pulse_height_cells.begin(),
-    model::pulse_height_cells.end(), lowest_coord().cell);
+  int index = model::pulse_height_index[lowest_coord().cell];
 
-  if (it != model::pulse_height_cells.end()) {
-    int index = std::distance(model::pulse_height_cells.begin(), it);
+  if (index != C_NONE) {
     pht_storage()[index] += E_last() - E();
 
     // If the energy of the particle is below the cutoff, it will not be sampled
@@ -515,11 +764,9 @@ void Particle::pht_secondary_particles()
   // Removes the energy of secondary produced particles from the pulse-height
 
   // determine index of cell in pulse_height_cells
-  auto it = std::find(model::pulse_height_cells.begin(),
-    model::pulse_height_cells.end(), cell_born());
+  int index = model::pulse_height_index[cell_born()];
 
-  if (it != model::pulse_height_cells.end()) {
-    int index = std::distance(model::pulse_height_cells.begin(), it);
+  if (index != C_NONE) {
     pht_storage()[index] -= E();
   }
 }
@@ -561,7 +808,7 @@ void Particle::cross_surface(const Surface& surf)
 
     cell_instance() = 0;
     if (cell->distribcell_index_ >= 0)
-      cell_instance() = cell_instance_at_level(*this, n_coord() - 1);
+      cell_instance() = lowest_cell_instance(*this);
 
     material() = cell->material(cell_instance());
     sqrtkT() = cell->sqrtkT(cell_instance());
@@ -836,6 +1083,28 @@ void Particle::update_neutron_xs(
   // Get microscopic cross section cache
   auto& micro = this->neutron_xs(i_nuclide);
 
+  // If only the temperature changed, cross sections interpolated from the
+  // tables at the same energy are unchanged as long as the same temperature
+  // is selected. This does not hold when they also depend on the temperature
+  // through S(a,b) tables or NCrystal, or when they were sampled from
+  // probability tables. Multipole data is never used when index_temp is set.
+  if (this->E() == micro.last_E && this->sqrtkT() != micro.last_sqrtkT &&
+      i_sab == micro.index_sab && sab_frac == micro.sab_frac &&
+      i_sab == C_NONE && ncrystal_xs < 0.0 && micro.index_temp >= 0 &&
+      !micro.use_ptable) {
+    const auto& nuc {*data::nuclides[i_nuclide]};
+    int i_temp = nuc.temperature_index(*this);
+    if (i_temp == micro.index_temp) {
+      micro.last_sqrtkT = this->sqrtkT();
+      ++xs_temperature_hits();
+    } else {
+      data::nuclides[i_nuclide]->calculate_xs(
+        i_sab, i_grid, sab_frac, *this, i_temp);
+      ++xs_temperature_misses();
+    }
+    return;
+  }
+
   // If the cache doesn't match, recalculate micro xs
   if (this->E() != micro.last_E || this->sqrtkT() != micro.last_sqrtkT ||
       i_sab != micro.index_sab || sab_frac != micro.sab_frac) {
@@ -886,7 +1155,7 @@ ParticleType str_to_particle_type(std::string str)
 void add_surf_source_to_bank(Particle& p, const Surface& surf)
 {
   if (simulation::current_batch <= settings::n_inactive ||
-      simulation::surf_source_bank.full()) {
+      (!settings::surf_source_stream && simulation::surf_source_bank.full())) {
     return;
   }
 
@@ -966,7 +1235,11 @@ void add_surf_source_to_bank(Particle& p, const Surface& surf)
   site.particle = p.type();
   site.parent_id = p.id();
   site.progeny_id = p.n_progeny();
-  int64_t idx = simulation::surf_source_bank.thread_safe_append(site);
+  if (settings::surf_source_stream) {
+    add_surf_source_to_stream(site);
+  } else {
+    simulation::surf_source_bank.thread_safe_append(site);
+  }
 }
 
 } // namespace openmc
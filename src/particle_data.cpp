@@ -15,6 +15,14 @@
 
 namespace openmc {
 
+#ifdef OPENMC_PARTICLE_SOA
+namespace simulation {
+
+ParticleSoA particle_soa;
+
+} // namespace simulation
+#endif
+
 void GeometryState::mark_as_lost(const std::string& message)
 {
   mark_as_lost(message.c_str());
@@ -46,6 +54,7 @@ void LocalCoord::reset()
   lattice_i[1] = 0;
   lattice_i[2] = 0;
   rotated = false;
+  instance_map = C_NONE;
 }
 
 GeometryState::GeometryState()
@@ -53,6 +62,7 @@ GeometryState::GeometryState()
   // Create and clear coordinate levels
   coord_.resize(model::n_coord_levels);
   cell_last_.resize(model::n_coord_levels);
+  surface_distances_.resize(model::n_coord_levels);
   clear();
 }
 
@@ -70,9 +80,19 @@ ParticleData::ParticleData()
 
   // Allocate space for tally filter matches
   filter_matches_.resize(model::tally_filters.size());
-
-  // Create microscopic cross section caches
-  neutron_xs_.resize(data::nuclides.size());
+  filter_bin_caches_.resize(model::n_filter_groups);
+
+  // Create microscopic cross section caches. The compact neutron cache holds
+  // one slot per nuclide in the largest material plus an overflow slot.
+  // Photon-only runs have no neutron cross sections to cache.
+  if (settings::photon_only) {
+    neutron_xs_.clear();
+  } else if (settings::compact_micro_xs) {
+    compact_neutron_xs_ = true;
+    neutron_xs_.resize(model::max_material_nuclides + 1);
+  } else {
+    neutron_xs_.resize(data::nuclides.size());
+  }
   photon_xs_.resize(data::elements.size());
 
   // Creates the pulse-height storage for the particle
@@ -81,6 +101,20 @@ ParticleData::ParticleData()
   }
 }
 
+#ifdef OPENMC_PARTICLE_SOA
+void ParticleData::use_soa_slot(int64_t i)
+{
+  auto& soa = simulation::particle_soa;
+  soa.E[i] = E_;
+  soa.E_last[i] = E_last_;
+  soa.wgt[i] = wgt_;
+  soa.material[i] = material();
+  soa.sqrtkT[i] = sqrtkT();
+  soa.macro_xs[i] = macro_xs_;
+  soa_index_ = i;
+}
+#endif
+
 TrackState ParticleData::get_track_state() const
 {
   TrackState state;
@@ -79,6 +79,9 @@ void run_particle_restart()
   // Initialize nuclear data (energy limits, log grid, etc.)
   initialize_data();
 
+  // Allocate the sums the particle adds to when it dies
+  init_history_sums();
+
   // Initialize the particle to be tracked
   Particle p;
 
@@ -19,6 +19,7 @@
 #include "xtensor/xslice.hpp"
 #include "xtensor/xview.hpp"
 
+#include <algorithm> // for max, min
 #include <cmath>
 #include <fmt/core.h>
 #include <tuple> // for tie
@@ -40,6 +41,89 @@ vector<unique_ptr<PhotonInteraction>> elements;
 
 } // namespace data
 
+namespace {
+
+//! Number of intervals of the coarsest and finest log-uniform grids used to
+//! tabulate photon cross sections
+constexpr int MIN_XS_TABLE_BINS {256};
+constexpr int MAX_XS_TABLE_BINS {65536};
+
+} // namespace
+
+//==============================================================================
+// PhotonXSTable implementation
+//==============================================================================
+
+PhotonXSTable::PhotonXSTable(double log_E_min, double log_E_max,
+  const vector<double>& edges, const vector<double>& kinks, double tolerance,
+  const std::function<void(double, double*)>& evaluate)
+  : log_E_min_ {log_E_min}
+{
+  int n_bins = MIN_XS_TABLE_BINS;
+  while (true) {
+    double spacing = (log_E_max - log_E_min) / n_bins;
+    auto bin = [&](double log_E) {
+      int j = (log_E - log_E_min) / spacing;
+      return std::max(0, std::min(j, n_bins - 1));
+    };
+
+    values_.resize(4 * (n_bins + 1));
+    for (int j = 0; j <= n_bins; ++j) {
+      evaluate(log_E_min + j * spacing, &values_[4 * j]);
+    }
+
+    // Intervals containing a discontinuity are never interpolated
+    vector<bool> edge(n_bins, false);
+    for (double log_E : edges) {
+      if (log_E >= log_E_min && log_E <= log_E_max)
+        edge[bin(log_E)] = true;
+    }
+
+    // Check the interpolation error at the middle of each interval and at the
+    // kinks of the data
+    exact_.assign(n_bins, false);
+    auto check = [&](double log_E) {
+      int j = bin(log_E);
+      double g = (log_E - log_E_min) / spacing - j;
+      double xs[4];
+      evaluate(log_E, xs);
+      double total = xs[0] + xs[1] + xs[2] + xs[3];
+      for (int k = 0; k < 4; ++k) {
+        double lo = values_[4 * j + k];
+        double value = lo + g * (values_[4 * (j + 1) + k] - lo);
+        if (std::abs(value - xs[k]) > tolerance * total)
+          exact_[j] = true;
+      }
+    };
+    for (int j = 0; j < n_bins; ++j) {
+      check(log_E_min + (j + 0.5) * spacing);
+    }
+    for (double log_E : kinks) {
+      if (log_E > log_E_min && log_E < log_E_max)
+        check(log_E);
+    }
+
+    int n_failed = 0;
+    for (int j = 0; j < n_bins; ++j) {
+      if (exact_[j] && !edge[j])
+        ++n_failed;
+      exact_[j] = exact_[j] || edge[j];
+    }
+    if (n_failed == 0 || n_bins >= MAX_XS_TABLE_BINS)
+      break;
+    n_bins *= 2;
+  }
+
+  inv_spacing_ = n_bins / (log_E_max - log_E_min);
+}
+
+void PhotonXSTable::scale(double f)
+{
+  for (auto& x : values_) {
+    x *= f;
+  }
+}
+
 //==============================================================================
 // PhotonInteraction implementation
 //==============================================================================
@@ -248,6 +332,27 @@ PhotonInteraction::PhotonInteraction(hid_t group)
     }
   }
 
+  // Build guide tables so that the shell and the momentum of the electron are
+  // found without searching from the start of each CDF
+  if (settings::guide_table_cells > 0) {
+    electron_cdf_.assign(electron_pdf_.size() + 1, 0.0);
+    double c = 0.0;
+    for (int i = 0; i < electron_pdf_.size(); ++i) {
+      c += electron_pdf_(i);
+      electron_cdf_[i + 1] = c;
+    }
+    electron_guide_ = GuideTable(electron_cdf_, settings::guide_table_cells);
+
+    vector<double> cdf(n_profile);
+    for (int i = 0; i < n_shell_compton; ++i) {
+      double total = profile_cdf_(i, n_profile - 1);
+      for (int j = 0; j < n_profile; ++j) {
+        cdf[j] = total > 0.0 ? profile_cdf_(i, j) / total : 0.0;
+      }
+      profile_guide_.emplace_back(cdf, settings::guide_table_cells);
+    }
+  }
+
   // Calculate total pair production
   pair_production_total_ = pair_production_nuclear_ + pair_production_electron_;
 
@@ -337,6 +442,14 @@ PhotonInteraction::PhotonInteraction(hid_t group)
   pair_production_total_ = xt::where(
     pair_production_total_ > 0.0, xt::log(pair_production_total_), -500.0);
   heating_ = xt::where(heating_ > 0.0, xt::log(heating_), -500.0);
+
+  // Tabulate the cross sections on a log-uniform grid
+  if (settings::photon_xs_tolerance > 0.0 && energy_.size() > 1) {
+    vector<double> kinks(energy_.begin() + 1, energy_.end() - 1);
+    xs_table_ = PhotonXSTable(energy_(0), energy_(energy_.size() - 1),
+      this->edges(), kinks, settings::photon_xs_tolerance,
+      [this](double log_E, double* xs) { this->interpolate_xs(log_E, xs); });
+  }
 }
 
 PhotonInteraction::~PhotonInteraction()
@@ -441,13 +554,22 @@ void PhotonInteraction::compton_doppler(
 
   int shell; // index for shell
   while (true) {
-    // Sample electron shell
+    // Sample electron shell. The guide table gives the same shell as the
+    // linear search over the running sum.
     double rn = prn(seed);
     double c = 0.0;
-    for (shell = 0; shell < electron_pdf_.size(); ++shell) {
-      c += electron_pdf_(shell);
-      if (rn < c)
-        break;
+    if (!electron_guide_.empty()) {
+      for (shell = electron_guide_.start(rn); shell < electron_pdf_.size();
+           ++shell) {
+        if (rn < electron_cdf_[shell + 1])
+          break;
+      }
+    } else {
+      for (shell = 0; shell < electron_pdf_.size(); ++shell) {
+        c += electron_pdf_(shell);
+        if (rn < c)
+          break;
+      }
     }
 
     // Determine binding energy of shell
@@ -495,7 +617,12 @@ void PhotonInteraction::compton_doppler(
 
     // Determine pz corresponding to sampled cdf value
     auto cdf_shell = xt::view(profile_cdf_, shell, xt::all());
-    int i = lower_bound_index(cdf_shell.cbegin(), cdf_shell.cend(), c);
+    int i;
+    if (!profile_guide_.empty()) {
+      i = profile_guide_[shell].find(cdf_shell, n, c, c / cdf_shell(n - 1));
+    } else {
+      i = lower_bound_index(cdf_shell.cbegin(), cdf_shell.cend(), c);
+    }
     double pz_l = data::compton_profile_pz(i);
     double pz_r = data::compton_profile_pz(i + 1);
     double p_l = profile_pdf_(shell, i);
@@ -551,13 +678,12 @@ void PhotonInteraction::compton_doppler(
   *i_shell = shell;
 }
 
-void PhotonInteraction::calculate_xs(Particle& p) const
+void PhotonInteraction::find_grid_index(
+  double log_E, int& i_grid, double& f) const
 {
   // Perform binary search on the element energy grid in order to determine
   // which points to interpolate between
   int n_grid = energy_.size();
-  double log_E = std::log(p.E());
-  int i_grid;
   if (log_E <= energy_[0]) {
     i_grid = 0;
   } else if (log_E > energy_(n_grid - 1)) {
@@ -573,35 +699,81 @@ void PhotonInteraction::calculate_xs(Particle& p) const
     ++i_grid;
 
   // calculate interpolation factor
-  double f =
-    (log_E - energy_(i_grid)) / (energy_(i_grid + 1) - energy_(i_grid));
-
-  auto& xs {p.photon_xs(index_)};
-  xs.index_grid = i_grid;
-  xs.interp_factor = f;
+  f = (log_E - energy_(i_grid)) / (energy_(i_grid + 1) - energy_(i_grid));
+}
 
+void PhotonInteraction::interpolate_xs(int i_grid, double f, double* xs) const
+{
   // Calculate microscopic coherent cross section
-  xs.coherent = std::exp(
+  xs[0] = std::exp(
     coherent_(i_grid) + f * (coherent_(i_grid + 1) - coherent_(i_grid)));
 
   // Calculate microscopic incoherent cross section
-  xs.incoherent = std::exp(
+  xs[1] = std::exp(
     incoherent_(i_grid) + f * (incoherent_(i_grid + 1) - incoherent_(i_grid)));
 
   // Calculate microscopic photoelectric cross section
-  xs.photoelectric = 0.0;
+  xs[2] = 0.0;
   const auto& xs_lower = xt::row(cross_sections_, i_grid);
   const auto& xs_upper = xt::row(cross_sections_, i_grid + 1);
 
   for (int i = 0; i < xs_upper.size(); ++i)
     if (xs_lower(i) != 0)
-      xs.photoelectric +=
-        std::exp(xs_lower(i) + f * (xs_upper(i) - xs_lower(i)));
+      xs[2] += std::exp(xs_lower(i) + f * (xs_upper(i) - xs_lower(i)));
 
   // Calculate microscopic pair production cross section
-  xs.pair_production = std::exp(
+  xs[3] = std::exp(
     pair_production_total_(i_grid) +
     f * (pair_production_total_(i_grid + 1) - pair_production_total_(i_grid)));
+}
+
+void PhotonInteraction::interpolate_xs(double log_E, double* xs) const
+{
+  int i_grid;
+  double f;
+  this->find_grid_index(log_E, i_grid, f);
+  this->interpolate_xs(i_grid, f, xs);
+}
+
+vector<double> PhotonInteraction::edges() const
+{
+  vector<double> result;
+  for (int i = 1; i < energy_.size(); ++i) {
+    if (energy_(i) == energy_(i - 1))
+      result.push_back(energy_(i));
+  }
+  for (const auto& shell : shells_) {
+    if (shell.threshold > 0)
+      result.push_back(energy_(shell.threshold));
+  }
+  return result;
+}
+
+void PhotonInteraction::calculate_xs(Particle& p) const
+{
+  double log_E = std::log(p.E());
+  auto& xs {p.photon_xs(index_)};
+  double values[4];
+
+  // Interpolate the tabulated cross sections, which needs neither a search
+  // nor any exponentials. The index on the energy grid of the element is only
+  // found if a photoelectric subshell is sampled.
+  if (xs_table_.interpolate(log_E, values)) {
+    xs.index_grid = -1;
+    xs.interp_factor = 0.0;
+  } else {
+    int i_grid;
+    double f;
+    this->find_grid_index(log_E, i_grid, f);
+    xs.index_grid = i_grid;
+    xs.interp_factor = f;
+    this->interpolate_xs(i_grid, f, values);
+  }
+
+  xs.coherent = values[0];
+  xs.incoherent = values[1];
+  xs.photoelectric = values[2];
+  xs.pair_production = values[3];
 
   // Calculate microscopic total cross section
   xs.total =
@@ -891,6 +1063,7 @@ void free_memory_photon()
   data::compton_profile_pz.resize({0});
   data::ttb_e_grid.resize({0});
   data::ttb_k_grid.resize({0});
+  data::ttb_e_guide = {};
 }
 
 } // namespace openmc
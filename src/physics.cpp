@@ -2,6 +2,7 @@
 
 #include "openmc/bank.h"
 #include "openmc/bremsstrahlung.h"
+#include "openmc/census.h"
 #include "openmc/constants.h"
 #include "openmc/distribution_multi.h"
 #include "openmc/eigenvalue.h"
@@ -12,6 +13,7 @@
 #include "openmc/message_passing.h"
 #include "openmc/ncrystal_interface.h"
 #include "openmc/nuclide.h"
+#include "openmc/openmp_interface.h"
 #include "openmc/photon.h"
 #include "openmc/physics_common.h"
 #include "openmc/random_dist.h"
@@ -28,7 +30,7 @@
 
 #include <fmt/core.h>
 
-#include <algorithm> // for max, min, max_element
+#include <algorithm> // for max, min, lower_bound, upper_bound
 #include <cmath>     // for sqrt, exp, log, abs, copysign
 #include <xtensor/xview.hpp>
 
@@ -59,8 +61,16 @@ void collision(Particle& p)
     break;
   }
 
-  if (settings::weight_window_checkpoint_collision)
-    apply_weight_windows(p);
+  // Play the weight game of the collision once. With survival biasing, a
+  // weight window found at the collision takes the place of roulette against
+  // the weight cutoff.
+  bool in_window = settings::weight_window_checkpoint_collision &&
+                   apply_weight_windows(p);
+  if (settings::survival_biasing && !in_window &&
+      p.type() == ParticleType::neutron && p.alive() &&
+      p.wgt() < settings::weight_cutoff) {
+    russian_roulette(p, settings::weight_survive);
+  }
 
   // Kill particle if energy falls below cutoff
   int type = static_cast<int>(p.type());
@@ -99,17 +109,17 @@ void sample_neutron_reaction(Particle& p)
   // Create fission bank sites. Note that while a fission reaction is sampled,
   // it never actually "happens", i.e. the weight of the particle does not
   // change when sampling fission sites. The following block handles all
-  // absorption (including fission)
+  // absorption (including fission). The fission reaction is only sampled when
+  // sites are created.
 
   const auto& nuc {data::nuclides[i_nuclide]};
 
   if (nuc->fissionable_ && p.neutron_xs(i_nuclide).fission > 0.0) {
-    auto& rx = sample_fission(i_nuclide, p);
     if (settings::run_mode == RunMode::EIGENVALUE) {
-      create_fission_sites(p, i_nuclide, rx);
+      create_fission_sites(p, i_nuclide, sample_fission(i_nuclide, p));
     } else if (settings::run_mode == RunMode::FIXED_SOURCE &&
                settings::create_fission_neutrons) {
-      create_fission_sites(p, i_nuclide, rx);
+      create_fission_sites(p, i_nuclide, sample_fission(i_nuclide, p));
 
       // Make sure particle population doesn't grow out of control for
       // subcritical multiplication problems.
@@ -127,9 +137,11 @@ void sample_neutron_reaction(Particle& p)
     sample_secondary_photons(p, i_nuclide);
   }
 
-  // If survival biasing is being used, the following subroutine adjusts the
-  // weight of the particle. Otherwise, it checks to see if absorption occurs
+  // If survival biasing is being used, the following subroutine removes the
+  // absorbed weight from the particle (implicit capture). Otherwise, it checks
+  // to see if absorption occurs
 
+  p.wgt_absorb() = 0.0;
   if (p.neutron_xs(i_nuclide).absorption > 0.0) {
     absorption(p, i_nuclide);
   }
@@ -150,12 +162,8 @@ void sample_neutron_reaction(Particle& p)
     advance_prn_seed(data::nuclides.size(), &p.seeds(STREAM_URR_PTABLE));
   }
 
-  // Play russian roulette if survival biasing is turned on
-  if (settings::survival_biasing) {
-    if (p.wgt() < settings::weight_cutoff) {
-      russian_roulette(p, settings::weight_survive);
-    }
-  }
+  // Russian roulette for survival biasing is played in collision() together
+  // with the weight windows
 }
 
 void create_fission_sites(Particle& p, int i_nuclide, const Reaction& rx)
@@ -164,16 +172,39 @@ void create_fission_sites(Particle& p, int i_nuclide, const Reaction& rx)
   // the expected number of fission sites produced
   double weight = settings::ufs_on ? ufs_get_weight(p) : 1.0;
 
+  // Determine whether to place fission sites into the shared fission bank
+  // or the secondary particle bank.
+  bool use_fission_bank = (settings::run_mode == RunMode::EIGENVALUE);
+
+  // With a Wielandt shift, a fraction 1/k_e of the fission neutrons is
+  // transported in the current generation and only the remainder is banked
+  // for the next generation
+  bool shifted = use_fission_bank && settings::wielandt_shift > 0.0;
+  double k_shifted = simulation::keff + settings::wielandt_shift;
+
   // Determine the expected number of neutrons produced
-  double nu_t = p.wgt() / simulation::keff * weight *
-                p.neutron_xs(i_nuclide).nu_fission /
-                p.neutron_xs(i_nuclide).total;
+  double nu_fission =
+    p.neutron_xs(i_nuclide).nu_fission / p.neutron_xs(i_nuclide).total;
+  double nu_t = p.wgt() / simulation::keff * weight * nu_fission;
+  if (shifted)
+    nu_t = p.wgt() * (1.0 / simulation::keff - 1.0 / k_shifted) * weight *
+           nu_fission;
 
   // Sample the number of neutrons produced
   int nu = static_cast<int>(nu_t);
   if (prn(p.current_seed()) <= (nu_t - nu))
     ++nu;
 
+  // Sample the number of neutrons transported in the current generation
+  int nu_shifted = 0;
+  if (shifted) {
+    double nu_s = p.wgt() / k_shifted * nu_fission;
+    nu_shifted = static_cast<int>(nu_s);
+    if (prn(p.current_seed()) <= (nu_s - nu_shifted))
+      ++nu_shifted;
+    nu += nu_shifted;
+  }
+
   // If no neutrons were produced then don't continue
   if (nu == 0)
     return;
@@ -187,45 +218,34 @@ void create_fission_sites(Particle& p, int i_nuclide, const Reaction& rx)
 
   p.fission() = true;
 
-  // Determine whether to place fission sites into the shared fission bank
-  // or the secondary particle bank.
-  bool use_fission_bank = (settings::run_mode == RunMode::EIGENVALUE);
-
-  // Counter for the number of fission sites successfully stored to the shared
-  // fission bank or the secondary particle bank
-  int n_sites_stored;
+  for (int i = 0; i < nu; ++i) {
+    // Neutrons transported in the current generation come first
+    bool banked = i >= nu_shifted;
 
-  for (n_sites_stored = 0; n_sites_stored < nu; n_sites_stored++) {
     // Initialize fission site object with particle data
     SourceSite site;
     site.r = p.r();
     site.particle = ParticleType::neutron;
     site.time = p.time();
-    site.wgt = 1. / weight;
+    site.wgt = banked ? 1. / weight : 1.;
     site.parent_id = p.id();
-    site.progeny_id = p.n_progeny()++;
+    site.progeny_id = banked ? p.n_progeny()++ : 0;
     site.surf_id = 0;
 
     // Sample delayed group and angle/energy for fission reaction
     sample_fission_neutron(i_nuclide, rx, &site, p);
 
+    // With a time census, delayed neutrons are emitted when their precursors
+    // decay, which may be in a later time step
+    if (census_on() && site.delayed_group > 0) {
+      double decay_rate = rx.products_[site.delayed_group].decay_rate_;
+      if (decay_rate > 0.0)
+        site.time -= std::log(prn(p.current_seed())) / decay_rate;
+    }
+
     // Store fission site in bank
-    if (use_fission_bank) {
-      int64_t idx = simulation::fission_bank.thread_safe_append(site);
-      if (idx == -1) {
-        warning(
-          "The shared fission bank is full. Additional fission sites created "
-          "in this generation will not be banked. Results may be "
-          "non-deterministic.");
-
-        // Decrement number of particle progeny as storage was unsuccessful.
-        // This step is needed so that the sum of all progeny is equal to the
-        // size of the shared fission bank.
-        p.n_progeny()--;
-
-        // Break out of loop as no more sites can be added to fission bank
-        break;
-      }
+    if (use_fission_bank && banked) {
+      bank_fission_site(site);
     } else {
       p.secondary_bank().push_back(site);
     }
@@ -246,20 +266,15 @@ void create_fission_sites(Particle& p, int i_nuclide, const Reaction& rx)
     nu_bank_entry->delayed_group = site.delayed_group;
   }
 
-  // If shared fission bank was full, and no fissions could be added,
-  // set the particle fission flag to false.
-  if (n_sites_stored == 0) {
-    p.fission() = false;
-    return;
+  // Count the neutrons transported in the current generation for normalizing
+  // the estimates of this generation
+  if (nu_shifted > 0) {
+    simulation::history_sums[thread_num()].wielandt_weight += nu_shifted;
   }
 
-  // Set nu to the number of fission sites successfully stored. If the fission
-  // bank was not found to be full then these values are already equivalent.
-  nu = n_sites_stored;
-
   // Store the total weight banked for analog fission tallies
   p.n_bank() = nu;
-  p.wgt_bank() = nu / weight;
+  p.wgt_bank() = (nu - nu_shifted) / weight + nu_shifted;
   for (size_t d = 0; d < MAX_DELAYED_GROUPS; d++) {
     p.n_delayed_bank(d) = nu_d[d];
   }
@@ -277,6 +292,11 @@ void sample_photon_reaction(Particle& p)
     return;
   }
 
+  // Cross sections tabulated for the material do not include those of each
+  // element, which are needed to sample the collision
+  if (p.macro_total_cdf().empty())
+    model::materials[p.material()]->calculate_element_photon_xs(p);
+
   // Sample element within material
   int i_element = sample_element(p);
   const auto& micro {p.photon_xs(i_element)};
@@ -349,12 +369,25 @@ void sample_photon_reaction(Particle& p)
 
   if (prob_after > cutoff) {
     // Get grid index, interpolation factor, and bounding subshell
-    // cross sections
+    // cross sections. The index is not known if the cross sections were
+    // evaluated from the tables of the element.
     int i_grid = micro.index_grid;
     double f = micro.interp_factor;
+    if (i_grid < 0)
+      element.find_grid_index(std::log(p.E()), i_grid, f);
     const auto& xs_lower = xt::row(element.cross_sections_, i_grid);
     const auto& xs_upper = xt::row(element.cross_sections_, i_grid + 1);
 
+    // A tabulated photoelectric cross section may slightly exceed the sum
+    // over subshells, in which case the last open subshell is chosen
+    int i_last = -1;
+    if (micro.index_grid < 0) {
+      for (int i = 0; i < element.shells_.size(); ++i) {
+        if (xs_lower(i) != 0)
+          i_last = i;
+      }
+    }
+
     for (int i_shell = 0; i_shell < element.shells_.size(); ++i_shell) {
       const auto& shell {element.shells_[i_shell]};
 
@@ -366,7 +399,7 @@ void sample_photon_reaction(Particle& p)
       prob += std::exp(
         xs_lower(i_shell) + f * (xs_upper(i_shell) - xs_lower(i_shell)));
 
-      if (prob > cutoff) {
+      if (prob > cutoff || i_shell == i_last) {
         // Determine binding energy based on whether atomic relaxation data is
         // present (if not, use value from Compton profile data)
         double binding_energy = element.has_atomic_relaxation_
@@ -477,21 +510,14 @@ int sample_nuclide(Particle& p)
   // Sample cumulative distribution function
   double cutoff = prn(p.current_seed()) * p.macro_xs().total;
 
-  // Get pointers to nuclide/density arrays
+  // The running sum of atom_density * micro total over the material's
+  // nuclides was stored when the cross sections were calculated, so the
+  // first nuclide that reaches the cutoff can be found by binary search
   const auto& mat {model::materials[p.material()]};
-  int n = mat->nuclide_.size();
-
-  double prob = 0.0;
-  for (int i = 0; i < n; ++i) {
-    // Get atom density
-    int i_nuclide = mat->nuclide_[i];
-    double atom_density = mat->atom_density_[i];
-
-    // Increment probability to compare to cutoff
-    prob += atom_density * p.neutron_xs(i_nuclide).total;
-    if (prob >= cutoff)
-      return i_nuclide;
-  }
+  const auto& cdf {p.macro_total_cdf()};
+  auto it = std::lower_bound(cdf.begin(), cdf.end(), cutoff);
+  if (it != cdf.end())
+    return mat->nuclide_[it - cdf.begin()];
 
   // If we reach here, no nuclide was sampled
   p.write_restart();
@@ -503,26 +529,18 @@ int sample_element(Particle& p)
   // Sample cumulative distribution function
   double cutoff = prn(p.current_seed()) * p.macro_xs().total;
 
-  // Get pointers to elements, densities
+  // Find the first element whose running sum of the total cross section,
+  // stored when the cross sections were calculated, exceeds the cutoff
   const auto& mat {model::materials[p.material()]};
+  const auto& cdf {p.macro_total_cdf()};
+  auto it = std::upper_bound(cdf.begin(), cdf.end(), cutoff);
+  if (it != cdf.end()) {
+    int i = it - cdf.begin();
 
-  double prob = 0.0;
-  for (int i = 0; i < mat->element_.size(); ++i) {
-    // Find atom density
-    int i_element = mat->element_[i];
-    double atom_density = mat->atom_density_[i];
-
-    // Determine microscopic cross section
-    double sigma = atom_density * p.photon_xs(i_element).total;
+    // Save which nuclide particle had collision with for tally purpose
+    p.event_nuclide() = mat->nuclide_[i];
 
-    // Increment probability to compare to cutoff
-    prob += sigma;
-    if (prob > cutoff) {
-      // Save which nuclide particle had collision with for tally purpose
-      p.event_nuclide() = mat->nuclide_[i];
-
-      return i_element;
-    }
+    return mat->element_[i];
   }
 
   // If we made it here, no element was sampled
@@ -578,8 +596,17 @@ void sample_photon_product(
   double cutoff = prn(p.current_seed()) * micro.photon_prod;
   double prob = 0.0;
 
-  // Loop through each reaction type
+  // Search the tabulated running sums of the photon production cross sections
+  // if they are available
   const auto& nuc {data::nuclides[i_nuclide]};
+  int i_photon = nuc->find_photon_product(micro, cutoff);
+  if (i_photon != C_NONE) {
+    *i_rx = nuc->photon_products_[i_photon].first;
+    *i_product = nuc->photon_products_[i_photon].second;
+    return;
+  }
+
+  // Loop through each reaction type
   for (int i = 0; i < nuc->reactions_.size(); ++i) {
     // Evaluate neutron cross section
     const auto& rx = nuc->reactions_[i];
@@ -623,8 +650,10 @@ void absorption(Particle& p, int i_nuclide)
     const double wgt_absorb = p.wgt() * p.neutron_xs(i_nuclide).absorption /
                               p.neutron_xs(i_nuclide).total;
 
-    // Adjust weight of particle by probability of absorption
+    // Adjust weight of particle by probability of absorption. The absorbed
+    // weight is kept so that absorption tallies can score it directly.
     p.wgt() -= wgt_absorb;
+    p.wgt_absorb() = wgt_absorb;
 
     // Score implicit absorption estimate of keff
     if (settings::run_mode == RunMode::EIGENVALUE) {
@@ -700,14 +729,7 @@ void scatter(Particle& p, int i_nuclide)
     // =======================================================================
     // INELASTIC SCATTERING
 
-    int n = nuc->index_inelastic_scatter_.size();
-    int i = 0;
-    for (int j = 0; j < n && prob < cutoff; ++j) {
-      i = nuc->index_inelastic_scatter_[j];
-
-      // add to cumulative probability
-      prob += nuc->reactions_[i]->xs(micro);
-    }
+    int i = nuc->sample_inelastic_scatter(micro, prob, cutoff);
 
     // Perform collision physics for inelastic scattering
     const auto& rx {nuc->reactions_[i]};
@@ -894,8 +916,8 @@ Direction sample_target_velocity(const Nuclide& nuc, double E, Direction u,
       xs_up += m * (E_up - nuc.energy_0K_[i_E_up]);
 
       // get max 0K xs value over range of practical relative energies
-      double xs_max = *std::max_element(
-        &nuc.elastic_0K_[i_E_low + 1], &nuc.elastic_0K_[i_E_up + 1]);
+      double xs_max =
+        nuc.elastic_0K_max_(nuc.elastic_0K_, i_E_low + 1, i_E_up + 1);
       xs_max = std::max({xs_low, xs_max, xs_up});
 
       while (true) {
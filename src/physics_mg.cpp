@@ -13,6 +13,7 @@
 #include "openmc/math_functions.h"
 #include "openmc/message_passing.h"
 #include "openmc/mgxs_interface.h"
+#include "openmc/openmp_interface.h"
 #include "openmc/particle.h"
 #include "openmc/physics_common.h"
 #include "openmc/random_lcg.h"
@@ -91,9 +92,22 @@ void create_fission_sites(Particle& p)
   // the expected number of fission sites produced
   double weight = settings::ufs_on ? ufs_get_weight(p) : 1.0;
 
+  // Determine whether to place fission sites into the shared fission bank
+  // or the secondary particle bank.
+  bool use_fission_bank = (settings::run_mode == RunMode::EIGENVALUE);
+
+  // With a Wielandt shift, a fraction 1/k_e of the fission neutrons is
+  // transported in the current generation and only the remainder is banked
+  // for the next generation
+  bool shifted = use_fission_bank && settings::wielandt_shift > 0.0;
+  double k_shifted = simulation::keff + settings::wielandt_shift;
+
   // Determine the expected number of neutrons produced
-  double nu_t = p.wgt() / simulation::keff * weight * p.macro_xs().nu_fission /
-                p.macro_xs().total;
+  double nu_fission = p.macro_xs().nu_fission / p.macro_xs().total;
+  double nu_t = p.wgt() / simulation::keff * weight * nu_fission;
+  if (shifted)
+    nu_t = p.wgt() * (1.0 / simulation::keff - 1.0 / k_shifted) * weight *
+           nu_fission;
 
   // Sample the number of neutrons produced
   int nu = static_cast<int>(nu_t);
@@ -101,6 +115,17 @@ void create_fission_sites(Particle& p)
     nu++;
   }
 
+  // Sample the number of neutrons transported in the current generation
+  int nu_shifted = 0;
+  if (shifted) {
+    double nu_s = p.wgt() / k_shifted * nu_fission;
+    nu_shifted = static_cast<int>(nu_s);
+    if (prn(p.current_seed()) <= (nu_s - nu_shifted)) {
+      nu_shifted++;
+    }
+    nu += nu_shifted;
+  }
+
   // If no neutrons were produced then don't continue
   if (nu == 0)
     return;
@@ -114,22 +139,17 @@ void create_fission_sites(Particle& p)
 
   p.fission() = true;
 
-  // Determine whether to place fission sites into the shared fission bank
-  // or the secondary particle bank.
-  bool use_fission_bank = (settings::run_mode == RunMode::EIGENVALUE);
+  for (int i = 0; i < nu; ++i) {
+    // Neutrons transported in the current generation come first
+    bool banked = i >= nu_shifted;
 
-  // Counter for the number of fission sites successfully stored to the shared
-  // fission bank or the secondary particle bank
-  int n_sites_stored;
-
-  for (n_sites_stored = 0; n_sites_stored < nu; n_sites_stored++) {
     // Initialize fission site object with particle data
     SourceSite site;
     site.r = p.r();
     site.particle = ParticleType::neutron;
-    site.wgt = 1. / weight;
+    site.wgt = banked ? 1. / weight : 1.;
     site.parent_id = p.id();
-    site.progeny_id = p.n_progeny()++;
+    site.progeny_id = banked ? p.n_progeny()++ : 0;
 
     // Sample the cosine of the angle, assuming fission neutrons are emitted
     // isotropically
@@ -155,22 +175,8 @@ void create_fission_sites(Particle& p)
     site.delayed_group = dg + 1;
 
     // Store fission site in bank
-    if (use_fission_bank) {
-      int64_t idx = simulation::fission_bank.thread_safe_append(site);
-      if (idx == -1) {
-        warning(
-          "The shared fission bank is full. Additional fission sites created "
-          "in this generation will not be banked. Results may be "
-          "non-deterministic.");
-
-        // Decrement number of particle progeny as storage was unsuccessful.
-        // This step is needed so that the sum of all progeny is equal to the
-        // size of the shared fission bank.
-        p.n_progeny()--;
-
-        // Break out of loop as no more sites can be added to fission bank
-        break;
-      }
+    if (use_fission_bank && banked) {
+      bank_fission_site(site);
     } else {
       p.secondary_bank().push_back(site);
     }
@@ -191,20 +197,15 @@ void create_fission_sites(Particle& p)
     nu_bank_entry->delayed_group = site.delayed_group;
   }
 
-  // If shared fission bank was full, and no fissions could be added,
-  // set the particle fission flag to false.
-  if (n_sites_stored == 0) {
-    p.fission() = false;
-    return;
+  // Count the neutrons transported in the current generation for normalizing
+  // the estimates of this generation
+  if (nu_shifted > 0) {
+    simulation::history_sums[thread_num()].wielandt_weight += nu_shifted;
   }
 
-  // Set nu to the number of fission sites successfully stored. If the fission
-  // bank was not found to be full then these values are already equivalent.
-  nu = n_sites_stored;
-
   // Store the total weight banked for analog fission tallies
   p.n_bank() = nu;
-  p.wgt_bank() = nu / weight;
+  p.wgt_bank() = (nu - nu_shifted) / weight + nu_shifted;
   for (size_t d = 0; d < MAX_DELAYED_GROUPS; d++) {
     p.n_delayed_bank(d) = nu_d[d];
   }
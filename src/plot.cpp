@@ -94,6 +94,27 @@ void PropertyData::set_overlap(size_t y, size_t x)
   data_(y, x) = OVERLAP;
 }
 
+double slice_span_length(GeometryState& p, Position r, Direction u)
+{
+  p.r() = r;
+  p.u() = u;
+  p.surface() = 0;
+  p.n_coord() = 1;
+  p.coord(0).universe = model::root_universe;
+  if (!exhaustive_find_cell(p))
+    return -1.0;
+  return distance_to_boundary(p).distance;
+}
+
+bool slice_ray_trace_supported()
+{
+  for (const auto& univ : model::universes) {
+    if (univ->geom_type() == GeometryType::DAG)
+      return false;
+  }
+  return true;
+}
+
 //==============================================================================
 // Global variables
 //==============================================================================
@@ -930,37 +951,49 @@ void Plot::create_voxel() const
   // initial particle position
   Position ll = origin_ - width_ / 2.;
 
-  // Open binary plot file for writing
-  std::ofstream of;
-  std::string fname = std::string(path_plot_);
-  fname = strtrim(fname);
-  hid_t file_id = file_open(fname, 'w');
+  // Slices are dealt out to the processes in turn, so that each process
+  // generates one slice per round and the slices of a round are written
+  // together. With parallel HDF5 every process writes its own slices;
+  // otherwise they are sent to the master process.
+#ifdef PHDF5
+  bool parallel = mpi::n_procs > 1;
+#else
+  bool parallel = false;
+#endif
+  bool writer = parallel || mpi::master;
 
-  // write header info
-  write_attribute(file_id, "filetype", "voxel");
-  write_attribute(file_id, "version", VERSION_VOXEL);
-  write_attribute(file_id, "openmc_version", VERSION);
+  hid_t file_id, dspace, dset, memspace;
+  if (writer) {
+    // Open binary plot file for writing
+    std::string fname = std::string(path_plot_);
+    fname = strtrim(fname);
+    file_id = file_open(fname, 'w', parallel);
+
+    // write header info
+    write_attribute(file_id, "filetype", "voxel");
+    write_attribute(file_id, "version", VERSION_VOXEL);
+    write_attribute(file_id, "openmc_version", VERSION);
 
 #ifdef GIT_SHA1
-  write_attribute(file_id, "git_sha1", GIT_SHA1);
+    write_attribute(file_id, "git_sha1", GIT_SHA1);
 #endif
 
-  // Write current date and time
-  write_attribute(file_id, "date_and_time", time_stamp().c_str());
-  array<int, 3> pixels;
-  std::copy(pixels_.begin(), pixels_.end(), pixels.begin());
-  write_attribute(file_id, "num_voxels", pixels);
-  write_attribute(file_id, "voxel_width", vox);
-  write_attribute(file_id, "lower_left", ll);
-
-  // Create dataset for voxel data -- note that the dimensions are reversed
-  // since we want the order in the file to be z, y, x
-  hsize_t dims[3];
-  dims[0] = pixels_[2];
-  dims[1] = pixels_[1];
-  dims[2] = pixels_[0];
-  hid_t dspace, dset, memspace;
-  voxel_init(file_id, &(dims[0]), &dspace, &dset, &memspace);
+    // Write current date and time
+    write_attribute(file_id, "date_and_time", time_stamp().c_str());
+    array<int, 3> pixels;
+    std::copy(pixels_.begin(), pixels_.end(), pixels.begin());
+    write_attribute(file_id, "num_voxels", pixels);
+    write_attribute(file_id, "voxel_width", vox);
+    write_attribute(file_id, "lower_left", ll);
+
+    // Create dataset for voxel data -- note that the dimensions are reversed
+    // since we want the order in the file to be z, y, x
+    hsize_t dims[3];
+    dims[0] = pixels_[2];
+    dims[1] = pixels_[1];
+    dims[2] = pixels_[0];
+    voxel_init(file_id, &(dims[0]), &dspace, &dset, &memspace);
+  }
 
   SlicePlotBase pltbase;
   pltbase.width_ = width_;
@@ -969,39 +1002,82 @@ void Plot::create_voxel() const
   pltbase.pixels_ = pixels_;
   pltbase.slice_color_overlaps_ = color_overlaps_;
 
-  ProgressBar pb;
-  for (int z = 0; z < pixels_[2]; z++) {
-    // update progress bar
-    pb.set_value(
-      100. * static_cast<double>(z) / static_cast<double>((pixels_[2] - 1)));
+  int n_slices = pixels_[2];
+  int n_rounds = (n_slices + mpi::n_procs - 1) / mpi::n_procs;
+  xt::xtensor<int32_t, 2> data_flipped;
+#ifdef OPENMC_MPI
+  vector<int32_t> received(pixels_[0] * pixels_[1]);
+#endif
 
-    // update z coordinate
-    pltbase.origin_.z = ll.z + z * vox[2];
+  std::unique_ptr<ProgressBar> pb;
+  if (mpi::master)
+    pb = std::make_unique<ProgressBar>();
+  for (int k = 0; k < n_rounds; k++) {
+    int z = k * mpi::n_procs + mpi::rank;
+    if (z < n_slices) {
+      // update z coordinate
+      pltbase.origin_.z = ll.z + z * vox[2];
 
-    // generate ids using plotbase
-    IdData ids = pltbase.get_map<IdData>();
+      // generate ids using plotbase
+      IdData ids = pltbase.get_map<IdData>();
 
-    // select only cell/material ID data and flip the y-axis
-    int idx = color_by_ == PlotColorBy::cells ? 0 : 2;
-    xt::xtensor<int32_t, 2> data_slice =
-      xt::view(ids.data_, xt::all(), xt::all(), idx);
-    xt::xtensor<int32_t, 2> data_flipped = xt::flip(data_slice, 0);
+      // select only cell/material ID data and flip the y-axis
+      int idx = color_by_ == PlotColorBy::cells ? 0 : 2;
+      xt::xtensor<int32_t, 2> data_slice =
+        xt::view(ids.data_, xt::all(), xt::all(), idx);
+      data_flipped = xt::flip(data_slice, 0);
+    }
 
     // Write to HDF5 dataset
-    voxel_write_slice(z, dspace, dset, memspace, data_flipped.data());
+    if (parallel) {
+      voxel_write_slice(z, dspace, dset, memspace,
+        z < n_slices ? data_flipped.data() : nullptr);
+    } else if (mpi::master) {
+      for (int r = 0; r < mpi::n_procs; r++) {
+        int z_r = k * mpi::n_procs + r;
+        if (z_r >= n_slices)
+          break;
+        void* buf = data_flipped.data();
+#ifdef OPENMC_MPI
+        if (r != 0) {
+          MPI_Recv(received.data(), received.size(), MPI_INT32_T, r, z_r,
+            mpi::intracomm, MPI_STATUS_IGNORE);
+          buf = received.data();
+        }
+#endif
+        voxel_write_slice(z_r, dspace, dset, memspace, buf);
+      }
+    } else if (z < n_slices) {
+#ifdef OPENMC_MPI
+      MPI_Send(data_flipped.data(), data_flipped.size(), MPI_INT32_T, 0, z,
+        mpi::intracomm);
+#endif
+    }
+
+    // update progress bar
+    if (pb) {
+      int n_done = std::min((k + 1) * mpi::n_procs, n_slices);
+      pb->set_value(100. * n_done / n_slices);
+    }
   }
 
-  voxel_finalize(dspace, dset, memspace);
-  file_close(file_id);
+  if (writer) {
+    voxel_finalize(dspace, dset, memspace);
+    file_close(file_id);
+  }
 }
 
 void voxel_init(hid_t file_id, const hsize_t* dims, hid_t* dspace, hid_t* dset,
   hid_t* memspace)
 {
-  // Create dataspace/dataset for voxel data
+  // Create dataspace/dataset for voxel data. Slices are written one at a time,
+  // so a compressed chunk never spans more than one of them.
   *dspace = H5Screate_simple(3, dims, nullptr);
-  *dset = H5Dcreate(file_id, "data", H5T_NATIVE_INT, *dspace, H5P_DEFAULT,
-    H5P_DEFAULT, H5P_DEFAULT);
+  hid_t dcpl = create_compressed_plist(3, dims, sizeof(int), 1);
+  *dset = H5Dcreate(
+    file_id, "data", H5T_NATIVE_INT, *dspace, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+  if (dcpl != H5P_DEFAULT)
+    H5Pclose(dcpl);
 
   // Create dataspace for a slice of the voxel
   hsize_t dims_slice[2] {dims[1], dims[2]};
@@ -1016,9 +1092,34 @@ void voxel_init(hid_t file_id, const hsize_t* dims, hid_t* dspace, hid_t* dset,
 void voxel_write_slice(
   int x, hid_t dspace, hid_t dset, hid_t memspace, void* buf)
 {
-  hssize_t offset[3] {x, 0, 0};
-  H5Soffset_simple(dspace, offset);
-  H5Dwrite(dset, H5T_NATIVE_INT, memspace, dspace, H5P_DEFAULT, buf);
+  hid_t plist = H5P_DEFAULT;
+#ifdef PHDF5
+  // Writes to a file opened for parallel I/O are collective, which is also
+  // required to write compressed chunks
+  if (using_mpio_device(dset)) {
+    plist = H5Pcreate(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(plist, H5FD_MPIO_COLLECTIVE);
+  }
+#endif
+
+  if (buf) {
+    hssize_t offset[3] {x, 0, 0};
+    H5Soffset_simple(dspace, offset);
+    H5Dwrite(dset, H5T_NATIVE_INT, memspace, dspace, plist, buf);
+  } else {
+    // A process without a slice takes part in the write with an empty
+    // selection
+    hid_t fspace = H5Scopy(dspace);
+    hid_t mspace = H5Scopy(memspace);
+    H5Sselect_none(fspace);
+    H5Sselect_none(mspace);
+    H5Dwrite(dset, H5T_NATIVE_INT, mspace, fspace, plist, nullptr);
+    H5Sclose(mspace);
+    H5Sclose(fspace);
+  }
+
+  if (plist != H5P_DEFAULT)
+    H5Pclose(plist);
 }
 
 void voxel_finalize(hid_t dspace, hid_t dset, hid_t memspace)
@@ -1214,213 +1315,249 @@ void ProjectionPlot::create_output() const
   // wireframe thickness in order to thicken the lines.
   xt::xtensor<int, 2> wireframe_initial({width, height}, 0);
 
-  /* Holds all of the track segments for the current rendered line of pixels.
-   * old_segments holds a copy of this_line_segments from the previous line.
-   * By holding both we can check if the cell/material intersection stack
-   * differs from the left or upper neighbor. This allows a robustly drawn
-   * wireframe. If only checking the left pixel (which requires substantially
-   * less memory), the wireframe tends to be spotty and be disconnected for
-   * surface edges oriented horizontally in the rendering.
-   *
-   * Note that a vector of vectors is required rather than a 2-tensor,
-   * since the stack size varies within each column.
-   */
-  const int n_threads = num_threads();
-  std::vector<std::vector<std::vector<TrackSegment>>> this_line_segments(
-    n_threads);
-  for (int t = 0; t < n_threads; ++t) {
-    this_line_segments[t].resize(pixels_[0]);
-  }
-
-  // The last thread writes to this, and the first thread reads from it.
-  std::vector<std::vector<TrackSegment>> old_segments(pixels_[0]);
-
-#pragma omp parallel
-  {
-    const int n_threads = num_threads();
-    const int tid = thread_num();
-
-    GeometryState p;
-    p.u() = {1.0, 0.0, 0.0};
+  // Traces the rays of one line of pixels, recording the intersection stack
+  // of each pixel in segments. If color is true, the pixels are colored and
+  // wireframe edges between horizontal neighbors are marked.
+  auto trace_line = [&](GeometryState& p, int vert,
+                      std::vector<std::vector<TrackSegment>>& segments,
+                      bool color) {
+    for (int horiz = 0; horiz < pixels_[0]; ++horiz) {
 
-    int vert = tid;
-    for (int iter = 0; iter <= pixels_[1] / n_threads; iter++) {
-
-      // Save bottom line of current work chunk to compare against later
-      // I used to have this inside the below if block, but it causes a
-      // spurious line to be drawn at the bottom of the image. Not sure
-      // why, but moving it here fixes things.
-      if (tid == n_threads - 1)
-        old_segments = this_line_segments[n_threads - 1];
-
-      if (vert < pixels_[1]) {
-
-        for (int horiz = 0; horiz < pixels_[0]; ++horiz) {
-
-          // Projection mode below decides ray starting conditions
-          Position init_r;
-          Direction init_u;
-
-          // Generate the starting position/direction of the ray
-          if (orthographic_width_ == 0.0) { // perspective projection
-            double this_phi =
-              -horiz_fov_radians / 2.0 + dphi * horiz + 0.5 * dphi;
-            double this_mu =
-              -vert_fov_radians / 2.0 + dmu * vert + M_PI / 2.0 + 0.5 * dmu;
-            Direction camera_local_vec;
-            camera_local_vec.x = std::cos(this_phi) * std::sin(this_mu);
-            camera_local_vec.y = std::sin(this_phi) * std::sin(this_mu);
-            camera_local_vec.z = std::cos(this_mu);
-            init_u = camera_local_vec.rotate(camera_to_model);
-            init_r = camera_position_;
-          } else { // orthographic projection
-            init_u = looking_direction;
-
-            double x_pix_coord = (static_cast<double>(horiz) - p0 / 2.0) / p0;
-            double y_pix_coord = (static_cast<double>(vert) - p1 / 2.0) / p0;
-
-            init_r = camera_position_;
-            init_r += cam_yaxis * x_pix_coord * orthographic_width_;
-            init_r += cam_zaxis * y_pix_coord * orthographic_width_;
-          }
+      // Projection mode below decides ray starting conditions
+      Position init_r;
+      Direction init_u;
+
+      // Generate the starting position/direction of the ray
+      if (orthographic_width_ == 0.0) { // perspective projection
+        double this_phi = -horiz_fov_radians / 2.0 + dphi * horiz + 0.5 * dphi;
+        double this_mu =
+          -vert_fov_radians / 2.0 + dmu * vert + M_PI / 2.0 + 0.5 * dmu;
+        Direction camera_local_vec;
+        camera_local_vec.x = std::cos(this_phi) * std::sin(this_mu);
+        camera_local_vec.y = std::sin(this_phi) * std::sin(this_mu);
+        camera_local_vec.z = std::cos(this_mu);
+        init_u = camera_local_vec.rotate(camera_to_model);
+        init_r = camera_position_;
+      } else { // orthographic projection
+        init_u = looking_direction;
+
+        double x_pix_coord = (static_cast<double>(horiz) - p0 / 2.0) / p0;
+        double y_pix_coord = (static_cast<double>(vert) - p1 / 2.0) / p0;
+
+        init_r = camera_position_;
+        init_r += cam_yaxis * x_pix_coord * orthographic_width_;
+        init_r += cam_zaxis * y_pix_coord * orthographic_width_;
+      }
 
-          // Resets internal geometry state of particle
-          p.init_from_r_u(init_r, init_u);
+      // Resets internal geometry state of particle
+      p.init_from_r_u(init_r, init_u);
 
-          bool hitsomething = false;
-          bool intersection_found = true;
-          int loop_counter = 0;
+      bool intersection_found = true;
+      int loop_counter = 0;
 
-          this_line_segments[tid][horiz].clear();
+      segments[horiz].clear();
 
-          int first_surface =
-            -1; // surface first passed when entering the model
-          bool first_inside_model = true; // false after entering the model
-          while (intersection_found) {
-            bool inside_cell = false;
+      int first_surface = -1; // surface first passed when entering the model
+      bool first_inside_model = true; // false after entering the model
+      while (intersection_found) {
+        bool inside_cell = false;
 
-            int32_t i_surface = std::abs(p.surface()) - 1;
-            if (i_surface > 0 &&
-                model::surfaces[i_surface]->geom_type_ == GeometryType::DAG) {
+        int32_t i_surface = std::abs(p.surface()) - 1;
+        if (i_surface > 0 &&
+            model::surfaces[i_surface]->geom_type_ == GeometryType::DAG) {
 #ifdef DAGMC
-              int32_t i_cell = next_cell(i_surface,
-                p.cell_last(p.n_coord() - 1), p.lowest_coord().universe);
-              inside_cell = i_cell >= 0;
+          int32_t i_cell = next_cell(i_surface, p.cell_last(p.n_coord() - 1),
+            p.lowest_coord().universe);
+          inside_cell = i_cell >= 0;
 #else
-              fatal_error(
-                "Not compiled for DAGMC, but somehow you have a DAGCell!");
+          fatal_error(
+            "Not compiled for DAGMC, but somehow you have a DAGCell!");
 #endif
-            } else {
-              inside_cell = exhaustive_find_cell(p);
-            }
+        } else {
+          inside_cell = exhaustive_find_cell(p);
+        }
 
-            if (inside_cell) {
+        if (inside_cell) {
 
-              // This allows drawing wireframes with surface intersection
-              // edges on the model boundary for the same cell.
-              if (first_inside_model) {
-                this_line_segments[tid][horiz].emplace_back(
-                  color_by_ == PlotColorBy::mats ? p.material()
-                                                 : p.lowest_coord().cell,
-                  0.0, first_surface);
-                first_inside_model = false;
-              }
+          // This allows drawing wireframes with surface intersection
+          // edges on the model boundary for the same cell.
+          if (first_inside_model) {
+            segments[horiz].emplace_back(color_by_ == PlotColorBy::mats
+                                           ? p.material()
+                                           : p.lowest_coord().cell,
+              0.0, first_surface);
+            first_inside_model = false;
+          }
 
-              hitsomething = true;
-              intersection_found = true;
-              auto dist = distance_to_boundary(p);
-              this_line_segments[tid][horiz].emplace_back(
-                color_by_ == PlotColorBy::mats ? p.material()
-                                               : p.lowest_coord().cell,
-                dist.distance, std::abs(dist.surface_index));
-
-              // Advance particle
-              for (int lev = 0; lev < p.n_coord(); ++lev) {
-                p.coord(lev).r += dist.distance * p.coord(lev).u;
-              }
-              p.surface() = dist.surface_index;
-              p.n_coord_last() = p.n_coord();
-              p.n_coord() = dist.coord_level;
-              if (dist.lattice_translation[0] != 0 ||
-                  dist.lattice_translation[1] != 0 ||
-                  dist.lattice_translation[2] != 0) {
-                cross_lattice(p, dist);
-              }
+          intersection_found = true;
+          auto dist = distance_to_boundary(p);
+          segments[horiz].emplace_back(color_by_ == PlotColorBy::mats
+                                         ? p.material()
+                                         : p.lowest_coord().cell,
+            dist.distance, std::abs(dist.surface_index));
 
-            } else {
-              first_surface = advance_to_boundary_from_void(p);
-              intersection_found =
-                first_surface != -1; // -1 if no surface found
-            }
-            loop_counter++;
-            if (loop_counter > MAX_INTERSECTIONS)
-              fatal_error("Infinite loop in projection plot");
+          // Advance particle
+          for (int lev = 0; lev < p.n_coord(); ++lev) {
+            p.coord(lev).r += dist.distance * p.coord(lev).u;
           }
-
-          // Now color the pixel based on what we have intersected...
-          // Loops backwards over intersections.
-          Position current_color(
-            not_found_.red, not_found_.green, not_found_.blue);
-          const auto& segments = this_line_segments[tid][horiz];
-          for (unsigned i = segments.size(); i-- > 0;) {
-            int colormap_idx = segments[i].id;
-            RGBColor seg_color = colors_[colormap_idx];
-            Position seg_color_vec(
-              seg_color.red, seg_color.green, seg_color.blue);
-            double mixing = std::exp(-xs_[colormap_idx] * segments[i].length);
-            current_color =
-              current_color * mixing + (1.0 - mixing) * seg_color_vec;
-            RGBColor result;
-            result.red = static_cast<uint8_t>(current_color.x);
-            result.green = static_cast<uint8_t>(current_color.y);
-            result.blue = static_cast<uint8_t>(current_color.z);
-            data(horiz, vert) = result;
+          p.surface() = dist.surface_index;
+          p.n_coord_last() = p.n_coord();
+          p.n_coord() = dist.coord_level;
+          if (dist.lattice_translation[0] != 0 ||
+              dist.lattice_translation[1] != 0 ||
+              dist.lattice_translation[2] != 0) {
+            cross_lattice(p, dist);
           }
 
-          // Check to draw wireframe in horizontal direction. No inter-thread
-          // comm.
-          if (horiz > 0) {
-            if (!trackstack_equivalent(this_line_segments[tid][horiz],
-                  this_line_segments[tid][horiz - 1])) {
-              wireframe_initial(horiz, vert) = 1;
-            }
-          }
+        } else {
+          first_surface = advance_to_boundary_from_void(p);
+          intersection_found = first_surface != -1; // -1 if no surface found
         }
-      } // end "if" vert in correct range
-
-      // We require a barrier before comparing vertical neighbors' intersection
-      // stacks. i.e. all threads must be done with their line.
-#pragma omp barrier
-
-      // Now that the horizontal line has finished rendering, we can fill in
-      // wireframe entries that require comparison among all the threads. Hence
-      // the omp barrier being used. It has to be OUTSIDE any if blocks!
-      if (vert < pixels_[1]) {
-        // Loop over horizontal pixels, checking intersection stack of upper
-        // neighbor
-
-        const std::vector<std::vector<TrackSegment>>* top_cmp = nullptr;
-        if (tid == 0)
-          top_cmp = &old_segments;
-        else
-          top_cmp = &this_line_segments[tid - 1];
-
-        for (int horiz = 0; horiz < pixels_[0]; ++horiz) {
-          if (!trackstack_equivalent(
-                this_line_segments[tid][horiz], (*top_cmp)[horiz])) {
-            wireframe_initial(horiz, vert) = 1;
-          }
+        loop_counter++;
+        if (loop_counter > MAX_INTERSECTIONS)
+          fatal_error("Infinite loop in projection plot");
+      }
+
+      if (!color)
+        continue;
+
+      // Now color the pixel based on what we have intersected...
+      // Loops backwards over intersections.
+      Position current_color(
+        not_found_.red, not_found_.green, not_found_.blue);
+      const auto& segs = segments[horiz];
+      for (unsigned i = segs.size(); i-- > 0;) {
+        int colormap_idx = segs[i].id;
+        RGBColor seg_color = colors_[colormap_idx];
+        Position seg_color_vec(seg_color.red, seg_color.green, seg_color.blue);
+        double mixing = std::exp(-xs_[colormap_idx] * segs[i].length);
+        current_color = current_color * mixing + (1.0 - mixing) * seg_color_vec;
+        RGBColor result;
+        result.red = static_cast<uint8_t>(current_color.x);
+        result.green = static_cast<uint8_t>(current_color.y);
+        result.blue = static_cast<uint8_t>(current_color.z);
+        data(horiz, vert) = result;
+      }
+
+      // Check to draw wireframe in horizontal direction
+      if (horiz > 0) {
+        if (!trackstack_equivalent(segments[horiz], segments[horiz - 1])) {
+          wireframe_initial(horiz, vert) = 1;
+        }
+      }
+    }
+  };
+
+  // Marks wireframe edges between each pixel of a line and its upper neighbor
+  auto compare_lines = [&](int vert,
+                         const std::vector<std::vector<TrackSegment>>& line,
+                         const std::vector<std::vector<TrackSegment>>& top) {
+    for (int horiz = 0; horiz < pixels_[0]; ++horiz) {
+      if (!trackstack_equivalent(line[horiz], top[horiz])) {
+        wireframe_initial(horiz, vert) = 1;
+      }
+    }
+  };
+
+  // The lines of the image are divided into contiguous blocks among MPI
+  // processes, and each block into tiles of TILE_ROWS lines that threads
+  // render independently. Only the intersection stacks of the first and last
+  // line of each tile are kept, so that the wireframe across the seams
+  // between tiles can be found afterwards. Holding the stacks of the line
+  // above as well as the left neighbor is needed for a robustly drawn
+  // wireframe; only checking the left pixel tends to leave it spotty and
+  // disconnected for surface edges oriented horizontally in the rendering.
+  //
+  // Note that a vector of vectors is required rather than a 2-tensor, since
+  // the stack size varies within each column.
+  int line_begin = height * mpi::rank / mpi::n_procs;
+  int line_end = height * (mpi::rank + 1) / mpi::n_procs;
+  int n_tiles = (line_end - line_begin + TILE_ROWS - 1) / TILE_ROWS;
+  std::vector<std::vector<std::vector<TrackSegment>>> tile_first(n_tiles);
+  std::vector<std::vector<std::vector<TrackSegment>>> tile_last(n_tiles);
+
+  // The line above the first one of this process is traced again here. The
+  // first line of the image is compared against empty stacks, which draws
+  // the top edge of the model.
+  std::vector<std::vector<TrackSegment>> line_above(pixels_[0]);
+  if (line_begin > 0 && n_tiles > 0) {
+    GeometryState p;
+    p.u() = {1.0, 0.0, 0.0};
+    trace_line(p, line_begin - 1, line_above, false);
+  }
+
+#pragma omp parallel
+  {
+    GeometryState p;
+    p.u() = {1.0, 0.0, 0.0};
+
+    std::vector<std::vector<TrackSegment>> this_line(pixels_[0]);
+    std::vector<std::vector<TrackSegment>> last_line(pixels_[0]);
+
+#pragma omp for schedule(dynamic)
+    for (int t = 0; t < n_tiles; ++t) {
+      int first = line_begin + t * TILE_ROWS;
+      int last = std::min(first + TILE_ROWS, line_end);
+      for (int vert = first; vert < last; ++vert) {
+        trace_line(p, vert, this_line, true);
+        if (vert == first) {
+          tile_first[t] = this_line;
+        } else {
+          compare_lines(vert, this_line, last_line);
         }
+        std::swap(this_line, last_line);
       }
+      tile_last[t] = last_line;
+    }
 
-      // We need another barrier to ensure threads don't proceed to modify their
-      // intersection stacks on that horizontal line while others are
-      // potentially still working on the above.
-#pragma omp barrier
-      vert += n_threads;
+    // Now that all tiles have been rendered, the first line of each can be
+    // compared with the last line of the tile above it
+#pragma omp for
+    for (int t = 0; t < n_tiles; ++t) {
+      compare_lines(line_begin + t * TILE_ROWS, tile_first[t],
+        t == 0 ? line_above : tile_last[t - 1]);
     }
   } // end omp parallel
 
+#ifdef OPENMC_MPI
+  // Gather the colors and initial wireframe of each block of lines on the
+  // master process, packed as four bytes per pixel
+  if (mpi::n_procs > 1) {
+    vector<int> counts(mpi::n_procs);
+    vector<int> displs(mpi::n_procs);
+    for (int r = 0; r < mpi::n_procs; ++r) {
+      int begin = height * r / mpi::n_procs;
+      int end = height * (r + 1) / mpi::n_procs;
+      counts[r] = 4 * width * (end - begin);
+      displs[r] = 4 * width * begin;
+    }
+
+    vector<uint8_t> send(counts[mpi::rank]);
+    for (int vert = line_begin; vert < line_end; ++vert) {
+      for (int horiz = 0; horiz < pixels_[0]; ++horiz) {
+        auto* b = &send[4 * ((vert - line_begin) * width + horiz)];
+        b[0] = data(horiz, vert).red;
+        b[1] = data(horiz, vert).green;
+        b[2] = data(horiz, vert).blue;
+        b[3] = wireframe_initial(horiz, vert);
+      }
+    }
+    vector<uint8_t> recv(mpi::master ? 4 * width * height : 0);
+    MPI_Gatherv(send.data(), send.size(), MPI_UNSIGNED_CHAR, recv.data(),
+      counts.data(), displs.data(), MPI_UNSIGNED_CHAR, 0, mpi::intracomm);
+    if (!mpi::master)
+      return;
+
+    for (int vert = 0; vert < pixels_[1]; ++vert) {
+      for (int horiz = 0; horiz < pixels_[0]; ++horiz) {
+        const auto* b = &recv[4 * (vert * width + horiz)];
+        data(horiz, vert) = {b[0], b[1], b[2]};
+        wireframe_initial(horiz, vert) = b[3];
+      }
+    }
+  }
+#endif
+
   // Now thicken the wireframe lines and apply them to our image
   for (int vert = 0; vert < pixels_[1]; ++vert) {
     for (int horiz = 0; horiz < pixels_[0]; ++horiz) {
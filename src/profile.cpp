@@ -0,0 +1,183 @@
+#include "openmc/profile.h"
+
+#include <fmt/core.h>
+
+#include "openmc/cell.h"
+#include "openmc/hdf5_interface.h"
+#include "openmc/material.h"
+#include "openmc/message_passing.h"
+#include "openmc/nuclide.h"
+#include "openmc/output.h"
+#include "openmc/settings.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+vector<ThreadProfile> profile;
+
+} // namespace simulation
+
+namespace {
+
+//! Sum the counts of a domain over all threads and processes
+//
+//! \param[in] member  Member of ThreadProfile holding the counts
+//! \param[in] n  Number of domains
+//! \return Counts in each domain on the master process
+vector<ProfileCounts> sum_counts(
+  vector<ProfileCounts> ThreadProfile::*member, int n)
+{
+  vector<ProfileCounts> total(n);
+  for (const auto& prof : simulation::profile) {
+    const auto& counts = prof.*member;
+    for (int i = 0; i < n; ++i) {
+      total[i].xs_lookups += counts[i].xs_lookups;
+      total[i].segments += counts[i].segments;
+      total[i].collisions += counts[i].collisions;
+      total[i].surface_crossings += counts[i].surface_crossings;
+      total[i].track_length += counts[i].track_length;
+    }
+  }
+
+#ifdef OPENMC_MPI
+  // The integer and floating point members are reduced separately
+  vector<int64_t> events;
+  vector<double> lengths;
+  for (const auto& c : total) {
+    events.insert(events.end(),
+      {c.xs_lookups, c.segments, c.collisions, c.surface_crossings});
+    lengths.push_back(c.track_length);
+  }
+  MPI_Reduce(mpi::master ? MPI_IN_PLACE : events.data(), events.data(),
+    events.size(), MPI_INT64_T, MPI_SUM, 0, mpi::intracomm);
+  MPI_Reduce(mpi::master ? MPI_IN_PLACE : lengths.data(), lengths.data(),
+    lengths.size(), MPI_DOUBLE, MPI_SUM, 0, mpi::intracomm);
+  for (int i = 0; i < n; ++i) {
+    total[i].xs_lookups = events[4 * i];
+    total[i].segments = events[4 * i + 1];
+    total[i].collisions = events[4 * i + 2];
+    total[i].surface_crossings = events[4 * i + 3];
+    total[i].track_length = lengths[i];
+  }
+#endif
+  return total;
+}
+
+//! Write the counts of each domain as one dataset per quantity
+void write_counts(hid_t group, const vector<ProfileCounts>& counts)
+{
+  vector<int64_t> xs_lookups, segments, collisions, surface_crossings;
+  vector<double> track_length;
+  for (const auto& c : counts) {
+    xs_lookups.push_back(c.xs_lookups);
+    segments.push_back(c.segments);
+    collisions.push_back(c.collisions);
+    surface_crossings.push_back(c.surface_crossings);
+    track_length.push_back(c.track_length);
+  }
+  write_dataset(group, "xs_lookups", xs_lookups);
+  write_dataset(group, "segments", segments);
+  write_dataset(group, "collisions", collisions);
+  write_dataset(group, "surface_crossings", surface_crossings);
+  write_dataset(group, "track_length", track_length);
+}
+
+} // namespace
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void reset_profile()
+{
+  simulation::profile.clear();
+  if (!settings::profile)
+    return;
+
+  simulation::profile.resize(num_threads());
+  for (auto& prof : simulation::profile) {
+    prof.materials.resize(model::materials.size());
+    prof.cells.resize(model::cells.size());
+    if (settings::run_CE)
+      prof.nuclide_collisions.resize(data::nuclides.size());
+  }
+}
+
+void write_profile()
+{
+  if (simulation::profile.empty())
+    return;
+
+  auto materials =
+    sum_counts(&ThreadProfile::materials, model::materials.size());
+  auto cells = sum_counts(&ThreadProfile::cells, model::cells.size());
+
+  int n_nuclides = simulation::profile[0].nuclide_collisions.size();
+  vector<int64_t> nuclide_collisions(n_nuclides, 0);
+  for (const auto& prof : simulation::profile) {
+    for (int i = 0; i < n_nuclides; ++i) {
+      nuclide_collisions[i] += prof.nuclide_collisions[i];
+    }
+  }
+#ifdef OPENMC_MPI
+  MPI_Reduce(mpi::master ? MPI_IN_PLACE : nuclide_collisions.data(),
+    nuclide_collisions.data(), n_nuclides, MPI_INT64_T, MPI_SUM, 0,
+    mpi::intracomm);
+#endif
+
+  if (!mpi::master)
+    return;
+
+  std::string filename = settings::path_output + "profile.h5";
+  write_message(5, "Writing event profile to {}...", filename);
+  hid_t file_id = file_open(filename, 'w');
+
+  // Write header info
+  write_attribute(file_id, "filetype", "profile");
+  write_attribute(file_id, "version", VERSION_PROFILE);
+  write_attribute(file_id, "openmc_version", VERSION);
+#ifdef GIT_SHA1
+  write_attribute(file_id, "git_sha1", GIT_SHA1);
+#endif
+  write_attribute(file_id, "date_and_time", time_stamp());
+
+  hid_t group = create_group(file_id, "materials");
+  vector<int32_t> ids;
+  for (const auto& mat : model::materials)
+    ids.push_back(mat->id_);
+  write_dataset(group, "ids", ids);
+  write_counts(group, materials);
+  close_group(group);
+
+  group = create_group(file_id, "cells");
+  ids.clear();
+  for (const auto& c : model::cells)
+    ids.push_back(c->id_);
+  write_dataset(group, "ids", ids);
+  write_counts(group, cells);
+  close_group(group);
+
+  if (n_nuclides > 0) {
+    group = create_group(file_id, "nuclides");
+    vector<std::string> names;
+    for (const auto& nuc : data::nuclides)
+      names.push_back(nuc->name_);
+    write_dataset(group, "names", names);
+    write_dataset(group, "collisions", nuclide_collisions);
+    close_group(group);
+  }
+
+  file_close(file_id);
+}
+
+void free_memory_profile()
+{
+  simulation::profile.clear();
+}
+
+} // namespace openmc
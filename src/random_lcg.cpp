@@ -12,6 +12,11 @@ constexpr uint64_t prn_mult {6364136223846793005ULL}; // multiplication
 constexpr uint64_t prn_add {1442695040888963407ULL};  // additive factor, c
 constexpr uint64_t prn_stride {152917LL}; // stride between particles
 
+// Threefry-2x64 parameters
+constexpr int threefry_rounds {20};
+constexpr uint64_t threefry_parity {0x1BD11BDAA9FC1A22ULL};
+constexpr int threefry_rotation[8] {16, 42, 12, 31, 16, 32, 24, 21};
+
 //==============================================================================
 // PRN
 //==============================================================================
@@ -42,6 +47,68 @@ double prn(uint64_t* seed)
   return ldexp(result, -64);
 }
 
+void prn(int64_t n, uint64_t* seeds, double* values)
+{
+#pragma omp simd
+  for (int64_t i = 0; i < n; ++i) {
+    uint64_t seed = prn_mult * seeds[i] + prn_add;
+    uint64_t word =
+      ((seed >> ((seed >> 59u) + 5u)) ^ seed) * 12605985483714917081ull;
+    uint64_t result = (word >> 43u) ^ word;
+    seeds[i] = seed;
+    values[i] = ldexp(result, -64);
+  }
+}
+
+//==============================================================================
+// COUNTER_PRN
+//==============================================================================
+
+// Threefry-2x64 block cipher with 20 rounds, from J. K. Salmon et al.,
+// "Parallel random numbers: as easy as 1, 2, 3," Proceedings of the
+// International Conference for High Performance Computing, Networking,
+// Storage and Analysis (2011). Only the first word of the output is used.
+namespace {
+
+uint64_t threefry(uint64_t key, uint64_t counter)
+{
+  uint64_t ks[3] {key, static_cast<uint64_t>(master_seed),
+    threefry_parity ^ key ^ static_cast<uint64_t>(master_seed)};
+  uint64_t x0 = counter + ks[0];
+  uint64_t x1 = ks[1];
+  for (int r = 0; r < threefry_rounds; ++r) {
+    int rot = threefry_rotation[r % 8];
+    x0 += x1;
+    x1 = (x1 << rot) | (x1 >> (64 - rot));
+    x1 ^= x0;
+
+    // Inject the key every four rounds
+    if (r % 4 == 3) {
+      uint64_t s = r / 4 + 1;
+      x0 += ks[s % 3];
+      x1 += ks[(s + 1) % 3] + s;
+    }
+  }
+  return x0;
+}
+
+} // namespace
+
+double counter_prn(uint64_t key, uint64_t counter)
+{
+  // Use the upper 53 bits so that the result is strictly less than one
+  return ldexp(threefry(key, counter) >> 11, -53);
+}
+
+void counter_prn(
+  int64_t n, const uint64_t* keys, uint64_t counter, double* values)
+{
+#pragma omp simd
+  for (int64_t i = 0; i < n; ++i) {
+    values[i] = ldexp(threefry(keys[i], counter) >> 11, -53);
+  }
+}
+
 //==============================================================================
 // FUTURE_PRN
 //==============================================================================
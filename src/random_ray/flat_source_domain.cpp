@@ -4,6 +4,7 @@
 #include "openmc/eigenvalue.h"
 #include "openmc/geometry.h"
 #include "openmc/material.h"
+#include "openmc/memory_report.h"
 #include "openmc/message_passing.h"
 #include "openmc/mgxs_interface.h"
 #include "openmc/output.h"
@@ -15,7 +16,13 @@
 #include "openmc/tallies/tally_scoring.h"
 #include "openmc/timer.h"
 
+#include "xtensor/xview.hpp"
+
+#include <algorithm> // for copy, fill, find_if
+#include <cmath>     // for abs
 #include <cstdio>
+#include <limits>  // for numeric_limits
+#include <utility> // for move, pair, swap
 
 namespace openmc {
 
@@ -27,9 +34,44 @@ namespace openmc {
 RandomRayVolumeEstimator FlatSourceDomain::volume_estimator_ {
   RandomRayVolumeEstimator::HYBRID};
 bool FlatSourceDomain::volume_normalized_flux_tallies_ {false};
+int32_t FlatSourceDomain::source_region_mesh_id_ {C_NONE};
+std::unordered_set<int32_t> FlatSourceDomain::source_region_mesh_cells_;
+int FlatSourceDomain::anderson_depth_ {0};
+bool FlatSourceDomain::adjoint_ {false};
+bool FlatSourceDomain::adjoint_active_ {false};
+
+FlatSourceDomain::~FlatSourceDomain()
+{
+#ifdef OPENMC_OFFLOAD
+  const double* sigma_t = source_sigma_t_.data();
+  const double* nu_sigma_f = nu_sigma_f_.data();
+  const double* nu_sigma_s = nu_sigma_s_.data();
+  const double* chi = chi_.data();
+  int64_t n_1d = source_sigma_t_.size();
+  int64_t n_2d = nu_sigma_s_.size();
+#pragma omp target exit data map(delete : sigma_t[0 : n_1d], \
+    nu_sigma_f[0 : n_1d], nu_sigma_s[0 : n_2d], chi[0 : n_2d])
+#endif
+}
 
 FlatSourceDomain::FlatSourceDomain() : negroups_(data::mg.num_energy_groups_)
 {
+  // Find the mesh subdividing source regions, if any
+  const StructuredMesh* mesh = nullptr;
+  if (source_region_mesh_id_ != C_NONE) {
+    auto it = model::mesh_map.find(source_region_mesh_id_);
+    if (it == model::mesh_map.end()) {
+      fatal_error(fmt::format("Mesh {} used to subdivide random ray source "
+                              "regions does not exist.",
+        source_region_mesh_id_));
+    }
+    mesh = dynamic_cast<const StructuredMesh*>(model::meshes[it->second].get());
+    if (!mesh) {
+      fatal_error("Only structured meshes can subdivide random ray source "
+                  "regions.");
+    }
+  }
+
   // Count the number of source regions, compute the cell offset
   // indices, and store the material type The reason for the offsets is that
   // some cell types may not have material fills, and therefore do not
@@ -37,10 +79,20 @@ FlatSourceDomain::FlatSourceDomain() : negroups_(data::mg.num_energy_groups_)
   for (const auto& c : model::cells) {
     if (c->type_ != Fill::MATERIAL) {
       source_region_offsets_.push_back(-1);
+      source_region_bins_.push_back(1);
+      source_region_meshes_.push_back(nullptr);
     } else {
+      // Each instance of a cell subdivided by the mesh has one source region
+      // per mesh element and one for the parts of the cell outside the mesh
+      bool subdivided = mesh && (source_region_mesh_cells_.empty() ||
+                                  source_region_mesh_cells_.count(c->id_));
+      int n_bins = subdivided ? mesh->n_bins() + 1 : 1;
       source_region_offsets_.push_back(n_source_regions_);
-      n_source_regions_ += c->n_instances_;
-      n_source_elements_ += c->n_instances_ * negroups_;
+      source_region_bins_.push_back(n_bins);
+      source_region_meshes_.push_back(subdivided ? mesh : nullptr);
+      n_source_regions_ += static_cast<int64_t>(c->n_instances_) * n_bins;
+      n_source_elements_ +=
+        static_cast<int64_t>(c->n_instances_) * n_bins * negroups_;
     }
   }
 
@@ -58,8 +110,9 @@ FlatSourceDomain::FlatSourceDomain() : negroups_(data::mg.num_energy_groups_)
   scalar_flux_final_.assign(n_source_elements_, 0.0);
   source_.resize(n_source_elements_);
 
-  tally_task_.resize(n_source_elements_);
-  volume_task_.resize(n_source_regions_);
+  tally_task_offsets_.assign(n_source_elements_ + 1, 0);
+  volume_task_offsets_.assign(n_source_regions_ + 1, 0);
+  tally_mapped_.assign(n_source_regions_, 0);
 
   if (settings::run_mode == RunMode::EIGENVALUE) {
     // If in eigenvalue mode, set starting flux to guess of unity
@@ -78,7 +131,9 @@ FlatSourceDomain::FlatSourceDomain() : negroups_(data::mg.num_energy_groups_)
     Cell& cell = *model::cells[i];
     if (cell.type_ == Fill::MATERIAL) {
       for (int j = 0; j < cell.n_instances_; j++) {
-        material_[source_region_id++] = cell.material(j);
+        for (int b = 0; b < source_region_bins_[i]; b++) {
+          material_[source_region_id++] = cell.material(j);
+        }
       }
     }
   }
@@ -108,91 +163,442 @@ FlatSourceDomain::FlatSourceDomain() : negroups_(data::mg.num_energy_groups_)
   SpatialBox* sb = dynamic_cast<SpatialBox*>(space_dist);
   Position dims = sb->upper_right() - sb->lower_left();
   simulation_volume_ = dims.x * dims.y * dims.z;
+
+  flatten_xs();
+  if (adjoint_active_)
+    transpose_xs();
+  partition_source_regions();
+
+#ifdef OPENMC_OFFLOAD
+  // The cross sections used by the source update stay on the device for the
+  // lifetime of the domain
+  const double* sigma_t = source_sigma_t_.data();
+  const double* nu_sigma_f = nu_sigma_f_.data();
+  const double* nu_sigma_s = nu_sigma_s_.data();
+  const double* chi = chi_.data();
+  int64_t n_1d = source_sigma_t_.size();
+  int64_t n_2d = nu_sigma_s_.size();
+#pragma omp target enter data map(to : sigma_t[0 : n_1d], \
+    nu_sigma_f[0 : n_1d], nu_sigma_s[0 : n_2d], chi[0 : n_2d])
+#endif
+
+  // Choose how ray segments accumulate into source regions. With a small
+  // number of source regions, a few of them may be crossed by many threads at
+  // once, so each thread accumulates into its own copy of the flux. Otherwise,
+  // the flux is accumulated with atomic operations if there are few enough
+  // groups, or under the lock of the source region. Linear sources accumulate
+  // moments that are always updated under the lock.
+  int n_threads = num_threads();
+  if (RandomRay::source_shape_ != RandomRaySourceShape::FLAT ||
+      n_threads == 1) {
+    accumulation_ = RandomRayAccumulation::LOCK;
+  } else if (n_threads * n_source_elements_ <= MAX_PRIVATE_ACCUMULATOR_SIZE) {
+    accumulation_ = RandomRayAccumulation::PRIVATE;
+    thread_scalar_flux_.assign(
+      n_threads, vector<double>(n_source_elements_, 0.0));
+    thread_volume_.assign(n_threads, vector<double>(n_source_regions_, 0.0));
+  } else if (negroups_ <= MAX_ATOMIC_ACCUMULATOR_GROUPS) {
+    accumulation_ = RandomRayAccumulation::ATOMIC;
+  } else {
+    accumulation_ = RandomRayAccumulation::LOCK;
+  }
 }
 
-void FlatSourceDomain::batch_reset()
+// Returns the bin of the mesh subdividing the source regions of a cell that
+// contains a position, or the bin past the last mesh element if the position
+// is outside the mesh
+int FlatSourceDomain::mesh_bin(int i_cell, Position r) const
 {
-  // Reset scalar fluxes, iteration volume tallies, and region hit flags to
-  // zero
-  parallel_fill<double>(scalar_flux_new_, 0.0);
-  parallel_fill<double>(volume_, 0.0);
+  const auto* mesh = source_region_meshes_[i_cell];
+  if (!mesh)
+    return 0;
+  int bin = mesh->get_bin(r);
+  return bin < 0 ? mesh->n_bins() : bin;
 }
 
-void FlatSourceDomain::accumulate_iteration_flux()
+// Divides the source regions into contiguous blocks, one per process, whose
+// sources are updated by that process each iteration. If the values of all
+// source elements cannot be indexed by an int, as needed by MPI, all
+// processes update all sources instead.
+void FlatSourceDomain::partition_source_regions()
+{
+  // Linear sources gather three moments of each source element
+  if (3 * n_source_elements_ > std::numeric_limits<int>::max()) {
+    sr_begin_ = 0;
+    sr_end_ = n_source_regions_;
+  } else {
+    sr_begin_ = n_source_regions_ * mpi::rank / mpi::n_procs;
+    sr_end_ = n_source_regions_ * (mpi::rank + 1) / mpi::n_procs;
+  }
+}
+
+// Number of values in the block of source regions of each process
+vector<int> FlatSourceDomain::gather_counts(int values_per_region) const
+{
+  vector<int> counts(mpi::n_procs);
+  for (int i = 0; i < mpi::n_procs; i++) {
+    int64_t begin = n_source_regions_ * i / mpi::n_procs;
+    int64_t end = n_source_regions_ * (i + 1) / mpi::n_procs;
+    counts[i] = (end - begin) * values_per_region;
+  }
+  return counts;
+}
+
+// Offset of the first value in the block of source regions of each process
+vector<int> FlatSourceDomain::gather_offsets(int values_per_region) const
+{
+  vector<int> offsets(mpi::n_procs);
+  for (int i = 0; i < mpi::n_procs; i++) {
+    offsets[i] = n_source_regions_ * i / mpi::n_procs * values_per_region;
+  }
+  return offsets;
+}
+
+// Gathers the sources updated by each process on all processes
+void FlatSourceDomain::allgather_source()
 {
+#ifdef OPENMC_MPI
+  if (mpi::n_procs <= 1 || sr_end_ - sr_begin_ == n_source_regions_)
+    return;
+
+  simulation::time_bank_sendrecv.start();
+  auto counts = gather_counts(negroups_);
+  auto offsets = gather_offsets(negroups_);
+  MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, source_.data(),
+    counts.data(), offsets.data(), MPI_FLOAT, mpi::intracomm);
+  simulation::time_bank_sendrecv.stop();
+#endif
+}
+
+// Adds the scalar flux and volume accumulated by each thread during the
+// transport sweep to those of the source regions and resets them to zero
+void FlatSourceDomain::reduce_thread_accumulators()
+{
+  if (accumulation_ != RandomRayAccumulation::PRIVATE)
+    return;
+
 #pragma omp parallel for
   for (int64_t se = 0; se < n_source_elements_; se++) {
-    scalar_flux_final_[se] += scalar_flux_new_[se];
+    for (auto& flux : thread_scalar_flux_) {
+      scalar_flux_new_[se] += flux[se];
+      flux[se] = 0.0;
+    }
+  }
+
+#pragma omp parallel for
+  for (int64_t sr = 0; sr < n_source_regions_; sr++) {
+    for (auto& volume : thread_volume_) {
+      volume_[sr] += volume[sr];
+      volume[sr] = 0.0;
+    }
   }
 }
 
-// Compute new estimate of scattering + fission sources in each source region
-// based on the flux estimate from the previous iteration.
-void FlatSourceDomain::update_neutron_source(double k_eff)
+// Extrapolates the scalar flux with Anderson acceleration. The transport sweep
+// is a fixed-point map G taking the flux of the last iteration x to a new flux
+// G(x), with residual f = G(x) - x. The next flux is taken as the combination
+// of the fluxes of the last few sweeps whose residuals cancel out best in the
+// least squares sense:
+//
+//   x_next = G(x) - dG gamma,  gamma = argmin || f - dF gamma ||
+//
+// where the columns of dG and dF are the changes in G(x) and f between
+// consecutive iterations. Elements whose extrapolated flux is negative, which
+// can happen due to the noise of the random ray estimates, keep the flux of
+// the sweep.
+void FlatSourceDomain::accelerate_scalar_flux()
 {
-  simulation::time_update_src.start();
+  if (anderson_depth_ == 0)
+    return;
 
-  double inverse_k_eff = 1.0 / k_eff;
+  const auto& x = scalar_flux_old_;
+  auto& g = scalar_flux_new_;
+  vector<double> f(n_source_elements_);
+#pragma omp parallel for
+  for (int64_t se = 0; se < n_source_elements_; se++) {
+    f[se] = g[se] - x[se];
+  }
+
+  // Record the changes since the last iteration, replacing the oldest ones
+  if (!anderson_g_prev_.empty()) {
+    if (static_cast<int>(anderson_dg_.size()) < anderson_depth_) {
+      anderson_dg_.emplace_back(n_source_elements_);
+      anderson_df_.emplace_back(n_source_elements_);
+    }
+    auto& dg = anderson_dg_[anderson_next_];
+    auto& df = anderson_df_[anderson_next_];
+#pragma omp parallel for
+    for (int64_t se = 0; se < n_source_elements_; se++) {
+      dg[se] = g[se] - anderson_g_prev_[se];
+      df[se] = f[se] - anderson_f_prev_[se];
+    }
+    anderson_next_ = (anderson_next_ + 1) % anderson_depth_;
+  }
+  anderson_g_prev_ = g;
+  anderson_f_prev_ = f;
+
+  int n = anderson_dg_.size();
+  if (n == 0)
+    return;
+
+  // Form the normal equations (dF^T dF) gamma = dF^T f
+  vector<double> a(n * n);
+  vector<double> b(n);
+  for (int i = 0; i < n; i++) {
+    for (int j = i; j < n; j++) {
+      const auto& df_i = anderson_df_[i];
+      const auto& df_j = anderson_df_[j];
+      double sum = 0.0;
+#pragma omp parallel for reduction(+ : sum)
+      for (int64_t se = 0; se < n_source_elements_; se++) {
+        sum += df_i[se] * df_j[se];
+      }
+      a[i * n + j] = sum;
+      a[j * n + i] = sum;
+    }
+    const auto& df_i = anderson_df_[i];
+    double sum = 0.0;
+#pragma omp parallel for reduction(+ : sum)
+    for (int64_t se = 0; se < n_source_elements_; se++) {
+      sum += df_i[se] * f[se];
+    }
+    b[i] = sum;
+  }
+
+  // Regularize the system, as the changes of consecutive iterations are often
+  // nearly parallel, and solve it by Gaussian elimination with partial
+  // pivoting
+  double trace = 0.0;
+  for (int i = 0; i < n; i++) {
+    trace += a[i * n + i];
+  }
+  if (trace <= 0.0)
+    return;
+  for (int i = 0; i < n; i++) {
+    a[i * n + i] += 1.0e-10 * trace;
+  }
+  for (int k = 0; k < n; k++) {
+    int pivot = k;
+    for (int i = k + 1; i < n; i++) {
+      if (std::abs(a[i * n + k]) > std::abs(a[pivot * n + k]))
+        pivot = i;
+    }
+    if (a[pivot * n + k] == 0.0)
+      return;
+    if (pivot != k) {
+      for (int j = 0; j < n; j++) {
+        std::swap(a[k * n + j], a[pivot * n + j]);
+      }
+      std::swap(b[k], b[pivot]);
+    }
+    for (int i = k + 1; i < n; i++) {
+      double factor = a[i * n + k] / a[k * n + k];
+      for (int j = k; j < n; j++) {
+        a[i * n + j] -= factor * a[k * n + j];
+      }
+      b[i] -= factor * b[k];
+    }
+  }
+  vector<double> gamma(n);
+  for (int i = n - 1; i >= 0; i--) {
+    double sum = b[i];
+    for (int j = i + 1; j < n; j++) {
+      sum -= a[i * n + j] * gamma[j];
+    }
+    gamma[i] = sum / a[i * n + i];
+  }
+
+#pragma omp parallel for
+  for (int64_t se = 0; se < n_source_elements_; se++) {
+    double flux = g[se];
+    for (int i = 0; i < n; i++) {
+      flux -= gamma[i] * anderson_dg_[i][se];
+    }
+    if (flux >= 0.0)
+      g[se] = flux;
+  }
+}
 
+// Copies the cross sections needed by the transport sweep and source update
+// into contiguous arrays so that they can be read directly in inner loops
+// rather than through Mgxs::get_xs
+void FlatSourceDomain::flatten_xs()
+{
   // Temperature and angle indices, if using multiple temperature
   // data sets and/or anisotropic data sets.
   // TODO: Currently assumes we are only using single temp/single angle data.
   const int t = 0;
   const int a = 0;
 
-  // Add scattering source
-#pragma omp parallel for
-  for (int sr = 0; sr < n_source_regions_; sr++) {
-    int material = material_[sr];
-
+  int n_materials = data::mg.macro_xs_.size();
+  int64_t n_1d = static_cast<int64_t>(n_materials) * negroups_;
+  int64_t n_2d = n_1d * negroups_;
+  sigma_t_.resize(n_1d);
+  source_sigma_t_.resize(n_1d);
+  nu_sigma_f_.resize(n_1d);
+  nu_sigma_s_.resize(n_2d);
+  chi_.resize(n_2d);
+
+  for (int m = 0; m < n_materials; m++) {
+    auto& xs = data::mg.macro_xs_[m];
     for (int e_out = 0; e_out < negroups_; e_out++) {
-      double sigma_t = data::mg.macro_xs_[material].get_xs(
-        MgxsType::TOTAL, e_out, nullptr, nullptr, nullptr, t, a);
-      double scatter_source = 0.0f;
+      int64_t i = m * negroups_ + e_out;
+      source_sigma_t_[i] = xs.get_xs(MgxsType::TOTAL, e_out, t, a);
+      sigma_t_[i] = source_sigma_t_[i];
+      nu_sigma_f_[i] = xs.get_xs(MgxsType::NU_FISSION, e_out, t, a);
 
       for (int e_in = 0; e_in < negroups_; e_in++) {
-        double scalar_flux = scalar_flux_old_[sr * negroups_ + e_in];
-
-        double sigma_s = data::mg.macro_xs_[material].get_xs(
+        int64_t j = i * negroups_ + e_in;
+        nu_sigma_s_[j] = xs.get_xs(
           MgxsType::NU_SCATTER, e_in, &e_out, nullptr, nullptr, t, a);
-        scatter_source += sigma_s * scalar_flux;
+        chi_[j] = xs.get_xs(
+          MgxsType::CHI_PROMPT, e_in, &e_out, nullptr, nullptr, t, a);
       }
-
-      source_[sr * negroups_ + e_out] = scatter_source / sigma_t;
     }
   }
+}
 
-  // Add fission source
-#pragma omp parallel for
-  for (int sr = 0; sr < n_source_regions_; sr++) {
-    int material = material_[sr];
-
+// Transposes the scattering and fission matrices so that the source update
+// computes the source of the adjoint transport equation. An adjoint neutron in
+// group g is produced by fissions in g at a rate of nu-fission in g times the
+// fission spectrum, summed over the groups of the fission neutrons. That rate
+// is stored in chi_, with the nu-fission table set to one, so that the flat
+// and linear source updates need no changes.
+void FlatSourceDomain::transpose_xs()
+{
+  int n_materials = data::mg.macro_xs_.size();
+  vector<double> chi(negroups_ * negroups_);
+  for (int m = 0; m < n_materials; m++) {
+    double* nu_sigma_s = &nu_sigma_s_[m * negroups_ * negroups_];
     for (int e_out = 0; e_out < negroups_; e_out++) {
-      double sigma_t = data::mg.macro_xs_[material].get_xs(
-        MgxsType::TOTAL, e_out, nullptr, nullptr, nullptr, t, a);
-      double fission_source = 0.0f;
+      for (int e_in = e_out + 1; e_in < negroups_; e_in++) {
+        std::swap(nu_sigma_s[e_out * negroups_ + e_in],
+          nu_sigma_s[e_in * negroups_ + e_out]);
+      }
+    }
 
+    double* chi_mat = &chi_[m * negroups_ * negroups_];
+    double* nu_sigma_f = &nu_sigma_f_[m * negroups_];
+    std::copy(chi_mat, chi_mat + negroups_ * negroups_, chi.begin());
+    for (int e_out = 0; e_out < negroups_; e_out++) {
       for (int e_in = 0; e_in < negroups_; e_in++) {
-        double scalar_flux = scalar_flux_old_[sr * negroups_ + e_in];
-        double nu_sigma_f = data::mg.macro_xs_[material].get_xs(
-          MgxsType::NU_FISSION, e_in, nullptr, nullptr, nullptr, t, a);
-        double chi = data::mg.macro_xs_[material].get_xs(
-          MgxsType::CHI_PROMPT, e_in, &e_out, nullptr, nullptr, t, a);
-        fission_source += nu_sigma_f * scalar_flux * chi;
+        chi_mat[e_out * negroups_ + e_in] =
+          nu_sigma_f[e_out] * chi[e_in * negroups_ + e_out];
       }
-      source_[sr * negroups_ + e_out] +=
-        fission_source * inverse_k_eff / sigma_t;
     }
+    std::fill(nu_sigma_f, nu_sigma_f + negroups_, 1.0);
   }
+}
 
-  // Add external source if in fixed source mode
-  if (settings::run_mode == RunMode::FIXED_SOURCE) {
+void FlatSourceDomain::batch_reset()
+{
+  // Reset scalar fluxes, iteration volume tallies, and region hit flags to
+  // zero
+  parallel_fill<double>(scalar_flux_new_, 0.0);
+  parallel_fill<double>(volume_, 0.0);
+}
+
+double FlatSourceDomain::memory() const
+{
+  double size = vector_memory(source_region_offsets_) +
+                vector_memory(source_region_bins_) +
+                vector_memory(source_region_meshes_) + vector_memory(lock_) +
+                vector_memory(volume_) + vector_memory(volume_t_) +
+                vector_memory(position_recorded_) + vector_memory(position_) +
+                vector_memory(scalar_flux_old_) +
+                vector_memory(scalar_flux_new_) + vector_memory(source_) +
+                vector_memory(external_source_) +
+                vector_memory(external_source_present_) +
+                vector_memory(thread_scalar_flux_) +
+                vector_memory(thread_volume_) + vector_memory(sigma_t_) +
+                vector_memory(tally_task_offsets_) +
+                vector_memory(tally_tasks_) +
+                vector_memory(volume_task_offsets_) +
+                vector_memory(volume_tasks_) + vector_memory(tally_mapped_) +
+                vector_memory(material_) + vector_memory(volume_naive_) +
+                vector_memory(source_sigma_t_) + vector_memory(nu_sigma_f_) +
+                vector_memory(nu_sigma_s_) + vector_memory(chi_) +
+                vector_memory(anderson_dg_) + vector_memory(anderson_df_) +
+                vector_memory(anderson_g_prev_) +
+                vector_memory(anderson_f_prev_) +
+                vector_memory(scalar_flux_final_);
+  for (const auto& volumes : tally_volumes_) {
+    size += volumes.size() * sizeof(double) / 1.0e6;
+  }
+  return size;
+}
+
+void FlatSourceDomain::accumulate_iteration_flux()
+{
 #pragma omp parallel for
-    for (int se = 0; se < n_source_elements_; se++) {
-      source_[se] += external_source_[se];
+  for (int64_t se = 0; se < n_source_elements_; se++) {
+    scalar_flux_final_[se] += scalar_flux_new_[se];
+  }
+}
+
+// Compute new estimate of scattering + fission sources in each source region
+// based on the flux estimate from the previous iteration. Each process updates
+// its own block of source regions and the blocks are then gathered.
+void FlatSourceDomain::update_neutron_source(double k_eff)
+{
+  simulation::time_update_src.start();
+
+  double inverse_k_eff = 1.0 / k_eff;
+
+  // The loop only uses plain arrays so that it can run on a device
+  int ng = negroups_;
+  int64_t sr_begin = sr_begin_;
+  int64_t n_sr = sr_end_ - sr_begin_;
+  int64_t first = sr_begin * ng;
+  int64_t n = n_sr * ng;
+  int64_t n_external = settings::run_mode == RunMode::FIXED_SOURCE ? n : 0;
+  const int* materials = material_.data();
+  const double* scalar_flux = scalar_flux_old_.data();
+  const float* external_source = external_source_.data();
+  float* source = source_.data();
+  const double* source_sigma_t = source_sigma_t_.data();
+  const double* nu_sigma_f_all = nu_sigma_f_.data();
+  const double* nu_sigma_s = nu_sigma_s_.data();
+  const double* chi_all = chi_.data();
+
+  // Add the scattering, fission, and, in fixed source mode, external sources.
+  // On a device, only the fluxes and sources of this process are copied.
+#ifdef OPENMC_OFFLOAD
+#pragma omp target teams distribute parallel for \
+  map(to : materials[sr_begin : n_sr], scalar_flux[first : n], \
+      external_source[first : n_external]) map(from : source[first : n])
+#else
+#pragma omp parallel for
+#endif
+  for (int64_t sr = sr_begin; sr < sr_begin + n_sr; sr++) {
+    int material = materials[sr];
+    const double* flux = &scalar_flux[sr * ng];
+    const double* nu_sigma_f = &nu_sigma_f_all[material * ng];
+
+    for (int e_out = 0; e_out < ng; e_out++) {
+      int64_t i = material * ng + e_out;
+      double sigma_t = source_sigma_t[i];
+      const double* sigma_s = &nu_sigma_s[i * ng];
+      const double* chi = &chi_all[i * ng];
+      double scatter_source = 0.0f;
+      double fission_source = 0.0f;
+
+      for (int e_in = 0; e_in < ng; e_in++) {
+        scatter_source += sigma_s[e_in] * flux[e_in];
+        fission_source += nu_sigma_f[e_in] * flux[e_in] * chi[e_in];
+      }
+
+      float s = scatter_source / sigma_t;
+      s += fission_source * inverse_k_eff / sigma_t;
+      if (n_external > 0)
+        s += external_source[sr * ng + e_out];
+      source[sr * ng + e_out] = s;
     }
   }
 
+  // Share the sources of the source regions updated by this process
+  allgather_source();
+
   simulation::time_update_src.stop();
 }
 
@@ -223,15 +629,7 @@ void FlatSourceDomain::normalize_scalar_flux_and_volumes(
 void FlatSourceDomain::set_flux_to_flux_plus_source(
   int64_t idx, double volume, int material, int g)
 {
-  // Temperature and angle indices, if using multiple temperature
-  // data sets and/or anisotropic data sets.
-  // TODO: Currently assumes we are only using single temp/single
-  // angle data.
-  const int t = 0;
-  const int a = 0;
-
-  double sigma_t = data::mg.macro_xs_[material].get_xs(
-    MgxsType::TOTAL, g, nullptr, nullptr, nullptr, t, a);
+  double sigma_t = source_sigma_t_[material * negroups_ + g];
 
   scalar_flux_new_[idx] /= (sigma_t * volume);
   scalar_flux_new_[idx] += source_[idx];
@@ -437,6 +835,56 @@ double FlatSourceDomain::compute_k_eff(double k_eff_old) const
 // be passed back to the caller to alert them that this function doesn't
 // need to be called for the remainder of the simulation.
 
+namespace {
+
+// Adds the tasks found by each thread to a task list in compressed sparse row
+// form. All tasks of a source element must have been found by the same thread.
+void merge_tally_tasks(
+  const vector<vector<std::pair<int64_t, TallyTask>>>& new_tasks,
+  vector<int64_t>& offsets, vector<TallyTask>& tasks)
+{
+  size_t n_new = 0;
+  for (const auto& thread_tasks : new_tasks) {
+    n_new += thread_tasks.size();
+  }
+  if (n_new == 0)
+    return;
+
+  // Count the tasks of each element and convert the counts to offsets
+  int64_t n = offsets.size() - 1;
+  vector<int64_t> merged_offsets(n + 1, 0);
+  for (int64_t i = 0; i < n; i++) {
+    merged_offsets[i + 1] = offsets[i + 1] - offsets[i];
+  }
+  for (const auto& thread_tasks : new_tasks) {
+    for (const auto& t : thread_tasks) {
+      merged_offsets[t.first + 1]++;
+    }
+  }
+  for (int64_t i = 0; i < n; i++) {
+    merged_offsets[i + 1] += merged_offsets[i];
+  }
+
+  // Place the existing tasks of each element followed by its new ones
+  vector<TallyTask> merged(merged_offsets[n]);
+  vector<int64_t> next(merged_offsets.begin(), merged_offsets.end() - 1);
+  for (int64_t i = 0; i < n; i++) {
+    next[i] = std::copy(tasks.begin() + offsets[i],
+                tasks.begin() + offsets[i + 1], merged.begin() + next[i]) -
+              merged.begin();
+  }
+  for (const auto& thread_tasks : new_tasks) {
+    for (const auto& t : thread_tasks) {
+      merged[next[t.first]++] = t.second;
+    }
+  }
+
+  offsets = std::move(merged_offsets);
+  tasks = std::move(merged);
+}
+
+} // namespace
+
 void FlatSourceDomain::convert_source_regions_to_tallies()
 {
   openmc::simulation::time_tallies.start();
@@ -444,86 +892,133 @@ void FlatSourceDomain::convert_source_regions_to_tallies()
   // Tracks if we've generated a mapping yet for all source regions.
   bool all_source_regions_mapped = true;
 
-// Attempt to generate mapping for all source regions
-#pragma omp parallel for
-  for (int sr = 0; sr < n_source_regions_; sr++) {
+  // Tasks found for newly mapped source elements and source regions, held by
+  // each thread until they are merged into the task lists
+  vector<vector<std::pair<int64_t, TallyTask>>> new_tasks(num_threads());
+  vector<vector<std::pair<int64_t, TallyTask>>> new_volume_tasks(
+    num_threads());
 
-    // If this source region has not been hit by a ray yet, then
-    // we aren't going to be able to map it, so skip it.
-    if (!position_recorded_[sr]) {
-      all_source_regions_mapped = false;
-      continue;
-    }
+  auto block = tally_source_regions();
+  int64_t sr_begin = block.first;
+  int64_t sr_end = block.second;
 
-    // A particle located at the recorded midpoint of a ray
-    // crossing through this source region is used to estabilish
-    // the spatial location of the source region
-    Particle p;
-    p.r() = position_[sr];
-    p.r_last() = position_[sr];
-    bool found = exhaustive_find_cell(p);
-
-    // Loop over energy groups (so as to support energy filters)
-    for (int g = 0; g < negroups_; g++) {
+// Attempt to generate mapping for all source regions
+#pragma omp parallel
+  {
+    auto& tasks = new_tasks[thread_num()];
+    auto& volume_tasks = new_volume_tasks[thread_num()];
 
-      // Set particle to the current energy
-      p.g() = g;
-      p.g_last() = g;
-      p.E() = data::mg.energy_bin_avg_[p.g()];
-      p.E_last() = p.E();
+#pragma omp for reduction(&& : all_source_regions_mapped)
+    for (int64_t sr = sr_begin; sr < sr_end; sr++) {
 
-      int64_t source_element = sr * negroups_ + g;
+      // If the tasks of this source region have already been found, we don't
+      // need to do it again.
+      if (tally_mapped_[sr])
+        continue;
 
-      // If this task has already been populated, we don't need to do
-      // it again.
-      if (tally_task_[source_element].size() > 0) {
+      // If this source region has not been hit by a ray yet, then
+      // we aren't going to be able to map it, so skip it.
+      if (!position_recorded_[sr]) {
+        all_source_regions_mapped = false;
         continue;
       }
 
-      // Loop over all active tallies. This logic is essentially identical
-      // to what happens when scanning for applicable tallies during
-      // MC transport.
-      for (auto i_tally : model::active_tallies) {
-        Tally& tally {*model::tallies[i_tally]};
-
-        // Initialize an iterator over valid filter bin combinations.
-        // If there are no valid combinations, use a continue statement
-        // to ensure we skip the assume_separate break below.
-        auto filter_iter = FilterBinIter(tally, p);
-        auto end = FilterBinIter(tally, true, &p.filter_matches());
-        if (filter_iter == end)
-          continue;
-
-        // Loop over filter bins.
-        for (; filter_iter != end; ++filter_iter) {
-          auto filter_index = filter_iter.index_;
-          auto filter_weight = filter_iter.weight_;
-
-          // Loop over scores
-          for (auto score_index = 0; score_index < tally.scores_.size();
-               score_index++) {
-            auto score_bin = tally.scores_[score_index];
-            // If a valid tally, filter, and score combination has been found,
-            // then add it to the list of tally tasks for this source element.
-            TallyTask task(i_tally, filter_index, score_index, score_bin);
-            tally_task_[source_element].push_back(task);
-
-            // Also add this task to the list of volume tasks for this source
-            // region.
-            volume_task_[sr].insert(task);
+      // A particle located at the recorded midpoint of a ray
+      // crossing through this source region is used to estabilish
+      // the spatial location of the source region
+      Particle p;
+      p.r() = position_[sr];
+      p.r_last() = position_[sr];
+      bool found = exhaustive_find_cell(p);
+
+      // Volume tasks of this source region found so far
+      auto first_volume_task = volume_tasks.size();
+
+      // Loop over energy groups (so as to support energy filters)
+      for (int g = 0; g < negroups_; g++) {
+
+        // Set particle to the current energy
+        p.g() = g;
+        p.g_last() = g;
+        p.E() = data::mg.energy_bin_avg_[p.g()];
+        p.E_last() = p.E();
+
+        int64_t source_element = sr * negroups_ + g;
+
+        // Loop over all active tallies. This logic is essentially identical
+        // to what happens when scanning for applicable tallies during
+        // MC transport.
+        for (auto i_tally : model::active_tallies) {
+          Tally& tally {*model::tallies[i_tally]};
+
+          // Initialize an iterator over valid filter bin combinations.
+          // If there are no valid combinations, use a continue statement
+          // to ensure we skip the assume_separate break below.
+          auto filter_iter = FilterBinIter(tally, p);
+          auto end = FilterBinIter(tally, true, &p.filter_matches());
+          if (filter_iter == end)
+            continue;
+
+          // Loop over filter bins.
+          for (; filter_iter != end; ++filter_iter) {
+            auto filter_index = filter_iter.index_;
+            auto filter_weight = filter_iter.weight_;
+
+            // Loop over scores
+            for (auto score_index = 0; score_index < tally.scores_.size();
+                 score_index++) {
+              auto score_bin = tally.scores_[score_index];
+              // If a valid tally, filter, and score combination has been
+              // found, then add it to the list of tally tasks for this source
+              // element.
+              TallyTask task(i_tally, filter_index, score_index, score_bin);
+              tasks.emplace_back(source_element, task);
+
+              // Also add flux tasks to the list of volume tasks for this
+              // source region, unless another energy group already did.
+              if (score_bin != SCORE_FLUX)
+                continue;
+              auto it = std::find_if(volume_tasks.begin() + first_volume_task,
+                volume_tasks.end(),
+                [&task](const auto& t) { return t.second == task; });
+              if (it == volume_tasks.end())
+                volume_tasks.emplace_back(sr, task);
+            }
           }
         }
+        // Reset all the filter matches for the next tally event.
+        reset_filter_matches(p);
       }
-      // Reset all the filter matches for the next tally event.
-      for (auto& match : p.filter_matches())
-        match.bins_present_ = false;
+      tally_mapped_[sr] = 1;
     }
   }
+
+  merge_tally_tasks(new_tasks, tally_task_offsets_, tally_tasks_);
+  merge_tally_tasks(new_volume_tasks, volume_task_offsets_, volume_tasks_);
+
+#ifdef OPENMC_MPI
+  // Each process only maps its own source regions, so all of them need to be
+  // mapped before any process can stop mapping
+  int all_mapped = all_source_regions_mapped;
+  MPI_Allreduce(
+    MPI_IN_PLACE, &all_mapped, 1, MPI_INT, MPI_MIN, mpi::intracomm);
+  all_source_regions_mapped = all_mapped;
+#endif
+
   openmc::simulation::time_tallies.stop();
 
   mapped_all_tallies_ = all_source_regions_mapped;
 }
 
+// Block of source regions that are mapped to tallies and tallied by this
+// process. The fluxes and volumes of all source regions are known by all
+// processes, so this does not need to follow the partition of source updates.
+std::pair<int64_t, int64_t> FlatSourceDomain::tally_source_regions() const
+{
+  return {n_source_regions_ * mpi::rank / mpi::n_procs,
+    n_source_regions_ * (mpi::rank + 1) / mpi::n_procs};
+}
+
 // Set the volume accumulators to zero for all tallies
 void FlatSourceDomain::reset_tally_volumes()
 {
@@ -613,11 +1108,16 @@ void FlatSourceDomain::random_ray_tally()
   double source_normalization_factor =
     compute_fixed_source_normalization_factor();
 
+  // Each process scores its own block of source regions
+  auto block = tally_source_regions();
+  int64_t sr_begin = block.first;
+  int64_t sr_end = block.second;
+
 // We loop over all source regions and energy groups. For each
 // element, we check if there are any scores needed and apply
 // them.
 #pragma omp parallel for
-  for (int sr = 0; sr < n_source_regions_; sr++) {
+  for (int64_t sr = sr_begin; sr < sr_end; sr++) {
     // The fsr.volume_ is the unitless fractional simulation averaged volume
     // (i.e., it is the FSR's fraction of the overall simulation volume). The
     // simulation_volume_ is the total 3D physical volume in cm^3 of the
@@ -631,11 +1131,13 @@ void FlatSourceDomain::random_ray_tally()
 
     double material = material_[sr];
     for (int g = 0; g < negroups_; g++) {
-      int idx = sr * negroups_ + g;
+      int64_t idx = sr * negroups_ + g;
       double flux = scalar_flux_new_[idx] * source_normalization_factor;
 
       // Determine numerical score value
-      for (auto& task : tally_task_[idx]) {
+      for (int64_t k = tally_task_offsets_[idx];
+           k < tally_task_offsets_[idx + 1]; k++) {
+        const auto& task = tally_tasks_[k];
         double score;
         switch (task.score_type) {
 
@@ -684,22 +1186,55 @@ void FlatSourceDomain::random_ray_tally()
     // for normalizing the flux. We store this volume in a separate tensor.
     // We only contribute to each volume tally bin once per FSR.
     if (volume_normalized_flux_tallies_) {
-      for (const auto& task : volume_task_[sr]) {
-        if (task.score_type == SCORE_FLUX) {
+      for (int64_t k = volume_task_offsets_[sr];
+           k < volume_task_offsets_[sr + 1]; k++) {
+        const auto& task = volume_tasks_[k];
 #pragma omp atomic
-          tally_volumes_[task.tally_idx](task.filter_idx, task.score_idx) +=
-            volume;
-        }
+        tally_volumes_[task.tally_idx](task.filter_idx, task.score_idx) +=
+          volume;
       }
     }
   } // end FSR loop
 
+#ifdef OPENMC_MPI
+  // Sum the scores and volumes of all processes onto the master process,
+  // which accumulates them, and reset them on the other processes
+  if (mpi::n_procs > 1) {
+    for (auto i_tally : model::active_tallies) {
+      auto values_view = xt::view(model::tallies[i_tally]->results_, xt::all(),
+        xt::all(), static_cast<int>(TallyResult::VALUE));
+      vector<double> values(values_view.begin(), values_view.end());
+      if (mpi::master) {
+        MPI_Reduce(MPI_IN_PLACE, values.data(), values.size(), MPI_DOUBLE,
+          MPI_SUM, 0, mpi::intracomm);
+        std::copy(values.begin(), values.end(), values_view.begin());
+      } else {
+        MPI_Reduce(values.data(), nullptr, values.size(), MPI_DOUBLE, MPI_SUM,
+          0, mpi::intracomm);
+        values_view = 0.0;
+      }
+    }
+
+    if (volume_normalized_flux_tallies_) {
+      for (auto& tensor : tally_volumes_) {
+        if (mpi::master) {
+          MPI_Reduce(MPI_IN_PLACE, tensor.data(), tensor.size(), MPI_DOUBLE,
+            MPI_SUM, 0, mpi::intracomm);
+        } else {
+          MPI_Reduce(tensor.data(), nullptr, tensor.size(), MPI_DOUBLE,
+            MPI_SUM, 0, mpi::intracomm);
+        }
+      }
+    }
+  }
+#endif
+
   // Normalize any flux scores by the total volume of the FSRs scoring to that
   // bin. To do this, we loop over all tallies, and then all filter bins,
   // and then scores. For each score, we check the tally data structure to
   // see what index that score corresponds to. If that score is a flux score,
   // then we divide it by volume.
-  if (volume_normalized_flux_tallies_) {
+  if (volume_normalized_flux_tallies_ && mpi::master) {
     for (int i = 0; i < model::tallies.size(); i++) {
       Tally& tally {*model::tallies[i]};
 #pragma omp parallel for
@@ -743,50 +1278,32 @@ void FlatSourceDomain::all_reduce_replicated_source_regions()
   // as we do not want the sum of all positions in each cell, rather, we
   // want to just pick any single valid position. Thus, we perform a gather
   // and then pick the first valid position we find for all source regions
-  // that have had a position recorded. This operation does not need to
-  // be broadcast back to other ranks, as this value is only used for the
-  // tally conversion operation, which is only performed on the master rank.
-  // While this is expensive, it only needs to be done for active batches,
-  // and only if we have not mapped all the tallies yet. Once tallies are
-  // fully mapped, then the position vector is fully populated, so this
-  // operation can be skipped.
-
-  // First, we broadcast the fully mapped tally status variable so that
-  // all ranks are on the same page
-  int mapped_all_tallies_i = static_cast<int>(mapped_all_tallies_);
-  MPI_Bcast(&mapped_all_tallies_i, 1, MPI_INT, 0, mpi::intracomm);
-
-  // Then, we perform the gather of position data, if needed
+  // that have had a position recorded. The picked positions are then
+  // broadcast back to all ranks, as each rank maps its own block of source
+  // regions to tallies. While this is expensive, it only needs to be done for
+  // active batches, and only if we have not mapped all the tallies yet. Once
+  // tallies are fully mapped, which all ranks agree on, then the position
+  // vector is fully populated, so this operation can be skipped.
   if (simulation::current_batch > settings::n_inactive &&
-      !mapped_all_tallies_i) {
+      !mapped_all_tallies_) {
 
     // Master rank will gather results and pick valid positions
     if (mpi::master) {
-      // Initialize temporary vector for receiving positions
-      vector<vector<Position>> all_position;
-      all_position.resize(mpi::n_procs);
-      for (int i = 0; i < mpi::n_procs; i++) {
-        all_position[i].resize(n_source_regions_);
-      }
-
-      // Copy master rank data into gathered vector for convenience
-      all_position[0] = position_;
-
-      // Receive all data into gather vector
+      // Receive the positions of each rank in turn, so that only one
+      // additional copy of the positions is held, and pick the first valid
+      // position of each source region that has none yet
+      vector<Position> rank_position(n_source_regions_);
       for (int i = 1; i < mpi::n_procs; i++) {
-        MPI_Recv(all_position[i].data(), n_source_regions_ * 3, MPI_DOUBLE, i,
-          0, mpi::intracomm, MPI_STATUS_IGNORE);
-      }
+        MPI_Recv(rank_position.data(), n_source_regions_ * 3, MPI_DOUBLE, i, 0,
+          mpi::intracomm, MPI_STATUS_IGNORE);
 
-      // Scan through gathered data and pick first valid cell posiiton
-      for (int sr = 0; sr < n_source_regions_; sr++) {
-        if (position_recorded_[sr] == 1) {
-          for (int i = 0; i < mpi::n_procs; i++) {
-            if (all_position[i][sr].x != 0.0 || all_position[i][sr].y != 0.0 ||
-                all_position[i][sr].z != 0.0) {
-              position_[sr] = all_position[i][sr];
-              break;
-            }
+#pragma omp parallel for
+        for (int64_t sr = 0; sr < n_source_regions_; sr++) {
+          const Position& r = position_[sr];
+          const Position& r_i = rank_position[sr];
+          if (position_recorded_[sr] == 1 && r.x == 0.0 && r.y == 0.0 &&
+              r.z == 0.0) {
+            position_[sr] = r_i;
           }
         }
       }
@@ -795,16 +1312,15 @@ void FlatSourceDomain::all_reduce_replicated_source_regions()
       MPI_Send(position_.data(), n_source_regions_ * 3, MPI_DOUBLE, 0, 0,
         mpi::intracomm);
     }
+    MPI_Bcast(
+      position_.data(), n_source_regions_ * 3, MPI_DOUBLE, 0, mpi::intracomm);
   }
 
   // For the rest of the source region data, we simply perform an all reduce,
   // as these values will be needed on all ranks for transport during the
   // next iteration.
-  MPI_Allreduce(MPI_IN_PLACE, volume_.data(), n_source_regions_, MPI_DOUBLE,
-    MPI_SUM, mpi::intracomm);
-
-  MPI_Allreduce(MPI_IN_PLACE, scalar_flux_new_.data(), n_source_elements_,
-    MPI_DOUBLE, MPI_SUM, mpi::intracomm);
+  mpi::allreduce_sum(volume_.data(), n_source_regions_);
+  mpi::allreduce_sum(scalar_flux_new_.data(), n_source_elements_);
 
   simulation::time_bank_sendrecv.stop();
 #endif
@@ -891,8 +1407,8 @@ void FlatSourceDomain::output_to_vtk() const
           p.r() = sample;
           bool found = exhaustive_find_cell(p);
           int i_cell = p.lowest_coord().cell;
-          int64_t source_region_idx =
-            source_region_offsets_[i_cell] + p.cell_instance();
+          int64_t source_region_idx = source_region_index(
+            i_cell, p.cell_instance(), mesh_bin(i_cell, sample));
           voxel_indices[z * Ny * Nx + y * Nx + x] = source_region_idx;
           voxel_positions[z * Ny * Nx + y * Nx + x] = sample;
         }
@@ -998,9 +1514,11 @@ void FlatSourceDomain::apply_external_source_to_cell_instances(int32_t i_cell,
     int cell_material_id = model::materials[cell_material_idx]->id();
     if (target_material_id == C_NONE ||
         cell_material_id == target_material_id) {
-      int64_t source_region = source_region_offsets_[i_cell] + j;
-      apply_external_source_to_source_region(
-        discrete, strength_factor, source_region);
+      for (int b = 0; b < source_region_bins_[i_cell]; b++) {
+        int64_t source_region = source_region_index(i_cell, j, b);
+        apply_external_source_to_source_region(
+          discrete, strength_factor, source_region);
+      }
     }
   }
 }
@@ -1092,6 +1610,37 @@ void FlatSourceDomain::convert_external_sources()
     }
   }
 }
+// Sets the adjoint source of each source element to the inverse of its
+// forward flux, as in the FW-CADIS method, so that the adjoint flux is the
+// importance of each region to estimating the flux everywhere with the same
+// relative precision. Elements never reached by the forward solve have no
+// adjoint source.
+void FlatSourceDomain::set_adjoint_sources(vector<float> forward_flux)
+{
+#ifdef OPENMC_MPI
+  // The forward flux is only accumulated on the master process
+  MPI_Bcast(forward_flux.data(), n_source_elements_, MPI_FLOAT, 0,
+    mpi::intracomm);
+#endif
+
+  parallel_fill<float>(external_source_, 0.0f);
+  external_source_present_.assign(n_source_regions_, false);
+
+  // As with the forward external source, the adjoint source is divided by the
+  // total cross section once here rather than in every iteration
+  for (int64_t sr = 0; sr < n_source_regions_; sr++) {
+    int material = material_[sr];
+    for (int g = 0; g < negroups_; g++) {
+      int64_t se = sr * negroups_ + g;
+      if (forward_flux[se] > 0.0f) {
+        external_source_[se] =
+          1.0 / (forward_flux[se] * source_sigma_t_[material * negroups_ + g]);
+        external_source_present_[sr] = true;
+      }
+    }
+  }
+}
+
 void FlatSourceDomain::flux_swap()
 {
   scalar_flux_old_.swap(scalar_flux_new_);
@@ -3,6 +3,7 @@
 #include "openmc/cell.h"
 #include "openmc/geometry.h"
 #include "openmc/material.h"
+#include "openmc/memory_report.h"
 #include "openmc/message_passing.h"
 #include "openmc/mgxs_interface.h"
 #include "openmc/output.h"
@@ -50,28 +51,33 @@ void LinearSourceDomain::batch_reset()
   }
 }
 
+double LinearSourceDomain::memory() const
+{
+  return FlatSourceDomain::memory() + vector_memory(source_gradients_) +
+         vector_memory(flux_moments_old_) + vector_memory(flux_moments_new_) +
+         vector_memory(flux_moments_t_) + vector_memory(centroid_) +
+         vector_memory(centroid_iteration_) + vector_memory(centroid_t_) +
+         vector_memory(mom_matrix_) + vector_memory(mom_matrix_t_);
+}
+
 void LinearSourceDomain::update_neutron_source(double k_eff)
 {
   simulation::time_update_src.start();
 
   double inverse_k_eff = 1.0 / k_eff;
 
-  // Temperature and angle indices, if using multiple temperature
-  // data sets and/or anisotropic data sets.
-  // TODO: Currently assumes we are only using single temp/single
-  // angle data.
-  const int t = 0;
-  const int a = 0;
-
 #pragma omp parallel for
-  for (int sr = 0; sr < n_source_regions_; sr++) {
+  for (int64_t sr = sr_begin_; sr < sr_end_; sr++) {
 
     int material = material_[sr];
     MomentMatrix invM = mom_matrix_[sr].inverse();
+    const double* nu_sigma_f_mat = &nu_sigma_f_[material * negroups_];
 
     for (int e_out = 0; e_out < negroups_; e_out++) {
-      double sigma_t = data::mg.macro_xs_[material].get_xs(
-        MgxsType::TOTAL, e_out, nullptr, nullptr, nullptr, t, a);
+      int64_t i = material * negroups_ + e_out;
+      double sigma_t = source_sigma_t_[i];
+      const double* sigma_s_mat = &nu_sigma_s_[i * negroups_];
+      const double* chi_mat = &chi_[i * negroups_];
 
       double scatter_flat = 0.0f;
       double fission_flat = 0.0f;
@@ -84,12 +90,9 @@ void LinearSourceDomain::update_neutron_source(double k_eff)
         MomentArray flux_linear = flux_moments_old_[sr * negroups_ + e_in];
 
         // Handles for cross sections
-        double sigma_s = data::mg.macro_xs_[material].get_xs(
-          MgxsType::NU_SCATTER, e_in, &e_out, nullptr, nullptr, t, a);
-        double nu_sigma_f = data::mg.macro_xs_[material].get_xs(
-          MgxsType::NU_FISSION, e_in, nullptr, nullptr, nullptr, t, a);
-        double chi = data::mg.macro_xs_[material].get_xs(
-          MgxsType::CHI_PROMPT, e_in, &e_out, nullptr, nullptr, t, a);
+        double sigma_s = sigma_s_mat[e_in];
+        double nu_sigma_f = nu_sigma_f_mat[e_in];
+        double chi = chi_mat[e_in];
 
         // Compute source terms for flat and linear components of the flux
         scatter_flat += sigma_s * flux_flat;
@@ -116,11 +119,14 @@ void LinearSourceDomain::update_neutron_source(double k_eff)
   if (settings::run_mode == RunMode::FIXED_SOURCE) {
 // Add external source to flat source term if in fixed source mode
 #pragma omp parallel for
-    for (int se = 0; se < n_source_elements_; se++) {
+    for (int64_t se = sr_begin_ * negroups_; se < sr_end_ * negroups_; se++) {
       source_[se] += external_source_[se];
     }
   }
 
+  // Share the sources of the source regions updated by this process
+  allgather_source();
+
   simulation::time_update_src.stop();
 }
 
@@ -206,13 +212,33 @@ void LinearSourceDomain::all_reduce_replicated_source_regions()
     fatal_error("Unexpected buffer padding in linear source domain reduction.");
   }
 
-  MPI_Allreduce(MPI_IN_PLACE, static_cast<void*>(flux_moments_new_.data()),
-    n_source_elements_ * 3, MPI_DOUBLE, MPI_SUM, mpi::intracomm);
-  MPI_Allreduce(MPI_IN_PLACE, static_cast<void*>(mom_matrix_.data()),
-    n_source_regions_ * 6, MPI_DOUBLE, MPI_SUM, mpi::intracomm);
-  MPI_Allreduce(MPI_IN_PLACE, static_cast<void*>(centroid_iteration_.data()),
-    n_source_regions_ * 3, MPI_DOUBLE, MPI_SUM, mpi::intracomm);
+  mpi::allreduce_sum(reinterpret_cast<double*>(flux_moments_new_.data()),
+    n_source_elements_ * 3);
+  mpi::allreduce_sum(
+    reinterpret_cast<double*>(mom_matrix_.data()), n_source_regions_ * 6);
+  mpi::allreduce_sum(reinterpret_cast<double*>(centroid_iteration_.data()),
+    n_source_regions_ * 3);
+
+  simulation::time_bank_sendrecv.stop();
+#endif
+}
+
+void LinearSourceDomain::allgather_source()
+{
+  FlatSourceDomain::allgather_source();
 
+#ifdef OPENMC_MPI
+  if (mpi::n_procs <= 1 || sr_end_ - sr_begin_ == n_source_regions_)
+    return;
+
+  // As in the reduction above, source gradients are gathered as contiguous
+  // arrays of doubles
+  simulation::time_bank_sendrecv.start();
+  auto counts = gather_counts(3 * negroups_);
+  auto offsets = gather_offsets(3 * negroups_);
+  MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+    static_cast<void*>(source_gradients_.data()), counts.data(),
+    offsets.data(), MPI_DOUBLE, mpi::intracomm);
   simulation::time_bank_sendrecv.stop();
 #endif
 }
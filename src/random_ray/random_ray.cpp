@@ -4,6 +4,8 @@
 #include "openmc/geometry.h"
 #include "openmc/message_passing.h"
 #include "openmc/mgxs_interface.h"
+#include "openmc/openmp_interface.h"
+#include "openmc/random_ray/exponentials.h"
 #include "openmc/random_ray/flat_source_domain.h"
 #include "openmc/random_ray/linear_source_domain.h"
 #include "openmc/search.h"
@@ -13,167 +15,6 @@
 
 namespace openmc {
 
-//==============================================================================
-// Non-method functions
-//==============================================================================
-
-// returns 1 - exp(-tau)
-// Equivalent to -(_expm1f(-tau)), but faster
-// Written by Colin Josey.
-float cjosey_exponential(float tau)
-{
-  constexpr float c1n = -1.0000013559236386308f;
-  constexpr float c2n = 0.23151368626911062025f;
-  constexpr float c3n = -0.061481916409314966140f;
-  constexpr float c4n = 0.0098619906458127653020f;
-  constexpr float c5n = -0.0012629460503540849940f;
-  constexpr float c6n = 0.00010360973791574984608f;
-  constexpr float c7n = -0.000013276571933735820960f;
-
-  constexpr float c0d = 1.0f;
-  constexpr float c1d = -0.73151337729389001396f;
-  constexpr float c2d = 0.26058381273536471371f;
-  constexpr float c3d = -0.059892419041316836940f;
-  constexpr float c4d = 0.0099070188241094279067f;
-  constexpr float c5d = -0.0012623388962473160860f;
-  constexpr float c6d = 0.00010361277635498731388f;
-  constexpr float c7d = -0.000013276569500666698498f;
-
-  float x = -tau;
-
-  float den = c7d;
-  den = den * x + c6d;
-  den = den * x + c5d;
-  den = den * x + c4d;
-  den = den * x + c3d;
-  den = den * x + c2d;
-  den = den * x + c1d;
-  den = den * x + c0d;
-
-  float num = c7n;
-  num = num * x + c6n;
-  num = num * x + c5n;
-  num = num * x + c4n;
-  num = num * x + c3n;
-  num = num * x + c2n;
-  num = num * x + c1n;
-  num = num * x;
-
-  return num / den;
-}
-
-// The below two functions (exponentialG and exponentialG2) were developed
-// by Colin Josey. The implementation of these functions is closely based
-// on the OpenMOC versions of these functions. The OpenMOC license is given
-// below:
-
-// Copyright (C) 2012-2023 Massachusetts Institute of Technology and OpenMOC
-// contributors
-//
-// Permission is hereby granted, free of charge, to any person obtaining a copy
-// of this software and associated documentation files (the "Software"), to deal
-// in the Software without restriction, including without limitation the rights
-// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
-// copies of the Software, and to permit persons to whom the Software is
-// furnished to do so, subject to the following conditions:
-//
-// The above copyright notice and this permission notice shall be included in
-// all copies or substantial portions of the Software.
-//
-// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-// SOFTWARE.
-
-// Computes y = 1/x-(1-exp(-x))/x**2 using a 5/6th order rational
-// approximation. It is accurate to 2e-7 over [0, 1e5]. Developed by Colin
-// Josey using Remez's algorithm, with original implementation in OpenMOC at:
-// https://github.com/mit-crpg/OpenMOC/blob/develop/src/exponentials.h
-float exponentialG(float tau)
-{
-  // Numerator coefficients in rational approximation for 1/x - (1 - exp(-x)) /
-  // x^2
-  constexpr float d0n = 0.5f;
-  constexpr float d1n = 0.176558112351595f;
-  constexpr float d2n = 0.04041584305811143f;
-  constexpr float d3n = 0.006178333902037397f;
-  constexpr float d4n = 0.0006429894635552992f;
-  constexpr float d5n = 0.00006064409107557148f;
-
-  // Denominator coefficients in rational approximation for 1/x - (1 - exp(-x))
-  // / x^2
-  constexpr float d0d = 1.0f;
-  constexpr float d1d = 0.6864462055546078f;
-  constexpr float d2d = 0.2263358514260129f;
-  constexpr float d3d = 0.04721469893686252f;
-  constexpr float d4d = 0.006883236664917246f;
-  constexpr float d5d = 0.0007036272419147752f;
-  constexpr float d6d = 0.00006064409107557148f;
-
-  float x = tau;
-
-  float num = d5n;
-  num = num * x + d4n;
-  num = num * x + d3n;
-  num = num * x + d2n;
-  num = num * x + d1n;
-  num = num * x + d0n;
-
-  float den = d6d;
-  den = den * x + d5d;
-  den = den * x + d4d;
-  den = den * x + d3d;
-  den = den * x + d2d;
-  den = den * x + d1d;
-  den = den * x + d0d;
-
-  return num / den;
-}
-
-// Computes G2 : y = 2/3 - (1 + 2/x) * (1/x + 0.5 - (1 + 1/x) * (1-exp(-x)) /
-// x) using a 5/5th order rational approximation. It is accurate to 1e-6 over
-// [0, 1e6]. Developed by Colin Josey using Remez's algorithm, with original
-// implementation in OpenMOC at:
-// https://github.com/mit-crpg/OpenMOC/blob/develop/src/exponentials.h
-float exponentialG2(float tau)
-{
-
-  // Coefficients for numerator in rational approximation
-  constexpr float g1n = -0.08335775885589858f;
-  constexpr float g2n = -0.003603942303847604f;
-  constexpr float g3n = 0.0037673183263550827f;
-  constexpr float g4n = 0.00001124183494990467f;
-  constexpr float g5n = 0.00016837426505799449f;
-
-  // Coefficients for denominator in rational approximation
-  constexpr float g1d = 0.7454048371823628f;
-  constexpr float g2d = 0.23794300531408347f;
-  constexpr float g3d = 0.05367250964303789f;
-  constexpr float g4d = 0.006125197988351906f;
-  constexpr float g5d = 0.0010102514456857377f;
-
-  float x = tau;
-
-  float num = g5n;
-  num = num * x + g4n;
-  num = num * x + g3n;
-  num = num * x + g2n;
-  num = num * x + g1n;
-  num = num * x;
-
-  float den = g5d;
-  den = den * x + g4d;
-  den = den * x + g3d;
-  den = den * x + g2d;
-  den = den * x + g1d;
-  den = den * x + 1.0f;
-
-  return num / den;
-}
-
 //==============================================================================
 // RandomRay implementation
 //==============================================================================
@@ -183,6 +24,8 @@ double RandomRay::distance_inactive_;
 double RandomRay::distance_active_;
 unique_ptr<Source> RandomRay::ray_source_;
 RandomRaySourceShape RandomRay::source_shape_ {RandomRaySourceShape::FLAT};
+int RandomRay::segment_cache_iterations_ {1};
+double RandomRay::segment_cache_memory_ {1000.0};
 
 RandomRay::RandomRay()
   : angular_flux_(data::mg.num_energy_groups_),
@@ -192,6 +35,8 @@ RandomRay::RandomRay()
   if (source_shape_ == RandomRaySourceShape::LINEAR ||
       source_shape_ == RandomRaySourceShape::LINEAR_XY) {
     delta_moments_.resize(negroups_);
+    exp_g_.resize(negroups_);
+    exp_g2_.resize(negroups_);
   }
 }
 
@@ -208,7 +53,82 @@ uint64_t RandomRay::transport_history_based_single_ray()
     event_advance_ray();
     if (!alive())
       break;
-    event_cross_surface();
+    // A segment ending on the boundary of a mesh element subdividing the cell
+    // does not cross a surface
+    if (!mesh_crossed_)
+      event_cross_surface();
+  }
+
+  return n_event();
+}
+
+// Records the starting source region and the segments of the ray as it is
+// transported
+void RandomRay::record_segments(CachedRay* cached_ray)
+{
+  cached_ray_ = cached_ray;
+  cached_ray_->segments.clear();
+  cached_ray_->start_region = current_source_region();
+}
+
+// Index of the source region the ray is in
+int64_t RandomRay::current_source_region() const
+{
+  return domain_->source_region_index(
+    lowest_coord().cell, cell_instance(), mesh_bin_);
+}
+
+// Finds the bin of the mesh subdividing the current cell that the ray is in,
+// with the bin past the last mesh element standing for the parts of the cell
+// outside the mesh, and returns the distance to the next boundary of a mesh
+// element along the ray. Returns INFTY if the cell is not subdivided.
+double RandomRay::update_mesh_bin()
+{
+  const auto* mesh = domain_->source_region_meshes_[lowest_coord().cell];
+  if (!mesh) {
+    mesh_bin_ = 0;
+    return INFTY;
+  }
+
+  bool in_mesh;
+  auto ijk = mesh->get_indices(r() + TINY_BIT * u(), in_mesh);
+  Position r_local = mesh->local_coords(r());
+
+  // Inside the mesh, the next boundary is the closest one. Outside, the mesh
+  // is entered after crossing the planes of all directions in which the ray
+  // is outside of it.
+  double distance = in_mesh ? INFTY : 0.0;
+  for (int k = 0; k < mesh->n_dimension_; k++) {
+    double d = mesh->distance_to_grid_boundary(ijk, k, r_local, u(), 0.0)
+                 .distance;
+    if (in_mesh) {
+      distance = std::min(distance, d);
+    } else if (ijk[k] < 1 || ijk[k] > mesh->shape_[k]) {
+      distance = std::max(distance, d);
+    }
+  }
+
+  mesh_bin_ = in_mesh ? mesh->get_bin_from_indices(ijk) : mesh->n_bins();
+  return distance;
+}
+
+// Transports a ray along the segments recorded when it was traced, starting
+// from the isotropic source of its starting source region. The geometry is
+// not used.
+uint64_t RandomRay::replay_cached_ray(
+  const CachedRay& cached_ray, FlatSourceDomain* domain)
+{
+  domain_ = domain;
+  n_event() = 0;
+
+  int64_t start = cached_ray.start_region * negroups_;
+  for (int g = 0; g < negroups_; g++) {
+    angular_flux_[g] = domain_->source_[start + g];
+  }
+
+  for (const auto& s : cached_ray.segments) {
+    attenuate_flux_flat_source_region(
+      s.source_region, s.material, s.distance, s.is_active, nullptr);
   }
 
   return n_event();
@@ -217,15 +137,42 @@ uint64_t RandomRay::transport_history_based_single_ray()
 // Transports ray across a single source region
 void RandomRay::event_advance_ray()
 {
-  // Find the distance to the nearest boundary
-  boundary() = distance_to_boundary(*this);
+  event_find_segment();
+  if (!alive())
+    return;
+  event_attenuate_segment();
+  event_move_along_segment();
+}
+
+// Finds the length of the segment of the ray in its current source region
+void RandomRay::event_find_segment()
+{
+  // Find the distance to the nearest boundary. If the last segment ended on
+  // the boundary of a mesh element, the ray is still in the same cell and the
+  // nearest boundary is unchanged, so it does not need to be found again.
+  if (!mesh_crossed_)
+    boundary() = distance_to_boundary(*this);
   double distance = boundary().distance;
 
+  // End the segment where the ray leaves the mesh element it is in, if the
+  // cell is subdivided by a mesh
+  double distance_mesh = update_mesh_bin();
+  mesh_crossed_ = distance_mesh < distance;
+  if (mesh_crossed_)
+    distance = distance_mesh;
+
   if (distance <= 0.0) {
     mark_as_lost("Negative transport distance detected for particle " +
                  std::to_string(id()));
-    return;
   }
+  segment_distance_ = distance;
+}
+
+// Attenuates the angular flux of the ray along its current segment and
+// accumulates its contribution to the scalar flux
+void RandomRay::event_attenuate_segment()
+{
+  double& distance = segment_distance_;
 
   if (is_active_) {
     // If the ray is in the active length, need to check if it has
@@ -265,11 +212,17 @@ void RandomRay::event_advance_ray()
       attenuate_flux(distance, false);
     }
   }
+}
 
-  // Advance particle
+// Moves the ray to the end of its current segment
+void RandomRay::event_move_along_segment()
+{
+  double distance = segment_distance_;
   for (int j = 0; j < n_coord(); ++j) {
     coord(j).r += distance * coord(j).u;
   }
+  if (mesh_crossed_)
+    boundary().distance -= distance;
 }
 
 void RandomRay::attenuate_flux(double distance, bool is_active)
@@ -302,42 +255,73 @@ void RandomRay::attenuate_flux(double distance, bool is_active)
 // performed when inside the lock.
 void RandomRay::attenuate_flux_flat_source(double distance, bool is_active)
 {
-  // The number of geometric intersections is counted for reporting purposes
-  n_event()++;
+  // The source region is the spatial region index
+  int64_t source_region = current_source_region();
+  int material = this->material();
 
-  // Determine source region index etc.
-  int i_cell = lowest_coord().cell;
+  // Record the segment so that it can be replayed in later iterations
+  if (cached_ray_) {
+    cached_ray_->segments.push_back(
+      {source_region, distance, material, is_active});
+  }
 
-  // The source region is the spatial region index
-  int64_t source_region =
-    domain_->source_region_offsets_[i_cell] + cell_instance();
+  Position midpoint = r() + u() * (distance / 2.0);
+  attenuate_flux_flat_source_region(
+    source_region, material, distance, is_active, &midpoint);
+}
+
+// Attenuates the flux over a segment of a flat source region. The midpoint of
+// the segment is recorded as a position in the source region if it is given
+// and no position has been recorded yet.
+void RandomRay::attenuate_flux_flat_source_region(int64_t source_region,
+  int material, double distance, bool is_active, const Position* midpoint)
+{
+  // The number of geometric intersections is counted for reporting purposes
+  n_event()++;
 
   // The source element is the energy-specific region index
   int64_t source_element = source_region * negroups_;
-  int material = this->material();
-
-  // Temperature and angle indices, if using multiple temperature
-  // data sets and/or anisotropic data sets.
-  // TODO: Currently assumes we are only using single temp/single
-  // angle data.
-  const int t = 0;
-  const int a = 0;
+  const float* sigma_t_mat = &domain_->sigma_t_[material * negroups_];
 
   // MOC incoming flux attenuation + source contribution/attenuation equation
-  for (int g = 0; g < negroups_; g++) {
-    float sigma_t = data::mg.macro_xs_[material].get_xs(
-      MgxsType::TOTAL, g, NULL, NULL, NULL, t, a);
-    float tau = sigma_t * distance;
-    float exponential = cjosey_exponential(tau); // exponential = 1 - exp(-tau)
-    float new_delta_psi =
-      (angular_flux_[g] - domain_->source_[source_element + g]) * exponential;
-    delta_psi_[g] = new_delta_psi;
-    angular_flux_[g] -= new_delta_psi;
-  }
+  attenuate_flat_source_groups(negroups_, distance, sigma_t_mat,
+    &domain_->source_[source_element], angular_flux_.data(), delta_psi_.data());
 
   // If ray is in the active phase (not in dead zone), make contributions to
   // source region bookkeeping
-  if (is_active) {
+  if (is_active && domain_->accumulation_ != RandomRayAccumulation::LOCK) {
+    if (domain_->accumulation_ == RandomRayAccumulation::PRIVATE) {
+      // Accumulate into the buffers of this thread
+      int i_thread = thread_num();
+      double* flux = &domain_->thread_scalar_flux_[i_thread][source_element];
+      for (int g = 0; g < negroups_; g++) {
+        flux[g] += delta_psi_[g];
+      }
+      domain_->thread_volume_[i_thread][source_region] += distance;
+    } else {
+      for (int g = 0; g < negroups_; g++) {
+#pragma omp atomic
+        domain_->scalar_flux_new_[source_element + g] += delta_psi_[g];
+      }
+#pragma omp atomic
+      domain_->volume_[source_region] += distance;
+    }
+
+    // The position only needs to be recorded by the first ray crossing the
+    // source region, so the lock is only taken until then
+    int recorded;
+#pragma omp atomic read
+    recorded = domain_->position_recorded_[source_region];
+    if (!recorded && midpoint) {
+      domain_->lock_[source_region].lock();
+      if (!domain_->position_recorded_[source_region]) {
+        domain_->position_[source_region] = *midpoint;
+#pragma omp atomic write
+        domain_->position_recorded_[source_region] = 1;
+      }
+      domain_->lock_[source_region].unlock();
+    }
+  } else if (is_active) {
 
     // Aquire lock for source region
     domain_->lock_[source_region].lock();
@@ -354,9 +338,8 @@ void RandomRay::attenuate_flux_flat_source(double distance, bool is_active)
 
     // Tally valid position inside the source region (e.g., midpoint of
     // the ray) if not done already
-    if (!domain_->position_recorded_[source_region]) {
-      Position midpoint = r() + u() * (distance / 2.0);
-      domain_->position_[source_region] = midpoint;
+    if (!domain_->position_recorded_[source_region] && midpoint) {
+      domain_->position_[source_region] = *midpoint;
       domain_->position_recorded_[source_region] = 1;
     }
 
@@ -377,23 +360,13 @@ void RandomRay::attenuate_flux_linear_source(double distance, bool is_active)
   // The number of geometric intersections is counted for reporting purposes
   n_event()++;
 
-  // Determine source region index etc.
-  int i_cell = lowest_coord().cell;
-
   // The source region is the spatial region index
-  int64_t source_region =
-    domain_->source_region_offsets_[i_cell] + cell_instance();
+  int64_t source_region = current_source_region();
 
   // The source element is the energy-specific region index
   int64_t source_element = source_region * negroups_;
   int material = this->material();
-
-  // Temperature and angle indices, if using multiple temperature
-  // data sets and/or anisotropic data sets.
-  // TODO: Currently assumes we are only using single temp/single
-  // angle data.
-  const int t = 0;
-  const int a = 0;
+  const float* sigma_t_mat = &domain_->sigma_t_[material * negroups_];
 
   Position& centroid = domain->centroid_[source_region];
   Position midpoint = r() + u() * (distance / 2.0);
@@ -417,20 +390,30 @@ void RandomRay::attenuate_flux_linear_source(double distance, bool is_active)
   }
   double distance_2 = distance * distance;
 
-  // Linear Source MOC incoming flux attenuation + source
-  // contribution/attenuation equation
+  // Evaluate the exponential terms of all groups in a vectorized loop, apart
+  // from the moment arithmetic below
+#pragma omp simd
   for (int g = 0; g < negroups_; g++) {
-
     // Compute tau, the optical thickness of the ray segment
-    float sigma_t = data::mg.macro_xs_[material].get_xs(
-      MgxsType::TOTAL, g, NULL, NULL, NULL, t, a);
-    float tau = sigma_t * distance;
+    float tau = sigma_t_mat[g] * distance;
 
     // If tau is very small, set it to zero to avoid numerical issues.
     // The following computations will still work with tau = 0.
     if (tau < 1.0e-8f) {
       tau = 0.0f;
     }
+    exp_g_[g] = exponentialG(tau);
+    exp_g2_[g] = exponentialG2(tau);
+  }
+
+  // Linear Source MOC incoming flux attenuation + source
+  // contribution/attenuation equation
+  for (int g = 0; g < negroups_; g++) {
+    float sigma_t = sigma_t_mat[g];
+    float tau = sigma_t * distance;
+    if (tau < 1.0e-8f) {
+      tau = 0.0f;
+    }
 
     // Compute linear source terms, spatial and directional (dir),
     // calculated from the source gradients dot product with local centroid
@@ -440,7 +423,7 @@ void RandomRay::attenuate_flux_linear_source(double distance, bool is_active)
       rm_local.dot(domain->source_gradients_[source_element + g]);
     float dir_source = u().dot(domain->source_gradients_[source_element + g]);
 
-    float gn = exponentialG(tau);
+    float gn = exp_g_[g];
     float f1 = 1.0f - tau * gn;
     float f2 = (2.0f * gn - f1) * distance_2;
     float new_delta_psi = (angular_flux_[g] - spatial_source) * f1 * distance -
@@ -448,7 +431,7 @@ void RandomRay::attenuate_flux_linear_source(double distance, bool is_active)
 
     float h1 = f1 - gn;
     float g1 = 0.5f - h1;
-    float g2 = exponentialG2(tau);
+    float g2 = exp_g2_[g];
     g1 = g1 * spatial_source;
     g2 = g2 * dir_source * distance * 0.5f;
     h1 = h1 * angular_flux_[g];
@@ -518,6 +501,8 @@ void RandomRay::initialize_ray(uint64_t ray_id, FlatSourceDomain* domain)
   // Reset particle event counter
   n_event() = 0;
 
+  // Reset the distance travelled, as rays may be reused for several histories
+  distance_travelled_ = 0.0;
   is_active_ = (distance_inactive_ <= 0.0);
 
   wgt() = 1.0;
@@ -552,9 +537,9 @@ void RandomRay::initialize_ray(uint64_t ray_id, FlatSourceDomain* domain)
 
   // Initialize ray's starting angular flux to starting location's isotropic
   // source
-  int i_cell = lowest_coord().cell;
-  int64_t source_region_idx =
-    domain_->source_region_offsets_[i_cell] + cell_instance();
+  mesh_crossed_ = false;
+  update_mesh_bin();
+  int64_t source_region_idx = current_source_region();
 
   for (int g = 0; g < negroups_; g++) {
     angular_flux_[g] = domain_->source_[source_region_idx * negroups_ + g];
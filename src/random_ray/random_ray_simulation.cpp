@@ -1,7 +1,9 @@
 #include "openmc/random_ray/random_ray_simulation.h"
 
+#include "openmc/capi.h"
 #include "openmc/eigenvalue.h"
 #include "openmc/geometry.h"
+#include "openmc/memory_report.h"
 #include "openmc/message_passing.h"
 #include "openmc/mgxs_interface.h"
 #include "openmc/output.h"
@@ -13,8 +15,12 @@
 #include "openmc/tallies/filter.h"
 #include "openmc/tallies/tally.h"
 #include "openmc/tallies/tally_scoring.h"
+#include "openmc/tally_stream.h"
 #include "openmc/timer.h"
 
+#include <algorithm> // for min, remove_if, sort
+#include <utility>   // for pair
+
 namespace openmc {
 
 //==============================================================================
@@ -30,26 +36,74 @@ void openmc_run_random_ray()
   if (mpi::master)
     validate_random_ray_inputs();
 
-  // Initialize Random Ray Simulation Object
-  RandomRaySimulation sim;
+  // Forward flux, kept to set the sources of the adjoint solve
+  vector<float> forward_flux;
 
-  // Begin main simulation timer
-  simulation::time_total.start();
+  {
+    // Initialize Random Ray Simulation Object
+    RandomRaySimulation sim;
+
+    // Transfer external sources onto source regions, if present
+    sim.prepare_fixed_sources();
+
+    // A dry run stops once the memory allocated by initialization is reported
+    if (settings::memory_report || settings::dry_run) {
+      print_memory_report(
+        "Memory Use After Initialization", sim.memory_usage());
+    }
+    if (settings::dry_run) {
+      openmc_simulation_finalize();
+      return;
+    }
 
-  // Execute random ray simulation
-  sim.simulate();
+    // Begin main simulation timer
+    simulation::time_total.start();
 
-  // End main simulation timer
-  openmc::simulation::time_total.stop();
+    // Execute random ray simulation
+    sim.simulate();
 
-  // Finalize OpenMC
-  openmc_simulation_finalize();
+    if (settings::memory_report) {
+      print_memory_report(
+        "Memory Use at End of Simulation", sim.memory_usage());
+    }
 
-  // Reduce variables across MPI ranks
-  sim.reduce_simulation_statistics();
+    // End main simulation timer
+    openmc::simulation::time_total.stop();
+
+    // Finalize OpenMC
+    openmc_simulation_finalize();
+
+    // Reduce variables across MPI ranks
+    sim.reduce_simulation_statistics();
+
+    // Output all simulation results
+    sim.output_simulation_results();
+
+    if (FlatSourceDomain::adjoint_)
+      forward_flux = sim.domain()->scalar_flux_final();
+  }
+
+  if (!FlatSourceDomain::adjoint_)
+    return;
+
+  // Solve the adjoint equation from scratch, discarding the tallies and
+  // timers of the forward solve. Its flux is the importance used to generate
+  // FW-CADIS weight windows.
+  openmc_reset();
+  openmc_reset_timers();
+  FlatSourceDomain::adjoint_active_ = true;
+  write_message("Solving the adjoint transport equation...", 5);
+  openmc_simulation_init();
 
-  // Output all simulation results
-  sim.output_simulation_results();
+  RandomRaySimulation adjoint_sim;
+  adjoint_sim.prepare_fixed_sources_adjoint(forward_flux);
+  simulation::time_total.start();
+  adjoint_sim.simulate();
+  simulation::time_total.stop();
+  openmc_simulation_finalize();
+  adjoint_sim.reduce_simulation_statistics();
+  adjoint_sim.output_simulation_results();
+  FlatSourceDomain::adjoint_active_ = false;
 }
 
 // Enforces restrictions on inputs in random ray mode.  While there are
@@ -89,12 +143,13 @@ void validate_random_ray_inputs()
       case FilterType::ENERGY:
       case FilterType::MATERIAL:
       case FilterType::MESH:
+      case FilterType::PARTICLE:
       case FilterType::UNIVERSE:
         break;
       default:
         fatal_error("Invalid filter specified. Only cell, cell_instance, "
-                    "distribcell, energy, material, mesh, and universe filters "
-                    "are supported in random ray mode.");
+                    "distribcell, energy, material, mesh, particle, and "
+                    "universe filters are supported in random ray mode.");
       }
     }
   }
@@ -256,13 +311,38 @@ RandomRaySimulation::RandomRaySimulation()
   }
 }
 
-void RandomRaySimulation::simulate()
+vector<MemoryUse> RandomRaySimulation::memory_usage() const
+{
+  double cache = vector_memory(cached_rays_);
+  for (const auto& ray : cached_rays_) {
+    cache += vector_memory(ray.segments);
+  }
+  return {{"Random ray", "Source regions", domain_->memory()},
+    {"Random ray", "Cached rays", cache}};
+}
+
+void RandomRaySimulation::prepare_fixed_sources()
 {
   if (settings::run_mode == RunMode::FIXED_SOURCE) {
     // Transfer external source user inputs onto random ray source regions
     domain_->convert_external_sources();
     domain_->count_external_source_regions();
   }
+}
+
+void RandomRaySimulation::prepare_fixed_sources_adjoint(
+  const vector<float>& forward_flux)
+{
+  if (settings::run_mode == RunMode::FIXED_SOURCE) {
+    domain_->set_adjoint_sources(forward_flux);
+    domain_->count_external_source_regions();
+  }
+}
+
+void RandomRaySimulation::simulate()
+{
+  // Stream the accumulated flux of the source regions along with the tallies
+  stream_source_region_flux(domain_->scalar_flux_final(), negroups_);
 
   // Random ray power iteration loop
   while (simulation::current_batch < settings::n_batches) {
@@ -284,15 +364,68 @@ void RandomRaySimulation::simulate()
     // Start timer for transport
     simulation::time_transport.start();
 
-// Transport sweep over all random rays for the iteration
+    // When caching segments, new rays are sampled and traced through the
+    // geometry once every segment_cache_iterations_ iterations. The segments
+    // recorded then are replayed in the iterations in between, unless they
+    // did not fit in the memory given for them.
+    int n_cache = RandomRay::segment_cache_iterations_;
+    bool replay =
+      cache_valid_ && (simulation::current_batch - 1) % n_cache != 0;
+    bool record = !replay && n_cache > 1 && !cache_overflow_;
+    int64_t max_segments =
+      RandomRay::segment_cache_memory_ * 1.0e6 / sizeof(RaySegment);
+    int64_t n_segments = 0;
+    if (record) {
+      cached_rays_.resize(simulation::work_per_rank);
+    }
+
+    // Rays are transported together in event-based mode, unless their
+    // segments are being recorded or replayed
+    if (settings::event_based && !record && !replay) {
+      total_geometric_intersections_ += transport_sweep_event_based();
+    } else {
+      // Transport sweep over all random rays for the iteration
 #pragma omp parallel for schedule(dynamic)                                     \
   reduction(+ : total_geometric_intersections_)
-    for (int i = 0; i < simulation::work_per_rank; i++) {
-      RandomRay ray(i, domain_.get());
-      total_geometric_intersections_ +=
-        ray.transport_history_based_single_ray();
+      for (int i = 0; i < simulation::work_per_rank; i++) {
+        if (replay) {
+          RandomRay ray;
+          total_geometric_intersections_ +=
+            ray.replay_cached_ray(cached_rays_[i], domain_.get());
+          continue;
+        }
+
+        RandomRay ray(i, domain_.get());
+        int64_t n;
+#pragma omp atomic read
+        n = n_segments;
+        if (record && n <= max_segments) {
+          ray.record_segments(&cached_rays_[i]);
+        }
+        total_geometric_intersections_ +=
+          ray.transport_history_based_single_ray();
+        if (record) {
+#pragma omp atomic
+          n_segments += cached_rays_[i].segments.size();
+        }
+      }
+    }
+
+    // Stop caching segments if they do not fit in memory rather than
+    // spilling them
+    if (record) {
+      cache_valid_ = n_segments <= max_segments;
+      if (!cache_valid_) {
+        warning("Ray segments exceed the memory given to cache them. All "
+                "rays will be traced through the geometry.");
+        cache_overflow_ = true;
+        vector<CachedRay>().swap(cached_rays_);
+      }
     }
 
+    // Add contributions that threads accumulated separately
+    domain_->reduce_thread_accumulators();
+
     simulation::time_transport.stop();
 
     // If using multiple MPI ranks, perform all reduce on all transport results
@@ -313,8 +446,16 @@ void RandomRaySimulation::simulate()
       global_tally_tracklength = k_eff_;
     }
 
-    // Execute all tallying tasks, if this is an active batch
-    if (simulation::current_batch > settings::n_inactive && mpi::master) {
+    // Extrapolate the scalar flux from previous iterations to converge the
+    // inactive iterations faster. The flux of active iterations is left alone
+    // so as not to correlate the accumulated estimates.
+    if (simulation::current_batch <= settings::n_inactive) {
+      domain_->accelerate_scalar_flux();
+    }
+
+    // Execute all tallying tasks, if this is an active batch. Each process
+    // maps and scores its own block of source regions.
+    if (simulation::current_batch > settings::n_inactive) {
 
       // Generate mapping between source regions and tallies
       if (!domain_->mapped_all_tallies_) {
@@ -325,7 +466,9 @@ void RandomRaySimulation::simulate()
       domain_->random_ray_tally();
 
       // Add this iteration's scalar flux estimate to final accumulated estimate
-      domain_->accumulate_iteration_flux();
+      if (mpi::master) {
+        domain_->accumulate_iteration_flux();
+      }
     }
 
     // Set phi_old = phi_new
@@ -340,6 +483,74 @@ void RandomRaySimulation::simulate()
   } // End random ray power iteration loop
 }
 
+// Transports all rays of the iteration with every ray in flight advancing one
+// segment at a time, so that each stage is applied to all rays before the
+// next. Finding segments and crossing surfaces only use the geometry. Between
+// them, the rays are ordered by the material of their segment so that the
+// cross sections of a material are read by consecutive attenuations. Returns
+// the number of segments.
+uint64_t RandomRaySimulation::transport_sweep_event_based()
+{
+  int64_t n_work = simulation::work_per_rank;
+  int64_t n_in_flight = std::min(n_work, settings::max_particles_in_flight);
+  vector<RandomRay> rays(n_in_flight);
+  vector<std::pair<int32_t, int64_t>> queue;
+  queue.reserve(n_in_flight);
+  uint64_t n_events = 0;
+
+  for (int64_t start = 0; start < n_work; start += n_in_flight) {
+    int64_t n = std::min(n_in_flight, n_work - start);
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < n; i++) {
+      rays[i].initialize_ray(start + i, domain_.get());
+    }
+    queue.clear();
+    for (int64_t i = 0; i < n; i++) {
+      if (rays[i].alive())
+        queue.emplace_back(0, i);
+    }
+
+    while (!queue.empty()) {
+      int64_t n_queue = queue.size();
+
+#pragma omp parallel for schedule(static)
+      for (int64_t k = 0; k < n_queue; k++) {
+        auto& ray = rays[queue[k].second];
+        ray.event_find_segment();
+        queue[k].first = ray.material();
+      }
+
+      std::sort(queue.begin(), queue.end());
+
+#pragma omp parallel for schedule(static)
+      for (int64_t k = 0; k < n_queue; k++) {
+        auto& ray = rays[queue[k].second];
+        if (!ray.alive())
+          continue;
+        ray.event_attenuate_segment();
+        ray.event_move_along_segment();
+      }
+
+#pragma omp parallel for schedule(static)
+      for (int64_t k = 0; k < n_queue; k++) {
+        auto& ray = rays[queue[k].second];
+        if (ray.alive() && !ray.mesh_crossed())
+          ray.event_cross_surface();
+      }
+
+      // Remove the rays that reached the end of their active length
+      queue.erase(std::remove_if(queue.begin(), queue.end(),
+                    [&rays](const auto& q) { return !rays[q.second].alive(); }),
+        queue.end());
+    }
+
+    for (int64_t i = 0; i < n; i++) {
+      n_events += rays[i].n_event();
+    }
+  }
+  return n_events;
+}
+
 void RandomRaySimulation::reduce_simulation_statistics()
 {
   // Reduce number of intersections
@@ -450,7 +661,11 @@ void RandomRaySimulation::print_results_random_ray(
 
     header("Timing Statistics", 4);
     show_time("Total time for initialization", time_initialize.elapsed());
+    show_time("Reading materials", time_read_materials.elapsed(), 1);
+    show_time("Reading geometry", time_read_geometry.elapsed(), 1);
+    show_time("Setting up geometry", time_setup_geometry.elapsed(), 1);
     show_time("Reading cross sections", time_read_xs.elapsed(), 1);
+    show_time("Preparing distributed cells", time_distribcell.elapsed(), 1);
     show_time("Total simulation time", time_total.elapsed());
     show_time("Transport sweep only", time_transport.elapsed(), 1);
     show_time("Source update only", time_update_src.elapsed(), 1);
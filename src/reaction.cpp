@@ -9,9 +9,11 @@
 #include "openmc/constants.h"
 #include "openmc/endf.h"
 #include "openmc/hdf5_interface.h"
+#include "openmc/message_passing.h"
 #include "openmc/random_lcg.h"
 #include "openmc/search.h"
 #include "openmc/secondary_uncorrelated.h"
+#include "openmc/xs_cache.h"
 
 namespace openmc {
 
@@ -36,6 +38,10 @@ Reaction::Reaction(hid_t group, const vector<int>& temperatures)
     redundant_ = false;
   }
 
+  // Name of the nuclide, used to find cross sections in the cache
+  std::string path = object_name(group);
+  std::string nuclide = path.substr(1, path.find('/', 1) - 1);
+
   // Read cross section and threshold_idx data
   for (auto t : temperatures) {
     // Get group corresponding to temperature
@@ -46,13 +52,24 @@ Reaction::Reaction(hid_t group, const vector<int>& temperatures)
     TemperatureXS xs;
     read_attribute(dset, "threshold_idx", xs.threshold);
 
-    // Read cross section values
-    read_dataset(dset, xs.value);
+    // Read cross section values unless they are in the cache, which only
+    // holds double precision values
+#ifdef OPENMC_SINGLE_PRECISION_XS
+    bool cached = false;
+#else
+    bool cached =
+      data::xs_cache.find(xs_cache_key(nuclide, mt_, t), xs.value) &&
+      xs.value.size() == object_shape(dset)[0];
+#endif
+    if (!cached)
+      read_dataset(dset, xs.storage);
     close_dataset(dset);
     close_group(temp_group);
 
     // create new entry in xs vector
     xs_.push_back(std::move(xs));
+    if (!cached)
+      xs_.back().value = xs_.back().storage;
   }
 
   // Read products
@@ -82,6 +99,15 @@ double Reaction::xs(const NuclideMicroXS& micro) const
   return this->xs(micro.index_temp, micro.index_grid, micro.interp_factor);
 }
 
+void Reaction::share_xs()
+{
+  for (auto& x : xs_) {
+    // Values in the cache are already shared through the page cache
+    if (!x.storage.empty())
+      x.value = mpi::share_on_node(x.storage);
+  }
+}
+
 double Reaction::collapse_rate(gsl::index i_temp,
   gsl::span<const double> energy, gsl::span<const double> flux,
   const vector<double>& grid) const
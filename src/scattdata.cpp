@@ -67,6 +67,33 @@ void ScattData::base_init(int order, const xt::xtensor<int, 1>& in_gmin,
       v.resize(order);
     }
   }
+
+  // Pack the outgoing group distributions for sampling
+  energy_cdf.clear();
+  energy_cdf_start.resize(groups + 1);
+  for (int gin = 0; gin < groups; gin++) {
+    energy_cdf_start[gin] = energy_cdf.size();
+    double prob = 0.;
+    for (auto e : energy[gin]) {
+      prob += e;
+      energy_cdf.push_back(prob);
+    }
+  }
+  energy_cdf_start[groups] = energy_cdf.size();
+
+  // Build alias tables for sampling the outgoing group in constant time. A
+  // row that could not be normalized is left empty and always gives the last
+  // group, as when searching the cumulative sums.
+  energy_alias.clear();
+  if (settings::mg_alias_sampling) {
+    energy_alias.resize(groups);
+    for (int gin = 0; gin < groups; gin++) {
+      int start = energy_cdf_start[gin];
+      int n = energy_cdf_start[gin + 1] - start;
+      if (n > 0 && energy_cdf[start + n - 1] > 0.)
+        energy_alias[gin].assign(energy[gin]);
+    }
+  }
 }
 
 //==============================================================================
@@ -167,16 +194,16 @@ void ScattData::base_combine(size_t max_order, size_t order_dim,
 
 void ScattData::sample_energy(int gin, int& gout, int& i_gout, uint64_t* seed)
 {
-  // Sample the outgoing group
-  double xi = prn(seed);
-  double prob = 0.;
-  i_gout = 0;
-  for (gout = gmin[gin]; gout < gmax[gin]; ++gout) {
-    prob += energy[gin][i_gout];
-    if (xi < prob)
-      break;
-    ++i_gout;
+  if (!energy_alias.empty() && !energy_alias[gin].prob().empty()) {
+    i_gout = energy_alias[gin].sample(seed);
+  } else {
+    // Search the cumulative sums. The last group is taken if none of the
+    // others is sampled.
+    double xi = prn(seed);
+    const double* cdf = energy_cdf.data() + energy_cdf_start[gin];
+    i_gout = std::upper_bound(cdf, cdf + gmax[gin] - gmin[gin], xi) - cdf;
   }
+  gout = gmin[gin] + i_gout;
 }
 
 //==============================================================================
@@ -747,14 +774,9 @@ void ScattDataTabular::sample(
   int NP = this->mu.shape()[0];
   double xi = prn(seed);
 
-  double c_k = dist[gin][i_gout][0];
-  int k;
-  for (k = 0; k < NP - 1; k++) {
-    double c_k1 = dist[gin][i_gout][k + 1];
-    if (xi < c_k1)
-      break;
-    c_k = c_k1;
-  }
+  const double* c = dist[gin][i_gout].data();
+  int k = std::upper_bound(c + 1, c + NP, xi) - (c + 1);
+  double c_k = c[k];
 
   // Check to make sure k is <= NP - 1
   k = std::min(k, NP - 2);
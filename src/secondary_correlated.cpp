@@ -1,6 +1,6 @@
 #include "openmc/secondary_correlated.h"
 
-#include <algorithm> // for copy
+#include <algorithm> // for copy, min
 #include <cmath>
 #include <cstddef>  // for size_t
 #include <iterator> // for back_inserter
@@ -12,6 +12,7 @@
 #include "openmc/hdf5_interface.h"
 #include "openmc/random_lcg.h"
 #include "openmc/search.h"
+#include "openmc/settings.h"
 
 namespace openmc {
 
@@ -111,6 +112,10 @@ CorrelatedAngleEnergy::CorrelatedAngleEnergy(hid_t group)
       d.c /= d.c[n - 1];
     }
 
+    if (settings::guide_table_cells > 0) {
+      d.guide = GuideTable(d.c, settings::guide_table_cells);
+    }
+
     for (j = 0; j < n; ++j) {
       // Get interpolation scheme
       int interp_mu = std::lround(eout(3, offsets[i] + j));
@@ -207,9 +212,19 @@ void CorrelatedAngleEnergy::sample(
     }
   }
 
-  // Continuous portion
+  // Continuous portion. A guide table gives a bin at which to start the
+  // search that is not past the bin containing the random number.
+  int j_start = n_discrete;
+  if (end > n_discrete && !distribution_[l].guide.empty()) {
+    int j_guide = distribution_[l].guide.start(r1);
+    if (j_guide > n_discrete) {
+      j_start = std::min(j_guide, end);
+      k = j_start;
+      c_k = distribution_[l].c[k];
+    }
+  }
   double c_k1;
-  for (int j = n_discrete; j < end; ++j) {
+  for (int j = j_start; j < end; ++j) {
     k = j;
     c_k1 = distribution_[l].c[k + 1];
     if (r1 < c_k1)
@@ -3,6 +3,7 @@
 #include "openmc/hdf5_interface.h"
 #include "openmc/random_lcg.h"
 #include "openmc/search.h"
+#include "openmc/settings.h"
 
 #include <gsl/gsl-lite.hpp>
 
@@ -225,6 +226,9 @@ IncoherentInelasticAE::IncoherentInelasticAE(hid_t group)
     d.e_out = edist.e_out;
     d.e_out_pdf = edist.p;
     d.e_out_cdf = edist.c;
+    if (settings::guide_table_cells > 0) {
+      d.e_out_guide = GuideTable(d.e_out_cdf, settings::guide_table_cells);
+    }
 
     for (int j = 0; j < d.n_e_out; ++j) {
       auto adist = dynamic_cast<Tabular*>(edist.angle[j].get());
@@ -260,10 +264,13 @@ void IncoherentInelasticAE::sample(
   // (First reset n_energy_out to the right value)
   auto n = distribution_[l].n_e_out;
   double r1 = prn(seed);
-  double c_j = distribution_[l].e_out_cdf[0];
+  std::size_t j = 0;
+  if (!distribution_[l].e_out_guide.empty()) {
+    j = distribution_[l].e_out_guide.start(r1);
+  }
+  double c_j = distribution_[l].e_out_cdf[j];
   double c_j1;
-  std::size_t j;
-  for (j = 0; j < n - 1; ++j) {
+  for (; j < n - 1; ++j) {
     c_j1 = distribution_[l].e_out_cdf[j + 1];
     if (r1 < c_j1)
       break;
@@ -18,6 +18,7 @@
 #include "openmc/eigenvalue.h"
 #include "openmc/error.h"
 #include "openmc/file_utils.h"
+#include "openmc/hdf5_interface.h"
 #include "openmc/mcpl_interface.h"
 #include "openmc/mesh.h"
 #include "openmc/message_passing.h"
@@ -29,6 +30,7 @@
 #include "openmc/source.h"
 #include "openmc/string_utils.h"
 #include "openmc/tallies/trigger.h"
+#include "openmc/tally_stream.h"
 #include "openmc/volume_calc.h"
 #include "openmc/weight_windows.h"
 #include "openmc/xml_interface.h"
@@ -44,36 +46,66 @@ namespace settings {
 // Default values for boolean flags
 bool assume_separate {false};
 bool check_overlaps {false};
+bool compact_micro_xs {false};
 bool cmfd_run {false};
 bool confidence_intervals {false};
 bool create_delayed_neutrons {true};
 bool create_fission_neutrons {true};
 bool delayed_photon_scaling {true};
+bool dry_run {false};
 bool entropy_on {false};
 bool event_based {false};
+bool event_autotune {false};
+bool event_queue_sort {false};
+bool event_secondary_queue {false};
+bool fission_matrix_on {false};
 bool legendre_to_tabular {true};
+bool load_balancing {false};
 bool material_cell_offsets {true};
+bool memory_report {false};
+bool mg_alias_sampling {false};
+bool neighbor_list_precompute {false};
+bool neighbor_list_reorder {false};
+bool numa_interleave {false};
 bool output_summary {true};
 bool output_tallies {true};
+OutputCompression output_compression {OutputCompression::none};
+int output_compression_level {4};
+int64_t output_chunk_size {1 << 20};
 bool particle_restart_run {false};
+bool pipeline_batches {false};
 bool photon_transport {false};
+bool profile {false};
 bool reduce_tallies {true};
+bool overlap_bank_sync {false};
+bool overlap_reduction {false};
+bool hierarchical_reduce {false};
 bool res_scat_on {false};
 bool restart_run {false};
 bool run_CE {true};
+bool shared_xs {false};
+bool simplify_regions {false};
 bool source_latest {false};
 bool source_separate {false};
+bool source_shards {false};
+bool source_domain_bounds {false};
+bool statepoint_async {false};
 bool source_write {true};
 bool source_mcpl_write {false};
 bool surf_source_write {false};
 bool surf_mcpl_write {false};
+bool surf_source_stream {false};
 bool surf_source_read {false};
+bool surface_distance_cache {false};
 bool survival_biasing {false};
+bool tally_stream {false};
 bool temperature_multipole {false};
+bool thread_stats {false};
 bool trigger_on {false};
 bool trigger_predict {false};
 bool ufs_on {false};
 bool urr_ptables_on {true};
+bool vectorized_xs {false};
 bool weight_windows_on {false};
 bool weight_window_checkpoint_surface {false};
 bool weight_window_checkpoint_collision {true};
@@ -81,12 +113,17 @@ bool write_all_tracks {false};
 bool write_initial_source {false};
 
 std::string path_cross_sections;
+std::string path_geometry_cache;
 std::string path_input;
 std::string path_output;
 std::string path_particle_restart;
 std::string path_sourcepoint;
 std::string path_statepoint;
+std::string path_telemetry;
 const char* path_statepoint_c {path_statepoint.c_str()};
+std::string path_xs_cache;
+std::string tally_stream_engine {"SST"};
+std::string tally_stream_name {"openmc-tallies"};
 std::string weight_windows_file;
 
 int32_t n_inactive {0};
@@ -98,10 +135,19 @@ int64_t n_particles {-1};
 
 int64_t max_particles_in_flight {100000};
 int max_particle_events {1000000};
+int64_t event_history_tail {0};
+int64_t event_thread_pool {0};
+int event_xs_queue_groups {0};
 
+vector<int32_t> delta_tracking_cells;
+bool electron_inline_deposition {false};
 ElectronTreatment electron_treatment {ElectronTreatment::TTB};
 array<double, 4> energy_cutoff {0.0, 1000.0, 0.0, 0.0};
 array<double, 4> time_cutoff {INFTY, INFTY, INFTY, INFTY};
+vector<double> census_times;
+vector<int32_t> tally_stream_ids;
+int guide_table_cells {0};
+bool inelastic_scatter_cdf {false};
 int legendre_to_tabular_points {C_NONE};
 int max_order {0};
 int n_log_bins {8000};
@@ -109,12 +155,22 @@ int n_batches;
 int n_max_batches;
 int max_history_splits {10'000'000};
 int max_tracks {1000};
+bool photon_material_xs {false};
+bool photon_only {false};
+bool photon_product_cdf {false};
+bool prune_nuclear_data {false};
+double photon_xs_tolerance {0.0};
+double ncrystal_xs_tolerance {0.0};
 ResScatMethod res_scat_method {ResScatMethod::rvs};
 double res_scat_energy_min {0.01};
 double res_scat_energy_max {1000.0};
 vector<std::string> res_scat_nuclides;
 RunMode run_mode {RunMode::UNSET};
 SolverType solver_type {SolverType::MONTE_CARLO};
+int source_convergence_min {0};
+double source_convergence_threshold {2.0};
+int source_convergence_window {0};
+ThreadAffinity thread_affinity {ThreadAffinity::NONE};
 std::unordered_set<int> sourcepoint_batch;
 std::unordered_set<int> statepoint_batch;
 std::unordered_set<int> source_write_surf_id;
@@ -122,17 +178,24 @@ int64_t max_surface_particles;
 int64_t ssw_cell_id {C_NONE};
 SSWCellType ssw_cell_type {SSWCellType::None};
 TemperatureMethod temperature_method {TemperatureMethod::NEAREST};
+double tally_private_memory {512.0};
+double track_buffer_memory {16.0};
 double temperature_tolerance {10.0};
 double temperature_default {293.6};
 array<double, 2> temperature_range {0.0, 0.0};
+int statepoint_delta {0};
 int trace_batch;
 int trace_gen;
 int64_t trace_particle;
 vector<array<int, 3>> track_identifiers;
 int trigger_batch_interval {1};
+double union_grid_memory {0.0};
 int verbosity {7};
+double warm_start_entropy_tolerance {0.0};
+int warm_start_inactive {-1};
 double weight_cutoff {0.25};
 double weight_survive {1.0};
+double wielandt_shift {0.0};
 
 } // namespace settings
 
@@ -300,6 +363,50 @@ void get_run_parameters(pugi::xml_node node_base)
       FlatSourceDomain::volume_normalized_flux_tallies_ =
         get_node_value_bool(random_ray_node, "volume_normalized_flux_tallies");
     }
+    if (check_for_node(random_ray_node, "segment_cache_iterations")) {
+      RandomRay::segment_cache_iterations_ =
+        std::stoi(get_node_value(random_ray_node, "segment_cache_iterations"));
+      if (RandomRay::segment_cache_iterations_ < 1) {
+        fatal_error("Random ray segment cache iterations must be at least 1");
+      }
+      if (RandomRay::segment_cache_iterations_ > 1 &&
+          RandomRay::source_shape_ != RandomRaySourceShape::FLAT) {
+        fatal_error("Random ray segments can only be cached with flat "
+                    "source regions");
+      }
+    }
+    if (check_for_node(random_ray_node, "segment_cache_memory")) {
+      RandomRay::segment_cache_memory_ =
+        std::stod(get_node_value(random_ray_node, "segment_cache_memory"));
+      if (RandomRay::segment_cache_memory_ <= 0.0) {
+        fatal_error("Random ray segment cache memory must be greater than 0");
+      }
+    }
+    if (check_for_node(random_ray_node, "adjoint")) {
+      FlatSourceDomain::adjoint_ =
+        get_node_value_bool(random_ray_node, "adjoint");
+    }
+    if (check_for_node(random_ray_node, "anderson_depth")) {
+      FlatSourceDomain::anderson_depth_ =
+        std::stoi(get_node_value(random_ray_node, "anderson_depth"));
+      if (FlatSourceDomain::anderson_depth_ < 0) {
+        fatal_error("Random ray Anderson acceleration depth must be "
+                    "non-negative");
+      }
+    }
+    if (check_for_node(random_ray_node, "source_region_mesh")) {
+      xml_node mesh_node = random_ray_node.child("source_region_mesh");
+      if (!check_for_node(mesh_node, "mesh")) {
+        fatal_error("No mesh specified for random ray source region mesh");
+      }
+      FlatSourceDomain::source_region_mesh_id_ =
+        std::stoi(get_node_value(mesh_node, "mesh"));
+      if (check_for_node(mesh_node, "cells")) {
+        for (auto id : get_node_array<int32_t>(mesh_node, "cells")) {
+          FlatSourceDomain::source_region_mesh_cells_.insert(id);
+        }
+      }
+    }
   }
 }
 
@@ -389,6 +496,11 @@ void read_settings_xml(pugi::xml_node root)
       // int gets you the largest negative integer, which is not what we want.
       max_order = std::numeric_limits<int>::max() - 1;
     }
+
+    // Alias tables for sampling outgoing groups
+    if (check_for_node(root, "mg_alias_sampling")) {
+      mg_alias_sampling = get_node_value_bool(root, "mg_alias_sampling");
+    }
   }
 
   // Check for a trigger node and get trigger information
@@ -433,6 +545,8 @@ void read_settings_xml(pugi::xml_node root)
         run_mode = RunMode::PARTICLE;
       } else if (temp_str == "volume") {
         run_mode = RunMode::VOLUME;
+      } else if (temp_str == "overlap check") {
+        run_mode = RunMode::OVERLAP_CHECK;
       } else {
         fatal_error("Unrecognized run mode: " + temp_str);
       }
@@ -484,6 +598,17 @@ void read_settings_xml(pugi::xml_node root)
     }
   }
 
+  // The overlap check traces as many rays as there are particles
+  if (run_mode == RunMode::OVERLAP_CHECK) {
+    if (n_particles == -1 && check_for_node(root, "particles")) {
+      n_particles = std::stoll(get_node_value(root, "particles"));
+    }
+    if (n_particles <= 0) {
+      fatal_error("Number of rays for the overlap check must be given with "
+                  "<particles> or the --particles option.");
+    }
+  }
+
   // Copy plotting random number seed if specified
   if (check_for_node(root, "plot_seed")) {
     auto seed = std::stoll(get_node_value(root, "plot_seed"));
@@ -508,6 +633,17 @@ void read_settings_xml(pugi::xml_node root)
     }
   }
 
+  // Deposit the energy of electrons at the collision creating them
+  if (check_for_node(root, "electron_inline_deposition")) {
+    electron_inline_deposition =
+      get_node_value_bool(root, "electron_inline_deposition");
+    if (electron_inline_deposition &&
+        electron_treatment != ElectronTreatment::LED) {
+      fatal_error("Inline electron deposition requires the local energy "
+                  "deposition electron treatment.");
+    }
+  }
+
   // Check for photon transport
   if (check_for_node(root, "photon_transport")) {
     photon_transport = get_node_value_bool(root, "photon_transport");
@@ -518,6 +654,35 @@ void read_settings_xml(pugi::xml_node root)
     }
   }
 
+  // Check for photon-only transport, which reads no neutron cross sections
+  if (check_for_node(root, "photon_only")) {
+    photon_only = get_node_value_bool(root, "photon_only");
+    if (photon_only) {
+      if (run_mode != RunMode::FIXED_SOURCE) {
+        fatal_error("Photon-only transport requires a fixed source "
+                    "calculation.");
+      }
+      if (!run_CE) {
+        fatal_error("Photon transport is not currently supported in "
+                    "multigroup mode");
+      }
+      photon_transport = true;
+    }
+  }
+
+  // Number of guide table cells for sampling tabulated distributions
+  if (check_for_node(root, "guide_table_cells")) {
+    guide_table_cells = std::stoi(get_node_value(root, "guide_table_cells"));
+    if (guide_table_cells < 0) {
+      fatal_error("Number of guide table cells must be non-negative.");
+    }
+  }
+
+  // Tabulate running sums of inelastic scattering cross sections
+  if (check_for_node(root, "inelastic_scatter_cdf")) {
+    inelastic_scatter_cdf = get_node_value_bool(root, "inelastic_scatter_cdf");
+  }
+
   // Number of bins for logarithmic grid
   if (check_for_node(root, "log_grid_bins")) {
     n_log_bins = std::stoi(get_node_value(root, "log_grid_bins"));
@@ -527,6 +692,74 @@ void read_settings_xml(pugi::xml_node root)
     }
   }
 
+  // Memory limit for thread-private tally results
+  if (check_for_node(root, "tally_private_memory")) {
+    tally_private_memory =
+      std::stod(get_node_value(root, "tally_private_memory"));
+    if (tally_private_memory < 0.0) {
+      fatal_error("Memory limit for thread-private tally results must be "
+                  "non-negative.");
+    }
+  }
+
+  // Memory limit for the tracks held by each thread
+  if (check_for_node(root, "track_buffer_memory")) {
+    track_buffer_memory =
+      std::stod(get_node_value(root, "track_buffer_memory"));
+    if (track_buffer_memory < 0.0) {
+      fatal_error("Memory limit for buffered particle tracks must be "
+                  "non-negative.");
+    }
+  }
+
+  // Memory limit for unionized energy grid
+  if (check_for_node(root, "union_grid_memory")) {
+    union_grid_memory = std::stod(get_node_value(root, "union_grid_memory"));
+    if (union_grid_memory < 0.0) {
+      fatal_error("Memory limit for unionized energy grid must be "
+                  "non-negative.");
+    }
+  }
+
+  // Tolerance of photon cross sections tabulated on a log-uniform grid
+  if (check_for_node(root, "photon_xs_tolerance")) {
+    photon_xs_tolerance =
+      std::stod(get_node_value(root, "photon_xs_tolerance"));
+    if (photon_xs_tolerance < 0.0) {
+      fatal_error("Tolerance of tabulated photon cross sections must be "
+                  "non-negative.");
+    }
+  }
+
+  // Tolerance of NCrystal cross sections tabulated on a log-uniform grid
+  if (check_for_node(root, "ncrystal_xs_tolerance")) {
+    ncrystal_xs_tolerance =
+      std::stod(get_node_value(root, "ncrystal_xs_tolerance"));
+    if (ncrystal_xs_tolerance < 0.0) {
+      fatal_error("Tolerance of tabulated NCrystal cross sections must be "
+                  "non-negative.");
+    }
+  }
+
+  // Tabulate macroscopic photon cross sections of each material
+  if (check_for_node(root, "photon_material_xs")) {
+    photon_material_xs = get_node_value_bool(root, "photon_material_xs");
+    if (photon_material_xs && photon_xs_tolerance <= 0.0) {
+      fatal_error("Tabulated material photon cross sections require a "
+                  "positive photon_xs_tolerance.");
+    }
+  }
+
+  // Tabulate running sums of photon production cross sections
+  if (check_for_node(root, "photon_product_cdf")) {
+    photon_product_cdf = get_node_value_bool(root, "photon_product_cdf");
+  }
+
+  // Free nuclear data that the settings and tallies cannot use
+  if (check_for_node(root, "prune_nuclear_data")) {
+    prune_nuclear_data = get_node_value_bool(root, "prune_nuclear_data");
+  }
+
   // Number of OpenMP threads
   if (check_for_node(root, "threads")) {
     if (mpi::master)
@@ -569,11 +802,79 @@ void read_settings_xml(pugi::xml_node root)
       UPtrDist {new Discrete(T, p, 1)}));
   }
 
+  // Sources whose particle type is known up front must emit photons when no
+  // neutron data is read
+  if (photon_only) {
+    for (const auto& source : model::external_sources) {
+      auto src = dynamic_cast<IndependentSource*>(source.get());
+      if (src && src->particle_type() != ParticleType::photon) {
+        fatal_error("All sources of a photon-only calculation must emit "
+                    "photons.");
+      }
+    }
+  }
+
+  // Check whether box sources are sampled within their domains
+  if (check_for_node(root, "source_domain_bounds")) {
+    source_domain_bounds = get_node_value_bool(root, "source_domain_bounds");
+  }
+
   // Check if we want to write out source
   if (check_for_node(root, "write_initial_source")) {
     write_initial_source = get_node_value_bool(root, "write_initial_source");
   }
 
+  // Check whether neighbor lists are filled before transport
+  if (check_for_node(root, "neighbor_list_precompute")) {
+    neighbor_list_precompute =
+      get_node_value_bool(root, "neighbor_list_precompute");
+  }
+
+  // Check whether neighbor lists are sorted by how often cells are found
+  if (check_for_node(root, "neighbor_list_reorder")) {
+    neighbor_list_reorder = get_node_value_bool(root, "neighbor_list_reorder");
+  }
+
+  // Check whether distances to surfaces are reused along a ray
+  if (check_for_node(root, "surface_distance_cache")) {
+    surface_distance_cache =
+      get_node_value_bool(root, "surface_distance_cache");
+  }
+
+  // Check whether the work done by each thread is recorded
+  if (check_for_node(root, "thread_stats")) {
+    thread_stats = get_node_value_bool(root, "thread_stats");
+  }
+
+  // Check how threads are pinned to cores
+  if (check_for_node(root, "thread_affinity")) {
+    auto temp_str = get_node_value(root, "thread_affinity", true, true);
+    if (temp_str == "none") {
+      thread_affinity = ThreadAffinity::NONE;
+    } else if (temp_str == "compact") {
+      thread_affinity = ThreadAffinity::COMPACT;
+    } else if (temp_str == "spread") {
+      thread_affinity = ThreadAffinity::SPREAD;
+    } else {
+      fatal_error("Unrecognized thread affinity: " + temp_str + ".");
+    }
+  }
+
+  // Check whether nuclear data pages are interleaved over NUMA nodes
+  if (check_for_node(root, "numa_interleave")) {
+    numa_interleave = get_node_value_bool(root, "numa_interleave");
+  }
+
+  // Check whether events are counted in each material, cell, and nuclide
+  if (check_for_node(root, "profile")) {
+    profile = get_node_value_bool(root, "profile");
+  }
+
+  // Check whether the memory used by each subsystem is reported
+  if (check_for_node(root, "memory_report")) {
+    memory_report = get_node_value_bool(root, "memory_report");
+  }
+
   // Survival biasing
   if (check_for_node(root, "survival_biasing")) {
     survival_biasing = get_node_value_bool(root, "survival_biasing");
@@ -584,6 +885,55 @@ void read_settings_xml(pugi::xml_node root)
     urr_ptables_on = get_node_value_bool(root, "ptables");
   }
 
+  // Vectorized cross section lookups
+  if (check_for_node(root, "vectorized_xs")) {
+    vectorized_xs = get_node_value_bool(root, "vectorized_xs");
+  }
+
+  // Cache of tabulated cross sections
+  if (check_for_node(root, "xs_cache")) {
+    path_xs_cache = get_node_value(root, "xs_cache");
+  }
+
+  // Cache of the distribcell offsets and neighbor lists of the geometry
+  if (check_for_node(root, "geometry_cache")) {
+    path_geometry_cache = get_node_value(root, "geometry_cache");
+  }
+
+  // File receiving a summary of each batch
+  if (check_for_node(root, "telemetry")) {
+    path_telemetry = get_node_value(root, "telemetry");
+  }
+
+  // Stream of tally results read by coupled codes while the run continues
+  if (check_for_node(root, "tally_stream")) {
+    if (!ADIOS2_ENABLED) {
+      fatal_error(
+        "Your build of OpenMC does not support streaming tally results.");
+    }
+    tally_stream = true;
+    xml_node node_ts = root.child("tally_stream");
+    if (check_for_node(node_ts, "engine")) {
+      tally_stream_engine = get_node_value(node_ts, "engine");
+    }
+    if (check_for_node(node_ts, "name")) {
+      tally_stream_name = get_node_value(node_ts, "name");
+    }
+    if (check_for_node(node_ts, "tally_ids")) {
+      tally_stream_ids = get_node_array<int32_t>(node_ts, "tally_ids");
+    }
+  }
+
+  // Cross sections shared by processes on a node
+  if (check_for_node(root, "shared_xs")) {
+    shared_xs = get_node_value_bool(root, "shared_xs");
+  }
+
+  // Simplification of cell regions as they are read
+  if (check_for_node(root, "simplify_regions")) {
+    simplify_regions = get_node_value_bool(root, "simplify_regions");
+  }
+
   // Cutoffs
   if (check_for_node(root, "cutoff")) {
     xml_node node_cutoff = root.child("cutoff");
@@ -627,6 +977,23 @@ void read_settings_xml(pugi::xml_node root)
     }
   }
 
+  // Census times at which the population of a fixed source calculation is
+  // combed back to the number of particles per batch
+  if (check_for_node(root, "census_times")) {
+    census_times = get_node_array<double>(root, "census_times");
+    if (run_mode != RunMode::FIXED_SOURCE ||
+        solver_type != SolverType::MONTE_CARLO) {
+      fatal_error("Census times may only be given for fixed source Monte "
+                  "Carlo calculations.");
+    }
+    for (int i = 0; i < census_times.size(); ++i) {
+      if (census_times[i] <= 0.0 ||
+          (i > 0 && census_times[i] <= census_times[i - 1])) {
+        fatal_error("Census times must be positive and increasing.");
+      }
+    }
+  }
+
   // Particle trace
   if (check_for_node(root, "trace")) {
     auto temp = get_node_array<int64_t>(root, "trace");
@@ -714,6 +1081,88 @@ void read_settings_xml(pugi::xml_node root)
       "it by specifying its ID in a <ufs_mesh> element.");
   }
 
+  // Fission matrix source acceleration mesh
+  if (check_for_node(root, "fission_matrix_mesh")) {
+    auto temp = std::stoi(get_node_value(root, "fission_matrix_mesh"));
+    if (model::mesh_map.find(temp) == model::mesh_map.end()) {
+      fatal_error(fmt::format(
+        "Mesh {} specified for the fission matrix does not exist.", temp));
+    }
+
+    auto* m =
+      dynamic_cast<RegularMesh*>(model::meshes[model::mesh_map.at(temp)].get());
+    if (!m)
+      fatal_error("Only regular meshes can be used as a fission matrix mesh");
+    simulation::fission_matrix_mesh = m;
+
+    // Turn on fission matrix source acceleration
+    fission_matrix_on = true;
+  }
+
+  // Check for a Wielandt shift of the eigenvalue
+  if (check_for_node(root, "wielandt_shift")) {
+    wielandt_shift = std::stod(get_node_value(root, "wielandt_shift"));
+    if (wielandt_shift < 0.0) {
+      fatal_error("Wielandt shift must be non-negative.");
+    }
+  }
+
+  // Check whether the inactive batches end once the source has converged
+  if (check_for_node(root, "source_convergence")) {
+    xml_node node_conv = root.child("source_convergence");
+    source_convergence_window = 10;
+    if (check_for_node(node_conv, "window")) {
+      source_convergence_window =
+        std::stoi(get_node_value(node_conv, "window"));
+      if (source_convergence_window < 4) {
+        fatal_error("Source convergence window must be at least four "
+                    "batches.");
+      }
+    }
+    if (check_for_node(node_conv, "min_inactive")) {
+      source_convergence_min =
+        std::stoi(get_node_value(node_conv, "min_inactive"));
+      if (source_convergence_min < 0) {
+        fatal_error("Minimum number of inactive batches must be "
+                    "non-negative.");
+      }
+    }
+    if (check_for_node(node_conv, "threshold")) {
+      source_convergence_threshold =
+        std::stod(get_node_value(node_conv, "threshold"));
+      if (source_convergence_threshold <= 0.0) {
+        fatal_error("Source convergence threshold must be positive.");
+      }
+    }
+    if (run_mode != RunMode::EIGENVALUE) {
+      warning("Source convergence is only tested in eigenvalue calculations.");
+    }
+  }
+
+  // Check whether each run starts from the source of the previous one
+  if (check_for_node(root, "warm_start")) {
+    simulation::persistent = true;
+    xml_node node_warm = root.child("warm_start");
+    if (check_for_node(node_warm, "inactive")) {
+      warm_start_inactive = std::stoi(get_node_value(node_warm, "inactive"));
+      if (warm_start_inactive < 0) {
+        fatal_error("Number of warm-start inactive batches must be "
+                    "non-negative.");
+      }
+    }
+    if (check_for_node(node_warm, "entropy_tolerance")) {
+      warm_start_entropy_tolerance =
+        std::stod(get_node_value(node_warm, "entropy_tolerance"));
+      if (warm_start_entropy_tolerance < 0.0) {
+        fatal_error("Warm-start entropy tolerance must be non-negative.");
+      }
+      if (!entropy_on && warm_start_entropy_tolerance > 0.0) {
+        warning("A warm-start entropy tolerance has no effect without a "
+                "Shannon entropy mesh.");
+      }
+    }
+  }
+
   // Check if the user has specified to write state points
   if (check_for_node(root, "state_point")) {
 
@@ -731,6 +1180,25 @@ void read_settings_xml(pugi::xml_node root)
       // If neither were specified, write state point at last batch
       statepoint_batch.insert(n_batches);
     }
+
+    if (check_for_node(node_sp, "delta")) {
+      statepoint_delta = std::stoi(get_node_value(node_sp, "delta"));
+      if (statepoint_delta < 0) {
+        fatal_error("Number of delta state points must be non-negative.");
+      }
+    }
+
+    if (check_for_node(node_sp, "async")) {
+      statepoint_async = get_node_value_bool(node_sp, "async");
+#ifdef PHDF5
+      // State points are written collectively by all processes
+      if (statepoint_async) {
+        warning("State points cannot be written asynchronously with parallel "
+                "HDF5.");
+        statepoint_async = false;
+      }
+#endif
+    }
   } else {
     // If no <state_point> tag was present, by default write state point at
     // last batch only
@@ -770,6 +1238,16 @@ void read_settings_xml(pugi::xml_node root)
           "Your build of OpenMC does not support writing MCPL source files.");
       }
     }
+    if (check_for_node(node_sp, "sharded")) {
+      source_shards = get_node_value_bool(node_sp, "sharded");
+#ifdef PHDF5
+      // Source files are already written collectively by all processes
+      if (source_shards) {
+        warning("Sharded source files are not used with parallel HDF5.");
+        source_shards = false;
+      }
+#endif
+    }
     if (check_for_node(node_sp, "overwrite_latest")) {
       source_latest = get_node_value_bool(node_sp, "overwrite_latest");
       source_separate = source_latest;
@@ -797,10 +1275,20 @@ void read_settings_xml(pugi::xml_node root)
       }
     }
 
-    // Get maximum number of particles to be banked per surface
+    // Check whether banked particles are written to the file as they are
+    // banked rather than at the end of the simulation
+    if (check_for_node(node_ssw, "streaming")) {
+      surf_source_stream = get_node_value_bool(node_ssw, "streaming");
+    }
+
+    // Get maximum number of particles to be banked per surface. There is no
+    // limit on the number of particles that are streamed to the file unless
+    // one is given.
     if (check_for_node(node_ssw, "max_particles")) {
       max_surface_particles =
         std::stoll(get_node_value(node_ssw, "max_particles"));
+    } else if (surf_source_stream) {
+      max_surface_particles = 0;
     } else {
       fatal_error("A maximum number of particles needs to be specified "
                   "using the 'max_particles' parameter to store surface "
@@ -857,6 +1345,26 @@ void read_settings_xml(pugi::xml_node root)
     reduce_tallies = !get_node_value_bool(root, "no_reduce");
   }
 
+  // Check if tally reduction should overlap with transport of the next batch
+  if (check_for_node(root, "overlap_reduction")) {
+    overlap_reduction = get_node_value_bool(root, "overlap_reduction");
+  }
+
+  // Check if reductions should first sum the values on each node
+  if (check_for_node(root, "hierarchical_reduce")) {
+    hierarchical_reduce = get_node_value_bool(root, "hierarchical_reduce");
+  }
+
+  // Check if the fission bank exchange should overlap with transport
+  if (check_for_node(root, "overlap_bank_sync")) {
+    overlap_bank_sync = get_node_value_bool(root, "overlap_bank_sync");
+  }
+
+  // Check if the end of each batch should be completed during the next one
+  if (check_for_node(root, "pipeline_batches")) {
+    pipeline_batches = get_node_value_bool(root, "pipeline_batches");
+  }
+
   // Check if the user has specified to use confidence intervals for
   // uncertainties rather than standard deviations
   if (check_for_node(root, "confidence_intervals")) {
@@ -885,6 +1393,45 @@ void read_settings_xml(pugi::xml_node root)
         path_output += "/";
       }
     }
+
+    // Compression of large HDF5 datasets
+    if (check_for_node(node_output, "compression")) {
+      auto filter = get_node_value(node_output, "compression", true, true);
+      if (filter == "none") {
+        output_compression = OutputCompression::none;
+      } else if (filter == "deflate") {
+        output_compression = OutputCompression::deflate;
+      } else if (filter == "szip") {
+        output_compression = OutputCompression::szip;
+      } else if (filter == "zstd") {
+        output_compression = OutputCompression::zstd;
+      } else {
+        fatal_error("Unrecognized output compression filter: " + filter);
+      }
+      if (!compression_available(output_compression)) {
+        fatal_error(fmt::format(
+          "The HDF5 library cannot apply the {} compression filter.", filter));
+      }
+    }
+    if (output_compression == OutputCompression::zstd) {
+      output_compression_level = 3;
+    }
+    if (check_for_node(node_output, "compression_level")) {
+      output_compression_level =
+        std::stoi(get_node_value(node_output, "compression_level"));
+      int max_level = output_compression == OutputCompression::zstd ? 22 : 9;
+      if (output_compression_level < 0 ||
+          output_compression_level > max_level) {
+        fatal_error(fmt::format(
+          "Output compression level must be between 0 and {}.", max_level));
+      }
+    }
+    if (check_for_node(node_output, "chunk_size")) {
+      output_chunk_size = std::stoll(get_node_value(node_output, "chunk_size"));
+      if (output_chunk_size <= 0) {
+        fatal_error("Output chunk size must be positive.");
+      }
+    }
   }
 
   // Resonance scattering parameters
@@ -1018,11 +1565,63 @@ void read_settings_xml(pugi::xml_node root)
       get_node_value_bool(root, "delayed_photon_scaling");
   }
 
+  // Check whether to use a compact microscopic cross section cache
+  if (check_for_node(root, "compact_micro_xs")) {
+    compact_micro_xs = get_node_value_bool(root, "compact_micro_xs");
+  }
+
   // Check whether to use event-based parallelism
   if (check_for_node(root, "event_based")) {
     event_based = get_node_value_bool(root, "event_based");
   }
 
+  // Check whether each thread should use its own pool of particles for
+  // event-based transport
+  if (check_for_node(root, "event_thread_pool")) {
+    event_thread_pool = std::stoll(get_node_value(root, "event_thread_pool"));
+    if (event_thread_pool < 0) {
+      fatal_error("Event-based thread pool size must be non-negative.");
+    }
+  }
+
+  // Check when to hand the tail of event-based transport to history-based
+  if (check_for_node(root, "event_history_tail")) {
+    event_history_tail = std::stoll(get_node_value(root, "event_history_tail"));
+    if (event_history_tail < 0) {
+      fatal_error("Event-based history tail threshold must be non-negative.");
+    }
+  }
+
+  // Check how to partition cross section event queues by material
+  if (check_for_node(root, "event_xs_queue_groups")) {
+    event_xs_queue_groups =
+      std::stoi(get_node_value(root, "event_xs_queue_groups"));
+    if (event_xs_queue_groups < 0) {
+      fatal_error("Number of cross section event queue groups must be "
+                  "non-negative.");
+    }
+  }
+
+  // Check whether to sort cross section event queues
+  if (check_for_node(root, "event_queue_sort")) {
+    event_queue_sort = get_node_value_bool(root, "event_queue_sort");
+  }
+
+  // Check whether to pass secondaries between slots of the particle buffer
+  if (check_for_node(root, "event_secondary_queue")) {
+    event_secondary_queue = get_node_value_bool(root, "event_secondary_queue");
+  }
+
+  // Check whether to tune event-based transport in the first batches
+  if (check_for_node(root, "event_autotune")) {
+    event_autotune = get_node_value_bool(root, "event_autotune");
+  }
+
+  // Check whether to rebalance particles across MPI ranks between batches
+  if (check_for_node(root, "load_balancing")) {
+    load_balancing = get_node_value_bool(root, "load_balancing");
+  }
+
   // Check whether material cell offsets should be generated
   if (check_for_node(root, "material_cell_offsets")) {
     material_cell_offsets = get_node_value_bool(root, "material_cell_offsets");
@@ -1076,6 +1675,17 @@ void read_settings_xml(pugi::xml_node root)
     }
   }
 
+  // Cells in which neutrons are transported with delta tracking
+  if (check_for_node(root, "delta_tracking_cells")) {
+    delta_tracking_cells =
+      get_node_array<int32_t>(root, "delta_tracking_cells");
+  }
+
+  // Exponential transforms
+  for (pugi::xml_node node_et : root.children("exponential_transform")) {
+    variance_reduction::exponential_transforms.emplace_back(node_et);
+  }
+
   // Set up weight window checkpoints
   if (check_for_node(root, "weight_window_checkpoints")) {
     xml_node ww_checkpoints = root.child("weight_window_checkpoints");
@@ -1096,6 +1706,7 @@ void free_memory_settings()
   settings::sourcepoint_batch.clear();
   settings::source_write_surf_id.clear();
   settings::res_scat_nuclides.clear();
+  settings::delta_tracking_cells.clear();
 }
 
 //==============================================================================
@@ -1,27 +1,40 @@
 #include "openmc/simulation.h"
 
+#include "openmc/autotune.h"
 #include "openmc/bank.h"
 #include "openmc/capi.h"
+#include "openmc/cell.h"
+#include "openmc/census.h"
 #include "openmc/container_util.h"
+#include "openmc/delta_tracking.h"
 #include "openmc/eigenvalue.h"
 #include "openmc/error.h"
 #include "openmc/event.h"
 #include "openmc/geometry_aux.h"
 #include "openmc/material.h"
 #include "openmc/mcpl_interface.h"
+#include "openmc/memory_report.h"
 #include "openmc/message_passing.h"
 #include "openmc/nuclide.h"
+#include "openmc/openmp_interface.h"
 #include "openmc/output.h"
 #include "openmc/particle.h"
 #include "openmc/photon.h"
+#include "openmc/profile.h"
 #include "openmc/random_lcg.h"
 #include "openmc/settings.h"
 #include "openmc/source.h"
 #include "openmc/state_point.h"
+#include "openmc/surf_source_stream.h"
 #include "openmc/tallies/derivative.h"
 #include "openmc/tallies/filter.h"
+#include "openmc/tallies/reaction_rates.h"
 #include "openmc/tallies/tally.h"
 #include "openmc/tallies/trigger.h"
+#include "openmc/tally_stream.h"
+#include "openmc/telemetry.h"
+#include "openmc/thread_stats.h"
+#include "openmc/trace.h"
 #include "openmc/timer.h"
 #include "openmc/track_output.h"
 #include "openmc/weight_windows.h"
@@ -40,6 +53,9 @@
 #include <algorithm>
 #include <cmath>
 #include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility> // for make_pair
 
 //==============================================================================
 // C API functions
@@ -61,8 +77,9 @@ int openmc_run()
     status = openmc::STATUS_EXIT_MAX_BATCH;
   }
 
+  // A dry run stops once the memory allocated by initialization is reported
   int err = 0;
-  while (status == 0 && err == 0) {
+  while (status == 0 && err == 0 && !openmc::settings::dry_run) {
     err = openmc_next_batch(&status);
   }
 
@@ -84,11 +101,42 @@ int openmc_simulation_init()
     initialize_data();
   }
 
+  // Build the majorant cross sections of delta-tracking regions
+  init_delta_tracking();
+
+  // Restrict the sampling of external sources to their domains
+  init_source_domains();
+
   // Determine how much work each process should do
   calculate_work();
 
+  // A source kept from the previous simulation can only be used if every
+  // process transports as many particles as before
+  if (simulation::source_kept) {
+    bool same_size =
+      simulation::source_bank.size() == simulation::work_per_rank;
+#ifdef OPENMC_MPI
+    MPI_Allreduce(
+      MPI_IN_PLACE, &same_size, 1, MPI_C_BOOL, MPI_LAND, mpi::intracomm);
+#endif
+    simulation::source_kept = same_size;
+  }
+
   // Allocate source, fission and surface source banks.
   allocate_banks();
+  init_history_sums();
+  init_census();
+
+  // Determine the size needed for compact microscopic cross section caches
+  model::max_material_nuclides = 0;
+  for (const auto& mat : model::materials) {
+    model::max_material_nuclides = std::max(
+      model::max_material_nuclides, static_cast<int>(mat->nuclide_.size()));
+  }
+
+  // Find tallies that can share filter bin combinations. This needs to happen
+  // before any particles are created.
+  setup_filter_groups();
 
   // Create track file if needed
   if (!settings::track_identifiers.empty() || settings::write_all_tracks) {
@@ -96,29 +144,40 @@ int openmc_simulation_init()
   }
 
   // If doing an event-based simulation, intialize the particle buffer
-  // and event queues
-  if (settings::event_based) {
+  // and event queues. When each thread has its own pool of particles, the
+  // shared buffer and queues are not needed.
+  if (settings::event_based && settings::event_thread_pool == 0) {
     int64_t event_buffer_length =
       std::min(simulation::work_per_rank, settings::max_particles_in_flight);
     init_event_queues(event_buffer_length);
   }
 
+  // Set up the configurations of event-based transport to try
+  init_autotune();
+
   // Allocate tally results arrays if they're not allocated yet
   for (auto& t : model::tallies) {
     t->set_strides();
     t->init_results();
   }
+  setup_pulse_height_tallies();
 
   // Set up material nuclide index mapping
   for (auto& mat : model::materials) {
     mat->init_nuclide_index();
   }
+  init_material_derivs();
 
   // Reset global variables -- this is done before loading state point (as that
   // will potentially populate k_generation and entropy)
   simulation::current_batch = 0;
   simulation::k_generation.clear();
   simulation::entropy.clear();
+  simulation::fission_matrix.clear();
+  simulation::fission_matrix_source.clear();
+  simulation::fission_matrix_vector.clear();
+  reset_thread_stats();
+  reset_profile();
   openmc_reset();
 
   // If this is a restart run, load the state point data and binary source
@@ -130,10 +189,18 @@ int openmc_simulation_init()
     // Only initialize primary source bank for eigenvalue simulations
     if (settings::run_mode == RunMode::EIGENVALUE &&
         settings::solver_type == SolverType::MONTE_CARLO) {
-      initialize_source();
+      if (simulation::source_kept) {
+        write_message("Using source from the previous simulation...", 5);
+      } else {
+        initialize_source();
+      }
     }
   }
 
+  // Shorten the inactive batches when starting from the previous source
+  save_batch_counts();
+  begin_warm_start();
+
   // Display header
   if (mpi::master) {
     if (settings::run_mode == RunMode::FIXED_SOURCE) {
@@ -158,6 +225,22 @@ int openmc_simulation_init()
     openmc_weight_windows_import(settings::weight_windows_file.c_str());
   }
 
+  // Index the weight windows by the domain of their meshes
+  variance_reduction::ww_index.build();
+
+  // Open the file receiving a summary of each batch
+  open_telemetry();
+
+  // Open the stream of tally results read by coupled codes
+  open_tally_stream();
+
+  // The memory of a random ray solve is reported once its source regions are
+  // set up
+  if ((settings::memory_report || settings::dry_run) &&
+      settings::solver_type == SolverType::MONTE_CARLO) {
+    print_memory_report("Memory Use After Initialization");
+  }
+
   // Set flag indicating initialization is done
   simulation::initialized = true;
   return 0;
@@ -175,6 +258,24 @@ int openmc_simulation_finalize()
   simulation::time_active.stop();
   simulation::time_finalize.start();
 
+  // Complete any work deferred from the last batch, tally reduction and source
+  // site exchange still in progress
+  finish_pipelined_batch();
+  finish_tally_reduction();
+  finish_bank_synchronization();
+
+  // Write the sites left in the buffers of a streamed surface source and wait
+  // for a state point written in the background
+  close_surf_source_stream();
+  finish_statepoint_write();
+
+  // The source bank now holds the fission source of the last generation,
+  // which a persistent simulation uses as the initial source of the next one
+  simulation::source_kept = simulation::persistent &&
+                            settings::run_mode == RunMode::EIGENVALUE &&
+                            settings::solver_type == SolverType::MONTE_CARLO &&
+                            simulation::current_batch > 0;
+
   // Clear material nuclide mapping
   for (auto& mat : model::materials) {
     mat->mat_nuclide_index_.clear();
@@ -190,15 +291,33 @@ int openmc_simulation_finalize()
 
 #ifdef OPENMC_MPI
   broadcast_results();
+
+  // Sum cross section reuse statistics over all processes
+  int64_t n_xs[] {
+    simulation::n_xs_temperature_hits, simulation::n_xs_temperature_misses};
+  MPI_Reduce(mpi::master ? MPI_IN_PLACE : n_xs, n_xs, 2, MPI_INT64_T, MPI_SUM,
+    0, mpi::intracomm);
+  if (mpi::master) {
+    simulation::n_xs_temperature_hits = n_xs[0];
+    simulation::n_xs_temperature_misses = n_xs[1];
+  }
 #endif
 
+  // Collect the work done by each thread on the master
+  vector<int> n_threads;
+  auto thread_stats = gather_thread_stats(n_threads);
+
+  // Write the counts of events in each material, cell, and nuclide
+  write_profile();
+
   // Write tally results to tallies.out
-  if (settings::output_tallies && mpi::master)
+  if (settings::output_tallies && mpi::master && !settings::dry_run)
     write_tallies();
 
   // If weight window generators are present in this simulation,
   // write a weight windows file
-  if (variance_reduction::weight_windows_generators.size() > 0) {
+  if (variance_reduction::weight_windows_generators.size() > 0 &&
+      !settings::dry_run) {
     openmc_weight_windows_export();
   }
 
@@ -206,14 +325,21 @@ int openmc_simulation_finalize()
   for (auto& t : model::tallies) {
     t->active_ = false;
   }
+  simulation::reaction_rates.active_ = false;
 
   // Stop timers and show timing statistics
   simulation::time_finalize.stop();
   simulation::time_total.stop();
-  if (mpi::master) {
+  if (settings::memory_report &&
+      settings::solver_type == SolverType::MONTE_CARLO && !settings::dry_run) {
+    print_memory_report("Memory Use at End of Simulation");
+  }
+  if (mpi::master && !settings::dry_run) {
     if (settings::solver_type != SolverType::RANDOM_RAY) {
-      if (settings::verbosity >= 6)
+      if (settings::verbosity >= 6) {
         print_runtime();
+        print_thread_stats(thread_stats);
+      }
       if (settings::verbosity >= 4)
         print_results();
     }
@@ -221,11 +347,27 @@ int openmc_simulation_finalize()
   if (settings::check_overlaps)
     print_overlap_check();
 
-  // Reset flags
+  // Write the ranges recorded for profilers when built with tracing
+  write_trace();
+  close_telemetry();
+  close_tally_stream();
+
+  // Reset flags and the batches shortened once the source has converged
+  restore_batch_counts();
   simulation::initialized = false;
   return 0;
 }
 
+int openmc_simulation_set_persistent(bool persistent)
+{
+  using namespace openmc;
+
+  simulation::persistent = persistent;
+  if (!persistent)
+    simulation::source_kept = false;
+  return 0;
+}
+
 int openmc_next_batch(int* status)
 {
   using namespace openmc;
@@ -248,12 +390,28 @@ int openmc_next_batch(int* status)
     // Start timer for transport
     simulation::time_transport.start();
 
-    // Transport loop
-    if (settings::event_based) {
-      transport_event_based();
-    } else {
-      transport_history_based();
-    }
+    // Complete the work left from the end of the last batch while the first
+    // generation is transported
+    if (current_gen == 1)
+      start_pipelined_batch();
+
+    // Transport loop, over each time step of a time census
+    do {
+      if (settings::event_based) {
+        if (settings::event_thread_pool > 0) {
+          transport_event_based_thread_pool();
+        } else {
+          transport_event_based();
+        }
+      } else {
+        transport_history_based();
+      }
+
+      // Tallies and the source bank may only change once the helper thread is
+      // done with them
+      if (simulation::census_step == 0)
+        finish_pipelined_batch();
+    } while (census_population_control());
 
     // Accumulate time for transport
     simulation::time_transport.stop();
@@ -305,18 +463,29 @@ double k_col_tra {0.0};
 double k_abs_tra {0.0};
 double log_spacing;
 int n_lost_particles {0};
+int64_t n_xs_temperature_hits {0};
+int64_t n_xs_temperature_misses {0};
 bool need_depletion_rx {false};
+bool persistent {false};
+bool need_element_photon_xs {false};
 int restart_batch;
 bool satisfy_triggers {false};
+bool source_kept {false};
 int total_gen {0};
+double time_transport_balanced {0.0};
+double time_transport_batch {0.0};
 double total_weight;
+double wielandt_weight;
 int64_t work_per_rank;
 
 const RegularMesh* entropy_mesh {nullptr};
 const RegularMesh* ufs_mesh {nullptr};
+const RegularMesh* fission_matrix_mesh {nullptr};
 
 vector<double> k_generation;
 vector<int64_t> work_index;
+vector<double> load_imbalance;
+vector<HistorySums> history_sums;
 
 } // namespace simulation
 
@@ -336,16 +505,46 @@ void allocate_banks()
   }
 
   if (settings::surf_source_write) {
-    // Allocate surface source bank
-    simulation::surf_source_bank.reserve(settings::max_surface_particles);
+    if (settings::surf_source_stream) {
+      // Sites are written to the file as they are banked
+      open_surf_source_stream();
+    } else {
+      // Allocate surface source bank
+      simulation::surf_source_bank.reserve(settings::max_surface_particles);
+    }
+  }
+}
+
+void init_history_sums()
+{
+  simulation::history_sums.assign(num_threads(), HistorySums {});
+}
+
+void reduce_history_sums()
+{
+  for (auto& sums : simulation::history_sums) {
+    global_tally_absorption += sums.absorption;
+    global_tally_collision += sums.collision;
+    global_tally_tracklength += sums.tracklength;
+    global_tally_leakage += sums.leakage;
+    simulation::total_weight += sums.source_weight;
+    simulation::wielandt_weight += sums.wielandt_weight;
+    simulation::n_xs_temperature_hits += sums.xs_temperature_hits;
+    simulation::n_xs_temperature_misses += sums.xs_temperature_misses;
+    sums = HistorySums {};
   }
 }
 
 void initialize_batch()
 {
+  TraceRange trace {"initialize_batch"};
+
   // Increment current batch
   ++simulation::current_batch;
 
+  // Try the next configuration of event-based transport
+  autotune_initialize_batch();
+
   if (settings::run_mode == RunMode::FIXED_SOURCE) {
     if (settings::solver_type == SolverType::RANDOM_RAY &&
         simulation::current_batch < settings::n_inactive + 1) {
@@ -359,6 +558,9 @@ void initialize_batch()
   // Reset total starting particle weight used for normalizing tallies
   simulation::total_weight = 0.0;
 
+  // Transport time at the start of the batch, for figures of merit
+  simulation::time_transport_batch = simulation::time_transport.elapsed();
+
   // Determine if this batch is the first inactive or active batch.
   bool first_inactive = false;
   bool first_active = false;
@@ -379,65 +581,90 @@ void initialize_batch()
     for (auto& t : model::tallies) {
       t->active_ = true;
     }
+    simulation::reaction_rates.active_ =
+      simulation::reaction_rates.configured();
   }
 
   // Add user tallies to active tallies list
   setup_active_tallies();
 }
 
-void finalize_batch()
-{
-  // Reduce tallies onto master process and accumulate
-  simulation::time_tallies.start();
-  accumulate_tallies();
-  simulation::time_tallies.stop();
+namespace {
 
-  // update weight windows if needed
-  for (const auto& wwg : variance_reduction::weight_windows_generators) {
-    wwg->update();
-  }
+//! Work at the end of a batch that is deferred so that it can be completed on
+//! a helper thread while the first generation of the next batch is transported
+struct PipelinedBatch {
+  bool pending {false};
+  int batch;              //!< Batch that the work belongs to
+  bool tallies {false};   //!< Whether tally accumulation was deferred
+  bool files {false};     //!< Whether writing output files was deferred
+  std::thread helper;     //!< Thread completing the work, if started
+};
 
-  // Reset global tally results
-  if (simulation::current_batch <= settings::n_inactive) {
-    xt::view(simulation::global_tallies, xt::all()) = 0.0;
-    simulation::n_realizations = 0;
-  }
+PipelinedBatch pipelined_batch;
 
-  // Check_triggers
-  if (mpi::master)
-    check_triggers();
-#ifdef OPENMC_MPI
-  MPI_Bcast(&simulation::satisfy_triggers, 1, MPI_C_BOOL, 0, mpi::intracomm);
-#endif
-  if (simulation::satisfy_triggers ||
-      (settings::trigger_on &&
-        simulation::current_batch == settings::n_max_batches)) {
-    settings::statepoint_batch.insert(simulation::current_batch);
+//! Whether the work at the end of the current batch can be completed while the
+//! next batch is transported. Tally results must be complete at the end of a
+//! batch for triggers, CMFD, figures of merit and weight window generation.
+bool pipeline_batch()
+{
+  return settings::pipeline_batches &&
+         settings::solver_type == SolverType::MONTE_CARLO &&
+         simulation::current_batch < settings::n_batches &&
+         !settings::trigger_on && !settings::cmfd_run &&
+         !figures_of_merit_needed() &&
+         variance_reduction::weight_windows_generators.empty() &&
+         (settings::reduce_tallies || mpi::n_procs == 1);
+}
+
+//! Whether output files of the current batch can be written while the next
+//! batch is transported. The writes may not communicate with other processes
+//! or use HDF5 at the same time as transport, and tallies have to be written
+//! from the state they are in at the end of the batch. Streamed tallies are
+//! read whole, including the values being scored in the next batch.
+bool pipeline_files()
+{
+  if (mpi::n_procs > 1 || settings::write_all_tracks ||
+      !settings::track_identifiers.empty() || settings::surf_source_stream ||
+      settings::tally_stream ||
+      simulation::current_batch == settings::n_inactive)
+    return false;
+  for (const auto& t : model::tallies) {
+    if (t->sparse_storage())
+      return false;
   }
+  return true;
+}
+
+//! Write the state point and source files requested for a batch
+void write_batch_files(int batch)
+{
+  // Hand the results of the batch to readers of the tally stream
+  write_tally_stream(batch);
 
   // Write out state point if it's been specified for this batch and is not
   // a CMFD run instance
-  if (contains(settings::statepoint_batch, simulation::current_batch) &&
-      !settings::cmfd_run) {
-    if (contains(settings::sourcepoint_batch, simulation::current_batch) &&
+  if (contains(settings::statepoint_batch, batch) && !settings::cmfd_run) {
+    if (contains(settings::sourcepoint_batch, batch) &&
         settings::source_write && !settings::source_separate) {
       bool b = (settings::run_mode == RunMode::EIGENVALUE);
-      openmc_statepoint_write(nullptr, &b);
+      write_state_point(nullptr, &b, batch);
     } else {
       bool b = false;
-      openmc_statepoint_write(nullptr, &b);
+      write_state_point(nullptr, &b, batch);
     }
   }
 
   if (settings::run_mode == RunMode::EIGENVALUE) {
     // Write out a separate source point if it's been specified for this batch
-    if (contains(settings::sourcepoint_batch, simulation::current_batch) &&
+    if (contains(settings::sourcepoint_batch, batch) &&
         settings::source_write && settings::source_separate) {
+      finish_bank_synchronization();
 
       // Determine width for zero padding
       int w = std::to_string(settings::n_max_batches).size();
-      std::string source_point_filename = fmt::format("{0}source.{1:0{2}}",
-        settings::path_output, simulation::current_batch, w);
+      std::string source_point_filename = fmt::format(
+        "{0}source.{1:0{2}}", settings::path_output, batch, w);
       gsl::span<SourceSite> bankspan(simulation::source_bank);
       if (settings::source_mcpl_write) {
         write_mcpl_source_point(
@@ -450,6 +677,7 @@ void finalize_batch()
 
     // Write a continously-overwritten source point if requested.
     if (settings::source_latest) {
+      finish_bank_synchronization();
 
       // note: correct file extension appended automatically
       auto filename = settings::path_output + "source";
@@ -462,10 +690,138 @@ void finalize_batch()
       }
     }
   }
+}
+
+//! Complete the deferred work of the last batch on the calling thread
+void run_pipelined_batch()
+{
+  auto& pb = pipelined_batch;
+  simulation::time_pipeline.start();
+  if (pb.tallies) {
+    simulation::time_tallies.start();
+    accumulate_deferred_tallies();
+    simulation::time_tallies.stop();
+  }
+  if (pb.files)
+    write_batch_files(pb.batch);
+  simulation::time_pipeline.stop();
+}
+
+} // namespace
+
+void start_pipelined_batch()
+{
+  auto& pb = pipelined_batch;
+  if (!pb.pending || pb.helper.joinable())
+    return;
+
+  pb.helper = std::thread([] {
+#ifdef _OPENMP
+    // Leave the cores to the threads transporting particles
+    omp_set_num_threads(1);
+#endif
+    run_pipelined_batch();
+  });
+}
+
+void finish_pipelined_batch()
+{
+  auto& pb = pipelined_batch;
+  if (!pb.pending)
+    return;
+
+  if (pb.helper.joinable()) {
+    simulation::time_pipeline_wait.start();
+    pb.helper.join();
+    simulation::time_pipeline_wait.stop();
+  } else {
+    run_pipelined_batch();
+  }
+  pb.pending = false;
+}
+
+void finalize_batch()
+{
+  TraceRange trace {"finalize_batch"};
+
+  // Measure the rate of the configuration of event-based transport tried
+  autotune_finalize_batch();
+
+  // End the inactive batches early once the source has converged
+  check_warm_start_convergence();
+  check_source_convergence();
+
+  // Decide whether tally accumulation and output files can be completed while
+  // the next batch is transported
+  bool pipelined = pipeline_batch();
+  bool pipelined_files = pipelined && pipeline_files();
+
+  // Reduce tallies onto master process and accumulate
+  simulation::time_tallies.start();
+  accumulate_tallies(pipelined);
+  simulation::time_tallies.stop();
+
+  // Record figures of merit from the results of the batch
+  update_figures_of_merit();
+
+  // Write the tracks of this batch that are still held in memory
+  if (!settings::track_identifiers.empty() || settings::write_all_tracks) {
+    flush_track_buffers();
+  }
+
+  // Check the most likely neighbor of each cell first in the next batch
+  if (settings::neighbor_list_reorder) {
+    for (auto& c : model::cells) {
+      c->neighbors_.reorder();
+    }
+  }
+
+  // update weight windows if needed
+  for (const auto& wwg : variance_reduction::weight_windows_generators) {
+    wwg->update();
+  }
+
+  // Reset global tally results
+  if (simulation::current_batch <= settings::n_inactive) {
+    xt::view(simulation::global_tallies, xt::all()) = 0.0;
+    simulation::n_realizations = 0;
+  }
+
+  // Check_triggers
+  if (mpi::master)
+    check_triggers();
+#ifdef OPENMC_MPI
+  MPI_Bcast(&simulation::satisfy_triggers, 1, MPI_C_BOOL, 0, mpi::intracomm);
+#endif
+  if (simulation::satisfy_triggers ||
+      (settings::trigger_on &&
+        simulation::current_batch == settings::n_max_batches)) {
+    settings::statepoint_batch.insert(simulation::current_batch);
+  }
+
+  if (pipelined) {
+    // Defer the remaining work. Files of a state point batch must be written
+    // right away if they cannot be written on the helper thread.
+    auto& pb = pipelined_batch;
+    pb.pending = true;
+    pb.batch = simulation::current_batch;
+    pb.tallies = true;
+    pb.files = pipelined_files;
+    if (pipelined_files)
+      finish_bank_synchronization();
+    else
+      write_batch_files(simulation::current_batch);
+  } else {
+    write_batch_files(simulation::current_batch);
+  }
 
-  // Write out surface source if requested.
-  if (settings::surf_source_write &&
+  // Write out surface source if requested. A streamed surface source only
+  // needs the sites left in the buffers to be written.
+  if (settings::surf_source_write && settings::surf_source_stream &&
       simulation::current_batch == settings::n_batches) {
+    close_surf_source_stream();
+  } else if (settings::surf_source_write &&
+             simulation::current_batch == settings::n_batches) {
     auto filename = settings::path_output + "surface_source";
     auto surf_work_index =
       mpi::calculate_parallel_index_vector(simulation::surf_source_bank.size());
@@ -477,13 +833,18 @@ void finalize_batch()
       write_source_point(filename.c_str(), surfbankspan, surf_work_index);
     }
   }
+
+  // Report the batch to anything monitoring the run
+  write_telemetry();
 }
 
 void initialize_generation()
 {
+  TraceRange trace {"initialize_generation"};
+
   if (settings::run_mode == RunMode::EIGENVALUE) {
-    // Clear out the fission bank
-    simulation::fission_bank.resize(0);
+    // Clear out the fission bank and the bank of each thread
+    clear_fission_bank();
 
     // Count source sites if using uniform fission source weighting
     if (settings::ufs_on)
@@ -492,13 +853,24 @@ void initialize_generation()
     // Store current value of tracklength k
     simulation::keff_generation = simulation::global_tallies(
       GlobalTally::K_TRACKLENGTH, TallyResult::VALUE);
+
+    // Reset the weight of neutrons transported in their birth generation
+    simulation::wielandt_weight = 0.0;
   }
+
+  // Start with the time step ending at the first census time
+  start_census();
 }
 
 void finalize_generation()
 {
+  TraceRange trace {"finalize_generation"};
+
   auto& gt = simulation::global_tallies;
 
+  // Gather the sums of each thread over the histories of the generation
+  reduce_history_sums();
+
   // Update global tallies with the accumulation variables
   if (settings::run_mode == RunMode::EIGENVALUE) {
     gt(GlobalTally::K_COLLISION, TallyResult::VALUE) += global_tally_collision;
@@ -509,6 +881,10 @@ void finalize_generation()
   }
   gt(GlobalTally::LEAKAGE, TallyResult::VALUE) += global_tally_leakage;
 
+  // Neutrons transported in the generation they were born in are part of the
+  // source that tallies are normalized by
+  simulation::total_weight += simulation::wielandt_weight;
+
   // reset tallies
   if (settings::run_mode == RunMode::EIGENVALUE) {
     global_tally_collision = 0.0;
@@ -517,6 +893,9 @@ void finalize_generation()
   }
   global_tally_leakage = 0.0;
 
+  // Work is balanced across processes at the end of each batch
+  bool last_gen = simulation::current_gen == settings::gen_per_batch;
+
   if (settings::run_mode == RunMode::EIGENVALUE &&
       settings::solver_type == SolverType::MONTE_CARLO) {
     // If using shared memory, stable sort the fission bank (by parent IDs)
@@ -524,8 +903,29 @@ void finalize_generation()
     // are run in.
     sort_fission_bank();
 
+    // Score the fission matrix during inactive batches while the source bank
+    // still holds the source sites of this generation
+    bool inactive = simulation::current_batch <= settings::n_inactive;
+    if (settings::fission_matrix_on && inactive)
+      fission_matrix_tally();
+
+    // Reassign particles before the fission bank is distributed so that each
+    // process receives its new share of source sites
+    bool rebalanced = last_gen && balance_work();
+
     // Distribute fission bank across processors evenly
     synchronize_bank();
+
+    // Resize the fission bank for a new number of particles on this process
+    if (rebalanced)
+      init_fission_bank(3 * simulation::work_per_rank);
+
+    // Accelerate convergence of the source until the last inactive batch
+    if (settings::fission_matrix_on &&
+        simulation::current_batch < settings::n_inactive)
+      fission_matrix_reweight();
+  } else if (last_gen) {
+    balance_work();
   }
 
   if (settings::run_mode == RunMode::EIGENVALUE) {
@@ -549,7 +949,10 @@ void finalize_generation()
 void initialize_history(Particle& p, int64_t index_source)
 {
   // set defaults
-  if (settings::run_mode == RunMode::EIGENVALUE) {
+  if (simulation::census_step > 0) {
+    // continue the particles combed at the last census
+    p.from_source(&simulation::census_source[index_source - 1]);
+  } else if (settings::run_mode == RunMode::EIGENVALUE) {
     // set defaults for eigenvalue simulations from primary bank
     p.from_source(&simulation::source_bank[index_source - 1]);
   } else if (settings::run_mode == RunMode::FIXED_SOURCE) {
@@ -563,6 +966,7 @@ void initialize_history(Particle& p, int64_t index_source)
     p.from_source(&site);
   }
   p.current_work() = index_source;
+  count_thread_event(&ThreadStats::histories);
 
   // set identifier for particle
   p.id() = simulation::work_index[mpi::rank] + index_source;
@@ -576,16 +980,18 @@ void initialize_history(Particle& p, int64_t index_source)
   // Reset split counter
   p.n_split() = 0;
 
-  // Reset weight window ratio
+  // Reset weight window ratio and the last weight window found
   p.ww_factor() = 0.0;
+  p.ww_index() = C_NONE;
 
   // Reset pulse_height_storage
   std::fill(p.pht_storage().begin(), p.pht_storage().end(), 0);
 
-  // set random number seed
-  int64_t particle_seed =
-    (simulation::total_gen + overall_generation() - 1) * settings::n_particles +
-    p.id();
+  // set random number seed, distinct for each time step of a time census
+  int64_t step = (simulation::total_gen + overall_generation() - 1) *
+                   n_census_steps() +
+                 simulation::census_step;
+  int64_t particle_seed = step * settings::n_particles + p.id();
   init_particle_seeds(particle_seed, p.seeds());
 
   // set particle trace
@@ -603,9 +1009,10 @@ void initialize_history(Particle& p, int64_t index_source)
     write_message("Simulating Particle {}", p.id());
   }
 
-// Add paricle's starting weight to count for normalizing tallies later
-#pragma omp atomic
-  simulation::total_weight += p.wgt();
+  // Add paricle's starting weight to count for normalizing tallies later.
+  // Particles continued from a census were already counted.
+  if (simulation::census_step == 0)
+    simulation::history_sums[thread_num()].source_weight += p.wgt();
 
   // Force calculation of cross-sections by setting last energy to zero
   if (settings::run_CE) {
@@ -646,6 +1053,242 @@ void calculate_work()
     i_bank += work_i;
     simulation::work_index[i + 1] = i_bank;
   }
+
+  simulation::time_transport_balanced = simulation::time_transport.elapsed();
+  simulation::load_imbalance.clear();
+}
+
+bool balance_work()
+{
+  if (mpi::n_procs == 1)
+    return false;
+
+  // Transport time of each process since the last time work was balanced
+  double t_now = simulation::time_transport.elapsed();
+  double t = t_now - simulation::time_transport_balanced;
+  simulation::time_transport_balanced = t_now;
+  vector<double> times(mpi::n_procs, t);
+#ifdef OPENMC_MPI
+  MPI_Allgather(
+    &t, 1, MPI_DOUBLE, times.data(), 1, MPI_DOUBLE, mpi::intracomm);
+#endif
+
+  double t_mean = 0.0;
+  double t_max = 0.0;
+  for (auto t_i : times) {
+    t_mean += t_i / mpi::n_procs;
+    t_max = std::max(t_max, t_i);
+  }
+  if (t_mean <= 0.0)
+    return false;
+  simulation::load_imbalance.push_back(t_max / t_mean);
+
+  if (!settings::load_balancing ||
+      settings::solver_type != SolverType::MONTE_CARLO ||
+      settings::n_particles < mpi::n_procs)
+    return false;
+
+  // Rate at which each process transported particles. A process that reports
+  // no time is assumed to run at the mean rate.
+  vector<double> rates(mpi::n_procs);
+  double total_rate = 0.0;
+  for (int i = 0; i < mpi::n_procs; ++i) {
+    double work_i = simulation::work_index[i + 1] - simulation::work_index[i];
+    rates[i] = work_i / (times[i] > 0.0 ? times[i] : t_mean);
+    total_rate += rates[i];
+  }
+
+  // Give each process a share of the particles proportional to its rate.
+  // Rounding the cumulative shares keeps the total equal to the number of
+  // particles, and every process keeps at least one particle so that its rate
+  // can be measured in the next batch.
+  int64_t n = settings::n_particles;
+  double cum_rate = 0.0;
+  for (int i = 0; i < mpi::n_procs - 1; ++i) {
+    cum_rate += rates[i];
+    auto i_bank = static_cast<int64_t>(std::llround(n * cum_rate / total_rate));
+    simulation::work_index[i + 1] =
+      std::max(simulation::work_index[i] + 1,
+        std::min(i_bank, n - (mpi::n_procs - 1 - i)));
+  }
+
+  int64_t work_old = simulation::work_per_rank;
+  simulation::work_per_rank =
+    simulation::work_index[mpi::rank + 1] - simulation::work_index[mpi::rank];
+  if (simulation::work_per_rank == work_old)
+    return false;
+
+  // The source bank is refilled from the fission bank for the new shares when
+  // the fission bank is synchronized
+  if (settings::run_mode == RunMode::EIGENVALUE) {
+    simulation::source_bank.resize(simulation::work_per_rank);
+  }
+
+  // Make sure the shared particle buffer can hold the particles in flight
+  if (settings::event_based && settings::event_thread_pool == 0) {
+    int64_t event_buffer_length =
+      std::min(simulation::work_per_rank, settings::max_particles_in_flight);
+    if (event_buffer_length >
+        static_cast<int64_t>(simulation::particles.size())) {
+      init_event_queues(event_buffer_length);
+    }
+  }
+  return true;
+}
+
+namespace {
+
+//! Number of batches in each of the windows whose mean Shannon entropies are
+//! compared to detect the convergence of a warm-started source
+constexpr int WARM_START_WINDOW {3};
+
+bool warm_started {false}; //!< did the simulation start from a kept source?
+
+// Batch counts and output batches given in the settings
+int n_inactive_input {0};
+int n_batches_input {0};
+int n_max_batches_input {0};
+std::unordered_set<int> statepoint_batch_input;
+std::unordered_set<int> sourcepoint_batch_input;
+
+//! Whether the means of the two halves of the last n values of x differ by
+//! less than the given number of standard errors of their difference
+bool stationary(const vector<double>& x, int n, double threshold)
+{
+  if (x.size() < static_cast<size_t>(n))
+    return false;
+
+  // Mean and variance of the mean of the m values starting at x[first]
+  int m = n / 2;
+  auto moments = [&](int first) {
+    double mean = 0.0;
+    for (int i = 0; i < m; ++i)
+      mean += x[first + i];
+    mean /= m;
+    double var = 0.0;
+    for (int i = 0; i < m; ++i)
+      var += (x[first + i] - mean) * (x[first + i] - mean);
+    return std::make_pair(mean, var / ((m - 1) * m));
+  };
+  auto [older, var_older] = moments(x.size() - 2 * m);
+  auto [newer, var_newer] = moments(x.size() - m);
+  return std::abs(newer - older) <=
+         threshold * std::sqrt(var_older + var_newer);
+}
+
+} // namespace
+
+void save_batch_counts()
+{
+  n_inactive_input = settings::n_inactive;
+  n_batches_input = settings::n_batches;
+  n_max_batches_input = settings::n_max_batches;
+}
+
+void begin_warm_start()
+{
+  warm_started = simulation::source_kept && !settings::restart_run &&
+                 settings::run_mode == RunMode::EIGENVALUE &&
+                 settings::solver_type == SolverType::MONTE_CARLO;
+  if (warm_started && settings::warm_start_inactive >= 0 &&
+      settings::warm_start_inactive < settings::n_inactive) {
+    settings::n_inactive = settings::warm_start_inactive;
+    write_message(6, "Starting from the previous source with {} inactive "
+                     "batches",
+      settings::n_inactive);
+  }
+}
+
+void check_warm_start_convergence()
+{
+  if (!warm_started || settings::warm_start_entropy_tolerance <= 0.0 ||
+      !settings::entropy_on ||
+      simulation::current_batch >= settings::n_inactive ||
+      simulation::current_batch < 2 * WARM_START_WINDOW)
+    return;
+
+  // Compare the mean entropy of the last batches to that of the batches
+  // before them. The entropy is only known on the master process.
+  bool converged = false;
+  if (mpi::master) {
+    int n = WARM_START_WINDOW * settings::gen_per_batch;
+    const auto& H = simulation::entropy;
+    double recent = 0.0;
+    double previous = 0.0;
+    for (int i = 0; i < n; ++i) {
+      recent += H[H.size() - 1 - i];
+      previous += H[H.size() - 1 - n - i];
+    }
+    converged = std::abs(recent - previous) <=
+                settings::warm_start_entropy_tolerance * std::abs(previous);
+  }
+#ifdef OPENMC_MPI
+  MPI_Bcast(&converged, 1, MPI_C_BOOL, 0, mpi::intracomm);
+#endif
+
+  // The remaining inactive batches become active batches
+  if (converged) {
+    settings::n_inactive = simulation::current_batch;
+    write_message(6, "Shannon entropy converged after {} inactive batches",
+      simulation::current_batch);
+  }
+}
+
+void check_source_convergence()
+{
+  int batch = simulation::current_batch;
+  if (settings::source_convergence_window == 0 || settings::restart_run ||
+      settings::run_mode != RunMode::EIGENVALUE ||
+      settings::solver_type != SolverType::MONTE_CARLO ||
+      batch >= settings::n_inactive ||
+      batch < std::max(settings::source_convergence_min,
+                settings::source_convergence_window))
+    return;
+
+  // Test the generations of the last batches for a trend in k and in the
+  // Shannon entropy, which are only known on the master process
+  bool converged = false;
+  if (mpi::master) {
+    int n = settings::source_convergence_window * settings::gen_per_batch;
+    double threshold = settings::source_convergence_threshold;
+    converged = stationary(simulation::k_generation, n, threshold) &&
+                (!settings::entropy_on ||
+                  stationary(simulation::entropy, n, threshold));
+  }
+#ifdef OPENMC_MPI
+  MPI_Bcast(&converged, 1, MPI_C_BOOL, 0, mpi::intracomm);
+#endif
+  if (!converged)
+    return;
+
+  // Skip the remaining inactive batches, keeping the number of active
+  // batches, and write the output files of the last batch at its new number
+  int skipped = settings::n_inactive - batch;
+  statepoint_batch_input = settings::statepoint_batch;
+  sourcepoint_batch_input = settings::sourcepoint_batch;
+  for (auto* batches : {&settings::statepoint_batch,
+         &settings::sourcepoint_batch}) {
+    if (batches->erase(settings::n_batches))
+      batches->insert(settings::n_batches - skipped);
+  }
+  settings::n_inactive = batch;
+  settings::n_batches -= skipped;
+  settings::n_max_batches -= skipped;
+  write_message(6, "Source converged after {} inactive batches, {} fewer than "
+                   "requested",
+    batch, skipped);
+}
+
+void restore_batch_counts()
+{
+  if (settings::n_batches != n_batches_input) {
+    settings::statepoint_batch = statepoint_batch_input;
+    settings::sourcepoint_batch = sourcepoint_batch_input;
+  }
+  settings::n_inactive = n_inactive_input;
+  settings::n_batches = n_batches_input;
+  settings::n_max_batches = n_max_batches_input;
+  warm_started = false;
 }
 
 void initialize_data()
@@ -708,14 +1351,32 @@ void initialize_data()
     }
   }
 
+  // Photon-only runs read no neutron cross sections to index
+  if (settings::photon_only)
+    return;
+
   // Set up logarithmic grid for nuclides
-  for (auto& nuc : data::nuclides) {
-    nuc->init_grid();
+  simulation::time_energy_grids.start();
+  int n_rebuilt = 0;
+#pragma omp parallel for schedule(dynamic) reduction(+ : n_rebuilt)
+  for (int i = 0; i < data::nuclides.size(); ++i) {
+    if (data::nuclides[i]->init_grid())
+      ++n_rebuilt;
   }
   int neutron = static_cast<int>(ParticleType::neutron);
   simulation::log_spacing =
     std::log(data::energy_max[neutron] / data::energy_min[neutron]) /
     settings::n_log_bins;
+
+  // Set up unionized grid for nuclides if requested. It only changes when
+  // nuclides are added or their logarithmic grids are rebuilt.
+  if (n_rebuilt > 0 || data::union_energy.empty())
+    init_union_grid();
+
+  // Pack cross sections for vectorized lookups if requested
+  if (settings::vectorized_xs)
+    init_packed_xs();
+  simulation::time_energy_grids.stop();
 }
 
 #ifdef OPENMC_MPI
@@ -723,6 +1384,15 @@ void broadcast_results()
 {
   // Broadcast tally results so that each process has access to results
   for (auto& t : model::tallies) {
+    if (t->sparse_storage()) {
+      t->sparse_results_.broadcast();
+      continue;
+    }
+
+    // Each process keeps only its own bins of a partitioned tally
+    if (t->partitioned())
+      continue;
+
     // Create a new datatype that consists of all values for a given filter
     // bin and then use that to broadcast. This is done to minimize the
     // chance of the 'count' argument of MPI_BCAST exceeding 2**31
@@ -756,10 +1426,11 @@ void broadcast_results()
 void free_memory_simulation()
 {
   simulation::k_generation.clear();
+  simulation::history_sums.clear();
   simulation::entropy.clear();
 }
 
-void transport_history_based_single_particle(Particle& p)
+void transport_history_based_remaining(Particle& p)
 {
   while (p.alive()) {
     p.event_calculate_xs();
@@ -775,16 +1446,43 @@ void transport_history_based_single_particle(Particle& p)
     }
     p.event_revive_from_secondary();
   }
+}
+
+void transport_history_based_single_particle(Particle& p)
+{
+  transport_history_based_remaining(p);
   p.event_death();
 }
 
 void transport_history_based()
 {
-#pragma omp parallel for schedule(runtime)
-  for (int64_t i_work = 1; i_work <= simulation::work_per_rank; ++i_work) {
-    Particle p;
-    initialize_history(p, i_work);
-    transport_history_based_single_particle(p);
+  auto transport = [](int64_t first, int64_t last) {
+#pragma omp parallel
+    {
+      // Each thread reuses one particle for all of its histories rather than
+      // allocating the banks and cross section caches of a new one for each.
+      // As in event-based transport, initialize_history resets all of the
+      // state a history depends on.
+      Particle p;
+      ThreadTimer timer;
+#pragma omp for schedule(runtime) nowait
+      for (int64_t i_work = first + 1; i_work <= last; ++i_work) {
+        initialize_history(p, i_work);
+        transport_history_based_single_particle(p);
+      }
+    }
+  };
+
+  // If source sites are still arriving from other processes, transport each
+  // part of the source bank once it is ready. Particle IDs and seeds depend
+  // only on the index of the source site, so the order does not matter.
+  if (source_sites_pending()) {
+    int64_t first, last;
+    while (receive_source_sites(first, last)) {
+      transport(first, last);
+    }
+  } else {
+    transport(0, simulation::work_per_rank);
   }
 }
 
@@ -806,11 +1504,46 @@ void transport_event_based()
     // Initialize all particle histories for this subiteration
     process_init_events(n_particles, source_offset);
 
+    // Slots of the particle buffer are refilled from the shared secondary
+    // queue once this many are free
+    int64_t n_refill = std::max<int64_t>(1, n_particles / 4);
+
     // Event-based transport loop
     while (true) {
+      // Determine which cross section queue is the longest and how many
+      // particles are still in flight
+      int i_xs_max = 0;
+      int64_t n_in_flight = simulation::advance_particle_queue.size() +
+                            simulation::surface_crossing_queue.size() +
+                            simulation::collision_queue.size();
+      for (int i = 0; i < simulation::calculate_xs_queues.size(); ++i) {
+        n_in_flight += simulation::calculate_xs_queues[i].size();
+        if (simulation::calculate_xs_queues[i].size() >
+            simulation::calculate_xs_queues[i_xs_max].size())
+          i_xs_max = i;
+      }
+      auto& xs_queue = simulation::calculate_xs_queues[i_xs_max];
+
+      // Start waiting secondary particles in the slots of particles that died
+      // once enough slots are free or no other particle is left
+      int64_t n_secondary = simulation::secondary_queue.size();
+      if (n_secondary > 0 && simulation::free_slots.size() > 0 &&
+          (simulation::free_slots.size() >= n_refill || n_in_flight == 0)) {
+        process_secondary_events();
+        continue;
+      }
+
+      // Once only a few particles remain, the overhead of launching a kernel
+      // for each event outweighs any benefit from batching, so finish the
+      // remaining particles using history-based transport
+      if (n_in_flight > 0 && n_in_flight <= settings::event_history_tail &&
+          n_secondary == 0) {
+        process_history_based_tail();
+        break;
+      }
+
       // Determine which event kernel has the longest queue
-      int64_t max = std::max({simulation::calculate_fuel_xs_queue.size(),
-        simulation::calculate_nonfuel_xs_queue.size(),
+      int64_t max = std::max({xs_queue.size(),
         simulation::advance_particle_queue.size(),
         simulation::surface_crossing_queue.size(),
         simulation::collision_queue.size()});
@@ -818,10 +1551,8 @@ void transport_event_based()
       // Execute event with the longest queue
       if (max == 0) {
         break;
-      } else if (max == simulation::calculate_fuel_xs_queue.size()) {
-        process_calculate_xs_events(simulation::calculate_fuel_xs_queue);
-      } else if (max == simulation::calculate_nonfuel_xs_queue.size()) {
-        process_calculate_xs_events(simulation::calculate_nonfuel_xs_queue);
+      } else if (max == xs_queue.size()) {
+        process_calculate_xs_events(xs_queue);
       } else if (max == simulation::advance_particle_queue.size()) {
         process_advance_particle_events();
       } else if (max == simulation::surface_crossing_queue.size()) {
@@ -833,6 +1564,7 @@ void transport_event_based()
 
     // Execute death event for all particles
     process_death_events(n_particles);
+    simulation::free_slots.resize(0);
 
     // Adjust remaining work and source offset variables
     remaining_work -= n_particles;
@@ -840,4 +1572,103 @@ void transport_event_based()
   }
 }
 
+void transport_event_based_thread_pool()
+{
+  // Particles are handed out to threads in blocks the size of a thread's pool
+  // so that the only synchronization needed is one atomic update per block
+  int64_t next_work = 0;
+
+#pragma omp parallel
+  {
+    int64_t pool_size =
+      std::min(simulation::work_per_rank, settings::event_thread_pool);
+    vector<Particle> pool(pool_size);
+
+    // Thread-private event queues holding indices into the pool. Since only
+    // one thread ever touches these, no atomics are needed to append to them.
+    vector<int64_t> xs_queue;
+    vector<int64_t> advance_queue;
+    vector<int64_t> surface_queue;
+    vector<int64_t> collision_queue;
+    xs_queue.reserve(pool_size);
+    advance_queue.reserve(pool_size);
+    surface_queue.reserve(pool_size);
+    collision_queue.reserve(pool_size);
+
+    ThreadTimer timer;
+    while (true) {
+      int64_t start;
+#pragma omp atomic capture
+      {
+        start = next_work;
+        next_work += pool_size;
+      }
+      if (start >= simulation::work_per_rank)
+        break;
+      int64_t n_particles =
+        std::min(pool_size, simulation::work_per_rank - start);
+
+      // Initialize all particle histories in this block
+      for (int64_t i = 0; i < n_particles; i++) {
+        initialize_history(pool[i], start + i + 1);
+        xs_queue.push_back(i);
+      }
+
+      // Event-based transport loop over this thread's pool
+      while (true) {
+        // Determine which event kernel has the longest queue
+        auto max = std::max({xs_queue.size(), advance_queue.size(),
+          surface_queue.size(), collision_queue.size()});
+
+        // Execute event with the longest queue
+        if (max == 0) {
+          break;
+        } else if (max == xs_queue.size()) {
+          for (auto i : xs_queue) {
+            pool[i].event_calculate_xs();
+            advance_queue.push_back(i);
+          }
+          xs_queue.clear();
+        } else if (max == advance_queue.size()) {
+          for (auto i : advance_queue) {
+            Particle& p = pool[i];
+            p.event_advance();
+            if (!p.alive())
+              continue;
+            if (p.collision_distance() > p.boundary().distance) {
+              surface_queue.push_back(i);
+            } else {
+              collision_queue.push_back(i);
+            }
+          }
+          advance_queue.clear();
+        } else if (max == surface_queue.size()) {
+          for (auto i : surface_queue) {
+            Particle& p = pool[i];
+            p.event_cross_surface();
+            p.event_revive_from_secondary();
+            if (p.alive())
+              xs_queue.push_back(i);
+          }
+          surface_queue.clear();
+        } else if (max == collision_queue.size()) {
+          for (auto i : collision_queue) {
+            Particle& p = pool[i];
+            p.event_collide();
+            p.event_revive_from_secondary();
+            if (p.alive())
+              xs_queue.push_back(i);
+          }
+          collision_queue.clear();
+        }
+      }
+
+      // Execute death event for all particles in this block
+      for (int64_t i = 0; i < n_particles; i++) {
+        pool[i].event_death();
+      }
+    }
+  }
+}
+
 } // namespace openmc
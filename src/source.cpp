@@ -4,7 +4,9 @@
 #define HAS_DYNAMIC_LINKING
 #endif
 
-#include <algorithm> // for move
+#include <algorithm>  // for min, move, upper_bound
+#include <functional> // for function
+#include <tuple>      // for tie
 
 #ifdef HAS_DYNAMIC_LINKING
 #include <dlfcn.h> // for dlopen, dlsym, dlclose, dlerror
@@ -21,6 +23,7 @@
 #include "openmc/file_utils.h"
 #include "openmc/geometry.h"
 #include "openmc/hdf5_interface.h"
+#include "openmc/lattice.h"
 #include "openmc/material.h"
 #include "openmc/mcpl_interface.h"
 #include "openmc/memory.h"
@@ -33,6 +36,7 @@
 #include "openmc/simulation.h"
 #include "openmc/state_point.h"
 #include "openmc/string_utils.h"
+#include "openmc/universe.h"
 #include "openmc/xml_interface.h"
 
 namespace openmc {
@@ -46,6 +50,33 @@ namespace model {
 vector<unique_ptr<Source>> external_sources;
 }
 
+//==============================================================================
+// RejectionCounter implementation
+//==============================================================================
+
+void RejectionCounter::accept() const
+{
+#pragma omp atomic
+  ++n_accept_;
+}
+
+void RejectionCounter::reject(const char* hint) const
+{
+  int64_t n_reject;
+#pragma omp atomic capture
+  n_reject = ++n_reject_;
+  int64_t n_accept;
+#pragma omp atomic read
+  n_accept = n_accept_;
+
+  if (n_reject >= EXTSRC_REJECT_THRESHOLD &&
+      static_cast<double>(n_accept) / n_reject <= EXTSRC_REJECT_FRACTION) {
+    fatal_error(fmt::format("More than 95% of external source sites sampled "
+                            "were rejected. Please check your {}.",
+      hint));
+  }
+}
+
 //==============================================================================
 // Source implementation
 //==============================================================================
@@ -157,8 +188,6 @@ void Source::read_constraints(pugi::xml_node node)
 SourceSite Source::sample_with_constraints(uint64_t* seed) const
 {
   bool accepted = false;
-  static int n_reject = 0;
-  static int n_accept = 0;
   SourceSite site;
 
   while (!accepted) {
@@ -173,13 +202,7 @@ SourceSite Source::sample_with_constraints(uint64_t* seed) const
                  satisfies_energy_constraints(site.E) &&
                  satisfies_time_constraints(site.time);
       if (!accepted) {
-        ++n_reject;
-        if (n_reject >= EXTSRC_REJECT_THRESHOLD &&
-            static_cast<double>(n_accept) / n_reject <=
-              EXTSRC_REJECT_FRACTION) {
-          fatal_error("More than 95% of external source sites sampled were "
-                      "rejected. Please check your source definition.");
-        }
+        rejections_.reject("source definition");
 
         // For the "kill" strategy, accept particle but set weight to 0 so that
         // it is terminated immediately
@@ -192,11 +215,18 @@ SourceSite Source::sample_with_constraints(uint64_t* seed) const
   }
 
   // Increment number of accepted samples
-  ++n_accept;
+  rejections_.accept();
 
   return site;
 }
 
+SourceSite Source::sample_at(Position r, uint64_t* seed) const
+{
+  SourceSite site = this->sample_with_constraints(seed);
+  site.r = r;
+  return site;
+}
+
 bool Source::satisfies_energy_constraints(double E) const
 {
   return E > energy_bounds_.first && E < energy_bounds_.second;
@@ -251,6 +281,85 @@ bool Source::satisfies_spatial_constraints(Position r) const
   return accepted;
 }
 
+BoundingBox Source::domain_bounding_box() const
+{
+  BoundingBox infinite;
+  if (domain_ids_.empty() && !only_fissionable_)
+    return infinite;
+
+  // Whether any point of a universe may lie in one of the domains and, if
+  // required, in fissionable material, given whether a higher level of the
+  // geometry already lies in one of the domains. The result for each universe
+  // and state is cached.
+  vector<int8_t> cache(2 * model::universes.size(), -1);
+  std::function<bool(int32_t, bool)> universe_may_satisfy;
+
+  auto cell_may_satisfy = [&](const Cell& c, bool in_domain) {
+    in_domain = in_domain || (domain_type_ == DomainType::CELL &&
+                               contains(domain_ids_, c.id_));
+    if (c.type_ == Fill::UNIVERSE) {
+      return universe_may_satisfy(c.fill_, in_domain);
+    } else if (c.type_ == Fill::LATTICE) {
+      const auto& lat = *model::lattices[c.fill_];
+      for (int32_t u : lat.universes_) {
+        if (u != C_NONE && universe_may_satisfy(u, in_domain))
+          return true;
+      }
+      return lat.outer_ != NO_OUTER_UNIVERSE &&
+             universe_may_satisfy(lat.outer_, in_domain);
+    }
+
+    // Void is accepted by material domains, as in
+    // satisfies_spatial_constraints
+    for (int32_t i_mat : c.material_) {
+      const Material* mat =
+        i_mat == MATERIAL_VOID ? nullptr : model::materials[i_mat].get();
+      bool domain = in_domain || (domain_type_ == DomainType::MATERIAL &&
+                                   (!mat || contains(domain_ids_, mat->id())));
+      bool fissionable = !only_fissionable_ || (mat && mat->fissionable());
+      if (domain && fissionable)
+        return true;
+    }
+    return false;
+  };
+
+  universe_may_satisfy = [&](int32_t i_univ, bool in_domain) {
+    const auto& univ = *model::universes[i_univ];
+    in_domain = in_domain || (domain_type_ == DomainType::UNIVERSE &&
+                               contains(domain_ids_, univ.id_));
+    auto& cached = cache[2 * i_univ + in_domain];
+    if (cached < 0) {
+      cached = 0;
+      for (int32_t i_cell : univ.cells_) {
+        if (cell_may_satisfy(*model::cells[i_cell], in_domain)) {
+          cached = 1;
+          break;
+        }
+      }
+    }
+    return cached == 1;
+  };
+
+  // Cells of the root universe are in the global coordinate system, so the
+  // union of their bounding boxes contains every site that can be accepted
+  bool in_domain = domain_ids_.empty();
+  const auto& root = *model::universes[model::root_universe];
+  if (!in_domain && domain_type_ == DomainType::UNIVERSE)
+    in_domain = contains(domain_ids_, root.id_);
+  BoundingBox bbox {INFTY, -INFTY, INFTY, -INFTY, INFTY, -INFTY};
+  bool found = false;
+  for (int32_t i_cell : root.cells_) {
+    const auto& c = *model::cells[i_cell];
+    if (cell_may_satisfy(c, in_domain)) {
+      bbox |= c.bounding_box();
+      found = true;
+    }
+  }
+
+  // Without any such cell, sampling is left to fail with the usual message
+  return found ? bbox : infinite;
+}
+
 //==============================================================================
 // IndependentSource implementation
 //==============================================================================
@@ -329,34 +438,42 @@ IndependentSource::IndependentSource(pugi::xml_node node) : Source(node)
 
 SourceSite IndependentSource::sample(uint64_t* seed) const
 {
-  SourceSite site;
-  site.particle = particle_;
-
   // Repeat sampling source location until a good site has been accepted
   bool accepted = false;
-  static int n_reject = 0;
-  static int n_accept = 0;
+  const SpatialDistribution* space =
+    domain_space_ ? domain_space_.get() : space_.get();
 
+  // Weight that compensates for sampling from biased distributions
+  Position r;
+  double wgt_space = 1.0;
   while (!accepted) {
 
     // Sample spatial distribution
-    site.r = space_->sample(seed);
+    std::tie(r, wgt_space) = space->sample_biased(seed);
 
     // Check if sampled position satisfies spatial constraints
-    accepted = satisfies_spatial_constraints(site.r);
+    accepted = satisfies_spatial_constraints(r);
 
     // Check for rejection
-    if (!accepted) {
-      ++n_reject;
-      if (n_reject >= EXTSRC_REJECT_THRESHOLD &&
-          static_cast<double>(n_accept) / n_reject <= EXTSRC_REJECT_FRACTION) {
-        fatal_error("More than 95% of external source sites sampled were "
-                    "rejected. Please check your external source's spatial "
-                    "definition.");
-      }
-    }
+    if (!accepted)
+      rejections_.reject("external source's spatial definition");
   }
 
+  // Increment number of accepted samples
+  rejections_.accept();
+
+  SourceSite site = this->sample_at(r, seed);
+  site.wgt *= wgt_space;
+  return site;
+}
+
+SourceSite IndependentSource::sample_at(Position r, uint64_t* seed) const
+{
+  SourceSite site;
+  site.particle = particle_;
+  site.r = r;
+  site.wgt = 1.0;
+
   // Sample angle
   site.u = angle_->sample(seed);
 
@@ -375,21 +492,14 @@ SourceSite IndependentSource::sample(uint64_t* seed) const
 
     while (true) {
       // Sample energy spectrum
-      site.E = energy_->sample(seed);
+      std::tie(site.E, site.wgt) = energy_->sample_biased(seed);
 
       // Resample if energy falls above maximum particle energy
       if (site.E < data::energy_max[p] and
           (satisfies_energy_constraints(site.E)))
         break;
 
-      n_reject++;
-      if (n_reject >= EXTSRC_REJECT_THRESHOLD &&
-          static_cast<double>(n_accept) / n_reject <= EXTSRC_REJECT_FRACTION) {
-        fatal_error(
-          "More than 95% of external source sites sampled were "
-          "rejected. Please check your external source energy spectrum "
-          "definition.");
-      }
+      energy_rejections_.reject("external source energy spectrum definition");
     }
 
     // Sample particle creation time
@@ -397,11 +507,37 @@ SourceSite IndependentSource::sample(uint64_t* seed) const
   }
 
   // Increment number of accepted samples
-  ++n_accept;
+  energy_rejections_.accept();
 
   return site;
 }
 
+void IndependentSource::init_domains()
+{
+  domain_space_.reset();
+  auto box = dynamic_cast<SpatialBox*>(space_.get());
+  if (!box)
+    return;
+
+  // Uniform positions in the overlap of the box with the bounding box of the
+  // domains that are accepted have the same distribution as the accepted
+  // positions of the whole box, but fewer are rejected
+  Position ll = box->lower_left();
+  Position ur = box->upper_right();
+  BoundingBox bbox = domain_bounding_box();
+  Position domain_ll = {std::max(ll.x, bbox.xmin), std::max(ll.y, bbox.ymin),
+    std::max(ll.z, bbox.zmin)};
+  Position domain_ur = {std::min(ur.x, bbox.xmax), std::min(ur.y, bbox.ymax),
+    std::min(ur.z, bbox.zmax)};
+  if (domain_ll.x >= domain_ur.x || domain_ll.y >= domain_ur.y ||
+      domain_ll.z >= domain_ur.z)
+    return;
+  if (domain_ll != ll || domain_ur != ur) {
+    domain_space_ = make_unique<SpatialBox>(
+      domain_ll, domain_ur, box->only_fissionable());
+  }
+}
+
 //==============================================================================
 // FileSource implementation
 //==============================================================================
@@ -409,8 +545,11 @@ SourceSite IndependentSource::sample(uint64_t* seed) const
 FileSource::FileSource(pugi::xml_node node) : Source(node)
 {
   auto path = get_node_value(node, "file", false, true);
+  if (check_for_node(node, "partitioned")) {
+    partitioned_ = get_node_value_bool(node, "partitioned");
+  }
   if (ends_with(path, ".mcpl") || ends_with(path, ".mcpl.gz")) {
-    sites_ = mcpl_source_sites(path);
+    sites_ = mcpl_source_sites(path, partitioned_);
   } else {
     this->load_sites_from_file(path);
   }
@@ -421,6 +560,12 @@ FileSource::FileSource(const std::string& path)
   load_sites_from_file(path);
 }
 
+FileSource::FileSource(const SourceSite* sites, size_t n, double strength)
+  : external_sites_ {sites}, n_external_ {n}
+{
+  strength_ = strength;
+}
+
 void FileSource::load_sites_from_file(const std::string& path)
 {
   // Check if source file exists
@@ -442,8 +587,13 @@ void FileSource::load_sites_from_file(const std::string& path)
     fatal_error("Specified starting source file not a source file type.");
   }
 
-  // Read in the source particles
-  read_source_bank(file_id, sites_, false);
+  // Read in the source particles. When partitioned, each process samples
+  // from its own part of the file, which together cover every site.
+  if (partitioned_) {
+    read_source_bank_partition(file_id, sites_);
+  } else {
+    read_source_bank(file_id, sites_, false);
+  }
 
   // Close file
   file_close(file_id);
@@ -452,6 +602,10 @@ void FileSource::load_sites_from_file(const std::string& path)
 SourceSite FileSource::sample(uint64_t* seed) const
 {
   // Sample a particle randomly from list
+  if (external_sites_) {
+    size_t i_site = n_external_ * prn(seed);
+    return external_sites_[i_site];
+  }
   size_t i_site = sites_.size() * prn(seed);
   return sites_[i_site];
 }
@@ -547,32 +701,48 @@ MeshSource::MeshSource(pugi::xml_node node) : Source(node)
   }
 
   space_ = std::make_unique<MeshSpatial>(mesh_idx, strengths);
+
+  // Elements may be sampled from biased strengths instead of the strengths of
+  // their sources
+  if (check_for_node(node, "bias")) {
+    auto bias = get_node_array<double>(node, "bias");
+    if (bias.size() != strengths.size()) {
+      fatal_error(fmt::format("Number of biased strengths ({}) does not match "
+                              "the number of source distributions ({}) for "
+                              "mesh source.",
+        bias.size(), strengths.size()));
+    }
+    space_->set_bias(strengths, bias);
+  }
 }
 
 SourceSite MeshSource::sample(uint64_t* seed) const
 {
-  // Sample the CDF defined in initialization above
-  int32_t element = space_->sample_element_index(seed);
+  // Sample the element from its alias table
+  auto [element, wgt] = space_->sample_element_biased(seed);
 
   // Sample position and apply rejection on spatial domains
   Position r;
-  do {
-    r = space_->mesh()->sample_element(element, seed);
-  } while (!this->satisfies_spatial_constraints(r));
-
-  SourceSite site;
   while (true) {
-    // Sample source for the chosen element and replace the position
-    site = source(element)->sample_with_constraints(seed);
-    site.r = r;
-
-    // Apply other rejections
-    if (satisfies_energy_constraints(site.E) &&
-        satisfies_time_constraints(site.time)) {
+    r = space_->mesh()->sample_element(element, seed);
+    if (this->satisfies_spatial_constraints(r))
       break;
-    }
+
+    rejections_.reject("mesh source's spatial constraints");
   }
+  rejections_.accept();
+
+  // Sample the rest of the site from the source of the chosen element. Its
+  // own spatial distribution is not used, so the position is not located in
+  // the geometry a second time.
+  SourceSite site;
+  const auto& src = source(element);
+  do {
+    site = src->sample_at(r, seed);
+  } while (!satisfies_energy_constraints(site.E) ||
+           !satisfies_time_constraints(site.time));
 
+  site.wgt *= wgt;
   return site;
 }
 
@@ -580,21 +750,26 @@ SourceSite MeshSource::sample(uint64_t* seed) const
 // Non-member functions
 //==============================================================================
 
+void init_source_domains()
+{
+  if (!settings::source_domain_bounds)
+    return;
+  for (auto& s : model::external_sources) {
+    s->init_domains();
+  }
+}
+
 void initialize_source()
 {
   write_message("Initializing source particles...", 5);
 
-// Generation source sites from specified distribution in user input
-#pragma omp parallel for
-  for (int64_t i = 0; i < simulation::work_per_rank; ++i) {
-    // initialize random number seed
-    int64_t id = simulation::total_gen * settings::n_particles +
-                 simulation::work_index[mpi::rank] + i + 1;
-    uint64_t seed = init_seed(id, STREAM_SOURCE);
-
-    // sample external source distribution
-    simulation::source_bank[i] = sample_external_source(&seed);
-  }
+  // Generation source sites from specified distribution in user input
+  int64_t first_id = simulation::total_gen * settings::n_particles +
+                     simulation::work_index[mpi::rank] + 1;
+  sample_external_sources(
+    {simulation::source_bank.data(),
+      static_cast<size_t>(simulation::work_per_rank)},
+    first_id);
 
   // Write out initial source
   if (settings::write_initial_source) {
@@ -606,28 +781,41 @@ void initialize_source()
   }
 }
 
-SourceSite sample_external_source(uint64_t* seed)
+namespace {
+
+//! Cumulative strengths of the external source distributions
+vector<double> external_source_cdf()
 {
-  // Determine total source strength
-  double total_strength = 0.0;
-  for (auto& s : model::external_sources)
-    total_strength += s->strength();
+  vector<double> cdf;
+  double c = 0.0;
+  for (auto& s : model::external_sources) {
+    c += s->strength();
+    cdf.push_back(c);
+  }
+  return cdf;
+}
 
+//! Sample a site from the external source distributions given their
+//! cumulative strengths
+SourceSite sample_external_source(uint64_t* seed, const vector<double>& cdf)
+{
   // Sample from among multiple source distributions
   int i = 0;
-  if (model::external_sources.size() > 1) {
-    double xi = prn(seed) * total_strength;
-    double c = 0.0;
-    for (; i < model::external_sources.size(); ++i) {
-      c += model::external_sources[i]->strength();
-      if (xi < c)
-        break;
-    }
+  if (cdf.size() > 1) {
+    double xi = prn(seed) * cdf.back();
+    i = std::upper_bound(cdf.begin(), cdf.end(), xi) - cdf.begin();
+    i = std::min(i, static_cast<int>(cdf.size()) - 1);
   }
 
   // Sample source site from i-th source distribution
   SourceSite site {model::external_sources[i]->sample_with_constraints(seed)};
 
+  // Sites read from files or made by compiled sources can only be checked as
+  // they are sampled
+  if (settings::photon_only && site.particle != ParticleType::photon) {
+    fatal_error("Source sites of a photon-only calculation must be photons.");
+  }
+
   // If running in MG, convert site.E to group
   if (!settings::run_CE) {
     site.E = lower_bound_index(data::mg.rev_energy_bins_.begin(),
@@ -638,6 +826,24 @@ SourceSite sample_external_source(uint64_t* seed)
   return site;
 }
 
+} // namespace
+
+SourceSite sample_external_source(uint64_t* seed)
+{
+  return sample_external_source(seed, external_source_cdf());
+}
+
+void sample_external_sources(gsl::span<SourceSite> sites, int64_t first_id)
+{
+  auto cdf = external_source_cdf();
+
+#pragma omp parallel for
+  for (int64_t i = 0; i < sites.size(); ++i) {
+    uint64_t seed = init_seed(first_id + i, STREAM_SOURCE);
+    sites[i] = sample_external_source(&seed, cdf);
+  }
+}
+
 void free_memory_source()
 {
   model::external_sources.clear();
@@ -661,9 +867,37 @@ extern "C" int openmc_sample_external_source(
   }
 
   auto sites_array = static_cast<SourceSite*>(sites);
+  auto cdf = external_source_cdf();
   for (size_t i = 0; i < n; ++i) {
-    sites_array[i] = sample_external_source(seed);
+    sites_array[i] = sample_external_source(seed, cdf);
+  }
+  return 0;
+}
+
+extern "C" int openmc_set_source_sites(
+  const void* sites, int64_t n, double strength)
+{
+  if (!sites) {
+    set_errmsg("Received null pointer.");
+    return OPENMC_E_INVALID_ARGUMENT;
+  }
+
+  if (n <= 0) {
+    set_errmsg("Number of source sites must be positive.");
+    return OPENMC_E_INVALID_ARGUMENT;
   }
+
+  if (strength < 0.0) {
+    set_errmsg("Source strength must be non-negative.");
+    return OPENMC_E_INVALID_ARGUMENT;
+  }
+
+  // The sites are sampled in place, so they replace all other sources,
+  // including a source kept from the previous simulation
+  simulation::source_kept = false;
+  model::external_sources.clear();
+  model::external_sources.push_back(make_unique<FileSource>(
+    static_cast<const SourceSite*>(sites), n, strength));
   return 0;
 }
 
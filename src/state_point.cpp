@@ -2,7 +2,10 @@
 
 #include <algorithm>
 #include <cstdint> // for int64_t
+#include <cstdio>  // for rename
+#include <fstream>
 #include <string>
+#include <thread>
 
 #include "xtensor/xbuilder.hpp" // for empty_like
 #include "xtensor/xview.hpp"
@@ -22,19 +25,194 @@
 #include "openmc/output.h"
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
+#include "openmc/string_utils.h"
 #include "openmc/tallies/derivative.h"
 #include "openmc/tallies/filter.h"
 #include "openmc/tallies/filter_mesh.h"
 #include "openmc/tallies/tally.h"
+#include "openmc/thread_stats.h"
 #include "openmc/timer.h"
 #include "openmc/vector.h"
 
 namespace openmc {
 
+namespace {
+
+//! State point file written to disk by a background thread
+struct AsyncStatePoint {
+  std::thread writer;   //!< Thread writing the file
+  std::string filename; //!< Name of the file
+  bool failed {false};  //!< Whether writing the file failed
+};
+
+AsyncStatePoint async_statepoint;
+
+//! State points written since the last full state point
+struct StatePointChain {
+  std::string last; //!< Name of the last state point written
+  int n_deltas {0}; //!< Number of delta state points since the full one
+};
+
+StatePointChain statepoint_chain;
+
+//! Write the image of a state point file to disk on a background thread. The
+//! file is written under a temporary name and renamed once it is complete, so
+//! that an incomplete file is never mistaken for a state point.
+void start_statepoint_write(const std::string& filename, vector<char> image)
+{
+  auto& a = async_statepoint;
+  a.filename = filename;
+  a.failed = false;
+  a.writer = std::thread([&a, image = std::move(image)] {
+    std::string temp = a.filename + ".tmp";
+    std::ofstream out(temp, std::ios::binary);
+    out.write(image.data(), image.size());
+    out.close();
+    a.failed = !out || std::rename(temp.c_str(), a.filename.c_str()) != 0;
+  });
+}
+
+//! Directory part of a file name, including the trailing slash
+std::string directory_of(const std::string& filename)
+{
+  return filename.substr(0, filename.rfind('/') + 1);
+}
+
+//! Whether changes to the bins of a tally are tracked for delta state points
+bool tracks_changes(const Tally& tally)
+{
+  return settings::statepoint_delta > 0 && settings::reduce_tallies &&
+         !tally.sparse_storage() && !tally.partitioned();
+}
+
+//! Write the sum and sum of squares of the filter bins of a tally that changed
+//! since the last state point
+void write_tally_delta(hid_t group_id, const Tally& tally)
+{
+  const auto& results = tally.results_;
+  int64_t n_scores = results.shape()[1];
+  vector<int64_t> rows;
+  vector<double> sums;
+  for (int64_t i = 0; i < results.shape()[0]; ++i) {
+    if (!tally.changed_rows_[i])
+      continue;
+    rows.push_back(i);
+    for (int64_t j = 0; j < n_scores; ++j) {
+      sums.push_back(results(i, j, TallyResult::SUM));
+      sums.push_back(results(i, j, TallyResult::SUM_SQ));
+    }
+  }
+
+  write_attribute(group_id, "delta", 1);
+  if (!rows.empty()) {
+    write_dataset(group_id, "delta_rows", rows);
+    hsize_t dims[] {rows.size(), static_cast<hsize_t>(n_scores), 2};
+    write_dataset_lowlevel(group_id, 3, dims, "delta_results",
+      H5T_NATIVE_DOUBLE, H5S_ALL, false, sums.data());
+  }
+}
+
+//! Replace the sum and sum of squares of the filter bins of a tally that
+//! changed in a delta state point
+void read_tally_delta(hid_t group_id, Tally& tally)
+{
+  if (!object_exists(group_id, "delta_rows"))
+    return;
+
+  auto& results = tally.results_;
+  int64_t n_scores = results.shape()[1];
+  vector<int64_t> rows;
+  read_dataset(group_id, "delta_rows", rows);
+  vector<double> sums(rows.size() * n_scores * 2);
+  read_dataset_lowlevel(group_id, "delta_results", H5T_NATIVE_DOUBLE, H5S_ALL,
+    false, sums.data());
+
+  for (int64_t k = 0; k < rows.size(); ++k) {
+    for (int64_t j = 0; j < n_scores; ++j) {
+      results(rows[k], j, TallyResult::SUM) = sums[2 * (k * n_scores + j)];
+      results(rows[k], j, TallyResult::SUM_SQ) =
+        sums[2 * (k * n_scores + j) + 1];
+    }
+  }
+}
+
+//! Find the state points that have to be replayed to restore tally results,
+//! from the last full state point to the given one
+vector<std::string> statepoint_chain_files(
+  const std::string& filename, hid_t file_id)
+{
+  vector<std::string> files {filename};
+  hid_t current = file_id;
+  while (attribute_exists(current, "previous")) {
+    std::string previous;
+    read_attribute(current, "previous", previous);
+
+    // A name without a directory is relative to the file referring to it
+    const auto& last = files.back();
+    if (directory_of(previous).empty())
+      previous = directory_of(last) + previous;
+    if (!file_exists(previous)) {
+      fatal_error(fmt::format("State point {} that delta state point {} "
+                              "follows does not exist.",
+        previous, last));
+    }
+
+    if (current != file_id)
+      file_close(current);
+    current = file_open(previous, 'r', true);
+    files.push_back(previous);
+  }
+  if (current != file_id)
+    file_close(current);
+
+  std::reverse(files.begin(), files.end());
+  return files;
+}
+
+} // namespace
+
+void finish_statepoint_write()
+{
+  auto& a = async_statepoint;
+  if (!a.writer.joinable())
+    return;
+
+  a.writer.join();
+  if (a.failed) {
+    fatal_error(fmt::format("Failed to write state point {}.", a.filename));
+  }
+}
+
 extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
+{
+  return write_state_point(filename, write_source, simulation::current_batch);
+}
+
+int write_state_point(const char* filename, bool* write_source, int batch)
 {
   simulation::time_statepoint.start();
 
+  // Complete any tally reduction still in progress
+  finish_tally_reduction();
+  finish_bank_synchronization();
+
+  // With asynchronous writing, the file is created in memory on the master
+  // process and written to disk in the background once it is complete. The
+  // previous state point has to be on disk before the next one is created.
+  bool async = settings::statepoint_async;
+  if (async)
+    finish_statepoint_write();
+
+#ifdef OPENMC_MPI
+  // Results of partitioned tallies are written from the master process
+  if (settings::reduce_tallies && !model::active_tallies.empty()) {
+    for (auto& tally : model::tallies) {
+      if (tally->writable_ && tally->partitioned())
+        tally->gather_results();
+    }
+  }
+#endif
+
   // If a nullptr is passed in, we assume that the user
   // wants a default name for this, of the form like output/statepoint.20.h5
   std::string filename_;
@@ -46,7 +224,7 @@ extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
 
     // Set filename for state point
     filename_ = fmt::format("{0}statepoint.{1:0{2}}.h5", settings::path_output,
-      simulation::current_batch, w);
+      batch, w);
   }
 
   // If a file name was specified, ensure it has .h5 file extension
@@ -61,13 +239,20 @@ extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
   // Determine whether or not to write the source bank
   bool write_source_ = write_source ? *write_source : true;
 
+  // Tallies are written as the bins that changed since the last state point
+  // until the chain of delta state points reaches its maximum length
+  auto& chain = statepoint_chain;
+  bool delta = settings::statepoint_delta > 0 && settings::reduce_tallies &&
+               !chain.last.empty() && chain.last != filename_ &&
+               chain.n_deltas < settings::statepoint_delta;
+
   // Write message
   write_message("Creating state point " + filename_ + "...", 5);
 
   hid_t file_id;
   if (mpi::master) {
     // Create statepoint file
-    file_id = file_open(filename_, 'w');
+    file_id = async ? file_open_memory(filename_) : file_open(filename_, 'w');
 
     // Write file type
     write_attribute(file_id, "filetype", "statepoint");
@@ -108,11 +293,21 @@ extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
     write_dataset(file_id, "n_batches", settings::n_batches);
 
     // Write out current batch number
-    write_dataset(file_id, "current_batch", simulation::current_batch);
+    write_dataset(file_id, "current_batch", batch);
 
     // Indicate whether source bank is stored in statepoint
     write_attribute(file_id, "source_present", write_source_);
 
+    // Refer a delta state point to the one before it, by name only if both
+    // are in the same directory
+    if (delta) {
+      std::string previous = chain.last;
+      auto dir = directory_of(previous);
+      if (dir == directory_of(filename_))
+        previous.erase(0, dir.size());
+      write_attribute(file_id, "previous", previous);
+    }
+
     // Write out information for eigenvalue run
     if (settings::run_mode == RunMode::EIGENVALUE)
       write_eigenvalue_hdf5(file_id);
@@ -245,6 +440,27 @@ extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
         write_dataset(tally_group, "n_score_bins", scores.size());
         write_dataset(tally_group, "score_bins", scores);
 
+        // Write the figure of merit at the end of each active batch
+        if (tally->figure_of_merit_) {
+          const auto& history = tally->fom_history_;
+          vector<int> batches;
+          vector<double> time, max_rel_err, median_rel_err, value;
+          for (const auto& fom : history) {
+            batches.push_back(fom.batch);
+            time.push_back(fom.time);
+            max_rel_err.push_back(fom.max_rel_err);
+            median_rel_err.push_back(fom.median_rel_err);
+            value.push_back(fom.value);
+          }
+          hid_t fom_group = create_group(tally_group, "figure_of_merit");
+          write_dataset(fom_group, "batches", batches);
+          write_dataset(fom_group, "time", time);
+          write_dataset(fom_group, "max_rel_err", max_rel_err);
+          write_dataset(fom_group, "median_rel_err", median_rel_err);
+          write_dataset(fom_group, "fom", value);
+          close_group(fom_group);
+        }
+
         close_group(tally_group);
       }
     }
@@ -265,9 +481,17 @@ extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
           // Write sum and sum_sq for each bin
           std::string name = "tally " + std::to_string(tally->id_);
           hid_t tally_group = open_group(tallies_group, name.c_str());
+          tally->materialize_results();
           auto& results = tally->results_;
-          write_tally_results(tally_group, results.shape()[0],
-            results.shape()[1], results.data());
+          if (delta && !tally->changed_rows_.empty()) {
+            write_tally_delta(tally_group, *tally);
+          } else {
+            write_tally_results(tally_group, results.shape()[0],
+              results.shape()[1], results.data());
+          }
+          if (tracks_changes(*tally))
+            tally->changed_rows_.assign(results.shape()[0], 0);
+          tally->release_results();
           close_group(tally_group);
         }
       } else {
@@ -290,14 +514,28 @@ extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
     write_dataset(file_id, "n_realizations", simulation::n_realizations);
   }
 
+  // Collect the work done by each thread on the master
+  vector<int> n_threads;
+  auto thread_stats = gather_thread_stats(n_threads);
+
   if (mpi::master) {
     // Write out the runtime metrics.
     using namespace simulation;
     hid_t runtime_group = create_group(file_id, "runtime");
     write_dataset(
       runtime_group, "total initialization", time_initialize.elapsed());
+    write_dataset(
+      runtime_group, "reading materials", time_read_materials.elapsed());
+    write_dataset(
+      runtime_group, "reading geometry", time_read_geometry.elapsed());
+    write_dataset(
+      runtime_group, "setting up geometry", time_setup_geometry.elapsed());
     write_dataset(
       runtime_group, "reading cross sections", time_read_xs.elapsed());
+    write_dataset(runtime_group, "preparing distributed cells",
+      time_distribcell.elapsed());
+    write_dataset(
+      runtime_group, "setting up energy grids", time_energy_grids.elapsed());
     write_dataset(runtime_group, "simulation",
       time_inactive.elapsed() + time_active.elapsed());
     write_dataset(runtime_group, "transport", time_transport.elapsed());
@@ -318,9 +556,62 @@ extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
     write_dataset(runtime_group, "total", time_total.elapsed());
     write_dataset(
       runtime_group, "writing statepoints", time_statepoint.elapsed());
+    if (settings::event_based) {
+      write_dataset(runtime_group, "event particle initialization",
+        time_event_init.elapsed());
+      write_dataset(
+        runtime_group, "event XS lookups", time_event_calculate_xs.elapsed());
+      if (settings::event_queue_sort) {
+        write_dataset(
+          runtime_group, "event sorting XS queues", time_event_sort.elapsed());
+      }
+      write_dataset(runtime_group, "event advancing",
+        time_event_advance_particle.elapsed());
+      write_dataset(runtime_group, "event surface crossings",
+        time_event_surface_crossing.elapsed());
+      write_dataset(
+        runtime_group, "event collisions", time_event_collision.elapsed());
+      if (settings::event_history_tail > 0) {
+        write_dataset(
+          runtime_group, "event history-based tail", time_event_tail.elapsed());
+      }
+      write_dataset(
+        runtime_group, "event particle death", time_event_death.elapsed());
+    }
+
+    // Particle rates, which are the only values not in seconds
+    auto [rate_inactive, rate_active] = calculation_rates();
+    if (settings::run_mode == RunMode::EIGENVALUE) {
+      write_dataset(
+        runtime_group, "calculation rate (inactive)", rate_inactive);
+    }
+    write_dataset(runtime_group, "calculation rate (active)", rate_active);
+    if (!thread_stats.empty()) {
+      vector<double> time;
+      vector<int64_t> histories, segments, collisions, surface_crossings;
+      for (const auto& s : thread_stats) {
+        time.push_back(s.time);
+        histories.push_back(s.histories);
+        segments.push_back(s.segments);
+        collisions.push_back(s.collisions);
+        surface_crossings.push_back(s.surface_crossings);
+      }
+      hid_t threads_group = create_group(runtime_group, "threads");
+      write_dataset(threads_group, "n_threads", n_threads);
+      write_dataset(threads_group, "time", time);
+      write_dataset(threads_group, "histories", histories);
+      write_dataset(threads_group, "segments", segments);
+      write_dataset(threads_group, "collisions", collisions);
+      write_dataset(threads_group, "surface_crossings", surface_crossings);
+      close_group(threads_group);
+    }
     close_group(runtime_group);
 
-    file_close(file_id);
+    if (!async)
+      file_close(file_id);
+
+    chain.last = filename_;
+    chain.n_deltas = delta ? chain.n_deltas + 1 : 0;
   }
 
 #ifdef PHDF5
@@ -331,16 +622,26 @@ extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
 
   // Write the source bank if desired
   if (write_source_) {
-    if (mpi::master || parallel)
+    if ((mpi::master || parallel) && !async)
       file_id = file_open(filename_, 'a', true);
-    write_source_bank(file_id, simulation::source_bank, simulation::work_index);
-    if (mpi::master || parallel)
+    if (settings::source_shards) {
+      write_source_shards(file_id, filename_, simulation::source_bank,
+        simulation::work_index);
+    } else {
+      write_source_bank(
+        file_id, simulation::source_bank, simulation::work_index);
+    }
+    if ((mpi::master || parallel) && !async)
       file_close(file_id);
   }
 
+  // Hand the complete file over to the background thread
+  if (async && mpi::master)
+    start_statepoint_write(filename_, file_close_image(file_id));
+
 #if defined(LIBMESH) || defined(DAGMC)
   // write unstructured mesh tally files
-  write_unstructured_mesh_results();
+  write_unstructured_mesh_results(batch);
 #endif
 
   simulation::time_statepoint.stop();
@@ -488,7 +789,7 @@ extern "C" int openmc_statepoint_load(const char* filename)
       hid_t tallies_group = open_group(file_id, "tallies");
 
       for (auto& tally : model::tallies) {
-        // Read sum, sum_sq, and N for each bin
+        // Read N for each bin
         std::string name = "tally " + std::to_string(tally->id_);
         hid_t tally_group = open_group(tallies_group, name.c_str());
 
@@ -499,17 +800,54 @@ extern "C" int openmc_statepoint_load(const char* filename)
         if (internal) {
           tally->writable_ = false;
         } else {
-          auto& results = tally->results_;
-          read_tally_results(tally_group, results.shape()[0],
-            results.shape()[1], results.data());
+          tally->materialize_results();
           read_dataset(tally_group, "n_realizations", tally->n_realizations_);
           close_group(tally_group);
         }
       }
       close_group(tallies_group);
+
+      // Read sum and sum_sq for each bin. A delta state point only holds the
+      // bins that changed since the state point before it, so every state
+      // point since the last full one is read in order.
+      for (const auto& name : statepoint_chain_files(filename, file_id)) {
+        hid_t chain_id =
+          (name == filename) ? file_id : file_open(name, 'r', true);
+        tallies_group = open_group(chain_id, "tallies");
+        for (auto& tally : model::tallies) {
+          if (!tally->writable_)
+            continue;
+          std::string group = "tally " + std::to_string(tally->id_);
+          hid_t tally_group = open_group(tallies_group, group.c_str());
+          if (attribute_exists(tally_group, "delta")) {
+            read_tally_delta(tally_group, *tally);
+          } else {
+            auto& results = tally->results_;
+            read_tally_results(tally_group, results.shape()[0],
+              results.shape()[1], results.data());
+          }
+          close_group(tally_group);
+        }
+        close_group(tallies_group);
+        if (chain_id != file_id)
+          file_close(chain_id);
+      }
+
+      for (auto& tally : model::tallies) {
+        if (tally->writable_)
+          tally->store_results();
+      }
     }
   }
 
+#ifdef OPENMC_MPI
+  // Send the results of partitioned tallies to the processes owning them
+  for (auto& tally : model::tallies) {
+    if (tally->writable_ && tally->partitioned())
+      tally->scatter_results();
+  }
+#endif
+
   // Read source if in eigenvalue mode
   if (settings::run_mode == RunMode::EIGENVALUE) {
 
@@ -600,7 +938,11 @@ void write_source_point(const char* filename, gsl::span<SourceSite> source_bank,
   }
 
   // Get pointer to source bank and write to file
-  write_source_bank(file_id, source_bank, bank_index);
+  if (settings::source_shards) {
+    write_source_shards(file_id, filename_, source_bank, bank_index);
+  } else {
+    write_source_bank(file_id, source_bank, bank_index);
+  }
 
   if (mpi::master || parallel)
     file_close(file_id);
@@ -716,18 +1058,22 @@ std::string dtype_member_names(hid_t dtype_id)
   return names;
 }
 
-void read_source_bank(
-  hid_t group_id, vector<SourceSite>& sites, bool distribute)
-{
-  hid_t banktype = h5banktype();
+namespace {
 
-  // Open the dataset
-  hid_t dset = H5Dopen(group_id, "source_bank", H5P_DEFAULT);
+//! Name of the file holding the source sites of one process in a sharded
+//! source bank
+std::string shard_filename(const std::string& prefix, int rank)
+{
+  return fmt::format("{}_p{}.h5", prefix, rank);
+}
 
-  // Make sure number of members matches
+//! Check that the source sites of a dataset have the members expected
+void check_bank_type(hid_t dset, hid_t banktype)
+{
   hid_t dtype = H5Dget_type(dset);
   auto file_member_names = dtype_member_names(dtype);
   auto bank_member_names = dtype_member_names(banktype);
+  H5Tclose(dtype);
   if (file_member_names != bank_member_names) {
     fatal_error(fmt::format(
       "Source site attributes in file do not match what is "
@@ -735,6 +1081,122 @@ void read_source_bank(
       "attributes = ({})",
       file_member_names, bank_member_names));
   }
+}
+
+//! Read the sites of a sharded source bank in a range of global indices
+void read_source_shards(hid_t group_id, vector<SourceSite>& sites,
+  bool distribute)
+{
+  std::string prefix;
+  read_attribute(group_id, "source_shards", prefix);
+  vector<int64_t> shard_index;
+  read_dataset(group_id, "source_shard_index", shard_index);
+
+  // Shards are found in the directory of the file holding the index
+  ssize_t len = H5Fget_name(group_id, nullptr, 0);
+  std::string path(len, '\0');
+  H5Fget_name(group_id, path.data(), len + 1);
+  auto pos = path.rfind('/');
+  if (pos != std::string::npos)
+    prefix = path.substr(0, pos + 1) + prefix;
+
+  // Determine which sites are read by this process
+  int64_t start = 0;
+  int64_t end = shard_index.back();
+  if (distribute) {
+    if (simulation::work_index[mpi::n_procs] > end) {
+      fatal_error("Number of source sites in source file is less "
+                  "than number of source particles per generation.");
+    }
+    start = simulation::work_index[mpi::rank];
+    end = simulation::work_index[mpi::rank + 1];
+  }
+  sites.resize(end - start);
+
+  // Each process only opens the shards holding its sites, and no process
+  // needs to communicate with another
+  hid_t banktype = h5banktype();
+  for (int i = 0; i < shard_index.size() - 1; ++i) {
+    int64_t lo = std::max(start, shard_index[i]);
+    int64_t hi = std::min(end, shard_index[i + 1]);
+    if (lo >= hi)
+      continue;
+
+    auto filename = shard_filename(prefix, i);
+    if (!file_exists(filename)) {
+      fatal_error(fmt::format("Source file '{}' does not exist.", filename));
+    }
+    hid_t file_id = file_open(filename, 'r');
+    hid_t dset = H5Dopen(file_id, "source_bank", H5P_DEFAULT);
+    check_bank_type(dset, banktype);
+
+    hsize_t offset = lo - shard_index[i];
+    hsize_t count = hi - lo;
+    hid_t dspace = H5Dget_space(dset);
+    H5Sselect_hyperslab(
+      dspace, H5S_SELECT_SET, &offset, nullptr, &count, nullptr);
+    hid_t memspace = H5Screate_simple(1, &count, nullptr);
+    H5Dread(dset, banktype, memspace, dspace, H5P_DEFAULT,
+      sites.data() + (lo - start));
+
+    H5Sclose(memspace);
+    H5Sclose(dspace);
+    H5Dclose(dset);
+    file_close(file_id);
+  }
+  H5Tclose(banktype);
+}
+
+} // namespace
+
+void write_source_shards(hid_t group_id, const std::string& filename,
+  gsl::span<SourceSite> source_bank, const vector<int64_t>& bank_index)
+{
+  // Shards are named after the file holding the index, without its extension
+  std::string prefix = filename;
+  if (ends_with(prefix, ".h5"))
+    prefix.erase(prefix.size() - 3);
+
+  // Each process writes its sites to its own file
+  hid_t file_id = file_open(shard_filename(prefix, mpi::rank), 'w');
+  write_attribute(file_id, "filetype", "source");
+  hid_t banktype = h5banktype();
+  hsize_t dims[] {static_cast<hsize_t>(source_bank.size())};
+  hid_t dspace = H5Screate_simple(1, dims, nullptr);
+  hid_t dset = H5Dcreate(file_id, "source_bank", banktype, dspace, H5P_DEFAULT,
+    H5P_DEFAULT, H5P_DEFAULT);
+  H5Dwrite(dset, banktype, H5S_ALL, H5S_ALL, H5P_DEFAULT, source_bank.data());
+  H5Dclose(dset);
+  H5Sclose(dspace);
+  H5Tclose(banktype);
+  file_close(file_id);
+
+  // The index holds the name of the shards relative to the directory of the
+  // file and the range of global indices of the sites in each of them
+  if (mpi::master) {
+    auto pos = prefix.rfind('/');
+    write_attribute(group_id, "source_shards",
+      pos == std::string::npos ? prefix : prefix.substr(pos + 1));
+    write_dataset(group_id, "source_shard_index", bank_index);
+  }
+}
+
+void read_source_bank(
+  hid_t group_id, vector<SourceSite>& sites, bool distribute)
+{
+  // A sharded source bank only holds the index of the shards
+  if (attribute_exists(group_id, "source_shards")) {
+    read_source_shards(group_id, sites, distribute);
+    return;
+  }
+
+  hid_t banktype = h5banktype();
+
+  // Open the dataset
+  hid_t dset = H5Dopen(group_id, "source_bank", H5P_DEFAULT);
+
+  // Make sure number of members matches
+  check_bank_type(dset, banktype);
 
   hid_t dspace = H5Dget_space(dset);
   hsize_t n_sites;
@@ -782,7 +1244,56 @@ void read_source_bank(
   H5Tclose(banktype);
 }
 
-void write_unstructured_mesh_results()
+void read_source_bank_partition(hid_t group_id, vector<SourceSite>& sites)
+{
+  if (attribute_exists(group_id, "source_shards")) {
+    fatal_error("A sharded source file cannot be read in partitions.");
+  }
+
+  hid_t banktype = h5banktype();
+  hid_t dset = H5Dopen(group_id, "source_bank", H5P_DEFAULT);
+  check_bank_type(dset, banktype);
+
+  hid_t dspace = H5Dget_space(dset);
+  hsize_t n_sites;
+  H5Sget_simple_extent_dims(dspace, &n_sites, nullptr);
+
+  hsize_t n_procs = mpi::n_procs;
+  if (n_sites < n_procs) {
+    fatal_error(fmt::format("Source file has {} sites, which is fewer than "
+                            "the number of processes.",
+      n_sites));
+  }
+
+  // The first n_sites % n_procs processes hold one more site than the others
+  hsize_t rank = mpi::rank;
+  hsize_t n_min = n_sites / n_procs;
+  hsize_t n_extra = n_sites % n_procs;
+  hsize_t n_local = n_min + (rank < n_extra ? 1 : 0);
+  hsize_t offset = rank * n_min + std::min(rank, n_extra);
+
+  sites.resize(n_local);
+  hid_t memspace = H5Screate_simple(1, &n_local, nullptr);
+  H5Sselect_hyperslab(
+    dspace, H5S_SELECT_SET, &offset, nullptr, &n_local, nullptr);
+
+#ifdef PHDF5
+  // Read data in parallel
+  hid_t plist = H5Pcreate(H5P_DATASET_XFER);
+  H5Pset_dxpl_mpio(plist, H5FD_MPIO_COLLECTIVE);
+  H5Dread(dset, banktype, memspace, dspace, plist, sites.data());
+  H5Pclose(plist);
+#else
+  H5Dread(dset, banktype, memspace, dspace, H5P_DEFAULT, sites.data());
+#endif
+
+  H5Sclose(memspace);
+  H5Sclose(dspace);
+  H5Dclose(dset);
+  H5Tclose(banktype);
+}
+
+void write_unstructured_mesh_results(int batch)
 {
 
   for (auto& tally : model::tallies) {
@@ -825,9 +1336,11 @@ void write_unstructured_mesh_results()
       }
 
       int n_realizations = tally->n_realizations_;
+      int n_scores = tally->scores_.size();
+      int n_nuclides = tally->nuclides_.size();
 
-      for (int score_idx = 0; score_idx < tally->scores_.size(); score_idx++) {
-        for (int nuc_idx = 0; nuc_idx < tally->nuclides_.size(); nuc_idx++) {
+      for (int score_idx = 0; score_idx < n_scores; score_idx++) {
+        for (int nuc_idx = 0; nuc_idx < n_nuclides; nuc_idx++) {
           // combine the score and nuclide into a name for the value
           auto score_str = fmt::format("{}_{}", tally->score_name(score_idx),
             tally->nuclide_name(nuc_idx));
@@ -839,52 +1352,66 @@ void write_unstructured_mesh_results()
         }
       }
 
-      for (int score_idx = 0; score_idx < tally->scores_.size(); score_idx++) {
-        for (int nuc_idx = 0; nuc_idx < tally->nuclides_.size(); nuc_idx++) {
-          // combine the score and nuclide into a name for the value
+      // Compute the mean and standard deviation of every score and nuclide
+      // in each element at once, sharing the elements among threads. Each
+      // result is stored contiguously for all elements.
+      int n_bins = umesh->n_bins();
+      int n_results = n_scores * n_nuclides;
+      vector<double> means(static_cast<size_t>(n_results) * n_bins);
+      vector<double> std_devs(means.size());
+      auto volumes = umesh->volumes();
+      tally->materialize_results();
+#pragma omp parallel for schedule(static)
+      for (int j = 0; j < n_bins; j++) {
+        double volume = volumes[j];
+        for (int k = 0; k < n_results; k++) {
+          // compute the mean
+          double mean =
+            tally->results_(j, k, TallyResult::SUM) / n_realizations;
+
+          // compute the standard deviation
+          double sum_sq = tally->results_(j, k, TallyResult::SUM_SQ);
+          double std_dev {0.0};
+          if (n_realizations > 1) {
+            std_dev = sum_sq / n_realizations - mean * mean;
+            std_dev = std::sqrt(std_dev / (n_realizations - 1));
+          }
+
+          size_t idx = static_cast<size_t>(k) * n_bins + j;
+          means[idx] = mean / volume;
+          std_devs[idx] = std_dev / volume;
+        }
+      }
+      tally->release_results();
+#ifdef OPENMC_MPI
+      MPI_Bcast(means.data(), means.size(), MPI_DOUBLE, 0, mpi::intracomm);
+      MPI_Bcast(
+        std_devs.data(), std_devs.size(), MPI_DOUBLE, 0, mpi::intracomm);
+#endif
+
+      for (int score_idx = 0; score_idx < n_scores; score_idx++) {
+        for (int nuc_idx = 0; nuc_idx < n_nuclides; nuc_idx++) {
           auto score_str = fmt::format("{}_{}", tally->score_name(score_idx),
             tally->nuclide_name(nuc_idx));
 
           // index for this nuclide and score
-          int nuc_score_idx = score_idx + nuc_idx * tally->scores_.size();
-
-          // construct result vectors
-          vector<double> mean_vec(umesh->n_bins()),
-            std_dev_vec(umesh->n_bins());
-          for (int j = 0; j < tally->results_.shape()[0]; j++) {
-            // get the volume for this bin
-            double volume = umesh->volume(j);
-            // compute the mean
-            double mean = tally->results_(j, nuc_score_idx, TallyResult::SUM) /
-                          n_realizations;
-            mean_vec.at(j) = mean / volume;
-
-            // compute the standard deviation
-            double sum_sq =
-              tally->results_(j, nuc_score_idx, TallyResult::SUM_SQ);
-            double std_dev {0.0};
-            if (n_realizations > 1) {
-              std_dev = sum_sq / n_realizations - mean * mean;
-              std_dev = std::sqrt(std_dev / (n_realizations - 1));
-            }
-            std_dev_vec[j] = std_dev / volume;
-          }
-#ifdef OPENMC_MPI
-          MPI_Bcast(
-            mean_vec.data(), mean_vec.size(), MPI_DOUBLE, 0, mpi::intracomm);
-          MPI_Bcast(std_dev_vec.data(), std_dev_vec.size(), MPI_DOUBLE, 0,
-            mpi::intracomm);
-#endif
+          int nuc_score_idx = score_idx + nuc_idx * n_scores;
+          auto begin = static_cast<size_t>(nuc_score_idx) * n_bins;
+          vector<double> mean_vec(
+            means.begin() + begin, means.begin() + begin + n_bins);
+          vector<double> std_dev_vec(
+            std_devs.begin() + begin, std_devs.begin() + begin + n_bins);
+
           // set the data for this score
           umesh->set_score_data(score_str, mean_vec, std_dev_vec);
         }
       }
 
       // Generate a file name based on the tally id
-      // and the current batch number
+      // and the batch number
       size_t batch_width {std::to_string(settings::n_max_batches).size()};
-      std::string filename = fmt::format("tally_{0}.{1:0{2}}", tally->id_,
-        simulation::current_batch, batch_width);
+      std::string filename = fmt::format(
+        "tally_{0}.{1:0{2}}", tally->id_, batch, batch_width);
 
       // Write the unstructured mesh and data to file
       umesh->write(filename);
@@ -0,0 +1,146 @@
+#include "openmc/surf_source_stream.h"
+
+#include "openmc/hdf5_interface.h"
+#include "openmc/mcpl_interface.h"
+#include "openmc/message_passing.h"
+#include "openmc/openmp_interface.h"
+#include "openmc/settings.h"
+#include "openmc/state_point.h"
+#include "openmc/vector.h"
+
+#include <fmt/core.h>
+#include <gsl/gsl-lite.hpp>
+#include <hdf5.h>
+
+#include <atomic>
+#include <string>
+
+namespace openmc {
+
+namespace {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+// Number of sites buffered by each thread before they are appended to the file
+constexpr int64_t BUFFER_SIZE {8192};
+
+bool stream_open {false};
+hid_t stream_file;              //!< HDF5 surface source file
+hid_t stream_dset;              //!< Dataset of source sites in HDF5 file
+hid_t stream_dtype;             //!< HDF5 datatype of source sites
+int64_t n_written;              //!< Number of sites in the file
+std::atomic<int64_t> n_claimed; //!< Number of sites added to any buffer
+vector<vector<SourceSite>> buffers; //!< Sites not yet written, by thread
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Append sites to the end of the file. Must not be called by two threads at
+//! the same time.
+void append_sites(gsl::span<const SourceSite> sites)
+{
+  if (sites.empty())
+    return;
+
+  if (settings::surf_mcpl_write) {
+    append_mcpl_source_sites(sites);
+  } else {
+    // Grow the dataset and select the newly added region
+    hsize_t dims[] {static_cast<hsize_t>(n_written + sites.size())};
+    H5Dset_extent(stream_dset, dims);
+    hid_t dspace = H5Dget_space(stream_dset);
+    hsize_t start[] {static_cast<hsize_t>(n_written)};
+    hsize_t count[] {static_cast<hsize_t>(sites.size())};
+    H5Sselect_hyperslab(dspace, H5S_SELECT_SET, start, nullptr, count, nullptr);
+    hid_t memspace = H5Screate_simple(1, count, nullptr);
+
+    H5Dwrite(
+      stream_dset, stream_dtype, memspace, dspace, H5P_DEFAULT, sites.data());
+
+    H5Sclose(memspace);
+    H5Sclose(dspace);
+  }
+  n_written += sites.size();
+}
+
+} // namespace
+
+void open_surf_source_stream()
+{
+  // When there is more than one process, each process writes its own file
+  std::string filename = settings::path_output + "surface_source";
+  if (mpi::n_procs > 1)
+    filename += fmt::format("_p{}", mpi::rank);
+
+  if (settings::surf_mcpl_write) {
+    open_mcpl_appended_file(filename + ".mcpl");
+  } else {
+    stream_file = file_open(filename + ".h5", 'w');
+    write_attribute(stream_file, "filetype", "source");
+
+    // Create an empty dataset that can be extended without limit
+    stream_dtype = h5banktype();
+    hsize_t dims[] {0};
+    hsize_t maxdims[] {H5S_UNLIMITED};
+    hid_t dspace = H5Screate_simple(1, dims, maxdims);
+    hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+    hsize_t chunk[] {static_cast<hsize_t>(BUFFER_SIZE)};
+    H5Pset_chunk(plist, 1, chunk);
+    stream_dset = H5Dcreate(stream_file, "source_bank", stream_dtype, dspace,
+      H5P_DEFAULT, plist, H5P_DEFAULT);
+    H5Pclose(plist);
+    H5Sclose(dspace);
+  }
+
+  n_written = 0;
+  n_claimed = 0;
+  buffers.resize(num_threads());
+  for (auto& b : buffers) {
+    b.reserve(BUFFER_SIZE);
+  }
+  stream_open = true;
+}
+
+bool add_surf_source_to_stream(const SourceSite& site)
+{
+  if (settings::max_surface_particles > 0 &&
+      n_claimed.fetch_add(1, std::memory_order_relaxed) >=
+        settings::max_surface_particles)
+    return false;
+
+  auto& buffer = buffers[thread_num()];
+  buffer.push_back(site);
+  if (buffer.size() == BUFFER_SIZE) {
+    // Other threads continue transporting particles while the buffer is
+    // written. HDF5 calls are serialized with those writing particle tracks.
+#pragma omp critical(WriteHDF5)
+    append_sites(buffer);
+    buffer.clear();
+  }
+  return true;
+}
+
+void close_surf_source_stream()
+{
+  if (!stream_open)
+    return;
+
+  for (auto& b : buffers) {
+    append_sites(b);
+  }
+  buffers.clear();
+
+  if (settings::surf_mcpl_write) {
+    close_mcpl_appended_file();
+  } else {
+    H5Dclose(stream_dset);
+    H5Tclose(stream_dtype);
+    file_close(stream_file);
+  }
+  stream_open = false;
+}
+
+} // namespace openmc
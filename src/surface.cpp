@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include <complex>
+#include <exception>
 #include <initializer_list>
 #include <set>
 #include <utility>
@@ -29,6 +30,7 @@ namespace openmc {
 namespace model {
 std::unordered_map<int, int> surface_map;
 vector<unique_ptr<Surface>> surfaces;
+vector<PackedSurface> packed_surfaces;
 } // namespace model
 
 //==============================================================================
@@ -196,24 +198,6 @@ CSGSurface::CSGSurface(pugi::xml_node surf_node) : Surface {surf_node}
   geom_type_ = GeometryType::CSG;
 };
 
-//==============================================================================
-// Generic functions for x-, y-, and z-, planes.
-//==============================================================================
-
-// The template parameter indicates the axis normal to the plane.
-template<int i>
-double axis_aligned_plane_distance(
-  Position r, Direction u, bool coincident, double offset)
-{
-  const double f = offset - r[i];
-  if (coincident || std::abs(f) < FP_COINCIDENT || u[i] == 0.0)
-    return INFTY;
-  const double d = f / u[i];
-  if (d < 0.0)
-    return INFTY;
-  return d;
-}
-
 //==============================================================================
 // SurfaceXPlane implementation
 //==============================================================================
@@ -350,16 +334,7 @@ double SurfacePlane::evaluate(Position r) const
 
 double SurfacePlane::distance(Position r, Direction u, bool coincident) const
 {
-  const double f = A_ * r.x + B_ * r.y + C_ * r.z - D_;
-  const double projection = A_ * u.x + B_ * u.y + C_ * u.z;
-  if (coincident || std::abs(f) < FP_COINCIDENT || projection == 0.0) {
-    return INFTY;
-  } else {
-    const double d = -f / projection;
-    if (d < 0.0)
-      return INFTY;
-    return d;
-  }
+  return plane_distance(r, u, coincident, A_, B_, C_, D_);
 }
 
 Direction SurfacePlane::normal(Position r) const
@@ -374,84 +349,6 @@ void SurfacePlane::to_hdf5_inner(hid_t group_id) const
   write_dataset(group_id, "coefficients", coeffs);
 }
 
-//==============================================================================
-// Generic functions for x-, y-, and z-, cylinders
-//==============================================================================
-
-// The template parameters indicate the axes perpendicular to the axis of the
-// cylinder.  offset1 and offset2 should correspond with i1 and i2,
-// respectively.
-template<int i1, int i2>
-double axis_aligned_cylinder_evaluate(
-  Position r, double offset1, double offset2, double radius)
-{
-  const double r1 = r.get<i1>() - offset1;
-  const double r2 = r.get<i2>() - offset2;
-  return r1 * r1 + r2 * r2 - radius * radius;
-}
-
-// The first template parameter indicates which axis the cylinder is aligned to.
-// The other two parameters indicate the other two axes.  offset1 and offset2
-// should correspond with i2 and i3, respectively.
-template<int i1, int i2, int i3>
-double axis_aligned_cylinder_distance(Position r, Direction u, bool coincident,
-  double offset1, double offset2, double radius)
-{
-  const double a = 1.0 - u.get<i1>() * u.get<i1>(); // u^2 + v^2
-  if (a == 0.0)
-    return INFTY;
-
-  const double r2 = r.get<i2>() - offset1;
-  const double r3 = r.get<i3>() - offset2;
-  const double k = r2 * u.get<i2>() + r3 * u.get<i3>();
-  const double c = r2 * r2 + r3 * r3 - radius * radius;
-  const double quad = k * k - a * c;
-
-  if (quad < 0.0) {
-    // No intersection with cylinder.
-    return INFTY;
-
-  } else if (coincident || std::abs(c) < FP_COINCIDENT) {
-    // Particle is on the cylinder, thus one distance is positive/negative
-    // and the other is zero. The sign of k determines if we are facing in or
-    // out.
-    if (k >= 0.0) {
-      return INFTY;
-    } else {
-      return (-k + sqrt(quad)) / a;
-    }
-
-  } else if (c < 0.0) {
-    // Particle is inside the cylinder, thus one distance must be negative
-    // and one must be positive. The positive distance will be the one with
-    // negative sign on sqrt(quad).
-    return (-k + sqrt(quad)) / a;
-
-  } else {
-    // Particle is outside the cylinder, thus both distances are either
-    // positive or negative. If positive, the smaller distance is the one
-    // with positive sign on sqrt(quad).
-    const double d = (-k - sqrt(quad)) / a;
-    if (d < 0.0)
-      return INFTY;
-    return d;
-  }
-}
-
-// The first template parameter indicates which axis the cylinder is aligned to.
-// The other two parameters indicate the other two axes.  offset1 and offset2
-// should correspond with i2 and i3, respectively.
-template<int i1, int i2, int i3>
-Direction axis_aligned_cylinder_normal(
-  Position r, double offset1, double offset2)
-{
-  Direction u;
-  u.get<i2>() = 2.0 * (r.get<i2>() - offset1);
-  u.get<i3>() = 2.0 * (r.get<i3>() - offset2);
-  u.get<i1>() = 0.0;
-  return u;
-}
-
 //==============================================================================
 // SurfaceXCylinder implementation
 //==============================================================================
@@ -594,54 +491,17 @@ SurfaceSphere::SurfaceSphere(pugi::xml_node surf_node) : CSGSurface(surf_node)
 
 double SurfaceSphere::evaluate(Position r) const
 {
-  const double x = r.x - x0_;
-  const double y = r.y - y0_;
-  const double z = r.z - z0_;
-  return x * x + y * y + z * z - radius_ * radius_;
+  return sphere_evaluate(r, x0_, y0_, z0_, radius_);
 }
 
 double SurfaceSphere::distance(Position r, Direction u, bool coincident) const
 {
-  const double x = r.x - x0_;
-  const double y = r.y - y0_;
-  const double z = r.z - z0_;
-  const double k = x * u.x + y * u.y + z * u.z;
-  const double c = x * x + y * y + z * z - radius_ * radius_;
-  const double quad = k * k - c;
-
-  if (quad < 0.0) {
-    // No intersection with sphere.
-    return INFTY;
-
-  } else if (coincident || std::abs(c) < FP_COINCIDENT) {
-    // Particle is on the sphere, thus one distance is positive/negative and
-    // the other is zero. The sign of k determines if we are facing in or out.
-    if (k >= 0.0) {
-      return INFTY;
-    } else {
-      return -k + sqrt(quad);
-    }
-
-  } else if (c < 0.0) {
-    // Particle is inside the sphere, thus one distance must be negative and
-    // one must be positive. The positive distance will be the one with
-    // negative sign on sqrt(quad)
-    return -k + sqrt(quad);
-
-  } else {
-    // Particle is outside the sphere, thus both distances are either positive
-    // or negative. If positive, the smaller distance is the one with positive
-    // sign on sqrt(quad).
-    const double d = -k - sqrt(quad);
-    if (d < 0.0)
-      return INFTY;
-    return d;
-  }
+  return sphere_distance(r, u, coincident, x0_, y0_, z0_, radius_);
 }
 
 Direction SurfaceSphere::normal(Position r) const
 {
-  return {2.0 * (r.x - x0_), 2.0 * (r.y - y0_), 2.0 * (r.z - z0_)};
+  return sphere_normal(r, x0_, y0_, z0_);
 }
 
 void SurfaceSphere::to_hdf5_inner(hid_t group_id) const
@@ -1166,96 +1026,95 @@ Direction SurfaceZTorus::normal(Position r) const
 
 //==============================================================================
 
+namespace {
+
+//! Create a surface of the type given by an XML element
+unique_ptr<Surface> make_surface(pugi::xml_node surf_node)
+{
+  std::string surf_type = get_node_value(surf_node, "type", true, true);
+  if (surf_type == "x-plane") {
+    return make_unique<SurfaceXPlane>(surf_node);
+  } else if (surf_type == "y-plane") {
+    return make_unique<SurfaceYPlane>(surf_node);
+  } else if (surf_type == "z-plane") {
+    return make_unique<SurfaceZPlane>(surf_node);
+  } else if (surf_type == "plane") {
+    return make_unique<SurfacePlane>(surf_node);
+  } else if (surf_type == "x-cylinder") {
+    return make_unique<SurfaceXCylinder>(surf_node);
+  } else if (surf_type == "y-cylinder") {
+    return make_unique<SurfaceYCylinder>(surf_node);
+  } else if (surf_type == "z-cylinder") {
+    return make_unique<SurfaceZCylinder>(surf_node);
+  } else if (surf_type == "sphere") {
+    return make_unique<SurfaceSphere>(surf_node);
+  } else if (surf_type == "x-cone") {
+    return make_unique<SurfaceXCone>(surf_node);
+  } else if (surf_type == "y-cone") {
+    return make_unique<SurfaceYCone>(surf_node);
+  } else if (surf_type == "z-cone") {
+    return make_unique<SurfaceZCone>(surf_node);
+  } else if (surf_type == "quadric") {
+    return make_unique<SurfaceQuadric>(surf_node);
+  } else if (surf_type == "x-torus") {
+    return make_unique<SurfaceXTorus>(surf_node);
+  } else if (surf_type == "y-torus") {
+    return make_unique<SurfaceYTorus>(surf_node);
+  } else if (surf_type == "z-torus") {
+    return make_unique<SurfaceZTorus>(surf_node);
+  } else {
+    fatal_error(fmt::format("Invalid surface type, \"{}\"", surf_type));
+  }
+  return nullptr;
+}
+
+} // namespace
+
 void read_surfaces(pugi::xml_node node)
 {
-  // Count the number of surfaces
-  int n_surfaces = 0;
+  vector<pugi::xml_node> surf_nodes;
   for (pugi::xml_node surf_node : node.children("surface")) {
-    n_surfaces++;
+    surf_nodes.push_back(surf_node);
   }
 
-  // Loop over XML surface elements and populate the array.  Keep track of
-  // periodic surfaces and their albedos.
-  model::surfaces.reserve(n_surfaces);
+  // Surfaces only read their own XML element, so they are created in parallel
+  // for models with many surfaces. Exceptions cannot leave a parallel region
+  // and are reported where they occur.
+  int n_surfaces = surf_nodes.size();
+  model::surfaces.resize(n_surfaces);
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int i_surf = 0; i_surf < n_surfaces; ++i_surf) {
+    try {
+      model::surfaces[i_surf] = make_surface(surf_nodes[i_surf]);
+    } catch (const std::exception& e) {
+      fatal_error(e.what());
+    }
+  }
+
+  // Keep track of periodic surfaces and their albedos
   std::set<std::pair<int, int>> periodic_pairs;
   std::unordered_map<int, double> albedo_map;
-  {
-    pugi::xml_node surf_node;
-    int i_surf;
-    for (surf_node = node.child("surface"), i_surf = 0; surf_node;
-         surf_node = surf_node.next_sibling("surface"), i_surf++) {
-      std::string surf_type = get_node_value(surf_node, "type", true, true);
-
-      // Allocate and initialize the new surface
-
-      if (surf_type == "x-plane") {
-        model::surfaces.push_back(make_unique<SurfaceXPlane>(surf_node));
-
-      } else if (surf_type == "y-plane") {
-        model::surfaces.push_back(make_unique<SurfaceYPlane>(surf_node));
-
-      } else if (surf_type == "z-plane") {
-        model::surfaces.push_back(make_unique<SurfaceZPlane>(surf_node));
-
-      } else if (surf_type == "plane") {
-        model::surfaces.push_back(make_unique<SurfacePlane>(surf_node));
-
-      } else if (surf_type == "x-cylinder") {
-        model::surfaces.push_back(make_unique<SurfaceXCylinder>(surf_node));
-
-      } else if (surf_type == "y-cylinder") {
-        model::surfaces.push_back(make_unique<SurfaceYCylinder>(surf_node));
-
-      } else if (surf_type == "z-cylinder") {
-        model::surfaces.push_back(make_unique<SurfaceZCylinder>(surf_node));
-
-      } else if (surf_type == "sphere") {
-        model::surfaces.push_back(make_unique<SurfaceSphere>(surf_node));
-
-      } else if (surf_type == "x-cone") {
-        model::surfaces.push_back(make_unique<SurfaceXCone>(surf_node));
-
-      } else if (surf_type == "y-cone") {
-        model::surfaces.push_back(make_unique<SurfaceYCone>(surf_node));
-
-      } else if (surf_type == "z-cone") {
-        model::surfaces.push_back(make_unique<SurfaceZCone>(surf_node));
-
-      } else if (surf_type == "quadric") {
-        model::surfaces.push_back(make_unique<SurfaceQuadric>(surf_node));
-
-      } else if (surf_type == "x-torus") {
-        model::surfaces.push_back(std::make_unique<SurfaceXTorus>(surf_node));
-
-      } else if (surf_type == "y-torus") {
-        model::surfaces.push_back(std::make_unique<SurfaceYTorus>(surf_node));
-
-      } else if (surf_type == "z-torus") {
-        model::surfaces.push_back(std::make_unique<SurfaceZTorus>(surf_node));
-
-      } else {
-        fatal_error(fmt::format("Invalid surface type, \"{}\"", surf_type));
-      }
-
-      // Check for a periodic surface
-      if (check_for_node(surf_node, "boundary")) {
-        std::string surf_bc = get_node_value(surf_node, "boundary", true, true);
-        if (surf_bc == "periodic") {
-          // Check for surface albedo. Skip sanity check as it is already done
-          // in the Surface class's constructor.
-          if (check_for_node(surf_node, "albedo")) {
-            albedo_map[model::surfaces.back()->id_] =
-              std::stod(get_node_value(surf_node, "albedo"));
-          }
-          if (check_for_node(surf_node, "periodic_surface_id")) {
-            int i_periodic =
-              std::stoi(get_node_value(surf_node, "periodic_surface_id"));
-            int lo_id = std::min(model::surfaces.back()->id_, i_periodic);
-            int hi_id = std::max(model::surfaces.back()->id_, i_periodic);
-            periodic_pairs.insert({lo_id, hi_id});
-          } else {
-            periodic_pairs.insert({model::surfaces.back()->id_, -1});
-          }
+  for (int i_surf = 0; i_surf < n_surfaces; ++i_surf) {
+    pugi::xml_node surf_node = surf_nodes[i_surf];
+
+    // Check for a periodic surface
+    if (check_for_node(surf_node, "boundary")) {
+      std::string surf_bc = get_node_value(surf_node, "boundary", true, true);
+      if (surf_bc == "periodic") {
+        // Check for surface albedo. Skip sanity check as it is already done
+        // in the Surface class's constructor.
+        if (check_for_node(surf_node, "albedo")) {
+          albedo_map[model::surfaces[i_surf]->id_] =
+            std::stod(get_node_value(surf_node, "albedo"));
+        }
+        if (check_for_node(surf_node, "periodic_surface_id")) {
+          int i_periodic =
+            std::stoi(get_node_value(surf_node, "periodic_surface_id"));
+          int lo_id = std::min(model::surfaces[i_surf]->id_, i_periodic);
+          int hi_id = std::max(model::surfaces[i_surf]->id_, i_periodic);
+          periodic_pairs.insert({lo_id, hi_id});
+        } else {
+          periodic_pairs.insert({model::surfaces[i_surf]->id_, -1});
         }
       }
     }
@@ -1343,12 +1202,43 @@ void read_surfaces(pugi::xml_node node)
       surf2.bc_->set_albedo(albedo_map[surf2.id_]);
     }
   }
+
+  pack_surfaces();
+}
+
+void pack_surfaces()
+{
+  model::packed_surfaces.clear();
+  model::packed_surfaces.reserve(model::surfaces.size());
+  for (const auto& surf : model::surfaces) {
+    PackedSurface packed;
+    const auto* s = surf.get();
+    if (const auto* p = dynamic_cast<const SurfaceXPlane*>(s)) {
+      packed = {SurfaceKind::X_PLANE, {p->x0_}};
+    } else if (const auto* p = dynamic_cast<const SurfaceYPlane*>(s)) {
+      packed = {SurfaceKind::Y_PLANE, {p->y0_}};
+    } else if (const auto* p = dynamic_cast<const SurfaceZPlane*>(s)) {
+      packed = {SurfaceKind::Z_PLANE, {p->z0_}};
+    } else if (const auto* p = dynamic_cast<const SurfacePlane*>(s)) {
+      packed = {SurfaceKind::PLANE, {p->A_, p->B_, p->C_, p->D_}};
+    } else if (const auto* p = dynamic_cast<const SurfaceXCylinder*>(s)) {
+      packed = {SurfaceKind::X_CYLINDER, {p->y0_, p->z0_, p->radius_}};
+    } else if (const auto* p = dynamic_cast<const SurfaceYCylinder*>(s)) {
+      packed = {SurfaceKind::Y_CYLINDER, {p->x0_, p->z0_, p->radius_}};
+    } else if (const auto* p = dynamic_cast<const SurfaceZCylinder*>(s)) {
+      packed = {SurfaceKind::Z_CYLINDER, {p->x0_, p->y0_, p->radius_}};
+    } else if (const auto* p = dynamic_cast<const SurfaceSphere*>(s)) {
+      packed = {SurfaceKind::SPHERE, {p->x0_, p->y0_, p->z0_, p->radius_}};
+    }
+    model::packed_surfaces.push_back(packed);
+  }
 }
 
 void free_memory_surfaces()
 {
   model::surfaces.clear();
   model::surface_map.clear();
+  model::packed_surfaces.clear();
 }
 
 } // namespace openmc
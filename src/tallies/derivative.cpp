@@ -1,8 +1,10 @@
 #include "openmc/tallies/derivative.h"
 
+#include "openmc/array.h"
 #include "openmc/error.h"
 #include "openmc/material.h"
 #include "openmc/nuclide.h"
+#include "openmc/openmp_interface.h"
 #include "openmc/settings.h"
 #include "openmc/tallies/tally.h"
 #include "openmc/xml_interface.h"
@@ -20,8 +22,108 @@ namespace openmc {
 namespace model {
 std::unordered_map<int, int> tally_deriv_map;
 vector<TallyDerivative> tally_derivs;
+vector<vector<int>> material_derivs;
 } // namespace model
 
+namespace {
+
+//==============================================================================
+//! Derivatives with respect to temperature of the microscopic cross sections
+//! of the nuclides of a material at one energy, with their sums over the
+//! nuclides. They are evaluated once for each event and shared by all the
+//! derivatives and scores of the event.
+//==============================================================================
+
+struct TemperatureDerivs {
+  int material {C_NONE}; //!< Index of the material, or C_NONE if unset
+  double E {-1.0};       //!< Energy in [eV] of the derivatives
+  double sqrtkT {-1.0};  //!< Square root of kT in [eV] of the derivatives
+
+  //! Whether each nuclide of the material has multipole data at E
+  vector<bool> in_range;
+  //! Derivatives of the scattering, absorption, and fission cross sections
+  vector<array<double, 3>> dsig;
+
+  // Macroscopic derivatives summed over the nuclides in the multipole range
+  // that have a nonzero cross section for the reaction
+  double flux;       //!< Total, over all nuclides in range
+  double total;      //!< Total
+  double scatter;    //!< Scattering
+  double absorption; //!< Absorption
+  double fission;    //!< Fission
+  double nu_fission; //!< Fission neutron production
+};
+
+//! Derivatives of the event being scored on each thread
+vector<TemperatureDerivs> temperature_derivs_cache;
+
+//! Temperature derivatives of the nuclides of the particle's material at
+//! energy E, which are only evaluated when the material, energy, or
+//! temperature differs from the last call on this thread
+
+const TemperatureDerivs& temperature_derivs(
+  const Particle& p, const Material& material, double E)
+{
+  auto& td = temperature_derivs_cache[thread_num()];
+  if (td.material == p.material() && td.E == E && td.sqrtkT == p.sqrtkT())
+    return td;
+
+  td.material = p.material();
+  td.E = E;
+  td.sqrtkT = p.sqrtkT();
+  int n = material.nuclide_.size();
+  td.in_range.assign(n, false);
+  td.dsig.assign(n, {0.0, 0.0, 0.0});
+  td.flux = 0.0;
+  td.total = 0.0;
+  td.scatter = 0.0;
+  td.absorption = 0.0;
+  td.fission = 0.0;
+  td.nu_fission = 0.0;
+
+  for (int i = 0; i < n; ++i) {
+    auto i_nuc = material.nuclide_[i];
+    const auto& nuc {*data::nuclides[i_nuc]};
+    if (!multipole_in_range(nuc, E))
+      continue;
+    double dsig_s, dsig_a, dsig_f;
+    std::tie(dsig_s, dsig_a, dsig_f) =
+      nuc.multipole_->evaluate_deriv(E, p.sqrtkT());
+    td.in_range[i] = true;
+    td.dsig[i] = {dsig_s, dsig_a, dsig_f};
+
+    double N = material.atom_density_(i);
+    const auto& micro {p.neutron_xs(i_nuc)};
+    td.flux += (dsig_s + dsig_a) * N;
+    if (micro.total)
+      td.total += (dsig_s + dsig_a) * N;
+    if (micro.total - micro.absorption)
+      td.scatter += dsig_s * N;
+    if (micro.absorption)
+      td.absorption += dsig_a * N;
+    if (micro.fission) {
+      td.fission += dsig_f * N;
+      td.nu_fission += micro.nu_fission / micro.fission * dsig_f * N;
+    }
+  }
+  return td;
+}
+
+//! Index of a nuclide in the material, checking that it is present
+
+int nuclide_index(const Material& material, int i_nuclide, int deriv_id)
+{
+  int i = material.mat_nuclide_index_[i_nuclide];
+  if (i == C_NONE) {
+    fatal_error(fmt::format(
+      "Could not find nuclide {} in material {} for tally derivative {}",
+      data::nuclides[i_nuclide]->name_, material.id_, deriv_id));
+  }
+  return i;
+}
+
+} // namespace
+
 //==============================================================================
 // TallyDerivative implementation
 //==============================================================================
@@ -95,6 +197,22 @@ void read_tally_derivatives(pugi::xml_node node)
     fatal_error("Differential tallies not supported in multi-group mode");
 }
 
+void init_material_derivs()
+{
+  model::material_derivs.clear();
+  temperature_derivs_cache.clear();
+  if (model::tally_derivs.empty())
+    return;
+
+  model::material_derivs.resize(model::materials.size());
+  for (int i = 0; i < model::tally_derivs.size(); ++i) {
+    auto it = model::material_map.find(model::tally_derivs[i].diff_material);
+    if (it != model::material_map.end())
+      model::material_derivs[it->second].push_back(i);
+  }
+  temperature_derivs_cache.resize(num_threads());
+}
+
 void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
   double atom_density, int score_bin, double& score)
 {
@@ -191,11 +309,7 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
       case SCORE_ABSORPTION:
       case SCORE_FISSION:
       case SCORE_NU_FISSION: {
-        // Find the index of the perturbed nuclide.
-        int i;
-        for (i = 0; i < material.nuclide_.size(); ++i)
-          if (material.nuclide_[i] == deriv.diff_nuclide)
-            break;
+        int i = nuclide_index(material, deriv.diff_nuclide, deriv.id);
         score *= flux_deriv + 1. / material.atom_density_(i);
       } break;
 
@@ -300,78 +414,57 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
 
     case TallyEstimator::ANALOG: {
       // Find the index of the event nuclide.
-      int i;
-      for (i = 0; i < material.nuclide_.size(); ++i)
-        if (material.nuclide_[i] == p.event_nuclide())
-          break;
-
-      const auto& nuc {*data::nuclides[p.event_nuclide()]};
-      if (!multipole_in_range(nuc, p.E_last())) {
+      int i = material.mat_nuclide_index_[p.event_nuclide()];
+      const auto& td = temperature_derivs(p, material, p.E_last());
+      if (i == C_NONE || !td.in_range[i]) {
         score *= flux_deriv;
         break;
       }
+      const auto& micro {p.neutron_xs(p.event_nuclide())};
+      double dsig_s = td.dsig[i][0];
+      double dsig_a = td.dsig[i][1];
+      double dsig_f = td.dsig[i][2];
+      double N = material.atom_density_(i);
 
       switch (score_bin) {
 
       case SCORE_TOTAL:
-        if (p.neutron_xs(p.event_nuclide()).total) {
-          double dsig_s, dsig_a, dsig_f;
-          std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
-          score *= flux_deriv + (dsig_s + dsig_a) * material.atom_density_(i) /
-                                  p.macro_xs().total;
+        if (micro.total) {
+          score *= flux_deriv + (dsig_s + dsig_a) * N / p.macro_xs().total;
         } else {
           score *= flux_deriv;
         }
         break;
 
       case SCORE_SCATTER:
-        if (p.neutron_xs(p.event_nuclide()).total -
-            p.neutron_xs(p.event_nuclide()).absorption) {
-          double dsig_s, dsig_a, dsig_f;
-          std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
-          score *=
-            flux_deriv + dsig_s * material.atom_density_(i) /
-                           (p.macro_xs().total - p.macro_xs().absorption);
+        if (micro.total - micro.absorption) {
+          score *= flux_deriv + dsig_s * N / (p.macro_xs().total -
+                                               p.macro_xs().absorption);
         } else {
           score *= flux_deriv;
         }
         break;
 
       case SCORE_ABSORPTION:
-        if (p.neutron_xs(p.event_nuclide()).absorption) {
-          double dsig_s, dsig_a, dsig_f;
-          std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
-          score *= flux_deriv +
-                   dsig_a * material.atom_density_(i) / p.macro_xs().absorption;
+        if (micro.absorption) {
+          score *= flux_deriv + dsig_a * N / p.macro_xs().absorption;
         } else {
           score *= flux_deriv;
         }
         break;
 
       case SCORE_FISSION:
-        if (p.neutron_xs(p.event_nuclide()).fission) {
-          double dsig_s, dsig_a, dsig_f;
-          std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
-          score *= flux_deriv +
-                   dsig_f * material.atom_density_(i) / p.macro_xs().fission;
+        if (micro.fission) {
+          score *= flux_deriv + dsig_f * N / p.macro_xs().fission;
         } else {
           score *= flux_deriv;
         }
         break;
 
       case SCORE_NU_FISSION:
-        if (p.neutron_xs(p.event_nuclide()).fission) {
-          double nu = p.neutron_xs(p.event_nuclide()).nu_fission /
-                      p.neutron_xs(p.event_nuclide()).fission;
-          double dsig_s, dsig_a, dsig_f;
-          std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
-          score *= flux_deriv + nu * dsig_f * material.atom_density_(i) /
-                                  p.macro_xs().nu_fission;
+        if (micro.fission) {
+          double nu = micro.nu_fission / micro.fission;
+          score *= flux_deriv + nu * dsig_f * N / p.macro_xs().nu_fission;
         } else {
           score *= flux_deriv;
         }
@@ -383,37 +476,37 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
       }
     } break;
 
-    case TallyEstimator::COLLISION:
+    case TallyEstimator::COLLISION: {
+      const auto& td = temperature_derivs(p, material, p.E_last());
+
+      // Derivatives of the cross sections of the scored nuclide, which are
+      // evaluated here if it is not in the material
+      double dsig_s = 0.0;
+      double dsig_a = 0.0;
+      double dsig_f = 0.0;
       if (i_nuclide != -1) {
-        const auto& nuc {data::nuclides[i_nuclide]};
-        if (!multipole_in_range(*nuc, p.E_last())) {
+        const auto& nuc {*data::nuclides[i_nuclide]};
+        if (!multipole_in_range(nuc, p.E_last())) {
           score *= flux_deriv;
           return;
         }
+        int i = material.mat_nuclide_index_[i_nuclide];
+        if (i != C_NONE) {
+          dsig_s = td.dsig[i][0];
+          dsig_a = td.dsig[i][1];
+          dsig_f = td.dsig[i][2];
+        } else {
+          std::tie(dsig_s, dsig_a, dsig_f) =
+            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+        }
       }
 
       switch (score_bin) {
 
       case SCORE_TOTAL:
         if (i_nuclide == -1 && p.macro_xs().total > 0.0) {
-          double cum_dsig = 0;
-          for (auto i = 0; i < material.nuclide_.size(); ++i) {
-            auto i_nuc = material.nuclide_[i];
-            const auto& nuc {*data::nuclides[i_nuc]};
-            if (multipole_in_range(nuc, p.E_last()) &&
-                p.neutron_xs(i_nuc).total) {
-              double dsig_s, dsig_a, dsig_f;
-              std::tie(dsig_s, dsig_a, dsig_f) =
-                nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
-              cum_dsig += (dsig_s + dsig_a) * material.atom_density_(i);
-            }
-          }
-          score *= flux_deriv + cum_dsig / p.macro_xs().total;
-        } else if (p.neutron_xs(i_nuclide).total) {
-          const auto& nuc {*data::nuclides[i_nuclide]};
-          double dsig_s, dsig_a, dsig_f;
-          std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+          score *= flux_deriv + td.total / p.macro_xs().total;
+        } else if (i_nuclide != -1 && p.neutron_xs(i_nuclide).total) {
           score *=
             flux_deriv + (dsig_s + dsig_a) / p.neutron_xs(i_nuclide).total;
         } else {
@@ -423,26 +516,10 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
 
       case SCORE_SCATTER:
         if (i_nuclide == -1 && (p.macro_xs().total - p.macro_xs().absorption)) {
-          double cum_dsig = 0;
-          for (auto i = 0; i < material.nuclide_.size(); ++i) {
-            auto i_nuc = material.nuclide_[i];
-            const auto& nuc {*data::nuclides[i_nuc]};
-            if (multipole_in_range(nuc, p.E_last()) &&
-                (p.neutron_xs(i_nuc).total - p.neutron_xs(i_nuc).absorption)) {
-              double dsig_s, dsig_a, dsig_f;
-              std::tie(dsig_s, dsig_a, dsig_f) =
-                nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
-              cum_dsig += dsig_s * material.atom_density_(i);
-            }
-          }
           score *= flux_deriv +
-                   cum_dsig / (p.macro_xs().total - p.macro_xs().absorption);
-        } else if (p.neutron_xs(i_nuclide).total -
-                   p.neutron_xs(i_nuclide).absorption) {
-          const auto& nuc {*data::nuclides[i_nuclide]};
-          double dsig_s, dsig_a, dsig_f;
-          std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+                   td.scatter / (p.macro_xs().total - p.macro_xs().absorption);
+        } else if (i_nuclide != -1 && (p.neutron_xs(i_nuclide).total -
+                                        p.neutron_xs(i_nuclide).absorption)) {
           score *= flux_deriv + dsig_s / (p.neutron_xs(i_nuclide).total -
                                            p.neutron_xs(i_nuclide).absorption);
         } else {
@@ -452,24 +529,8 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
 
       case SCORE_ABSORPTION:
         if (i_nuclide == -1 && p.macro_xs().absorption > 0.0) {
-          double cum_dsig = 0;
-          for (auto i = 0; i < material.nuclide_.size(); ++i) {
-            auto i_nuc = material.nuclide_[i];
-            const auto& nuc {*data::nuclides[i_nuc]};
-            if (multipole_in_range(nuc, p.E_last()) &&
-                p.neutron_xs(i_nuc).absorption) {
-              double dsig_s, dsig_a, dsig_f;
-              std::tie(dsig_s, dsig_a, dsig_f) =
-                nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
-              cum_dsig += dsig_a * material.atom_density_(i);
-            }
-          }
-          score *= flux_deriv + cum_dsig / p.macro_xs().absorption;
-        } else if (p.neutron_xs(i_nuclide).absorption) {
-          const auto& nuc {*data::nuclides[i_nuclide]};
-          double dsig_s, dsig_a, dsig_f;
-          std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+          score *= flux_deriv + td.absorption / p.macro_xs().absorption;
+        } else if (i_nuclide != -1 && p.neutron_xs(i_nuclide).absorption) {
           score *= flux_deriv + dsig_a / p.neutron_xs(i_nuclide).absorption;
         } else {
           score *= flux_deriv;
@@ -478,24 +539,8 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
 
       case SCORE_FISSION:
         if (i_nuclide == -1 && p.macro_xs().fission > 0.0) {
-          double cum_dsig = 0;
-          for (auto i = 0; i < material.nuclide_.size(); ++i) {
-            auto i_nuc = material.nuclide_[i];
-            const auto& nuc {*data::nuclides[i_nuc]};
-            if (multipole_in_range(nuc, p.E_last()) &&
-                p.neutron_xs(i_nuc).fission) {
-              double dsig_s, dsig_a, dsig_f;
-              std::tie(dsig_s, dsig_a, dsig_f) =
-                nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
-              cum_dsig += dsig_f * material.atom_density_(i);
-            }
-          }
-          score *= flux_deriv + cum_dsig / p.macro_xs().fission;
-        } else if (p.neutron_xs(i_nuclide).fission) {
-          const auto& nuc {*data::nuclides[i_nuclide]};
-          double dsig_s, dsig_a, dsig_f;
-          std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+          score *= flux_deriv + td.fission / p.macro_xs().fission;
+        } else if (i_nuclide != -1 && p.neutron_xs(i_nuclide).fission) {
           score *= flux_deriv + dsig_f / p.neutron_xs(i_nuclide).fission;
         } else {
           score *= flux_deriv;
@@ -504,26 +549,8 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
 
       case SCORE_NU_FISSION:
         if (i_nuclide == -1 && p.macro_xs().nu_fission > 0.0) {
-          double cum_dsig = 0;
-          for (auto i = 0; i < material.nuclide_.size(); ++i) {
-            auto i_nuc = material.nuclide_[i];
-            const auto& nuc {*data::nuclides[i_nuc]};
-            if (multipole_in_range(nuc, p.E_last()) &&
-                p.neutron_xs(i_nuc).fission) {
-              double nu =
-                p.neutron_xs(i_nuc).nu_fission / p.neutron_xs(i_nuc).fission;
-              double dsig_s, dsig_a, dsig_f;
-              std::tie(dsig_s, dsig_a, dsig_f) =
-                nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
-              cum_dsig += nu * dsig_f * material.atom_density_(i);
-            }
-          }
-          score *= flux_deriv + cum_dsig / p.macro_xs().nu_fission;
-        } else if (p.neutron_xs(i_nuclide).fission) {
-          const auto& nuc {*data::nuclides[i_nuclide]};
-          double dsig_s, dsig_a, dsig_f;
-          std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+          score *= flux_deriv + td.nu_fission / p.macro_xs().nu_fission;
+        } else if (i_nuclide != -1 && p.neutron_xs(i_nuclide).fission) {
           score *= flux_deriv + dsig_f / p.neutron_xs(i_nuclide).fission;
         } else {
           score *= flux_deriv;
@@ -533,7 +560,7 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
       default:
         break;
       }
-      break;
+    } break;
 
     default:
       fatal_error("Differential tallies are only implemented for analog and "
@@ -549,13 +576,16 @@ void score_track_derivative(Particle& p, double distance)
   if (p.material() == MATERIAL_VOID)
     return;
 
+  // Skip materials that none of the derivatives apply to
+  if (p.material() >= model::material_derivs.size() ||
+      model::material_derivs[p.material()].empty())
+    return;
+
   const Material& material {*model::materials[p.material()]};
 
-  for (auto idx = 0; idx < model::tally_derivs.size(); idx++) {
+  for (auto idx : model::material_derivs[p.material()]) {
     const auto& deriv = model::tally_derivs[idx];
     auto& flux_deriv = p.flux_derivs(idx);
-    if (deriv.diff_material != material.id_)
-      continue;
 
     switch (deriv.variable) {
 
@@ -574,19 +604,10 @@ void score_track_derivative(Particle& p, double distance)
       break;
 
     case DerivativeVariable::TEMPERATURE:
-      for (auto i = 0; i < material.nuclide_.size(); ++i) {
-        const auto& nuc {*data::nuclides[material.nuclide_[i]]};
-        if (multipole_in_range(nuc, p.E_last())) {
-          // phi is proportional to e^(-Sigma_tot * dist)
-          // (1 / phi) * (d_phi / d_T) = - (d_Sigma_tot / d_T) * dist
-          // (1 / phi) * (d_phi / d_T) = - N (d_sigma_tot / d_T) * dist
-          double dsig_s, dsig_a, dsig_f;
-          std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E(), p.sqrtkT());
-          flux_deriv -=
-            distance * (dsig_s + dsig_a) * material.atom_density_(i);
-        }
-      }
+      // phi is proportional to e^(-Sigma_tot * dist)
+      // (1 / phi) * (d_phi / d_T) = - (d_Sigma_tot / d_T) * dist
+      // (1 / phi) * (d_phi / d_T) = - N (d_sigma_tot / d_T) * dist
+      flux_deriv -= distance * temperature_derivs(p, material, p.E()).flux;
       break;
     }
   }
@@ -598,15 +619,17 @@ void score_collision_derivative(Particle& p)
   if (p.material() == MATERIAL_VOID)
     return;
 
+  // Skip materials that none of the derivatives apply to
+  if (p.material() >= model::material_derivs.size() ||
+      model::material_derivs[p.material()].empty())
+    return;
+
   const Material& material {*model::materials[p.material()]};
 
-  for (auto idx = 0; idx < model::tally_derivs.size(); idx++) {
+  for (auto idx : model::material_derivs[p.material()]) {
     const auto& deriv = model::tally_derivs[idx];
     auto& flux_deriv = p.flux_derivs(idx);
 
-    if (deriv.diff_material != material.id_)
-      continue;
-
     switch (deriv.variable) {
 
     case DerivativeVariable::DENSITY:
@@ -616,50 +639,37 @@ void score_collision_derivative(Particle& p)
       flux_deriv += 1. / material.density_gpcc_;
       break;
 
-    case DerivativeVariable::NUCLIDE_DENSITY:
+    case DerivativeVariable::NUCLIDE_DENSITY: {
       if (p.event_nuclide() != deriv.diff_nuclide)
         continue;
-      // Find the index in this material for the diff_nuclide.
-      int i;
-      for (i = 0; i < material.nuclide_.size(); ++i)
-        if (material.nuclide_[i] == deriv.diff_nuclide)
-          break;
-      // Make sure we found the nuclide.
-      if (material.nuclide_[i] != deriv.diff_nuclide) {
-        fatal_error(fmt::format(
-          "Could not find nuclide {} in material {} for tally derivative {}",
-          data::nuclides[deriv.diff_nuclide]->name_, material.id_, deriv.id));
-      }
       // phi is proportional to Sigma_s
       // (1 / phi) * (d_phi / d_N) = (d_Sigma_s / d_N) / Sigma_s
       // (1 / phi) * (d_phi / d_N) = sigma_s / Sigma_s
       // (1 / phi) * (d_phi / d_N) = 1 / N
+      int i = nuclide_index(material, deriv.diff_nuclide, deriv.id);
       flux_deriv += 1. / material.atom_density_(i);
-      break;
+    } break;
 
-    case DerivativeVariable::TEMPERATURE:
-      // Loop over the material's nuclides until we find the event nuclide.
-      for (auto i_nuc : material.nuclide_) {
-        const auto& nuc {*data::nuclides[i_nuc]};
-        if (i_nuc == p.event_nuclide() && multipole_in_range(nuc, p.E_last())) {
-          // phi is proportional to Sigma_s
-          // (1 / phi) * (d_phi / d_T) = (d_Sigma_s / d_T) / Sigma_s
-          // (1 / phi) * (d_phi / d_T) = (d_sigma_s / d_T) / sigma_s
-          const auto& micro_xs {p.neutron_xs(i_nuc)};
-          double dsig_s, dsig_a, dsig_f;
-          std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
-          flux_deriv += dsig_s / (micro_xs.total - micro_xs.absorption);
-          // Note that this is an approximation!  The real scattering cross
-          // section is
-          // Sigma_s(E'->E, u'->u) = Sigma_s(E') * P(E'->E, u'->u).
-          // We are assuming that d_P(E'->E, u'->u) / d_T = 0 and only
-          // computing d_S(E') / d_T.  Using this approximation in the vicinity
-          // of low-energy resonances causes errors (~2-5% for PWR pincell
-          // eigenvalue derivatives).
-        }
+    case DerivativeVariable::TEMPERATURE: {
+      int i = material.mat_nuclide_index_[p.event_nuclide()];
+      if (i == C_NONE)
+        continue;
+      const auto& td = temperature_derivs(p, material, p.E_last());
+      if (td.in_range[i]) {
+        // phi is proportional to Sigma_s
+        // (1 / phi) * (d_phi / d_T) = (d_Sigma_s / d_T) / Sigma_s
+        // (1 / phi) * (d_phi / d_T) = (d_sigma_s / d_T) / sigma_s
+        const auto& micro_xs {p.neutron_xs(p.event_nuclide())};
+        flux_deriv += td.dsig[i][0] / (micro_xs.total - micro_xs.absorption);
+        // Note that this is an approximation!  The real scattering cross
+        // section is
+        // Sigma_s(E'->E, u'->u) = Sigma_s(E') * P(E'->E, u'->u).
+        // We are assuming that d_P(E'->E, u'->u) / d_T = 0 and only
+        // computing d_S(E') / d_T.  Using this approximation in the vicinity
+        // of low-energy resonances causes errors (~2-5% for PWR pincell
+        // eigenvalue derivatives).
       }
-      break;
+    } break;
     }
   }
 }
@@ -19,6 +19,7 @@
 #include "openmc/tallies/filter_distribcell.h"
 #include "openmc/tallies/filter_energy.h"
 #include "openmc/tallies/filter_energyfunc.h"
+#include "openmc/tallies/filter_energyresponse.h"
 #include "openmc/tallies/filter_legendre.h"
 #include "openmc/tallies/filter_material.h"
 #include "openmc/tallies/filter_materialfrom.h"
@@ -113,6 +114,8 @@ Filter* Filter::create(const std::string& type, int32_t id)
     return Filter::create<DelayedGroupFilter>(id);
   } else if (type == "energyfunction") {
     return Filter::create<EnergyFunctionFilter>(id);
+  } else if (type == "energyresponse") {
+    return Filter::create<EnergyResponseFilter>(id);
   } else if (type == "energy") {
     return Filter::create<EnergyFilter>(id);
   } else if (type == "collision") {
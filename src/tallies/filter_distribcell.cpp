@@ -38,6 +38,13 @@ void DistribcellFilter::set_cell(int32_t cell)
 void DistribcellFilter::get_all_bins(
   const Particle& p, TallyEstimator estimator, FilterMatch& match) const
 {
+  // The instance of the cell the particle is in is already known
+  if (cell_ == p.lowest_coord().cell) {
+    match.bins_.push_back(p.cell_instance());
+    match.weights_.push_back(1.0);
+    return;
+  }
+
   int offset = 0;
   auto distribcell_index = model::cells[cell_]->distribcell_index_;
   for (int i = 0; i < p.n_coord(); i++) {
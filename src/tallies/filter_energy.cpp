@@ -1,5 +1,9 @@
 #include "openmc/tallies/filter_energy.h"
 
+#include <algorithm> // for max
+#include <cmath>     // for log
+#include <map>
+
 #include <fmt/core.h>
 
 #include "openmc/capi.h"
@@ -11,6 +15,20 @@
 
 namespace openmc {
 
+namespace {
+
+//! Number of bins from which the bins are searched with a guide table
+constexpr int MIN_GUIDE_BINS {16};
+
+//! Number of guide table cells per bin. Each cell of a uniform lethargy
+//! structure then falls in a single bin.
+constexpr int GUIDE_CELLS_PER_BIN {4};
+
+//! Guide tables of the bin structures in use, keyed by their bin edges
+std::map<vector<double>, std::weak_ptr<const GuideTable>> log_guides;
+
+} // namespace
+
 //==============================================================================
 // EnergyFilter implementation
 //==============================================================================
@@ -54,6 +72,38 @@ void EnergyFilter::set_bins(gsl::span<const double> bins)
       }
     }
   }
+
+  // Index the bins on an equal-lethargy grid, as done for the energy grids of
+  // nuclides, so that finding a bin takes constant expected time. Energies
+  // below the lowest positive edge all fall in the first bin, which allows a
+  // lower edge of zero.
+  log_guide_.reset();
+  if (n_bins_ < MIN_GUIDE_BINS || bins_[1] <= 0.0)
+    return;
+  double E_lower = bins_[0] > 0.0 ? bins_[0] : bins_[1];
+  log_lower_ = std::log(E_lower);
+  inv_log_width_ = 1.0 / (std::log(bins_.back()) - log_lower_);
+
+  auto& guide = log_guides[bins_];
+  log_guide_ = guide.lock();
+  if (!log_guide_) {
+    vector<double> u(bins_.size());
+    for (gsl::index i = 0; i < bins_.size(); ++i) {
+      double x = (std::log(bins_[i]) - log_lower_) * inv_log_width_;
+      u[i] = bins_[i] > 0.0 ? std::max(x, 0.0) : 0.0;
+    }
+    log_guide_ = std::make_shared<const GuideTable>(
+      u, GUIDE_CELLS_PER_BIN * n_bins_);
+    guide = log_guide_;
+  }
+}
+
+int EnergyFilter::find_bin(double E) const
+{
+  if (!log_guide_)
+    return lower_bound_index(bins_.begin(), bins_.end(), E);
+  double r = E > 0.0 ? (std::log(E) - log_lower_) * inv_log_width_ : -1.0;
+  return log_guide_->find(bins_, bins_.size(), E, r);
 }
 
 void EnergyFilter::get_all_bins(
@@ -73,8 +123,7 @@ void EnergyFilter::get_all_bins(
 
     // Bin the energy.
     if (E >= bins_.front() && E <= bins_.back()) {
-      auto bin = lower_bound_index(bins_.begin(), bins_.end(), E);
-      match.bins_.push_back(bin);
+      match.bins_.push_back(this->find_bin(E));
       match.weights_.push_back(1.0);
     }
   }
@@ -104,8 +153,7 @@ void EnergyoutFilter::get_all_bins(
 
   } else {
     if (p.E() >= bins_.front() && p.E() <= bins_.back()) {
-      auto bin = lower_bound_index(bins_.begin(), bins_.end(), p.E());
-      match.bins_.push_back(bin);
+      match.bins_.push_back(this->find_bin(p.E()));
       match.weights_.push_back(1.0);
     }
   }
@@ -0,0 +1,151 @@
+#include "openmc/tallies/filter_energyresponse.h"
+
+#include <algorithm> // for min
+#include <stdexcept>
+
+#include <fmt/core.h>
+#include "xtensor/xtensor.hpp"
+
+#include "openmc/error.h"
+#include "openmc/hdf5_interface.h"
+#include "openmc/search.h"
+#include "openmc/settings.h"
+#include "openmc/xml_interface.h"
+
+namespace openmc {
+
+void EnergyResponseFilter::from_xml(pugi::xml_node node)
+{
+  if (!settings::run_CE)
+    fatal_error("EnergyResponse filters are only supported for "
+                "continuous-energy transport calculations");
+
+  if (!check_for_node(node, "energy"))
+    fatal_error("Energy grid not specified for EnergyResponse filter.");
+  auto energy = get_node_array<double>(node, "energy");
+
+  if (!check_for_node(node, "responses"))
+    fatal_error("Responses not specified for EnergyResponse filter.");
+  auto responses = get_node_array<double>(node, "responses");
+
+  // default to multigroup responses
+  auto interpolation = Interpolation::histogram;
+  if (check_for_node(node, "interpolation")) {
+    std::string interp = get_node_value(node, "interpolation");
+    if (interp == "linear-linear") {
+      interpolation = Interpolation::lin_lin;
+    } else if (interp != "histogram") {
+      fatal_error(fmt::format("Found invalid interpolation type '{}' on "
+                              "EnergyResponseFilter {}.",
+        interp, this->id()));
+    }
+  }
+
+  try {
+    this->set_data(energy, responses, interpolation);
+  } catch (const std::exception& e) {
+    fatal_error(fmt::format("EnergyResponseFilter {}: {}", id(), e.what()));
+  }
+}
+
+void EnergyResponseFilter::set_data(gsl::span<const double> energy,
+  gsl::span<const double> responses, Interpolation interpolation)
+{
+  if (interpolation != Interpolation::histogram &&
+      interpolation != Interpolation::lin_lin) {
+    throw std::runtime_error {
+      "Responses must use histogram or linear-linear interpolation."};
+  }
+  if (energy.size() < 2) {
+    throw std::runtime_error {"Energy grid must have at least two values."};
+  }
+  for (gsl::index i = 1; i < energy.size(); ++i) {
+    if (energy[i] <= energy[i - 1]) {
+      throw std::runtime_error {
+        "Energy bins must be monotonically increasing."};
+    }
+  }
+
+  // Multigroup responses have one value per group and pointwise responses
+  // have one value per grid energy
+  int n_values = (interpolation == Interpolation::histogram)
+                   ? energy.size() - 1
+                   : energy.size();
+  if (responses.empty() || responses.size() % n_values != 0) {
+    throw std::runtime_error {fmt::format(
+      "Number of response values ({}) is not a multiple of the {} values "
+      "of each response.",
+      responses.size(), n_values)};
+  }
+  int n_responses = responses.size() / n_values;
+
+  energy_.assign(energy.begin(), energy.end());
+  values_.resize(responses.size());
+  for (int i = 0; i < n_responses; ++i) {
+    for (int g = 0; g < n_values; ++g) {
+      values_[g * n_responses + i] = responses[i * n_values + g];
+    }
+  }
+  interpolation_ = interpolation;
+  n_bins_ = n_responses;
+}
+
+void EnergyResponseFilter::get_all_bins(
+  const Particle& p, TallyEstimator estimator, FilterMatch& match) const
+{
+  double E = p.E_last();
+  if (E < energy_.front() || E > energy_.back())
+    return;
+
+  // Find the group or grid interval once for all responses
+  int n = energy_.size();
+  int g = std::min<int>(
+    lower_bound_index(energy_.begin(), energy_.end(), E), n - 2);
+  const double* v0 = &values_[g * n_bins_];
+
+  if (interpolation_ == Interpolation::histogram) {
+    for (int i = 0; i < n_bins_; ++i) {
+      if (v0[i] != 0.0) {
+        match.bins_.push_back(i);
+        match.weights_.push_back(v0[i]);
+      }
+    }
+  } else {
+    const double* v1 = v0 + n_bins_;
+    double f = (E - energy_[g]) / (energy_[g + 1] - energy_[g]);
+    for (int i = 0; i < n_bins_; ++i) {
+      double w = v0[i] + f * (v1[i] - v0[i]);
+      if (w != 0.0) {
+        match.bins_.push_back(i);
+        match.weights_.push_back(w);
+      }
+    }
+  }
+}
+
+void EnergyResponseFilter::to_statepoint(hid_t filter_group) const
+{
+  Filter::to_statepoint(filter_group);
+  write_dataset(filter_group, "energy", energy_);
+
+  // Responses are written with one row per response
+  int n_values = values_.size() / n_bins_;
+  xt::xtensor<double, 2> responses({static_cast<size_t>(n_bins_),
+    static_cast<size_t>(n_values)});
+  for (int i = 0; i < n_bins_; ++i) {
+    for (int g = 0; g < n_values; ++g) {
+      responses(i, g) = values_[g * n_bins_ + i];
+    }
+  }
+  write_dataset(filter_group, "responses", responses);
+  write_dataset(filter_group, "interpolation",
+    interpolation_ == Interpolation::histogram ? "histogram" : "linear-linear");
+}
+
+std::string EnergyResponseFilter::text_label(int bin) const
+{
+  return fmt::format("Energy Response {} on [{:.1e}, {:.1e}] eV", bin,
+    energy_.front(), energy_.back());
+}
+
+} // namespace openmc
@@ -24,12 +24,7 @@ void LegendreFilter::set_order(int order)
 void LegendreFilter::get_all_bins(
   const Particle& p, TallyEstimator estimator, FilterMatch& match) const
 {
-  vector<double> wgt(n_bins_);
-  calc_pn_c(order_, p.mu(), wgt.data());
-  for (int i = 0; i < n_bins_; i++) {
-    match.bins_.push_back(i);
-    match.weights_.push_back(wgt[i]);
-  }
+  calc_pn_c(order_, p.mu(), match.append_bins(n_bins_));
 }
 
 void LegendreFilter::to_statepoint(hid_t filter_group) const
@@ -46,30 +46,32 @@ void SphericalHarmonicsFilter::set_cosine(gsl::cstring_span cosine)
 void SphericalHarmonicsFilter::get_all_bins(
   const Particle& p, TallyEstimator estimator, FilterMatch& match) const
 {
-  // Determine cosine term for scatter expansion if necessary
-  vector<double> wgt(order_ + 1);
-  if (cosine_ == SphericalHarmonicsCosine::scatter) {
-    calc_pn_c(order_, p.mu(), wgt.data());
-  } else {
-    for (int i = 0; i < order_ + 1; i++) {
-      wgt[i] = 1;
-    }
-  }
+  // Find the Rn,m values directly in the weights of the match
+  double* rn = match.append_bins(n_bins_);
+  calc_rn(order_, p.u_last(), rn);
 
-  // Find the Rn,m values
-  vector<double> rn(n_bins_);
-  calc_rn(order_, p.u_last(), rn.data());
-
-  int j = 0;
-  for (int n = 0; n < order_ + 1; n++) {
-    // Calculate n-th order spherical harmonics for (u,v,w)
-    int num_nm = 2 * n + 1;
-
-    // Append the matching (bin,weight) for each moment
-    for (int i = 0; i < num_nm; i++) {
-      match.weights_.push_back(wgt[n] * rn[j]);
-      match.bins_.push_back(j);
-      ++j;
+  // Multiply by the cosine term for scatter expansion if necessary, with the
+  // Legendre polynomials found by the same recursion as calc_pn_c
+  if (cosine_ == SphericalHarmonicsCosine::scatter) {
+    double mu = p.mu();
+    double pn_last = 0.0;
+    double pn = 1.0;
+    int j = 0;
+    for (int n = 0; n < order_ + 1; n++) {
+      if (n == 1) {
+        pn_last = pn;
+        pn = mu;
+      } else if (n > 1) {
+        double next = ((2 * n - 1) * mu * pn - (n - 1) * pn_last) / n;
+        pn_last = pn;
+        pn = next;
+      }
+
+      // Each order has 2n + 1 moments
+      for (int i = 0; i < 2 * n + 1; i++) {
+        rn[j] *= pn;
+        ++j;
+      }
     }
   }
 }
@@ -77,13 +77,8 @@ void SpatialLegendreFilter::get_all_bins(
     // Compute the normalized coordinate value.
     double x_norm = 2.0 * (x - min_) / (max_ - min_) - 1.0;
 
-    // Compute and return the Legendre weights.
-    vector<double> wgt(order_ + 1);
-    calc_pn_c(order_, x_norm, wgt.data());
-    for (int i = 0; i < order_ + 1; i++) {
-      match.bins_.push_back(i);
-      match.weights_.push_back(wgt[i]);
-    }
+    // Compute the Legendre weights directly into the match.
+    calc_pn_c(order_, x_norm, match.append_bins(order_ + 1));
   }
 }
 
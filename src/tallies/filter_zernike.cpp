@@ -36,13 +36,8 @@ void ZernikeFilter::get_all_bins(
   double theta = std::atan2(y, x);
 
   if (r <= 1.0) {
-    // Compute and return the Zernike weights.
-    vector<double> zn(n_bins_);
-    calc_zn(order_, r, theta, zn.data());
-    for (int i = 0; i < n_bins_; i++) {
-      match.bins_.push_back(i);
-      match.weights_.push_back(zn[i]);
-    }
+    // Compute the Zernike weights directly into the match.
+    calc_zn(order_, r, theta, match.append_bins(n_bins_));
   }
 }
 
@@ -91,13 +86,8 @@ void ZernikeRadialFilter::get_all_bins(
   double r = std::sqrt(x * x + y * y) / r_;
 
   if (r <= 1.0) {
-    // Compute and return the Zernike weights.
-    vector<double> zn(n_bins_);
-    calc_zn_rad(order_, r, zn.data());
-    for (int i = 0; i < n_bins_; i++) {
-      match.bins_.push_back(i);
-      match.weights_.push_back(zn[i]);
-    }
+    // Compute the Zernike weights directly into the match.
+    calc_zn_rad(order_, r, match.append_bins(n_bins_));
   }
 }
 
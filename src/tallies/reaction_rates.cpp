@@ -0,0 +1,281 @@
+#include "openmc/tallies/reaction_rates.h"
+
+#include <algorithm> // for find, is_sorted, min
+#include <stdexcept> // for out_of_range
+
+#include "xtensor/xbuilder.hpp"
+#include <fmt/core.h>
+
+#include "openmc/capi.h"
+#include "openmc/constants.h"
+#include "openmc/error.h"
+#include "openmc/material.h"
+#include "openmc/message_passing.h"
+#include "openmc/nuclide.h"
+#include "openmc/search.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+ReactionRates reaction_rates;
+
+} // namespace simulation
+
+//==============================================================================
+// ReactionRates implementation
+//==============================================================================
+
+void ReactionRates::set(vector<int32_t> materials, vector<int> nuclides,
+  vector<int> reactions, vector<double> energies)
+{
+  materials_ = std::move(materials);
+  nuclides_ = std::move(nuclides);
+  reactions_ = std::move(reactions);
+  energies_ = std::move(energies);
+
+  material_index_.assign(model::materials.size(), C_NONE);
+  for (int i = 0; i < materials_.size(); ++i) {
+    material_index_[materials_[i]] = i;
+  }
+
+  nuclide_index_.assign(data::nuclides.size(), C_NONE);
+  for (int i = 0; i < nuclides_.size(); ++i) {
+    nuclide_index_[nuclides_[i]] = i;
+  }
+
+  // Rates accumulated directly are read from the cached microscopic cross
+  // sections, so the depletion reactions need to be calculated with them
+  rx_index_.clear();
+  for (auto mt : reactions_) {
+    auto it = std::find(DEPLETION_RX.begin(), DEPLETION_RX.end(), mt);
+    if (it == DEPLETION_RX.end()) {
+      rx_index_.push_back(C_NONE);
+    } else {
+      rx_index_.push_back(it - DEPLETION_RX.begin());
+      if (!this->collapse())
+        simulation::need_depletion_rx = true;
+    }
+  }
+
+  size_t n_mat = materials_.size();
+  size_t n_nuc = this->collapse() ? 0 : nuclides_.size();
+  size_t n_rx = reactions_.size();
+  size_t n_groups = this->n_groups();
+  rate_values_ = xt::zeros<double>({n_mat, n_nuc, n_rx});
+  rate_sum_ = xt::zeros<double>({n_mat, n_nuc, n_rx});
+  flux_values_ = xt::zeros<double>({n_mat, n_groups});
+  flux_sum_ = xt::zeros<double>({n_mat, n_groups});
+  n_realizations_ = 0;
+}
+
+void ReactionRates::clear()
+{
+  this->set({}, {}, {}, {});
+  active_ = false;
+}
+
+void ReactionRates::reset()
+{
+  rate_values_.fill(0.0);
+  rate_sum_.fill(0.0);
+  flux_values_.fill(0.0);
+  flux_sum_.fill(0.0);
+  n_realizations_ = 0;
+}
+
+void ReactionRates::score_tracklength(Particle& p, double distance)
+{
+  if (p.type() != ParticleType::neutron || p.material() == MATERIAL_VOID)
+    return;
+  int i_mat = material_index_[p.material()];
+  if (i_mat == C_NONE)
+    return;
+
+  double flux = p.wgt() * distance;
+
+  // With flux collapse, only the flux in the particle's energy group is needed
+  if (this->collapse()) {
+    double E = p.E();
+    if (E < energies_.front() || E > energies_.back())
+      return;
+    int g = std::min<int>(
+      lower_bound_index(energies_.begin(), energies_.end(), E), n_groups() - 1);
+#pragma omp atomic
+    flux_values_(i_mat, g) += flux;
+    return;
+  }
+
+#pragma omp atomic
+  flux_values_(i_mat, 0) += flux;
+
+  // Read the microscopic cross sections of each selected nuclide in the
+  // material, which were calculated before the particle moved
+  const auto& mat {*model::materials[p.material()]};
+  int n_rx = reactions_.size();
+  for (auto i_nuclide : mat.nuclide_) {
+    int i_nuc = nuclide_index_[i_nuclide];
+    if (i_nuc == C_NONE)
+      continue;
+
+    const auto& micro = p.neutron_xs(i_nuclide);
+    for (int k = 0; k < n_rx; ++k) {
+      int m = rx_index_[k];
+      double xs = (m == C_NONE) ? micro.fission : micro.reaction[m];
+#pragma omp atomic
+      rate_values_(i_mat, i_nuc, k) += xs * flux;
+    }
+  }
+}
+
+void ReactionRates::accumulate(double norm)
+{
+#ifdef OPENMC_MPI
+  // Every process keeps the combined results so that they can be read from
+  // any of them
+  if (mpi::n_procs > 1) {
+    MPI_Allreduce(MPI_IN_PLACE, rate_values_.data(), rate_values_.size(),
+      MPI_DOUBLE, MPI_SUM, mpi::intracomm);
+    MPI_Allreduce(MPI_IN_PLACE, flux_values_.data(), flux_values_.size(),
+      MPI_DOUBLE, MPI_SUM, mpi::intracomm);
+  }
+#endif
+
+  ++n_realizations_;
+  rate_sum_ += norm * rate_values_;
+  flux_sum_ += norm * flux_values_;
+  rate_values_.fill(0.0);
+  flux_values_.fill(0.0);
+}
+
+void ReactionRates::rates(double* rates) const
+{
+  int n_nuc = nuclides_.size();
+  int n_rx = reactions_.size();
+  double n = n_realizations_ > 0 ? n_realizations_ : 1.0;
+
+  if (!this->collapse()) {
+    for (int i = 0; i < rate_sum_.size(); ++i) {
+      rates[i] = rate_sum_.data()[i] / n;
+    }
+    return;
+  }
+
+  vector<double> flux(n_groups());
+  for (int i = 0; i < materials_.size(); ++i) {
+    for (int g = 0; g < flux.size(); ++g) {
+      flux[g] = flux_sum_(i, g) / n;
+    }
+    double T = model::materials[materials_[i]]->temperature();
+    for (int j = 0; j < n_nuc; ++j) {
+      const auto& nuc {*data::nuclides[nuclides_[j]]};
+      for (int k = 0; k < n_rx; ++k) {
+        rates[(i * n_nuc + j) * n_rx + k] =
+          nuc.collapse_rate(reactions_[k], T, energies_, flux);
+      }
+    }
+  }
+}
+
+void ReactionRates::flux(double* flux) const
+{
+  double n = n_realizations_ > 0 ? n_realizations_ : 1.0;
+  for (int i = 0; i < flux_sum_.size(); ++i) {
+    flux[i] = flux_sum_.data()[i] / n;
+  }
+}
+
+//==============================================================================
+// C API functions
+//==============================================================================
+
+extern "C" int openmc_reaction_rates_set(int n_materials,
+  const int32_t* materials, int n_nuclides, const int* nuclides,
+  int n_reactions, const int* reactions, int n_energies, const double* energies)
+{
+  if (!settings::run_CE) {
+    set_errmsg("Reaction rates can only be accumulated in continuous-energy "
+               "mode.");
+    return OPENMC_E_INVALID_ARGUMENT;
+  }
+
+  for (int i = 0; i < n_materials; ++i) {
+    if (materials[i] < 0 || materials[i] >= model::materials.size()) {
+      set_errmsg("Index in materials array is out of bounds.");
+      return OPENMC_E_OUT_OF_BOUNDS;
+    }
+  }
+  for (int i = 0; i < n_nuclides; ++i) {
+    if (nuclides[i] < 0 || nuclides[i] >= data::nuclides.size()) {
+      set_errmsg("Index in nuclides array is out of bounds.");
+      return OPENMC_E_OUT_OF_BOUNDS;
+    }
+  }
+
+  if (n_energies == 1 ||
+      (n_energies > 1 && !std::is_sorted(energies, energies + n_energies))) {
+    set_errmsg("Energy group boundaries must contain at least two values in "
+               "increasing order.");
+    return OPENMC_E_INVALID_ARGUMENT;
+  }
+
+  // Without flux collapse, only reactions whose cross sections are cached
+  // during transport can be accumulated
+  for (int i = 0; i < n_reactions; ++i) {
+    bool cached = reactions[i] == N_FISSION ||
+                  std::find(DEPLETION_RX.begin(), DEPLETION_RX.end(),
+                    reactions[i]) != DEPLETION_RX.end();
+    if (reactions[i] <= 0 || (n_energies == 0 && !cached)) {
+      set_errmsg(fmt::format("Reaction with MT={} cannot be accumulated "
+                             "without energy group boundaries.",
+        reactions[i]));
+      return OPENMC_E_INVALID_ARGUMENT;
+    }
+  }
+
+  simulation::reaction_rates.set({materials, materials + n_materials},
+    {nuclides, nuclides + n_nuclides}, {reactions, reactions + n_reactions},
+    {energies, energies + n_energies});
+  return 0;
+}
+
+extern "C" int openmc_reaction_rates_get(double* rates)
+{
+  if (!simulation::reaction_rates.configured()) {
+    set_errmsg("Reaction rates have not been set.");
+    return OPENMC_E_ALLOCATE;
+  }
+
+  try {
+    simulation::reaction_rates.rates(rates);
+  } catch (const std::out_of_range& e) {
+    set_errmsg(e.what());
+    return OPENMC_E_OUT_OF_BOUNDS;
+  }
+  return 0;
+}
+
+extern "C" int openmc_reaction_rates_flux(double* flux)
+{
+  if (!simulation::reaction_rates.configured()) {
+    set_errmsg("Reaction rates have not been set.");
+    return OPENMC_E_ALLOCATE;
+  }
+
+  simulation::reaction_rates.flux(flux);
+  return 0;
+}
+
+extern "C" int openmc_reaction_rates_clear()
+{
+  simulation::reaction_rates.clear();
+  return 0;
+}
+
+} // namespace openmc
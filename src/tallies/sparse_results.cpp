@@ -0,0 +1,204 @@
+#include "openmc/tallies/sparse_results.h"
+
+#include <algorithm> // for copy, fill, min, any_of
+#include <mutex>     // for lock_guard
+
+#include "xtensor/xbuilder.hpp"
+
+#include "openmc/message_passing.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+// SparseResults implementation
+//==============================================================================
+
+SparseResults::~SparseResults()
+{
+  this->init(0, 0);
+}
+
+void SparseResults::init(int32_t n_filter_bins, int n_scores)
+{
+  for (int64_t t = 0; t < n_tiles_; ++t) {
+    delete[] tiles_[t].load();
+  }
+
+  n_filter_bins_ = n_filter_bins;
+  n_scores_ = n_scores;
+  n_tiles_ = (static_cast<int64_t>(n_filter_bins) + TILE_BINS - 1) / TILE_BINS;
+  tiles_ = make_unique<std::atomic<double*>[]>(n_tiles_);
+  for (int64_t t = 0; t < n_tiles_; ++t) {
+    tiles_[t].store(nullptr);
+  }
+}
+
+double* SparseResults::allocate_tile(int64_t t)
+{
+  std::lock_guard<OpenMPMutex> lock(mutex_);
+
+  // Another thread may have allocated the tile while this one was waiting
+  double* tile = tiles_[t].load(std::memory_order_acquire);
+  if (!tile) {
+    tile = new double[tile_length()]();
+    tiles_[t].store(tile, std::memory_order_release);
+  }
+  return tile;
+}
+
+double SparseResults::get(
+  int filter_index, int score_index, TallyResult k) const
+{
+  const double* tile = tiles_[filter_index / TILE_BINS].load();
+  if (!tile)
+    return 0.0;
+  return tile[index(filter_index % TILE_BINS, score_index, k)];
+}
+
+void SparseResults::reset()
+{
+  for (int64_t t = 0; t < n_tiles_; ++t) {
+    double* tile = tiles_[t].load();
+    if (tile)
+      std::fill(tile, tile + tile_length(), 0.0);
+  }
+}
+
+void SparseResults::accumulate(double norm)
+{
+#pragma omp parallel for
+  for (int64_t t = 0; t < n_tiles_; ++t) {
+    double* tile = tiles_[t].load();
+    if (!tile)
+      continue;
+    for (int64_t i = 0; i < tile_length(); i += 3) {
+      double val = tile[i + static_cast<int>(TallyResult::VALUE)] * norm;
+      tile[i + static_cast<int>(TallyResult::VALUE)] = 0.0;
+      tile[i + static_cast<int>(TallyResult::SUM)] += val;
+      tile[i + static_cast<int>(TallyResult::SUM_SQ)] += val * val;
+    }
+  }
+}
+
+void SparseResults::to_dense(xt::xtensor<double, 3>& dense) const
+{
+  dense = xt::zeros<double>({static_cast<size_t>(n_filter_bins_),
+    static_cast<size_t>(n_scores_), static_cast<size_t>(3)});
+
+  // The rows of a tile are stored in the same order as in the dense array
+  int64_t row_length = static_cast<int64_t>(n_scores_) * 3;
+  for (int64_t t = 0; t < n_tiles_; ++t) {
+    const double* tile = tiles_[t].load();
+    if (!tile)
+      continue;
+    int64_t first = t * TILE_BINS;
+    int64_t n_rows = std::min<int64_t>(TILE_BINS, n_filter_bins_ - first);
+    std::copy(
+      tile, tile + n_rows * row_length, dense.data() + first * row_length);
+  }
+}
+
+void SparseResults::from_dense(const xt::xtensor<double, 3>& dense)
+{
+  this->init(n_filter_bins_, n_scores_);
+
+  int64_t row_length = static_cast<int64_t>(n_scores_) * 3;
+  for (int64_t t = 0; t < n_tiles_; ++t) {
+    int64_t first = t * TILE_BINS;
+    int64_t n_rows = std::min<int64_t>(TILE_BINS, n_filter_bins_ - first);
+    const double* begin = dense.data() + first * row_length;
+    const double* end = begin + n_rows * row_length;
+    if (std::any_of(begin, end, [](double x) { return x != 0.0; })) {
+      double* tile = this->allocate_tile(t);
+      std::copy(begin, end, tile);
+    }
+  }
+}
+
+int64_t SparseResults::n_allocated() const
+{
+  int64_t n = 0;
+  for (int64_t t = 0; t < n_tiles_; ++t) {
+    if (tiles_[t].load())
+      ++n;
+  }
+  return n;
+}
+
+double SparseResults::memory() const
+{
+  return this->n_allocated() * tile_length() * sizeof(double) / 1.0e6;
+}
+
+#ifdef OPENMC_MPI
+void SparseResults::allocate_union()
+{
+  vector<unsigned char> allocated(n_tiles_);
+  for (int64_t t = 0; t < n_tiles_; ++t) {
+    allocated[t] = tiles_[t].load() ? 1 : 0;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, allocated.data(), n_tiles_, MPI_UNSIGNED_CHAR,
+    MPI_MAX, mpi::intracomm);
+  for (int64_t t = 0; t < n_tiles_; ++t) {
+    if (allocated[t] && !tiles_[t].load())
+      this->allocate_tile(t);
+  }
+}
+
+void SparseResults::reduce()
+{
+  // Make sure every process has the same set of tiles so that their values
+  // can be reduced as one contiguous array
+  this->allocate_union();
+
+  int64_t n_values = this->n_allocated() * TILE_BINS * n_scores_;
+  vector<double> values(n_values);
+  vector<double> values_reduced(n_values);
+  int64_t j = 0;
+  for (int64_t t = 0; t < n_tiles_; ++t) {
+    const double* tile = tiles_[t].load();
+    if (!tile)
+      continue;
+    for (int64_t i = 0; i < tile_length(); i += 3) {
+      values[j++] = tile[i + static_cast<int>(TallyResult::VALUE)];
+    }
+  }
+
+  MPI_Reduce(values.data(), values_reduced.data(), n_values, MPI_DOUBLE,
+    MPI_SUM, 0, mpi::intracomm);
+
+  // Transfer values on master and reset on other ranks
+  j = 0;
+  for (int64_t t = 0; t < n_tiles_; ++t) {
+    double* tile = tiles_[t].load();
+    if (!tile)
+      continue;
+    for (int64_t i = 0; i < tile_length(); i += 3) {
+      tile[i + static_cast<int>(TallyResult::VALUE)] =
+        mpi::master ? values_reduced[j] : 0.0;
+      ++j;
+    }
+  }
+}
+
+void SparseResults::broadcast()
+{
+  // Non-master processes need a tile wherever the master has one
+  vector<unsigned char> allocated(n_tiles_);
+  for (int64_t t = 0; t < n_tiles_; ++t) {
+    allocated[t] = tiles_[t].load() ? 1 : 0;
+  }
+  MPI_Bcast(allocated.data(), n_tiles_, MPI_UNSIGNED_CHAR, 0, mpi::intracomm);
+
+  // Send one tile at a time to keep the count within the range of an int
+  for (int64_t t = 0; t < n_tiles_; ++t) {
+    if (!allocated[t])
+      continue;
+    double* tile = this->allocate_tile(t);
+    MPI_Bcast(tile, tile_length(), MPI_DOUBLE, 0, mpi::intracomm);
+  }
+}
+#endif
+
+} // namespace openmc
@@ -0,0 +1,149 @@
+#include "openmc/tallies/spatial_index.h"
+
+#include <algorithm> // for min, max, sort, unique
+
+#include "openmc/cell.h"
+#include "openmc/material.h"
+#include "openmc/mesh.h"
+#include "openmc/tallies/filter.h"
+#include "openmc/tallies/filter_cell.h"
+#include "openmc/tallies/filter_material.h"
+#include "openmc/tallies/filter_mesh.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace model {
+
+TallySpatialIndex tracklength_tally_index;
+TallySpatialIndex collision_tally_index;
+
+} // namespace model
+
+//==============================================================================
+// TallySpatialIndex implementation
+//==============================================================================
+
+void TallySpatialIndex::build(
+  const vector<int>& tallies, TallyEstimator estimator)
+{
+  this->clear();
+  tracklength_ = (estimator == TallyEstimator::TRACKLENGTH);
+  by_cell_.resize(model::cells.size());
+  by_material_.resize(model::materials.size());
+
+  for (auto i_tally : tallies) {
+    const auto& tally {*model::tallies[i_tally]};
+
+    // Find the filter that restricts the tally to the smallest domain. A cell
+    // filter is preferred over a material filter, which is preferred over a
+    // mesh filter.
+    const CellFilter* cell_filter = nullptr;
+    const MaterialFilter* material_filter = nullptr;
+    const MeshFilter* mesh_filter = nullptr;
+    for (auto i_filt : tally.filters()) {
+      const auto* filt = model::tally_filters[i_filt].get();
+      switch (filt->type()) {
+      case FilterType::CELL:
+        cell_filter = static_cast<const CellFilter*>(filt);
+        break;
+      case FilterType::MATERIAL:
+        material_filter = static_cast<const MaterialFilter*>(filt);
+        break;
+      case FilterType::MESH:
+        mesh_filter = static_cast<const MeshFilter*>(filt);
+        break;
+      default:
+        break;
+      }
+    }
+
+    if (cell_filter) {
+      for (auto i_cell : cell_filter->cells()) {
+        by_cell_[i_cell].push_back(i_tally);
+      }
+    } else if (material_filter) {
+      for (auto i_mat : material_filter->materials()) {
+        // Void regions never score to a material filter
+        if (i_mat >= 0)
+          by_material_[i_mat].push_back(i_tally);
+      }
+    } else if (mesh_filter) {
+      auto box = model::meshes[mesh_filter->mesh()]->bounding_box();
+      if (mesh_filter->translated()) {
+        const auto& t = mesh_filter->translation();
+        box.xmin += t.x;
+        box.xmax += t.x;
+        box.ymin += t.y;
+        box.ymax += t.y;
+        box.zmin += t.z;
+        box.zmax += t.z;
+      }
+      by_mesh_.emplace_back(i_tally, box);
+    } else {
+      unindexed_.push_back(i_tally);
+    }
+  }
+
+  enabled_ = unindexed_.size() < tallies.size();
+}
+
+void TallySpatialIndex::clear()
+{
+  enabled_ = false;
+  unindexed_.clear();
+  by_cell_.clear();
+  by_material_.clear();
+  by_mesh_.clear();
+}
+
+void TallySpatialIndex::candidates(
+  const Particle& p, vector<int>& tallies) const
+{
+  tallies = unindexed_;
+
+  // A cell filter matches the cell at any level of the geometry
+  for (int j = 0; j < p.n_coord(); ++j) {
+    const auto& v = by_cell_[p.coord(j).cell];
+    tallies.insert(tallies.end(), v.begin(), v.end());
+  }
+
+  if (p.material() != MATERIAL_VOID) {
+    const auto& v = by_material_[p.material()];
+    tallies.insert(tallies.end(), v.begin(), v.end());
+  }
+
+  if (!by_mesh_.empty()) {
+    // Box around the event. A track segment is widened since mesh traversals
+    // locate the starting element slightly ahead of the starting point.
+    Position lo = p.r();
+    Position hi = p.r();
+    if (tracklength_) {
+      const auto& r_last = p.r_last();
+      lo = {std::min(lo.x, r_last.x) - TINY_BIT,
+        std::min(lo.y, r_last.y) - TINY_BIT,
+        std::min(lo.z, r_last.z) - TINY_BIT};
+      hi = {std::max(hi.x, r_last.x) + TINY_BIT,
+        std::max(hi.y, r_last.y) + TINY_BIT,
+        std::max(hi.z, r_last.z) + TINY_BIT};
+    }
+    for (const auto& m : by_mesh_) {
+      const auto& box = m.second;
+      if (lo.x <= box.xmax && hi.x >= box.xmin && lo.y <= box.ymax &&
+          hi.y >= box.ymin && lo.z <= box.zmax && hi.z >= box.zmin)
+        tallies.push_back(m.first);
+    }
+  }
+
+  // Restore the order in which tallies are scored. A tally whose domain
+  // contains more than one of the cells above only needs to be visited once.
+  if (tallies.size() > unindexed_.size()) {
+    std::sort(tallies.begin(), tallies.end());
+    tallies.erase(std::unique(tallies.begin(), tallies.end()), tallies.end());
+  }
+}
+
+} // namespace openmc
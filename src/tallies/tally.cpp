@@ -2,10 +2,12 @@
 
 #include "openmc/array.h"
 #include "openmc/capi.h"
+#include "openmc/cell.h"
 #include "openmc/constants.h"
 #include "openmc/container_util.h"
 #include "openmc/error.h"
 #include "openmc/file_utils.h"
+#include "openmc/memory_report.h"
 #include "openmc/mesh.h"
 #include "openmc/message_passing.h"
 #include "openmc/mgxs_interface.h"
@@ -16,6 +18,8 @@
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
 #include "openmc/source.h"
+#include "openmc/timer.h"
+#include "openmc/weight_windows.h"
 #include "openmc/tallies/derivative.h"
 #include "openmc/tallies/filter.h"
 #include "openmc/tallies/filter_cell.h"
@@ -31,6 +35,8 @@
 #include "openmc/tallies/filter_particle.h"
 #include "openmc/tallies/filter_sph_harm.h"
 #include "openmc/tallies/filter_surface.h"
+#include "openmc/tallies/reaction_rates.h"
+#include "openmc/tallies/spatial_index.h"
 #include "openmc/xml_interface.h"
 
 #include "xtensor/xadapt.hpp"
@@ -38,9 +44,12 @@
 #include "xtensor/xview.hpp"
 #include <fmt/core.h>
 
-#include <algorithm> // for max
+#include <algorithm> // for copy, max, min, fill, sort, nth_element
+#include <cmath>     // for sqrt
 #include <cstddef>   // for size_t
+#include <map>
 #include <string>
+#include <tuple>
 
 namespace openmc {
 
@@ -59,7 +68,9 @@ vector<int> active_collision_tallies;
 vector<int> active_meshsurf_tallies;
 vector<int> active_surface_tallies;
 vector<int> active_pulse_height_tallies;
+int n_filter_groups {0};
 vector<int> pulse_height_cells;
+vector<int> pulse_height_index;
 } // namespace model
 
 namespace simulation {
@@ -101,6 +112,33 @@ Tally::Tally(pugi::xml_node node)
     multiply_density_ = get_node_value_bool(node, "multiply_density");
   }
 
+  if (check_for_node(node, "thread_private")) {
+    thread_private_ = get_node_value_bool(node, "thread_private");
+  }
+
+  if (check_for_node(node, "sparse_storage")) {
+    sparse_storage_ = get_node_value_bool(node, "sparse_storage");
+  }
+
+  if (check_for_node(node, "partitioned")) {
+    partitioned_ = get_node_value_bool(node, "partitioned");
+  }
+
+  if (check_for_node(node, "figure_of_merit")) {
+    figure_of_merit_ = get_node_value_bool(node, "figure_of_merit");
+  }
+
+  if (check_for_node(node, "precision")) {
+    std::string precision = get_node_value(node, "precision", true, true);
+    if (precision == "single") {
+      single_precision_ = true;
+    } else if (precision != "double") {
+      fatal_error(fmt::format(
+        "Invalid precision '{}' on tally {}. Must be 'single' or 'double'.",
+        precision, id_));
+    }
+  }
+
   // =======================================================================
   // READ DATA FOR FILTERS
 
@@ -316,20 +354,6 @@ Tally::Tally(pugi::xml_node node)
         fmt::format("Invalid estimator '{}' on tally {}", est, id_)};
     }
   }
-
-#ifdef LIBMESH
-  // ensure a tracklength tally isn't used with a libMesh filter
-  for (auto i : this->filters_) {
-    auto df = dynamic_cast<MeshFilter*>(model::tally_filters[i].get());
-    if (df) {
-      auto lm = dynamic_cast<LibMesh*>(model::meshes[df->mesh()].get());
-      if (lm && estimator_ == TallyEstimator::TRACKLENGTH) {
-        fatal_error("A tracklength estimator cannot be used with "
-                    "an unstructured LibMesh tally.");
-      }
-    }
-  }
-#endif
 }
 
 Tally::~Tally()
@@ -696,6 +720,15 @@ void Tally::init_triggers(pugi::xml_node node)
       ignore_zeros = get_node_value_bool(trigger_node, "ignore_zeros");
     }
 
+    // Read the fraction of the bins that must satisfy the threshold.
+    double fraction = 1.0;
+    if (check_for_node(trigger_node, "fraction")) {
+      fraction = std::stod(get_node_value(trigger_node, "fraction"));
+      if (fraction <= 0.0 || fraction > 1.0) {
+        fatal_error("Tally trigger fraction must be in (0, 1]");
+      }
+    }
+
     // Read the trigger scores.
     vector<std::string> trigger_scores;
     if (check_for_node(trigger_node, "scores")) {
@@ -709,7 +742,8 @@ void Tally::init_triggers(pugi::xml_node node)
       if (score_str == "all") {
         triggers_.reserve(triggers_.size() + this->scores_.size());
         for (auto i_score = 0; i_score < this->scores_.size(); ++i_score) {
-          triggers_.push_back({metric, threshold, ignore_zeros, i_score});
+          triggers_.push_back(
+            {metric, threshold, ignore_zeros, i_score, fraction});
         }
       } else {
         int i_score = 0;
@@ -723,7 +757,8 @@ void Tally::init_triggers(pugi::xml_node node)
                         "{} but it was listed in a trigger on that tally",
               score_str, id_));
         }
-        triggers_.push_back({metric, threshold, ignore_zeros, i_score});
+        triggers_.push_back(
+          {metric, threshold, ignore_zeros, i_score, fraction});
       }
     }
   }
@@ -732,54 +767,272 @@ void Tally::init_triggers(pugi::xml_node node)
 void Tally::init_results()
 {
   int n_scores = scores_.size() * nuclides_.size();
+
+  single_values_.clear();
+  if (single_precision_ &&
+      (sparse_storage_ || (partitioned_ && mpi::n_procs > 1))) {
+    warning(fmt::format("Tally {} uses sparse storage or is partitioned, so "
+                        "single-precision values will not be used.",
+      id_));
+  }
+
+  // Divide the filter bins of partitioned tallies evenly among processes
+  if (partitioned_ && mpi::n_procs > 1) {
+    if (!settings::reduce_tallies || sparse_storage_ ||
+        settings::solver_type == SolverType::RANDOM_RAY) {
+      fatal_error(fmt::format("Partitioned tally {} cannot be used when "
+                              "tallies are not reduced, with sparse storage, "
+                              "or with the random ray solver.",
+        id_));
+    }
+    if (!triggers_.empty() || figure_of_merit_) {
+      fatal_error(fmt::format(
+        "Partitioned tally {} cannot have triggers or a figure of merit.",
+        id_));
+    }
+    const auto* mesh_filter = this->get_filter<MeshFilter>();
+    if (!mesh_filter || dynamic_cast<const UnstructuredMesh*>(
+                          model::meshes[mesh_filter->mesh()].get())) {
+      fatal_error(fmt::format("Partitioned tally {} requires a mesh filter "
+                              "with a structured mesh.",
+        id_));
+    }
+    if (thread_private_) {
+      warning(fmt::format("Tally {} is partitioned, so thread-private "
+                          "results will not be used.",
+        id_));
+    }
+    thread_results_.clear();
+
+    bin_offsets_.resize(mpi::n_procs + 1);
+    for (int r = 0; r <= mpi::n_procs; ++r) {
+      bin_offsets_[r] = static_cast<int64_t>(n_filter_bins_) * r / mpi::n_procs;
+    }
+    bin_begin_ = bin_offsets_[mpi::rank];
+    size_t n_owned = bin_offsets_[mpi::rank + 1] - bin_begin_;
+    results_ = xt::empty<double>({n_owned, static_cast<size_t>(n_scores), 3});
+    remote_scores_.assign(num_threads(), {});
+    return;
+  }
+  partitioned_ = false;
+
+  // With sparse storage, tiles of results are allocated as bins are scored and
+  // the dense array is only created when it needs to be read
+  if (sparse_storage_) {
+    if (!settings::reduce_tallies) {
+      fatal_error(fmt::format("Sparse storage for tally {} is not supported "
+                              "when tallies are not reduced.",
+        id_));
+    }
+    if (settings::solver_type == SolverType::RANDOM_RAY) {
+      fatal_error(fmt::format(
+        "Sparse storage for tally {} is not supported by the random ray "
+        "solver.",
+        id_));
+    }
+    if (thread_private_) {
+      warning(fmt::format("Tally {} uses sparse storage, so thread-private "
+                          "results will not be used.",
+        id_));
+    }
+    thread_results_.clear();
+    sparse_results_.init(n_filter_bins_, n_scores);
+    this->release_results();
+    return;
+  }
+
   results_ = xt::empty<double>({n_filter_bins_, n_scores, 3});
+
+  // Allocate a private copy of the values for each thread as long as they fit
+  // within the memory limit. Otherwise, scores are added atomically. Current
+  // tallies on regular meshes have few bins that every thread scores into
+  // repeatedly, so they get private copies unless those would not fit.
+  thread_results_.clear();
+  if ((thread_private_ || current_filter_ != C_NONE) && num_threads() > 1) {
+    int64_t n_values = static_cast<int64_t>(n_filter_bins_) * n_scores;
+    double memory = num_threads() * n_values * sizeof(double) / 1.0e6;
+    if (memory <= settings::tally_private_memory) {
+      // Each thread touches its own copy first so that its pages are placed
+      // on the NUMA node of the thread
+      thread_results_.resize(num_threads());
+#pragma omp parallel
+      thread_results_[thread_num()].assign(n_values, 0.0);
+    } else if (thread_private_) {
+      warning(fmt::format("Thread-private results for tally {} would require "
+                          "{:.1f} MB, which exceeds the limit of {:.1f} MB. "
+                          "Using atomic updates instead.",
+        id_, memory, settings::tally_private_memory));
+    }
+  }
+
+  // Scoring into single-precision values halves the memory traffic of the
+  // atomic updates. They are promoted to double precision once per batch.
+  if (single_precision_) {
+    if (thread_results_.empty()) {
+      int64_t n_values = static_cast<int64_t>(n_filter_bins_) * n_scores;
+      single_values_.assign(n_values, 0.0f);
+    } else {
+      warning(fmt::format("Tally {} uses thread-private results, so "
+                          "single-precision values will not be used.",
+        id_));
+    }
+  }
 }
 
 void Tally::reset()
 {
   n_realizations_ = 0;
+  changed_rows_.clear();
+  fom_history_.clear();
+  fom_time_ = 0.0;
+  // Results are first touched here, so they are zeroed by all threads to
+  // spread their pages over the NUMA nodes instead of placing them all on the
+  // node of the master thread
   if (results_.size() != 0) {
-    xt::view(results_, xt::all()) = 0.0;
+    double* values = results_.data();
+    int64_t n = results_.size();
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < n; ++i) {
+      values[i] = 0.0;
+    }
+  }
+  for (auto& values : thread_results_) {
+    std::fill(values.begin(), values.end(), 0.0);
+  }
+  for (auto& scores : remote_scores_) {
+    scores.clear();
+  }
+  std::fill(single_values_.begin(), single_values_.end(), 0.0f);
+  if (sparse_storage_) {
+    sparse_results_.reset();
   }
 }
 
-void Tally::accumulate()
+void Tally::reduce_thread_results()
 {
-  // Increment number of realizations
-  n_realizations_ += settings::reduce_tallies ? 1 : mpi::n_procs;
+  if (!single_values_.empty()) {
+    int n_scores = results_.shape()[1];
+#pragma omp parallel for
+    for (int i = 0; i < results_.shape()[0]; ++i) {
+      for (int j = 0; j < n_scores; ++j) {
+        int64_t k = static_cast<int64_t>(i) * n_scores + j;
+        results_(i, j, TallyResult::VALUE) += single_values_[k];
+        single_values_[k] = 0.0f;
+      }
+    }
+  }
 
-  if (mpi::master || !settings::reduce_tallies) {
-    // Calculate total source strength for normalization
-    double total_source = 0.0;
-    if (settings::run_mode == RunMode::FIXED_SOURCE) {
-      for (const auto& s : model::external_sources) {
-        total_source += s->strength();
+  if (thread_results_.empty())
+    return;
+
+  int n_scores = results_.shape()[1];
+#pragma omp parallel for
+  for (int i = 0; i < results_.shape()[0]; ++i) {
+    for (int j = 0; j < n_scores; ++j) {
+      int64_t k = static_cast<int64_t>(i) * n_scores + j;
+      for (auto& values : thread_results_) {
+        results_(i, j, TallyResult::VALUE) += values[k];
+        values[k] = 0.0;
       }
-    } else {
-      total_source = 1.0;
     }
+  }
+}
+
+void Tally::accumulate(const double* values, double norm)
+{
+  ++n_realizations_;
+
+  if (mpi::master) {
+    int64_t n_scores = results_.shape()[1];
+    bool track = !changed_rows_.empty();
+#pragma omp parallel for
+    for (int i = 0; i < results_.shape()[0]; ++i) {
+      bool changed = false;
+      for (int j = 0; j < n_scores; ++j) {
+        double val = values[i * n_scores + j] * norm;
+        results_(i, j, TallyResult::SUM) += val;
+        results_(i, j, TallyResult::SUM_SQ) += val * val;
+        changed |= (val != 0.0);
+      }
+      if (track && changed)
+        changed_rows_[i] = 1;
+    }
+  }
+}
+
+void Tally::accumulate()
+{
+  // Increment number of realizations
+  n_realizations_ += settings::reduce_tallies ? 1 : mpi::n_procs;
 
-    // Account for number of source particles in normalization
-    double norm =
-      total_source / (settings::n_particles * settings::gen_per_batch);
+  // Each process accumulates the bins it owns for partitioned tallies
+  if (mpi::master || !settings::reduce_tallies || partitioned_) {
+    double norm = batch_normalization();
 
     if (settings::solver_type == SolverType::RANDOM_RAY) {
       norm = 1.0;
     }
 
-// Accumulate each result
+    if (sparse_storage_) {
+      sparse_results_.accumulate(norm);
+      return;
+    }
+
+    // Accumulate each result, noting which bins changed
+    bool track = !changed_rows_.empty();
 #pragma omp parallel for
     for (int i = 0; i < results_.shape()[0]; ++i) {
+      bool changed = false;
       for (int j = 0; j < results_.shape()[1]; ++j) {
         double val = results_(i, j, TallyResult::VALUE) * norm;
         results_(i, j, TallyResult::VALUE) = 0.0;
         results_(i, j, TallyResult::SUM) += val;
         results_(i, j, TallyResult::SUM_SQ) += val * val;
+        changed |= (val != 0.0);
       }
+      if (track && changed)
+        changed_rows_[i] = 1;
     }
   }
 }
 
+void Tally::record_figure_of_merit(double time)
+{
+  fom_time_ += time;
+  int n = n_realizations_;
+  if (n < 2 || fom_time_ <= 0.0)
+    return;
+
+  // Relative error of each bin with contributions
+  int n_scores = scores_.size() * nuclides_.size();
+  vector<double> rel_err;
+  for (int i = 0; i < n_filter_bins_; ++i) {
+    for (int j = 0; j < n_scores; ++j) {
+      double sum = this->result(i, j, TallyResult::SUM);
+      if (sum == 0.0)
+        continue;
+      double sum_sq = this->result(i, j, TallyResult::SUM_SQ);
+      double mean = sum / n;
+      double variance = std::max(sum_sq / n - mean * mean, 0.0) / (n - 1);
+      rel_err.push_back(std::sqrt(variance) / std::abs(mean));
+    }
+  }
+  if (rel_err.empty())
+    return;
+
+  FigureOfMerit fom;
+  fom.batch = simulation::current_batch;
+  fom.time = fom_time_;
+  fom.max_rel_err = *std::max_element(rel_err.begin(), rel_err.end());
+  auto median = rel_err.begin() + rel_err.size() / 2;
+  std::nth_element(rel_err.begin(), median, rel_err.end());
+  fom.median_rel_err = *median;
+  fom.value = fom.max_rel_err > 0.0
+                ? 1.0 / (fom.max_rel_err * fom.max_rel_err * fom_time_)
+                : INFTY;
+  fom_history_.push_back(fom);
+}
+
 int Tally::score_index(const std::string& score) const
 {
   for (int i = 0; i < scores_.size(); i++) {
@@ -789,6 +1042,164 @@ int Tally::score_index(const std::string& score) const
   return -1;
 }
 
+void Tally::materialize_results()
+{
+  if (sparse_storage_)
+    sparse_results_.to_dense(results_);
+
+  // Make room for the bins of all processes, which are filled by
+  // gather_results() or by reading a state point
+  if (partitioned_ && results_.shape()[0] != n_filter_bins_) {
+    xt::xtensor<double, 3> all = xt::zeros<double>(
+      {static_cast<size_t>(n_filter_bins_), results_.shape()[1], 3});
+    xt::view(all, xt::range(bin_begin_, bin_begin_ + results_.shape()[0]),
+      xt::all(), xt::all()) = results_;
+    results_ = std::move(all);
+  }
+}
+
+void Tally::release_results()
+{
+  if (sparse_storage_)
+    results_ = xt::empty<double>({0, 0, 3});
+
+  // Only keep the bins owned by this process
+  if (partitioned_ && results_.shape()[0] == n_filter_bins_) {
+    int64_t bin_end = bin_offsets_[mpi::rank + 1];
+    results_ = xt::eval(xt::view(
+      results_, xt::range(bin_begin_, bin_end), xt::all(), xt::all()));
+  }
+}
+
+double Tally::memory() const
+{
+  return results_.size() * sizeof(double) / 1.0e6 +
+         sparse_results_.memory() + vector_memory(changed_rows_) +
+         vector_memory(thread_results_) + vector_memory(remote_scores_) +
+         vector_memory(single_values_);
+}
+
+void Tally::store_results()
+{
+  if (sparse_storage_) {
+    sparse_results_.from_dense(results_);
+    this->release_results();
+  }
+}
+
+#ifdef OPENMC_MPI
+void Tally::exchange_remote_scores()
+{
+  // Combine the scores of all threads, merging scores to the same bin so that
+  // fewer of them are sent
+  vector<RemoteScore> scores;
+  for (auto& s : remote_scores_) {
+    scores.insert(scores.end(), s.begin(), s.end());
+    s.clear();
+  }
+  std::sort(scores.begin(), scores.end(),
+    [](const RemoteScore& a, const RemoteScore& b) {
+      return a.index < b.index;
+    });
+  size_t n = 0;
+  for (const auto& s : scores) {
+    if (n > 0 && scores[n - 1].index == s.index) {
+      scores[n - 1].value += s.value;
+    } else {
+      scores[n++] = s;
+    }
+  }
+  scores.resize(n);
+
+  // Since the bins of each process are contiguous and in order of rank, the
+  // sorted scores are already grouped by the process that owns them
+  int64_t n_scores = results_.shape()[1];
+  vector<int> send_counts(mpi::n_procs);
+  vector<int> send_displs(mpi::n_procs);
+  vector<int64_t> send_index(n);
+  vector<double> send_value(n);
+  size_t j = 0;
+  for (int r = 0; r < mpi::n_procs; ++r) {
+    send_displs[r] = j;
+    while (j < n && scores[j].index < bin_offsets_[r + 1] * n_scores) {
+      send_index[j] = scores[j].index;
+      send_value[j] = scores[j].value;
+      ++j;
+    }
+    send_counts[r] = j - send_displs[r];
+  }
+
+  vector<int> recv_counts(mpi::n_procs);
+  vector<int> recv_displs(mpi::n_procs);
+  MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT,
+    mpi::intracomm);
+  int n_recv = 0;
+  for (int r = 0; r < mpi::n_procs; ++r) {
+    recv_displs[r] = n_recv;
+    n_recv += recv_counts[r];
+  }
+
+  vector<int64_t> recv_index(n_recv);
+  vector<double> recv_value(n_recv);
+  MPI_Alltoallv(send_index.data(), send_counts.data(), send_displs.data(),
+    MPI_INT64_T, recv_index.data(), recv_counts.data(), recv_displs.data(),
+    MPI_INT64_T, mpi::intracomm);
+  MPI_Alltoallv(send_value.data(), send_counts.data(), send_displs.data(),
+    MPI_DOUBLE, recv_value.data(), recv_counts.data(), recv_displs.data(),
+    MPI_DOUBLE, mpi::intracomm);
+
+  // Add the received scores to the values of the current realization
+  int64_t first = bin_begin_ * n_scores;
+  for (int k = 0; k < n_recv; ++k) {
+    int64_t i = recv_index[k] - first;
+    results_(i / n_scores, i % n_scores, TallyResult::VALUE) += recv_value[k];
+  }
+}
+
+void Tally::gather_results()
+{
+  // Send the results of each process as rows of whole filter bins so that the
+  // counts stay small
+  MPI_Datatype row;
+  MPI_Type_contiguous(results_.shape()[1] * 3, MPI_DOUBLE, &row);
+  MPI_Type_commit(&row);
+  if (mpi::master) {
+    this->materialize_results();
+    size_t row_length = results_.shape()[1] * 3;
+    for (int r = 1; r < mpi::n_procs; ++r) {
+      MPI_Recv(results_.data() + bin_offsets_[r] * row_length,
+        bin_offsets_[r + 1] - bin_offsets_[r], row, r, 0, mpi::intracomm,
+        MPI_STATUS_IGNORE);
+    }
+  } else {
+    MPI_Send(results_.data(), results_.shape()[0], row, 0, 0, mpi::intracomm);
+  }
+  MPI_Type_free(&row);
+}
+
+void Tally::scatter_results()
+{
+  MPI_Datatype row;
+  MPI_Type_contiguous(results_.shape()[1] * 3, MPI_DOUBLE, &row);
+  MPI_Type_commit(&row);
+  if (mpi::master) {
+    this->materialize_results();
+    size_t row_length = results_.shape()[1] * 3;
+    for (int r = 1; r < mpi::n_procs; ++r) {
+      MPI_Send(results_.data() + bin_offsets_[r] * row_length,
+        bin_offsets_[r + 1] - bin_offsets_[r], row, r, 0, mpi::intracomm);
+    }
+    this->release_results();
+  } else {
+    size_t n_owned = bin_offsets_[mpi::rank + 1] - bin_begin_;
+    results_ = xt::empty<double>({n_owned, results_.shape()[1], 3});
+    MPI_Recv(results_.data(), n_owned, row, 0, 0, mpi::intracomm,
+      MPI_STATUS_IGNORE);
+  }
+  MPI_Type_free(&row);
+}
+#endif
+
 xt::xarray<double> Tally::get_reshaped_data() const
 {
   std::vector<uint64_t> shape;
@@ -796,11 +1207,17 @@ xt::xarray<double> Tally::get_reshaped_data() const
     shape.push_back(model::tally_filters[f]->n_bins());
   }
 
+  // Sparse results are copied into a dense array first
+  xt::xtensor<double, 3> dense;
+  if (sparse_storage_)
+    sparse_results_.to_dense(dense);
+  const auto& results = sparse_storage_ ? dense : results_;
+
   // add number of scores and nuclides to tally
-  shape.push_back(results_.shape()[1]);
-  shape.push_back(results_.shape()[2]);
+  shape.push_back(results.shape()[1]);
+  shape.push_back(results.shape()[2]);
 
-  xt::xarray<double> reshaped_results = results_;
+  xt::xarray<double> reshaped_results = results;
   reshaped_results.reshape(shape);
   return reshaped_results;
 }
@@ -866,7 +1283,7 @@ void read_tallies_xml(pugi::xml_node root)
   read_meshes(root);
 
   // We only need the mesh info for plotting
-  if (settings::run_mode == RunMode::PLOTTING)
+  if (geometry_only())
     return;
 
   // Read data for tally derivatives
@@ -896,32 +1313,130 @@ void read_tallies_xml(pugi::xml_node root)
   }
 }
 
+namespace {
+
+//! Values of the last batch of tallies whose accumulation was deferred so that
+//! it can be completed while the next batch is transported
+struct DeferredAccumulation {
+  bool pending {false};
+  vector<int> tallies;   //!< Tallies whose values are in the buffer
+  vector<double> values; //!< Packed values of the batch
+  double norm;           //!< Normalization of the batch
+};
+
+DeferredAccumulation deferred_accumulation;
+
+//! Copy the values of the current realization of tallies into one buffer
+void pack_tally_values(const vector<int>& tallies, vector<double>& buffer)
+{
+  size_t n = 0;
+  for (auto i_tally : tallies) {
+    const auto& results = model::tallies[i_tally]->results_;
+    n += results.shape()[0] * results.shape()[1];
+  }
+  buffer.resize(n);
+
+  double* it = buffer.data();
+  for (auto i_tally : tallies) {
+    auto values_view = xt::view(model::tallies[i_tally]->results_, xt::all(),
+      xt::all(), static_cast<int>(TallyResult::VALUE));
+    it = std::copy(values_view.begin(), values_view.end(), it);
+  }
+}
+
+} // namespace
+
 #ifdef OPENMC_MPI
+namespace {
+
+//! A reduction of tally values that has been started but not completed
+struct PendingReduction {
+  bool in_progress {false};
+  vector<int> tallies;          //!< Tallies whose values are in the buffers
+  vector<double> values;        //!< Packed values of this process
+  vector<double> reduced;       //!< Values summed over processes on master
+  vector<MPI_Request> requests; //!< Requests for each chunk of the buffers
+  double norm;                  //!< Normalization of the reduced batch
+};
+
+PendingReduction pending_reduction;
+
+//! Start reducing the values of tallies without waiting for the reduction to
+//! complete. The values are zeroed so that the next batch can be scored into
+//! them while the reduction proceeds.
+void start_tally_reduction(const vector<int>& tallies)
+{
+  // Only one reduction is in flight at a time
+  finish_tally_reduction();
+
+  auto& r = pending_reduction;
+  r.tallies = tallies;
+  pack_tally_values(r.tallies, r.values);
+  if (mpi::master)
+    r.reduced.resize(r.values.size());
+  r.norm = batch_normalization();
+  for (auto i_tally : r.tallies) {
+    xt::view(model::tallies[i_tally]->results_, xt::all(), xt::all(),
+      static_cast<int>(TallyResult::VALUE)) = 0.0;
+  }
+
+  mpi::reduce_sum(
+    r.values.data(), r.reduced.data(), r.values.size(), &r.requests);
+  r.in_progress = true;
+}
+
+//! Whether tally results are needed at the end of the current batch, in which
+//! case an overlapped reduction has to be completed right away
+bool tally_results_needed()
+{
+  return settings::trigger_on || settings::cmfd_run ||
+         figures_of_merit_needed() ||
+         !variance_reduction::weight_windows_generators.empty() ||
+         contains(settings::statepoint_batch, simulation::current_batch) ||
+         simulation::current_batch >= settings::n_batches;
+}
+
+} // namespace
+
 void reduce_tally_results()
 {
   // Don't reduce tally is no_reduce option is on
   if (settings::reduce_tallies) {
+    // Tallies with sparse storage are reduced on their own and partitioned
+    // tallies already hold complete values for their own bins. Values of all
+    // other tallies are packed into one buffer and reduced together.
+    vector<int> tallies;
     for (int i_tally : model::active_tallies) {
-      // Skip any tallies that are not active
       auto& tally {model::tallies[i_tally]};
+      if (tally->sparse_storage()) {
+        tally->sparse_results_.reduce();
+      } else if (!tally->partitioned()) {
+        tallies.push_back(i_tally);
+      }
+    }
 
-      // Get view of accumulated tally values
-      auto values_view = xt::view(tally->results_, xt::all(), xt::all(),
-        static_cast<int>(TallyResult::VALUE));
-
-      // Make copy of tally values in contiguous array
-      xt::xtensor<double, 2> values = values_view;
-      xt::xtensor<double, 2> values_reduced = xt::empty_like(values);
-
-      // Reduce contiguous set of tally results
-      MPI_Reduce(values.data(), values_reduced.data(), values.size(),
-        MPI_DOUBLE, MPI_SUM, 0, mpi::intracomm);
+    if (settings::overlap_reduction) {
+      start_tally_reduction(tallies);
+    } else {
+      vector<double> values;
+      vector<double> values_reduced;
+      pack_tally_values(tallies, values);
+      if (mpi::master)
+        values_reduced.resize(values.size());
+      mpi::reduce_sum(
+        values.data(), values_reduced.data(), values.size());
 
       // Transfer values on master and reset on other ranks
-      if (mpi::master) {
-        values_view = values_reduced;
-      } else {
-        values_view = 0.0;
+      auto it = values_reduced.begin();
+      for (auto i_tally : tallies) {
+        auto values_view = xt::view(model::tallies[i_tally]->results_,
+          xt::all(), xt::all(), static_cast<int>(TallyResult::VALUE));
+        if (mpi::master) {
+          std::copy(it, it + values_view.size(), values_view.begin());
+          it += values_view.size();
+        } else {
+          values_view = 0.0;
+        }
       }
     }
   }
@@ -959,12 +1474,109 @@ void reduce_tally_results()
 }
 #endif
 
-void accumulate_tallies()
+void finish_tally_reduction()
 {
+#ifdef OPENMC_MPI
+  auto& r = pending_reduction;
+  if (!r.in_progress)
+    return;
+
+  MPI_Waitall(r.requests.size(), r.requests.data(), MPI_STATUSES_IGNORE);
+  r.requests.clear();
+  r.in_progress = false;
+
+  int64_t offset = 0;
+  for (auto i_tally : r.tallies) {
+    auto& tally {*model::tallies[i_tally]};
+    tally.accumulate(mpi::master ? r.reduced.data() + offset : nullptr, r.norm);
+    offset += tally.results_.shape()[0] * tally.results_.shape()[1];
+  }
+  r.tallies.clear();
+#endif
+
+  accumulate_deferred_tallies();
+}
+
+void accumulate_deferred_tallies()
+{
+  auto& d = deferred_accumulation;
+  if (!d.pending)
+    return;
+
+  d.pending = false;
+  int64_t offset = 0;
+  for (auto i_tally : d.tallies) {
+    auto& tally {*model::tallies[i_tally]};
+    tally.accumulate(mpi::master ? d.values.data() + offset : nullptr, d.norm);
+    offset += tally.results_.shape()[0] * tally.results_.shape()[1];
+  }
+  d.tallies.clear();
+}
+
+double batch_normalization()
+{
+  // Calculate total source strength for normalization
+  double total_source = 0.0;
+  if (settings::run_mode == RunMode::FIXED_SOURCE) {
+    for (const auto& s : model::external_sources) {
+      total_source += s->strength();
+    }
+  } else {
+    total_source = 1.0;
+  }
+
+  // Account for number of source particles in normalization
+  return total_source / (settings::n_particles * settings::gen_per_batch);
+}
+
+bool figures_of_merit_needed()
+{
+  for (int i_tally : model::active_tallies) {
+    if (model::tallies[i_tally]->figure_of_merit_)
+      return true;
+  }
+  return false;
+}
+
+void update_figures_of_merit()
+{
+  // Results are only complete on the master process, and a process only holds
+  // its own realizations when tallies are not reduced
+  if (!mpi::master || (!settings::reduce_tallies && mpi::n_procs > 1))
+    return;
+
+  double time = simulation::time_transport.elapsed() -
+                simulation::time_transport_batch;
+  for (int i_tally : model::active_tallies) {
+    auto& tally {*model::tallies[i_tally]};
+    if (tally.figure_of_merit_)
+      tally.record_figure_of_merit(time);
+  }
+}
+
+void accumulate_tallies(bool defer)
+{
+  // Combine thread-private values for each tally
+  for (int i_tally : model::active_tallies) {
+    model::tallies[i_tally]->reduce_thread_results();
+  }
+
+  // Whether values of tallies are accumulated once an overlapped reduction
+  // completes rather than below
+  bool overlapped = false;
+
 #ifdef OPENMC_MPI
   // Combine tally results onto master process
   if (mpi::n_procs > 1 && settings::solver_type == SolverType::MONTE_CARLO) {
+    // Send scores of partitioned tallies to the processes that own their bins
+    for (int i_tally : model::active_tallies) {
+      auto& tally {model::tallies[i_tally]};
+      if (tally->partitioned())
+        tally->exchange_remote_scores();
+    }
+
     reduce_tally_results();
+    overlapped = settings::reduce_tallies && settings::overlap_reduction;
   }
 #endif
 
@@ -999,11 +1611,45 @@ void accumulate_tallies()
     }
   }
 
-  // Accumulate results for each tally
+  // Accumulate results for each tally. Tallies with sparse storage or
+  // partitioned bins are always accumulated right away.
+  vector<int> deferred;
   for (int i_tally : model::active_tallies) {
     auto& tally {model::tallies[i_tally]};
+    bool dense = !tally->sparse_storage() && !tally->partitioned();
+    if (overlapped && dense)
+      continue;
+    if (defer && dense) {
+      deferred.push_back(i_tally);
+      continue;
+    }
     tally->accumulate();
   }
+
+  // Save the values of the deferred tallies and reset them for the next batch
+  if (!deferred.empty()) {
+    auto& d = deferred_accumulation;
+    d.tallies = deferred;
+    if (mpi::master)
+      pack_tally_values(d.tallies, d.values);
+    d.norm = batch_normalization();
+    for (auto i_tally : d.tallies) {
+      xt::view(model::tallies[i_tally]->results_, xt::all(), xt::all(),
+        static_cast<int>(TallyResult::VALUE)) = 0.0;
+    }
+    d.pending = true;
+  }
+
+#ifdef OPENMC_MPI
+  if (overlapped && tally_results_needed()) {
+    finish_tally_reduction();
+  }
+#endif
+
+  // Accumulate reaction rates for depletion
+  if (simulation::reaction_rates.active_) {
+    simulation::reaction_rates.accumulate(batch_normalization());
+  }
 }
 
 void setup_active_tallies()
@@ -1015,12 +1661,51 @@ void setup_active_tallies()
   model::active_meshsurf_tallies.clear();
   model::active_surface_tallies.clear();
   model::active_pulse_height_tallies.clear();
+  simulation::need_element_photon_xs = false;
 
   for (auto i = 0; i < model::tallies.size(); ++i) {
-    const auto& tally {*model::tallies[i]};
+    auto& tally {*model::tallies[i]};
+
+    // Check whether the tally only has reaction rates of specific nuclides
+    tally.nuclide_rates_ = settings::run_CE &&
+                           tally.type_ == TallyType::VOLUME &&
+                           tally.multiply_density() && tally.deriv_ == C_NONE;
+    for (auto i_nuclide : tally.nuclides_) {
+      if (i_nuclide < 0)
+        tally.nuclide_rates_ = false;
+    }
+    for (auto score : tally.scores_) {
+      switch (score) {
+      case SCORE_TOTAL:
+      case SCORE_ABSORPTION:
+      case SCORE_FISSION:
+      case SCORE_NU_FISSION:
+        break;
+      case N_GAMMA:
+      case N_P:
+      case N_A:
+      case N_2N:
+      case N_3N:
+      case N_4N:
+        // Only available when depletion reactions are precalculated
+        if (!simulation::need_depletion_rx)
+          tally.nuclide_rates_ = false;
+        break;
+      default:
+        tally.nuclide_rates_ = false;
+      }
+    }
 
     if (tally.active_) {
       model::active_tallies.push_back(i);
+
+      // Scores of specific nuclides use the photon cross sections of each
+      // element rather than those tabulated for the material
+      for (auto i_nuclide : tally.nuclides_) {
+        if (i_nuclide >= 0)
+          simulation::need_element_photon_xs = true;
+      }
+
       switch (tally.type_) {
 
       case TallyType::VOLUME:
@@ -1029,6 +1714,13 @@ void setup_active_tallies()
           model::active_analog_tallies.push_back(i);
           break;
         case TallyEstimator::TRACKLENGTH:
+          // The distances travelled in each cell of a delta-tracking region
+          // are not known, so collision estimates are scored instead
+          if (!settings::delta_tracking_cells.empty()) {
+            tally.estimator_ = TallyEstimator::COLLISION;
+            model::active_collision_tallies.push_back(i);
+            break;
+          }
           model::active_tracklength_tallies.push_back(i);
           break;
         case TallyEstimator::COLLISION:
@@ -1050,17 +1742,204 @@ void setup_active_tallies()
       }
     }
   }
+
+  // Index the tallies scored at each event by their spatial domain
+  model::tracklength_tally_index.build(
+    model::active_tracklength_tallies, TallyEstimator::TRACKLENGTH);
+  model::collision_tally_index.build(
+    model::active_collision_tallies, TallyEstimator::COLLISION);
+}
+
+namespace {
+
+//! Find the expansion filter with the most bins of a volume tally with a
+//! tracklength or collision estimator. Scores of these tallies are linear in
+//! the filter weight, so one evaluation can be spread over the bins of the
+//! expansion with their weights. Event counts ignore the weight and the
+//! energyout and delayedgroup filters are handled by the scoring itself, so
+//! tallies using them are left out.
+int find_expansion_filter(const Tally& tally)
+{
+  if (tally.type_ != TallyType::VOLUME ||
+      tally.estimator_ == TallyEstimator::ANALOG ||
+      tally.energyout_filter_ != C_NONE || tally.delayedgroup_filter_ != C_NONE)
+    return C_NONE;
+  for (auto score : tally.scores_) {
+    if (score == SCORE_EVENTS)
+      return C_NONE;
+  }
+
+  int i_expansion = C_NONE;
+  int n_bins = 1;
+  for (int i = 0; i < tally.filters().size(); ++i) {
+    const auto& filt = *model::tally_filters[tally.filters(i)];
+    switch (filt.type()) {
+    case FilterType::LEGENDRE:
+    case FilterType::SPATIAL_LEGENDRE:
+    case FilterType::SPHERICAL_HARMONICS:
+    case FilterType::ZERNIKE:
+    case FilterType::ZERNIKE_RADIAL:
+      if (filt.n_bins() > n_bins) {
+        i_expansion = i;
+        n_bins = filt.n_bins();
+      }
+      break;
+    default:
+      break;
+    }
+  }
+  return i_expansion;
+}
+
+//! Find the mesh surface filter of a current tally on a regular mesh. Its
+//! crossings are found by the same traversal as mesh track lengths and are
+//! added to the face bins directly.
+int find_current_filter(const Tally& tally)
+{
+  if (tally.type_ != TallyType::MESH_SURFACE)
+    return C_NONE;
+  for (int i = 0; i < tally.filters().size(); ++i) {
+    const auto* filt = dynamic_cast<const MeshSurfaceFilter*>(
+      model::tally_filters[tally.filters(i)].get());
+    if (filt &&
+        dynamic_cast<const RegularMesh*>(model::meshes[filt->mesh()].get()))
+      return i;
+  }
+  return C_NONE;
+}
+
+//! Find a time filter and a mesh filter on a structured mesh of a tracklength
+//! tally. The part of a track in each combination of their bins is found by
+//! walking the time bin boundaries and mesh crossings together, rather than
+//! as the product of the fractions of the track in each bin found separately.
+//! Tallies with an energyout or delayedgroup filter are left out since their
+//! scoring relies on the current bin of each filter.
+std::pair<int, int> find_time_mesh_filters(const Tally& tally)
+{
+  if (tally.type_ != TallyType::VOLUME ||
+      tally.estimator_ != TallyEstimator::TRACKLENGTH ||
+      tally.energyout_filter_ != C_NONE || tally.delayedgroup_filter_ != C_NONE)
+    return {C_NONE, C_NONE};
+
+  int i_time = C_NONE;
+  int i_mesh = C_NONE;
+  for (int i = 0; i < tally.filters().size(); ++i) {
+    const auto& filt = *model::tally_filters[tally.filters(i)];
+    if (filt.type() == FilterType::TIME) {
+      i_time = i;
+    } else if (filt.type() == FilterType::MESH) {
+      int i_m = static_cast<const MeshFilter&>(filt).mesh();
+      if (dynamic_cast<const StructuredMesh*>(model::meshes[i_m].get()))
+        i_mesh = i;
+    }
+  }
+  if (i_time == C_NONE || i_mesh == C_NONE)
+    return {C_NONE, C_NONE};
+  return {i_time, i_mesh};
+}
+
+} // namespace
+
+void setup_filter_groups()
+{
+  // Tallies of the same type and estimator with identical filters see the same
+  // filter bin combinations for every event. Tallies with an energyout or
+  // delayedgroup filter are left out since scoring them relies on the current
+  // bin of each filter, which is only tracked by a full iteration. Tallies
+  // whose expansion or current filter bins are scored together are left out
+  // as well.
+  using GroupKey = std::tuple<TallyType, TallyEstimator, vector<int32_t>>;
+  std::map<GroupKey, vector<int>> groups;
+  for (auto i = 0; i < model::tallies.size(); ++i) {
+    auto& tally {*model::tallies[i]};
+    tally.filter_group_ = C_NONE;
+    tally.expansion_filter_ = find_expansion_filter(tally);
+    tally.current_filter_ = find_current_filter(tally);
+    std::tie(tally.time_filter_, tally.time_mesh_filter_) =
+      find_time_mesh_filters(tally);
+    if (tally.filters().empty() || tally.energyout_filter_ != C_NONE ||
+        tally.delayedgroup_filter_ != C_NONE ||
+        tally.expansion_filter_ != C_NONE || tally.current_filter_ != C_NONE)
+      continue;
+    groups[{tally.type_, tally.estimator_, tally.filters()}].push_back(i);
+  }
+
+  // Only groups with more than one tally benefit from sharing
+  model::n_filter_groups = 0;
+  for (const auto& group : groups) {
+    if (group.second.size() < 2)
+      continue;
+    for (auto i : group.second) {
+      model::tallies[i]->filter_group_ = model::n_filter_groups;
+    }
+    ++model::n_filter_groups;
+  }
+}
+
+void setup_pulse_height_tallies()
+{
+  model::pulse_height_index.assign(model::cells.size(), C_NONE);
+  for (int i = 0; i < model::pulse_height_cells.size(); ++i) {
+    model::pulse_height_index[model::pulse_height_cells[i]] = i;
+  }
+
+  for (auto& t : model::tallies) {
+    auto& tally {*t};
+    tally.pulse_height_bins_.clear();
+    tally.pulse_height_energy_filters_.clear();
+    if (tally.type_ != TallyType::PULSE_HEIGHT)
+      continue;
+
+    vector<int> cell_filters;
+    for (int i = 0; i < tally.filters().size(); ++i) {
+      auto type = model::tally_filters[tally.filters(i)]->type();
+      if (type == FilterType::CELL) {
+        cell_filters.push_back(i);
+      } else if (type == FilterType::ENERGY) {
+        tally.pulse_height_energy_filters_.push_back(i);
+      }
+    }
+
+    auto cells_of = [&tally](int i) -> const vector<int32_t>& {
+      const auto* filt = model::tally_filters[tally.filters(i)].get();
+      return static_cast<const CellFilter*>(filt)->cells();
+    };
+
+    // Each cell of each cell filter is scored in the bins that all of the cell
+    // filters give it, as if the particle were in that cell
+    for (int i : cell_filters) {
+      for (int32_t cell : cells_of(i)) {
+        int index = model::pulse_height_index[cell];
+        int filter_index = 0;
+        for (int j : cell_filters) {
+          const auto& cells = cells_of(j);
+          auto it = std::find(cells.begin(), cells.end(), cell);
+          if (it == cells.end()) {
+            index = C_NONE;
+            break;
+          }
+          filter_index += (it - cells.begin()) * tally.strides(j);
+        }
+        if (index != C_NONE)
+          tally.pulse_height_bins_.push_back({index, filter_index});
+      }
+    }
+  }
 }
 
 void free_memory_tally()
 {
+  finish_tally_reduction();
+
   model::tally_derivs.clear();
   model::tally_deriv_map.clear();
+  model::material_derivs.clear();
 
   model::tally_filters.clear();
   model::filter_map.clear();
 
   model::tallies.clear();
+  model::pulse_height_index.clear();
 
   model::active_tallies.clear();
   model::active_analog_tallies.clear();
@@ -1069,8 +1948,13 @@ void free_memory_tally()
   model::active_meshsurf_tallies.clear();
   model::active_surface_tallies.clear();
   model::active_pulse_height_tallies.clear();
+  model::tracklength_tally_index.clear();
+  model::collision_tally_index.clear();
+  model::n_filter_groups = 0;
 
   model::tally_map.clear();
+
+  simulation::reaction_rates.clear();
 }
 
 //==============================================================================
@@ -1266,6 +2150,28 @@ extern "C" int openmc_tally_set_multiply_density(int32_t index, bool value)
   return 0;
 }
 
+extern "C" int openmc_tally_get_thread_private(int32_t index, bool* value)
+{
+  if (index < 0 || index >= model::tallies.size()) {
+    set_errmsg("Index in tallies array is out of bounds.");
+    return OPENMC_E_OUT_OF_BOUNDS;
+  }
+  *value = model::tallies[index]->thread_private();
+
+  return 0;
+}
+
+extern "C" int openmc_tally_set_thread_private(int32_t index, bool value)
+{
+  if (index < 0 || index >= model::tallies.size()) {
+    set_errmsg("Index in tallies array is out of bounds.");
+    return OPENMC_E_OUT_OF_BOUNDS;
+  }
+  model::tallies[index]->set_thread_private(value);
+
+  return 0;
+}
+
 extern "C" int openmc_tally_get_scores(int32_t index, int** scores, int* n)
 {
   if (index < 0 || index >= model::tallies.size()) {
@@ -1403,6 +2309,7 @@ extern "C" int openmc_tally_get_n_realizations(int32_t index, int32_t* n)
     return OPENMC_E_OUT_OF_BOUNDS;
   }
 
+  finish_tally_reduction();
   *n = model::tallies[index]->n_realizations_;
   return 0;
 }
@@ -1418,7 +2325,17 @@ extern "C" int openmc_tally_results(
     return OPENMC_E_OUT_OF_BOUNDS;
   }
 
+  // Results of a batch still being reduced are needed
+  finish_tally_reduction();
+
   const auto& t {model::tallies[index]};
+  if (t->partitioned()) {
+    set_errmsg(fmt::format("Results of tally {} are partitioned across "
+                           "processes and can only be read from a state point.",
+      t->id_));
+    return OPENMC_E_INVALID_ARGUMENT;
+  }
+  t->materialize_results();
   if (t->results_.size() == 0) {
     set_errmsg("Tally results have not been allocated yet.");
     return OPENMC_E_ALLOCATE;
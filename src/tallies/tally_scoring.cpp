@@ -5,6 +5,7 @@
 #include "openmc/constants.h"
 #include "openmc/error.h"
 #include "openmc/material.h"
+#include "openmc/mesh.h"
 #include "openmc/mgxs_interface.h"
 #include "openmc/nuclide.h"
 #include "openmc/photon.h"
@@ -18,22 +19,149 @@
 #include "openmc/tallies/filter_cell.h"
 #include "openmc/tallies/filter_delayedgroup.h"
 #include "openmc/tallies/filter_energy.h"
+#include "openmc/tallies/filter_mesh.h"
+#include "openmc/tallies/filter_time.h"
+#include "openmc/tallies/spatial_index.h"
 
+#include <algorithm> // for max, min
 #include <string>
 
 namespace openmc {
 
+namespace {
+
+//! Find the part of a track in each combination of the bins of the time and
+//! mesh filters of a tally. The mesh crossings and the time bin boundaries are
+//! both ordered along the track, so a single merge pass over them gives the
+//! fraction of the track in each combination.
+//
+//! \param tally The tally whose time and mesh filters are combined
+//! \param p The particle being tracked
+//! \param match Receives the part of the filter index from the two filters
+//!   and the fraction of the track for each combination
+void find_time_mesh_bins(const Tally& tally, Particle& p, FilterMatch& match)
+{
+  match.bins_.clear();
+  match.weights_.clear();
+
+  const auto& time_filt = static_cast<const TimeFilter&>(
+    *model::tally_filters[tally.filters(tally.time_filter_)]);
+  const auto& mesh_filt = static_cast<const MeshFilter&>(
+    *model::tally_filters[tally.filters(tally.time_mesh_filter_)]);
+  const auto& times = time_filt.bins();
+
+  // If time interval is entirely out of time bin range, exit
+  double t_start = p.time_last();
+  double t_end = p.time();
+  if (t_end < times.front() || t_start >= times.back())
+    return;
+
+  // Find the mesh bins crossed in order along the track
+  Position r0 = p.r_last();
+  Position r1 = p.r();
+  if (mesh_filt.translated()) {
+    r0 -= mesh_filt.translation();
+    r1 -= mesh_filt.translation();
+  }
+  auto& segments = p.mesh_segments();
+  segments.bins_.clear();
+  segments.starts_.clear();
+  segments.lengths_.clear();
+  const auto& mesh =
+    static_cast<const StructuredMesh&>(*model::meshes[mesh_filt.mesh()]);
+  mesh.segments_crossed(
+    r0, r1, p.u(), segments.bins_, segments.starts_, segments.lengths_);
+
+  int time_stride = tally.strides(tally.time_filter_);
+  int mesh_stride = tally.strides(tally.time_mesh_filter_);
+  int n_times = times.size() - 1;
+  int i_time = std::max<int>(
+    lower_bound_index(times.begin(), times.end(), t_start), 0);
+
+  // A track without duration is in the time bin of its start
+  double dt = t_end - t_start;
+  if (dt == 0.0) {
+    for (int i = 0; i < segments.bins_.size(); ++i) {
+      match.bins_.push_back(
+        segments.bins_[i] * mesh_stride + i_time * time_stride);
+      match.weights_.push_back(segments.lengths_[i]);
+    }
+    return;
+  }
+
+  // Fraction of the track traveled when time bin boundary j is reached
+  auto boundary = [&](int j) { return (times[j] - t_start) / dt; };
+  for (int i = 0; i < segments.bins_.size(); ++i) {
+    double start = segments.starts_[i];
+    double end = start + segments.lengths_[i];
+
+    // Skip the time bins that end before the mesh bin is entered
+    while (i_time < n_times && boundary(i_time + 1) <= start)
+      ++i_time;
+
+    for (int j = i_time; j < n_times; ++j) {
+      double left = std::max(start, boundary(j));
+      double right = std::min(end, boundary(j + 1));
+      if (right > left) {
+        match.bins_.push_back(
+          segments.bins_[i] * mesh_stride + j * time_stride);
+        match.weights_.push_back(right - left);
+      }
+      if (boundary(j + 1) >= end)
+        break;
+    }
+  }
+}
+
+} // namespace
+
 //==============================================================================
 // FilterBinIter implementation
 //==============================================================================
 
-FilterBinIter::FilterBinIter(const Tally& tally, Particle& p)
+FilterBinIter::FilterBinIter(const Tally& tally, Particle& p, bool fuse)
   : filter_matches_ {p.filter_matches()}, tally_ {tally}
 {
+  if (fuse) {
+    skipped_filter_ = tally_.expansion_filter_ != C_NONE
+                        ? tally_.expansion_filter_
+                        : tally_.current_filter_;
+  }
+
+  // Tallies with identical filters share the combinations found by whichever
+  // of them is scored first for this event
+  if (tally_.filter_group_ != C_NONE) {
+    auto& cache {p.filter_bin_caches(tally_.filter_group_)};
+    if (!cache.present_) {
+      cache.indices_.clear();
+      cache.weights_.clear();
+      for (this->find_bins(p); index_ != -1; this->next_combination()) {
+        cache.indices_.push_back(index_);
+        cache.weights_.push_back(weight_);
+      }
+      cache.present_ = true;
+    }
+    cache_ = &cache;
+    this->set_cached_combination(0);
+    return;
+  }
+
+  this->find_bins(p);
+}
+
+void FilterBinIter::find_bins(Particle& p)
+{
+  // The combinations of the time and mesh bins of a tally that finds them
+  // together stand in for the matches of the two filters
+  if (tally_.time_filter_ != C_NONE)
+    joint_ = &p.time_mesh_match();
+
   // Find all valid bins in each relevant filter if they have not already been
   // found for this event.
-  for (auto i_filt : tally_.filters()) {
-    auto& match {filter_matches_[i_filt]};
+  for (int i = 0; i < tally_.filters().size(); ++i) {
+    if (joint_ && (i == tally_.time_filter_ || i == tally_.time_mesh_filter_))
+      continue;
+    auto& match {filter_matches_[tally_.filters(i)]};
     if (!match.bins_present_) {
       match.bins_.clear();
       match.weights_.clear();
@@ -52,6 +180,15 @@ FilterBinIter::FilterBinIter(const Tally& tally, Particle& p)
     match.i_bin_ = 0;
   }
 
+  if (joint_) {
+    find_time_mesh_bins(tally_, p, p.time_mesh_match());
+    if (joint_->bins_.empty()) {
+      index_ = -1;
+      return;
+    }
+    i_joint_ = 0;
+  }
+
   // Compute the initial index and weight.
   this->compute_index_weight();
 }
@@ -92,11 +229,30 @@ FilterBinIter::FilterBinIter(
 
 FilterBinIter& FilterBinIter::operator++()
 {
+  if (cache_) {
+    this->set_cached_combination(i_cache_ + 1);
+  } else {
+    this->next_combination();
+  }
+  return *this;
+}
+
+void FilterBinIter::next_combination()
+{
+  // The combined time and mesh bins vary fastest
+  if (joint_ && ++i_joint_ < joint_->bins_.size()) {
+    compute_index_weight();
+    return;
+  }
+  i_joint_ = 0;
+
   // Find the next valid combination of filter bins.  To do this, we search
   // backwards through the filters until we find the first filter whose bins
   // can be incremented.
   bool visited_all_combinations = true;
   for (int i = tally_.filters().size() - 1; i >= 0; --i) {
+    if (this->skipped(i))
+      continue;
     auto i_filt = tally_.filters(i);
     auto& match {filter_matches_[i_filt]};
     if (match.i_bin_ < match.bins_.size() - 1) {
@@ -120,8 +276,17 @@ FilterBinIter& FilterBinIter::operator++()
     // index and weight.
     compute_index_weight();
   }
+}
 
-  return *this;
+void FilterBinIter::set_cached_combination(int i)
+{
+  i_cache_ = i;
+  if (i_cache_ < cache_->indices_.size()) {
+    index_ = cache_->indices_[i_cache_];
+    weight_ = cache_->weights_[i_cache_];
+  } else {
+    index_ = -1;
+  }
 }
 
 void FilterBinIter::compute_index_weight()
@@ -129,18 +294,56 @@ void FilterBinIter::compute_index_weight()
   index_ = 0;
   weight_ = 1.;
   for (auto i = 0; i < tally_.filters().size(); ++i) {
+    if (this->skipped(i))
+      continue;
     auto i_filt = tally_.filters(i);
     auto& match {filter_matches_[i_filt]};
     auto i_bin = match.i_bin_;
     index_ += match.bins_[i_bin] * tally_.strides(i);
     weight_ *= match.weights_[i_bin];
   }
+  if (joint_) {
+    index_ += joint_->bins_[i_joint_];
+    weight_ *= joint_->weights_[i_joint_];
+  }
+}
+
+bool FilterBinIter::skipped(int i) const
+{
+  if (joint_ && (i == tally_.time_filter_ || i == tally_.time_mesh_filter_))
+    return true;
+  return i == skipped_filter_;
 }
 
 //==============================================================================
 // Non-member functions
 //==============================================================================
 
+void add_tally_result(Particle& p, Tally& tally, int filter_index,
+  int score_index, double value)
+{
+  if (tally.expansion_filter_ == C_NONE) {
+    tally.add_result(filter_index, score_index, value);
+    return;
+  }
+
+  const auto& match {
+    p.filter_matches()[tally.filters(tally.expansion_filter_)]};
+  int stride = tally.strides(tally.expansion_filter_);
+  for (int i = 0; i < match.bins_.size(); ++i) {
+    tally.add_result(filter_index + match.bins_[i] * stride, score_index,
+      value * match.weights_[i]);
+  }
+}
+
+void reset_filter_matches(Particle& p)
+{
+  for (auto& match : p.filter_matches())
+    match.bins_present_ = false;
+  for (auto& cache : p.filter_bin_caches())
+    cache.present_ = false;
+}
+
 //! Helper function used to increment tallies with a delayed group filter.
 
 void score_fission_delayed_dg(int i_tally, int d_bin, double score,
@@ -165,10 +368,8 @@ void score_fission_delayed_dg(int i_tally, int d_bin, double score,
     filter_weight *= match.weights_[i_bin];
   }
 
-// Update the tally result
-#pragma omp atomic
-  tally.results_(filter_index, score_index, TallyResult::VALUE) +=
-    score * filter_weight;
+  // Update the tally result
+  tally.add_result(filter_index, score_index, score * filter_weight);
 
   // Reset the original delayed group bin
   dg_match.bins_[i_bin] = original_bin;
@@ -406,10 +607,8 @@ void score_fission_eout(Particle& p, int i_tally, int i_score, int score_bin)
         filter_weight *= match.weights_[i_bin];
       }
 
-// Update tally results
-#pragma omp atomic
-      tally.results_(filter_index, i_score, TallyResult::VALUE) +=
-        score * filter_weight;
+      // Update tally results
+      tally.add_result(filter_index, i_score, score * filter_weight);
 
     } else if (score_bin == SCORE_DELAYED_NU_FISSION && g != 0) {
 
@@ -454,10 +653,8 @@ void score_fission_eout(Particle& p, int i_tally, int i_score, int score_bin)
           filter_weight *= match.weights_[i_bin];
         }
 
-// Update tally results
-#pragma omp atomic
-        tally.results_(filter_index, i_score, TallyResult::VALUE) +=
-          score * filter_weight;
+        // Update tally results
+        tally.add_result(filter_index, i_score, score * filter_weight);
       }
     }
   }
@@ -854,9 +1051,8 @@ void score_general_ce_nonanalog(Particle& p, int i_tally, int start_index,
       break;
 
     case SCORE_EVENTS:
-// Simply count the number of scoring events
-#pragma omp atomic
-      tally.results_(filter_index, score_index, TallyResult::VALUE) += 1.0;
+      // Simply count the number of scoring events
+      tally.add_result(filter_index, score_index, 1.0);
       continue;
 
     case ELASTIC:
@@ -967,11 +1163,7 @@ void score_general_ce_nonanalog(Particle& p, int i_tally, int start_index,
 
           // ...less the energy of any secondary particles since they will be
           // transported individually later
-          const auto& bank = p.secondary_bank();
-          for (auto it = bank.end() - p.n_bank_second(); it < bank.end();
-               ++it) {
-            score -= it->E;
-          }
+          score -= p.energy_banked_second();
 
           score *= p.wgt_last();
         } else {
@@ -1010,10 +1202,9 @@ void score_general_ce_nonanalog(Particle& p, int i_tally, int start_index,
       apply_derivative_to_score(
         p, i_tally, i_nuclide, atom_density, score_bin, score);
 
-// Update tally results
-#pragma omp atomic
-    tally.results_(filter_index, score_index, TallyResult::VALUE) +=
-      score * filter_weight;
+    // Update tally results
+    add_tally_result(
+      p, tally, filter_index, score_index, score * filter_weight);
   }
 }
 
@@ -1032,12 +1223,8 @@ void score_general_ce_analog(Particle& p, int i_tally, int start_index,
   // Get the pre-collision energy of the particle.
   auto E = p.E_last();
 
-  // Determine how much weight was absorbed due to survival biasing
-  double wgt_absorb = settings::survival_biasing
-                        ? p.wgt_last() *
-                            p.neutron_xs(p.event_nuclide()).absorption /
-                            p.neutron_xs(p.event_nuclide()).total
-                        : 0.0;
+  // Weight absorbed due to survival biasing, as removed during the collision
+  double wgt_absorb = settings::survival_biasing ? p.wgt_absorb() : 0.0;
 
   using Type = ParticleType;
 
@@ -1427,9 +1614,8 @@ void score_general_ce_analog(Particle& p, int i_tally, int start_index,
       break;
 
     case SCORE_EVENTS:
-// Simply count the number of scoring events
-#pragma omp atomic
-      tally.results_(filter_index, score_index, TallyResult::VALUE) += 1.0;
+      // Simply count the number of scoring events
+      tally.add_result(filter_index, score_index, 1.0);
       continue;
 
     case ELASTIC:
@@ -1503,10 +1689,7 @@ void score_general_ce_analog(Particle& p, int i_tally, int start_index,
 
         // ...less the energy of any secondary particles since they will be
         // transported individually later
-        const auto& bank = p.secondary_bank();
-        for (auto it = bank.end() - p.n_bank_second(); it < bank.end(); ++it) {
-          score -= it->E;
-        }
+        score -= p.energy_banked_second();
 
         score *= p.wgt_last();
       }
@@ -1532,10 +1715,8 @@ void score_general_ce_analog(Particle& p, int i_tally, int start_index,
       apply_derivative_to_score(
         p, i_tally, i_nuclide, atom_density, score_bin, score);
 
-// Update tally results
-#pragma omp atomic
-    tally.results_(filter_index, score_index, TallyResult::VALUE) +=
-      score * filter_weight;
+    // Update tally results
+    tally.add_result(filter_index, score_index, score * filter_weight);
   }
 }
 
@@ -2221,19 +2402,17 @@ void score_general_mg(Particle& p, int i_tally, int start_index,
       break;
 
     case SCORE_EVENTS:
-// Simply count the number of scoring events
-#pragma omp atomic
-      tally.results_(filter_index, score_index, TallyResult::VALUE) += 1.0;
+      // Simply count the number of scoring events
+      tally.add_result(filter_index, score_index, 1.0);
       continue;
 
     default:
       continue;
     }
 
-// Update tally results
-#pragma omp atomic
-    tally.results_(filter_index, score_index, TallyResult::VALUE) +=
-      score * filter_weight;
+    // Update tally results
+    add_tally_result(
+      p, tally, filter_index, score_index, score * filter_weight);
   }
 }
 
@@ -2285,8 +2464,7 @@ void score_analog_tally_ce(Particle& p)
   }
 
   // Reset all the filter matches for the next tally event.
-  for (auto& match : p.filter_matches())
-    match.bins_present_ = false;
+  reset_filter_matches(p);
 }
 
 void score_analog_tally_mg(Particle& p)
@@ -2334,8 +2512,66 @@ void score_analog_tally_mg(Particle& p)
   }
 
   // Reset all the filter matches for the next tally event.
-  for (auto& match : p.filter_matches())
-    match.bins_present_ = false;
+  reset_filter_matches(p);
+}
+
+//! Score every nuclide bin of a tally whose bins are all density-weighted
+//! reaction rates of specific nuclides.
+//
+//! This is equivalent to calling score_general_ce_nonanalog for each nuclide
+//! but gathers the microscopic cross sections of all nuclides in one loop.
+//! Nuclides that are not in the material contribute nothing and are skipped.
+
+void score_nuclide_rates_ce(Particle& p, int i_tally, int filter_index,
+  double filter_weight, double flux)
+{
+  if (p.material() == MATERIAL_VOID)
+    return;
+
+  Tally& tally {*model::tallies[i_tally]};
+
+  const auto& mat {*model::materials[p.material()]};
+  bool fission = p.macro_xs().fission != 0;
+  int n_scores = tally.scores_.size();
+
+  for (auto i = 0; i < tally.nuclides_.size(); ++i) {
+    auto i_nuclide = tally.nuclides_[i];
+    auto j = mat.mat_nuclide_index_[i_nuclide];
+    if (j == C_NONE)
+      continue;
+
+    double atom_density = mat.atom_density_(j);
+    const auto& micro = p.neutron_xs(i_nuclide);
+    for (auto k = 0; k < n_scores; ++k) {
+      double xs;
+      switch (tally.scores_[k]) {
+        // clang-format off
+      case SCORE_TOTAL:      xs = micro.total; break;
+      case SCORE_ABSORPTION: xs = micro.absorption; break;
+      case N_GAMMA:          xs = micro.reaction[0]; break;
+      case N_P:              xs = micro.reaction[1]; break;
+      case N_A:              xs = micro.reaction[2]; break;
+      case N_2N:             xs = micro.reaction[3]; break;
+      case N_3N:             xs = micro.reaction[4]; break;
+      case N_4N:             xs = micro.reaction[5]; break;
+        // clang-format on
+      case SCORE_FISSION:
+        if (!fission)
+          continue;
+        xs = micro.fission;
+        break;
+      case SCORE_NU_FISSION:
+        if (!fission)
+          continue;
+        xs = micro.nu_fission;
+        break;
+      default:
+        UNREACHABLE();
+      }
+      add_tally_result(p, tally, filter_index, i * n_scores + k,
+        xs * atom_density * flux * filter_weight);
+    }
+  }
 }
 
 void score_tracklength_tally(Particle& p, double distance)
@@ -2346,22 +2582,39 @@ void score_tracklength_tally(Particle& p, double distance)
   // Set 'none' value for log union grid index
   int i_log_union = C_NONE;
 
-  for (auto i_tally : model::active_tracklength_tallies) {
+  // Only visit tallies whose spatial domain may contain the event
+  const vector<int>* tallies = &model::active_tracklength_tallies;
+  if (model::tracklength_tally_index.enabled()) {
+    model::tracklength_tally_index.candidates(p, p.tally_candidates());
+    tallies = &p.tally_candidates();
+  }
+
+  for (auto i_tally : *tallies) {
     const Tally& tally {*model::tallies[i_tally]};
 
     // Initialize an iterator over valid filter bin combinations.  If there are
     // no valid combinations, use a continue statement to ensure we skip the
-    // assume_separate break below.
-    auto filter_iter = FilterBinIter(tally, p);
+    // assume_separate break below. The bins of an expansion filter are
+    // scored together rather than as separate combinations.
+    auto filter_iter = FilterBinIter(tally, p, true);
     auto end = FilterBinIter(tally, true, &p.filter_matches());
     if (filter_iter == end)
       continue;
 
+    // Reaction rates of specific nuclides can be scored in a single pass
+    bool nuclide_rates =
+      tally.nuclide_rates_ && p.type() == ParticleType::neutron;
+
     // Loop over filter bins.
     for (; filter_iter != end; ++filter_iter) {
       auto filter_index = filter_iter.index_;
       auto filter_weight = filter_iter.weight_;
 
+      if (nuclide_rates) {
+        score_nuclide_rates_ce(p, i_tally, filter_index, filter_weight, flux);
+        continue;
+      }
+
       // Loop over nuclide bins.
       for (auto i = 0; i < tally.nuclides_.size(); ++i) {
         auto i_nuclide = tally.nuclides_[i];
@@ -2374,9 +2627,7 @@ void score_tracklength_tally(Particle& p, double distance)
             if (j == C_NONE) {
               // Determine log union grid index
               if (i_log_union == C_NONE) {
-                int neutron = static_cast<int>(ParticleType::neutron);
-                i_log_union = std::log(p.E() / data::energy_min[neutron]) /
-                              simulation::log_spacing;
+                i_log_union = energy_search_index(p.E());
               }
 
               // Update micro xs cache
@@ -2411,8 +2662,7 @@ void score_tracklength_tally(Particle& p, double distance)
   }
 
   // Reset all the filter matches for the next tally event.
-  for (auto& match : p.filter_matches())
-    match.bins_present_ = false;
+  reset_filter_matches(p);
 }
 
 void score_collision_tally(Particle& p)
@@ -2426,22 +2676,39 @@ void score_collision_tally(Particle& p)
   // Set 'none value for log union grid index
   int i_log_union = C_NONE;
 
-  for (auto i_tally : model::active_collision_tallies) {
+  // Only visit tallies whose spatial domain may contain the event
+  const vector<int>* tallies = &model::active_collision_tallies;
+  if (model::collision_tally_index.enabled()) {
+    model::collision_tally_index.candidates(p, p.tally_candidates());
+    tallies = &p.tally_candidates();
+  }
+
+  for (auto i_tally : *tallies) {
     const Tally& tally {*model::tallies[i_tally]};
 
     // Initialize an iterator over valid filter bin combinations.  If there are
     // no valid combinations, use a continue statement to ensure we skip the
-    // assume_separate break below.
-    auto filter_iter = FilterBinIter(tally, p);
+    // assume_separate break below. The bins of an expansion filter are
+    // scored together rather than as separate combinations.
+    auto filter_iter = FilterBinIter(tally, p, true);
     auto end = FilterBinIter(tally, true, &p.filter_matches());
     if (filter_iter == end)
       continue;
 
+    // Reaction rates of specific nuclides can be scored in a single pass
+    bool nuclide_rates =
+      tally.nuclide_rates_ && p.type() == ParticleType::neutron;
+
     // Loop over filter bins.
     for (; filter_iter != end; ++filter_iter) {
       auto filter_index = filter_iter.index_;
       auto filter_weight = filter_iter.weight_;
 
+      if (nuclide_rates) {
+        score_nuclide_rates_ce(p, i_tally, filter_index, filter_weight, flux);
+        continue;
+      }
+
       // Loop over nuclide bins.
       for (auto i = 0; i < tally.nuclides_.size(); ++i) {
         auto i_nuclide = tally.nuclides_[i];
@@ -2453,9 +2720,7 @@ void score_collision_tally(Particle& p)
           if (j == C_NONE) {
             // Determine log union grid index
             if (i_log_union == C_NONE) {
-              int neutron = static_cast<int>(ParticleType::neutron);
-              i_log_union = std::log(p.E() / data::energy_min[neutron]) /
-                            simulation::log_spacing;
+              i_log_union = energy_search_index(p.E());
             }
 
             // Update micro xs cache
@@ -2489,8 +2754,7 @@ void score_collision_tally(Particle& p)
   }
 
   // Reset all the filter matches for the next tally event.
-  for (auto& match : p.filter_matches())
-    match.bins_present_ = false;
+  reset_filter_matches(p);
 }
 
 void score_surface_tally(Particle& p, const vector<int>& tallies)
@@ -2503,11 +2767,33 @@ void score_surface_tally(Particle& p, const vector<int>& tallies)
     // Initialize an iterator over valid filter bin combinations.  If there are
     // no valid combinations, use a continue statement to ensure we skip the
     // assume_separate break below.
-    auto filter_iter = FilterBinIter(tally, p);
+    auto filter_iter = FilterBinIter(tally, p, true);
     auto end = FilterBinIter(tally, true, &p.filter_matches());
     if (filter_iter == end)
       continue;
 
+    // Each crossing of a regular mesh adds the weight to one face bin for
+    // every combination of the other filters. The crossing weights are always
+    // one, so they are not multiplied in.
+    if (tally.current_filter_ != C_NONE) {
+      const auto& faces {
+        p.filter_matches()[tally.filters(tally.current_filter_)]};
+      int stride = tally.strides(tally.current_filter_);
+      for (; filter_iter != end; ++filter_iter) {
+        double score = current * filter_iter.weight_;
+        for (auto face : faces.bins_) {
+          int filter_index = filter_iter.index_ + face * stride;
+          for (auto score_index = 0; score_index < tally.scores_.size();
+               ++score_index) {
+            tally.add_result(filter_index, score_index, score);
+          }
+        }
+      }
+      if (settings::assume_separate)
+        break;
+      continue;
+    }
+
     // Loop over filter bins.
     for (; filter_iter != end; ++filter_iter) {
       auto filter_index = filter_iter.index_;
@@ -2519,8 +2805,7 @@ void score_surface_tally(Particle& p, const vector<int>& tallies)
       double score = current * filter_weight;
       for (auto score_index = 0; score_index < tally.scores_.size();
            ++score_index) {
-#pragma omp atomic
-        tally.results_(filter_index, score_index, TallyResult::VALUE) += score;
+        tally.add_result(filter_index, score_index, score);
       }
     }
 
@@ -2533,83 +2818,40 @@ void score_surface_tally(Particle& p, const vector<int>& tallies)
   }
 
   // Reset all the filter matches for the next tally event.
-  for (auto& match : p.filter_matches())
-    match.bins_present_ = false;
+  reset_filter_matches(p);
 }
 
-void score_pulse_height_tally(Particle& p, const vector<int>& tallies)
+void score_pulse_height_tally(const Particle& p, const vector<int>& tallies)
 {
-  // The pulse height tally in OpenMC hijacks the logic of CellFilter and
-  // EnergyFilter to score specific quantities related to particle pulse height.
-  // This is achieved by setting the pulse-height cell of the tally to the cell
-  // of the particle being scored, and the energy to the particle's last
-  // recorded energy (E_last()). After the tally is scored, the values are reset
-  // to ensure proper accounting and avoid interference with subsequent
-  // calculations or tallies.
-
-  // Save original cell/energy information
-  int orig_n_coord = p.n_coord();
-  int orig_cell = p.coord(0).cell;
-  double orig_E_last = p.E_last();
-
+  // The energy deposited in each detector cell over the history has been
+  // accumulated in the pulse-height storage of the particle during transport.
+  // Each detector cell of a tally is binned by its deposited energy, and the
+  // bins of its cell filters were found when the simulation was initialized.
+  const auto& storage = p.pht_storage();
   for (auto i_tally : tallies) {
     auto& tally {*model::tallies[i_tally]};
 
-    // Determine all CellFilter in the tally
-    for (const auto& filter : tally.filters()) {
-      auto cell_filter =
-        dynamic_cast<CellFilter*>(model::tally_filters[filter].get());
-      if (cell_filter != nullptr) {
-
-        const auto& cells = cell_filter->cells();
-        // Loop over all cells in the CellFilter
-        for (auto cell_index = 0; cell_index < cells.size(); ++cell_index) {
-          int cell_id = cells[cell_index];
-
-          // Temporarily change cell of particle
-          p.n_coord() = 1;
-          p.coord(0).cell = cell_id;
-
-          // Determine index of cell in model::pulse_height_cells
-          auto it = std::find(model::pulse_height_cells.begin(),
-            model::pulse_height_cells.end(), cell_id);
-          int index = std::distance(model::pulse_height_cells.begin(), it);
-
-          // Temporarily change energy of particle to pulse-height value
-          p.E_last() = p.pht_storage()[index];
-
-          // Initialize an iterator over valid filter bin combinations. If
-          // there are no valid combinations, use a continue statement to ensure
-          // we skip the assume_separate break below.
-          auto filter_iter = FilterBinIter(tally, p);
-          auto end = FilterBinIter(tally, true, &p.filter_matches());
-          if (filter_iter == end)
-            continue;
-
-          // Loop over filter bins.
-          for (; filter_iter != end; ++filter_iter) {
-            auto filter_index = filter_iter.index_;
-            auto filter_weight = filter_iter.weight_;
-
-            // Loop over scores.
-            for (auto score_index = 0; score_index < tally.scores_.size();
-                 ++score_index) {
-#pragma omp atomic
-              tally.results_(filter_index, score_index, TallyResult::VALUE) +=
-                filter_weight;
-            }
-          }
+    for (const auto& [index, cell_filter_index] : tally.pulse_height_bins_) {
+      double E = storage[index];
+      int filter_index = cell_filter_index;
+      bool in_range = true;
+      for (int i : tally.pulse_height_energy_filters_) {
+        const auto& filt = *static_cast<const EnergyFilter*>(
+          model::tally_filters[tally.filters(i)].get());
+        if (E < filt.bins().front() || E > filt.bins().back()) {
+          in_range = false;
+          break;
+        }
+        filter_index += filt.find_bin(E) * tally.strides(i);
+      }
+      if (!in_range)
+        continue;
 
-          // Reset all the filter matches for the next tally event.
-          for (auto& match : p.filter_matches())
-            match.bins_present_ = false;
-        }
+      for (auto score_index = 0; score_index < tally.scores_.size();
+           ++score_index) {
+        tally.add_result(filter_index, score_index, 1.0);
       }
     }
-    // Restore cell/energy
-    p.n_coord() = orig_n_coord;
-    p.coord(0).cell = orig_cell;
-    p.E_last() = orig_E_last;
   }
 }
 } // namespace openmc
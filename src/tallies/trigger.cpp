@@ -1,5 +1,6 @@
 #include "openmc/tallies/trigger.h"
 
+#include <algorithm> // for count_if, max, min, nth_element, remove_if
 #include <cmath>
 #include <utility> // for std::pair
 
@@ -12,6 +13,7 @@
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
 #include "openmc/tallies/tally.h"
+#include "openmc/vector.h"
 
 namespace openmc {
 
@@ -32,8 +34,8 @@ std::pair<double, double> get_tally_uncertainty(
 {
   const auto& tally {model::tallies[i_tally]};
 
-  auto sum = tally->results_(filter_index, score_index, TallyResult::SUM);
-  auto sum_sq = tally->results_(filter_index, score_index, TallyResult::SUM_SQ);
+  auto sum = tally->result(filter_index, score_index, TallyResult::SUM);
+  auto sum_sq = tally->result(filter_index, score_index, TallyResult::SUM_SQ);
 
   int n = tally->n_realizations_;
   auto mean = sum / n;
@@ -48,6 +50,104 @@ std::pair<double, double> get_tally_uncertainty(
   return {std_dev, rel_err};
 }
 
+namespace {
+
+//! Largest number of bins whose uncertainties are computed to check a trigger
+//! that only needs a fraction of the bins to be satisfied
+constexpr int TRIGGER_SAMPLE_BINS {1 << 16};
+
+//! Uncertainty/threshold ratio of one bin of a trigger, which is infinite for
+//! a bin without contributions or negative if such a bin is ignored
+
+double bin_ratio(int i_tally, const Trigger& trigger, int filter_index)
+{
+  auto [std_dev, rel_err] =
+    get_tally_uncertainty(i_tally, trigger.score_index, filter_index);
+  if (std_dev == -1)
+    return trigger.ignore_zeros ? -1.0 : INFINITY;
+
+  // Pick out the relevant uncertainty metric for this trigger.
+  double uncertainty;
+  switch (trigger.metric) {
+  case TriggerMetric::variance:
+    uncertainty = std_dev * std_dev;
+    break;
+  case TriggerMetric::standard_deviation:
+    uncertainty = std_dev;
+    break;
+  case TriggerMetric::relative_error:
+    uncertainty = rel_err;
+    break;
+  case TriggerMetric::not_active:
+    UNREACHABLE();
+  }
+
+  // Compute the uncertainty / threshold ratio.
+  double ratio = uncertainty / trigger.threshold;
+  if (trigger.metric == TriggerMetric::variance) {
+    ratio = std::sqrt(ratio);
+  }
+  return ratio;
+}
+
+//! Compute the ratio of a trigger and the fraction of its bins below the
+//! threshold.
+//
+//! A trigger on all bins takes the largest ratio of any bin. A trigger on a
+//! fraction of the bins takes the ratio under which that fraction of the bins
+//! lie, which is estimated from evenly spaced bins of large tallies.
+
+void evaluate_trigger(int i_tally, Trigger& trigger)
+{
+  int n_bins = model::tallies[i_tally]->n_filter_bins();
+  int n_counted = 0;
+  int n_satisfied = 0;
+
+  if (trigger.fraction == 1.0) {
+    double ratio = 0.0;
+#pragma omp parallel for schedule(static) reduction(max : ratio) \
+  reduction(+ : n_counted, n_satisfied)
+    for (int i = 0; i < n_bins; ++i) {
+      double r = bin_ratio(i_tally, trigger, i);
+      if (r < 0.0)
+        continue;
+      ratio = std::max(ratio, r);
+      ++n_counted;
+      if (r <= 1.0)
+        ++n_satisfied;
+    }
+    trigger.ratio = ratio;
+  } else {
+    int stride = std::max(1, n_bins / TRIGGER_SAMPLE_BINS);
+    int n_sample = (n_bins + stride - 1) / stride;
+    vector<double> ratios(n_sample);
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n_sample; ++i) {
+      ratios[i] = bin_ratio(i_tally, trigger, i * stride);
+    }
+    ratios.erase(std::remove_if(ratios.begin(), ratios.end(),
+                   [](double r) { return r < 0.0; }),
+      ratios.end());
+    n_counted = ratios.size();
+    n_satisfied = std::count_if(
+      ratios.begin(), ratios.end(), [](double r) { return r <= 1.0; });
+
+    trigger.ratio = 0.0;
+    if (n_counted > 0) {
+      int k = std::ceil(trigger.fraction * n_counted) - 1;
+      k = std::min(std::max(k, 0), n_counted - 1);
+      std::nth_element(ratios.begin(), ratios.begin() + k, ratios.end());
+      trigger.ratio = ratios[k];
+    }
+  }
+
+  trigger.batch = simulation::current_batch;
+  trigger.satisfied =
+    n_counted > 0 ? static_cast<double>(n_satisfied) / n_counted : 1.0;
+}
+
+} // namespace
+
 //! Find the limiting limiting tally trigger.
 //
 //! param[out] ratio The uncertainty/threshold ratio for the most limiting
@@ -59,64 +159,25 @@ void check_tally_triggers(double& ratio, int& tally_id, int& score)
 {
   ratio = 0.;
   for (auto i_tally = 0; i_tally < model::tallies.size(); ++i_tally) {
-    const Tally& t {*model::tallies[i_tally]};
+    Tally& t {*model::tallies[i_tally]};
 
     // Ignore tallies with less than two realizations.
     if (t.n_realizations_ < 2)
       continue;
 
-    for (const auto& trigger : t.triggers_) {
+    for (auto& trigger : t.triggers_) {
       // Skip trigger if it is not active
       if (trigger.metric == TriggerMetric::not_active)
         continue;
 
-      const auto& results = t.results_;
-      for (auto filter_index = 0; filter_index < results.shape()[0];
-           ++filter_index) {
-        // Compute the tally uncertainty metrics.
-        auto uncert_pair =
-          get_tally_uncertainty(i_tally, trigger.score_index, filter_index);
-
-        // If there is a score without contributions, set ratio to inf and
-        // exit early, unless zero scores are ignored for this trigger.
-        if (uncert_pair.first == -1 && !trigger.ignore_zeros) {
-          ratio = INFINITY;
-          score = t.scores_[trigger.score_index];
-          tally_id = t.id_;
-          return;
-        }
-
-        double std_dev = uncert_pair.first;
-        double rel_err = uncert_pair.second;
-
-        // Pick out the relevant uncertainty metric for this trigger.
-        double uncertainty;
-        switch (trigger.metric) {
-        case TriggerMetric::variance:
-          uncertainty = std_dev * std_dev;
-          break;
-        case TriggerMetric::standard_deviation:
-          uncertainty = std_dev;
-          break;
-        case TriggerMetric::relative_error:
-          uncertainty = rel_err;
-          break;
-        case TriggerMetric::not_active:
-          UNREACHABLE();
-        }
-
-        // Compute the uncertainty / threshold ratio.
-        double this_ratio = uncertainty / trigger.threshold;
-        if (trigger.metric == TriggerMetric::variance) {
-          this_ratio = std::sqrt(ratio);
-        }
-
-        // If this is the most uncertain value, set the output variables.
-        if (this_ratio > ratio) {
-          ratio = this_ratio;
-          score = t.scores_[trigger.score_index];
-          tally_id = t.id_;
-        }
+      // If this is the most uncertain value, set the output variables. A
+      // score without contributions gives an infinite ratio unless zero
+      // scores are ignored for this trigger.
+      evaluate_trigger(i_tally, trigger);
+      if (trigger.ratio > ratio) {
+        ratio = trigger.ratio;
+        score = t.scores_[trigger.score_index];
+        tally_id = t.id_;
       }
     }
   }
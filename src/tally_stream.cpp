@@ -0,0 +1,201 @@
+#include "openmc/tally_stream.h"
+
+#include <cstdint>
+#include <string>
+
+#include <fmt/core.h>
+
+#ifdef OPENMC_ADIOS2
+#include <adios2.h>
+#endif
+
+#include "openmc/constants.h"
+#include "openmc/container_util.h"
+#include "openmc/error.h"
+#include "openmc/memory.h"
+#include "openmc/message_passing.h"
+#include "openmc/settings.h"
+#include "openmc/tallies/filter.h"
+#include "openmc/tallies/tally.h"
+
+namespace openmc {
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+#ifdef OPENMC_ADIOS2
+const bool ADIOS2_ENABLED = true;
+#else
+const bool ADIOS2_ENABLED = false;
+#endif
+
+#ifdef OPENMC_ADIOS2
+namespace {
+
+//==============================================================================
+//! A tally whose results are streamed and the variables holding them
+//==============================================================================
+
+struct StreamedTally {
+  Tally* tally;
+  adios2::Variable<double> results;
+  adios2::Variable<int32_t> n_realizations;
+};
+
+//==============================================================================
+//! ADIOS2 objects of the stream written by the master process
+//==============================================================================
+
+struct TallyStream {
+  adios2::ADIOS adios;
+  adios2::IO io;
+  adios2::Engine engine;
+  adios2::Variable<int32_t> batch;
+  vector<StreamedTally> tallies;
+  const vector<float>* flux {nullptr}; //!< flux of random ray source regions
+  int negroups {0};                    //!< energy groups of the flux
+  adios2::Variable<float> flux_var;
+};
+
+unique_ptr<TallyStream> stream;
+
+} // namespace
+#endif
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void open_tally_stream()
+{
+#ifdef OPENMC_ADIOS2
+  if (!settings::tally_stream || !mpi::master)
+    return;
+
+  // Tallies are reduced onto the master process, so it alone writes the
+  // stream, through a serial ADIOS2 object
+  stream = make_unique<TallyStream>();
+  auto& io = stream->io;
+  io = stream->adios.DeclareIO("openmc");
+  io.SetEngine(settings::tally_stream_engine);
+  stream->batch = io.DefineVariable<int32_t>("batch");
+
+  for (auto& t : model::tallies) {
+    if (!settings::tally_stream_ids.empty() &&
+        !contains(settings::tally_stream_ids, t->id_))
+      continue;
+    if (t->partitioned() && mpi::n_procs > 1) {
+      warning(fmt::format(
+        "Tally {} is partitioned across processes and will not be streamed.",
+        t->id_));
+      continue;
+    }
+
+    // The results have the layout of Tally::results_: filter combinations,
+    // then the scores of each nuclide, then the value, sum and sum of squares
+    std::string prefix = fmt::format("tally/{}/", t->id_);
+    adios2::Dims shape {static_cast<size_t>(t->n_filter_bins()),
+      static_cast<size_t>(t->n_scores() * t->nuclides_.size()),
+      static_cast<size_t>(TallyResult::SIZE)};
+    stream->tallies.push_back({t.get(),
+      io.DefineVariable<double>(prefix + "results", shape, {0, 0, 0}, shape),
+      io.DefineVariable<int32_t>(prefix + "n_realizations")});
+
+    // Readers identify the bins from the filters, nuclides and scores
+    vector<int32_t> filter_ids;
+    for (auto i_filt : t->filters()) {
+      filter_ids.push_back(model::tally_filters[i_filt]->id());
+    }
+    if (!filter_ids.empty()) {
+      io.DefineAttribute<int32_t>(
+        prefix + "filters", filter_ids.data(), filter_ids.size());
+    }
+    vector<std::string> nuclides;
+    for (int i = 0; i < t->nuclides_.size(); ++i) {
+      nuclides.push_back(t->nuclide_name(i));
+    }
+    io.DefineAttribute<std::string>(
+      prefix + "nuclides", nuclides.data(), nuclides.size());
+    vector<std::string> scores;
+    for (int i = 0; i < t->scores_.size(); ++i) {
+      scores.push_back(t->score_name(i));
+    }
+    io.DefineAttribute<std::string>(
+      prefix + "scores", scores.data(), scores.size());
+  }
+
+  stream->engine = io.Open(settings::tally_stream_name, adios2::Mode::Write);
+#endif
+}
+
+void stream_source_region_flux(const vector<float>& flux, int negroups)
+{
+#ifdef OPENMC_ADIOS2
+  if (!stream)
+    return;
+  stream->flux = &flux;
+  stream->negroups = negroups;
+#endif
+}
+
+void write_tally_stream(int batch)
+{
+#ifdef OPENMC_ADIOS2
+  if (!settings::tally_stream || batch <= settings::n_inactive)
+    return;
+
+  // Reductions still in flight are completed by all processes before the
+  // master process reads the results
+  finish_tally_reduction();
+  if (!stream)
+    return;
+
+  auto& engine = stream->engine;
+  engine.BeginStep();
+  engine.Put(stream->batch, batch, adios2::Mode::Sync);
+  for (auto& st : stream->tallies) {
+    Tally& t = *st.tally;
+    engine.Put(st.n_realizations, t.n_realizations_, adios2::Mode::Sync);
+
+    // Dense results are handed to the engine without a copy and are read when
+    // the step ends. Sparse results only exist as a dense array for the time
+    // it takes to copy them.
+    if (t.sparse_storage()) {
+      t.materialize_results();
+      engine.Put(st.results, t.results_.data(), adios2::Mode::Sync);
+      t.release_results();
+    } else {
+      engine.Put(st.results, t.results_.data(), adios2::Mode::Deferred);
+    }
+  }
+
+  // The flux of random ray source regions, summed over the active batches
+  if (stream->flux) {
+    const auto& flux = *stream->flux;
+    adios2::Dims shape {flux.size() / stream->negroups,
+      static_cast<size_t>(stream->negroups)};
+    if (!stream->flux_var) {
+      stream->flux_var = stream->io.DefineVariable<float>(
+        "random_ray/scalar_flux", shape, {0, 0}, shape);
+    } else {
+      stream->flux_var.SetShape(shape);
+      stream->flux_var.SetSelection({{0, 0}, shape});
+    }
+    engine.Put(stream->flux_var, flux.data(), adios2::Mode::Deferred);
+  }
+  engine.EndStep();
+#endif
+}
+
+void close_tally_stream()
+{
+#ifdef OPENMC_ADIOS2
+  if (!stream)
+    return;
+  stream->engine.Close();
+  stream.reset();
+#endif
+}
+
+} // namespace openmc
@@ -0,0 +1,168 @@
+#include "openmc/telemetry.h"
+
+#include <algorithm> // for max, min
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include <fmt/core.h>
+
+#include "openmc/bank.h"
+#include "openmc/eigenvalue.h"
+#include "openmc/error.h"
+#include "openmc/memory_report.h"
+#include "openmc/message_passing.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+#include "openmc/tallies/tally.h"
+#include "openmc/timer.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+vector<TelemetryCounts> telemetry_counts;
+
+} // namespace simulation
+
+namespace {
+
+std::FILE* telemetry_file {nullptr}; //!< telemetry file on the master
+bool telemetry_opened {false};       //!< has the file been opened before?
+
+//! Wall-clock time at the end of the last batch
+std::chrono::steady_clock::time_point last_batch;
+
+//! Transport time at the end of the last batch in [s]
+double last_transport {0.0};
+
+} // namespace
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void open_telemetry()
+{
+  simulation::telemetry_counts.clear();
+  if (settings::path_telemetry.empty())
+    return;
+
+  simulation::telemetry_counts.resize(num_threads());
+  last_batch = std::chrono::steady_clock::now();
+  last_transport = simulation::time_transport.elapsed();
+
+  // The file is only truncated the first time it is opened, so that it
+  // covers all simulations run by this process and restarts of a run
+  if (mpi::master) {
+    bool append = telemetry_opened || settings::restart_run;
+    telemetry_file =
+      std::fopen(settings::path_telemetry.c_str(), append ? "a" : "w");
+    if (!telemetry_file) {
+      warning(fmt::format(
+        "Could not open telemetry file '{}'.", settings::path_telemetry));
+    }
+    telemetry_opened = true;
+  }
+}
+
+void write_telemetry()
+{
+  if (simulation::telemetry_counts.empty())
+    return;
+
+  // Time of the batch on the wall clock and in transport on this process
+  auto now = std::chrono::steady_clock::now();
+  std::chrono::duration<double> wall = now - last_batch;
+  last_batch = now;
+  double t_transport = simulation::time_transport.elapsed() - last_transport;
+  last_transport = simulation::time_transport.elapsed();
+
+  // Quantities summed or maximized over the threads of this process. Sums
+  // are stored as doubles so that one reduction covers all of them.
+  int64_t secondaries = 0;
+  int64_t max_bank = 0;
+  for (auto& counts : simulation::telemetry_counts) {
+    secondaries += counts.secondaries;
+    max_bank = std::max(max_bank, counts.max_secondary_bank);
+    counts = {};
+  }
+  double sums[] {static_cast<double>(secondaries),
+    static_cast<double>(simulation::n_lost_particles),
+    static_cast<double>(simulation::source_bank.size()),
+    static_cast<double>(simulation::fission_bank.size())};
+  double maxes[] {static_cast<double>(max_bank), max_resident_memory()};
+  vector<double> times(mpi::n_procs, t_transport);
+
+#ifdef OPENMC_MPI
+  MPI_Reduce(mpi::master ? MPI_IN_PLACE : sums, sums, 4, MPI_DOUBLE, MPI_SUM,
+    0, mpi::intracomm);
+  MPI_Reduce(mpi::master ? MPI_IN_PLACE : maxes, maxes, 2, MPI_DOUBLE,
+    MPI_MAX, 0, mpi::intracomm);
+  MPI_Gather(&t_transport, 1, MPI_DOUBLE, times.data(), 1, MPI_DOUBLE, 0,
+    mpi::intracomm);
+#endif
+
+  if (!mpi::master || !telemetry_file)
+    return;
+
+  double t_min = times[0];
+  double t_max = times[0];
+  double t_mean = 0.0;
+  for (auto t : times) {
+    t_min = std::min(t_min, t);
+    t_max = std::max(t_max, t);
+    t_mean += t / times.size();
+  }
+  double n_particles =
+    static_cast<double>(settings::n_particles) * settings::gen_per_batch;
+
+  std::string line = fmt::format(
+    "{{\"batch\":{},\"time\":{:.6g},\"batch_time\":{:.6g},"
+    "\"rate\":{:.6g},\"lost_particles\":{},\"secondaries\":{},"
+    "\"max_secondary_bank\":{},\"source_bank\":{},\"fission_bank\":{},"
+    "\"max_memory_mb\":{:.6g},\"transport_time\":{{\"min\":{:.6g},"
+    "\"mean\":{:.6g},\"max\":{:.6g}}},\"rank_transport_time\":[",
+    simulation::current_batch, simulation::time_total.elapsed(), wall.count(),
+    wall.count() > 0.0 ? n_particles / wall.count() : 0.0,
+    static_cast<int64_t>(sums[1]), static_cast<int64_t>(sums[0]),
+    static_cast<int64_t>(maxes[0]), static_cast<int64_t>(sums[2]),
+    static_cast<int64_t>(sums[3]), maxes[1], t_min, t_mean, t_max);
+  for (int i = 0; i < times.size(); ++i) {
+    line += fmt::format("{}{:.6g}", i == 0 ? "" : ",", times[i]);
+  }
+  line += "]";
+
+  // Multiplication factor and entropy, when they have been computed
+  if (settings::run_mode == RunMode::EIGENVALUE) {
+    if (!simulation::k_generation.empty())
+      line += fmt::format(",\"k_generation\":{:.8g}",
+        simulation::k_generation.back());
+    if (simulation::n_realizations > 0)
+      line += fmt::format(",\"keff\":{:.8g}", simulation::keff);
+    if (simulation::n_realizations > 1)
+      line += fmt::format(",\"keff_std\":{:.8g}", simulation::keff_std);
+  }
+  if (settings::entropy_on && !simulation::entropy.empty())
+    line += fmt::format(",\"entropy\":{:.8g}", simulation::entropy.back());
+  line += "}\n";
+
+  // Flush so that monitoring processes see the batch right away
+  std::fputs(line.c_str(), telemetry_file);
+  std::fflush(telemetry_file);
+}
+
+void close_telemetry()
+{
+  simulation::telemetry_counts.clear();
+  if (telemetry_file) {
+    std::fclose(telemetry_file);
+    telemetry_file = nullptr;
+  }
+}
+
+} // namespace openmc
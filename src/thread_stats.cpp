@@ -0,0 +1,144 @@
+#include "openmc/thread_stats.h"
+
+#include <algorithm> // for min, max
+
+#include <fmt/core.h>
+
+#include "openmc/message_passing.h"
+#include "openmc/settings.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+vector<ThreadStats> thread_stats;
+
+} // namespace simulation
+
+//==============================================================================
+// ThreadTimer implementation
+//==============================================================================
+
+ThreadTimer::ThreadTimer() : active_ {!simulation::thread_stats.empty()}
+{
+  if (active_)
+    start_ = std::chrono::steady_clock::now();
+}
+
+ThreadTimer::~ThreadTimer()
+{
+  if (active_) {
+    std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start_;
+    simulation::thread_stats[thread_num()].time += elapsed.count();
+  }
+}
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void reset_thread_stats()
+{
+  simulation::thread_stats.clear();
+  if (settings::thread_stats)
+    simulation::thread_stats.resize(num_threads());
+}
+
+vector<ThreadStats> gather_thread_stats(vector<int>& n_threads)
+{
+  n_threads.clear();
+  if (simulation::thread_stats.empty())
+    return {};
+
+#ifdef OPENMC_MPI
+  // The members of each thread are sent as doubles, which represent the
+  // counts exactly up to 2^53
+  constexpr int N_MEMBERS {5};
+  int n_local = simulation::thread_stats.size();
+  vector<double> send;
+  for (const auto& s : simulation::thread_stats) {
+    send.insert(send.end(),
+      {s.time, static_cast<double>(s.histories),
+        static_cast<double>(s.segments), static_cast<double>(s.collisions),
+        static_cast<double>(s.surface_crossings)});
+  }
+
+  if (mpi::master)
+    n_threads.resize(mpi::n_procs);
+  MPI_Gather(
+    &n_local, 1, MPI_INT, n_threads.data(), 1, MPI_INT, 0, mpi::intracomm);
+
+  vector<int> counts;
+  vector<int> displs;
+  int n_total = 0;
+  if (mpi::master) {
+    for (auto n : n_threads) {
+      counts.push_back(N_MEMBERS * n);
+      displs.push_back(N_MEMBERS * n_total);
+      n_total += n;
+    }
+  }
+  vector<double> recv(N_MEMBERS * n_total);
+  MPI_Gatherv(send.data(), send.size(), MPI_DOUBLE, recv.data(), counts.data(),
+    displs.data(), MPI_DOUBLE, 0, mpi::intracomm);
+
+  vector<ThreadStats> stats(n_total);
+  for (int i = 0; i < n_total; ++i) {
+    const double* x = &recv[N_MEMBERS * i];
+    stats[i].time = x[0];
+    stats[i].histories = x[1];
+    stats[i].segments = x[2];
+    stats[i].collisions = x[3];
+    stats[i].surface_crossings = x[4];
+  }
+  if (!mpi::master)
+    n_threads.clear();
+  return stats;
+#else
+  n_threads.push_back(simulation::thread_stats.size());
+  return simulation::thread_stats;
+#endif
+}
+
+void print_thread_stats(const vector<ThreadStats>& stats)
+{
+  if (stats.empty())
+    return;
+
+  // Display the spread of a quantity over all threads along with the ratio of
+  // its largest to its mean value
+  auto show = [&stats](const char* label, auto value) {
+    double min = value(stats[0]);
+    double max = min;
+    double mean = 0.0;
+    for (const auto& s : stats) {
+      double x = value(s);
+      min = std::min(min, x);
+      max = std::max(max, x);
+      mean += x / stats.size();
+    }
+    double imbalance = mean > 0.0 ? max / mean : 1.0;
+    fmt::print(" {:<33} = {:.4g} / {:.4g} / {:.4g} ({:.3f} max/mean)\n",
+      label, min, mean, max, imbalance);
+  };
+
+  fmt::print(" Work per thread (min / mean / max) over {} threads\n",
+    stats.size());
+  show("  Transport time [s]", [](const ThreadStats& s) { return s.time; });
+  show("  Histories",
+    [](const ThreadStats& s) { return static_cast<double>(s.histories); });
+  show("  Track segments",
+    [](const ThreadStats& s) { return static_cast<double>(s.segments); });
+  show("  Collisions",
+    [](const ThreadStats& s) { return static_cast<double>(s.collisions); });
+  show("  Surface crossings", [](const ThreadStats& s) {
+    return static_cast<double>(s.surface_crossings);
+  });
+}
+
+} // namespace openmc
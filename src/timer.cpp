@@ -1,5 +1,7 @@
 #include "openmc/timer.h"
 
+#include "openmc/trace.h"
+
 namespace openmc {
 
 //==============================================================================
@@ -8,25 +10,34 @@ namespace openmc {
 
 namespace simulation {
 
-Timer time_active;
-Timer time_bank;
-Timer time_bank_sample;
-Timer time_bank_sendrecv;
-Timer time_finalize;
-Timer time_inactive;
-Timer time_initialize;
-Timer time_read_xs;
-Timer time_statepoint;
-Timer time_tallies;
-Timer time_total;
-Timer time_transport;
-Timer time_event_init;
-Timer time_event_calculate_xs;
-Timer time_event_advance_particle;
-Timer time_event_surface_crossing;
-Timer time_event_collision;
-Timer time_event_death;
-Timer time_update_src;
+Timer time_active {"active batches"};
+Timer time_bank {"synchronizing fission bank"};
+Timer time_bank_sample {"sampling source sites"};
+Timer time_bank_sendrecv {"SEND-RECV source sites"};
+Timer time_energy_grids {"setting up energy grids"};
+Timer time_finalize {"finalization"};
+Timer time_inactive {"inactive batches"};
+Timer time_pipeline {"pipelined batch completion"};
+Timer time_pipeline_wait {"waiting on pipelined batch"};
+Timer time_initialize {"total initialization"};
+Timer time_read_xs {"reading cross sections"};
+Timer time_read_geometry {"reading geometry"};
+Timer time_read_materials {"reading materials"};
+Timer time_setup_geometry {"setting up geometry"};
+Timer time_distribcell {"preparing distributed cells"};
+Timer time_statepoint {"writing statepoints"};
+Timer time_tallies {"accumulating tallies"};
+Timer time_total {"total"};
+Timer time_transport {"transport"};
+Timer time_event_init {"event particle initialization"};
+Timer time_event_calculate_xs {"event XS lookups"};
+Timer time_event_sort {"event sorting XS queues"};
+Timer time_event_advance_particle {"event advancing"};
+Timer time_event_surface_crossing {"event surface crossings"};
+Timer time_event_collision {"event collisions"};
+Timer time_event_tail {"event history-based tail"};
+Timer time_event_death {"event particle death"};
+Timer time_update_src {"updating source"};
 
 } // namespace simulation
 
@@ -36,18 +47,33 @@ Timer time_update_src;
 
 void Timer::start()
 {
+#ifdef OPENMC_TRACE
+  if (name_) {
+    if (running_)
+      trace_end(trace_);
+    trace_ = trace_begin(name_);
+  }
+#endif
   running_ = true;
   start_ = clock::now();
 }
 
 void Timer::stop()
 {
+#ifdef OPENMC_TRACE
+  if (name_ && running_)
+    trace_end(trace_);
+#endif
   elapsed_ = elapsed();
   running_ = false;
 }
 
 void Timer::reset()
 {
+#ifdef OPENMC_TRACE
+  if (name_ && running_)
+    trace_end(trace_);
+#endif
   running_ = false;
   elapsed_ = 0.0;
 }
@@ -72,19 +98,28 @@ void reset_timers()
   simulation::time_bank.reset();
   simulation::time_bank_sample.reset();
   simulation::time_bank_sendrecv.reset();
+  simulation::time_energy_grids.reset();
   simulation::time_finalize.reset();
   simulation::time_inactive.reset();
+  simulation::time_pipeline.reset();
+  simulation::time_pipeline_wait.reset();
   simulation::time_initialize.reset();
   simulation::time_read_xs.reset();
+  simulation::time_read_geometry.reset();
+  simulation::time_read_materials.reset();
+  simulation::time_setup_geometry.reset();
+  simulation::time_distribcell.reset();
   simulation::time_statepoint.reset();
   simulation::time_tallies.reset();
   simulation::time_total.reset();
   simulation::time_transport.reset();
   simulation::time_event_init.reset();
   simulation::time_event_calculate_xs.reset();
+  simulation::time_event_sort.reset();
   simulation::time_event_advance_particle.reset();
   simulation::time_event_surface_crossing.reset();
   simulation::time_event_collision.reset();
+  simulation::time_event_tail.reset();
   simulation::time_event_death.reset();
   simulation::time_update_src.reset();
 }
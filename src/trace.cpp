@@ -0,0 +1,165 @@
+#include "openmc/trace.h"
+
+#ifdef OPENMC_TRACE
+
+#include <atomic>
+
+#if defined(OPENMC_TRACE_NVTX)
+#include <nvtx3/nvToolsExt.h>
+#elif defined(OPENMC_TRACE_ITT)
+#include <ittnotify.h>
+#else
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+#include <fmt/core.h>
+
+#include "openmc/message_passing.h"
+#include "openmc/openmp_interface.h"
+#include "openmc/settings.h"
+#include "openmc/vector.h"
+#endif
+
+namespace openmc {
+
+#if defined(OPENMC_TRACE_NVTX)
+
+//==============================================================================
+// NVTX ranges for Nsight Systems
+//==============================================================================
+
+uint64_t trace_begin(const char* name)
+{
+  return nvtxRangeStartA(name);
+}
+
+void trace_end(uint64_t handle)
+{
+  nvtxRangeEnd(handle);
+}
+
+void write_trace() {}
+
+#elif defined(OPENMC_TRACE_ITT)
+
+//==============================================================================
+// ITT tasks for VTune. Timed phases need not be nested, so they are written as
+// overlapped tasks identified by their handle.
+//==============================================================================
+
+namespace {
+
+__itt_domain* domain()
+{
+  static __itt_domain* d = __itt_domain_create("OpenMC");
+  return d;
+}
+
+std::atomic<uint64_t> next_handle {1};
+
+} // namespace
+
+uint64_t trace_begin(const char* name)
+{
+  uint64_t handle = next_handle++;
+  __itt_id id = __itt_id_make(nullptr, handle);
+  __itt_task_begin_overlapped(
+    domain(), id, __itt_null, __itt_string_handle_create(name));
+  return handle;
+}
+
+void trace_end(uint64_t handle)
+{
+  __itt_task_end_overlapped(domain(), __itt_id_make(nullptr, handle));
+}
+
+void write_trace() {}
+
+#else
+
+//==============================================================================
+// Chrome trace events, which can be viewed in Perfetto or chrome://tracing.
+// Ranges are written as async events, which need not be nested.
+//==============================================================================
+
+namespace {
+
+struct TraceEvent {
+  const char* name; //!< name of the range
+  char phase;       //!< 'b' at the beginning of a range and 'e' at its end
+  uint64_t handle;  //!< handle of the range
+  int thread;       //!< thread that recorded the event
+  double time;      //!< time of the event in [us]
+};
+
+using clock = std::chrono::steady_clock;
+
+const clock::time_point trace_start = clock::now();
+std::atomic<uint64_t> next_handle {1};
+std::mutex events_mutex;
+vector<TraceEvent> events;
+vector<const char*> names; //!< name of each range, indexed by handle
+
+void record(const char* name, char phase, uint64_t handle)
+{
+  std::chrono::duration<double, std::micro> t = clock::now() - trace_start;
+  std::lock_guard<std::mutex> lock {events_mutex};
+  events.push_back({name, phase, handle, thread_num(), t.count()});
+}
+
+} // namespace
+
+uint64_t trace_begin(const char* name)
+{
+  uint64_t handle = next_handle++;
+  {
+    std::lock_guard<std::mutex> lock {events_mutex};
+    if (names.size() <= handle)
+      names.resize(handle + 1);
+    names[handle] = name;
+  }
+  record(name, 'b', handle);
+  return handle;
+}
+
+void trace_end(uint64_t handle)
+{
+  const char* name;
+  {
+    std::lock_guard<std::mutex> lock {events_mutex};
+    name = names[handle];
+  }
+  record(name, 'e', handle);
+}
+
+void write_trace()
+{
+  std::string filename =
+    mpi::n_procs > 1
+      ? fmt::format("{}trace.{}.json", settings::path_output, mpi::rank)
+      : fmt::format("{}trace.json", settings::path_output);
+  std::FILE* f = std::fopen(filename.c_str(), "w");
+  if (!f)
+    return;
+
+  std::lock_guard<std::mutex> lock {events_mutex};
+  fmt::print(f, "{{\"traceEvents\":[");
+  for (int i = 0; i < events.size(); ++i) {
+    const auto& e = events[i];
+    fmt::print(f,
+      "{}\n{{\"name\":\"{}\",\"cat\":\"openmc\",\"ph\":\"{}\",\"id\":{},"
+      "\"pid\":{},\"tid\":{},\"ts\":{:.3f}}}",
+      i == 0 ? "" : ",", e.name, e.phase, e.handle, mpi::rank, e.thread,
+      e.time);
+  }
+  fmt::print(f, "\n]}}\n");
+  std::fclose(f);
+}
+
+#endif
+
+} // namespace openmc
+
+#endif // OPENMC_TRACE
@@ -3,6 +3,7 @@
 #include "openmc/constants.h"
 #include "openmc/hdf5_interface.h"
 #include "openmc/message_passing.h"
+#include "openmc/openmp_interface.h"
 #include "openmc/position.h"
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
@@ -14,6 +15,7 @@
 
 #include <cstddef> // for size_t
 #include <string>
+#include <utility> // for move
 
 namespace openmc {
 
@@ -25,6 +27,63 @@ hid_t track_file;     //! HDF5 identifier for track file
 hid_t track_dtype;    //! HDF5 identifier for track datatype
 int n_tracks_written; //! Number of tracks written
 
+namespace {
+
+// Track of one particle that has not been written to the track file yet
+struct PendingTrack {
+  std::string name;          // name of the dataset
+  vector<int> offsets;       // index of the first state of each track
+  vector<int> particles;     // type of each primary/secondary particle
+  vector<TrackState> states; // states of all tracks, one after another
+};
+
+// Tracks finished by one thread and the memory in bytes of their states
+struct TrackBuffer {
+  vector<PendingTrack> tracks;
+  size_t n_bytes {0};
+};
+
+vector<TrackBuffer> track_buffers; // buffer of each thread
+
+void write_track(const PendingTrack& track)
+{
+  // Write array of TrackState to file
+  hsize_t dims[] {static_cast<hsize_t>(track.states.size())};
+  hid_t dspace = H5Screate_simple(1, dims, nullptr);
+  hid_t dset = H5Dcreate(track_file, track.name.c_str(), track_dtype, dspace,
+    H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  H5Dwrite(
+    dset, track_dtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, track.states.data());
+
+  // Write attributes
+  write_attribute(dset, "n_particles", track.particles.size());
+  write_attribute(dset, "offsets", track.offsets);
+  write_attribute(dset, "particles", track.particles);
+
+  // Free resources
+  H5Dclose(dset);
+  H5Sclose(dspace);
+}
+
+void flush_track_buffer(TrackBuffer& buffer)
+{
+  if (buffer.tracks.empty())
+    return;
+
+  // HDF5 calls are serialized with those writing the surface source. All
+  // tracks in the buffer are written while the other threads wait only once.
+#pragma omp critical(WriteHDF5)
+  {
+    for (const auto& track : buffer.tracks) {
+      write_track(track);
+    }
+  }
+  buffer.tracks.clear();
+  buffer.n_bytes = 0;
+}
+
+} // namespace
+
 //==============================================================================
 // Non-member functions
 //==============================================================================
@@ -78,10 +137,21 @@ void open_track_file()
   H5Tinsert(track_dtype, "material_id", HOFFSET(TrackState, material_id),
     H5T_NATIVE_INT);
   H5Tclose(postype);
+
+  track_buffers.resize(num_threads());
+}
+
+void flush_track_buffers()
+{
+  for (auto& buffer : track_buffers) {
+    flush_track_buffer(buffer);
+  }
 }
 
 void close_track_file()
 {
+  flush_track_buffers();
+  track_buffers.clear();
   H5Tclose(track_dtype);
   file_close(track_file);
 
@@ -115,44 +185,33 @@ bool check_track_criteria(const Particle& p)
 
 void finalize_particle_track(Particle& p)
 {
+  // Create name for dataset
+  PendingTrack track;
+  track.name = fmt::format("track_{}_{}_{}", simulation::current_batch,
+    simulation::current_gen, p.id());
+
   // Determine number of coordinates for each particle
-  vector<int> offsets;
-  vector<int> particles;
-  vector<TrackState> tracks;
   int offset = 0;
   for (auto& track_i : p.tracks()) {
-    offsets.push_back(offset);
-    particles.push_back(static_cast<int>(track_i.particle));
+    track.offsets.push_back(offset);
+    track.particles.push_back(static_cast<int>(track_i.particle));
     offset += track_i.states.size();
-    tracks.insert(tracks.end(), track_i.states.begin(), track_i.states.end());
-  }
-  offsets.push_back(offset);
-
-#pragma omp critical(FinalizeParticleTrack)
-  {
-    // Create name for dataset
-    std::string dset_name = fmt::format("track_{}_{}_{}",
-      simulation::current_batch, simulation::current_gen, p.id());
-
-    // Write array of TrackState to file
-    hsize_t dims[] {static_cast<hsize_t>(tracks.size())};
-    hid_t dspace = H5Screate_simple(1, dims, nullptr);
-    hid_t dset = H5Dcreate(track_file, dset_name.c_str(), track_dtype, dspace,
-      H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-    H5Dwrite(dset, track_dtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, tracks.data());
-
-    // Write attributes
-    write_attribute(dset, "n_particles", p.tracks().size());
-    write_attribute(dset, "offsets", offsets);
-    write_attribute(dset, "particles", particles);
-
-    // Free resources
-    H5Dclose(dset);
-    H5Sclose(dspace);
+    track.states.insert(
+      track.states.end(), track_i.states.begin(), track_i.states.end());
   }
+  track.offsets.push_back(offset);
 
   // Clear particle tracks
   p.tracks().clear();
+
+  // Hold the track in the buffer of this thread, which is written out once
+  // it reaches its memory limit
+  auto& buffer = track_buffers[thread_num()];
+  buffer.n_bytes += track.states.size() * sizeof(TrackState);
+  buffer.tracks.push_back(std::move(track));
+  if (buffer.n_bytes >= settings::track_buffer_memory * 1.0e6) {
+    flush_track_buffer(buffer);
+  }
 }
 
 } // namespace openmc
@@ -1,5 +1,7 @@
 #include "openmc/universe.h"
 
+#include <algorithm> // for min, max
+#include <cmath>     // for pow
 #include <set>
 
 #include "openmc/hdf5_interface.h"
@@ -74,10 +76,10 @@ BoundingBox Universe::bounding_box() const
 }
 
 //==============================================================================
-// UniversePartitioner implementation
+// ZPlanePartitioner implementation
 //==============================================================================
 
-UniversePartitioner::UniversePartitioner(const Universe& univ)
+ZPlanePartitioner::ZPlanePartitioner(const Universe& univ)
 {
   // Define an ordered set of surface indices that point to z-planes.  Use a
   // functor to to order the set by the z0_ values of the corresponding planes.
@@ -177,7 +179,7 @@ UniversePartitioner::UniversePartitioner(const Universe& univ)
   }
 }
 
-const vector<int32_t>& UniversePartitioner::get_cells(
+const vector<int32_t>& ZPlanePartitioner::get_cells(
   Position r, Direction u) const
 {
   // Perform a binary search for the partition containing the given coordinates.
@@ -214,4 +216,140 @@ const vector<int32_t>& UniversePartitioner::get_cells(
   }
 }
 
+//==============================================================================
+// OctreePartitioner implementation
+//==============================================================================
+
+OctreePartitioner::OctreePartitioner(const Universe& univ)
+{
+  // Find the bounding box of each cell, padded so that points on the surface
+  // of a cell are not missed due to round-off, and the extent of the finite
+  // bounds of all cells
+  lower_ = {INFTY, INFTY, INFTY};
+  upper_ = {-INFTY, -INFTY, -INFTY};
+  for (auto i_cell : univ.cells_) {
+    auto box = model::cells[i_cell]->bounding_box();
+    Position lower {box.xmin, box.ymin, box.zmin};
+    Position upper {box.xmax, box.ymax, box.zmax};
+    bool bounded = true;
+    for (int i = 0; i < 3; ++i) {
+      if (lower[i] > -INFTY) {
+        lower[i] -= TINY_BIT;
+        lower_[i] = std::min(lower_[i], lower[i]);
+        upper_[i] = std::max(upper_[i], lower[i]);
+      } else {
+        bounded = false;
+      }
+      if (upper[i] < INFTY) {
+        upper[i] += TINY_BIT;
+        lower_[i] = std::min(lower_[i], upper[i]);
+        upper_[i] = std::max(upper_[i], upper[i]);
+      } else {
+        bounded = false;
+      }
+    }
+
+    // Only cells that are unbounded in some direction can contain points
+    // outside of the octree
+    if (!bounded)
+      outside_.push_back(i_cell);
+    cells_.push_back(i_cell);
+    cell_lower_.push_back(lower);
+    cell_upper_.push_back(upper);
+  }
+
+  // If no cell is bounded along some axis, every cell is unbounded and the
+  // octree would not exclude any of them
+  for (int i = 0; i < 3; ++i) {
+    if (lower_[i] >= upper_[i]) {
+      mean_cells_ = cells_.size();
+      return;
+    }
+  }
+
+  vector<int> cells(cells_.size());
+  for (int j = 0; j < cells.size(); ++j) {
+    cells[j] = j;
+  }
+  nodes_.resize(1);
+  this->build(0, lower_, upper_, cells, 0);
+}
+
+void OctreePartitioner::build(int i_node, Position lower, Position upper,
+  const vector<int>& cells, int depth)
+{
+  Position center = 0.5 * (lower + upper);
+  nodes_[i_node].center = center;
+
+  // Find the cells overlapping each octant. Octant k lies on the positive side
+  // of the center along axis i if bit i of k is set.
+  vector<Position> octant_lower(8);
+  vector<Position> octant_upper(8);
+  vector<vector<int>> octants;
+  if (cells.size() > LEAF_CELLS && depth < MAX_DEPTH) {
+    octants.resize(8);
+    size_t n_total = 0;
+    for (int k = 0; k < 8; ++k) {
+      auto& lo = octant_lower[k];
+      auto& hi = octant_upper[k];
+      for (int i = 0; i < 3; ++i) {
+        bool positive = (k >> i) & 1;
+        lo[i] = positive ? center[i] : lower[i];
+        hi[i] = positive ? upper[i] : center[i];
+      }
+      for (auto j : cells) {
+        const auto& cell_lo = cell_lower_[j];
+        const auto& cell_hi = cell_upper_[j];
+        if (cell_lo.x <= hi.x && cell_hi.x >= lo.x && cell_lo.y <= hi.y &&
+            cell_hi.y >= lo.y && cell_lo.z <= hi.z && cell_hi.z >= lo.z)
+          octants[k].push_back(j);
+      }
+      n_total += octants[k].size();
+    }
+
+    // Only divide the node if an octant has far fewer candidates on average.
+    // This also bounds the memory used by cells that span many octants.
+    if (n_total > 4 * cells.size())
+      octants.clear();
+  }
+
+  if (octants.empty()) {
+    nodes_[i_node].leaf = leaves_.size();
+    leaves_.emplace_back();
+    for (auto j : cells) {
+      leaves_.back().push_back(cells_[j]);
+    }
+    mean_cells_ += cells.size() * std::pow(0.125, depth);
+    return;
+  }
+
+  // Children are stored contiguously so that they can be found from the
+  // octant alone
+  int first_child = nodes_.size();
+  nodes_[i_node].first_child = first_child;
+  nodes_.resize(first_child + 8);
+  for (int k = 0; k < 8; ++k) {
+    this->build(first_child + k, octant_lower[k], octant_upper[k], octants[k],
+      depth + 1);
+  }
+}
+
+const vector<int32_t>& OctreePartitioner::get_cells(
+  Position r, Direction u) const
+{
+  if (nodes_.empty() || r.x < lower_.x || r.x > upper_.x || r.y < lower_.y ||
+      r.y > upper_.y || r.z < lower_.z || r.z > upper_.z)
+    return outside_;
+
+  // Descend into the octant containing the coordinates until reaching a leaf
+  int i_node = 0;
+  while (nodes_[i_node].first_child >= 0) {
+    const auto& node = nodes_[i_node];
+    int k = (r.x >= node.center.x) | (r.y >= node.center.y) << 1 |
+            (r.z >= node.center.z) << 2;
+    i_node = node.first_child + k;
+  }
+  return leaves_[nodes_[i_node].leaf];
+}
+
 } // namespace openmc
@@ -6,6 +6,7 @@
 #include "openmc/error.h"
 #include "openmc/geometry.h"
 #include "openmc/hdf5_interface.h"
+#include "openmc/lattice.h"
 #include "openmc/material.h"
 #include "openmc/message_passing.h"
 #include "openmc/mgxs_interface.h"
@@ -15,14 +16,15 @@
 #include "openmc/random_lcg.h"
 #include "openmc/settings.h"
 #include "openmc/timer.h"
+#include "openmc/universe.h"
 #include "openmc/xml_interface.h"
 
 #include "xtensor/xadapt.hpp"
 #include "xtensor/xview.hpp"
 #include <fmt/core.h>
 
-#include <algorithm> // for copy
-#include <cmath>     // for pow, sqrt
+#include <algorithm> // for copy, find, max, min
+#include <cmath>     // for cos, pow, sin, sqrt
 #include <unordered_set>
 
 namespace openmc {
@@ -61,6 +63,19 @@ VolumeCalculation::VolumeCalculation(pugi::xml_node node)
   upper_right_ = get_node_array<double>(node, "upper_right");
   n_samples_ = std::stoull(get_node_value(node, "samples"));
 
+  // Read how the fraction of the bounding box in each domain is estimated
+  if (check_for_node(node, "estimator")) {
+    std::string estimator = get_node_value(node, "estimator", true);
+    if (estimator == "point") {
+      estimator_ = Estimator::POINT;
+    } else if (estimator == "ray") {
+      estimator_ = Estimator::RAY;
+    } else {
+      fatal_error(fmt::format(
+        "Unrecognized estimator '{}' for a volume calculation.", estimator));
+    }
+  }
+
   if (check_for_node(node, "threshold")) {
     pugi::xml_node threshold_node = node.child("threshold");
 
@@ -93,6 +108,302 @@ VolumeCalculation::VolumeCalculation(pugi::xml_node node)
   }
 }
 
+namespace {
+
+// Fraction of a sample that was found in one material of a domain
+struct VolumeContribution {
+  int domain;
+  int material;
+  double fraction;
+};
+
+// Sums over samples of the fraction of each sample found in each domain and of
+// its square, in total and for each material the domain was found to contain.
+// Only the domains that were found are visited when adding or clearing.
+class VolumeScores {
+public:
+  explicit VolumeScores(int n_domains)
+    : sum_(n_domains, 0.0), sum_sq_(n_domains, 0.0), materials_(n_domains),
+      mat_sum_(n_domains), mat_sum_sq_(n_domains)
+  {}
+
+  // Add one sample. Each contribution has a distinct domain and material.
+  void add_sample(const vector<VolumeContribution>& sample)
+  {
+    for (int i = 0; i < sample.size(); ++i) {
+      const auto& c = sample[i];
+
+      // Add the total of the domain once, for its first contribution
+      bool first = true;
+      double total = 0.0;
+      for (int j = 0; j < sample.size(); ++j) {
+        if (sample[j].domain == c.domain) {
+          if (j < i)
+            first = false;
+          total += sample[j].fraction;
+        }
+      }
+      if (first)
+        add_domain(c.domain, total, total * total);
+
+      add_material(
+        c.domain, c.material, c.fraction, c.fraction * c.fraction);
+    }
+  }
+
+  // Add the sums of other scores
+  void add(const VolumeScores& other)
+  {
+    for (int d : other.touched_) {
+      add_domain(d, other.sum_[d], other.sum_sq_[d]);
+      for (int j = 0; j < other.materials_[d].size(); ++j) {
+        add_material(d, other.materials_[d][j], other.mat_sum_[d][j],
+          other.mat_sum_sq_[d][j]);
+      }
+    }
+  }
+
+  void clear()
+  {
+    for (int d : touched_) {
+      sum_[d] = 0.0;
+      sum_sq_[d] = 0.0;
+      materials_[d].clear();
+      mat_sum_[d].clear();
+      mat_sum_sq_[d].clear();
+    }
+    touched_.clear();
+  }
+
+  // Serialize the sums of the domains that were found as (domain, sum,
+  // sum_sq, number of materials, (material, sum, sum_sq)...) records
+  vector<double> pack() const
+  {
+    vector<double> buffer;
+    for (int d : touched_) {
+      buffer.insert(buffer.end(),
+        {static_cast<double>(d), sum_[d], sum_sq_[d],
+          static_cast<double>(materials_[d].size())});
+      for (int j = 0; j < materials_[d].size(); ++j) {
+        buffer.insert(buffer.end(), {static_cast<double>(materials_[d][j]),
+                                      mat_sum_[d][j], mat_sum_sq_[d][j]});
+      }
+    }
+    return buffer;
+  }
+
+  // Add sums serialized by pack()
+  void add_packed(const vector<double>& buffer)
+  {
+    for (size_t k = 0; k < buffer.size();) {
+      int d = buffer[k];
+      add_domain(d, buffer[k + 1], buffer[k + 2]);
+      int n_mat = buffer[k + 3];
+      k += 4;
+      for (int j = 0; j < n_mat; ++j, k += 3) {
+        add_material(d, buffer[k], buffer[k + 1], buffer[k + 2]);
+      }
+    }
+  }
+
+  double sum(int d) const { return sum_[d]; }
+  double sum_sq(int d) const { return sum_sq_[d]; }
+  const vector<int>& materials(int d) const { return materials_[d]; }
+  double mat_sum(int d, int j) const { return mat_sum_[d][j]; }
+  double mat_sum_sq(int d, int j) const { return mat_sum_sq_[d][j]; }
+
+private:
+  void add_domain(int d, double sum, double sum_sq)
+  {
+    if (materials_[d].empty())
+      touched_.push_back(d);
+    sum_[d] += sum;
+    sum_sq_[d] += sum_sq;
+  }
+
+  void add_material(int d, int i_material, double sum, double sum_sq)
+  {
+    auto& mats = materials_[d];
+    auto it = std::find(mats.begin(), mats.end(), i_material);
+    if (it == mats.end()) {
+      mats.push_back(i_material);
+      mat_sum_[d].push_back(sum);
+      mat_sum_sq_[d].push_back(sum_sq);
+    } else {
+      mat_sum_[d][it - mats.begin()] += sum;
+      mat_sum_sq_[d][it - mats.begin()] += sum_sq;
+    }
+  }
+
+  vector<double> sum_;
+  vector<double> sum_sq_;
+  vector<vector<int>> materials_;
+  vector<vector<double>> mat_sum_;
+  vector<vector<double>> mat_sum_sq_;
+  vector<int> touched_; // domains with a contribution, in order found
+};
+
+// Maximum number of segments a ray is tracked through
+constexpr int MAX_RAY_SEGMENTS {1000000};
+
+// Add a fraction of a sample to the contribution of a domain and material
+void add_contribution(vector<VolumeContribution>& sample, int domain,
+  int material, double fraction)
+{
+  for (auto& c : sample) {
+    if (c.domain == domain && c.material == material) {
+      c.fraction += fraction;
+      return;
+    }
+  }
+  sample.push_back({domain, material, fraction});
+}
+
+// Index of the domain of each cell, material, or universe, or -1 for those
+// that are not a domain
+vector<int> domain_indices(const VolumeCalculation& vol)
+{
+  using Domain = VolumeCalculation::TallyDomain;
+  vector<int> index;
+  switch (vol.domain_type_) {
+  case Domain::MATERIAL:
+    index.resize(model::materials.size(), -1);
+    for (int i = 0; i < vol.domain_ids_.size(); ++i)
+      index[model::material_map[vol.domain_ids_[i]]] = i;
+    break;
+  case Domain::CELL:
+    index.resize(model::cells.size(), -1);
+    for (int i = 0; i < vol.domain_ids_.size(); ++i)
+      index[model::cell_map[vol.domain_ids_[i]]] = i;
+    break;
+  case Domain::UNIVERSE:
+    index.resize(model::universes.size(), -1);
+    for (int i = 0; i < vol.domain_ids_.size(); ++i)
+      index[model::universe_map[vol.domain_ids_[i]]] = i;
+    break;
+  }
+  return index;
+}
+
+// Add a fraction of a sample to each domain that contains a particle
+void score_domains(const VolumeCalculation& vol, const GeometryState& p,
+  const vector<int>& domain_index, double fraction,
+  vector<VolumeContribution>& sample)
+{
+  using Domain = VolumeCalculation::TallyDomain;
+  if (vol.domain_type_ == Domain::MATERIAL) {
+    if (p.material() != MATERIAL_VOID) {
+      int i_domain = domain_index[p.material()];
+      if (i_domain >= 0)
+        add_contribution(sample, i_domain, p.material(), fraction);
+    }
+  } else {
+    for (int level = 0; level < p.n_coord(); ++level) {
+      int i_domain = vol.domain_type_ == Domain::CELL
+                       ? domain_index[p.coord(level).cell]
+                       : domain_index[p.coord(level).universe];
+      if (i_domain >= 0)
+        add_contribution(sample, i_domain, p.material(), fraction);
+    }
+  }
+}
+
+// Score whether a point sampled in the bounding box is in each domain
+void sample_point(const VolumeCalculation& vol, GeometryState& p,
+  uint64_t* seed, const vector<int>& domain_index,
+  vector<VolumeContribution>& sample)
+{
+  p.n_coord() = 1;
+  Position xi {prn(seed), prn(seed), prn(seed)};
+  p.r() = vol.lower_left_ + xi * (vol.upper_right_ - vol.lower_left_);
+  p.u() = {1. / std::sqrt(3.), 1. / std::sqrt(3.), 1. / std::sqrt(3.)};
+
+  // If this location is not in the geometry at all, there is no contribution
+  if (exhaustive_find_cell(p))
+    score_domains(vol, p, domain_index, 1.0, sample);
+}
+
+// Score the fraction of a ray across the bounding box in each domain
+void sample_ray(const VolumeCalculation& vol, GeometryState& p,
+  uint64_t* seed, const vector<int>& domain_index,
+  vector<VolumeContribution>& sample)
+{
+  // Sample a point in the bounding box and an isotropic direction
+  Position xi {prn(seed), prn(seed), prn(seed)};
+  Position r = vol.lower_left_ + xi * (vol.upper_right_ - vol.lower_left_);
+  double mu = 2.0 * prn(seed) - 1.0;
+  double phi = 2.0 * PI * prn(seed);
+  double s = std::sqrt(1.0 - mu * mu);
+  Direction u {s * std::cos(phi), s * std::sin(phi), mu};
+
+  // Find the chord of the bounding box through the point. Since the point is
+  // uniformly distributed along the chord, the fraction of the chord in a
+  // domain is an unbiased estimate of the fraction of the box it fills.
+  double t_min = -INFTY;
+  double t_max = INFTY;
+  for (int i = 0; i < 3; ++i) {
+    if (u[i] == 0.0)
+      continue;
+    double t0 = (vol.lower_left_[i] - r[i]) / u[i];
+    double t1 = (vol.upper_right_[i] - r[i]) / u[i];
+    t_min = std::max(t_min, std::min(t0, t1));
+    t_max = std::min(t_max, std::max(t0, t1));
+  }
+  double length = t_max - t_min;
+
+  // Track the ray through the geometry from one side of the box to the other
+  p.init_from_r_u(r + t_min * u, u);
+  bool found = exhaustive_find_cell(p);
+  double traveled = 0.0;
+  for (int i = 0; i < MAX_RAY_SEGMENTS && traveled < length; ++i) {
+    if (!found) {
+      // Move through the void to where the ray enters the geometry again
+      double d = distance_to_geometry(p) + TINY_BIT;
+      traveled += d;
+      if (traveled >= length)
+        break;
+      p.n_coord() = 1;
+      p.r() += d * u;
+      p.surface() = 0;
+      found = exhaustive_find_cell(p);
+      continue;
+    }
+
+    auto boundary = distance_to_boundary(p);
+    double d = std::min(boundary.distance, length - traveled);
+    score_domains(vol, p, domain_index, d / length, sample);
+    traveled += d;
+    if (traveled >= length)
+      break;
+
+    // Move to the boundary and find the cell on the other side
+    for (int j = 0; j < p.n_coord(); ++j) {
+      p.coord(j).r += d * p.coord(j).u;
+    }
+    p.surface() = boundary.surface_index;
+    p.n_coord_last() = p.n_coord();
+    p.n_coord() = boundary.coord_level;
+    const auto& t = boundary.lattice_translation;
+    if (t[0] != 0 || t[1] != 0 || t[2] != 0) {
+      // A ray leaving the lattice may leave the geometry, which must not be
+      // treated as a lost particle
+      const auto& coord = p.lowest_coord();
+      array<int, 3> i_xyz {coord.lattice_i[0] + t[0],
+        coord.lattice_i[1] + t[1], coord.lattice_i[2] + t[2]};
+      if (model::lattices[coord.lattice]->are_valid_indices(i_xyz)) {
+        cross_lattice(p, boundary);
+        continue;
+      }
+    } else if (neighbor_list_find_cell(p)) {
+      continue;
+    }
+    p.n_coord() = 1;
+    found = exhaustive_find_cell(p);
+  }
+}
+
+} // namespace
+
 vector<VolumeCalculation::Result> VolumeCalculation::execute() const
 {
   // Check to make sure domain IDs are valid
@@ -120,12 +431,13 @@ vector<VolumeCalculation::Result> VolumeCalculation::execute() const
     }
   }
 
-  // Shared data that is collected from all threads
+  // Index of the domain of each cell, material, or universe so that the
+  // domains containing a point are found without searching
   int n = domain_ids_.size();
-  vector<vector<uint64_t>> master_indices(
-    n); // List of material indices for each domain
-  vector<vector<uint64_t>> master_hits(
-    n); // Number of hits for each material in each domain
+  vector<int> domain_index = domain_indices(*this);
+
+  // Scores collected from all threads and processes over all iterations
+  VolumeScores totals(n);
   int iterations = 0;
 
   // Divide work over MPI processes
@@ -141,75 +453,67 @@ vector<VolumeCalculation::Result> VolumeCalculation::execute() const
     i_end = i_start + min_samples;
   }
 
+  // Samples are scored in blocks. The scores of the blocks are added in
+  // order, so the results do not depend on the number of threads.
+  constexpr uint64_t block_size {1024};
+  uint64_t n_blocks = (i_end - i_start + block_size - 1) / block_size;
+
   while (true) {
+    VolumeScores scores(n);
 
 #pragma omp parallel
     {
       // Variables that are private to each thread
-      vector<vector<uint64_t>> indices(n);
-      vector<vector<uint64_t>> hits(n);
+      VolumeScores block_scores(n);
+      vector<VolumeContribution> sample;
       Particle p;
 
-// Sample locations and count hits
-#pragma omp for
-      for (size_t i = i_start; i < i_end; i++) {
-        uint64_t id = iterations * n_samples_ + i;
-        uint64_t seed = init_seed(id, STREAM_VOLUME);
-
-        p.n_coord() = 1;
-        Position xi {prn(&seed), prn(&seed), prn(&seed)};
-        p.r() = lower_left_ + xi * (upper_right_ - lower_left_);
-        p.u() = {1. / std::sqrt(3.), 1. / std::sqrt(3.), 1. / std::sqrt(3.)};
-
-        // If this location is not in the geometry at all, move on to next block
-        if (!exhaustive_find_cell(p))
-          continue;
-
-        if (domain_type_ == TallyDomain::MATERIAL) {
-          if (p.material() != MATERIAL_VOID) {
-            for (int i_domain = 0; i_domain < n; i_domain++) {
-              if (model::materials[p.material()]->id_ ==
-                  domain_ids_[i_domain]) {
-                this->check_hit(
-                  p.material(), indices[i_domain], hits[i_domain]);
-                break;
-              }
-            }
-          }
-        } else if (domain_type_ == TallyDomain::CELL) {
-          for (int level = 0; level < p.n_coord(); ++level) {
-            for (int i_domain = 0; i_domain < n; i_domain++) {
-              if (model::cells[p.coord(level).cell]->id_ ==
-                  domain_ids_[i_domain]) {
-                this->check_hit(
-                  p.material(), indices[i_domain], hits[i_domain]);
-                break;
-              }
-            }
-          }
-        } else if (domain_type_ == TallyDomain::UNIVERSE) {
-          for (int level = 0; level < p.n_coord(); ++level) {
-            for (int i_domain = 0; i_domain < n; ++i_domain) {
-              if (model::universes[p.coord(level).universe]->id_ ==
-                  domain_ids_[i_domain]) {
-                check_hit(p.material(), indices[i_domain], hits[i_domain]);
-                break;
-              }
-            }
+#pragma omp for ordered schedule(static, 1)
+      for (uint64_t b = 0; b < n_blocks; ++b) {
+        uint64_t first = i_start + b * block_size;
+        uint64_t last = std::min(first + block_size, i_end);
+        for (uint64_t i = first; i < last; ++i) {
+          uint64_t id = iterations * n_samples_ + i;
+          uint64_t seed = init_seed(id, STREAM_VOLUME);
+
+          sample.clear();
+          if (estimator_ == Estimator::RAY) {
+            sample_ray(*this, p, &seed, domain_index, sample);
+          } else {
+            sample_point(*this, p, &seed, domain_index, sample);
           }
+          block_scores.add_sample(sample);
         }
-      }
 
-      // At this point, each thread has its own pair of index/hits lists and we
-      // now need to reduce them. OpenMP is not nearly smart enough to do this
-      // on its own, so we have to manually reduce them
-      for (int i_domain = 0; i_domain < n; ++i_domain) {
-        reduce_indices_hits(indices[i_domain], hits[i_domain],
-          master_indices[i_domain], master_hits[i_domain]);
+#pragma omp ordered
+        scores.add(block_scores);
+        block_scores.clear();
       }
     } // omp parallel
 
-    // Reduce hits onto master process
+    // Reduce scores onto master process in order of the processes
+    if (mpi::master) {
+      totals.add(scores);
+    }
+#ifdef OPENMC_MPI
+    if (mpi::master) {
+      for (int j = 1; j < mpi::n_procs; j++) {
+        int64_t q;
+        MPI_Recv(
+          &q, 1, MPI_INT64_T, j, 2 * j, mpi::intracomm, MPI_STATUS_IGNORE);
+        vector<double> buffer(q);
+        MPI_Recv(buffer.data(), q, MPI_DOUBLE, j, 2 * j + 1, mpi::intracomm,
+          MPI_STATUS_IGNORE);
+        totals.add_packed(buffer);
+      }
+    } else {
+      auto buffer = scores.pack();
+      int64_t q = buffer.size();
+      MPI_Send(&q, 1, MPI_INT64_T, 0, 2 * mpi::rank, mpi::intracomm);
+      MPI_Send(buffer.data(), q, MPI_DOUBLE, 0, 2 * mpi::rank + 1,
+        mpi::intracomm);
+    }
+#endif
 
     // Determine volume of bounding box
     Position d {upper_right_ - lower_left_};
@@ -244,54 +548,16 @@ vector<VolumeCalculation::Result> VolumeCalculation::execute() const
         settings::run_CE ? data::nuclides.size() : data::mg.nuclides_.size();
       xt::xtensor<double, 2> atoms({n_nuc, 2}, 0.0);
 
-#ifdef OPENMC_MPI
       if (mpi::master) {
-        for (int j = 1; j < mpi::n_procs; j++) {
-          int q;
-          // retrieve results
-          MPI_Recv(
-            &q, 1, MPI_UINT64_T, j, 2 * j, mpi::intracomm, MPI_STATUS_IGNORE);
-          vector<uint64_t> buffer(2 * q);
-          MPI_Recv(buffer.data(), 2 * q, MPI_UINT64_T, j, 2 * j + 1,
-            mpi::intracomm, MPI_STATUS_IGNORE);
-          for (int k = 0; k < q; ++k) {
-            bool already_added = false;
-            for (int m = 0; m < master_indices[i_domain].size(); ++m) {
-              if (buffer[2 * k] == master_indices[i_domain][m]) {
-                master_hits[i_domain][m] += buffer[2 * k + 1];
-                already_added = true;
-                break;
-              }
-            }
-            if (!already_added) {
-              master_indices[i_domain].push_back(buffer[2 * k]);
-              master_hits[i_domain].push_back(buffer[2 * k + 1]);
-            }
-          }
-        }
-      } else {
-        int q = master_indices[i_domain].size();
-        vector<uint64_t> buffer(2 * q);
-        for (int k = 0; k < q; ++k) {
-          buffer[2 * k] = master_indices[i_domain][k];
-          buffer[2 * k + 1] = master_hits[i_domain][k];
-        }
-
-        MPI_Send(&q, 1, MPI_UINT64_T, 0, 2 * mpi::rank, mpi::intracomm);
-        MPI_Send(buffer.data(), 2 * q, MPI_UINT64_T, 0, 2 * mpi::rank + 1,
-          mpi::intracomm);
-      }
-#endif
-
-      if (mpi::master) {
-        size_t total_hits = 0;
-        for (int j = 0; j < master_indices[i_domain].size(); ++j) {
-          total_hits += master_hits[i_domain][j];
-          double f =
-            static_cast<double>(master_hits[i_domain][j]) / total_samples;
-          double var_f = f * (1.0 - f) / total_samples;
-
-          int i_material = master_indices[i_domain][j];
+        // Mean fraction of a sample in the domain and its variance. For point
+        // samples, each fraction is either zero or one.
+        const auto& mats = totals.materials(i_domain);
+        for (int j = 0; j < mats.size(); ++j) {
+          double f = totals.mat_sum(i_domain, j) / total_samples;
+          double mean_sq = totals.mat_sum_sq(i_domain, j) / total_samples;
+          double var_f = std::max(mean_sq - f * f, 0.0) / total_samples;
+
+          int i_material = mats[j];
           if (i_material == MATERIAL_VOID)
             continue;
 
@@ -305,11 +571,11 @@ vector<VolumeCalculation::Result> VolumeCalculation::execute() const
         }
 
         // Determine volume
-        result.volume[0] =
-          static_cast<double>(total_hits) / total_samples * volume_sample;
-        result.volume[1] =
-          std::sqrt(result.volume[0] * (volume_sample - result.volume[0]) /
-                    total_samples);
+        double f = totals.sum(i_domain) / total_samples;
+        double mean_sq = totals.sum_sq(i_domain) / total_samples;
+        double var_f = std::max(mean_sq - f * f, 0.0) / total_samples;
+        result.volume[0] = f * volume_sample;
+        result.volume[1] = std::sqrt(var_f) * volume_sample;
         result.iterations = iterations;
 
         // update threshold value if needed
@@ -365,20 +631,6 @@ vector<VolumeCalculation::Result> VolumeCalculation::execute() const
     if (trigger_val < threshold_) {
       return results;
     }
-
-#ifdef OPENMC_MPI
-    // if iterating in an MPI run, need to zero indices and hits so they aren't
-    // counted twice
-    if (!mpi::master) {
-      for (auto& v : master_indices) {
-        std::fill(v.begin(), v.end(), 0);
-      }
-      for (auto& v : master_hits) {
-        std::fill(v.begin(), v.end(), 0);
-      }
-    }
-#endif
-
   } // end while
 }
 
@@ -401,6 +653,8 @@ void VolumeCalculation::to_hdf5(
 
   // Write basic metadata
   write_attribute(file_id, "samples", n_samples_);
+  write_attribute(
+    file_id, "estimator", estimator_ == Estimator::RAY ? "ray" : "point");
   write_attribute(file_id, "lower_left", lower_left_);
   write_attribute(file_id, "upper_right", upper_right_);
   // Write trigger info
@@ -466,27 +720,6 @@ void VolumeCalculation::to_hdf5(
   file_close(file_id);
 }
 
-void VolumeCalculation::check_hit(
-  int i_material, vector<uint64_t>& indices, vector<uint64_t>& hits) const
-{
-
-  // Check if this material was previously hit and if so, increment count
-  bool already_hit = false;
-  for (int j = 0; j < indices.size(); j++) {
-    if (indices[j] == i_material) {
-      hits[j]++;
-      already_hit = true;
-    }
-  }
-
-  // If the material was not previously hit, append an entry to the material
-  // indices and hits lists
-  if (!already_hit) {
-    indices.push_back(i_material);
-    hits.push_back(1);
-  }
-}
-
 void free_memory_volume()
 {
   openmc::model::volume_calcs.clear();
@@ -12,6 +12,7 @@
 #include "xtensor/xstrided_view.hpp"
 #include "xtensor/xview.hpp"
 
+#include "openmc/cell.h"
 #include "openmc/error.h"
 #include "openmc/file_utils.h"
 #include "openmc/hdf5_interface.h"
@@ -22,6 +23,7 @@
 #include "openmc/particle.h"
 #include "openmc/particle_data.h"
 #include "openmc/physics_common.h"
+#include "openmc/random_ray/flat_source_domain.h"
 #include "openmc/search.h"
 #include "openmc/settings.h"
 #include "openmc/tallies/filter_energy.h"
@@ -44,6 +46,9 @@ namespace variance_reduction {
 std::unordered_map<int32_t, int32_t> ww_map;
 openmc::vector<unique_ptr<WeightWindows>> weight_windows;
 openmc::vector<unique_ptr<WeightWindowsGenerator>> weight_windows_generators;
+WeightWindowsIndex ww_index;
+vector<ExponentialTransform> exponential_transforms;
+vector<int> cell_exponential_transform;
 
 } // namespace variance_reduction
 
@@ -51,30 +56,56 @@ openmc::vector<unique_ptr<WeightWindowsGenerator>> weight_windows_generators;
 // Non-member functions
 //==============================================================================
 
-void apply_weight_windows(Particle& p)
+bool apply_weight_windows(Particle& p)
 {
   if (!settings::weight_windows_on)
-    return;
+    return false;
 
   // WW on photon and neutron only
   if (p.type() != ParticleType::neutron && p.type() != ParticleType::photon)
-    return;
+    return false;
 
   // skip dead or no energy
   if (p.E() <= 0 || !p.alive())
-    return;
+    return false;
 
-  bool in_domain = false;
-  // TODO: this is a linear search - should do something more clever
+  // Look up a weight window, starting from the bins of the weight windows
+  // last found for the particle, and remember where it was found
   WeightWindow weight_window;
-  for (const auto& ww : variance_reduction::weight_windows) {
-    weight_window = ww->get_weight_window(p);
-    if (weight_window.is_valid())
-      break;
+  auto find_weight_window = [&p, &weight_window](int i) {
+    int mesh_bin = C_NONE;
+    int energy_bin = C_NONE;
+    if (i == p.ww_index()) {
+      mesh_bin = p.ww_mesh_bin();
+      energy_bin = p.ww_energy_bin();
+    }
+    const auto& ww = variance_reduction::weight_windows[i];
+    weight_window = ww->get_weight_window(p, mesh_bin, energy_bin);
+    if (!weight_window.is_valid())
+      return false;
+    p.ww_index() = i;
+    p.ww_mesh_bin() = mesh_bin;
+    p.ww_energy_bin() = energy_bin;
+    return true;
+  };
+
+  // Search the weight windows whose mesh may contain the particle, or all of
+  // them if they have changed since the index was built
+  const auto& ww_index = variance_reduction::ww_index;
+  if (ww_index.enabled()) {
+    for (auto i : ww_index.candidates(p.type(), p.r())) {
+      if (find_weight_window(i))
+        break;
+    }
+  } else {
+    for (int i = 0; i < variance_reduction::weight_windows.size(); ++i) {
+      if (find_weight_window(i))
+        break;
+    }
   }
   // particle is not in any of the ww domains, do nothing
   if (!weight_window.is_valid())
-    return;
+    return false;
 
   // get the paramters
   double weight = p.wgt();
@@ -82,7 +113,7 @@ void apply_weight_windows(Particle& p)
   // first check to see if particle should be killed for weight cutoff
   if (p.wgt() < weight_window.weight_cutoff) {
     p.wgt() = 0.0;
-    return;
+    return true;
   }
 
   // check if particle is far above current weight window
@@ -103,7 +134,7 @@ void apply_weight_windows(Particle& p)
   if (weight > weight_window.upper_weight) {
     // do not further split the particle if above the limit
     if (p.n_split() >= settings::max_history_splits)
-      return;
+      return true;
 
     double n_split = std::ceil(weight / weight_window.upper_weight);
     double max_split = weight_window.max_split;
@@ -111,11 +142,10 @@ void apply_weight_windows(Particle& p)
 
     p.n_split() += n_split;
 
-    // Create secondaries and divide weight among all particles
+    // Create secondaries and divide weight among all particles. The copies
+    // share a single site in the secondary bank.
     int i_split = std::round(n_split);
-    for (int l = 0; l < i_split - 1; l++) {
-      p.create_secondary(weight / n_split, p.u(), p.E(), p.type());
-    }
+    p.split(i_split - 1, weight / n_split);
     // remaining weight is applied to current particle
     p.wgt() = weight / n_split;
 
@@ -125,12 +155,31 @@ void apply_weight_windows(Particle& p)
       std::min(weight * weight_window.max_split, weight_window.survival_weight);
     russian_roulette(p, weight_survive);
   } // else particle is in the window, continue as normal
+  return true;
 }
 
 void free_memory_weight_windows()
 {
   variance_reduction::ww_map.clear();
   variance_reduction::weight_windows.clear();
+  variance_reduction::ww_index.clear();
+  variance_reduction::exponential_transforms.clear();
+  variance_reduction::cell_exponential_transform.clear();
+}
+
+const ExponentialTransform* get_exponential_transform(const Particle& p)
+{
+  const auto& cell_transform = variance_reduction::cell_exponential_transform;
+  if (cell_transform.empty())
+    return nullptr;
+
+  if (p.type() != ParticleType::neutron && p.type() != ParticleType::photon)
+    return nullptr;
+
+  int i_cell = p.lowest_coord().cell;
+  if (i_cell == C_NONE || cell_transform[i_cell] == C_NONE)
+    return nullptr;
+  return &variance_reduction::exponential_transforms[cell_transform[i_cell]];
 }
 
 //==============================================================================
@@ -332,6 +381,7 @@ void WeightWindows::set_particle_type(ParticleType p_type)
       fmt::format("Particle type '{}' cannot be applied to weight windows.",
         particle_type_to_str(p_type)));
   particle_type_ = p_type;
+  variance_reduction::ww_index.clear();
 }
 
 void WeightWindows::set_mesh(int32_t mesh_idx)
@@ -341,6 +391,7 @@ void WeightWindows::set_mesh(int32_t mesh_idx)
 
   mesh_idx_ = mesh_idx;
   allocate_ww_bounds();
+  variance_reduction::ww_index.clear();
 }
 
 void WeightWindows::set_mesh(const std::unique_ptr<Mesh>& mesh)
@@ -354,6 +405,14 @@ void WeightWindows::set_mesh(const Mesh* mesh)
 }
 
 WeightWindow WeightWindows::get_weight_window(const Particle& p) const
+{
+  int mesh_bin = C_NONE;
+  int energy_bin = C_NONE;
+  return get_weight_window(p, mesh_bin, energy_bin);
+}
+
+WeightWindow WeightWindows::get_weight_window(
+  const Particle& p, int& mesh_bin, int& energy_bin) const
 {
   // check for particle type
   if (particle_type_ != p.type()) {
@@ -362,7 +421,7 @@ WeightWindow WeightWindows::get_weight_window(const Particle& p) const
 
   // Get mesh index for particle's position
   const auto& mesh = this->mesh();
-  int mesh_bin = mesh->get_bin(p.r());
+  mesh_bin = mesh->get_bin_near(p.r(), mesh_bin);
 
   // particle is outside the weight window mesh
   if (mesh_bin < 0)
@@ -375,9 +434,16 @@ WeightWindow WeightWindows::get_weight_window(const Particle& p) const
   if (E < energy_bounds_.front() || E > energy_bounds_.back())
     return {};
 
-  // get the mesh bin in energy group
-  int energy_bin =
-    lower_bound_index(energy_bounds_.begin(), energy_bounds_.end(), E);
+  // get the mesh bin in energy group, unless the energy is still in the
+  // earlier one. Bins are bounded as in lower_bound_index.
+  int n_energy_bins = energy_bounds_.size() - 1;
+  if (energy_bin < 0 || energy_bin >= n_energy_bins ||
+      !((E > energy_bounds_[energy_bin] ||
+          (energy_bin == 0 && E == energy_bounds_[0])) &&
+        E <= energy_bounds_[energy_bin + 1])) {
+    energy_bin =
+      lower_bound_index(energy_bounds_.begin(), energy_bounds_.end(), E);
+  }
 
   // mesh_bin += energy_bin * mesh->n_bins();
   // Create individual weight window
@@ -483,15 +549,20 @@ void WeightWindows::set_bounds(
 
 void WeightWindows::update_magic(
   const Tally* tally, const std::string& value, double threshold, double ratio)
+{
+  update_weights(tally, WeightWindowUpdateMethod::MAGIC, value, threshold,
+    ratio);
+}
+
+void WeightWindows::update_weights(const Tally* tally,
+  WeightWindowUpdateMethod method, const std::string& value, double threshold,
+  double ratio, double damping)
 {
   ///////////////////////////
   // Setup and checks
   ///////////////////////////
   this->check_tally_update_compatibility(tally);
 
-  lower_ww_.fill(-1);
-  upper_ww_.fill(-1);
-
   // determine which value to use
   const std::set<std::string> allowed_values = {"mean", "rel_err"};
   if (allowed_values.count(value) == 0) {
@@ -556,9 +627,15 @@ void WeightWindows::update_magic(
     std::find(filter_types.begin(), filter_types.end(), FilterType::MESH) -
     filter_types.begin();
 
+  // sparse results are copied into a dense array first
+  xt::xtensor<double, 3> dense;
+  if (tally->sparse_storage())
+    tally->sparse_results_.to_dense(dense);
+  const auto& results = tally->sparse_storage() ? dense : tally->results();
+
   // get a fully reshaped view of the tally according to tally ordering of
   // filters
-  auto tally_values = xt::reshape_view(tally->results(), shape);
+  auto tally_values = xt::reshape_view(results, shape);
 
   // get a that is (particle, energy, mesh, scores, values)
   auto transposed_view = xt::transpose(tally_values, transpose);
@@ -587,12 +664,42 @@ void WeightWindows::update_magic(
     particle_idx = p_it - particles.begin();
   }
 
+  // Tally statistics are only accumulated on the master process when results
+  // are reduced, so the bounds are computed there and shared afterwards
+  bool shared = mpi::n_procs > 1 &&
+                (settings::reduce_tallies ||
+                  settings::solver_type == SolverType::RANDOM_RAY);
+  if (!shared || mpi::master) {
+    this->compute_bounds(transposed_view, particle_idx, score_index,
+      tally->n_realizations_, method, value, threshold, ratio, damping);
+  }
+
+#ifdef OPENMC_MPI
+  if (shared) {
+    MPI_Bcast(
+      lower_ww_.data(), lower_ww_.size(), MPI_DOUBLE, 0, mpi::intracomm);
+    MPI_Bcast(
+      upper_ww_.data(), upper_ww_.size(), MPI_DOUBLE, 0, mpi::intracomm);
+  }
+#endif
+}
+
+template<class T>
+void WeightWindows::compute_bounds(const T& transposed_view, int particle_idx,
+  int score_index, int n, WeightWindowUpdateMethod method,
+  const std::string& value, double threshold, double ratio, double damping)
+{
+  // With damping, the new bounds are blended with a copy of the current ones
+  bool damped = damping < 1.0;
+  xt::xtensor<double, 2> old_bounds;
+  if (damped)
+    old_bounds = lower_ww_;
+
   // down-select data based on particle and score
   auto sum = xt::view(transposed_view, particle_idx, xt::all(), xt::all(),
     score_index, static_cast<int>(TallyResult::SUM));
   auto sum_sq = xt::view(transposed_view, particle_idx, xt::all(), xt::all(),
     score_index, static_cast<int>(TallyResult::SUM_SQ));
-  int n = tally->n_realizations_;
 
   //////////////////////////////////////////////
   //
@@ -623,33 +730,57 @@ void WeightWindows::update_magic(
   auto mesh_vols = this->mesh()->volumes();
 
   int e_bins = new_bounds.shape()[0];
+  int n_mesh_bins = new_bounds.shape()[1];
   for (int e = 0; e < e_bins; e++) {
-    // select all
-    auto group_view = xt::view(new_bounds, e);
-
-    // divide by volume of mesh elements
-    for (int i = 0; i < group_view.size(); i++) {
-      group_view[i] /= mesh_vols[i];
+    // divide by volume of mesh elements. With FW-CADIS, the bounds are
+    // inversely proportional to the adjoint flux, i.e. the importance of each
+    // element.
+    double group_max = -INFTY;
+#pragma omp parallel for reduction(max : group_max)
+    for (int i = 0; i < n_mesh_bins; i++) {
+      double v = new_bounds(e, i) / mesh_vols[i];
+      if (method == WeightWindowUpdateMethod::FW_CADIS && v > 0.0)
+        v = 1.0 / v;
+      new_bounds(e, i) = v;
+      group_max = std::max(group_max, v);
     }
 
-    double group_max = *std::max_element(group_view.begin(), group_view.end());
     // normalize values in this energy group by the maximum value for this
     // group
-    if (group_max > 0.0)
-      group_view /= 2.0 * group_max;
+    if (group_max > 0.0) {
+#pragma omp parallel for
+      for (int i = 0; i < n_mesh_bins; i++) {
+        new_bounds(e, i) /= 2.0 * group_max;
+      }
+    }
   }
 
-  // make sure that values where the mean is zero are set s.t. the weight window
-  // value will be ignored
-  xt::filter(new_bounds, sum <= 0.0).fill(-1.0);
-
-  // make sure the weight windows are ignored for any locations where the
-  // relative error is higher than the specified relative error threshold
-  xt::filter(new_bounds, rel_err > threshold).fill(-1.0);
+#pragma omp parallel for collapse(2)
+  for (int e = 0; e < e_bins; e++) {
+    for (int i = 0; i < n_mesh_bins; i++) {
+      // make sure that values where the mean is zero or the relative error is
+      // higher than the specified relative error threshold are set s.t. the
+      // weight window value will be ignored
+      double v = new_bounds(e, i);
+      if (sum(e, i) <= 0.0 || rel_err(e, i) > threshold)
+        v = -1.0;
+
+      // with damping, bins without a usable result keep their current bounds
+      // and others move part of the way towards the new ones
+      if (damped) {
+        double v_old = old_bounds(e, i);
+        if (v < 0.0) {
+          v = v_old;
+        } else if (v_old > 0.0) {
+          v = std::pow(v_old, 1.0 - damping) * std::pow(v, damping);
+        }
+      }
 
-  // update the bounds of this weight window class
-  // noalias avoids additional memory allocation
-  xt::noalias(upper_ww_) = ratio * lower_ww_;
+      // update the bounds of this weight window class
+      new_bounds(e, i) = v;
+      upper_ww_(e, i) = ratio * v;
+    }
+  }
 }
 
 void WeightWindows::check_tally_update_compatibility(const Tally* tally)
@@ -661,6 +792,13 @@ void WeightWindows::check_tally_update_compatibility(const Tally* tally)
   // retrieve a mapping of filter type to filter index for the tally
   auto filter_indices = tally->filter_indices();
 
+  // results of every bin are needed on each process
+  if (tally->partitioned()) {
+    fatal_error(fmt::format("Partitioned tally {} cannot be used to update "
+                            "weight window bounds",
+      tally->id()));
+  }
+
   // a mesh filter is required for a tally used to update weight windows
   if (!filter_indices.count(FilterType::MESH)) {
     fatal_error(
@@ -761,7 +899,16 @@ WeightWindowsGenerator::WeightWindowsGenerator(pugi::xml_node node)
 
   // set method and parameters for updates
   method_ = get_node_value(node, "method");
-  if (method_ == "magic") {
+  if (method_ == "magic" || method_ == "fw_cadis") {
+    if (method_ == "fw_cadis") {
+      // The adjoint flux is only computed by the random ray solver
+      if (settings::solver_type != SolverType::RANDOM_RAY ||
+          !FlatSourceDomain::adjoint_) {
+        fatal_error("FW-CADIS weight window generation requires the random "
+                    "ray solver with an adjoint solve.");
+      }
+      update_method_ = WeightWindowUpdateMethod::FW_CADIS;
+    }
     // parse non-default update parameters if specified
     if (check_for_node(node, "update_parameters")) {
       pugi::xml_node params_node = node.child("update_parameters");
@@ -772,6 +919,8 @@ WeightWindowsGenerator::WeightWindowsGenerator(pugi::xml_node node)
       if (check_for_node(params_node, "ratio")) {
         ratio_ = std::stod(get_node_value(params_node, "ratio"));
       }
+      if (check_for_node(params_node, "damping"))
+        damping_ = std::stod(get_node_value(params_node, "damping"));
     }
     // check update parameter values
     if (tally_value_ != "mean" && tally_value_ != "rel_err") {
@@ -779,6 +928,12 @@ WeightWindowsGenerator::WeightWindowsGenerator(pugi::xml_node node)
                               "weight window generation.",
         tally_value_));
     }
+    if (update_method_ == WeightWindowUpdateMethod::FW_CADIS &&
+        tally_value_ != "mean") {
+      fatal_error(fmt::format("Only the 'mean' tally value can be used for "
+                              "FW-CADIS weight window generation, not '{}'.",
+        tally_value_));
+    }
     if (threshold_ <= 0.0)
       fatal_error(fmt::format("Invalid relative error threshold '{}' (<= 0.0) "
                               "specified for weight window generation",
@@ -786,6 +941,11 @@ WeightWindowsGenerator::WeightWindowsGenerator(pugi::xml_node node)
     if (ratio_ <= 1.0)
       fatal_error(fmt::format("Invalid weight window ratio '{}' (<= 1.0) "
                               "specified for weight window generation"));
+    if (damping_ <= 0.0 || damping_ > 1.0)
+      fatal_error(fmt::format("Invalid weight window damping '{}' (must be in "
+                              "(0.0, 1.0]) specified for weight window "
+                              "generation",
+        damping_));
   } else {
     fatal_error(fmt::format(
       "Unknown weight window update method '{}' specified", method_));
@@ -853,13 +1013,19 @@ void WeightWindowsGenerator::update() const
 
   Tally* tally = model::tallies[tally_idx_].get();
 
+  // the adjoint flux used by FW-CADIS is only tallied in the adjoint solve
+  if (update_method_ == WeightWindowUpdateMethod::FW_CADIS &&
+      !FlatSourceDomain::adjoint_active_)
+    return;
+
   // if we're beyond the number of max realizations or not at the corrrect
   // update interval, skip the update
   if (max_realizations_ < tally->n_realizations_ ||
       tally->n_realizations_ % update_interval_ != 0)
     return;
 
-  wws->update_magic(tally, tally_value_, threshold_, ratio_);
+  wws->update_weights(
+    tally, update_method_, tally_value_, threshold_, ratio_, damping_);
 
   // if we're not doing on the fly generation, reset the tally results once
   // we're done with the update
@@ -870,6 +1036,109 @@ void WeightWindowsGenerator::update() const
   // complete
 }
 
+//==============================================================================
+// ExponentialTransform implementation
+//==============================================================================
+
+ExponentialTransform::ExponentialTransform(pugi::xml_node node)
+{
+  cell_ids_ = get_node_array<int32_t>(node, "cells");
+  stretching_ = std::stod(get_node_value(node, "stretching"));
+  if (stretching_ <= -1.0 || stretching_ >= 1.0) {
+    fatal_error(fmt::format("Invalid exponential transform stretching "
+                            "parameter '{}' (must be in (-1.0, 1.0))",
+      stretching_));
+  }
+
+  auto u = get_node_array<double>(node, "direction");
+  if (u.size() != 3) {
+    fatal_error("The preferred direction of an exponential transform must "
+                "have three components.");
+  }
+  direction_ = Direction {u[0], u[1], u[2]};
+  if (direction_.norm() == 0.0) {
+    fatal_error("The preferred direction of an exponential transform must "
+                "not be zero.");
+  }
+  direction_ /= direction_.norm();
+}
+
+//==============================================================================
+// WeightWindowsIndex implementation
+//==============================================================================
+
+void WeightWindowsIndex::build()
+{
+  this->clear();
+  const auto& wws = variance_reduction::weight_windows;
+
+  // Find the box around the meshes of all weight windows
+  vector<int> indexed;
+  vector<BoundingBox> boxes(wws.size());
+  lower_left_ = {INFTY, INFTY, INFTY};
+  upper_right_ = {-INFTY, -INFTY, -INFTY};
+  for (int i = 0; i < wws.size(); ++i) {
+    if (!wws[i]->has_mesh())
+      continue;
+    indexed.push_back(i);
+    boxes[i] = wws[i]->mesh()->bounding_box();
+    lower_left_ = {std::min(lower_left_.x, boxes[i].xmin),
+      std::min(lower_left_.y, boxes[i].ymin),
+      std::min(lower_left_.z, boxes[i].zmin)};
+    upper_right_ = {std::max(upper_right_.x, boxes[i].xmax),
+      std::max(upper_right_.y, boxes[i].ymax),
+      std::max(upper_right_.z, boxes[i].zmax)};
+  }
+
+  // Divide the dimensions in which the box is finite into grid cells. A
+  // single weight window does not need a grid.
+  for (int i = 0; i < 3; ++i) {
+    double width = upper_right_[i] - lower_left_[i];
+    if (indexed.size() > 1 && std::isfinite(width) && width > 0.0) {
+      n_[i] = MAX_DIVISIONS;
+      inv_width_[i] = n_[i] / width;
+    }
+  }
+
+  // List the weight windows overlapping each grid cell, by particle type
+  int n_cells = n_[0] * n_[1] * n_[2];
+  candidates_.resize(N_TYPES * n_cells);
+  for (auto i_ww : indexed) {
+    const auto& b = boxes[i_ww];
+    int offset = static_cast<int>(wws[i_ww]->particle_type()) * n_cells;
+    for (int k = grid_index(2, b.zmin); k <= grid_index(2, b.zmax); ++k) {
+      for (int j = grid_index(1, b.ymin); j <= grid_index(1, b.ymax); ++j) {
+        for (int i = grid_index(0, b.xmin); i <= grid_index(0, b.xmax); ++i) {
+          candidates_[offset + (k * n_[1] + j) * n_[0] + i].push_back(i_ww);
+        }
+      }
+    }
+  }
+
+  enabled_ = true;
+}
+
+void WeightWindowsIndex::clear()
+{
+  enabled_ = false;
+  n_ = {1, 1, 1};
+  inv_width_ = {};
+  candidates_.clear();
+}
+
+const vector<int>& WeightWindowsIndex::candidates(
+  ParticleType type, Position r) const
+{
+  if (r.x < lower_left_.x || r.x > upper_right_.x || r.y < lower_left_.y ||
+      r.y > upper_right_.y || r.z < lower_left_.z || r.z > upper_right_.z)
+    return none_;
+
+  int n_cells = n_[0] * n_[1] * n_[2];
+  int cell = (grid_index(2, r.z) * n_[1] + grid_index(1, r.y)) * n_[0] +
+             grid_index(0, r.x);
+  return candidates_[static_cast<int>(type) * n_cells + cell];
+}
+
 //==============================================================================
 // Non-member functions
 //==============================================================================
@@ -879,6 +1148,27 @@ void finalize_variance_reduction()
   for (const auto& wwg : variance_reduction::weight_windows_generators) {
     wwg->create_tally();
   }
+
+  // Map cells to the exponential transforms applied in them
+  const auto& transforms = variance_reduction::exponential_transforms;
+  if (!transforms.empty()) {
+    auto& cell_transform = variance_reduction::cell_exponential_transform;
+    cell_transform.assign(model::cells.size(), C_NONE);
+    for (int i = 0; i < transforms.size(); ++i) {
+      for (auto id : transforms[i].cell_ids_) {
+        auto it = model::cell_map.find(id);
+        if (it == model::cell_map.end()) {
+          fatal_error(fmt::format(
+            "Cell {} of an exponential transform does not exist.", id));
+        }
+        if (cell_transform[it->second] != C_NONE) {
+          fatal_error(fmt::format(
+            "Cell {} has more than one exponential transform.", id));
+        }
+        cell_transform[it->second] = i;
+      }
+    }
+  }
 }
 
 //==============================================================================
@@ -82,27 +82,59 @@ WindowedMultipole::WindowedMultipole(hid_t group)
 std::tuple<double, double, double> WindowedMultipole::evaluate(
   double E, double sqrtkT) const
 {
-  using namespace std::complex_literals;
+  double sig_s, sig_a, sig_f;
+  this->evaluate_batch(1, &E, &sqrtkT, &sig_s, &sig_a, &sig_f);
+  return std::make_tuple(sig_s, sig_a, sig_f);
+}
 
-  // ==========================================================================
-  // Bookkeeping
+void WindowedMultipole::evaluate_batch(int n, const double* E,
+  const double* sqrtkT, double* sig_s, double* sig_a, double* sig_f) const
+{
+  for (int k = 0; k < n;) {
+    // Find the run of lookups with energies in the same window
+    int i_window = this->window_index(E[k]);
+    int k_end = k + 1;
+    while (k_end < n && this->window_index(E[k_end]) == i_window) {
+      ++k_end;
+    }
+
+    for (int m = k; m < k_end; ++m) {
+      this->evaluate_curvefit(
+        i_window, E[m], sqrtkT[m], sig_s[m], sig_a[m], sig_f[m]);
+    }
 
+    // Add the contribution from the poles in this window. Each block of poles
+    // is used for every lookup in the run while it is in cache.
+    const auto& window {window_info_[i_window]};
+    for (int i_start = window.index_start; i_start <= window.index_end;
+         i_start += POLE_BLOCK) {
+      int n_poles = std::min(POLE_BLOCK, window.index_end + 1 - i_start);
+      for (int m = k; m < k_end; ++m) {
+        this->add_poles(i_start, n_poles, E[m], sqrtkT[m], sig_s[m], sig_a[m],
+          sig_f[m]);
+      }
+    }
+    k = k_end;
+  }
+}
+
+int WindowedMultipole::window_index(double E) const
+{
+  return std::min(window_info_.size() - 1,
+    static_cast<size_t>((std::sqrt(E) - std::sqrt(E_min_)) * inv_spacing_));
+}
+
+void WindowedMultipole::evaluate_curvefit(int i_window, double E,
+  double sqrtkT, double& sig_s, double& sig_a, double& sig_f) const
+{
   // Define some frequently used variables.
   double sqrtE = std::sqrt(E);
   double invE = 1.0 / E;
-
-  // Locate window containing energy
-  int i_window = std::min(window_info_.size() - 1,
-    static_cast<size_t>((sqrtE - std::sqrt(E_min_)) * inv_spacing_));
   const auto& window {window_info_[i_window]};
 
-  // Initialize the ouptut cross sections
-  double sig_s = 0.0;
-  double sig_a = 0.0;
-  double sig_f = 0.0;
-
-  // ==========================================================================
-  // Add the contribution from the curvefit polynomial.
+  sig_s = 0.0;
+  sig_a = 0.0;
+  sig_f = 0.0;
 
   if (sqrtkT > 0.0 && window.broaden_poly) {
     // Broaden the curvefit.
@@ -132,14 +164,20 @@ std::tuple<double, double, double> WindowedMultipole::evaluate(
       temp *= sqrtE;
     }
   }
+}
 
-  // ==========================================================================
-  // Add the contribution from the poles in this window.
+void WindowedMultipole::add_poles(int i_start, int n, double E, double sqrtkT,
+  double& sig_s, double& sig_a, double& sig_f) const
+{
+  using namespace std::complex_literals;
+
+  // Define some frequently used variables.
+  double sqrtE = std::sqrt(E);
+  double invE = 1.0 / E;
 
   if (sqrtkT == 0.0) {
     // If at 0K, use asymptotic form.
-    for (int i_pole = window.index_start; i_pole <= window.index_end;
-         ++i_pole) {
+    for (int i_pole = i_start; i_pole < i_start + n; ++i_pole) {
       std::complex<double> psi_chi = -1.0i / (data_(i_pole, MP_EA) - sqrtE);
       std::complex<double> c_temp = psi_chi * invE;
       sig_s += (data_(i_pole, MP_RS) * c_temp).real();
@@ -148,22 +186,57 @@ std::tuple<double, double, double> WindowedMultipole::evaluate(
         sig_f += (data_(i_pole, MP_RF) * c_temp).real();
       }
     }
-  } else {
-    // At temperature, use Faddeeva function-based form.
-    double dopp = sqrt_awr_ / sqrtkT;
-    for (int i_pole = window.index_start; i_pole <= window.index_end;
-         ++i_pole) {
-      std::complex<double> z = (sqrtE - data_(i_pole, MP_EA)) * dopp;
-      std::complex<double> w_val = faddeeva(z) * dopp * invE * SQRT_PI;
-      sig_s += (data_(i_pole, MP_RS) * w_val).real();
-      sig_a += (data_(i_pole, MP_RA) * w_val).real();
-      if (fissionable_) {
-        sig_f += (data_(i_pole, MP_RF) * w_val).real();
+    return;
+  }
+
+  // At temperature, use Faddeeva function-based form. The Faddeeva function
+  // is first evaluated for the whole block with the vectorizable form that
+  // holds far from the origin, and only the poles close to the incident
+  // energy are then evaluated exactly.
+  double dopp = sqrt_awr_ / sqrtkT;
+  const auto* pole = &data_(i_start, 0);
+  const int stride = data_.shape()[1];
+  array<double, POLE_BLOCK> x, y, w_re, w_im;
+
+  int n_near = 0;
+#pragma omp simd reduction(+ : n_near)
+  for (int k = 0; k < n; ++k) {
+    x[k] = (sqrtE - pole[k * stride + MP_EA].real()) * dopp;
+    y[k] = -pole[k * stride + MP_EA].imag() * dopp;
+    faddeeva_far(x[k], y[k], w_re[k], w_im[k]);
+    n_near += (x[k] * x[k] + y[k] * y[k] < FADDEEVA_FAR_MIN_SQ);
+  }
+  if (n_near > 0) {
+    for (int k = 0; k < n; ++k) {
+      if (x[k] * x[k] + y[k] * y[k] < FADDEEVA_FAR_MIN_SQ) {
+        auto w = faddeeva({x[k], y[k]});
+        w_re[k] = w.real();
+        w_im[k] = w.imag();
       }
     }
   }
 
-  return std::make_tuple(sig_s, sig_a, sig_f);
+  double sum_s = 0.0;
+  double sum_a = 0.0;
+  double sum_f = 0.0;
+#pragma omp simd reduction(+ : sum_s, sum_a)
+  for (int k = 0; k < n; ++k) {
+    const auto& r_s = pole[k * stride + MP_RS];
+    const auto& r_a = pole[k * stride + MP_RA];
+    sum_s += r_s.real() * w_re[k] - r_s.imag() * w_im[k];
+    sum_a += r_a.real() * w_re[k] - r_a.imag() * w_im[k];
+  }
+  if (fissionable_) {
+#pragma omp simd reduction(+ : sum_f)
+    for (int k = 0; k < n; ++k) {
+      const auto& r_f = pole[k * stride + MP_RF];
+      sum_f += r_f.real() * w_re[k] - r_f.imag() * w_im[k];
+    }
+  }
+  double factor = dopp * invE * SQRT_PI;
+  sig_s += sum_s * factor;
+  sig_a += sum_a * factor;
+  sig_f += sum_f * factor;
 }
 
 std::tuple<double, double, double> WindowedMultipole::evaluate_deriv(
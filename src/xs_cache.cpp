@@ -0,0 +1,226 @@
+#include "openmc/xs_cache.h"
+
+#include <cmath>   // for round
+#include <cstdint> // for uint64_t
+#include <cstdio>  // for rename
+#include <cstring> // for memcmp, memcpy, memset, strncpy, strnlen
+#include <fstream>
+#include <utility> // for pair
+
+#include <fcntl.h>    // for open
+#include <sys/mman.h> // for mmap, munmap
+#include <sys/stat.h> // for fstat
+#include <unistd.h>   // for close
+
+#include <fmt/core.h>
+
+#include "openmc/constants.h"
+#include "openmc/error.h"
+#include "openmc/nuclide.h"
+#include "openmc/settings.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace data {
+
+CrossSectionCache xs_cache;
+
+} // namespace data
+
+namespace {
+
+constexpr char CACHE_MAGIC[8] {'O', 'P', 'E', 'N', 'M', 'C', 'X', 'S'};
+constexpr uint64_t CACHE_VERSION {1};
+
+//! Alignment of each array in the file in bytes
+constexpr uint64_t CACHE_ALIGNMENT {64};
+
+struct CacheHeader {
+  char magic[8];
+  uint64_t version;
+  uint64_t flags;    //!< Settings the derived cross sections depend on
+  uint64_t n_arrays; //!< Number of entries in the directory
+};
+
+struct CacheEntry {
+  char key[112];
+  uint64_t offset; //!< Offset of the array from the start of the file in bytes
+  uint64_t size;   //!< Number of values in the array
+};
+
+//! Settings used when the derived cross sections in the cache were computed
+uint64_t cache_flags()
+{
+  return settings::delayed_photon_scaling ? 1 : 0;
+}
+
+} // namespace
+
+//==============================================================================
+// CrossSectionCache implementation
+//==============================================================================
+
+bool CrossSectionCache::open(const std::string& path)
+{
+  this->close();
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0 ||
+      static_cast<size_t>(st.st_size) < sizeof(CacheHeader)) {
+    ::close(fd);
+    warning(fmt::format("Ignoring invalid cross section cache {}.", path));
+    return false;
+  }
+  void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    warning(fmt::format("Could not map cross section cache {}.", path));
+    return false;
+  }
+  data_ = data;
+  size_ = st.st_size;
+
+  // Check that the file is a cache written with the same settings
+  const auto* header = static_cast<const CacheHeader*>(data_);
+  if (std::memcmp(header->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+      header->version != CACHE_VERSION ||
+      header->n_arrays > (size_ - sizeof(CacheHeader)) / sizeof(CacheEntry)) {
+    warning(fmt::format("Ignoring invalid cross section cache {}.", path));
+    this->close();
+    return false;
+  }
+  if (header->flags != cache_flags()) {
+    warning(fmt::format("Ignoring cross section cache {} since it was written "
+                        "with different settings.",
+      path));
+    this->close();
+    return false;
+  }
+
+  // Read directory of arrays
+  const auto* entries = reinterpret_cast<const CacheEntry*>(header + 1);
+  const char* start = static_cast<const char*>(data_);
+  for (uint64_t i = 0; i < header->n_arrays; ++i) {
+    const auto& entry = entries[i];
+    if (entry.offset % CACHE_ALIGNMENT != 0 || entry.offset > size_ ||
+        entry.size > (size_ - entry.offset) / sizeof(double)) {
+      warning(fmt::format("Ignoring invalid cross section cache {}.", path));
+      this->close();
+      return false;
+    }
+    std::string key {entry.key, strnlen(entry.key, sizeof(entry.key))};
+    const auto* values = reinterpret_cast<const double*>(start + entry.offset);
+    arrays_.emplace(key, gsl::span<const double> {values, entry.size});
+  }
+  return true;
+}
+
+void CrossSectionCache::close()
+{
+  if (data_)
+    munmap(data_, size_);
+  data_ = nullptr;
+  size_ = 0;
+  arrays_.clear();
+}
+
+bool CrossSectionCache::find(
+  const std::string& key, gsl::span<const double>& values) const
+{
+  auto it = arrays_.find(key);
+  if (it == arrays_.end())
+    return false;
+  values = it->second;
+  return true;
+}
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+std::string xs_cache_key(const std::string& nuclide, int T)
+{
+  return fmt::format("{}/xs/{}K", nuclide, T);
+}
+
+std::string xs_cache_key(const std::string& nuclide, int mt, int T)
+{
+  return fmt::format("{}/{}/{}K", nuclide, mt, T);
+}
+
+void write_xs_cache(const std::string& path)
+{
+  // Gather the tabulated cross sections of all nuclides
+  vector<std::pair<std::string, gsl::span<const double>>> arrays;
+  for (const auto& nuc : data::nuclides) {
+    for (int t = 0; t < nuc->xs_.size(); ++t) {
+      int T = std::round(nuc->kTs_[t] / K_BOLTZMANN);
+      const auto& xs = nuc->xs_[t];
+      arrays.emplace_back(xs_cache_key(nuc->name_, T),
+        gsl::span<const double> {xs.data(), xs.size()});
+#ifndef OPENMC_SINGLE_PRECISION_XS
+      for (const auto& rx : nuc->reactions_) {
+        arrays.emplace_back(
+          xs_cache_key(nuc->name_, rx->mt_, T), rx->xs_[t].value);
+      }
+#endif
+    }
+  }
+
+  // Determine where each array is located in the file
+  CacheHeader header;
+  std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  header.version = CACHE_VERSION;
+  header.flags = cache_flags();
+  header.n_arrays = arrays.size();
+  vector<CacheEntry> entries(arrays.size());
+  uint64_t offset = sizeof(CacheHeader) + arrays.size() * sizeof(CacheEntry);
+  for (int i = 0; i < arrays.size(); ++i) {
+    const auto& key = arrays[i].first;
+    if (key.size() >= sizeof(entries[i].key)) {
+      warning(fmt::format("Cannot write cross section cache {} since the name "
+                          "{} is too long.",
+        path, key));
+      return;
+    }
+    std::memset(entries[i].key, 0, sizeof(entries[i].key));
+    std::strncpy(entries[i].key, key.c_str(), sizeof(entries[i].key) - 1);
+    offset = (offset + CACHE_ALIGNMENT - 1) / CACHE_ALIGNMENT * CACHE_ALIGNMENT;
+    entries[i].offset = offset;
+    entries[i].size = arrays[i].second.size();
+    offset += entries[i].size * sizeof(double);
+  }
+
+  // Write to a temporary file first so that other processes never map a
+  // partially written cache
+  write_message(5, "Writing cross section cache {}...", path);
+  std::string tmp_path = path + ".tmp";
+  std::ofstream file {tmp_path, std::ios::binary};
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(entries.data()),
+    entries.size() * sizeof(CacheEntry));
+  uint64_t position = sizeof(CacheHeader) + entries.size() * sizeof(CacheEntry);
+  const char padding[CACHE_ALIGNMENT] {};
+  for (int i = 0; i < arrays.size(); ++i) {
+    file.write(padding, entries[i].offset - position);
+    const auto& values = arrays[i].second;
+    file.write(reinterpret_cast<const char*>(values.data()),
+      values.size() * sizeof(double));
+    position = entries[i].offset + values.size() * sizeof(double);
+  }
+  file.close();
+  if (!file || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    warning(fmt::format("Could not write cross section cache {}.", path));
+  }
+}
+
+} // namespace openmc
@@ -0,0 +1,140 @@
+#include <cmath>
+#include <string>
+#include <tuple>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <pugixml.hpp>
+
+#include "openmc/cell.h"
+#include "openmc/memory.h"
+#include "openmc/surface.h"
+
+using namespace openmc;
+
+namespace {
+
+// Add a surface with the given ID and coefficients to the model
+template<typename T>
+void add_surface(int id, const std::string& coeffs)
+{
+  pugi::xml_document doc;
+  auto node = doc.append_child("surface");
+  node.append_child("id").text() = std::to_string(id).c_str();
+  node.append_child("coeffs").text() = coeffs.c_str();
+  model::surface_map[id] = model::surfaces.size();
+  model::surfaces.push_back(make_unique<T>(node));
+}
+
+// Surfaces of a pin cell: a fuel cylinder between two axial planes, the four
+// sides of the cell and a sphere around it
+void make_pin_surfaces()
+{
+  free_memory_surfaces();
+  add_surface<SurfaceZCylinder>(1, "0 0 0.4");
+  add_surface<SurfaceZPlane>(2, "-10");
+  add_surface<SurfaceZPlane>(3, "10");
+  add_surface<SurfaceSphere>(4, "0 0 0 5");
+  add_surface<SurfaceXPlane>(5, "-0.63");
+  add_surface<SurfaceXPlane>(6, "0.63");
+  add_surface<SurfaceYPlane>(7, "-0.63");
+  add_surface<SurfaceYPlane>(8, "0.63");
+  pack_surfaces();
+}
+
+} // namespace
+
+TEST_CASE("Test region containment and distance")
+{
+  make_pin_surfaces();
+  Region fuel {"-1 2 -3", 1};
+  Region moderator {"5 -6 7 -8 2 -3 1", 2};
+  Region outside {"~(5 -6 7 -8) -4 | 1 -2", 3};
+  Direction u {1.0, 0.0, 0.0};
+
+  REQUIRE(fuel.contains({0.1, 0.1, 0.0}, u, 0));
+  REQUIRE(!fuel.contains({0.5, 0.0, 0.0}, u, 0));
+  REQUIRE(moderator.contains({0.5, 0.0, 0.0}, u, 0));
+  REQUIRE(!moderator.contains({0.5, 0.0, 11.0}, u, 0));
+  REQUIRE(outside.contains({2.0, 0.0, 0.0}, u, 0));
+  REQUIRE(outside.contains({0.5, 0.0, -12.0}, u, 0));
+  REQUIRE(!outside.contains({0.5, 0.0, 0.0}, u, 0));
+
+  // Distance to the nearest surface, which is returned with the sign of the
+  // half-space on its other side
+  auto [d, i_surf] = fuel.distance({0.0, 0.0, 0.0}, u, 0);
+  REQUIRE_THAT(d, Catch::Matchers::WithinAbs(0.4, 1e-12));
+  REQUIRE(i_surf == 1);
+  std::tie(d, i_surf) = moderator.distance({0.4, 0.0, 0.0}, u, -1);
+  REQUIRE_THAT(d, Catch::Matchers::WithinAbs(0.23, 1e-12));
+  REQUIRE(i_surf == 6);
+  std::tie(d, i_surf) = outside.distance({2.0, 0.0, 0.0}, u, 0);
+  REQUIRE_THAT(d, Catch::Matchers::WithinAbs(3.0, 1e-12));
+  REQUIRE(i_surf == 4);
+
+  free_memory_surfaces();
+}
+
+TEST_CASE("Benchmark region containment and distance", "[.][benchmark]")
+{
+  make_pin_surfaces();
+  Region fuel {"-1 2 -3", 1};
+  Region moderator {"5 -6 7 -8 2 -3 1", 2};
+  Region outside {"~(5 -6 7 -8) -4 | 1 -2", 3};
+
+  // Points spread over the sphere in varied directions
+  int n = 1000;
+  vector<Position> points;
+  vector<Direction> directions;
+  for (int k = 0; k < n; ++k) {
+    double mu = -0.9 + 1.8 * k / (n - 1);
+    double phi = 0.37 * k;
+    double s = std::sqrt(1.0 - mu * mu);
+    directions.push_back({s * std::cos(phi), s * std::sin(phi), mu});
+    points.push_back({2.0 * std::sin(0.7 * k), 2.0 * std::cos(1.3 * k),
+      4.0 * std::sin(2.9 * k)});
+  }
+
+  auto contains = [&](const Region& region) {
+    int count = 0;
+    for (int k = 0; k < n; ++k) {
+      count += region.contains(points[k], directions[k], 0);
+    }
+    return count;
+  };
+  auto distance = [&](const Region& region) {
+    double total = 0.0;
+    for (int k = 0; k < n; ++k) {
+      total += region.distance(points[k], directions[k], 0).first;
+    }
+    return total;
+  };
+
+  BENCHMARK("contains simple")
+  {
+    return contains(fuel);
+  };
+  BENCHMARK("contains batched")
+  {
+    return contains(moderator);
+  };
+  BENCHMARK("contains complex")
+  {
+    return contains(outside);
+  };
+  BENCHMARK("distance simple")
+  {
+    return distance(fuel);
+  };
+  BENCHMARK("distance batched")
+  {
+    return distance(moderator);
+  };
+  BENCHMARK("distance complex")
+  {
+    return distance(outside);
+  };
+
+  free_memory_surfaces();
+}
@@ -79,3 +79,26 @@ TEST_CASE("Test alias sampling method for pugixml constructor")
     REQUIRE(dist.alias()[i] == correct_alias[i]);
   }
 }
+
+TEST_CASE("Test guide table sampling of a long tabular distribution")
+{
+  // Uniform density on [0, 1] tabulated at many points, for which sampling
+  // returns the random number
+  constexpr int n = 1001;
+  openmc::vector<double> x(n);
+  openmc::vector<double> p(n, 1.0);
+  for (int i = 0; i < n; ++i) {
+    x[i] = static_cast<double>(i) / (n - 1);
+  }
+
+  for (auto interp :
+    {openmc::Interpolation::histogram, openmc::Interpolation::lin_lin}) {
+    openmc::Tabular dist(x.data(), p.data(), n, interp);
+    uint64_t seed = openmc::init_seed(0, 0);
+    for (int i = 0; i < 10000; ++i) {
+      uint64_t copy = seed;
+      double r = openmc::prn(&copy);
+      REQUIRE_THAT(dist.sample(&seed), Catch::Matchers::WithinAbs(r, 1e-12));
+    }
+  }
+}
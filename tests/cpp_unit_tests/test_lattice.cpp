@@ -0,0 +1,201 @@
+#include <cmath>
+#include <string>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <pugixml.hpp>
+
+#include "openmc/lattice.h"
+
+using namespace openmc;
+
+namespace {
+
+// Build a hexagonal lattice with the given orientation and number of rings
+HexLattice make_hex_lattice(const std::string& orientation, int n_rings)
+{
+  std::string universes;
+  for (int i = 0; i < 3 * n_rings * n_rings - 3 * n_rings + 1; ++i) {
+    universes += " 1";
+  }
+  pugi::xml_document doc;
+  auto node = doc.append_child("hex_lattice");
+  node.append_child("id").text() = "1";
+  node.append_child("n_rings").text() = std::to_string(n_rings).c_str();
+  node.append_child("orientation").text() = orientation.c_str();
+  node.append_child("center").text() = "0.5 -0.25";
+  node.append_child("pitch").text() = "1.26";
+  node.append_child("universes").text() = universes.c_str();
+  return HexLattice {node};
+}
+
+// Build a square two-dimensional lattice with n by n tiles of pitch 1.26
+RectLattice make_rect_lattice(int n)
+{
+  std::string universes;
+  for (int i = 0; i < n * n; ++i) {
+    universes += " 1";
+  }
+  auto dimension = std::to_string(n) + " " + std::to_string(n);
+  auto lower_left = std::to_string(-0.63 * n) + " " + std::to_string(-0.63 * n);
+  pugi::xml_document doc;
+  auto node = doc.append_child("lattice");
+  node.append_child("id").text() = "2";
+  node.append_child("dimension").text() = dimension.c_str();
+  node.append_child("lower_left").text() = lower_left.c_str();
+  node.append_child("pitch").text() = "1.26 1.26";
+  node.append_child("universes").text() = universes.c_str();
+  return RectLattice {node};
+}
+
+// Squared distance in the xy-plane from a point to the center of a tile
+double distance_to_center(
+  const HexLattice& lat, Position r, const array<int, 3>& i_xyz)
+{
+  Position r_t = lat.get_local_position(r, i_xyz);
+  return r_t.x * r_t.x + r_t.y * r_t.y;
+}
+
+} // namespace
+
+TEST_CASE("Test hexagonal lattice indices")
+{
+  auto orientation = GENERATE(std::string("x"), std::string("y"));
+  int n_rings = 5;
+  auto lat = make_hex_lattice(orientation, n_rings);
+  Direction u {1.0, 0.0, 0.0};
+
+  // Points are located in the tile whose center is closest to them
+  for (int i = 0; i < 40; ++i) {
+    for (int j = 0; j < 40; ++j) {
+      Position r {0.5 + 0.2137 * (i - 20), -0.25 + 0.1913 * (j - 20), 0.0};
+
+      array<int, 3> closest {0, 0, 0};
+      double d_min = INFTY;
+      double d_next = INFTY;
+      for (int i0 = 0; i0 < 2 * n_rings - 1; ++i0) {
+        for (int i1 = 0; i1 < 2 * n_rings - 1; ++i1) {
+          double d = distance_to_center(lat, r, {i0, i1, 0});
+          if (d < d_min) {
+            d_next = d_min;
+            d_min = d;
+            closest = {i0, i1, 0};
+          } else if (d < d_next) {
+            d_next = d;
+          }
+        }
+      }
+      // Skip points on the side of a tile
+      if (d_next - d_min < 1e-6)
+        continue;
+
+      array<int, 3> result;
+      lat.get_indices(r, u, result);
+      REQUIRE(result == closest);
+    }
+  }
+}
+
+TEST_CASE("Test hexagonal lattice distance")
+{
+  auto orientation = GENERATE(std::string("x"), std::string("y"));
+  auto lat = make_hex_lattice(orientation, 5);
+
+  // Moving by the distance to the lattice boundary reaches the neighbor given
+  // by the lattice translation
+  Position r {0.61, -0.17, 0.0};
+  for (int k = 0; k < 36; ++k) {
+    double angle = 0.1 + k * 2.0 * PI / 36;
+    Direction u {std::cos(angle), std::sin(angle), 0.0};
+
+    array<int, 3> i_xyz;
+    lat.get_indices(r, u, i_xyz);
+    auto [d, trans] = lat.distance(r, u, i_xyz);
+    REQUIRE(d > 0.0);
+    REQUIRE(d < 1.26);
+
+    array<int, 3> before;
+    lat.get_indices(r + (d - 1e-6) * u, u, before);
+    REQUIRE(before == i_xyz);
+
+    array<int, 3> after;
+    lat.get_indices(r + (d + 1e-6) * u, u, after);
+    array<int, 3> expected {
+      i_xyz[0] + trans[0], i_xyz[1] + trans[1], i_xyz[2] + trans[2]};
+    REQUIRE(after == expected);
+  }
+}
+
+TEST_CASE("Benchmark hexagonal lattice traversal", "[.][benchmark]")
+{
+  auto orientation = GENERATE(std::string("x"), std::string("y"));
+  auto lat = make_hex_lattice(orientation, 10);
+  Direction u {std::cos(0.3), std::sin(0.3), 0.0};
+  Position start {-8.0, -3.0, 0.0};
+
+  BENCHMARK("get_indices " + orientation)
+  {
+    array<int, 3> i_xyz;
+    int sum = 0;
+    for (int k = 0; k < 100; ++k) {
+      lat.get_indices(start + 0.16 * k * u, u, i_xyz);
+      sum += i_xyz[0] + i_xyz[1];
+    }
+    return sum;
+  };
+
+  BENCHMARK("distance " + orientation)
+  {
+    // Cross the lattice tile by tile
+    Position r = start;
+    array<int, 3> i_xyz;
+    lat.get_indices(r, u, i_xyz);
+    double total = 0.0;
+    for (int k = 0; k < 12 && lat.are_valid_indices(i_xyz); ++k) {
+      auto [d, trans] = lat.distance(r, u, i_xyz);
+      r += d * u;
+      total += d;
+      for (int i = 0; i < 3; ++i) {
+        i_xyz[i] += trans[i];
+      }
+    }
+    return total;
+  };
+}
+
+TEST_CASE("Benchmark rectangular lattice traversal", "[.][benchmark]")
+{
+  auto lat = make_rect_lattice(17);
+  Direction u {std::cos(0.3), std::sin(0.3), 0.0};
+  Position start {-10.5, -3.0, 0.0};
+
+  BENCHMARK("get_indices")
+  {
+    array<int, 3> i_xyz;
+    int sum = 0;
+    for (int k = 0; k < 100; ++k) {
+      lat.get_indices(start + 0.2 * k * u, u, i_xyz);
+      sum += i_xyz[0] + i_xyz[1];
+    }
+    return sum;
+  };
+
+  BENCHMARK("distance")
+  {
+    // Cross the lattice tile by tile
+    Position r = start;
+    array<int, 3> i_xyz;
+    lat.get_indices(r, u, i_xyz);
+    double total = 0.0;
+    for (int k = 0; k < 30 && lat.are_valid_indices(i_xyz); ++k) {
+      auto [d, trans] = lat.distance(r, u, i_xyz);
+      r += d * u;
+      total += d;
+      for (int i = 0; i < 3; ++i) {
+        i_xyz[i] += trans[i];
+      }
+    }
+    return total;
+  };
+}
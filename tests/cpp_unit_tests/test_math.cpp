@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <cmath>
 #include <random>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
@@ -8,6 +10,7 @@
 #include "openmc/math_functions.h"
 #include "openmc/random_dist.h"
 #include "openmc/random_lcg.h"
+#include "openmc/search.h"
 #include "openmc/wmp.h"
 
 TEST_CASE("Test t_percentile")
@@ -355,3 +358,169 @@ TEST_CASE("Test broaden_wmp_polynomials")
     REQUIRE_THAT(ref_val, Catch::Matchers::Approx(test_val));
   }
 }
+
+TEST_CASE("Test faddeeva_far")
+{
+  // Compare to the exact evaluation on circles around the origin, including
+  // points close to the real axis and in the lower half plane
+  for (double r : {6.0, 8.5, 40.0, 1.0e4}) {
+    for (int i = 0; i < 360; ++i) {
+      std::complex<double> z = std::polar(r, (i + 0.5) * openmc::PI / 180.0);
+      double w_re, w_im;
+      openmc::faddeeva_far(z.real(), z.imag(), w_re, w_im);
+      auto ref = openmc::faddeeva(z);
+      REQUIRE(std::abs(std::complex<double>(w_re, w_im) - ref) <=
+              1e-10 * std::abs(ref));
+    }
+  }
+}
+
+TEST_CASE("Benchmark faddeeva_far", "[.][benchmark]")
+{
+  // Arguments spread like those of poles far from the incident energy
+  std::vector<double> x(1000), y(1000);
+  for (int i = 0; i < 1000; ++i) {
+    x[i] = 6.0 + 0.37 * i;
+    y[i] = (i % 2 == 0 ? 1.0 : -1.0) * 0.01 * (i % 17);
+  }
+
+  BENCHMARK("faddeeva")
+  {
+    double sum = 0.0;
+    for (int i = 0; i < 1000; ++i) {
+      sum += openmc::faddeeva({x[i], y[i]}).real();
+    }
+    return sum;
+  };
+
+  BENCHMARK("faddeeva_far")
+  {
+    double sum = 0.0;
+#pragma omp simd reduction(+ : sum)
+    for (int i = 0; i < 1000; ++i) {
+      double w_re, w_im;
+      openmc::faddeeva_far(x[i], y[i], w_re, w_im);
+      sum += w_re;
+    }
+    return sum;
+  };
+}
+
+TEST_CASE("Test GuideTable")
+{
+  // CDF with bins of very different widths, including empty bins
+  std::vector<double> cdf {0.0, 0.001, 0.001, 0.2, 0.21, 0.5, 0.5, 0.9, 1.0};
+  int n_bins = cdf.size() - 1;
+
+  for (int n_cells : {1, 3, 8, 100}) {
+    openmc::GuideTable guide(cdf, n_cells);
+    REQUIRE(!guide.empty());
+    for (int i = 0; i < 1000; ++i) {
+      double r = (i + 0.5) / 1000;
+
+      // Bin found by a linear search from the first bin
+      int j = 0;
+      while (j < n_bins - 1 && cdf[j + 1] <= r) {
+        ++j;
+      }
+
+      int start = guide.start(r);
+      REQUIRE(start <= j);
+      REQUIRE(cdf[start] <= r);
+    }
+  }
+}
+
+TEST_CASE("Test GuideTable find")
+{
+  // Unnormalized values with repeated entries, searched through a table
+  // built for them after normalization
+  std::vector<double> x {2.0, 2.5, 2.5, 4.0, 7.0, 7.0, 7.5, 10.0};
+  int n = x.size();
+  std::vector<double> xn(n);
+  for (int i = 0; i < n; ++i) {
+    xn[i] = (x[i] - x[0]) / (x[n - 1] - x[0]);
+  }
+
+  for (int n_cells : {1, 4, 50}) {
+    openmc::GuideTable guide(xn, n_cells);
+    for (int i = 0; i <= 800; ++i) {
+      double value = 2.0 + i * 0.01;
+      double r = (value - x[0]) / (x[n - 1] - x[0]);
+      int expected = openmc::lower_bound_index(x.begin(), x.end(), value);
+      expected = std::min(expected, n - 2);
+      REQUIRE(guide.find(x, n, value, r) == expected);
+    }
+  }
+}
+
+TEST_CASE("Test RangeMaximum")
+{
+  std::vector<double> x(50);
+  for (int i = 0; i < x.size(); ++i) {
+    x[i] = std::sin(0.7 * i) + 0.01 * i;
+  }
+
+  for (int block_size : {1, 4, 7, 64}) {
+    openmc::RangeMaximum range_max(x, block_size);
+    REQUIRE(!range_max.empty());
+    for (int first = 0; first < x.size(); ++first) {
+      for (int last = first + 1; last <= x.size(); ++last) {
+        double expected =
+          *std::max_element(x.begin() + first, x.begin() + last);
+        REQUIRE(range_max(x, first, last) == expected);
+      }
+    }
+  }
+}
+
+TEST_CASE("Test batched prn")
+{
+  std::vector<uint64_t> seeds;
+  for (int i = 0; i < 37; ++i) {
+    seeds.push_back(openmc::init_seed(i, openmc::STREAM_TRACKING));
+  }
+  auto expected_seeds = seeds;
+
+  std::vector<double> values(seeds.size());
+  for (int k = 0; k < 3; ++k) {
+    openmc::prn(seeds.size(), seeds.data(), values.data());
+    for (int i = 0; i < seeds.size(); ++i) {
+      REQUIRE(values[i] == openmc::prn(&expected_seeds[i]));
+      REQUIRE(seeds[i] == expected_seeds[i]);
+    }
+  }
+}
+
+TEST_CASE("Test counter_prn")
+{
+  // Known answer of Threefry-2x64 with 20 rounds for a zero key and counter
+  openmc::openmc_set_seed(0);
+  REQUIRE(openmc::counter_prn(0, 0) ==
+          std::ldexp(0xc2b6e3a8c2c69865ULL >> 11, -53));
+  openmc::openmc_set_seed(openmc::DEFAULT_SEED);
+
+  // The batched version agrees with the scalar one, and the numbers depend on
+  // both the key and the counter
+  std::vector<uint64_t> keys {1, 2, 3, 1000000, 1000001};
+  std::vector<double> values(keys.size());
+  for (uint64_t counter : {0, 1, 2, 100}) {
+    openmc::counter_prn(keys.size(), keys.data(), counter, values.data());
+    for (int i = 0; i < keys.size(); ++i) {
+      REQUIRE(values[i] == openmc::counter_prn(keys[i], counter));
+      REQUIRE(values[i] >= 0.0);
+      REQUIRE(values[i] < 1.0);
+      REQUIRE(values[i] != openmc::counter_prn(keys[i], counter + 1));
+      if (i > 0)
+        REQUIRE(values[i] != values[i - 1]);
+    }
+  }
+
+  // The mean of many numbers is close to one half
+  double sum = 0.0;
+  int n = 100000;
+  for (int i = 0; i < n; ++i) {
+    sum += openmc::counter_prn(i % 100, i / 100);
+  }
+  REQUIRE_THAT(sum / n, Catch::Matchers::WithinAbs(0.5, 0.01));
+}
@@ -0,0 +1,258 @@
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <pugixml.hpp>
+
+#include "openmc/constants.h"
+#include "openmc/mesh.h"
+
+using namespace openmc;
+
+namespace {
+
+// Grid of n + 1 equally spaced values between a and b
+std::string grid(double a, double b, int n)
+{
+  std::ostringstream s;
+  s.precision(17);
+  for (int i = 0; i <= n; ++i) {
+    s << (i == n ? b : a + (b - a) * i / n) << " ";
+  }
+  return s.str();
+}
+
+CylindricalMesh make_cylindrical_mesh()
+{
+  pugi::xml_document doc;
+  auto node = doc.append_child("mesh");
+  node.append_child("id").text() = "1";
+  node.append_child("r_grid").text() = grid(0.0, 10.0, 10).c_str();
+  node.append_child("phi_grid").text() = grid(0.0, 2.0 * PI, 8).c_str();
+  node.append_child("z_grid").text() = grid(-10.0, 10.0, 10).c_str();
+  return CylindricalMesh {node};
+}
+
+SphericalMesh make_spherical_mesh()
+{
+  pugi::xml_document doc;
+  auto node = doc.append_child("mesh");
+  node.append_child("id").text() = "2";
+  node.append_child("r_grid").text() = grid(0.0, 10.0, 10).c_str();
+  node.append_child("theta_grid").text() = grid(0.0, PI, 6).c_str();
+  node.append_child("phi_grid").text() = grid(0.0, 2.0 * PI, 8).c_str();
+  return SphericalMesh {node};
+}
+
+RegularMesh make_regular_mesh()
+{
+  pugi::xml_document doc;
+  auto node = doc.append_child("mesh");
+  node.append_child("id").text() = "3";
+  node.append_child("dimension").text() = "10 10 10";
+  node.append_child("lower_left").text() = "-10 -10 -10";
+  node.append_child("upper_right").text() = "10 10 10";
+  return RegularMesh {node};
+}
+
+// Octree mesh over two root cells whose second cell is split twice
+OctreeMesh make_octree_mesh()
+{
+  pugi::xml_document doc;
+  auto node = doc.append_child("mesh");
+  node.append_child("id").text() = "4";
+  node.append_child("dimension").text() = "2 1 1";
+  node.append_child("lower_left").text() = "0 0 0";
+  node.append_child("upper_right").text() = "2 1 1";
+  node.append_child("refinement").text() =
+    "0 1 1 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0";
+  return OctreeMesh {node};
+}
+
+// Length of a track in each radial shell of a mesh
+vector<double> shell_lengths(const StructuredMesh& mesh, Position r0,
+  Position r1, int n_shells)
+{
+  Direction u = (r1 - r0) / (r1 - r0).norm();
+  vector<int> bins;
+  vector<double> lengths;
+  mesh.bins_crossed(r0, r1, u, bins, lengths);
+
+  vector<double> result(n_shells, 0.0);
+  for (int i = 0; i < bins.size(); ++i) {
+    auto ijk = mesh.get_indices_from_bin(bins[i]);
+    result[ijk[0] - 1] += lengths[i] * (r1 - r0).norm();
+  }
+  return result;
+}
+
+// Length of a straight line at distance b from the center within each shell
+// of radii 1, 2, ..., n
+vector<double> chord_lengths(double b, int n_shells)
+{
+  vector<double> result(n_shells, 0.0);
+  double inner = 0.0;
+  for (int i = 0; i < n_shells; ++i) {
+    double R = i + 1.0;
+    double outer = R > b ? 2.0 * std::sqrt(R * R - b * b) : 0.0;
+    result[i] = outer - inner;
+    inner = outer;
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("Test cylindrical mesh track lengths")
+{
+  auto mesh = make_cylindrical_mesh();
+
+  // A track perpendicular to the axis crosses every shell twice
+  double b = 0.5;
+  auto lengths =
+    shell_lengths(mesh, {-12.0, b, 0.3}, {12.0, b, 0.3}, mesh.shape_[0]);
+  auto expected = chord_lengths(b, mesh.shape_[0]);
+  for (int i = 0; i < lengths.size(); ++i) {
+    REQUIRE_THAT(lengths[i], Catch::Matchers::WithinAbs(expected[i], 1e-8));
+  }
+}
+
+TEST_CASE("Test spherical mesh track lengths")
+{
+  auto mesh = make_spherical_mesh();
+
+  double b = std::hypot(0.5, 0.3);
+  auto lengths =
+    shell_lengths(mesh, {-12.0, 0.5, 0.3}, {12.0, 0.5, 0.3}, mesh.shape_[0]);
+  auto expected = chord_lengths(b, mesh.shape_[0]);
+  for (int i = 0; i < lengths.size(); ++i) {
+    REQUIRE_THAT(lengths[i], Catch::Matchers::WithinAbs(expected[i], 1e-8));
+  }
+}
+
+TEST_CASE("Test regular mesh point location")
+{
+  auto mesh = make_regular_mesh();
+
+  // Points on and between mesh lines, inside and outside of the mesh
+  vector<Position> points;
+  for (int i = -12; i <= 12; ++i) {
+    for (int j = -12; j <= 12; j += 3) {
+      points.push_back({i * 1.0, j * 0.9, 0.5 * i - 0.25 * j});
+    }
+  }
+  vector<int> bins(points.size());
+  mesh.get_bins(points, bins);
+
+  // The fast path agrees with locating the index along each direction
+  for (int i = 0; i < points.size(); ++i) {
+    REQUIRE(bins[i] == mesh.StructuredMesh::get_bin(points[i]));
+  }
+  REQUIRE(mesh.get_bin({-10.0, 0.0, 0.0}) == -1);
+  REQUIRE(mesh.get_bin({10.0, 10.0, 10.0}) == mesh.n_bins() - 1);
+}
+
+TEST_CASE("Test octree mesh")
+{
+  auto mesh = make_octree_mesh();
+  REQUIRE(mesh.n_bins() == 16);
+
+  // Point location descends to the smallest element containing the point
+  REQUIRE(mesh.get_bin({0.5, 0.5, 0.5}) == 0);
+  REQUIRE(mesh.get_bin({1.1, 0.1, 0.1}) == 1);
+  REQUIRE(mesh.get_bin({1.3, 0.1, 0.1}) == 2);
+  REQUIRE(mesh.get_bin({1.75, 0.25, 0.25}) == 9);
+  REQUIRE(mesh.get_bin({1.75, 0.75, 0.75}) == 15);
+  REQUIRE(mesh.get_bin({2.5, 0.5, 0.5}) == -1);
+  REQUIRE(mesh.level(1) == 2);
+  REQUIRE_THAT(mesh.volume(1), Catch::Matchers::WithinAbs(1.0 / 64, 1e-12));
+
+  // A track along x crosses the unsplit root cell, two elements at the
+  // second level, and one at the first
+  Position r0 {-1.0, 0.1, 0.1};
+  Position r1 {3.0, 0.1, 0.1};
+  vector<int> bins;
+  vector<double> lengths;
+  mesh.bins_crossed(r0, r1, {1.0, 0.0, 0.0}, bins, lengths);
+  vector<int> expected_bins {0, 1, 2, 9};
+  vector<double> expected_lengths {1.0, 0.25, 0.25, 0.5};
+  REQUIRE(bins == expected_bins);
+  for (int i = 0; i < bins.size(); ++i) {
+    REQUIRE_THAT(lengths[i] * 4.0,
+      Catch::Matchers::WithinAbs(expected_lengths[i], 1e-8));
+  }
+}
+
+TEST_CASE("Benchmark structured mesh traversal", "[.][benchmark]")
+{
+  auto regular = make_regular_mesh();
+  auto cylindrical = make_cylindrical_mesh();
+  auto spherical = make_spherical_mesh();
+
+  // Tracks through the center region of the meshes in varied directions
+  vector<Position> starts;
+  vector<Position> ends;
+  for (int k = 0; k < 100; ++k) {
+    double mu = -0.9 + 1.8 * k / 99;
+    double phi = 0.37 * k;
+    double s = std::sqrt(1.0 - mu * mu);
+    Direction u {s * std::cos(phi), s * std::sin(phi), mu};
+    Position center {0.1 * std::sin(k), 0.1 * std::cos(k), 0.05 * k - 2.5};
+    starts.push_back(center - 9.0 * u);
+    ends.push_back(center + 9.0 * u);
+  }
+
+  auto traverse = [&](const Mesh& mesh) {
+    vector<int> bins;
+    vector<double> lengths;
+    int n = 0;
+    for (int k = 0; k < starts.size(); ++k) {
+      Direction u = (ends[k] - starts[k]) / (ends[k] - starts[k]).norm();
+      bins.clear();
+      lengths.clear();
+      mesh.bins_crossed(starts[k], ends[k], u, bins, lengths);
+      n += bins.size();
+    }
+    return n;
+  };
+
+  BENCHMARK("regular")
+  {
+    return traverse(regular);
+  };
+  BENCHMARK("cylindrical")
+  {
+    return traverse(cylindrical);
+  };
+  BENCHMARK("spherical")
+  {
+    return traverse(spherical);
+  };
+}
+
+TEST_CASE("Benchmark regular mesh point location", "[.][benchmark]")
+{
+  auto mesh = make_regular_mesh();
+  vector<Position> points;
+  for (int k = 0; k < 10000; ++k) {
+    points.push_back({11.0 * std::sin(0.7 * k), 11.0 * std::cos(1.3 * k),
+      11.0 * std::sin(2.9 * k)});
+  }
+  vector<int> bins(points.size());
+
+  BENCHMARK("get_bin per axis")
+  {
+    for (int k = 0; k < points.size(); ++k) {
+      bins[k] = mesh.StructuredMesh::get_bin(points[k]);
+    }
+    return bins.back();
+  };
+  BENCHMARK("get_bins")
+  {
+    mesh.get_bins(points, bins);
+    return bins.back();
+  };
+}
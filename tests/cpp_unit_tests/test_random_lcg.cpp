@@ -0,0 +1,88 @@
+#include <cstdint>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "openmc/random_lcg.h"
+
+using namespace openmc;
+
+TEST_CASE("Test random number streams")
+{
+  // Skipping ahead gives the same number as drawing every number before it
+  uint64_t seed = init_seed(17, STREAM_TRACKING);
+  uint64_t start = seed;
+  double xi = 0.0;
+  for (int i = 0; i < 1000; ++i) {
+    xi = prn(&seed);
+    REQUIRE(xi >= 0.0);
+    REQUIRE(xi < 1.0);
+  }
+  REQUIRE(future_prn(999, start) == xi);
+
+  uint64_t advanced = start;
+  advance_prn_seed(1000, &advanced);
+  REQUIRE(advanced == seed);
+
+  // Drawing from several seeds at once gives the same numbers as drawing from
+  // each in turn
+  int n = 37;
+  std::vector<uint64_t> seeds(n);
+  std::vector<uint64_t> reference(n);
+  for (int i = 0; i < n; ++i) {
+    seeds[i] = init_seed(i, STREAM_TRACKING);
+    reference[i] = seeds[i];
+  }
+  std::vector<double> values(n);
+  prn(n, seeds.data(), values.data());
+  for (int i = 0; i < n; ++i) {
+    REQUIRE(values[i] == prn(&reference[i]));
+    REQUIRE(seeds[i] == reference[i]);
+  }
+
+  // Counter-based numbers only depend on the key and counter
+  REQUIRE(counter_prn(3, 5) == counter_prn(3, 5));
+  REQUIRE(counter_prn(3, 5) != counter_prn(3, 6));
+  REQUIRE(counter_prn(3, 5) != counter_prn(4, 5));
+}
+
+TEST_CASE("Benchmark random number generation", "[.][benchmark]")
+{
+  int n = 1000;
+  std::vector<uint64_t> seeds(n);
+  for (int i = 0; i < n; ++i) {
+    seeds[i] = init_seed(i, STREAM_TRACKING);
+  }
+  std::vector<double> values(n);
+
+  BENCHMARK("prn")
+  {
+    uint64_t seed = seeds[0];
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+      sum += prn(&seed);
+    }
+    return sum;
+  };
+
+  BENCHMARK("prn batch")
+  {
+    prn(n, seeds.data(), values.data());
+    return values[n - 1];
+  };
+
+  BENCHMARK("counter_prn")
+  {
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+      sum += counter_prn(7, i);
+    }
+    return sum;
+  };
+
+  BENCHMARK("future_prn")
+  {
+    return future_prn(1000000, seeds[0]);
+  };
+}
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "openmc/random_ray/exponentials.h"
+
+using namespace openmc;
+
+TEST_CASE("Test random ray exponentials")
+{
+  for (int i = 0; i <= 60; ++i) {
+    double tau = 1.0e-3 * std::pow(10.0, 0.1 * i);
+    double ref = -std::expm1(-tau);
+    REQUIRE_THAT(cjosey_exponential(tau),
+      Catch::Matchers::WithinRel(ref, 1.0e-4) ||
+        Catch::Matchers::WithinAbs(ref, 1.0e-6));
+
+    double ref_g = 1.0 / tau - ref / (tau * tau);
+    REQUIRE_THAT(exponentialG(tau), Catch::Matchers::WithinAbs(ref_g, 1.0e-5));
+  }
+}
+
+TEST_CASE("Test flat source attenuation")
+{
+  int n = 37;
+  std::vector<float> sigma_t(n), source(n), psi(n), delta_psi(n);
+  for (int g = 0; g < n; ++g) {
+    sigma_t[g] = 0.1f + 0.05f * g;
+    source[g] = 0.5f;
+    psi[g] = 1.0f + 0.01f * g;
+  }
+  std::vector<float> psi_0 = psi;
+
+  float distance = 0.8f;
+  attenuate_flat_source_groups(n, distance, sigma_t.data(), source.data(),
+    psi.data(), delta_psi.data());
+
+  // The angular flux relaxes towards the source along the segment
+  for (int g = 0; g < n; ++g) {
+    double ref = source[g] + (psi_0[g] - source[g]) *
+                               std::exp(-sigma_t[g] * distance);
+    REQUIRE_THAT(psi[g], Catch::Matchers::WithinRel(ref, 1.0e-5));
+    REQUIRE_THAT(psi_0[g] - delta_psi[g],
+      Catch::Matchers::WithinRel(psi[g], 1.0e-6));
+  }
+}
+
+TEST_CASE("Benchmark flat source attenuation", "[.][benchmark]")
+{
+  int n = GENERATE(2, 7, 70, 300);
+  std::vector<float> sigma_t(n), source(n), psi(n, 1.0f), delta_psi(n);
+  for (int g = 0; g < n; ++g) {
+    sigma_t[g] = 0.2f + 0.01f * g;
+    source[g] = 0.5f;
+  }
+
+  BENCHMARK("attenuate " + std::to_string(n) + " groups")
+  {
+    attenuate_flat_source_groups(n, 0.3f, sigma_t.data(), source.data(),
+      psi.data(), delta_psi.data());
+    return psi[n - 1];
+  };
+}
+
+TEST_CASE("Benchmark history and event attenuation order", "[.][benchmark]")
+{
+  // Segments crossing materials in random order, as traced by one ray at a
+  // time, and sorted by material, as attenuated in event-based mode
+  int n = GENERATE(2, 7, 70);
+  int n_materials = 500;
+  int n_segments = 20000;
+  std::vector<float> sigma_t(n_materials * n), source(n_materials * n, 0.5f);
+  for (int i = 0; i < n_materials * n; ++i) {
+    sigma_t[i] = 0.2f + 1.0e-4f * i;
+  }
+  std::vector<int> history(n_segments);
+  uint64_t seed = 1;
+  for (auto& m : history) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    m = (seed >> 33) % n_materials;
+  }
+  std::vector<int> event = history;
+  std::sort(event.begin(), event.end());
+  std::vector<float> psi(n, 1.0f), delta_psi(n);
+
+  auto sweep = [&](const std::vector<int>& materials) {
+    for (int m : materials) {
+      attenuate_flat_source_groups(n, 0.3f, &sigma_t[m * n], &source[m * n],
+        psi.data(), delta_psi.data());
+    }
+    return psi[n - 1];
+  };
+
+  BENCHMARK("history order " + std::to_string(n) + " groups")
+  {
+    return sweep(history);
+  };
+
+  BENCHMARK("event order " + std::to_string(n) + " groups")
+  {
+    return sweep(event);
+  };
+}
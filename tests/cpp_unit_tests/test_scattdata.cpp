@@ -0,0 +1,44 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "openmc/random_lcg.h"
+#include "openmc/scattdata.h"
+#include "openmc/settings.h"
+
+using namespace openmc;
+
+TEST_CASE("Test alias sampling of outgoing groups")
+{
+  constexpr int n_samples = 1000000;
+  double p[4] = {0.1, 0.0, 0.6, 0.3};
+
+  // One incoming group scattering isotropically into four outgoing groups
+  xt::xtensor<int, 1> gmin {0};
+  xt::xtensor<int, 1> gmax {3};
+  double_2dvec mult {{1.0, 1.0, 1.0, 1.0}};
+  double_3dvec coeffs {{{p[0]}, {p[1]}, {p[2]}, {p[3]}}};
+
+  for (bool alias : {false, true}) {
+    settings::mg_alias_sampling = alias;
+    ScattDataHistogram scatt;
+    scatt.init(gmin, gmax, mult, coeffs);
+    REQUIRE(scatt.energy_alias.empty() == !alias);
+
+    uint64_t seed = init_seed(0, 0);
+    int counts[4] = {0, 0, 0, 0};
+    for (int i = 0; i < n_samples; i++) {
+      int gout, i_gout;
+      scatt.sample_energy(0, gout, i_gout, &seed);
+      REQUIRE(gout == i_gout);
+      counts[gout]++;
+    }
+
+    // Groups without scattering are never sampled
+    REQUIRE(counts[1] == 0);
+    for (int g = 0; g < 4; g++) {
+      REQUIRE_THAT(
+        counts[g] / double(n_samples), Catch::Matchers::WithinAbs(p[g], 2e-3));
+    }
+  }
+  settings::mg_alias_sampling = false;
+}
@@ -1,6 +1,10 @@
+#include "openmc/search.h"
+#include "openmc/tallies/filter_energy.h"
 #include "openmc/tallies/tally.h"
 #include <catch2/catch_test_macros.hpp>
 
+#include <cmath>
+
 using namespace openmc;
 
 TEST_CASE("Test add/set_filter")
@@ -52,4 +56,33 @@ TEST_CASE("Test add/set_filter")
   REQUIRE(tally->filters().size() == 1);
   REQUIRE(model::filter_map[cell_filter->id()] == tally->filters(0));
 
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test energy filter bin search")
+{
+  auto* filter = dynamic_cast<EnergyFilter*>(Filter::create("energy"));
+  REQUIRE(filter);
+
+  // Uniform lethargy bins above a lower edge of zero, with one irregular edge
+  std::vector<double> bins {0.0};
+  for (int i = 0; i <= 100; ++i) {
+    bins.push_back(1.0e-5 * std::pow(10.0, 0.12 * i));
+  }
+  bins[50] = 0.5 * (bins[49] + bins[50]);
+  filter->set_bins(bins);
+
+  // Bin edges, points just around them, and points within the first bin
+  std::vector<double> energies {1.0e-8, 1.0e-6};
+  for (double E : bins) {
+    energies.push_back(E);
+    energies.push_back(std::nextafter(E, 0.0));
+    energies.push_back(std::nextafter(E, 1.0e8));
+    energies.push_back(E * 1.3);
+  }
+  for (double E : energies) {
+    if (E < bins.front() || E > bins.back())
+      continue;
+    REQUIRE(filter->find_bin(E) ==
+            lower_bound_index(bins.begin(), bins.end(), E));
+  }
+}
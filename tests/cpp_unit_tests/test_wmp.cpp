@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <string>
+#include <tuple>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <hdf5.h>
+
+#include "xtensor/xtensor.hpp"
+
+#include "openmc/hdf5_interface.h"
+#include "openmc/vector.h"
+#include "openmc/wmp.h"
+
+using namespace openmc;
+
+namespace {
+
+constexpr int N_WINDOWS {99};
+constexpr int POLES_PER_WINDOW {4};
+
+// Pole of a synthetic library. Windows are one unit apart in sqrt(E) from
+// 1 eV to 10 keV and each holds evenly spaced poles just below the real axis.
+std::complex<double> pole(int i)
+{
+  return {1.125 + 0.25 * i, -0.01 - 0.001 * (i % 7)};
+}
+
+// Write a synthetic fissionable multipole library and read it back
+WindowedMultipole make_multipole()
+{
+  int n_poles = N_WINDOWS * POLES_PER_WINDOW;
+  xt::xtensor<std::complex<double>, 2> data({size_t(n_poles), 4});
+  for (int i = 0; i < n_poles; ++i) {
+    data(i, MP_EA) = pole(i);
+    data(i, MP_RS) = {0.02 + 0.001 * (i % 5), 0.003};
+    data(i, MP_RA) = {0.01, -0.002 * (i % 3)};
+    data(i, MP_RF) = {0.005, 0.001};
+  }
+  xt::xtensor<int, 2> windows({N_WINDOWS, 2});
+  xt::xtensor<bool, 1> broaden_poly({N_WINDOWS});
+  xt::xtensor<double, 3> curvefit({N_WINDOWS, 3, 3});
+  for (int i = 0; i < N_WINDOWS; ++i) {
+    windows(i, 0) = POLES_PER_WINDOW * i + 1;
+    windows(i, 1) = POLES_PER_WINDOW * (i + 1);
+    broaden_poly(i) = (i % 2 == 0);
+    for (int j = 0; j < 3; ++j) {
+      curvefit(i, 0, j) = 10.0 + j;
+      curvefit(i, 1, j) = 2.0;
+      curvefit(i, 2, j) = 0.1 * j;
+    }
+  }
+
+  hid_t file = file_open("wmp_synthetic.h5", 'w');
+  hid_t group = create_group(file, "U235");
+  write_dataset(group, "spacing", 1.0);
+  write_dataset(group, "sqrtAWR", std::sqrt(233.0248));
+  write_dataset(group, "E_min", 1.0);
+  write_dataset(group, "E_max", 1.0e4);
+  write_dataset(group, "windows", windows);
+  write_dataset(group, "broaden_poly", broaden_poly);
+  write_dataset(group, "curvefit", curvefit);
+
+  // Poles and residues are stored as compound complex numbers
+  hid_t complex_id = H5Tcreate(H5T_COMPOUND, sizeof(std::complex<double>));
+  H5Tinsert(complex_id, "r", 0, H5T_NATIVE_DOUBLE);
+  H5Tinsert(complex_id, "i", sizeof(double), H5T_NATIVE_DOUBLE);
+  hsize_t dims[] {hsize_t(n_poles), 4};
+  write_dataset_lowlevel(
+    group, 2, dims, "data", complex_id, H5S_ALL, false, data.data());
+  H5Tclose(complex_id);
+  close_group(group);
+  file_close(file);
+
+  file = file_open("wmp_synthetic.h5", 'r');
+  group = open_group(file, "U235");
+  WindowedMultipole wmp {group};
+  close_group(group);
+  file_close(file);
+  return wmp;
+}
+
+} // namespace
+
+TEST_CASE("Test windowed multipole evaluation")
+{
+  auto wmp = make_multipole();
+  REQUIRE(wmp.fissionable_);
+  REQUIRE(wmp.fit_order_ == 2);
+
+  // At 0 K the cross sections are the curvefit plus the contribution of the
+  // poles of the window
+  for (double E : {1.3, 17.0, 250.0, 9876.5}) {
+    double sqrtE = std::sqrt(E);
+    int i_window = std::min<int>(sqrtE - 1.0, N_WINDOWS - 1);
+    std::complex<double> sum_s = 0.0;
+    std::complex<double> sum_a = 0.0;
+    std::complex<double> sum_f = 0.0;
+    for (int i = POLES_PER_WINDOW * i_window;
+         i < POLES_PER_WINDOW * (i_window + 1); ++i) {
+      auto c = std::complex<double>(0.0, -1.0) / (wmp.data_(i, MP_EA) - sqrtE);
+      sum_s += wmp.data_(i, MP_RS) * c;
+      sum_a += wmp.data_(i, MP_RA) * c;
+      sum_f += wmp.data_(i, MP_RF) * c;
+    }
+    double ref_s = (10.0 + 2.0 * sqrtE) / E + sum_s.real() / E;
+    double ref_a = (11.0 + 2.0 * sqrtE + 0.1 * E) / E + sum_a.real() / E;
+    double ref_f = (12.0 + 2.0 * sqrtE + 0.2 * E) / E + sum_f.real() / E;
+
+    auto [sig_s, sig_a, sig_f] = wmp.evaluate(E, 0.0);
+    REQUIRE_THAT(sig_s, Catch::Matchers::WithinRel(ref_s, 1e-12));
+    REQUIRE_THAT(sig_a, Catch::Matchers::WithinRel(ref_a, 1e-12));
+    REQUIRE_THAT(sig_f, Catch::Matchers::WithinRel(ref_f, 1e-12));
+  }
+
+  // Evaluating several lookups together gives the same cross sections as
+  // evaluating each alone
+  int n = 50;
+  vector<double> E(n), sqrtkT(n, 0.1), sig_s(n), sig_a(n), sig_f(n);
+  for (int k = 0; k < n; ++k) {
+    E[k] = 1.0 + 3.7 * k * k;
+  }
+  wmp.evaluate_batch(
+    n, E.data(), sqrtkT.data(), sig_s.data(), sig_a.data(), sig_f.data());
+  for (int k = 0; k < n; ++k) {
+    auto [s, a, f] = wmp.evaluate(E[k], sqrtkT[k]);
+    REQUIRE(sig_s[k] == s);
+    REQUIRE(sig_a[k] == a);
+    REQUIRE(sig_f[k] == f);
+  }
+}
+
+TEST_CASE("Benchmark windowed multipole evaluation", "[.][benchmark]")
+{
+  auto wmp = make_multipole();
+  int n = 1000;
+  vector<double> E(n);
+  for (int k = 0; k < n; ++k) {
+    E[k] = 1.0 + 9998.0 * (0.5 + 0.5 * std::sin(1.7 * k));
+  }
+
+  auto evaluate = [&](double sqrtkT) {
+    double total = 0.0;
+    for (int k = 0; k < n; ++k) {
+      auto [s, a, f] = wmp.evaluate(E[k], sqrtkT);
+      total += s + a + f;
+    }
+    return total;
+  };
+
+  BENCHMARK("evaluate 0 K")
+  {
+    return evaluate(0.0);
+  };
+  BENCHMARK("evaluate 294 K")
+  {
+    return evaluate(std::sqrt(8.617333262e-5 * 294.0));
+  };
+}
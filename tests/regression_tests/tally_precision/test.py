@@ -0,0 +1,75 @@
+"""Scores to a tally whose batch values are summed in single precision should
+agree with those of an identical tally in double precision to within rounding
+error, which is far smaller than the statistical uncertainty of the tally."""
+
+import numpy as np
+import openmc
+import pytest
+
+from tests.regression_tests import config
+
+
+@pytest.fixture
+def model():
+    openmc.reset_auto_ids()
+    model = openmc.Model()
+
+    fuel = openmc.Material()
+    fuel.add_nuclide('U235', 1.0)
+    fuel.add_nuclide('O16', 2.0)
+    fuel.set_density('g/cm3', 10.0)
+    water = openmc.Material()
+    water.add_nuclide('H1', 2.0)
+    water.add_nuclide('O16', 1.0)
+    water.set_density('g/cm3', 1.0)
+    model.materials = [fuel, water]
+
+    sphere = openmc.Sphere(r=5.0)
+    box = openmc.model.RectangularParallelepiped(
+        -10., 10., -10., 10., -10., 10., boundary_type='vacuum')
+    inner = openmc.Cell(fill=fuel, region=-sphere)
+    outer = openmc.Cell(fill=water, region=+sphere & -box)
+    model.geometry = openmc.Geometry([inner, outer])
+
+    model.settings.batches = 10
+    model.settings.inactive = 0
+    model.settings.particles = 2000
+    model.settings.source = openmc.IndependentSource(
+        space=openmc.stats.Point())
+
+    mesh = openmc.RegularMesh()
+    mesh.lower_left = (-10., -10., -10.)
+    mesh.upper_right = (10., 10., 10.)
+    mesh.dimension = (10, 10, 10)
+    mesh_filter = openmc.MeshFilter(mesh)
+    for precision in ('double', 'single'):
+        tally = openmc.Tally(name=precision)
+        tally.filters = [mesh_filter]
+        tally.scores = ['flux', 'fission']
+        tally.precision = precision
+        model.tallies.append(tally)
+
+    return model
+
+
+def test_tally_precision(model, run_in_tmpdir):
+    kwargs = {'openmc_exec': config['exe'], 'event_based': config['event']}
+    if config['mpi']:
+        kwargs['mpi_args'] = [config['mpiexec'], '-n', config['mpi_np']]
+    sp_path = model.run(**kwargs)
+
+    with openmc.StatePoint(sp_path) as sp:
+        t_double = sp.get_tally(name='double')
+        t_single = sp.get_tally(name='single')
+
+        # Both tallies see exactly the same scores, so any difference in the
+        # mean is rounding error in the single-precision batch values
+        scored = t_double.mean > 0.0
+        assert np.array_equal(scored, t_single.mean > 0.0)
+        np.testing.assert_allclose(t_single.mean, t_double.mean, rtol=1e-5)
+        diff = np.abs(t_single.mean - t_double.mean)
+        assert np.all(diff[scored] < 1e-2 * t_double.std_dev[scored])
+
+        # The statistical uncertainty is unaffected
+        np.testing.assert_allclose(
+            t_single.std_dev, t_double.std_dev, rtol=1e-3, atol=0.0)
@@ -261,11 +261,6 @@ def test_unstructured_mesh_tets(model, test_opts):
     if test_opts['library'] == 'libmesh' and not openmc.lib._libmesh_enabled():
         pytest.skip("LibMesh is not enabled in this build.")
 
-    # skip the tracklength test for libmesh
-    if test_opts['library'] == 'libmesh' and \
-       test_opts['estimator'] == 'tracklength':
-       pytest.skip("Tracklength tallies are not supported using libmesh.")
-
     if test_opts['holes']:
         mesh_filename = "test_mesh_tets_w_holes.e"
     else:
@@ -276,6 +276,32 @@ def test_energyfunc():
     assert f.interpolation == new_f.interpolation
 
 
+
+def test_energyresponse():
+    f = openmc.EnergyResponseFilter(
+        [0.0, 0.625, 2.0e7],
+        [[1.0, 0.5], [0.0, 2.0], [3.0, 3.0]]
+    )
+    assert f.num_bins == 3
+    assert f.bins.tolist() == [0, 1, 2]
+    assert f.interpolation == 'histogram'
+
+    # Make sure XML roundtrip works
+    elem = f.to_xml_element()
+    new_f = openmc.EnergyResponseFilter.from_xml_element(elem)
+    assert new_f == f
+    assert new_f.responses.shape == (3, 2)
+
+    # Pointwise responses need a value at each grid energy
+    f = openmc.EnergyResponseFilter(
+        [1.0, 10.0, 100.0], [[1.0, 2.0, 3.0]], 'linear-linear')
+    new_f = openmc.EnergyResponseFilter.from_xml_element(f.to_xml_element())
+    assert new_f == f
+    with raises(ValueError):
+        f.interpolation = 'histogram'
+    with raises(ValueError):
+        openmc.EnergyResponseFilter([1.0, 10.0], [[1.0, 2.0, 3.0]])
+
 def test_tabular_from_energyfilter():
     efilter = openmc.EnergyFilter([0.0, 10.0, 20.0, 25.0])
     tab = efilter.get_tabular(values=[5, 10, 10])
@@ -420,3 +420,42 @@ def test_hex_lattice_roundtrip(orientation):
     xml_latt = xml_geom.get_all_lattices()[latt.id]
 
     check_lattice_universes(latt, xml_latt)
+
+
+def test_sphere_pack(run_in_tmpdir, pincell1, pincell2, uo2, water):
+    openmc.reset_auto_ids()
+    outer = openmc.Universe(cells=[openmc.Cell(fill=water)])
+    pack = openmc.SpherePack()
+    pack.radius = 0.5
+    pack.centers = [(0., 0., 0.), (1.5, 0., 0.), (0., 1.5, 0.)]
+    pack.universes = [pincell1, pincell2, pincell1]
+    pack.outer = outer
+
+    assert pack.indices == [0, 1, 2]
+    assert pack.get_unique_universes() == {
+        pincell1.id: pincell1, pincell2.id: pincell2, outer.id: outer}
+
+    # Points inside a sphere are relative to its center
+    idx, p = pack.find_element((1.6, 0.1, 0.0))
+    assert idx == 1
+    assert p == pytest.approx((0.1, 0.1, 0.0))
+    assert pack.get_universe(idx) is pincell2
+
+    # Points between spheres are in the outer universe
+    idx, p = pack.find_element((0.75, 0.75, 0.0))
+    assert idx == 3
+    assert p == pytest.approx((0.75, 0.75, 0.0))
+    assert pack.get_universe(idx) is outer
+
+    # Export to XML and read back
+    geom = openmc.Geometry([openmc.Cell(fill=pack)])
+    geom.export_to_xml()
+    xml_geom = openmc.Geometry.from_xml(
+        materials=openmc.Materials([uo2, water]))
+    xml_pack = xml_geom.get_all_lattices()[pack.id]
+    assert isinstance(xml_pack, openmc.SpherePack)
+    assert xml_pack.radius == pack.radius
+    assert xml_pack.centers == pytest.approx(pack.centers)
+    assert [u.id for u in xml_pack.universes] == [
+        pincell1.id, pincell2.id, pincell1.id]
+    assert xml_pack.outer.id == outer.id
@@ -395,6 +395,30 @@ def test_tally_writable(lib_simulation_init):
     t.writable = True
 
 
+def test_tally_thread_private(lib_simulation_init):
+    t = openmc.lib.tallies[1]
+    assert not t.thread_private
+    t.thread_private = True
+    assert t.thread_private
+    t.thread_private = False
+
+
+def test_majorant(lib_simulation_init):
+    fuel = openmc.lib.materials[1]
+    water = openmc.lib.materials[3]
+    fuel_majorant = openmc.lib.Majorant([fuel])
+    majorant = openmc.lib.Majorant([fuel, water])
+
+    xs = majorant.xs
+    assert majorant.energy.size == xs.size + 1
+    assert np.all(xs > 0.0)
+    assert np.all(xs >= fuel_majorant.xs)
+
+    # Evaluating at the center of a bin gives the value of that bin
+    E = np.sqrt(majorant.energy[100] * majorant.energy[101])
+    assert majorant(E) == pytest.approx(xs[100])
+
+
 def test_tally_results(lib_run):
     t = openmc.lib.tallies[1]
     assert t.num_realizations == 10  # t was made active in test_tally_active
@@ -531,6 +555,37 @@ def test_reproduce_keff(lib_init):
     assert keff0 == pytest.approx(keff1)
 
 
+def test_reaction_rates(lib_init):
+    fuel = openmc.lib.materials[1]
+    nuclides = ['U235', 'U238']
+    reactions = ['fission', '(n,gamma)']
+
+    # Accumulate rates directly from transport cross sections
+    openmc.lib.hard_reset()
+    openmc.lib.set_reaction_rates([fuel], nuclides, reactions)
+    try:
+        openmc.lib.run()
+        rates = openmc.lib.reaction_rates()
+        assert rates.shape == (1, 2, 2)
+        assert np.all(rates > 0.0)
+        flux = openmc.lib.reaction_rate_flux()
+        assert flux.shape == (1, 1)
+        assert flux[0, 0] > 0.0
+
+        # Use flux collapse instead
+        openmc.lib.hard_reset()
+        energies = [0.0, 0.625, 1.0e3, 20.0e6]
+        openmc.lib.set_reaction_rates([fuel], nuclides, reactions, energies)
+        openmc.lib.run()
+        assert openmc.lib.reaction_rate_flux().shape == (1, 3)
+        assert np.all(openmc.lib.reaction_rates() > 0.0)
+    finally:
+        openmc.lib.clear_reaction_rates()
+
+    with pytest.raises(exc.AllocationError):
+        openmc.lib.reaction_rates()
+
+
 def test_find_cell(lib_init):
     cell, instance = openmc.lib.find_cell((0., 0., 0.))
     assert cell is openmc.lib.cells[1]
@@ -614,6 +669,11 @@ def test_regular_mesh(lib_init):
     for elem_vols in vols:
         assert sum(f[1] for f in elem_vols) == pytest.approx(1.26 * 1.26, 1e-2)
 
+    # Ray-traced volumes only count the part of the mesh inside the model
+    vols = mesh.traced_material_volumes((50, 50, 10))
+    for elem_vols in vols:
+        assert sum(f[1] for f in elem_vols) == pytest.approx(1.26 * 1.26, 1e-2)
+
 
 def test_regular_mesh_get_plot_bins(lib_init):
     mesh: openmc.lib.RegularMesh = openmc.lib.meshes[2]
@@ -888,6 +948,39 @@ def test_property_map(lib_init):
     assert np.allclose(expected_properties, properties, atol=1e-04)
 
 
+def test_tile_mapper(lib_init):
+    s = openmc.lib.plot._PlotBase()
+    s.width = 1.26
+    s.height = 1.26
+    s.v_res = 9
+    s.h_res = 7
+    s.origin = (0.0, 0.0, 0.0)
+    s.basis = 'xy'
+    s.level = -1
+    expected_ids = openmc.lib.plot.id_map(s)
+
+    # Tiles at full resolution assemble into the map of the whole view
+    mapper = openmc.lib.TileMapper(tile_size=4, max_workers=2)
+    nx, ny = mapper.n_tiles(s)
+    assert (nx, ny) == (2, 3)
+    rows = []
+    for j in range(ny):
+        futures = [mapper.request(s, i, j) for i in range(nx)]
+        rows.append(np.hstack([f.result() for f in futures]))
+    assert np.array_equal(np.vstack(rows), expected_ids)
+
+    # Finished tiles are cached and coarse tiles have the shape of the tile
+    levels = []
+    futures = mapper.request_progressive(
+        s, 1, 2, levels=2, callback=lambda data, level: levels.append(level))
+    assert len(futures) == 3
+    assert futures[-1].result() is mapper.request(s, 1, 2).result()
+    for f in futures:
+        assert f.result().shape == (1, 3, 3)
+    mapper.shutdown()
+    assert sorted(levels) == [0, 1, 2]
+
+
 def test_position(lib_init):
 
     pos = openmc.lib.plot._Position(1.0, 2.0, 3.0)
@@ -1020,3 +1113,122 @@ def test_sample_external_source(run_in_tmpdir, mpi_intracomm):
     openmc.lib.init(["-c"])
     openmc.lib.sample_external_source(100)
     openmc.lib.finalize()
+
+
+def test_sample_biased_source(run_in_tmpdir, mpi_intracomm):
+    mat = openmc.Material()
+    mat.add_nuclide('U235', 1.0e-2)
+    sph = openmc.Sphere(r=100.0, boundary_type='vacuum')
+    cell = openmc.Cell(fill=mat, region=-sph)
+    model = openmc.Model()
+    model.geometry = openmc.Geometry([cell])
+    model.settings.source = openmc.IndependentSource(
+        energy=openmc.stats.Discrete([1.0e5, 1.0e6], [0.9, 0.1],
+                                     bias=[0.5, 0.5])
+    )
+    model.settings.particles = 1000
+    model.settings.batches = 10
+    model.export_to_xml()
+
+    # Energies are sampled from the biased probabilities and weighted by the
+    # ratio of unbiased to biased probability
+    openmc.lib.init()
+    particles = openmc.lib.sample_external_source(1000, prn_seed=3)
+    openmc.lib.finalize()
+    for p in particles:
+        if p.E == 1.0e5:
+            assert p.wgt == pytest.approx(1.8)
+        else:
+            assert p.wgt == pytest.approx(0.2)
+    n_high = sum(p.E == 1.0e6 for p in particles)
+    assert 400 < n_high < 600
+
+
+def test_set_source_sites(run_in_tmpdir, mpi_intracomm):
+    mat = openmc.Material()
+    mat.add_nuclide('U235', 1.0e-2)
+    sph = openmc.Sphere(r=100.0, boundary_type='vacuum')
+    cell = openmc.Cell(fill=mat, region=-sph)
+    model = openmc.Model()
+    model.geometry = openmc.Geometry([cell])
+    model.settings.particles = 1000
+    model.settings.batches = 10
+    model.export_to_xml()
+
+    # Sites held in memory replace the source given in the settings
+    openmc.lib.init()
+    sites = [openmc.SourceParticle(r=(float(i), 0., 0.), E=1.0e6)
+             for i in range(5)]
+    openmc.lib.set_source_sites(sites)
+    particles = openmc.lib.sample_external_source(100, prn_seed=3)
+    assert {p.r[0] for p in particles} <= {0., 1., 2., 3., 4.}
+    assert all(p.E == 1.0e6 for p in particles)
+
+    # An array with the source bank datatype is sampled in place
+    array = np.zeros(2, dtype=openmc.lib.core._SourceSite)
+    array['r'][:, 2] = [-1., 1.]
+    array['u'][:, 0] = 1.0
+    array['E'] = 2.0e6
+    array['wgt'] = 1.0
+    openmc.lib.set_source_sites(array)
+    array['E'] = 3.0e6
+    particles = openmc.lib.sample_external_source(10)
+    assert all(p.E == 3.0e6 for p in particles)
+    assert {p.r[2] for p in particles} <= {-1., 1.}
+    openmc.lib.finalize()
+
+
+def test_persistent_source(run_in_tmpdir, mpi_intracomm):
+    mat = openmc.Material()
+    mat.add_nuclide('U235', 1.0e-2)
+    sph = openmc.Sphere(r=100.0, boundary_type='vacuum')
+    cell = openmc.Cell(fill=mat, region=-sph)
+    model = openmc.Model()
+    model.geometry = openmc.Geometry([cell])
+    model.settings.particles = 100
+    model.settings.batches = 3
+    model.settings.inactive = 1
+    model.export_to_xml()
+
+    # The source at the end of a simulation starts the next one
+    openmc.lib.init(intracomm=mpi_intracomm)
+    openmc.lib.simulation_set_persistent(True)
+    openmc.lib.run()
+    final_source = openmc.lib.source_bank().copy()
+    openmc.lib.simulation_init()
+    assert np.array_equal(openmc.lib.source_bank(), final_source)
+    openmc.lib.simulation_finalize()
+
+    # Without it, the external source is sampled again
+    openmc.lib.simulation_set_persistent(False)
+    openmc.lib.simulation_init()
+    assert not np.array_equal(openmc.lib.source_bank(), final_source)
+    openmc.lib.simulation_finalize()
+    openmc.lib.finalize()
+
+
+def test_run_ensemble(run_in_tmpdir, mpi_intracomm):
+    mat = openmc.Material()
+    mat.add_nuclide('U235', 1.0e-2)
+    mat.set_density('g/cm3', 1.0)
+    sph = openmc.Sphere(r=100.0, boundary_type='vacuum')
+    cell = openmc.Cell(fill=mat, region=-sph)
+    model = openmc.Model()
+    model.geometry = openmc.Geometry([cell])
+    model.settings.particles = 100
+    model.settings.batches = 3
+    model.settings.inactive = 1
+    model.export_to_xml()
+
+    variants = [{}, {'seed': 2}, {'densities': {mat.id: 2.0}}, {}]
+    paths = openmc.lib.run_ensemble(variants, intracomm=mpi_intracomm)
+    keff = []
+    for path in paths:
+        with openmc.StatePoint(path) as sp:
+            keff.append(sp.keff)
+
+    # The seed and density change the result, and the changes of a variant
+    # do not carry over to the next one
+    assert keff[1] != keff[0]
+    assert keff[2] != keff[0]
+    assert keff[3] == keff[0]
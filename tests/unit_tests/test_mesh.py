@@ -1,5 +1,6 @@
 from math import pi
 
+import h5py
 import numpy as np
 import pytest
 import openmc
@@ -360,6 +361,7 @@ def test_CylindricalMesh_get_indices_at_coords():
 def test_umesh_roundtrip(run_in_tmpdir, request):
     umesh = openmc.UnstructuredMesh(request.path.parent / 'test_mesh_tets.e', 'moab')
     umesh.output = True
+    umesh.tracker = 'adjacency'
 
     # create a tally using this mesh
     mf = openmc.MeshFilter(umesh)
@@ -375,6 +377,7 @@ def test_umesh_roundtrip(run_in_tmpdir, request):
     xml_mesh = xml_tally.filters[0].mesh
 
     assert umesh.id == xml_mesh.id
+    assert xml_mesh.tracker == 'adjacency'
 
 
 def test_mesh_get_homogenized_materials():
@@ -428,3 +431,98 @@ def test_mesh_get_homogenized_materials():
     m5, = mesh_void.get_homogenized_materials(
         model, n_samples=1000, include_void=False)
     assert m5.get_mass_density('H1') == pytest.approx(1.0)
+
+
+def test_mesh_traced_material_volumes(run_in_tmpdir):
+    """Test ray-traced material volumes and their cache"""
+    # Simple model with 1 cm of Fe56 next to 1 cm of H1
+    fe = openmc.Material()
+    fe.add_nuclide('Fe56', 1.0)
+    fe.set_density('g/cm3', 5.0)
+    h = openmc.Material()
+    h.add_nuclide('H1', 1.0)
+    h.set_density('g/cm3', 1.0)
+
+    x0 = openmc.XPlane(-1.0, boundary_type='vacuum')
+    x1 = openmc.XPlane(0.0)
+    x2 = openmc.XPlane(1.0, boundary_type='vacuum')
+    cell1 = openmc.Cell(fill=fe, region=+x0 & -x1)
+    cell2 = openmc.Cell(fill=h, region=+x1 & -x2)
+    model = openmc.Model(geometry=openmc.Geometry([cell1, cell2]))
+    model.settings.particles = 1000
+    model.settings.batches = 10
+
+    mesh = openmc.RegularMesh()
+    mesh.lower_left = (-1., -1., -1.)
+    mesh.upper_right = (1., 1., 1.)
+    mesh.dimension = (3, 1, 1)
+    vols = mesh.material_volumes(
+        model, n_rays=(30, 10, 10), cache_file='volumes.h5')
+
+    # Planes between materials and elements line up with the rays, so the
+    # traced volumes are exact
+    elem_volume = 8.0 / 3.0
+    assert vols[0] == [(fe.id, pytest.approx(elem_volume))]
+    assert dict(vols[1]) == {
+        fe.id: pytest.approx(elem_volume / 2),
+        h.id: pytest.approx(elem_volume / 2)
+    }
+    assert vols[2] == [(h.id, pytest.approx(elem_volume))]
+
+    # Computing the same volumes again reads them from the cache
+    with h5py.File('volumes.h5', 'r') as fh:
+        assert len(fh) == 1
+    assert mesh.material_volumes(
+        model, n_rays=(30, 10, 10), cache_file='volumes.h5') == vols
+
+    # Different rays are cached separately
+    mesh.material_volumes(model, n_rays=(60, 10, 10), cache_file='volumes.h5')
+    with h5py.File('volumes.h5', 'r') as fh:
+        assert len(fh) == 2
+
+    m1, m2, m3 = mesh.get_homogenized_materials(model, n_rays=(30, 10, 10))
+    assert m2.get_mass_density('Fe56') == pytest.approx(2.5)
+    assert m2.get_mass_density('H1') == pytest.approx(0.5)
+
+
+def test_octree_mesh(run_in_tmpdir):
+    mesh = openmc.OctreeMesh((2, 1, 1), (0., 0., 0.), (2., 1., 1.))
+    assert mesh.n_elements == 2
+
+    # Split the second root cell and then the first of its octants
+    mesh.refine([1])
+    assert mesh.refinement == [0, 1] + [0]*8
+    mesh.refine([1])
+    assert mesh.refinement == [0, 1, 1] + [0]*15
+    assert mesh.n_elements == 16
+    assert mesh.levels.tolist() == [0] + [2]*8 + [1]*7
+    assert mesh.volumes.sum() == pytest.approx(mesh.total_volume)
+    np.testing.assert_allclose(mesh.element_lower_left[1], (1., 0., 0.))
+    np.testing.assert_allclose(mesh.element_upper_right[1], (1.25, 0.25, 0.25))
+    np.testing.assert_allclose(mesh.centroids[9], (1.75, 0.25, 0.25))
+
+    with pytest.raises(ValueError):
+        mesh.refinement = [0, 1, 0]
+
+    # Refine around a point up to two levels everywhere nearby
+    mesh.refine_region(openmc.BoundingBox((0.1,)*3, (0.2,)*3), 2)
+    assert mesh.levels[0] == 2
+    assert mesh.volumes.sum() == pytest.approx(mesh.total_volume)
+
+    # Only well-converged elements are split
+    n = mesh.n_elements
+    mean = np.ones(n)
+    std_dev = np.full(n, 0.5)
+    std_dev[3] = 0.01
+    assert mesh.refine_by_error(mean, std_dev, 0.1) == 1
+    assert mesh.n_elements == n + 7
+
+    # Round trip through XML
+    tally = openmc.Tally()
+    tally.filters = [openmc.MeshFilter(mesh)]
+    tally.scores = ['flux']
+    openmc.Tallies([tally]).export_to_xml()
+    xml_mesh = openmc.Tallies.from_xml()[0].filters[0].mesh
+    assert isinstance(xml_mesh, openmc.OctreeMesh)
+    assert xml_mesh.refinement == mesh.refinement
+    np.testing.assert_allclose(xml_mesh.upper_right, mesh.upper_right)
@@ -12,17 +12,23 @@ def test_export_to_xml(run_in_tmpdir):
     s.keff_trigger = {'type': 'std_dev', 'threshold': 0.001}
     s.energy_mode = 'continuous-energy'
     s.max_order = 5
+    s.mg_alias_sampling = True
     s.max_tracks = 1234
     s.source = openmc.IndependentSource(space=openmc.stats.Point())
-    s.output = {'summary': True, 'tallies': False, 'path': 'here'}
+    s.output = {'summary': True, 'tallies': False, 'path': 'here',
+                'compression': 'deflate', 'compression_level': 6,
+                'chunk_size': 65536}
     s.verbosity = 7
     s.sourcepoint = {'batches': [50, 150, 500, 1000], 'separate': True,
-                     'write': True, 'overwrite': True, 'mcpl': True}
-    s.statepoint = {'batches': [50, 150, 500, 1000]}
+                     'write': True, 'overwrite': True, 'mcpl': True,
+                     'sharded': True}
+    s.statepoint = {'batches': [50, 150, 500, 1000], 'async': True,
+                    'delta': 4}
     s.surf_source_read = {'path': 'surface_source_1.h5'}
     s.surf_source_write = {'surface_ids': [2], 'max_particles': 200}
     s.confidence_intervals = True
     s.ptables = True
+    s.prune_nuclear_data = True
     s.plot_seed = 100
     s.survival_biasing = True
     s.cutoff = {'weight': 0.25, 'weight_avg': 0.5, 'energy_neutron': 1.0e-5,
@@ -45,6 +51,7 @@ def test_export_to_xml(run_in_tmpdir):
     s.trace = (10, 1, 20)
     s.track = [(1, 1, 1), (2, 1, 1)]
     s.ufs_mesh = mesh
+    s.fission_matrix_mesh = mesh
     s.resonance_scattering = {'enable': True, 'method': 'rvs',
                               'energy_min': 1.0, 'energy_max': 1000.0,
                               'nuclides': ['U235', 'U238', 'Pu239']}
@@ -56,17 +63,69 @@ def test_export_to_xml(run_in_tmpdir):
     s.log_grid_bins = 2000
     s.photon_transport = False
     s.electron_treatment = 'led'
+    s.electron_inline_deposition = True
     s.write_initial_source = True
     s.weight_window_checkpoints = {'surface': True, 'collision': False}
+    s.exponential_transforms = [
+        {'cells': [1, 2], 'stretching': 0.5, 'direction': (1.0, 0.0, 0.0)}]
+    s.delta_tracking_cells = [3, 4]
     s.random_ray = {
         'distance_inactive': 10.0,
         'distance_active': 100.0,
         'ray_source': openmc.IndependentSource(
             space=openmc.stats.Box((-1., -1., -1.), (1., 1., 1.))
-        )
+        ),
+        'segment_cache_iterations': 4,
+        'segment_cache_memory': 500.0,
+        'anderson_depth': 3,
+        'adjoint': True,
+        'source_region_mesh': (mesh, [1, 2])
     }
 
     s.max_particle_events = 100
+    s.event_queue_sort = True
+    s.event_autotune = True
+    s.event_xs_queue_groups = 8
+    s.event_history_tail = 500
+    s.event_secondary_queue = True
+    s.event_thread_pool = 1000
+    s.compact_micro_xs = True
+    s.union_grid_memory = 100.0
+    s.photon_xs_tolerance = 1e-4
+    s.ncrystal_xs_tolerance = 1e-3
+    s.photon_material_xs = True
+    s.photon_only = True
+    s.photon_product_cdf = True
+    s.vectorized_xs = True
+    s.tally_private_memory = 100.0
+    s.tally_stream = {'engine': 'BP5', 'name': 'coupling',
+                      'tally_ids': [1, 2]}
+    s.overlap_reduction = True
+    s.hierarchical_reduce = True
+    s.surface_distance_cache = True
+    s.neighbor_list_reorder = True
+    s.neighbor_list_precompute = True
+    s.geometry_cache = 'geometry_cache.h5'
+    s.thread_stats = True
+    s.thread_affinity = 'spread'
+    s.numa_interleave = True
+    s.profile = True
+    s.memory_report = True
+    s.shared_xs = True
+    s.simplify_regions = True
+    s.xs_cache = 'xs_cache.bin'
+    s.telemetry = 'telemetry.jsonl'
+    s.guide_table_cells = 64
+    s.inelastic_scatter_cdf = True
+    s.load_balancing = True
+    s.overlap_bank_sync = True
+    s.wielandt_shift = 0.5
+    s.warm_start = {'inactive': 2, 'entropy_tolerance': 1.0e-3}
+    s.source_convergence = {'window': 8, 'min_inactive': 5, 'threshold': 2.5}
+    s.source_domain_bounds = True
+    s.census_times = [1.0e-6, 1.0e-5]
+    s.pipeline_batches = True
+    s.track_buffer_memory = 8.0
 
     # Make sure exporting XML works
     s.export_to_xml()
@@ -83,18 +142,24 @@ def test_export_to_xml(run_in_tmpdir):
     assert s.keff_trigger == {'type': 'std_dev', 'threshold': 0.001}
     assert s.energy_mode == 'continuous-energy'
     assert s.max_order == 5
+    assert s.mg_alias_sampling
     assert s.max_tracks == 1234
     assert isinstance(s.source[0], openmc.IndependentSource)
     assert isinstance(s.source[0].space, openmc.stats.Point)
-    assert s.output == {'summary': True, 'tallies': False, 'path': 'here'}
+    assert s.output == {'summary': True, 'tallies': False, 'path': 'here',
+                        'compression': 'deflate', 'compression_level': 6,
+                        'chunk_size': 65536}
     assert s.verbosity == 7
     assert s.sourcepoint == {'batches': [50, 150, 500, 1000], 'separate': True,
-                             'write': True, 'overwrite': True, 'mcpl': True}
-    assert s.statepoint == {'batches': [50, 150, 500, 1000]}
+                             'write': True, 'overwrite': True, 'mcpl': True,
+                             'sharded': True}
+    assert s.statepoint == {'batches': [50, 150, 500, 1000], 'async': True,
+                            'delta': 4}
     assert s.surf_source_read == {'path': 'surface_source_1.h5'}
     assert s.surf_source_write == {'surface_ids': [2], 'max_particles': 200}
     assert s.confidence_intervals
     assert s.ptables
+    assert s.prune_nuclear_data
     assert s.plot_seed == 100
     assert s.seed == 17
     assert s.survival_biasing
@@ -120,6 +185,8 @@ def test_export_to_xml(run_in_tmpdir):
     assert s.ufs_mesh.lower_left == [-10., -10., -10.]
     assert s.ufs_mesh.upper_right == [10., 10., 10.]
     assert s.ufs_mesh.dimension == (5, 5, 5)
+    assert isinstance(s.fission_matrix_mesh, openmc.RegularMesh)
+    assert s.fission_matrix_mesh.dimension == (5, 5, 5)
     assert s.resonance_scattering == {'enable': True, 'method': 'rvs',
                                       'energy_min': 1.0, 'energy_max': 1000.0,
                                       'nuclides': ['U235', 'U238', 'Pu239']}
@@ -128,6 +195,7 @@ def test_export_to_xml(run_in_tmpdir):
     assert s.log_grid_bins == 2000
     assert not s.photon_transport
     assert s.electron_treatment == 'led'
+    assert s.electron_inline_deposition
     assert s.write_initial_source == True
     assert len(s.volume_calculations) == 1
     vol = s.volume_calculations[0]
@@ -137,8 +205,63 @@ def test_export_to_xml(run_in_tmpdir):
     assert vol.lower_left == (-10., -10., -10.)
     assert vol.upper_right == (10., 10., 10.)
     assert s.weight_window_checkpoints == {'surface': True, 'collision': False}
+    assert s.exponential_transforms == [
+        {'cells': [1, 2], 'stretching': 0.5, 'direction': (1.0, 0.0, 0.0)}]
+    assert s.delta_tracking_cells == [3, 4]
     assert s.max_particle_events == 100
+    assert s.event_queue_sort
+    assert s.event_autotune
+    assert s.event_xs_queue_groups == 8
+    assert s.event_history_tail == 500
+    assert s.event_secondary_queue
+    assert s.event_thread_pool == 1000
+    assert s.compact_micro_xs
+    assert s.union_grid_memory == 100.0
+    assert s.photon_xs_tolerance == 1e-4
+    assert s.ncrystal_xs_tolerance == 1e-3
+    assert s.photon_material_xs
+    assert s.photon_only
+    assert s.photon_product_cdf
+    assert s.vectorized_xs
+    assert s.tally_private_memory == 100.0
+    assert s.tally_stream == {'engine': 'BP5', 'name': 'coupling',
+                              'tally_ids': [1, 2]}
+    assert s.overlap_reduction
+    assert s.hierarchical_reduce
+    assert s.surface_distance_cache
+    assert s.neighbor_list_reorder
+    assert s.neighbor_list_precompute
+    assert s.geometry_cache == 'geometry_cache.h5'
+    assert s.thread_stats
+    assert s.thread_affinity == 'spread'
+    assert s.numa_interleave
+    assert s.profile
+    assert s.memory_report
+    assert s.shared_xs
+    assert s.simplify_regions
+    assert s.xs_cache == 'xs_cache.bin'
+    assert s.telemetry == 'telemetry.jsonl'
+    assert s.guide_table_cells == 64
+    assert s.inelastic_scatter_cdf
+    assert s.load_balancing
+    assert s.overlap_bank_sync
+    assert s.wielandt_shift == 0.5
+    assert s.warm_start == {'inactive': 2, 'entropy_tolerance': 1.0e-3}
+    assert s.source_convergence == {'window': 8, 'min_inactive': 5,
+                                    'threshold': 2.5}
+    assert s.source_domain_bounds
+    assert s.census_times == [1.0e-6, 1.0e-5]
+    assert s.pipeline_batches
+    assert s.track_buffer_memory == 8.0
     assert s.random_ray['distance_inactive'] == 10.0
     assert s.random_ray['distance_active'] == 100.0
     assert s.random_ray['ray_source'].space.lower_left == [-1., -1., -1.]
     assert s.random_ray['ray_source'].space.upper_right == [1., 1., 1.]
+    assert s.random_ray['segment_cache_iterations'] == 4
+    assert s.random_ray['segment_cache_memory'] == 500.0
+    assert s.random_ray['anderson_depth'] == 3
+    assert s.random_ray['adjoint']
+    sr_mesh, sr_cells = s.random_ray['source_region_mesh']
+    assert isinstance(sr_mesh, openmc.RegularMesh)
+    assert sr_mesh.dimension == (5, 5, 5)
+    assert sr_cells == [1, 2]
@@ -58,6 +58,12 @@ def test_source_file():
     elem = src.to_xml_element()
     assert 'strength' in elem.attrib
     assert 'file' in elem.attrib
+    assert 'partitioned' not in elem.attrib
+
+    src.partitioned = True
+    elem = src.to_xml_element()
+    assert elem.get('partitioned') == 'true'
+    assert openmc.FileSource.from_xml_element(elem).partitioned
 
 
 def test_source_dlopen():
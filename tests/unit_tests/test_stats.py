@@ -29,6 +29,15 @@ def test_discrete():
 
     d = openmc.stats.Univariate.from_xml_element(elem)
     assert isinstance(d, openmc.stats.Discrete)
+    assert d.bias is None
+
+    # Biased probabilities
+    d = openmc.stats.Discrete(x, p, bias=[0.2, 0.2, 0.6])
+    elem = d.to_xml_element('distribution')
+    d = openmc.stats.Discrete.from_xml_element(elem)
+    np.testing.assert_array_equal(d.bias, [0.2, 0.2, 0.6])
+    with pytest.raises(ValueError):
+        openmc.stats.Discrete(x, p, bias=[0.5, 0.5])
 
     # Single point
     d2 = openmc.stats.Discrete(1e6, 1.0)
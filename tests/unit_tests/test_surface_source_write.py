@@ -32,6 +32,8 @@ def geometry():
         {"max_particles": 200, "surface_ids": [2], "cell": 1},
         {"max_particles": 200, "surface_ids": [2], "cellto": 1},
         {"max_particles": 200, "surface_ids": [2], "cellfrom": 1},
+        {"streaming": True},
+        {"max_particles": 200, "streaming": True, "surface_ids": [2]},
     ],
 )
 def test_xml_serialization(parameter, run_in_tmpdir):
@@ -140,6 +142,31 @@ def test_particle_direction(parameter, run_in_tmpdir, model):
                 assert False
 
 
+def test_streaming(run_in_tmpdir, model):
+    """Test that streamed particles are the same as those banked in memory."""
+    model.settings.surf_source_write = {"max_particles": 200,
+                                        "surface_ids": [2]}
+    model.run()
+    with h5py.File("surface_source.h5", "r") as f:
+        banked = np.sort(f["source_bank"]["E"][()])
+
+    # Without a maximum, every crossing of surface 2 is written
+    model.settings.surf_source_write = {"streaming": True, "surface_ids": [2]}
+    model.run()
+    with h5py.File("surface_source.h5", "r") as f:
+        streamed = np.sort(f["source_bank"]["E"][()])
+    assert len(streamed) > 200
+
+    # Particles are written in a different order, but with a maximum the same
+    # number of them is written
+    model.settings.surf_source_write = {"max_particles": 200,
+                                        "streaming": True, "surface_ids": [2]}
+    model.run()
+    with h5py.File("surface_source.h5", "r") as f:
+        assert len(f["source_bank"]) == len(banked)
+    assert set(banked) <= set(streamed)
+
+
 @pytest.fixture
 def model_dagmc(request):
     """Model based on the mesh file 'dagmc.h5m' available from
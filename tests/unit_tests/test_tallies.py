@@ -1,4 +1,5 @@
 import numpy as np
+import pytest
 
 import openmc
 
@@ -20,6 +21,11 @@ def test_xml_roundtrip(run_in_tmpdir):
     )
     tally.triggers = [openmc.Trigger('rel_err', 0.025)]
     tally.triggers[0].scores = ['total', 'fission']
+    tally.thread_private = True
+    tally.sparse_storage = True
+    tally.partitioned = True
+    tally.figure_of_merit = True
+    tally.precision = 'single'
     tallies = openmc.Tallies([tally])
 
     # Roundtrip through XML and make sure we get what we started with
@@ -41,4 +47,41 @@ def test_xml_roundtrip(run_in_tmpdir):
     assert len(new_tally.triggers) == 1
     assert new_tally.triggers[0].trigger_type == tally.triggers[0].trigger_type
     assert new_tally.triggers[0].threshold == tally.triggers[0].threshold
-    assert new_tally.triggers[0].scores == tally.triggers[0].scores
\ No newline at end of file
+    assert new_tally.triggers[0].scores == tally.triggers[0].scores
+    assert new_tally.thread_private
+    assert new_tally.sparse_storage
+    assert new_tally.partitioned
+    assert new_tally.figure_of_merit
+    assert new_tally.precision == 'single'
+
+
+def test_figure_of_merit(run_in_tmpdir):
+    mat = openmc.Material()
+    mat.add_nuclide('H1', 1.0)
+    mat.set_density('g/cm3', 1.0)
+    sph = openmc.Sphere(r=10.0, boundary_type='vacuum')
+    cell = openmc.Cell(fill=mat, region=-sph)
+    model = openmc.Model()
+    model.geometry = openmc.Geometry([cell])
+    model.settings.run_mode = 'fixed source'
+    model.settings.particles = 100
+    model.settings.batches = 5
+    model.settings.source = openmc.IndependentSource()
+
+    tally = openmc.Tally()
+    tally.filters = [openmc.EnergyFilter([0.0, 1.0, 1.0e3, 20.0e6])]
+    tally.scores = ['flux']
+    tally.figure_of_merit = True
+    model.tallies = [tally]
+
+    # The figure of merit is recorded from the second batch on
+    sp_path = model.run()
+    with openmc.StatePoint(sp_path) as sp:
+        t = sp.tallies[tally.id]
+        fom = t.fom_history
+        np.testing.assert_array_equal(fom['batches'], [2, 3, 4, 5])
+        assert np.all(np.diff(fom['time']) >= 0.0)
+        rel_err = t.std_dev[t.mean > 0.0] / t.mean[t.mean > 0.0]
+        assert rel_err.max() == pytest.approx(fom['max_rel_err'][-1])
+        assert np.allclose(
+            fom['fom'], 1.0 / (fom['max_rel_err']**2 * fom['time']))
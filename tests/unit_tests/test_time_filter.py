@@ -185,3 +185,48 @@ def test_small_time_interval(run_in_tmpdir):
         flux_with = sp.tallies[tally_with_filter.id].mean.ravel()[0]
         flux_without = sp.tallies[tally_without_filter.id].mean.ravel()[0]
         assert flux_with == pytest.approx(flux_without)
+
+
+def test_time_mesh_filter(run_in_tmpdir):
+    # Particles cross a void slab in a straight line, reaching the middle of
+    # the slab at t0. With two mesh bins split at the middle and two time bins
+    # split at t0, the whole track in each half of the slab lies in one time
+    # bin rather than being spread over every combination of bins.
+    E = 1.0e6
+    length = 10.0
+    mat = openmc.Material()
+    mat.add_nuclide('Zr90', 1.0)
+    mat.set_density('g/cm3', 1.0)
+    left = openmc.XPlane(0.0, boundary_type='vacuum')
+    right = openmc.XPlane(length, boundary_type='vacuum')
+    cell = openmc.Cell(region=+left & -right)
+    model = openmc.Model()
+    model.materials.append(mat)
+    model.geometry = openmc.Geometry([cell])
+    model.settings.run_mode = 'fixed source'
+    model.settings.particles = 100
+    model.settings.batches = 2
+    model.settings.source = openmc.IndependentSource(
+        space=openmc.stats.Point((1.0e-6, 0., 0.)),
+        angle=openmc.stats.Monodirectional([1., 0., 0.]),
+        energy=openmc.stats.Discrete([E], [1.0])
+    )
+
+    mesh = openmc.RegularMesh()
+    mesh.lower_left = (0.0, -1.0, -1.0)
+    mesh.upper_right = (length, 1.0, 1.0)
+    mesh.dimension = (2, 1, 1)
+    t0 = time('neutron', 0.5*length, E)
+    tally = openmc.Tally()
+    tally.filters = [openmc.MeshFilter(mesh),
+                     openmc.TimeFilter([0.0, t0, 2*t0])]
+    tally.scores = ['flux']
+    model.tallies.append(tally)
+
+    sp_filename = model.run()
+    with openmc.StatePoint(sp_filename) as sp:
+        values = sp.tallies[tally.id].mean.reshape(2, 2)
+        assert values[0, 0] == pytest.approx(0.5*length, rel=1e-4)
+        assert values[0, 1] == pytest.approx(0.0, abs=1e-4)
+        assert values[1, 0] == pytest.approx(0.0, abs=1e-4)
+        assert values[1, 1] == pytest.approx(0.5*length, rel=1e-4)
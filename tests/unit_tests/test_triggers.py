@@ -113,3 +113,18 @@ def test_tally_trigger_zero_ignored(run_in_tmpdir):
         total_batches = sp.n_realizations + sp.n_inactive
         assert total_batches < pincell.settings.trigger_max_batches
 
+
+
+def test_trigger_fraction_xml():
+    trigger = openmc.Trigger('rel_err', 0.05, fraction=0.95)
+    trigger.scores = ['flux']
+    elem = trigger.to_xml_element()
+    assert elem.get('fraction') == '0.95'
+
+    new_trigger = openmc.Trigger.from_xml_element(elem)
+    assert new_trigger.fraction == 0.95
+    assert new_trigger.scores == ['flux']
+
+    # A trigger on every bin does not write the fraction
+    assert openmc.Trigger('std_dev', 1.0).to_xml_element().get('fraction') \
+        is None
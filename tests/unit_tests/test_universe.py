@@ -1,6 +1,7 @@
 import lxml.etree as ET
 import numpy as np
 import openmc
+import openmc.lib
 import pytest
 
 from tests.unit_tests import assert_unbounded
@@ -212,3 +213,35 @@ def test_get_nuclide_densities():
     universe = openmc.Universe(cells=[cell])
     with pytest.raises(RuntimeError):
         universe.get_nuclide_densities()
+
+
+def test_find_cell_octree(run_in_tmpdir, mpi_intracomm):
+    # A universe of many pins bounded by cylinders is partitioned with an
+    # octree, which must give the same cells as a search over all cells
+    mat = openmc.Material()
+    mat.add_nuclide('H1', 1.0)
+    mat.set_density('g/cm3', 1.0)
+
+    box = openmc.model.RectangularParallelepiped(
+        -6., 6., -6., 6., -1., 1., boundary_type='vacuum')
+    region = -box
+    cells = []
+    for x in np.linspace(-5., 5., 6):
+        for y in np.linspace(-5., 5., 6):
+            pin = openmc.ZCylinder(x0=x, y0=y, r=0.5)
+            cells.append(openmc.Cell(fill=mat, region=-pin & -box))
+            region &= +pin
+    cells.append(openmc.Cell(fill=mat, region=region))
+    model = openmc.Model(geometry=openmc.Geometry(cells))
+    model.settings.particles = 100
+    model.settings.batches = 10
+
+    points = np.random.default_rng(1).uniform(
+        (-6., -6., -1.), (6., 6., 1.), (500, 3))
+    model.init_lib(output=False, intracomm=mpi_intracomm)
+    try:
+        for point in points:
+            cell, _ = openmc.lib.find_cell(point)
+            assert cell.id == model.geometry.find(point)[-1].id
+    finally:
+        model.finalize_lib()
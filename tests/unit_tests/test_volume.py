@@ -31,6 +31,21 @@ def test_invalid_id(run_in_tmpdir, cls):
         model.calculate_volumes()
 
 
+def test_estimator_xml():
+    sph = openmc.Sphere(r=1.0)
+    cell = openmc.Cell(region=-sph)
+    vc = openmc.VolumeCalculation([cell], 100)
+    assert vc.estimator == 'point'
+    assert vc.to_xml_element().find('estimator') is None
+
+    vc.estimator = 'ray'
+    vc_new = openmc.VolumeCalculation.from_xml_element(vc.to_xml_element())
+    assert vc_new.estimator == 'ray'
+
+    with pytest.raises(ValueError):
+        vc.estimator = 'surface'
+
+
 def test_no_bcs(run_in_tmpdir):
     """Ensure that a model without boundary conditions can be used in a volume calculation"""
     model = openmc.examples.pwr_pin_cell()
@@ -249,7 +249,8 @@ def test_ww_gen_roundtrip(run_in_tmpdir, model):
     wwg = openmc.WeightWindowGenerator(mesh, energy_bounds, particle_type)
     wwg.update_parameters = {'ratio' : 5.0,
                              'threshold': 0.8,
-                             'value' : 'mean'}
+                             'value' : 'mean',
+                             'damping': 0.5}
 
     model.settings.weight_window_generators = wwg
     model.export_to_xml()
@@ -272,6 +273,13 @@ def test_ww_gen_roundtrip(run_in_tmpdir, model):
     with pytest.raises(ValueError):
         wwg.method = '🦍🐒'
 
+    # FW-CADIS accepts the same update parameters as MAGIC
+    wwg.method = 'fw_cadis'
+    model.export_to_xml()
+    wwg_in = openmc.Model.from_xml().settings.weight_window_generators[0]
+    assert wwg_in.method == 'fw_cadis'
+    assert wwg_in.update_parameters == wwg.update_parameters
+
     with pytest.raises(TypeError):
         wwg.update_parameters = {'ratio' : 'one-to-one'}
 
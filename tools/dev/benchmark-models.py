@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+"""Run reference models and compare their calculation rates to a baseline.
+
+Each model is run in its own directory and the runtime metrics written to its
+final statepoint, which include the calculation rates in particles/second and,
+for event-based runs, the time spent in each event kernel, are collected into
+a JSON file. When a baseline JSON file from an earlier run is given, the active
+calculation rate of each model is compared to it and the script exits with a
+nonzero status if any model slowed down by more than the tolerance.
+
+usage: benchmark-models.py [MODEL ...] [--output FILE] [--baseline FILE]
+                           [--tolerance FRAC] [--openmc-exec PATH]
+                           [--threads N] [--event] [--dagmc-file PATH]
+
+"""
+
+import argparse
+import json
+import sys
+from pathlib import Path
+
+import numpy as np
+import openmc
+import openmc.examples
+import openmc.lib
+from openmc.utility_funcs import change_directory
+
+
+# Nuclides added in trace amounts to the fuel of the full core, as they would
+# be present after depletion
+DEPLETION_NUCLIDES = [
+    'U234', 'U236', 'Np237', 'Pu238', 'Pu239', 'Pu240', 'Pu241', 'Pu242',
+    'Am241', 'Am243', 'Cm244', 'Kr83', 'Mo95', 'Tc99', 'Ru101', 'Rh103',
+    'Ag109', 'I135', 'Xe131', 'Xe133', 'Xe135', 'Cs133', 'Cs134', 'Cs135',
+    'Nd143', 'Nd145', 'Pm147', 'Sm147', 'Sm149', 'Sm150', 'Sm151', 'Sm152',
+    'Eu153', 'Eu154', 'Eu155', 'Gd155', 'Gd157'
+]
+
+DAGMC_FILE = (Path(__file__).resolve().parents[2] / 'tests' /
+              'regression_tests' / 'dagmc' / 'legacy' / 'dagmc.h5m')
+
+
+def pin():
+    return openmc.examples.pwr_pin_cell()
+
+
+def assembly():
+    return openmc.examples.pwr_assembly()
+
+
+def core():
+    model = openmc.examples.pwr_core()
+    for mat in model.materials:
+        if 'U235' in mat.get_nuclides():
+            for nuclide in DEPLETION_NUCLIDES:
+                if nuclide not in mat.get_nuclides():
+                    mat.add_nuclide(nuclide, 1.0e-8)
+    return model
+
+
+def shielding():
+    """Point source at the center of a water and concrete sphere, with weight
+    windows that fall off with the expected attenuation of the flux"""
+    water = openmc.Material(name='water')
+    water.add_nuclide('H1', 2.0)
+    water.add_nuclide('O16', 1.0)
+    water.set_density('g/cm3', 1.0)
+    water.add_s_alpha_beta('c_H_in_H2O')
+
+    concrete = openmc.Material(name='concrete')
+    for nuclide, fraction in [('H1', 0.168), ('O16', 0.563), ('Si28', 0.186),
+                              ('Ca40', 0.0544), ('Al27', 0.0214),
+                              ('Fe56', 0.0069)]:
+        concrete.add_nuclide(nuclide, fraction)
+    concrete.set_density('g/cm3', 2.3)
+
+    inner = openmc.Sphere(r=50.0)
+    outer = openmc.Sphere(r=150.0, boundary_type='vacuum')
+    cells = [openmc.Cell(fill=water, region=-inner),
+             openmc.Cell(fill=concrete, region=+inner & -outer)]
+
+    model = openmc.Model()
+    model.materials = openmc.Materials([water, concrete])
+    model.geometry = openmc.Geometry(cells)
+    model.settings.run_mode = 'fixed source'
+    model.settings.source = openmc.IndependentSource(
+        space=openmc.stats.Point(),
+        energy=openmc.stats.Discrete([14.1e6], [1.0]))
+
+    mesh = openmc.RegularMesh()
+    mesh.lower_left = (-150.0, -150.0, -150.0)
+    mesh.upper_right = (150.0, 150.0, 150.0)
+    mesh.dimension = (15, 15, 15)
+    x = np.linspace(-140.0, 140.0, 15)
+    r = np.sqrt(x[:, None, None]**2 + x[None, :, None]**2 +
+                x[None, None, :]**2)
+    lower = 0.5 * np.exp(-np.maximum(r - 50.0, 0.0) / 10.0)
+    model.settings.weight_windows = openmc.WeightWindows(
+        mesh, lower.ravel(order='F'), upper_bound_ratio=5.0)
+    model.settings.max_history_splits = 1000
+    return model
+
+
+def random_ray():
+    return openmc.examples.random_ray_lattice()
+
+
+def dagmc(path=DAGMC_FILE):
+    fuel = openmc.Material(name='no-void fuel')
+    fuel.add_nuclide('U235', 1.0)
+    fuel.set_density('g/cm3', 11.0)
+    fuel.id = 40
+
+    water = openmc.Material(name='water')
+    water.add_nuclide('H1', 2.0)
+    water.add_nuclide('O16', 1.0)
+    water.set_density('g/cm3', 1.0)
+    water.add_s_alpha_beta('c_H_in_H2O')
+    water.id = 41
+
+    model = openmc.Model()
+    model.materials = openmc.Materials([fuel, water])
+    model.geometry = openmc.Geometry(openmc.DAGMCUniverse(Path(path)))
+    model.settings.source = openmc.IndependentSource(
+        space=openmc.stats.Box([-4, -4, -4], [4, 4, 4]))
+    return model
+
+
+MODELS = {
+    'pin': pin,
+    'assembly': assembly,
+    'core': core,
+    'shielding': shielding,
+    'random_ray': random_ray,
+    'dagmc': dagmc,
+}
+
+# Particles, batches and inactive batches of each model, chosen so that each
+# runs for tens of seconds on a workstation
+SIZES = {
+    'pin': (20000, 30, 10),
+    'assembly': (20000, 30, 10),
+    'core': (20000, 20, 10),
+    'shielding': (20000, 10, 0),
+    'random_ray': (2000, 40, 20),
+    'dagmc': (20000, 20, 5),
+}
+
+
+def run(name, args):
+    directory = Path(name).resolve()
+    directory.mkdir(exist_ok=True)
+    with change_directory(directory):
+        openmc.reset_auto_ids()
+        if name == 'dagmc':
+            model = dagmc(args.dagmc_file)
+        else:
+            model = MODELS[name]()
+        particles, batches, inactive = SIZES[name]
+        model.settings.particles = particles
+        model.settings.batches = batches
+        if model.settings.run_mode == 'eigenvalue':
+            model.settings.inactive = inactive
+        model.settings.seed = 1
+        sp_path = model.run(threads=args.threads, openmc_exec=args.openmc_exec,
+                            event_based=args.event or None, output=False)
+        with openmc.StatePoint(sp_path) as sp:
+            return {key: float(value) for key, value in sp.runtime.items()}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('models', nargs='*',
+                        help='Models to run, out of {} (default: all)'.format(
+                            ', '.join(MODELS)))
+    parser.add_argument('--output', default='benchmarks.json',
+                        help='JSON file receiving the runtime metrics')
+    parser.add_argument('--baseline', help='JSON file from an earlier run')
+    parser.add_argument('--tolerance', type=float, default=0.05,
+                        help='Allowed fractional decrease of the rate')
+    parser.add_argument('--openmc-exec', default='openmc')
+    parser.add_argument('--threads', type=int)
+    parser.add_argument('--event', action='store_true',
+                        help='Use event-based transport')
+    parser.add_argument('--dagmc-file', default=DAGMC_FILE)
+    args = parser.parse_args()
+    for name in args.models:
+        if name not in MODELS:
+            parser.error(f'unknown model {name}')
+
+    names = args.models or list(MODELS)
+    if 'dagmc' in names and not args.models and \
+            not openmc.lib._dagmc_enabled():
+        names.remove('dagmc')
+
+    results = {}
+    for name in names:
+        results[name] = run(name, args)
+        print(f'{name:>12}: {results[name]["calculation rate (active)"]:.6g} '
+              'particles/second')
+
+    with open(args.output, 'w') as fh:
+        json.dump(results, fh, indent=2, sort_keys=True)
+
+    if args.baseline is None:
+        return
+    with open(args.baseline) as fh:
+        baseline = json.load(fh)
+
+    key = 'calculation rate (active)'
+    regressed = []
+    for name, metrics in results.items():
+        if name not in baseline:
+            continue
+        old = baseline[name][key]
+        new = metrics[key]
+        change = new / old - 1.0
+        print(f'{name:>12}: {change:+.1%} relative to baseline')
+        if change < -args.tolerance:
+            regressed.append(name)
+
+    if regressed:
+        print('Calculation rate decreased for: ' + ', '.join(regressed))
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
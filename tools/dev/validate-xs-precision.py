@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""Compare k-effective and reaction rates between two OpenMC executables.
+
+This is used to qualify builds with OPENMC_ENABLE_SINGLE_PRECISION_XS against
+a default build. The same model is run with the same seed by both executables
+and the differences are reported relative to their combined statistical
+uncertainty.
+
+usage: validate-xs-precision.py REFERENCE TEST [--particles N] [--batches N]
+
+"""
+
+import argparse
+import os
+
+import numpy as np
+import openmc
+import openmc.examples
+
+
+def build_model(particles, batches):
+    model = openmc.examples.pwr_assembly()
+    model.settings.particles = particles
+    model.settings.batches = batches
+    model.settings.inactive = 10
+    model.settings.seed = 1
+
+    # Reaction rates by material in a fine energy structure
+    tally = openmc.Tally(name='reaction rates')
+    tally.filters = [
+        openmc.MaterialFilter(model.materials),
+        openmc.EnergyFilter.from_group_structure('CASMO-70')
+    ]
+    tally.scores = ['total', 'absorption', 'fission', '(n,gamma)', 'elastic']
+    model.tallies = [tally]
+    return model
+
+
+def run(model, executable, directory):
+    os.makedirs(directory, exist_ok=True)
+    sp_path = model.run(cwd=directory, openmc_exec=executable)
+    with openmc.StatePoint(sp_path) as sp:
+        tally = sp.get_tally(name='reaction rates')
+        return sp.keff, tally.mean.ravel(), tally.std_dev.ravel()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('reference', help='OpenMC executable of default build')
+    parser.add_argument('test', help='OpenMC executable to qualify')
+    parser.add_argument('--particles', type=int, default=100000)
+    parser.add_argument('--batches', type=int, default=60)
+    args = parser.parse_args()
+
+    model = build_model(args.particles, args.batches)
+    keff_ref, mean_ref, std_ref = run(
+        model, os.path.abspath(args.reference), 'reference')
+    keff_test, mean_test, std_test = run(
+        model, os.path.abspath(args.test), 'test')
+
+    diff = keff_test - keff_ref
+    sigma = np.hypot(keff_test.s, keff_ref.s)
+    print(f'k-effective (reference): {keff_ref:.5f}')
+    print(f'k-effective (test):      {keff_test:.5f}')
+    print(f'Difference: {1e5*diff.n:.1f} pcm ({diff.n/sigma:.2f} sigma)')
+
+    # Only compare bins that were scored with reasonable precision
+    mask = (mean_ref > 0.0) & (std_ref < 0.05*mean_ref)
+    rel = (mean_test[mask] - mean_ref[mask]) / mean_ref[mask]
+    z = ((mean_test[mask] - mean_ref[mask]) /
+         np.hypot(std_test[mask], std_ref[mask]))
+    print(f'Reaction rate bins compared: {mask.sum()}')
+    print(f'Maximum relative difference: {np.abs(rel).max():.3e}')
+    print(f'Mean relative difference: {rel.mean():.3e}')
+    print(f'Bins differing by more than 3 sigma: {(np.abs(z) > 3).sum()}')
+
+
+if __name__ == '__main__':
+    main()